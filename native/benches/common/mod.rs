@@ -0,0 +1,183 @@
+//! Shared fixtures and memory capture for the Criterion benches.
+//!
+//! Each bench binary installs [`PeakAlloc`] as its global allocator. After
+//! Criterion has timed a workload, [`record_peak_heap`] runs it once more and
+//! writes the heap high-water mark above the pre-run baseline next to
+//! Criterion's own estimates (`<criterion dir>/<group>/<id>/peak_heap.json`),
+//! where `scripts/benchmark/native-throughput.ts` picks both up for the
+//! regression report.
+
+#![allow(dead_code)]
+
+use std::alloc::{GlobalAlloc, Layout, System};
+use std::path::{Path, PathBuf};
+use std::sync::atomic::{AtomicUsize, Ordering};
+
+use sdl_mcp_native::types::NativeFileInput;
+
+pub struct PeakAlloc;
+
+static CURRENT: AtomicUsize = AtomicUsize::new(0);
+static PEAK: AtomicUsize = AtomicUsize::new(0);
+
+fn grow(by: usize) {
+    let now = CURRENT.fetch_add(by, Ordering::Relaxed) + by;
+    PEAK.fetch_max(now, Ordering::Relaxed);
+}
+
+unsafe impl GlobalAlloc for PeakAlloc {
+    unsafe fn alloc(&self, layout: Layout) -> *mut u8 {
+        let ptr = System.alloc(layout);
+        if !ptr.is_null() {
+            grow(layout.size());
+        }
+        ptr
+    }
+
+    unsafe fn alloc_zeroed(&self, layout: Layout) -> *mut u8 {
+        let ptr = System.alloc_zeroed(layout);
+        if !ptr.is_null() {
+            grow(layout.size());
+        }
+        ptr
+    }
+
+    unsafe fn dealloc(&self, ptr: *mut u8, layout: Layout) {
+        System.dealloc(ptr, layout);
+        CURRENT.fetch_sub(layout.size(), Ordering::Relaxed);
+    }
+
+    unsafe fn realloc(&self, ptr: *mut u8, layout: Layout, new_size: usize) -> *mut u8 {
+        let new_ptr = System.realloc(ptr, layout, new_size);
+        if !new_ptr.is_null() {
+            if new_size >= layout.size() {
+                grow(new_size - layout.size());
+            } else {
+                CURRENT.fetch_sub(layout.size() - new_size, Ordering::Relaxed);
+            }
+        }
+        new_ptr
+    }
+}
+
+/// Bytes allocated at the high-water mark of one `f()` run, above what was
+/// live when it started. Allocations made by other threads during the run
+/// (e.g. parse pool workers) count too.
+pub fn peak_heap_bytes<R>(f: impl FnOnce() -> R) -> usize {
+    let base = CURRENT.load(Ordering::Relaxed);
+    PEAK.store(base, Ordering::Relaxed);
+    let result = f();
+    let peak = PEAK.load(Ordering::Relaxed);
+    drop(result);
+    peak.saturating_sub(base)
+}
+
+fn criterion_dir() -> PathBuf {
+    if let Some(home) = std::env::var_os("CRITERION_HOME") {
+        return PathBuf::from(home);
+    }
+    let target = std::env::var_os("CARGO_TARGET_DIR")
+        .map(PathBuf::from)
+        .unwrap_or_else(|| Path::new(env!("CARGO_MANIFEST_DIR")).join("target"));
+    target.join("criterion")
+}
+
+/// Measure one run of `f` and store its peak heap beside the Criterion
+/// results for `group/id`. Failures to write are reported, not fatal.
+pub fn record_peak_heap<R>(group: &str, id: &str, f: impl FnOnce() -> R) {
+    let bytes = peak_heap_bytes(f);
+    let dir = criterion_dir().join(group).join(id);
+    let written = std::fs::create_dir_all(&dir).and_then(|()| {
+        std::fs::write(
+            dir.join("peak_heap.json"),
+            format!("{{\"peakHeapBytes\":{bytes}}}\n"),
+        )
+    });
+    if let Err(error) = written {
+        eprintln!("peak heap for {group}/{id} not saved: {error}");
+    }
+    eprintln!("{group}/{id}: peak heap {:.1} KiB", bytes as f64 / 1024.0);
+}
+
+/// `tests/stress/fixtures/src`, the per-language fixture tree.
+pub fn fixture_root() -> PathBuf {
+    Path::new(env!("CARGO_MANIFEST_DIR")).join("../tests/stress/fixtures/src")
+}
+
+/// Parse inputs for every fixture file of `language`, found by extension.
+pub fn fixture_inputs(language: &str) -> Vec<NativeFileInput> {
+    let mut inputs = Vec::new();
+    collect_inputs(&fixture_root(), &fixture_root(), language, &mut inputs);
+    inputs.sort_by(|a, b| a.rel_path.cmp(&b.rel_path));
+    inputs
+}
+
+fn collect_inputs(root: &Path, dir: &Path, language: &str, out: &mut Vec<NativeFileInput>) {
+    let Ok(entries) = std::fs::read_dir(dir) else {
+        return;
+    };
+    for entry in entries.flatten() {
+        let path = entry.path();
+        if path.is_dir() {
+            collect_inputs(root, &path, language, out);
+            continue;
+        }
+        let ext = path.extension().and_then(|e| e.to_str()).unwrap_or("");
+        if sdl_mcp_native::lang::extension_to_language(ext) != Some(language) {
+            continue;
+        }
+        let rel_path = path
+            .strip_prefix(root)
+            .unwrap_or(&path)
+            .to_string_lossy()
+            .replace('\\', "/");
+        out.push(NativeFileInput {
+            rel_path,
+            absolute_path: path.to_string_lossy().into_owned(),
+            repo_id: "bench".to_string(),
+            language: language.to_string(),
+        });
+    }
+}
+
+/// Deterministic xorshift generator so every run benches the same graph.
+pub struct Rng(u64);
+
+impl Rng {
+    pub fn new(seed: u64) -> Self {
+        Self(seed.max(1))
+    }
+
+    pub fn next_u64(&mut self) -> u64 {
+        let mut x = self.0;
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        self.0 = x;
+        x
+    }
+
+    pub fn below(&mut self, n: usize) -> usize {
+        (self.next_u64() % n.max(1) as u64) as usize
+    }
+}
+
+/// A call-graph-like edge list: `degree` out-edges per node, most to nearby
+/// nodes (so label propagation finds communities), some anywhere.
+pub fn synthetic_edges(node_count: usize, degree: usize, seed: u64) -> Vec<(usize, usize)> {
+    let mut rng = Rng::new(seed);
+    let mut edges = Vec::with_capacity(node_count * degree);
+    for from in 0..node_count {
+        for _ in 0..degree {
+            let to = if rng.below(4) == 0 {
+                rng.below(node_count)
+            } else {
+                (from + 1 + rng.below(32)) % node_count
+            };
+            if to != from {
+                edges.push((from, to));
+            }
+        }
+    }
+    edges
+}
@@ -0,0 +1,209 @@
+//! Graph and SCIP benches on deterministic synthetic inputs: PPR forward
+//! push, label propagation, force layout and streaming SCIP decoding.
+//!
+//! Run with `npm run bench:native` (or `cargo bench --bench graph` in
+//! `native/`).
+
+mod common;
+
+use std::hint::black_box;
+use std::path::PathBuf;
+
+use criterion::{criterion_group, criterion_main, BatchSize, BenchmarkId, Criterion, Throughput};
+use prost::encoding;
+use sdl_mcp_native::cluster::label_propagation;
+use sdl_mcp_native::layout::compute_layout_json;
+use sdl_mcp_native::pagerank::push;
+use sdl_mcp_native::pagerank::types::{NativePprAdjEntry, NativePprSeed};
+use sdl_mcp_native::scip::decoder::ScipDecodeState;
+
+#[global_allocator]
+static ALLOC: common::PeakAlloc = common::PeakAlloc;
+
+/// Defaults from `src/retrieval/ppr.ts`.
+const PPR_ALPHA: f64 = 0.15;
+const PPR_EPSILON: f64 = 1e-4;
+const PPR_MAX_NODES_TOUCHED: usize = 2000;
+
+fn adjacency(node_count: usize, edges: &[(usize, usize)]) -> Vec<Vec<NativePprAdjEntry>> {
+    let mut rows: Vec<Vec<NativePprAdjEntry>> = vec![Vec::new(); node_count];
+    for &(from, to) in edges {
+        rows[from].push(NativePprAdjEntry {
+            neighbor: to as u32,
+            weight: 1.0,
+        });
+    }
+    rows
+}
+
+fn bench_ppr(c: &mut Criterion) {
+    let mut group = c.benchmark_group("ppr_push");
+    for node_count in [10_000usize, 100_000] {
+        let rows = adjacency(node_count, &common::synthetic_edges(node_count, 6, 7));
+        let seeds: Vec<NativePprSeed> = (0..4)
+            .map(|i| NativePprSeed {
+                node: (i * node_count / 4) as u32,
+                weight: 0.25,
+            })
+            .collect();
+        let id = node_count.to_string();
+        group.bench_function(BenchmarkId::from_parameter(&id), |b| {
+            // `run` takes ownership, so cloning the rows stays out of the timing.
+            b.iter_batched(
+                || (rows.clone(), seeds.clone()),
+                |(rows, seeds)| {
+                    push::run(rows, seeds, PPR_ALPHA, PPR_EPSILON, PPR_MAX_NODES_TOUCHED)
+                },
+                BatchSize::LargeInput,
+            );
+        });
+        common::record_peak_heap("ppr_push", &id, || {
+            push::run(
+                rows.clone(),
+                seeds.clone(),
+                PPR_ALPHA,
+                PPR_EPSILON,
+                PPR_MAX_NODES_TOUCHED,
+            )
+        });
+    }
+    group.finish();
+}
+
+fn bench_label_propagation(c: &mut Criterion) {
+    let mut group = c.benchmark_group("label_propagation");
+    group.sample_size(20);
+    for node_count in [5_000usize, 50_000] {
+        let edges = common::synthetic_edges(node_count, 4, 11);
+        let id = node_count.to_string();
+        group.throughput(Throughput::Elements(edges.len() as u64));
+        group.bench_function(BenchmarkId::from_parameter(&id), |b| {
+            b.iter(|| label_propagation(black_box(&edges), node_count, 100));
+        });
+        common::record_peak_heap("label_propagation", &id, || {
+            label_propagation(&edges, node_count, 100)
+        });
+    }
+    group.finish();
+}
+
+fn layout_input(node_count: usize) -> String {
+    let mut rng = common::Rng::new(23);
+    let nodes: Vec<String> = (0..node_count)
+        .map(|i| format!("{{\"id\":\"n{i}\",\"size\":{}}}", 1 + rng.below(8)))
+        .collect();
+    let edges: Vec<String> = common::synthetic_edges(node_count, 2, 29)
+        .into_iter()
+        .map(|(from, to)| format!("{{\"from\":\"n{from}\",\"to\":\"n{to}\",\"weight\":1}}"))
+        .collect();
+    format!(
+        "{{\"nodes\":[{}],\"edges\":[{}]}}",
+        nodes.join(","),
+        edges.join(",")
+    )
+}
+
+fn bench_compute_layout(c: &mut Criterion) {
+    let mut group = c.benchmark_group("compute_layout");
+    group.sample_size(10);
+    for node_count in [200usize, 1_000] {
+        let input = layout_input(node_count);
+        let id = node_count.to_string();
+        group.throughput(Throughput::Elements(node_count as u64));
+        group.bench_function(BenchmarkId::from_parameter(&id), |b| {
+            b.iter(|| compute_layout_json(black_box(&input), 42, 50).expect("layout"));
+        });
+        common::record_peak_heap("compute_layout", &id, || {
+            compute_layout_json(&input, 42, 50).expect("layout")
+        });
+    }
+    group.finish();
+}
+
+/// Encode a SCIP index of `documents` documents straight from the schema
+/// field numbers (`native/proto/scip.proto`); the generated message types
+/// are private to the decoder.
+fn write_scip_fixture(documents: usize, occurrences: usize) -> PathBuf {
+    let mut index = Vec::new();
+
+    let mut tool_info = Vec::new();
+    encoding::string::encode(1, &"sdl-bench".to_string(), &mut tool_info);
+    let mut metadata = Vec::new();
+    encoding::bytes::encode(2, &tool_info, &mut metadata);
+    encoding::string::encode(3, &"file:///bench".to_string(), &mut metadata);
+    encoding::bytes::encode(1, &metadata, &mut index);
+
+    for d in 0..documents {
+        let mut document = Vec::new();
+        encoding::string::encode(1, &format!("src/file_{d}.ts"), &mut document);
+        for o in 0..occurrences {
+            let mut occurrence = Vec::new();
+            let line = o as i32;
+            encoding::int32::encode_packed(1, &[line, 4, 12], &mut occurrence);
+            encoding::string::encode(
+                2,
+                &format!(
+                    "scip-typescript npm bench 1.0 src/file_{d}.ts/fn{}().",
+                    o % 40
+                ),
+                &mut occurrence,
+            );
+            encoding::bytes::encode(2, &occurrence, &mut document);
+        }
+        for s in 0..40 {
+            let mut symbol = Vec::new();
+            encoding::string::encode(
+                1,
+                &format!("scip-typescript npm bench 1.0 src/file_{d}.ts/fn{s}()."),
+                &mut symbol,
+            );
+            encoding::bytes::encode(3, &symbol, &mut document);
+        }
+        encoding::string::encode(4, &"typescript".to_string(), &mut document);
+        encoding::bytes::encode(2, &document, &mut index);
+    }
+
+    let path = std::env::temp_dir().join(format!(
+        "sdl_mcp_bench_{}_{documents}x{occurrences}.scip",
+        std::process::id()
+    ));
+    std::fs::write(&path, index).expect("write SCIP fixture");
+    path
+}
+
+fn decode_all(path: &str) -> usize {
+    let state = ScipDecodeState::new(path).expect("open SCIP fixture");
+    let mut decoded = 0;
+    loop {
+        let batch = state
+            .next_documents(64, 8 * 1024 * 1024)
+            .expect("decode SCIP documents");
+        if batch.is_empty() {
+            return decoded;
+        }
+        decoded += batch.len();
+        black_box(batch);
+    }
+}
+
+fn bench_scip_decode(c: &mut Criterion) {
+    let mut group = c.benchmark_group("scip_decode");
+    group.sample_size(20);
+    let fixture = write_scip_fixture(500, 400);
+    let path = fixture.to_string_lossy().into_owned();
+    let bytes = std::fs::metadata(&fixture).map_or(0, |m| m.len());
+    group.throughput(Throughput::Bytes(bytes));
+    group.bench_function("500docs", |b| b.iter(|| decode_all(&path)));
+    common::record_peak_heap("scip_decode", "500docs", || decode_all(&path));
+    group.finish();
+    let _ = std::fs::remove_file(fixture);
+}
+
+criterion_group!(
+    benches,
+    bench_ppr,
+    bench_label_propagation,
+    bench_compute_layout,
+    bench_scip_decode
+);
+criterion_main!(benches);
@@ -0,0 +1,149 @@
+//! Parse-path benches over `tests/stress/fixtures/src`: whole-file parsing
+//! per language, AST fingerprinting and summary generation.
+//!
+//! Run with `npm run bench:native` (or `cargo bench --bench parse` in
+//! `native/`); pass `-- --save-baseline <name>` / `-- --baseline <name>` to
+//! compare against an earlier run.
+
+mod common;
+
+use std::hint::black_box;
+
+use criterion::{criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use sdl_mcp_native::extract::file_context::FileContext;
+use sdl_mcp_native::extract::fingerprint::{generate_ast_fingerprint_with_mode, FingerprintMode};
+use sdl_mcp_native::extract::summary::generate_summary;
+use sdl_mcp_native::lang;
+use sdl_mcp_native::parse::parse_files_parallel;
+use sdl_mcp_native::types::NativeFileInput;
+
+#[global_allocator]
+static ALLOC: common::PeakAlloc = common::PeakAlloc;
+
+/// Language ids with a native grammar and at least one fixture file.
+const LANGUAGES: [&str; 11] = [
+    "ts", "js", "py", "go", "java", "cs", "c", "cpp", "php", "rs", "sh",
+];
+
+fn total_bytes(inputs: &[NativeFileInput]) -> u64 {
+    inputs
+        .iter()
+        .map(|input| std::fs::metadata(&input.absolute_path).map_or(0, |m| m.len()))
+        .sum()
+}
+
+fn bench_parse_files_parallel(c: &mut Criterion) {
+    let mut group = c.benchmark_group("parse_files_parallel");
+    let mut all = Vec::new();
+    for language in LANGUAGES {
+        let inputs = common::fixture_inputs(language);
+        if inputs.is_empty() {
+            continue;
+        }
+        // One thread: per-language cost without pool scheduling noise.
+        group.throughput(Throughput::Bytes(total_bytes(&inputs)));
+        group.bench_with_input(
+            BenchmarkId::from_parameter(language),
+            &inputs,
+            |b, inputs| {
+                b.iter(|| parse_files_parallel(black_box(inputs), 1));
+            },
+        );
+        common::record_peak_heap("parse_files_parallel", language, || {
+            parse_files_parallel(&inputs, 1)
+        });
+        all.extend(inputs);
+    }
+
+    let threads = std::thread::available_parallelism().map_or(4, |n| n.get());
+    group.throughput(Throughput::Bytes(total_bytes(&all)));
+    group.bench_with_input(BenchmarkId::from_parameter("all"), &all, |b, inputs| {
+        b.iter(|| parse_files_parallel(black_box(inputs), threads));
+    });
+    common::record_peak_heap("parse_files_parallel", "all", || {
+        parse_files_parallel(&all, threads)
+    });
+    group.finish();
+}
+
+fn bench_fingerprint(c: &mut Criterion) {
+    let mut group = c.benchmark_group("fingerprint");
+    for language in LANGUAGES {
+        let sources: Vec<Vec<u8>> = common::fixture_inputs(language)
+            .iter()
+            .filter_map(|input| std::fs::read(&input.absolute_path).ok())
+            .collect();
+        let Some(mut parser) = lang::create_parser(language) else {
+            continue;
+        };
+        let trees: Vec<_> = sources
+            .iter()
+            .filter_map(|source| parser.parse(source, None))
+            .collect();
+        if trees.is_empty() {
+            continue;
+        }
+        // Declarations and their members: the nodes symbols are cut from.
+        let mut nodes = Vec::new();
+        for (tree, source) in trees.iter().zip(&sources) {
+            let root = tree.root_node();
+            let mut cursor = root.walk();
+            for top in root.named_children(&mut cursor) {
+                nodes.push((top, source.as_slice()));
+                let mut inner = top.walk();
+                for child in top.named_children(&mut inner) {
+                    nodes.push((child, source.as_slice()));
+                }
+            }
+        }
+        group.throughput(Throughput::Elements(nodes.len() as u64));
+        group.bench_function(BenchmarkId::from_parameter(language), |b| {
+            b.iter(|| {
+                for (node, source) in &nodes {
+                    black_box(generate_ast_fingerprint_with_mode(
+                        *node,
+                        source,
+                        FingerprintMode::Native,
+                    ));
+                }
+            });
+        });
+    }
+    group.finish();
+}
+
+fn bench_summary(c: &mut Criterion) {
+    let mut group = c.benchmark_group("summary");
+    for language in LANGUAGES {
+        let inputs = common::fixture_inputs(language);
+        let parsed: Vec<_> = parse_files_parallel(&inputs, 1)
+            .into_iter()
+            .filter(|file| file.content.is_some() && !file.symbols.is_empty())
+            .collect();
+        if parsed.is_empty() {
+            continue;
+        }
+        let symbols: usize = parsed.iter().map(|file| file.symbols.len()).sum();
+        group.throughput(Throughput::Elements(symbols as u64));
+        group.bench_function(BenchmarkId::from_parameter(language), |b| {
+            b.iter(|| {
+                for file in &parsed {
+                    // Fresh context per pass: it caches doc descriptions.
+                    let ctx = FileContext::new(file.content.as_deref().unwrap_or(""), language);
+                    for symbol in &file.symbols {
+                        black_box(generate_summary(symbol, &ctx));
+                    }
+                }
+            });
+        });
+    }
+    group.finish();
+}
+
+criterion_group!(
+    benches,
+    bench_parse_files_parallel,
+    bench_fingerprint,
+    bench_summary
+);
+criterion_main!(benches);
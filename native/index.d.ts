@@ -3,6 +3,27 @@
 
 /* auto-generated by NAPI-RS */
 
+export interface NativeCentralityOptions {
+  pageRank: boolean
+  kCore: boolean
+  /** Upper bound on power iterations (0 = 20). */
+  maxIterations: number
+  damping: number
+  /**
+   * Stop once an iteration moves less than this much rank in total (L1);
+   * 0 always runs `max_iterations`.
+   */
+  tolerance: number
+}
+/**
+ * Per-node scores in CSR node order. A disabled kernel returns an empty
+ * column.
+ */
+export interface NativeCentrality {
+  pageRank: Float64Array
+  kCore: Uint32Array
+  pageRankIterations: number
+}
 export interface NativeClusterSymbol {
   symbolId: string
 }
@@ -19,6 +40,18 @@ export interface NativeClusterAssignment {
  * A single (neighbor index, weight) entry in the directional adjacency the
  * TypeScript layer hands to the native walker.
  */
+export interface NativeLayoutSessionOptions {
+  /**
+   * Barnes–Hut opening threshold (0 = 0.8); smaller is slower and closer
+   * to the exact layout.
+   */
+  theta?: number
+  /**
+   * Starting temperature, i.e. the largest first-step move (0 = width / 10).
+   * Warm starts pass a lower value so settled nodes stay put.
+   */
+  initialTemperature?: number
+}
 export interface NativePprAdjEntry {
   neighbor: number
   weight: number
@@ -43,6 +76,16 @@ export interface NativePprScore {
   node: number
   score: number
 }
+/**
+ * Unit-seed PPR vectors from `computePersonalizedPagerankCsrBatch`,
+ * flattened. Vector `i` (for the `i`-th seed node) is
+ * `nodes[offsets[i]..offsets[i + 1]]` with matching `scores`, sorted by node.
+ */
+export interface NativePprBatch {
+  offsets: Uint32Array
+  nodes: Uint32Array
+  scores: Float64Array
+}
 export interface NativeProcessSymbol {
   symbolId: string
   name: string
@@ -61,6 +104,16 @@ export interface NativeProcess {
   steps: Array<NativeProcessStep>
   depth: number
 }
+/**
+ * Traces returned by `traceProcessesCsr`, flattened. Trace `i` (for the
+ * `i`-th entry node) visits `steps[step_offsets[i]..step_offsets[i + 1]]`,
+ * as dense node IDs, and reached `depths[i]`.
+ */
+export interface NativeCsrProcessTraces {
+  stepOffsets: Uint32Array
+  steps: Uint32Array
+  depths: Uint32Array
+}
 export interface NapiScipMetadata {
   version: number
   toolName: string
@@ -122,6 +175,79 @@ export interface NapiScipExternalSymbol {
   signatureDocumentation?: string
 }
 /** Input file descriptor passed from TypeScript to Rust. */
+/**
+ * A graph snapshot packed for `sliceGraphBuild`. Per-edge columns follow
+ * `offsets`; per-node columns have one entry per node; file and cluster
+ * indexes are `0xFFFFFFFF` when absent.
+ */
+export interface NativeSliceGraphInput {
+  offsets: Uint32Array
+  neighbors: Uint32Array
+  edgeTypes: Uint8Array
+  confidences: Float64Array
+  /** Lower-cased symbol names. */
+  names: Array<string>
+  nodeFiles: Uint32Array
+  rangeStartLines: Float64Array
+  rangeEndLines: Float64Array
+  filePaths: Array<string>
+  filePathsLower: Array<string>
+  structure: Float64Array
+  kind: Float64Array
+  hotness: Float64Array
+  centrality: Float64Array
+  cardTokens: Float64Array
+  external: Uint8Array
+  nodeClusters: Uint32Array
+}
+export interface NativeSliceRequest {
+  startNodes: Uint32Array
+  startScores: Float64Array
+  forcedNodes: Uint32Array
+  entryNodes: Uint32Array
+  requiredEntryCoverage: number
+  queryTokens: Array<string>
+  stackTrace?: string
+  /** Base weight per edge type code. */
+  edgeWeights: Float64Array
+  /** Cohesion boost per cluster index; empty disables cohesion. */
+  clusterBoost: Float64Array
+  minConfidence: number
+  maxCards: number
+  maxEstimatedTokens: number
+  /** Return the accept/evict/reject trace in the `event*` columns. */
+  recordEvents: boolean
+}
+/**
+ * Beam result. Frontier entries are in heap-array order; `frontierStarts`
+ * is the start-node index of seeded entries (`0xFFFFFFFF` otherwise) and
+ * `frontierEdgeTypes` the edge type of the others (255 for seeded).
+ * Event columns are empty unless `recordEvents` was set; event kinds are
+ * 0 accept, 1 evict, 2 reject.
+ */
+export interface NativeSliceResult {
+  sliceNodes: Uint32Array
+  frontierNodes: Uint32Array
+  frontierScores: Float64Array
+  frontierPriorities: Uint8Array
+  frontierSequences: Uint32Array
+  frontierStarts: Uint32Array
+  frontierEdgeTypes: Uint8Array
+  wasTruncated: boolean
+  droppedCandidates: number
+  maxFrontierSize: number
+  accepted: number
+  evicted: number
+  rejected: number
+  eventKinds: Uint8Array
+  eventNodes: Uint32Array
+  eventScores: Float64Array
+  eventFrom: Uint32Array
+  eventEdgeTypes: Uint8Array
+  eventEdgeWeights: Float64Array
+  eventIterations: Uint32Array
+  eventCauses: Uint8Array
+}
 export interface NativeFileInput {
   /** Relative path from repo root (forward slashes). */
   relPath: string
@@ -277,6 +403,150 @@ export interface NativeParsedFile {
   /** Parse error message, if any. */
   parseError?: string
 }
+/**
+ * One buffer edit, applied in order against the previously parsed content
+ * of the same draft. Offsets are UTF-8 byte offsets.
+ */
+export interface NativeTextEdit {
+  /** Start of the replaced range. */
+  startByte: number
+  /** End (exclusive) of the replaced range, before the edit. */
+  oldEndByte: number
+  /** Replacement text. */
+  text: string
+}
+/** Input for an incremental draft re-parse. */
+export interface NativeIncrementalParseInput {
+  /** Repository identifier. */
+  repoId: string
+  /** Relative path from repo root (forward slashes). */
+  relPath: string
+  /** Language identifier (e.g., "ts", "cpp"). */
+  language: string
+  /** Full current buffer content. */
+  content: string
+  /**
+   * Optional edits that transform the previously parsed content into
+   * `content`. When absent or inconsistent, the changed region is derived
+   * from the two contents instead.
+   */
+  edits?: Array<NativeTextEdit>
+}
+/** Result of an incremental draft re-parse. */
+export interface NativeIncrementalParseResult {
+  /**
+   * Parse result for the whole file. `content` is always `None`; the
+   * caller already holds the buffer.
+   */
+  file: NativeParsedFile
+  /** Whether the previous tree for this draft was reused. */
+  reusedTree: boolean
+  /** First changed line (1-indexed, new content); 0 when nothing changed. */
+  changedStartLine: number
+  /** Last changed line (1-indexed, new content); 0 when nothing changed. */
+  changedEndLine: number
+  /** Symbols whose enrichment was carried over from the previous parse. */
+  symbolsReused: number
+  /** Symbols whose enrichment was recomputed. */
+  symbolsEnriched: number
+  /**
+   * Symbols extracted from re-parsed declarations; the rest were carried
+   * over from the previous parse.
+   */
+  symbolsExtracted: number
+}
+/**
+ * Parse results with symbols moved into one columnar buffer (see
+ * `parse::packed` for the layout). `files[i].symbols` is empty; its symbols
+ * are the next `symbol_counts[i]` rows of `symbols`.
+ */
+export interface NativePackedParseBatch {
+  /** Parse results in input order, without symbols. */
+  files: Array<NativeParsedFile>
+  /** Number of packed symbols belonging to each entry of `files`. */
+  symbolCounts: Array<number>
+  /** Packed symbol columns and string data. */
+  symbols: Buffer
+}
+/** Options for `scanRepositoryFilesAsync`. */
+export interface NativeScanOptions {
+  /** File-name suffixes to keep (e.g. `[".ts", ".tsx"]`). */
+  includeExtensions: Array<string>
+  /** Glob patterns to exclude, relative to the scan root. */
+  ignorePatterns: Array<string>
+  /** Drop files larger than this many bytes. */
+  maxFileBytes?: number
+  /** Walker threads (0 = automatic). */
+  threadCount: number
+}
+/** A file found by `scanRepositoryFilesAsync`. */
+export interface NativeScannedFile {
+  /** Relative path from the scan root (forward slashes). */
+  relPath: string
+  /** File size in bytes. */
+  size: number
+  /** Modification time in milliseconds since the Unix epoch. */
+  mtimeMs: number
+  /**
+   * Inode number on Unix, 0 elsewhere. Part of the parse cache key so a
+   * file replaced by another with the same size and mtime still misses.
+   */
+  inode: number
+}
+/** A file to hash with `hashFilesAsync`. */
+export interface NativeFileHashInput {
+  /** Absolute path on disk. */
+  absolutePath: string
+  /**
+   * The file's stored fast digest, if any. While the file still hashes to
+   * it, SHA-256 is not computed.
+   */
+  knownFastHash?: string
+}
+/** Digests of one file from `hashFilesAsync`, both over its raw bytes. */
+export interface NativeFileHash {
+  /** Fast digest (algorithm named by `contentFastHashAlgorithm()`). */
+  contentFastHash?: string
+  /**
+   * SHA-256 hex digest. `None` when the fast digest matched
+   * `known_fast_hash`, and when the file could not be read.
+   */
+  contentHash?: string
+  /** Read error, when the file could not be hashed. */
+  error?: string
+}
+/** Configuration and lifetime counters of the process-wide parse engine. */
+export interface NativeParseEngineStatus {
+  /** Worker threads in the current pool (0 when no pool is alive). */
+  threadCount: number
+  /** Number of times a pool was built (first use + each resize). */
+  poolBuilds: number
+  /** Number of `parse_files*` batches completed. */
+  batchesParsed: number
+  /** Number of files parsed across all batches. */
+  filesParsed: number
+  /** Current AST fingerprint mode ("native" or "ts-compat"). */
+  astFingerprintMode: string
+}
+export interface NativeEmbeddingIndexOptions {
+  /** Inverted lists (0 = about sqrt(rows); small indexes use one list). */
+  lists?: number
+  /** k-means refinement passes (0 = 8). */
+  iterations?: number
+}
+export interface NativeVectorHit {
+  symbolId: string
+  /** Approximate cosine similarity in `[-1, 1]`. */
+  score: number
+}
+export interface NativeLexicalHit {
+  symbolId: string
+  /**
+   * BM25 score for token search; matched share of the name for
+   * substring search.
+   */
+  score: number
+}
 export interface PreloadedWindowsLibrary {
   token: number
   loadedPath: string
@@ -285,15 +555,217 @@ export declare function preloadWindowsLibrary(absolutePath: string): PreloadedWi
 export declare function releaseWindowsLibrary(token: number): void
 export declare function parseFiles(files: Array<NativeFileInput>, threadCount: number): Array<NativeParsedFile>
 export declare function parseFilesAsync(files: Array<NativeFileInput>, threadCount: number): Promise<unknown>
+/**
+ * Packed-output variant of `parseFilesAsync`: symbols come back as one
+ * columnar buffer per batch instead of nested objects.
+ */
+export declare function parseFilesPackedAsync(files: Array<NativeFileInput>, threadCount: number): Promise<unknown>
+/**
+ * Start parsing a batch like `parseFilesAsync`, but hand results back in
+ * chunks of up to `chunkSize` files as they complete (completion order).
+ * Pull chunks with `nextChunk()` until it resolves to `null`.
+ */
+export declare function parseFilesStream(files: Array<NativeFileInput>, threadCount: number, chunkSize: number): ParseStreamHandle
+/**
+ * Walk a repository on a parallel walker and return matching files with
+ * their size and mtime, sorted by relative path.
+ */
+export declare function scanRepositoryFilesAsync(rootPath: string, options: NativeScanOptions): Promise<unknown>
+/**
+ * Hash files' raw bytes on the parse pool: a fast digest always, SHA-256
+ * only for files whose fast digest no longer matches `knownFastHash`.
+ * Files over the native parse limit are memory-mapped rather than read.
+ */
+export declare function hashFilesAsync(files: Array<NativeFileHashInput>, threadCount: number): Promise<unknown>
+/** Name of the digest `hashFilesAsync` returns as `contentFastHash`. */
+export declare function contentFastHashAlgorithm(): string
+/**
+ * Re-parse a live-index draft, reusing the previous tree and enrichment
+ * cached for the same (repo, relPath).
+ */
+export declare function parseFileIncremental(input: NativeIncrementalParseInput): NativeIncrementalParseResult
+export declare function parseFileIncrementalAsync(input: NativeIncrementalParseInput): Promise<unknown>
+/**
+ * Drop cached incremental-parse state for one draft, or for every draft of
+ * the repo when `rel_path` is omitted. Returns the number of entries removed.
+ */
+export declare function forgetIncrementalParse(repoId: string, relPath?: string | undefined | null): number
+/**
+ * Configure the process-wide parse engine. `thread_count = 0` selects the
+ * default (available cores minus one). This is the only call that resizes
+ * the pool: it swaps in a new one, and batches already running finish on the
+ * previous one. Per-call thread counts only cap a batch's share of the pool.
+ */
+export declare function configureParseEngine(threadCount: number): NativeParseEngineStatus
+export declare function parseEngineStatus(): NativeParseEngineStatus
+/**
+ * Select how symbol AST fingerprints are computed: `"native"` (default) or
+ * `"ts-compat"` for byte-exact parity with the TypeScript engine. Applies to
+ * files parsed after the call.
+ */
+export declare function setAstFingerprintMode(mode: string): void
+/** Release the parse engine's worker pool. The next parse call rebuilds it. */
+export declare function shutdownParseEngine(): void
 export declare function hashContentNative(content: string): string
 export declare function generateSymbolIdNative(repoId: string, relPath: string, kind: string, name: string, fingerprint: string): string
 export declare function computeClusters(symbols: Array<NativeClusterSymbol>, edges: Array<NativeClusterEdge>, minClusterSize: number): Array<NativeClusterAssignment>
+/**
+ * Label propagation over a CSR graph whose node IDs follow sorted symbol ID
+ * order (as built by `src/graph/csr-snapshot.ts`). Edges are treated as
+ * undirected; `edge_type_mask` selects edge type codes (0 = all) and nodes
+ * flagged in `excluded` never join a community.
+ *
+ * Returns one label per node: the lowest node ID of its community, or
+ * `u32::MAX` when the node is unclustered or its community was dropped by
+ * the same size bounds as `compute_clusters`. The caller derives cluster IDs
+ * from the member symbol IDs.
+ */
+export declare function computeClustersCsr(offsets: Uint32Array, neighbors: Uint32Array, edgeTypes: Uint8Array | undefined | null, edgeTypeMask: number, excluded: Uint8Array | undefined | null, minClusterSize: number): Uint32Array
+/**
+ * Parallel label propagation over the same CSR input as
+ * `compute_clusters_csr`, with an incremental mode.
+ *
+ * Without `previous_groups` every node starts from its own label. With it,
+ * `previous_groups[node]` keys the node's community from an earlier run
+ * (`u32::MAX` for none) and `changed` flags the nodes whose edges moved;
+ * only changed nodes are reset and only their neighborhood is re-evaluated.
+ *
+ * Returns one raw label per node, before any size bounds: the lowest node ID
+ * of its connected community, or `u32::MAX` for nodes without edges. The
+ * labels can be passed back as `previous_groups` on the next run.
+ */
+export declare function computeCommunitiesCsr(offsets: Uint32Array, neighbors: Uint32Array, edgeTypes: Uint8Array | undefined | null, edgeTypeMask: number, excluded: Uint8Array | undefined | null, previousGroups: Uint32Array | undefined | null, changed: Uint8Array | undefined | null, maxIterations: number): Uint32Array
+/**
+ * Global PageRank and k-core over a directed CSR call graph, computed off
+ * the JS thread. `previous_page_rank` (one score per node, e.g. from the
+ * last metrics refresh) warm-starts the power iteration; entries that are
+ * not finite and non-negative fall back to the uniform start.
+ */
+export declare function computeCentralityCsr(offsets: Uint32Array, neighbors: Uint32Array, previousPageRank: Float64Array | undefined | null, options: NativeCentralityOptions): Promise<NativeCentrality>
 export declare function computeLayout(inputJson: string, seed: number, iterations: number): string
+/**
+ * Start a Barnes–Hut layout over nodes `0..nodeCount`. Edge `i` runs
+ * `edgeFrom[i] -> edgeTo[i]` with `edgeWeight[i]`. `initialPositions`
+ * holds `x, y, z` per node; nodes with a NaN coordinate are placed from
+ * `seed`. Advance with `step()`, which resolves to the positions so far.
+ */
+export declare function startLayoutSession(nodeCount: number, edgeFrom: Uint32Array, edgeTo: Uint32Array, edgeWeight: Float64Array, initialPositions: Float64Array | undefined | null, seed: number, options?: NativeLayoutSessionOptions | undefined | null): LayoutSessionHandle
 export declare function computePersonalizedPagerank(adjacency: Array<Array<NativePprAdjEntry>>, seeds: Array<NativePprSeed>, alpha: number, epsilon: number, maxNodesTouched: number): Array<NativePprScore>
+/**
+ * [`compute_personalized_pagerank`] over a CSR adjacency. The typed arrays
+ * are read in place, so a snapshot's adjacency is never re-marshalled.
+ */
+export declare function computePersonalizedPagerankCsr(offsets: Uint32Array, neighbors: Uint32Array, weights: Float64Array, seeds: Array<NativePprSeed>, alpha: number, epsilon: number, maxNodesTouched: number): Array<NativePprScore>
+/**
+ * Unit-seed PPR vectors for every node in `seed_nodes`, computed in one
+ * batch over a CSR adjacency (see [`pagerank::push::run_csr_batch`]).
+ */
+export declare function computePersonalizedPagerankCsrBatch(offsets: Uint32Array, neighbors: Uint32Array, weights: Float64Array, seedNodes: Uint32Array, alpha: number, epsilon: number, maxNodesTouched: number): NativePprBatch
 export declare function traceProcesses(symbols: Array<NativeProcessSymbol>, callEdges: Array<NativeProcessCallEdge>, maxDepth: number, entryPatterns: Array<string>): Array<NativeProcess>
+/**
+ * Process tracing over a CSR call graph. `entry_nodes` are dense node IDs
+ * (selected by the caller); each is traced with the same depth-first rules
+ * as `trace_processes`, following only edges that pass `edge_type_mask`
+ * (0 = all).
+ */
+export declare function traceProcessesCsr(offsets: Uint32Array, neighbors: Uint32Array, edgeTypes: Uint8Array | undefined | null, edgeTypeMask: number, entryNodes: Uint32Array, maxDepth: number): NativeCsrProcessTraces
 export declare function scipDecodeStart(filePath: string): ScipDecodeHandle
+/**
+ * Quantise `vectors` (`dimension` floats per symbol, in `symbolIds` order)
+ * into an IVF embedding index at `path`, replacing any previous file
+ * atomically. Runs on the libuv thread pool and resolves to the row count.
+ */
+export declare function buildEmbeddingIndex(path: string, dimension: number, symbolIds: Array<string>, vectors: Float32Array, options?: NativeEmbeddingIndexOptions | undefined | null): Promise<number>
+/** Memory-map an index written by `buildEmbeddingIndex`. */
+export declare function openEmbeddingIndex(path: string): EmbeddingIndexHandle
+/**
+ * Index symbol names and search text in memory, one entry per
+ * `symbolIds` position.
+ */
+export declare function lexicalIndexBuild(symbolIds: Array<string>, names: Array<string>, searchTexts: Array<string>): LexicalIndexHandle
+/**
+ * Pack a graph snapshot for `SliceGraphHandle.beamSearch`. Built once per
+ * snapshot; every slice request over it reuses the handle.
+ */
+export declare function sliceGraphBuild(input: NativeSliceGraphInput): SliceGraphHandle
+export declare class ParseStreamHandle {
+  /** Number of files in the batch. */
+  get totalFiles(): number
+  /**
+   * Resolve with the next completed chunk, or `null` once every file has
+   * been delivered or the stream was cancelled.
+   */
+  nextChunk(): Promise<Array<NativeParsedFile> | null>
+  /**
+   * Like `nextChunk`, but with the chunk's symbols packed into one
+   * columnar buffer.
+   */
+  nextPackedChunk(): Promise<NativePackedParseBatch | null>
+  /** Stop parsing files that have not started yet. */
+  cancel(): void
+}
+export declare class LayoutSessionHandle {
+  /** Iterations run so far across every `step()`. */
+  get iterationsRun(): number
+  /**
+   * Run `iterations` more iterations off the main thread and resolve with
+   * every node's `x, y, z`. Concurrent steps run one after another.
+   */
+  step(iterations: number): Promise<Float64Array>
+}
 export declare class ScipDecodeHandle {
   metadata(): NapiScipMetadata
   nextDocument(): NapiScipDocument | null
+  /**
+   * Decode up to `maxDocuments` documents on the libuv thread pool, so the
+   * caller can keep working on the previous batch meanwhile. Resolves to an
+   * empty array once every document has been consumed.
+   */
+  nextDocuments(maxDocuments: number): Promise<Array<NapiScipDocument>>
   externalSymbols(): Array<NapiScipExternalSymbol>
 }
+export declare class EmbeddingIndexHandle {
+  /** 0 once closed. */
+  get dimension(): number
+  /** 0 once closed. */
+  get rows(): number
+  get lists(): number
+  /**
+   * Top `k` symbols by approximate cosine similarity to `query`, best
+   * first, scanning the `nprobe` closest lists (0 = a sixteenth, at
+   * least 8).
+   */
+  search(query: Float32Array, k: number, nprobe: number): Array<NativeVectorHit>
+  /** Unmap the index file. Later calls see an empty, closed index. */
+  close(): void
+}
+export declare class LexicalIndexHandle {
+  get size(): number
+  /** Insert or replace each symbol's entry. */
+  upsert(symbolIds: Array<string>, names: Array<string>, searchTexts: Array<string>): void
+  remove(symbolIds: Array<string>): void
+  /**
+   * Top `limit` symbols by BM25 over the query's words and their
+   * identifier fragments, best first. Conjunctive queries match only
+   * symbols holding every word.
+   */
+  search(query: string, limit: number, conjunctive: boolean): Array<NativeLexicalHit>
+  /** Top `limit` symbols whose name contains `query`, ignoring case. */
+  searchSubstring(query: string, limit: number): Array<NativeLexicalHit>
+  /**
+   * Symbols named exactly `name`, or starting with it when `prefix`,
+   * case-sensitively and in symbol ID order.
+   */
+  findByName(name: string, prefix: boolean, limit: number): Array<string>
+  /** Symbol IDs starting with `prefix`, in order. */
+  findByIdPrefix(prefix: string, limit: number): Array<string>
+  contains(symbolId: string): boolean
+}
+export declare class SliceGraphHandle {
+  get nodeCount(): number
+  /**
+   * Run the slice beam search synchronously; results match the
+   * TypeScript `beamSearch` over the same snapshot.
+   */
+  beamSearch(request: NativeSliceRequest): NativeSliceResult
+}
@@ -0,0 +1,149 @@
+//! Bucket-based k-core decomposition (Batagelj–Zaversnik), O(n + m).
+
+use crate::cluster::parallel::UndirectedGraph;
+use crate::cluster::undirected_edges;
+use crate::csr::CsrGraph;
+
+/// Core number of every node of `graph`, read as an undirected simple graph
+/// (duplicate edges, self-loops and out-of-range neighbors ignored).
+pub fn core_numbers(graph: &CsrGraph<'_>) -> Vec<u32> {
+    let n = graph.node_count();
+    let pairs = undirected_edges(graph, 0, None);
+    let undirected = UndirectedGraph::from_pairs(&pairs, n);
+
+    let mut degree: Vec<usize> = (0..n).map(|v| undirected.row(v).len()).collect();
+    let max_degree = degree.iter().copied().max().unwrap_or(0);
+
+    // `bin[d]` is the first position of degree-`d` nodes in `order`.
+    let mut bin = vec![0usize; max_degree + 1];
+    for &d in &degree {
+        bin[d] += 1;
+    }
+    let mut start = 0;
+    for slot in &mut bin {
+        let count = *slot;
+        *slot = start;
+        start += count;
+    }
+    let mut position = vec![0usize; n];
+    let mut order = vec![0usize; n];
+    for v in 0..n {
+        position[v] = bin[degree[v]];
+        order[position[v]] = v;
+        bin[degree[v]] += 1;
+    }
+    for d in (1..=max_degree).rev() {
+        bin[d] = bin[d - 1];
+    }
+    bin[0] = 0;
+
+    for i in 0..n {
+        let v = order[i];
+        for &u in undirected.row(v) {
+            let u = u as usize;
+            if degree[u] > degree[v] {
+                // Move `u` to the front of its bucket, then shrink it by one.
+                let du = degree[u];
+                let front = bin[du];
+                let w = order[front];
+                if u != w {
+                    order.swap(position[u], front);
+                    position[w] = position[u];
+                    position[u] = front;
+                }
+                bin[du] += 1;
+                degree[u] -= 1;
+            }
+        }
+    }
+    degree.into_iter().map(|d| d as u32).collect()
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::csr::OwnedCsr;
+
+    fn graph(rows: Vec<Vec<u32>>) -> OwnedCsr {
+        OwnedCsr::from_rows(
+            rows.into_iter()
+                .map(|row| row.into_iter().map(|v| (v, 1.0)).collect::<Vec<_>>()),
+        )
+    }
+
+    /// Peeling reference: repeatedly remove a node of minimum degree.
+    fn reference(rows: &[Vec<u32>]) -> Vec<u32> {
+        let n = rows.len();
+        let mut adjacency = vec![std::collections::BTreeSet::new(); n];
+        for (u, row) in rows.iter().enumerate() {
+            for &v in row {
+                let v = v as usize;
+                if v < n && v != u {
+                    adjacency[u].insert(v);
+                    adjacency[v].insert(u);
+                }
+            }
+        }
+        let mut removed = vec![false; n];
+        let mut core = vec![0u32; n];
+        let mut current = 0;
+        for _ in 0..n {
+            let v = (0..n)
+                .filter(|&v| !removed[v])
+                .min_by_key(|&v| adjacency[v].iter().filter(|&&u| !removed[u]).count())
+                .unwrap();
+            let d = adjacency[v].iter().filter(|&&u| !removed[u]).count() as u32;
+            current = current.max(d);
+            core[v] = current;
+            removed[v] = true;
+        }
+        core
+    }
+
+    #[test]
+    fn finds_nested_cores() {
+        // A 4-clique (core 3) with a triangle hanging off it (core 2), a
+        // pendant (core 1) and an isolated node (core 0).
+        let rows = vec![
+            vec![1, 2, 3],
+            vec![2, 3],
+            vec![3, 4],
+            vec![4, 5],
+            vec![],
+            vec![6],
+            vec![],
+            vec![],
+        ];
+        let csr = graph(rows.clone());
+        let core = core_numbers(&csr.view());
+        assert_eq!(core, vec![3, 3, 3, 3, 2, 1, 1, 0]);
+        assert_eq!(core, reference(&rows));
+    }
+
+    #[test]
+    fn ignores_duplicates_self_loops_and_out_of_range_neighbors() {
+        let csr = graph(vec![vec![1, 1, 0, 7], vec![0, 2], vec![0]]);
+        assert_eq!(core_numbers(&csr.view()), vec![2, 2, 2]);
+        assert!(core_numbers(&graph(vec![]).view()).is_empty());
+    }
+
+    #[test]
+    fn matches_peeling_on_a_random_graph() {
+        let n = 300u32;
+        let mut rng: u64 = 7;
+        let mut rows = vec![Vec::new(); n as usize];
+        for _ in 0..1500 {
+            rng = rng
+                .wrapping_mul(6364136223846793005)
+                .wrapping_add(1442695040888963407);
+            let a = ((rng >> 33) % u64::from(n)) as usize;
+            rng = rng
+                .wrapping_mul(6364136223846793005)
+                .wrapping_add(1442695040888963407);
+            let b = ((rng >> 33) % u64::from(n)) as u32;
+            rows[a].push(b);
+        }
+        let csr = graph(rows.clone());
+        assert_eq!(core_numbers(&csr.view()), reference(&rows));
+    }
+}
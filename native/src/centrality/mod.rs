@@ -0,0 +1,14 @@
+//! Global PageRank and k-core centrality over a CSR call graph.
+//!
+//! Replaces the worker-thread JavaScript implementation in
+//! `src/graph/centrality-algorithms.ts` when the addon is available. Both
+//! kernels read the CSR columns built by `src/graph/csr-snapshot.ts` and keep
+//! its semantics: PageRank follows directed call edges (duplicates and
+//! self-loops included, dangling rank spread uniformly), k-core treats the
+//! graph as undirected and simple.
+
+pub mod kcore;
+pub mod rank;
+pub mod types;
+
+pub use types::{NativeCentrality, NativeCentralityOptions};
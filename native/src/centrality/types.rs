@@ -0,0 +1,25 @@
+//! Napi-rs payload types for the centrality export.
+
+use napi_derive::napi;
+
+#[napi(object)]
+#[derive(Debug, Clone)]
+pub struct NativeCentralityOptions {
+    pub page_rank: bool,
+    pub k_core: bool,
+    /// Upper bound on power iterations (0 = 20).
+    pub max_iterations: u32,
+    pub damping: f64,
+    /// Stop once an iteration moves less than this much rank in total (L1);
+    /// 0 always runs `max_iterations`.
+    pub tolerance: f64,
+}
+
+/// Per-node scores in CSR node order. A disabled kernel returns an empty
+/// column.
+#[napi(object)]
+pub struct NativeCentrality {
+    pub page_rank: napi::bindgen_prelude::Float64Array,
+    pub k_core: napi::bindgen_prelude::Uint32Array,
+    pub page_rank_iterations: u32,
+}
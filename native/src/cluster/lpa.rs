@@ -1,5 +1,14 @@
 use std::collections::HashMap;
 
+use crate::csr::CsrGraph;
+
+/// Communities larger than this are dropped by [`select_communities`]. Even
+/// after edge-type filtering upstream, dispatcher-like functions can still
+/// pull hundreds of unrelated symbols into one community via transitive call
+/// chains. A group this large is not a meaningful cohesive cluster and only
+/// serves to pollute labels.
+pub const MAX_CLUSTER_SIZE: usize = 250;
+
 #[derive(Debug, Clone, PartialEq, Eq)]
 pub struct CommunityResult {
     pub node_labels: HashMap<usize, usize>,
@@ -113,11 +122,81 @@ pub fn label_propagation(
     }
 }
 
+/// Undirected, de-duplicated `(low, high)` edge list of `graph` for
+/// [`label_propagation`]. Self-loops, out-of-range neighbors, edges rejected
+/// by `type_mask` and edges touching a node flagged in `excluded` are dropped.
+pub fn undirected_edges(
+    graph: &CsrGraph<'_>,
+    type_mask: u32,
+    excluded: Option<&[u8]>,
+) -> Vec<(usize, usize)> {
+    let n = graph.node_count();
+    let is_excluded =
+        |node: usize| excluded.is_some_and(|flags| flags.get(node).is_some_and(|f| *f != 0));
+    let mut pairs: Vec<(usize, usize)> = Vec::with_capacity(graph.edge_count());
+    for a in 0..n {
+        if is_excluded(a) {
+            continue;
+        }
+        for edge in graph.edges(a) {
+            let b = graph.neighbor(edge);
+            if b >= n || a == b || is_excluded(b) || !graph.includes(edge, type_mask) {
+                continue;
+            }
+            pairs.push(if a < b { (a, b) } else { (b, a) });
+        }
+    }
+    pairs.sort_unstable();
+    pairs.dedup();
+    pairs
+}
+
+/// Communities with `min_size..=MAX_CLUSTER_SIZE` members, each sorted
+/// ascending, ordered by their first member.
+pub fn select_communities(result: CommunityResult, min_size: usize) -> Vec<Vec<usize>> {
+    let mut kept: Vec<Vec<usize>> = result
+        .communities
+        .into_values()
+        .filter(|members| members.len() >= min_size && members.len() <= MAX_CLUSTER_SIZE)
+        .collect();
+    kept.sort_unstable_by_key(|members| members[0]);
+    kept
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
     use std::time::Instant;
 
+    #[test]
+    fn undirected_edges_filters_and_dedups_csr_rows() {
+        // 0->1, 0->1 (dup), 1->0 (reverse), 1->1 (self), 1->2 (import), 2->3,
+        // 3->9 (out of range); node 3 is excluded.
+        let offsets = [0, 2, 5, 6, 7];
+        let neighbors = [1, 1, 0, 1, 2, 3, 9];
+        let types = [0, 0, 0, 0, 1, 0, 0];
+        let graph = CsrGraph::new(&offsets, &neighbors, None, Some(&types)).unwrap();
+        assert_eq!(
+            undirected_edges(&graph, 0, None),
+            vec![(0, 1), (1, 2), (2, 3)]
+        );
+        assert_eq!(
+            undirected_edges(&graph, 0b01, Some(&[0, 0, 0, 1])),
+            vec![(0, 1)]
+        );
+    }
+
+    #[test]
+    fn select_communities_applies_size_bounds() {
+        let (edges, node_count) = create_graph_with_singletons();
+        let result = label_propagation(&edges, node_count, 100);
+        let kept = select_communities(result.clone(), 3);
+        assert_eq!(kept.len(), 2);
+        assert_eq!(kept[0][0], 0);
+        assert_eq!(kept[1][0], 20);
+        assert!(select_communities(result, 21).is_empty());
+    }
+
     fn create_two_community_graph() -> (Vec<(usize, usize)>, usize) {
         let mut edges = Vec::new();
         for i in 0..50 {
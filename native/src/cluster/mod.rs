@@ -1,5 +1,8 @@
 pub mod lpa;
+pub mod parallel;
 pub mod types;
 
-pub use lpa::{label_propagation, CommunityResult};
+pub use lpa::{
+    label_propagation, select_communities, undirected_edges, CommunityResult, MAX_CLUSTER_SIZE,
+};
 pub use types::{NativeClusterAssignment, NativeClusterEdge, NativeClusterSymbol};
@@ -0,0 +1,410 @@
+//! Parallel and incremental label propagation over an undirected CSR graph.
+//!
+//! [`propagate_full`] runs the same update rule as
+//! [`label_propagation`](super::lpa::label_propagation) (most frequent
+//! neighbor label, smaller labels win ties, labels only ever decrease), but
+//! visits nodes by greedy colour class instead of by node ID. Nodes of one
+//! class share no edge, so a whole class is relabelled in parallel from the
+//! same label snapshot and the result is identical to a sequential pass in
+//! (colour, node) order: deterministic for any thread count.
+//!
+//! [`propagate_incremental`] starts from a previous run's communities, resets
+//! only the changed nodes and re-evaluates their neighborhood with a work
+//! list, so a small edit costs time proportional to the edit, not the graph.
+//!
+//! Both finish with [`connected_communities`]: a label whose members fell
+//! apart (possible once propagation moves nodes, and routine when a previous
+//! assignment is reused across edge removals) is split into its connected
+//! pieces, and every community is named by its smallest node.
+
+use rayon::prelude::*;
+
+/// Label of nodes without edges, which never join a community.
+pub const ISOLATED: u32 = u32::MAX;
+
+/// Symmetric, de-duplicated adjacency; each row is sorted ascending.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct UndirectedGraph {
+    offsets: Vec<u32>,
+    neighbors: Vec<u32>,
+}
+
+impl UndirectedGraph {
+    /// Build from sorted, de-duplicated `(low, high)` pairs, as produced by
+    /// [`undirected_edges`](super::lpa::undirected_edges).
+    pub fn from_pairs(pairs: &[(usize, usize)], node_count: usize) -> Self {
+        let mut degree = vec![0u32; node_count + 1];
+        for &(a, b) in pairs {
+            degree[a + 1] += 1;
+            degree[b + 1] += 1;
+        }
+        for v in 0..node_count {
+            degree[v + 1] += degree[v];
+        }
+        let offsets = degree;
+        let mut cursor = offsets[..node_count].to_vec();
+        let mut neighbors = vec![0u32; pairs.len() * 2];
+        // Pairs are sorted by (low, high), so each row fills in ascending
+        // order: a row first receives its smaller neighbors (as `high`, in
+        // ascending `low` order) and then its larger ones.
+        for &(a, b) in pairs {
+            neighbors[cursor[b] as usize] = a as u32;
+            cursor[b] += 1;
+        }
+        for &(a, b) in pairs {
+            neighbors[cursor[a] as usize] = b as u32;
+            cursor[a] += 1;
+        }
+        Self { offsets, neighbors }
+    }
+
+    pub fn node_count(&self) -> usize {
+        self.offsets.len() - 1
+    }
+
+    pub fn row(&self, node: usize) -> &[u32] {
+        &self.neighbors[self.offsets[node] as usize..self.offsets[node + 1] as usize]
+    }
+}
+
+/// Greedy colouring in node order; isolated nodes are left out.
+pub fn color_classes(graph: &UndirectedGraph) -> Vec<Vec<u32>> {
+    let n = graph.node_count();
+    let mut color = vec![u32::MAX; n];
+    let mut taken: Vec<usize> = Vec::new();
+    let mut classes: Vec<Vec<u32>> = Vec::new();
+    for v in 0..n {
+        let row = graph.row(v);
+        if row.is_empty() {
+            continue;
+        }
+        // `taken[c] == v + 1` marks colour `c` as used by a neighbor of `v`.
+        for &u in row {
+            let c = color[u as usize];
+            if c != u32::MAX {
+                let c = c as usize;
+                if c >= taken.len() {
+                    taken.resize(c + 1, 0);
+                }
+                taken[c] = v + 1;
+            }
+        }
+        let c = (0..).find(|&c| taken.get(c) != Some(&(v + 1))).unwrap();
+        if c == classes.len() {
+            classes.push(Vec::new());
+        }
+        classes[c].push(v as u32);
+        color[v] = c as u32;
+    }
+    classes
+}
+
+/// The label `node` adopts: the most frequent neighbor label, where a tie
+/// (or keeping its own label) goes to the smallest candidate. `scratch` is
+/// reused between calls.
+fn best_label(graph: &UndirectedGraph, labels: &[u32], node: usize, scratch: &mut Vec<u32>) -> u32 {
+    scratch.clear();
+    scratch.extend(graph.row(node).iter().map(|&u| labels[u as usize]));
+    scratch.sort_unstable();
+    let mut max_count = 0;
+    let mut i = 0;
+    while i < scratch.len() {
+        let mut j = i + 1;
+        while j < scratch.len() && scratch[j] == scratch[i] {
+            j += 1;
+        }
+        max_count = max_count.max(j - i);
+        i = j;
+    }
+    let mut best = labels[node];
+    let mut i = 0;
+    while i < scratch.len() {
+        let mut j = i + 1;
+        while j < scratch.len() && scratch[j] == scratch[i] {
+            j += 1;
+        }
+        if j - i == max_count && scratch[i] < best {
+            best = scratch[i];
+        }
+        i = j;
+    }
+    best
+}
+
+/// Label propagation from singleton labels, one parallel step per colour
+/// class. Returns raw labels; see [`connected_communities`].
+pub fn propagate_full(graph: &UndirectedGraph, max_iterations: usize) -> Vec<u32> {
+    let mut labels: Vec<u32> = (0..graph.node_count() as u32).collect();
+    let classes = color_classes(graph);
+    for _ in 0..max_iterations {
+        let mut changed = false;
+        for class in &classes {
+            let updates: Vec<(u32, u32)> = class
+                .par_iter()
+                .map_init(Vec::new, |scratch, &v| {
+                    (v, best_label(graph, &labels, v as usize, scratch))
+                })
+                .filter(|&(v, label)| label != labels[v as usize])
+                .collect();
+            changed |= !updates.is_empty();
+            for (v, label) in updates {
+                labels[v as usize] = label;
+            }
+        }
+        if !changed {
+            break;
+        }
+    }
+    labels
+}
+
+/// Seed labels for [`propagate_incremental`]. `previous_groups[v]` is an
+/// arbitrary key of `v`'s previous community ([`ISOLATED`] for none); each
+/// unchanged node takes the smallest unchanged node of its group as label,
+/// and changed nodes restart from their own ID. Returns the seed labels and
+/// the initial work list: changed nodes and their neighbors, ascending.
+pub fn seed_from_previous(
+    graph: &UndirectedGraph,
+    previous_groups: &[u32],
+    changed: &[u8],
+) -> (Vec<u32>, Vec<u32>) {
+    let n = graph.node_count();
+    let is_changed = |v: usize| changed.get(v).is_some_and(|c| *c != 0);
+    let mut representative: std::collections::HashMap<u32, u32> = std::collections::HashMap::new();
+    for v in 0..n {
+        let group = previous_groups.get(v).copied().unwrap_or(ISOLATED);
+        if group != ISOLATED && !is_changed(v) {
+            representative.entry(group).or_insert(v as u32);
+        }
+    }
+    let mut labels: Vec<u32> = (0..n as u32).collect();
+    let mut queued = vec![false; n];
+    for v in 0..n {
+        if is_changed(v) {
+            queued[v] = true;
+            for &u in graph.row(v) {
+                queued[u as usize] = true;
+            }
+            continue;
+        }
+        let group = previous_groups.get(v).copied().unwrap_or(ISOLATED);
+        if let Some(&rep) = representative.get(&group) {
+            labels[v] = rep;
+        }
+    }
+    let active = (0..n as u32).filter(|&v| queued[v as usize]).collect();
+    (labels, active)
+}
+
+/// Sequential work-list propagation from `labels`: each round visits the
+/// queued nodes in ascending order, and a node that changes label queues
+/// its neighbors for the next round.
+pub fn propagate_incremental(
+    graph: &UndirectedGraph,
+    mut labels: Vec<u32>,
+    mut active: Vec<u32>,
+    max_iterations: usize,
+) -> Vec<u32> {
+    let mut queued = vec![false; graph.node_count()];
+    let mut scratch = Vec::new();
+    for _ in 0..max_iterations {
+        if active.is_empty() {
+            break;
+        }
+        let mut next = Vec::new();
+        for &v in &active {
+            let v = v as usize;
+            if graph.row(v).is_empty() {
+                continue;
+            }
+            let label = best_label(graph, &labels, v, &mut scratch);
+            if label != labels[v] {
+                labels[v] = label;
+                for &u in graph.row(v) {
+                    if !queued[u as usize] {
+                        queued[u as usize] = true;
+                        next.push(u);
+                    }
+                }
+            }
+        }
+        for &u in &next {
+            queued[u as usize] = false;
+        }
+        next.sort_unstable();
+        active = next;
+    }
+    labels
+}
+
+/// Split every label into connected pieces and name each piece by its
+/// smallest node; nodes without edges get [`ISOLATED`].
+pub fn connected_communities(graph: &UndirectedGraph, labels: &[u32]) -> Vec<u32> {
+    let n = graph.node_count();
+    let mut parent: Vec<u32> = (0..n as u32).collect();
+    fn find(parent: &mut [u32], mut v: u32) -> u32 {
+        while parent[v as usize] != v {
+            let grand = parent[parent[v as usize] as usize];
+            parent[v as usize] = grand;
+            v = grand;
+        }
+        v
+    }
+    for v in 0..n {
+        for &u in graph.row(v) {
+            if (u as usize) < v || labels[u as usize] != labels[v] {
+                continue;
+            }
+            let (a, b) = (find(&mut parent, v as u32), find(&mut parent, u));
+            // Union towards the smaller root so each root is its piece's
+            // smallest node.
+            if a < b {
+                parent[b as usize] = a;
+            } else if b < a {
+                parent[a as usize] = b;
+            }
+        }
+    }
+    (0..n)
+        .map(|v| {
+            if graph.row(v).is_empty() {
+                ISOLATED
+            } else {
+                find(&mut parent, v as u32)
+            }
+        })
+        .collect()
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::cluster::lpa::label_propagation;
+    use std::collections::BTreeMap;
+
+    fn cliques(sizes: &[usize], bridges: &[(usize, usize)]) -> (Vec<(usize, usize)>, usize) {
+        let mut pairs = Vec::new();
+        let mut start = 0;
+        for &size in sizes {
+            for i in start..start + size {
+                for j in (i + 1)..start + size {
+                    pairs.push((i, j));
+                }
+            }
+            start += size;
+        }
+        pairs.extend_from_slice(bridges);
+        pairs.sort_unstable();
+        pairs.dedup();
+        (pairs, start)
+    }
+
+    fn groups(labels: &[u32]) -> Vec<Vec<usize>> {
+        let mut by_label: BTreeMap<u32, Vec<usize>> = BTreeMap::new();
+        for (v, &label) in labels.iter().enumerate() {
+            if label != ISOLATED {
+                by_label.entry(label).or_default().push(v);
+            }
+        }
+        by_label.into_values().collect()
+    }
+
+    #[test]
+    fn from_pairs_builds_sorted_symmetric_rows() {
+        let graph = UndirectedGraph::from_pairs(&[(0, 2), (1, 2), (2, 3)], 5);
+        assert_eq!(graph.row(0), &[2]);
+        assert_eq!(graph.row(2), &[0, 1, 3]);
+        assert_eq!(graph.row(3), &[2]);
+        assert!(graph.row(4).is_empty());
+    }
+
+    #[test]
+    fn colour_classes_are_independent_sets() {
+        let (pairs, n) = cliques(&[5, 4], &[(2, 7)]);
+        let graph = UndirectedGraph::from_pairs(&pairs, n);
+        let classes = color_classes(&graph);
+        let mut color = vec![usize::MAX; n];
+        for (c, class) in classes.iter().enumerate() {
+            for &v in class {
+                color[v as usize] = c;
+            }
+        }
+        for &(a, b) in &pairs {
+            assert_ne!(color[a], color[b]);
+        }
+        assert_eq!(classes.len(), 5);
+    }
+
+    #[test]
+    fn full_propagation_finds_the_same_communities_as_sequential_lpa() {
+        let (pairs, n) = cliques(&[30, 20, 12], &[(5, 40), (45, 55)]);
+        let graph = UndirectedGraph::from_pairs(&pairs, n + 3);
+        let labels = connected_communities(&graph, &propagate_full(&graph, 100));
+        assert_eq!(
+            groups(&labels),
+            vec![
+                (0..30).collect::<Vec<_>>(),
+                (30..50).collect(),
+                (50..62).collect()
+            ]
+        );
+        assert_eq!(&labels[62..], &[ISOLATED; 3]);
+
+        let sequential = label_propagation(&pairs, n + 3, 100);
+        let mut expected: Vec<Vec<usize>> = sequential.communities.into_values().collect();
+        expected.sort();
+        assert_eq!(groups(&labels), expected);
+    }
+
+    #[test]
+    fn incremental_matches_full_for_an_added_clique() {
+        let (before, n) = cliques(&[10, 10], &[]);
+        let before_graph = UndirectedGraph::from_pairs(&before, n + 6);
+        let previous = connected_communities(&before_graph, &propagate_full(&before_graph, 100));
+
+        // Six previously isolated nodes become a clique attached to nothing.
+        let (after, _) = cliques(&[10, 10, 6], &[]);
+        let graph = UndirectedGraph::from_pairs(&after, n + 6);
+        let mut changed = vec![0u8; n + 6];
+        changed[20..].fill(1);
+        let (seed, active) = seed_from_previous(&graph, &previous, &changed);
+        assert_eq!(active, (20..26).collect::<Vec<u32>>());
+        let incremental =
+            connected_communities(&graph, &propagate_incremental(&graph, seed, active, 100));
+        let full = connected_communities(&graph, &propagate_full(&graph, 100));
+        assert_eq!(incremental, full);
+    }
+
+    #[test]
+    fn incremental_splits_a_community_whose_bridge_was_removed() {
+        // Two 6-cliques that used to be one community lose the bridge between
+        // them; only the bridge endpoints are marked changed.
+        let n = 12;
+        let previous: Vec<u32> = vec![0; n];
+        let (after, _) = cliques(&[6, 6], &[]);
+        let graph = UndirectedGraph::from_pairs(&after, n);
+        let mut changed = vec![0u8; n];
+        for v in [4, 5, 6, 7] {
+            changed[v] = 1;
+        }
+        let (seed, active) = seed_from_previous(&graph, &previous, &changed);
+        let labels =
+            connected_communities(&graph, &propagate_incremental(&graph, seed, active, 100));
+        assert_eq!(
+            groups(&labels),
+            vec![(0..6).collect::<Vec<_>>(), (6..12).collect()]
+        );
+    }
+
+    #[test]
+    fn incremental_without_changes_keeps_previous_communities() {
+        let (pairs, n) = cliques(&[8, 8, 8], &[(0, 8)]);
+        let graph = UndirectedGraph::from_pairs(&pairs, n);
+        let previous = connected_communities(&graph, &propagate_full(&graph, 100));
+        let (seed, active) = seed_from_previous(&graph, &previous, &vec![0; n]);
+        assert!(active.is_empty());
+        let labels =
+            connected_communities(&graph, &propagate_incremental(&graph, seed, active, 100));
+        assert_eq!(labels, previous);
+    }
+}
@@ -0,0 +1,185 @@
+//! Compressed sparse row graphs over dense `u32` node IDs.
+//!
+//! The TypeScript layer interns symbol IDs once per graph snapshot (see
+//! `src/graph/csr-snapshot.ts`) and hands the columns across napi as typed
+//! arrays. [`CsrGraph`] borrows them in place, so the PPR, LPA and process
+//! tracer kernels can walk the same snapshot without any per-call string
+//! hashing or object conversion.
+//!
+//! Node `u`'s edges are `offsets[u]..offsets[u + 1]`; every per-edge column
+//! (`neighbors`, `weights`, `edge_types`) is indexed by that edge position.
+
+use std::ops::Range;
+
+#[derive(Debug, Clone, Copy)]
+pub struct CsrGraph<'a> {
+    offsets: &'a [u32],
+    neighbors: &'a [u32],
+    weights: Option<&'a [f64]>,
+    edge_types: Option<&'a [u8]>,
+}
+
+impl<'a> CsrGraph<'a> {
+    /// Validate the row structure. Neighbor values are not checked here:
+    /// each kernel skips out-of-range neighbors the same way its object-based
+    /// counterpart does.
+    pub fn new(
+        offsets: &'a [u32],
+        neighbors: &'a [u32],
+        weights: Option<&'a [f64]>,
+        edge_types: Option<&'a [u8]>,
+    ) -> Result<Self, String> {
+        let Some((&first, _)) = offsets.split_first() else {
+            return Err("CSR offsets must have node_count + 1 entries".into());
+        };
+        if first != 0 {
+            return Err("CSR offsets must start at 0".into());
+        }
+        if offsets.windows(2).any(|w| w[0] > w[1]) {
+            return Err("CSR offsets must be non-decreasing".into());
+        }
+        let edge_count = offsets[offsets.len() - 1] as usize;
+        if edge_count != neighbors.len() {
+            return Err(format!(
+                "CSR offsets end at {edge_count} but {} neighbors were given",
+                neighbors.len()
+            ));
+        }
+        if weights.is_some_and(|w| w.len() != edge_count) {
+            return Err("CSR weights must have one entry per edge".into());
+        }
+        if edge_types.is_some_and(|t| t.len() != edge_count) {
+            return Err("CSR edge types must have one entry per edge".into());
+        }
+        Ok(Self {
+            offsets,
+            neighbors,
+            weights,
+            edge_types,
+        })
+    }
+
+    pub fn node_count(&self) -> usize {
+        self.offsets.len() - 1
+    }
+
+    pub fn edge_count(&self) -> usize {
+        self.neighbors.len()
+    }
+
+    /// Edge positions of `node`'s row (empty for out-of-range nodes).
+    pub fn edges(&self, node: usize) -> Range<usize> {
+        if node >= self.node_count() {
+            return 0..0;
+        }
+        self.offsets[node] as usize..self.offsets[node + 1] as usize
+    }
+
+    pub fn neighbor(&self, edge: usize) -> usize {
+        self.neighbors[edge] as usize
+    }
+
+    /// Edge weight, or 1.0 when the graph carries no weight column.
+    pub fn weight(&self, edge: usize) -> f64 {
+        self.weights.map_or(1.0, |w| w[edge])
+    }
+
+    /// Whether `edge` passes `type_mask` (bit `t` selects edge type code `t`;
+    /// 0 selects every edge). Graphs without a type column pass every edge.
+    pub fn includes(&self, edge: usize, type_mask: u32) -> bool {
+        if type_mask == 0 {
+            return true;
+        }
+        match self.edge_types {
+            Some(types) => 1u32
+                .checked_shl(u32::from(types[edge]))
+                .is_some_and(|bit| type_mask & bit != 0),
+            None => true,
+        }
+    }
+}
+
+/// Owned CSR columns, for callers that start from per-row lists.
+#[derive(Debug, Default)]
+pub struct OwnedCsr {
+    pub offsets: Vec<u32>,
+    pub neighbors: Vec<u32>,
+    pub weights: Vec<f64>,
+}
+
+impl OwnedCsr {
+    pub fn from_rows<R, I>(rows: R) -> Self
+    where
+        R: IntoIterator<Item = I>,
+        I: IntoIterator<Item = (u32, f64)>,
+    {
+        let mut csr = Self {
+            offsets: vec![0],
+            ..Self::default()
+        };
+        for row in rows {
+            for (neighbor, weight) in row {
+                csr.neighbors.push(neighbor);
+                csr.weights.push(weight);
+            }
+            csr.offsets.push(csr.neighbors.len() as u32);
+        }
+        csr
+    }
+
+    pub fn view(&self) -> CsrGraph<'_> {
+        CsrGraph {
+            offsets: &self.offsets,
+            neighbors: &self.neighbors,
+            weights: Some(&self.weights),
+            edge_types: None,
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn rejects_malformed_rows() {
+        assert!(CsrGraph::new(&[], &[], None, None).is_err());
+        assert!(CsrGraph::new(&[1, 1], &[0], None, None).is_err());
+        assert!(CsrGraph::new(&[0, 2, 1], &[0, 1], None, None).is_err());
+        assert!(CsrGraph::new(&[0, 2], &[0], None, None).is_err());
+        assert!(CsrGraph::new(&[0, 1], &[0], Some(&[]), None).is_err());
+        assert!(CsrGraph::new(&[0, 1], &[0], None, Some(&[0, 1])).is_err());
+        let empty = CsrGraph::new(&[0], &[], None, None).unwrap();
+        assert_eq!(empty.node_count(), 0);
+    }
+
+    #[test]
+    fn exposes_rows_weights_and_type_filter() {
+        let offsets = [0, 2, 2, 3];
+        let neighbors = [1, 2, 0];
+        let types = [0, 1, 40];
+        let g = CsrGraph::new(&offsets, &neighbors, Some(&[0.5, 1.0, 2.0]), Some(&types)).unwrap();
+        assert_eq!(g.node_count(), 3);
+        assert_eq!(g.edge_count(), 3);
+        assert_eq!(g.edges(0), 0..2);
+        assert_eq!(g.edges(1), 2..2);
+        assert_eq!(g.edges(9), 0..0);
+        assert_eq!(g.neighbor(2), 0);
+        assert_eq!(g.weight(0), 0.5);
+        assert!(g.includes(0, 0b01));
+        assert!(!g.includes(1, 0b01));
+        assert!(g.includes(1, 0));
+        // Codes past the mask width never match a non-zero mask.
+        assert!(!g.includes(2, u32::MAX));
+    }
+
+    #[test]
+    fn owned_csr_flattens_rows_in_order() {
+        let csr = OwnedCsr::from_rows(vec![vec![(1, 1.0), (2, 0.5)], vec![], vec![(0, 2.0)]]);
+        assert_eq!(csr.offsets, vec![0, 2, 2, 3]);
+        assert_eq!(csr.neighbors, vec![1, 2, 0]);
+        let view = csr.view();
+        assert_eq!(view.node_count(), 3);
+        assert_eq!(view.weight(1), 0.5);
+    }
+}
@@ -0,0 +1,99 @@
+//! Per-file text views shared by the enrichment passes.
+//!
+//! Summary, invariant and side-effect extraction used to split the whole
+//! file into lines once per symbol and pass, which made enrichment
+//! O(symbols × file size). A `FileContext` splits the file once; each pass
+//! then borrows the lines it needs.
+
+use std::cell::RefCell;
+use std::collections::HashMap;
+use std::rc::Rc;
+
+use crate::types::NativeRange;
+
+pub struct FileContext<'a> {
+    language: &'a str,
+    /// `content.lines()`, so line semantics (including `\r\n` handling)
+    /// match the per-symbol splits this replaces.
+    lines: Vec<&'a str>,
+    /// Doc comment description per symbol start line, filled on first use.
+    doc_descriptions: RefCell<HashMap<usize, Rc<str>>>,
+}
+
+impl<'a> FileContext<'a> {
+    pub fn new(content: &'a str, language: &'a str) -> Self {
+        Self {
+            language,
+            lines: content.lines().collect(),
+            doc_descriptions: RefCell::new(HashMap::new()),
+        }
+    }
+
+    pub fn language(&self) -> &'a str {
+        self.language
+    }
+
+    pub fn lines(&self) -> &[&'a str] {
+        &self.lines
+    }
+
+    /// Lines of `range`, from the 1-based `start_line` through `end_line`.
+    pub fn range_lines(&self, range: &NativeRange) -> &[&'a str] {
+        let end = (range.end_line as usize).min(self.lines.len());
+        let start = (range.start_line as usize).saturating_sub(1).min(end);
+        &self.lines[start..end]
+    }
+
+    /// The doc comment description for a symbol starting at `start_line`,
+    /// computed by `extract` once per line and shared across passes.
+    pub fn doc_description(&self, start_line: usize, extract: impl FnOnce() -> String) -> Rc<str> {
+        if let Some(description) = self.doc_descriptions.borrow().get(&start_line) {
+            return Rc::clone(description);
+        }
+        let description: Rc<str> = extract().into();
+        self.doc_descriptions
+            .borrow_mut()
+            .insert(start_line, Rc::clone(&description));
+        description
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn range(start_line: u32, end_line: u32) -> NativeRange {
+        NativeRange {
+            start_line,
+            end_line,
+            ..NativeRange::default()
+        }
+    }
+
+    #[test]
+    fn range_lines_are_clamped_to_the_file() {
+        let ctx = FileContext::new("a\r\nb\nc", "ts");
+        assert_eq!(ctx.lines(), ["a", "b", "c"]);
+        assert_eq!(ctx.range_lines(&range(2, 3)), ["b", "c"]);
+        assert_eq!(ctx.range_lines(&range(0, 1)), ["a"]);
+        assert_eq!(ctx.range_lines(&range(3, 9)), ["c"]);
+        assert!(ctx.range_lines(&range(7, 9)).is_empty());
+    }
+
+    #[test]
+    fn doc_descriptions_are_computed_once_per_line() {
+        let ctx = FileContext::new("", "ts");
+        let mut calls = 0;
+        let first = ctx.doc_description(4, || {
+            calls += 1;
+            "Adds".to_string()
+        });
+        let second = ctx.doc_description(4, || {
+            calls += 1;
+            String::new()
+        });
+        assert_eq!(calls, 1);
+        assert_eq!(&*first, "Adds");
+        assert!(Rc::ptr_eq(&first, &second));
+    }
+}
@@ -1,155 +1,557 @@
-use tree_sitter::Node;
+use std::sync::atomic::{AtomicU8, Ordering};
 
-use crate::parse::content_hash::hash_content;
+use sha2::{Digest, Sha256};
+use tree_sitter::{Node, TreeCursor};
+
+/// How literal and visibility details enter the fingerprint.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+#[repr(u8)]
+pub enum FingerprintMode {
+    /// The native engine's historical output: literal subtrees are skipped
+    /// entirely and visibility is the first modifier child. Default, so
+    /// fingerprints already stored by the native engine stay stable.
+    Native = 0,
+    /// Byte-exact `generateAstFingerprint` from `src/indexer/fingerprints.ts`:
+    /// literals contribute their type plus up to 64 UTF-16 units of text, and
+    /// visibility follows the TS `public, private, protected, internal`
+    /// priority.
+    TsCompat = 1,
+}
+
+impl FingerprintMode {
+    pub fn parse(mode: &str) -> Option<Self> {
+        match mode {
+            "native" => Some(Self::Native),
+            "ts" | "ts-compat" => Some(Self::TsCompat),
+            _ => None,
+        }
+    }
+
+    pub fn as_str(self) -> &'static str {
+        match self {
+            Self::Native => "native",
+            Self::TsCompat => "ts-compat",
+        }
+    }
+}
+
+static MODE: AtomicU8 = AtomicU8::new(FingerprintMode::Native as u8);
+
+/// Process-wide mode used by [`generate_ast_fingerprint`].
+pub fn fingerprint_mode() -> FingerprintMode {
+    match MODE.load(Ordering::Relaxed) {
+        1 => FingerprintMode::TsCompat,
+        _ => FingerprintMode::Native,
+    }
+}
+
+pub fn set_fingerprint_mode(mode: FingerprintMode) {
+    MODE.store(mode as u8, Ordering::Relaxed);
+}
+
+const VISIBILITY_MODIFIERS: [&str; 4] = ["public", "private", "protected", "internal"];
+const LITERAL_TEXT_UTF16_UNITS: usize = 64;
 
 /// Generate a stable AST fingerprint for a symbol node.
 ///
-/// Exact parity with TypeScript `generateAstFingerprint` in `fingerprints.ts`.
+/// Parts, in order and pipe-delimited: type, name, params count, async,
+/// static, visibility, returnType, subtree hash; SHA-256 of the result. The
+/// subtree hash is SHA-256 of comma-delimited node types, skipping comments.
 ///
-/// Algorithm:
-/// 1. Build pipe-delimited parts: type, name, params count, async, static,
-///    visibility, returnType, subtree hash
-/// 2. Subtree hash: comma-delimited node types, skipping comments and literals
-/// 3. Hash via SHA-256
+/// Everything is streamed into the hashers: modifiers come from one pass over
+/// the node's children and the subtree is walked with a cursor, so no string
+/// or stack grows with subtree size.
 pub fn generate_ast_fingerprint(node: Node<'_>, source: &[u8]) -> String {
-    let mut parts: Vec<String> = Vec::new();
+    generate_ast_fingerprint_with_mode(node, source, fingerprint_mode())
+}
 
-    // type:{node_type}
-    parts.push(format!("type:{}", node.kind()));
+pub fn generate_ast_fingerprint_with_mode(
+    node: Node<'_>,
+    source: &[u8],
+    mode: FingerprintMode,
+) -> String {
+    let mut hasher = Sha256::new();
+    hasher.update(b"type:");
+    hasher.update(node.kind().as_bytes());
 
-    // name:{name}
     if let Some(name_node) = node.child_by_field_name("name") {
-        let name_text = name_node.utf8_text(source).unwrap_or("");
-        parts.push(format!("name:{name_text}"));
+        hasher.update(b"|name:");
+        hasher.update(name_node.utf8_text(source).unwrap_or("").as_bytes());
     }
 
-    // params:{count}
-    let mut cursor = node.walk();
-    for child in node.children(&mut cursor) {
-        if child.kind() == "formal_parameters" || child.kind() == "parameters" {
-            let param_count = count_params(&child);
-            parts.push(format!("params:{param_count}"));
-            break;
-        }
+    let modifiers = ChildModifiers::scan(node);
+    if let Some(count) = modifiers.param_count {
+        hasher.update(b"|params:");
+        update_decimal(&mut hasher, count);
     }
-
-    // async:true
-    let mut cursor2 = node.walk();
-    for child in node.children(&mut cursor2) {
-        if child.kind() == "async" {
-            parts.push("async:true".into());
-            break;
-        }
+    if modifiers.is_async {
+        hasher.update(b"|async:true");
+    }
+    if modifiers.is_static {
+        hasher.update(b"|static:true");
+    }
+    if let Some(vis) = modifiers.visibility(mode) {
+        hasher.update(b"|visibility:");
+        hasher.update(vis.as_bytes());
     }
 
-    // static:true
-    let mut cursor3 = node.walk();
-    for child in node.children(&mut cursor3) {
-        if child.kind() == "static" {
-            parts.push("static:true".into());
-            break;
-        }
+    if node.child_by_field_name("return_type").is_some()
+        || node.child_by_field_name("type").is_some()
+    {
+        hasher.update(b"|returnType:true");
     }
 
-    // visibility:{vis}
-    let visibility_modifiers = ["public", "private", "protected", "internal"];
-    let mut cursor4 = node.walk();
-    for child in node.children(&mut cursor4) {
-        let mut found = false;
-        for vis in &visibility_modifiers {
-            if child.kind() == *vis {
-                parts.push(format!("visibility:{vis}"));
-                found = true;
-                break;
+    hasher.update(b"|subtree:");
+    hasher.update(subtree_hash_hex(node, source, mode));
+
+    hex::encode(hasher.finalize())
+}
+
+/// Backwards-compatible wrapper for callers that pass source explicitly.
+pub fn generate_ast_fingerprint_with_source(node: Node<'_>, source: &[u8]) -> String {
+    generate_ast_fingerprint(node, source)
+}
+
+/// Modifier facts gathered in a single pass over a node's direct children.
+#[derive(Default)]
+struct ChildModifiers {
+    param_count: Option<usize>,
+    is_async: bool,
+    is_static: bool,
+    /// Index into [`VISIBILITY_MODIFIERS`] of the first modifier child.
+    first_visibility: Option<usize>,
+    /// Bit `i` set when a `VISIBILITY_MODIFIERS[i]` child exists.
+    visibility_mask: u8,
+}
+
+impl ChildModifiers {
+    fn scan(node: Node<'_>) -> Self {
+        let mut out = Self::default();
+        let mut cursor = node.walk();
+        for child in node.children(&mut cursor) {
+            let kind = child.kind();
+            match kind {
+                "formal_parameters" | "parameters" if out.param_count.is_none() => {
+                    out.param_count = Some(count_params(child));
+                }
+                "async" => out.is_async = true,
+                "static" => out.is_static = true,
+                _ => {
+                    if let Some(i) = VISIBILITY_MODIFIERS.iter().position(|v| *v == kind) {
+                        out.first_visibility.get_or_insert(i);
+                        out.visibility_mask |= 1 << i;
+                    }
+                }
             }
         }
-        if found {
-            break;
-        }
+        out
     }
 
-    // returnType:true
-    let has_return = node.child_by_field_name("return_type").is_some()
-        || node.child_by_field_name("type").is_some();
-    if has_return {
-        parts.push("returnType:true".into());
+    fn visibility(&self, mode: FingerprintMode) -> Option<&'static str> {
+        let index = match mode {
+            FingerprintMode::Native => self.first_visibility,
+            FingerprintMode::TsCompat => {
+                (self.visibility_mask != 0).then(|| self.visibility_mask.trailing_zeros() as usize)
+            }
+        };
+        index.map(|i| VISIBILITY_MODIFIERS[i])
     }
-
-    // subtree:{hash}
-    let subtree_hash = compute_subtree_hash(node);
-    parts.push(format!("subtree:{subtree_hash}"));
-
-    hash_content(&parts.join("|"))
 }
 
 /// Count parameters in a formal_parameters or parameters node.
 /// Matches the TypeScript logic that counts required_parameter,
 /// optional_parameter, identifier, and pattern children.
-fn count_params(params_node: &Node<'_>) -> usize {
-    let mut count = 0;
+fn count_params(params_node: Node<'_>) -> usize {
     let mut cursor = params_node.walk();
-    for child in params_node.children(&mut cursor) {
-        match child.kind() {
-            "required_parameter" | "optional_parameter" | "identifier" | "pattern" => {
-                count += 1;
-            }
-            _ => {}
+    params_node
+        .children(&mut cursor)
+        .filter(|child| {
+            matches!(
+                child.kind(),
+                "required_parameter" | "optional_parameter" | "identifier" | "pattern"
+            )
+        })
+        .count()
+}
+
+fn is_literal(kind: &str) -> bool {
+    kind.contains("string")
+        || kind.contains("number")
+        || kind == "true"
+        || kind == "false"
+        || kind == "null"
+        || kind == "undefined"
+}
+
+fn update_decimal(hasher: &mut Sha256, mut value: usize) {
+    let mut digits = [0u8; 20];
+    let mut at = digits.len();
+    loop {
+        at -= 1;
+        digits[at] = b'0' + (value % 10) as u8;
+        value /= 10;
+        if value == 0 {
+            break;
         }
     }
-    count
+    hasher.update(&digits[at..]);
 }
 
-/// Compute subtree hash: collect normalized node types, join with comma,
-/// hash with SHA-256.
-fn compute_subtree_hash(node: Node<'_>) -> String {
-    let mut parts: Vec<String> = Vec::new();
-    collect_normalized_parts(node, &mut parts);
-    hash_content(&parts.join(","))
+/// Hash the first 64 UTF-16 code units of `text`, as JS `text.slice(0, 64)`
+/// does. A surrogate pair cut in half leaves a lone surrogate, which Node
+/// encodes as U+FFFD when hashing.
+fn update_literal_text(hasher: &mut Sha256, text: &str) {
+    let mut units = 0;
+    for (offset, ch) in text.char_indices() {
+        let width = ch.len_utf16();
+        if units + width > LITERAL_TEXT_UTF16_UNITS {
+            hasher.update(&text.as_bytes()[..offset]);
+            if units < LITERAL_TEXT_UTF16_UNITS {
+                hasher.update("\u{FFFD}".as_bytes());
+            }
+            return;
+        }
+        units += width;
+    }
+    hasher.update(text.as_bytes());
 }
 
-/// Iteratively collect node types, skipping comments and literals.
-/// Uses an explicit stack to avoid stack overflow on deeply-nested ASTs.
-/// Exact match to TypeScript `collectNormalizedParts`.
-fn collect_normalized_parts(root: Node<'_>, parts: &mut Vec<String>) {
-    let mut stack = vec![root];
+/// Subtree hash in pre-order over all children except comments (the root is
+/// always visited).
+fn subtree_hash_hex(root: Node<'_>, source: &[u8], mode: FingerprintMode) -> [u8; 64] {
+    let mut hasher = Sha256::new();
+    let mut first = true;
+    let mut cursor = root.walk();
+    let mut depth = 0usize;
 
-    while let Some(node) = stack.pop() {
+    'visit: loop {
+        let node = cursor.node();
         let kind = node.kind();
+        let descend = if !is_literal(kind) {
+            separator(&mut hasher, &mut first);
+            hasher.update(kind.as_bytes());
+            true
+        } else {
+            if mode == FingerprintMode::TsCompat {
+                separator(&mut hasher, &mut first);
+                hasher.update(kind.as_bytes());
+                hasher.update(b",lit:");
+                let text =
+                    String::from_utf8_lossy(source.get(node.byte_range()).unwrap_or_default());
+                update_literal_text(&mut hasher, &text);
+            }
+            false
+        };
 
-        let is_literal = kind.contains("string")
-            || kind.contains("number")
-            || kind == "true"
-            || kind == "false"
-            || kind == "null"
-            || kind == "undefined";
-
-        if !is_literal {
-            parts.push(kind.to_string());
+        if descend && cursor.goto_first_child() {
+            depth += 1;
+            if skip_comments(&mut cursor) {
+                continue 'visit;
+            }
+            cursor.goto_parent();
+            depth -= 1;
+        }
 
-            // Push children in reverse order so left-most child is processed first
-            let child_count = node.child_count();
-            for i in (0..child_count).rev() {
-                if let Some(child) = node.child(i) {
-                    if child.kind() != "comment" {
-                        stack.push(child);
-                    }
-                }
+        loop {
+            if depth == 0 {
+                break 'visit;
+            }
+            if cursor.goto_next_sibling() && skip_comments(&mut cursor) {
+                continue 'visit;
             }
+            cursor.goto_parent();
+            depth -= 1;
         }
     }
+
+    let mut hex_out = [0u8; 64];
+    hex::encode_to_slice(hasher.finalize(), &mut hex_out).expect("SHA-256 hex is exactly 64 bytes");
+    hex_out
 }
 
-/// Backwards-compatible wrapper for callers that pass source explicitly.
-pub fn generate_ast_fingerprint_with_source(node: Node<'_>, source: &[u8]) -> String {
-    generate_ast_fingerprint(node, source)
+fn separator(hasher: &mut Sha256, first: &mut bool) {
+    if *first {
+        *first = false;
+    } else {
+        hasher.update(b",");
+    }
+}
+
+/// Advance past comment siblings. Returns false when only comments remain
+/// (the cursor is then on the last sibling).
+fn skip_comments(cursor: &mut TreeCursor<'_>) -> bool {
+    while cursor.node().kind() == "comment" {
+        if !cursor.goto_next_sibling() {
+            return false;
+        }
+    }
+    true
 }
 
 #[cfg(test)]
 mod tests {
+    use super::*;
+    use crate::parse::content_hash::hash_content;
+
+    /// The string-building implementation the native engine shipped before
+    /// the streaming rewrite; Native mode must reproduce it byte for byte.
+    fn legacy_native(node: Node<'_>, source: &[u8]) -> String {
+        let mut parts: Vec<String> = vec![format!("type:{}", node.kind())];
+        if let Some(name_node) = node.child_by_field_name("name") {
+            parts.push(format!(
+                "name:{}",
+                name_node.utf8_text(source).unwrap_or("")
+            ));
+        }
+        let children: Vec<Node<'_>> = {
+            let mut cursor = node.walk();
+            node.children(&mut cursor).collect()
+        };
+        if let Some(params) = children
+            .iter()
+            .find(|c| c.kind() == "formal_parameters" || c.kind() == "parameters")
+        {
+            parts.push(format!("params:{}", count_params(*params)));
+        }
+        if children.iter().any(|c| c.kind() == "async") {
+            parts.push("async:true".into());
+        }
+        if children.iter().any(|c| c.kind() == "static") {
+            parts.push("static:true".into());
+        }
+        if let Some(vis) = children
+            .iter()
+            .find_map(|c| VISIBILITY_MODIFIERS.iter().find(|v| **v == c.kind()))
+        {
+            parts.push(format!("visibility:{vis}"));
+        }
+        if node.child_by_field_name("return_type").is_some()
+            || node.child_by_field_name("type").is_some()
+        {
+            parts.push("returnType:true".into());
+        }
+        let mut kinds: Vec<String> = Vec::new();
+        let mut stack = vec![node];
+        while let Some(n) = stack.pop() {
+            if is_literal(n.kind()) {
+                continue;
+            }
+            kinds.push(n.kind().to_string());
+            for i in (0..n.child_count()).rev() {
+                let child = n.child(i).unwrap();
+                if child.kind() != "comment" {
+                    stack.push(child);
+                }
+            }
+        }
+        parts.push(format!("subtree:{}", hash_content(&kinds.join(","))));
+        hash_content(&parts.join("|"))
+    }
+
+    /// Line-for-line port of `generateAstFingerprint` in `fingerprints.ts`.
+    fn ts_reference(node: Node<'_>, source: &[u8]) -> String {
+        fn collect(node: Node<'_>, source: &[u8], parts: &mut Vec<String>) {
+            let kind = node.kind();
+            if is_literal(kind) {
+                parts.push(kind.to_string());
+                let text = String::from_utf8_lossy(&source[node.byte_range()]);
+                let units: Vec<u16> = text.encode_utf16().collect();
+                let sliced = &units[..units.len().min(64)];
+                parts.push(format!("lit:{}", String::from_utf16_lossy(sliced)));
+                return;
+            }
+            parts.push(kind.to_string());
+            let mut cursor = node.walk();
+            for child in node.children(&mut cursor) {
+                if child.kind() != "comment" {
+                    collect(child, source, parts);
+                }
+            }
+        }
+
+        let mut parts: Vec<String> = vec![format!("type:{}", node.kind())];
+        if let Some(name_node) = node.child_by_field_name("name") {
+            parts.push(format!(
+                "name:{}",
+                name_node.utf8_text(source).unwrap_or("")
+            ));
+        }
+        let children: Vec<Node<'_>> = {
+            let mut cursor = node.walk();
+            node.children(&mut cursor).collect()
+        };
+        if let Some(params) = children
+            .iter()
+            .find(|c| c.kind() == "formal_parameters" || c.kind() == "parameters")
+        {
+            parts.push(format!("params:{}", count_params(*params)));
+        }
+        if children.iter().any(|c| c.kind() == "async") {
+            parts.push("async:true".into());
+        }
+        if children.iter().any(|c| c.kind() == "static") {
+            parts.push("static:true".into());
+        }
+        for vis in VISIBILITY_MODIFIERS {
+            if children.iter().any(|c| c.kind() == vis) {
+                parts.push(format!("visibility:{vis}"));
+                break;
+            }
+        }
+        if node.child_by_field_name("return_type").is_some()
+            || node.child_by_field_name("type").is_some()
+        {
+            parts.push("returnType:true".into());
+        }
+        let mut subtree: Vec<String> = Vec::new();
+        collect(node, source, &mut subtree);
+        parts.push(format!("subtree:{}", hash_content(&subtree.join(","))));
+        hash_content(&parts.join("|"))
+    }
+
+    fn parse(language: &str, source: &str) -> tree_sitter::Tree {
+        crate::lang::with_cached_parser(language, |p| p.parse(source, None))
+            .flatten()
+            .expect("parse")
+    }
+
+    fn for_each_named(root: Node<'_>, mut visit: impl FnMut(Node<'_>)) {
+        let mut stack = vec![root];
+        while let Some(node) = stack.pop() {
+            visit(node);
+            for i in (0..node.named_child_count()).rev() {
+                stack.push(node.named_child(i).unwrap());
+            }
+        }
+    }
+
+    const FIXTURES: &[(&str, &str)] = &[
+        (
+            "ts",
+            r#"
+// leading comment
+export class Calc {
+  private static readonly NAME = "calcs \u{1F600} 😀😀😀😀😀😀😀😀😀😀😀😀😀😀😀😀😀😀😀😀😀😀😀😀😀😀😀😀😀😀😀 tail";
+  public async add(a: number, b?: number): Promise<number> {
+    /* inline */ return a + (b ?? 0) + 42;
+  }
+  protected render({ x }: { x: string }) { return `t${x}`; }
+}
+export function run(flag = true, value = null) { return undefined; }
+"#,
+        ),
+        (
+            "py",
+            r#"
+class Greeter:
+    # comment
+    def greet(self, name, *rest):
+        return "hello " + name + str(3.14)
+
+async def main():
+    await Greeter().greet("x")
+"#,
+        ),
+        (
+            "cs",
+            r#"
+public class Box {
+    internal protected static int Count(string s) { return s.Length + 1; }
+}
+"#,
+        ),
+    ];
+
+    #[test]
+    fn native_mode_matches_the_legacy_string_builder() {
+        for (language, source) in FIXTURES {
+            let tree = parse(language, source);
+            for_each_named(tree.root_node(), |node| {
+                assert_eq!(
+                    generate_ast_fingerprint_with_mode(
+                        node,
+                        source.as_bytes(),
+                        FingerprintMode::Native
+                    ),
+                    legacy_native(node, source.as_bytes()),
+                    "{language} {} at {:?}",
+                    node.kind(),
+                    node.start_position()
+                );
+            });
+        }
+    }
+
+    #[test]
+    fn ts_compat_mode_matches_fingerprints_ts() {
+        let mut literal_nodes = 0;
+        for (language, source) in FIXTURES {
+            let tree = parse(language, source);
+            for_each_named(tree.root_node(), |node| {
+                if is_literal(node.kind()) {
+                    literal_nodes += 1;
+                }
+                assert_eq!(
+                    generate_ast_fingerprint_with_mode(
+                        node,
+                        source.as_bytes(),
+                        FingerprintMode::TsCompat
+                    ),
+                    ts_reference(node, source.as_bytes()),
+                    "{language} {} at {:?}",
+                    node.kind(),
+                    node.start_position()
+                );
+            });
+        }
+        assert!(literal_nodes > 0, "fixtures must exercise literal handling");
+    }
+
+    #[test]
+    fn literal_text_is_cut_at_64_utf16_units() {
+        let hash = |text: &str| {
+            let mut hasher = Sha256::new();
+            update_literal_text(&mut hasher, text);
+            hex::encode(hasher.finalize())
+        };
+        let ascii = "a".repeat(70);
+        assert_eq!(hash(&ascii), hash_content(&ascii[..64]));
+        // 63 ASCII units followed by a surrogate pair: JS keeps the high
+        // surrogate alone, which Node hashes as U+FFFD.
+        let split = format!("{}😀", "a".repeat(63));
+        assert_eq!(
+            hash(&split),
+            hash_content(&format!("{}\u{FFFD}", "a".repeat(63)))
+        );
+        assert_eq!(hash("short"), hash_content("short"));
+    }
+
+    #[test]
+    fn visibility_priority_depends_on_mode() {
+        // Children in source order `protected`, `public`.
+        let modifiers = ChildModifiers {
+            first_visibility: Some(2),
+            visibility_mask: 0b0101,
+            ..ChildModifiers::default()
+        };
+        assert_eq!(
+            modifiers.visibility(FingerprintMode::Native),
+            Some("protected")
+        );
+        assert_eq!(
+            modifiers.visibility(FingerprintMode::TsCompat),
+            Some("public")
+        );
+        assert_eq!(
+            ChildModifiers::default().visibility(FingerprintMode::TsCompat),
+            None
+        );
+    }
+
     #[test]
     fn test_is_literal_detection() {
         // Verify the literal detection logic matches TypeScript
-        let literals = vec![
+        for lit in [
             "string",
             "string_fragment",
             "number",
@@ -157,26 +559,23 @@ mod tests {
             "false",
             "null",
             "undefined",
-        ];
-        for lit in literals {
-            let is_lit = lit.contains("string")
-                || lit.contains("number")
-                || lit == "true"
-                || lit == "false"
-                || lit == "null"
-                || lit == "undefined";
-            assert!(is_lit, "{lit} should be detected as literal");
-        }
-
-        let non_literals = vec!["identifier", "function_declaration", "call_expression"];
-        for nl in non_literals {
-            let is_lit = nl.contains("string")
-                || nl.contains("number")
-                || nl == "true"
-                || nl == "false"
-                || nl == "null"
-                || nl == "undefined";
-            assert!(!is_lit, "{nl} should not be detected as literal");
+        ] {
+            assert!(is_literal(lit), "{lit} should be detected as literal");
+        }
+        for nl in ["identifier", "function_declaration", "call_expression"] {
+            assert!(!is_literal(nl), "{nl} should not be detected as literal");
+        }
+    }
+
+    #[test]
+    fn mode_names_round_trip() {
+        for mode in [FingerprintMode::Native, FingerprintMode::TsCompat] {
+            assert_eq!(FingerprintMode::parse(mode.as_str()), Some(mode));
         }
+        assert_eq!(
+            FingerprintMode::parse("ts"),
+            Some(FingerprintMode::TsCompat)
+        );
+        assert_eq!(FingerprintMode::parse("sha1"), None);
     }
 }
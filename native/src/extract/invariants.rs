@@ -2,6 +2,7 @@ use regex::Regex;
 use std::collections::HashSet;
 use std::sync::LazyLock;
 
+use super::file_context::FileContext;
 use crate::types::NativeParsedSymbol;
 
 /// Extract invariants from a symbol's code and JSDoc.
@@ -14,15 +15,15 @@ use crate::types::NativeParsedSymbol;
 /// - `assert()` calls
 /// - Guard clauses: `if (!x) throw/return`
 /// - Null/undefined checks: `if (x === null || x === undefined) throw`
-pub fn extract_invariants(symbol: &NativeParsedSymbol, file_content: &str) -> Vec<String> {
+pub fn extract_invariants(symbol: &NativeParsedSymbol, ctx: &FileContext) -> Vec<String> {
     let mut invariants = Vec::new();
 
     // Extract JSDoc invariants
-    let jsdoc = extract_jsdoc_invariants(symbol, file_content);
+    let jsdoc = extract_jsdoc_invariants(symbol, ctx);
     invariants.extend(jsdoc);
 
     // Extract code-level invariants
-    let lines = get_symbol_lines(symbol, file_content);
+    let lines = ctx.range_lines(&symbol.range);
 
     static RE_ASSERT: LazyLock<Regex> = LazyLock::new(|| Regex::new(r"assert\(([^)]+)\)").unwrap());
     static RE_ASSERT_NO_PARENS: LazyLock<Regex> =
@@ -46,7 +47,7 @@ pub fn extract_invariants(symbol: &NativeParsedSymbol, file_content: &str) -> Ve
     static RE_JAVA_NONNULL: LazyLock<Regex> =
         LazyLock::new(|| Regex::new(r"Objects\.requireNonNull\s*\(").unwrap());
 
-    for line in &lines {
+    for line in lines {
         // assert() calls
         if line.contains("assert(") {
             if let Some(caps) = RE_ASSERT.captures(line) {
@@ -117,9 +118,9 @@ pub fn extract_invariants(symbol: &NativeParsedSymbol, file_content: &str) -> Ve
     invariants
 }
 
-fn extract_jsdoc_invariants(symbol: &NativeParsedSymbol, file_content: &str) -> Vec<String> {
+fn extract_jsdoc_invariants(symbol: &NativeParsedSymbol, ctx: &FileContext) -> Vec<String> {
     let mut invariants = Vec::new();
-    let lines: Vec<&str> = file_content.lines().collect();
+    let lines = ctx.lines();
     let start_line = symbol.range.start_line as usize;
 
     // Walk backwards to find JSDoc
@@ -194,10 +195,3 @@ fn extract_jsdoc_invariants(symbol: &NativeParsedSymbol, file_content: &str) ->
 
     invariants
 }
-
-fn get_symbol_lines<'a>(symbol: &NativeParsedSymbol, file_content: &'a str) -> Vec<&'a str> {
-    let lines: Vec<&str> = file_content.lines().collect();
-    let start = (symbol.range.start_line as usize).saturating_sub(1);
-    let end = (symbol.range.end_line as usize).min(lines.len());
-    lines[start..end].to_vec()
-}
@@ -1,4 +1,5 @@
 pub mod calls;
+pub mod file_context;
 pub mod fingerprint;
 pub mod imports;
 pub mod invariants;
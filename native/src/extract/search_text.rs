@@ -34,7 +34,7 @@ pub fn build_search_text(
     normalized.join(" ")
 }
 
-fn split_identifier_like_text(input: &str) -> Vec<String> {
+pub fn split_identifier_like_text(input: &str) -> Vec<String> {
     let mut result = Vec::new();
     let mut current = String::new();
     let chars: Vec<char> = input.chars().collect();
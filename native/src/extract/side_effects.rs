@@ -2,6 +2,7 @@ use regex::Regex;
 use std::collections::HashSet;
 use std::sync::LazyLock;
 
+use super::file_context::FileContext;
 use crate::types::NativeParsedSymbol;
 
 /// Detect side effects in a symbol's code.
@@ -14,9 +15,9 @@ use crate::types::NativeParsedSymbol;
 /// - Database query (db.query, pool.execute, etc.)
 /// - Global state mutation (globalThis, window, document, localStorage)
 /// - Environment access (process.env, process.cwd, import.meta.env)
-pub fn extract_side_effects(symbol: &NativeParsedSymbol, file_content: &str) -> Vec<String> {
+pub fn extract_side_effects(symbol: &NativeParsedSymbol, ctx: &FileContext) -> Vec<String> {
     let mut effects = Vec::new();
-    let lines = get_symbol_lines(symbol, file_content);
+    let lines = ctx.range_lines(&symbol.range);
 
     static NETWORK_PATTERNS: LazyLock<Vec<Regex>> = LazyLock::new(|| {
         vec![
@@ -103,7 +104,7 @@ pub fn extract_side_effects(symbol: &NativeParsedSymbol, file_content: &str) ->
         ]
     });
 
-    for line in &lines {
+    for line in lines {
         // Network I/O
         for pattern in NETWORK_PATTERNS.iter() {
             if pattern.is_match(line) {
@@ -167,10 +168,3 @@ pub fn extract_side_effects(symbol: &NativeParsedSymbol, file_content: &str) ->
     effects.retain(|item| seen.insert(item.clone()));
     effects
 }
-
-fn get_symbol_lines<'a>(symbol: &NativeParsedSymbol, file_content: &'a str) -> Vec<&'a str> {
-    let lines: Vec<&str> = file_content.lines().collect();
-    let start = (symbol.range.start_line as usize).saturating_sub(1);
-    let end = (symbol.range.end_line as usize).min(lines.len());
-    lines[start..end].to_vec()
-}
@@ -1,6 +1,7 @@
 use regex::Regex;
 use std::sync::LazyLock;
 
+use super::file_context::FileContext;
 use crate::types::NativeParsedSymbol;
 
 const ROLE_SUFFIXES: &[(&str, &str)] = &[
@@ -62,10 +63,10 @@ struct BodySignals {
 
 /// Analyze a function body for behavioral patterns using regex/string matching.
 /// Skips comment lines. Caps scan at MAX_BODY_SCAN_LINES.
-fn analyze_body_patterns(symbol: &NativeParsedSymbol, file_content: &str) -> BodySignals {
+fn analyze_body_patterns(symbol: &NativeParsedSymbol, ctx: &FileContext) -> BodySignals {
     let mut signals = BodySignals::default();
 
-    let all_lines: Vec<&str> = file_content.lines().collect();
+    let all_lines = ctx.lines();
     let start = symbol.range.start_line as usize;
     let end = symbol.range.end_line as usize;
     if start >= all_lines.len() || end > all_lines.len() || start >= end {
@@ -597,9 +598,9 @@ fn generate_prefix_summary(
 
 fn generate_behavioral_function_summary(
     symbol: &NativeParsedSymbol,
-    file_content: &str,
+    ctx: &FileContext,
 ) -> Option<String> {
-    let signals = analyze_body_patterns(symbol, file_content);
+    let signals = analyze_body_patterns(symbol, ctx);
 
     // Derive subject from name: split camelCase, drop the first word (verb)
     let words = split_camel_case(&symbol.name);
@@ -794,12 +795,11 @@ fn generate_behavioral_function_summary(
 /// Priority:
 /// 1. JSDoc @description (first 1-2 sentences)
 /// 2. Auto-generated from camelCase name + param context + return type
-pub fn generate_summary(symbol: &NativeParsedSymbol, file_content: &str, language: &str) -> String {
-    let jsdoc = extract_doc_comment(symbol, file_content, language);
+pub fn generate_summary(symbol: &NativeParsedSymbol, ctx: &FileContext) -> String {
+    let description = doc_description(symbol, ctx);
 
-    if !jsdoc.description.is_empty() {
-        let sentences: Vec<&str> = jsdoc
-            .description
+    if !description.is_empty() {
+        let sentences: Vec<&str> = description
             .split(|c| c == '.' || c == '!' || c == '?')
             .filter(|s| !s.trim().is_empty())
             .collect();
@@ -818,7 +818,7 @@ pub fn generate_summary(symbol: &NativeParsedSymbol, file_content: &str, languag
     // Dispatch to per-kind generators for non-function/method symbols.
     match symbol.kind.as_str() {
         "function" | "method" => {
-            return generate_behavioral_function_summary(symbol, file_content).unwrap_or_default();
+            return generate_behavioral_function_summary(symbol, ctx).unwrap_or_default();
         }
         "class" => {
             if let Some(s) = generate_class_summary(symbol) {
@@ -861,9 +861,16 @@ pub fn generate_summary(symbol: &NativeParsedSymbol, file_content: &str, languag
 }
 
 /// Check whether a symbol has a doc comment (without generating the summary).
-pub fn has_doc_comment(symbol: &NativeParsedSymbol, file_content: &str, language: &str) -> bool {
-    let jsdoc = extract_doc_comment(symbol, file_content, language);
-    !jsdoc.description.is_empty()
+pub fn has_doc_comment(symbol: &NativeParsedSymbol, ctx: &FileContext) -> bool {
+    !doc_description(symbol, ctx).is_empty()
+}
+
+/// The symbol's doc comment description, parsed once per file context.
+fn doc_description(symbol: &NativeParsedSymbol, ctx: &FileContext) -> std::rc::Rc<str> {
+    let start_line = symbol.range.start_line as usize;
+    ctx.doc_description(start_line, || {
+        extract_doc_comment(start_line, ctx.lines(), ctx.language()).description
+    })
 }
 
 struct JSDoc {
@@ -878,54 +885,48 @@ struct JSDocParam {
     description: String,
 }
 
-fn extract_jsdoc(symbol: &NativeParsedSymbol, file_content: &str) -> JSDoc {
-    let lines: Vec<&str> = file_content.lines().collect();
-    let start_line = symbol.range.start_line as usize;
-    let jsdoc_lines = extract_preceding_block_comment(&lines, start_line, "/**");
+fn extract_jsdoc(lines: &[&str], start_line: usize) -> JSDoc {
+    let jsdoc_lines = extract_preceding_block_comment(lines, start_line, "/**");
     parse_doc_comment(&jsdoc_lines.join("\n"))
 }
 
-fn extract_doc_comment(symbol: &NativeParsedSymbol, file_content: &str, language: &str) -> JSDoc {
-    let lines: Vec<&str> = file_content.lines().collect();
-    let start_line = symbol.range.start_line as usize;
-
+fn extract_doc_comment(start_line: usize, lines: &[&str], language: &str) -> JSDoc {
     match language {
         "py" => {
-            if let Some(docstring) = extract_python_docstring(&lines, start_line) {
+            if let Some(docstring) = extract_python_docstring(lines, start_line) {
                 return parse_doc_comment(&docstring);
             }
 
-            let comment_lines = extract_preceding_line_comments(&lines, start_line, &["#"]);
+            let comment_lines = extract_preceding_line_comments(lines, start_line, &["#"]);
             parse_doc_comment(&comment_lines.join("\n"))
         }
         "go" => {
-            let comment_lines = extract_preceding_line_comments(&lines, start_line, &["//"]);
+            let comment_lines = extract_preceding_line_comments(lines, start_line, &["//"]);
             parse_doc_comment(&comment_lines.join("\n"))
         }
         "rs" => {
-            let comment_lines =
-                extract_preceding_line_comments(&lines, start_line, &["///", "//!"]);
+            let comment_lines = extract_preceding_line_comments(lines, start_line, &["///", "//!"]);
             parse_doc_comment(&comment_lines.join("\n"))
         }
         "cs" => {
-            let comment_lines = extract_preceding_line_comments(&lines, start_line, &["///"]);
+            let comment_lines = extract_preceding_line_comments(lines, start_line, &["///"]);
             parse_doc_comment(&comment_lines.join("\n"))
         }
         "c" | "cpp" => {
-            let block = extract_preceding_block_comment(&lines, start_line, "/**");
+            let block = extract_preceding_block_comment(lines, start_line, "/**");
             if !block.is_empty() {
                 parse_doc_comment(&block.join("\n"))
             } else {
-                let line_comments = extract_preceding_line_comments(&lines, start_line, &["///"]);
+                let line_comments = extract_preceding_line_comments(lines, start_line, &["///"]);
                 parse_doc_comment(&line_comments.join("\n"))
             }
         }
         "sh" => {
-            let comment_lines = extract_preceding_line_comments(&lines, start_line, &["#"]);
+            let comment_lines = extract_preceding_line_comments(lines, start_line, &["#"]);
             parse_doc_comment(&comment_lines.join("\n"))
         }
-        "ts" | "tsx" | "js" | "jsx" | "java" | "php" => extract_jsdoc(symbol, file_content),
-        _ => extract_jsdoc(symbol, file_content),
+        "ts" | "tsx" | "js" | "jsx" | "java" | "php" => extract_jsdoc(lines, start_line),
+        _ => extract_jsdoc(lines, start_line),
     }
 }
 
@@ -1352,6 +1353,38 @@ mod tests {
         }
     }
 
+    #[test]
+    fn summaries_from_a_shared_context_match_fresh_ones() {
+        let content = "/**\n * Adds two numbers.\n */\nfunction add(a, b) {\n  return a + b;\n}\n\nfunction fetchUser(id) {\n  return fetch(url);\n}\n";
+        let shared = FileContext::new(content, "ts");
+        let mut add = make_symbol("add", "function");
+        add.range = NativeRange {
+            start_line: 4,
+            start_col: 0,
+            end_line: 6,
+            end_col: 1,
+        };
+        let mut fetch_user = make_symbol("fetchUser", "function");
+        fetch_user.range = NativeRange {
+            start_line: 8,
+            start_col: 0,
+            end_line: 10,
+            end_col: 1,
+        };
+        for symbol in [&add, &fetch_user, &add] {
+            let fresh = FileContext::new(content, "ts");
+            assert_eq!(
+                generate_summary(symbol, &shared),
+                generate_summary(symbol, &fresh)
+            );
+            assert_eq!(
+                has_doc_comment(symbol, &shared),
+                has_doc_comment(symbol, &fresh)
+            );
+        }
+        assert!(!generate_summary(&fetch_user, &shared).is_empty());
+    }
+
     #[test]
     fn test_class_with_provider_suffix() {
         let s = make_symbol("AuthProvider", "class");
@@ -1,3 +1,6 @@
+use std::cell::RefCell;
+use std::collections::HashMap;
+
 use tree_sitter::{Language, Parser};
 
 /// Get the tree-sitter Language for a given language identifier.
@@ -33,6 +36,33 @@ pub fn create_parser(lang_id: &str) -> Option<Parser> {
     Some(parser)
 }
 
+thread_local! {
+    /// Per-thread parser cache keyed by language identifier. Parse engine
+    /// workers are long-lived, so each thread pays `set_language` once per
+    /// language rather than once per file.
+    static PARSER_CACHE: RefCell<HashMap<String, Parser>> = RefCell::new(HashMap::new());
+}
+
+/// Run `f` with this thread's cached parser for `lang_id`, creating it on
+/// first use. Returns None if the language is not supported.
+///
+/// The parser is taken out of the cache for the duration of `f` and only put
+/// back when `f` returns normally, so a parser that was mid-parse when a
+/// panic unwound through it is discarded instead of being reused.
+pub fn with_cached_parser<R>(lang_id: &str, f: impl FnOnce(&mut Parser) -> R) -> Option<R> {
+    let cached = PARSER_CACHE.with(|cache| cache.borrow_mut().remove(lang_id));
+    let mut parser = match cached {
+        Some(parser) => parser,
+        None => create_parser(lang_id)?,
+    };
+    let result = f(&mut parser);
+    parser.reset();
+    PARSER_CACHE.with(|cache| {
+        cache.borrow_mut().insert(lang_id.to_string(), parser);
+    });
+    Some(result)
+}
+
 /// Map file extension to language identifier.
 pub fn extension_to_language(ext: &str) -> Option<&'static str> {
     match ext {
@@ -2,6 +2,8 @@ use serde::Deserialize;
 use sha2::{Digest, Sha256};
 use std::collections::HashMap;
 
+pub mod barnes_hut;
+
 pub const LAYOUT_SCHEMA_VERSION: u32 = 1;
 const EPSILON: f64 = 1e-9;
 
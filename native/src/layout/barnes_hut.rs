@@ -0,0 +1,531 @@
+//! Barnes–Hut force layout for graphs too large for the exact O(n²) pass.
+//!
+//! Same Fruchterman–Reingold model, placement and cooling schedule as
+//! `compute_layout_json`, but repulsion from a far-away octree cell is
+//! applied once at the cell's centre of mass: a cell of side `s` at distance
+//! `d` is treated as one body when `s < theta * d`. An iteration costs
+//! O(n log n + m). Each node's repulsion is summed on its own in a fixed
+//! traversal order, so the output does not depend on the thread count.
+//!
+//! A [`BarnesHutLayout`] keeps its positions and temperature between
+//! [`BarnesHutLayout::step`] calls, so callers can run a few iterations,
+//! publish the intermediate positions, and carry on.
+
+use napi_derive::napi;
+use rayon::prelude::*;
+
+use super::{initial_point, Mulberry32, EPSILON};
+
+/// Opening threshold used when the caller passes 0.
+pub const DEFAULT_THETA: f64 = 0.8;
+/// Cells holding at most this many nodes are summed exactly.
+const LEAF_SIZE: usize = 8;
+/// Coincident nodes would otherwise split forever.
+const MAX_DEPTH: u32 = 24;
+const NO_CHILD: u32 = u32::MAX;
+
+#[napi(object)]
+#[derive(Debug, Clone, Default)]
+pub struct NativeLayoutSessionOptions {
+    /// Barnes–Hut opening threshold (0 = 0.8); smaller is slower and closer
+    /// to the exact layout.
+    pub theta: Option<f64>,
+    /// Starting temperature, i.e. the largest first-step move (0 = width / 10).
+    /// Warm starts pass a lower value so settled nodes stay put.
+    pub initial_temperature: Option<f64>,
+}
+
+struct Cell {
+    center: [f64; 3],
+    half: f64,
+    mass: f64,
+    centroid: [f64; 3],
+    /// Range of `Octree::order` covered by this cell.
+    start: u32,
+    end: u32,
+    children: [u32; 8],
+}
+
+impl Cell {
+    fn is_leaf(&self) -> bool {
+        self.children.iter().all(|&child| child == NO_CHILD)
+    }
+
+    fn contains(&self, x: f64, y: f64, z: f64) -> bool {
+        (x - self.center[0]).abs() <= self.half
+            && (y - self.center[1]).abs() <= self.half
+            && (z - self.center[2]).abs() <= self.half
+    }
+}
+
+struct Octree {
+    cells: Vec<Cell>,
+    order: Vec<u32>,
+}
+
+impl Octree {
+    fn build(px: &[f64], py: &[f64], pz: &[f64]) -> Self {
+        let count = px.len();
+        let mut tree = Octree {
+            cells: Vec::with_capacity(count / LEAF_SIZE * 2 + 1),
+            order: (0..count as u32).collect(),
+        };
+        if count == 0 {
+            return tree;
+        }
+        let mut min = [f64::INFINITY; 3];
+        let mut max = [f64::NEG_INFINITY; 3];
+        for i in 0..count {
+            for (axis, value) in [px[i], py[i], pz[i]].into_iter().enumerate() {
+                min[axis] = min[axis].min(value);
+                max[axis] = max[axis].max(value);
+            }
+        }
+        let center = [
+            (min[0] + max[0]) / 2.0,
+            (min[1] + max[1]) / 2.0,
+            (min[2] + max[2]) / 2.0,
+        ];
+        let half = (0..3)
+            .map(|axis| (max[axis] - min[axis]) / 2.0)
+            .fold(EPSILON, f64::max)
+            * (1.0 + 1e-9);
+        let mut scratch = vec![0u32; count];
+        tree.split(px, py, pz, &mut scratch, 0, count, center, half, 0);
+        tree
+    }
+
+    #[allow(clippy::too_many_arguments)]
+    fn split(
+        &mut self,
+        px: &[f64],
+        py: &[f64],
+        pz: &[f64],
+        scratch: &mut [u32],
+        start: usize,
+        end: usize,
+        center: [f64; 3],
+        half: f64,
+        depth: u32,
+    ) -> u32 {
+        let id = self.cells.len() as u32;
+        let mut centroid = [0.0; 3];
+        for &node in &self.order[start..end] {
+            let node = node as usize;
+            centroid[0] += px[node];
+            centroid[1] += py[node];
+            centroid[2] += pz[node];
+        }
+        let mass = (end - start) as f64;
+        for value in &mut centroid {
+            *value /= mass;
+        }
+        self.cells.push(Cell {
+            center,
+            half,
+            mass,
+            centroid,
+            start: start as u32,
+            end: end as u32,
+            children: [NO_CHILD; 8],
+        });
+        if end - start <= LEAF_SIZE || depth >= MAX_DEPTH {
+            return id;
+        }
+
+        let octant = |node: u32| -> usize {
+            let node = node as usize;
+            (px[node] >= center[0]) as usize
+                | ((py[node] >= center[1]) as usize) << 1
+                | ((pz[node] >= center[2]) as usize) << 2
+        };
+        let mut counts = [0usize; 8];
+        for &node in &self.order[start..end] {
+            counts[octant(node)] += 1;
+        }
+        let mut cursor = [0usize; 8];
+        let mut running = start;
+        for (o, &n) in counts.iter().enumerate() {
+            cursor[o] = running;
+            running += n;
+        }
+        let bounds = cursor;
+        for &node in &self.order[start..end] {
+            let o = octant(node);
+            scratch[cursor[o]] = node;
+            cursor[o] += 1;
+        }
+        self.order[start..end].copy_from_slice(&scratch[start..end]);
+
+        let quarter = half / 2.0;
+        for o in 0..8 {
+            if counts[o] == 0 {
+                continue;
+            }
+            let offset = |bit: usize| if o & bit != 0 { quarter } else { -quarter };
+            let child_center = [
+                center[0] + offset(1),
+                center[1] + offset(2),
+                center[2] + offset(4),
+            ];
+            let child = self.split(
+                px,
+                py,
+                pz,
+                scratch,
+                bounds[o],
+                bounds[o] + counts[o],
+                child_center,
+                quarter,
+                depth + 1,
+            );
+            self.cells[id as usize].children[o] = child;
+        }
+        id
+    }
+
+    /// Approximate repulsion on `node`. `stack` is per-thread scratch.
+    #[allow(clippy::too_many_arguments)]
+    fn repulsion(
+        &self,
+        node: usize,
+        px: &[f64],
+        py: &[f64],
+        pz: &[f64],
+        k2: f64,
+        theta: f64,
+        stack: &mut Vec<u32>,
+    ) -> [f64; 3] {
+        let (x, y, z) = (px[node], py[node], pz[node]);
+        let mut force = [0.0; 3];
+        let mut push = |dx: f64, dy: f64, dz: f64, mass: f64| {
+            let dist = (dx * dx + dy * dy + dz * dz).sqrt().max(EPSILON);
+            let magnitude = mass * k2 / dist;
+            force[0] += (dx / dist) * magnitude;
+            force[1] += (dy / dist) * magnitude;
+            force[2] += (dz / dist) * magnitude;
+        };
+        stack.clear();
+        if !self.cells.is_empty() {
+            stack.push(0);
+        }
+        while let Some(id) = stack.pop() {
+            let cell = &self.cells[id as usize];
+            if cell.is_leaf() {
+                for &other in &self.order[cell.start as usize..cell.end as usize] {
+                    let other = other as usize;
+                    if other != node {
+                        push(x - px[other], y - py[other], z - pz[other], 1.0);
+                    }
+                }
+                continue;
+            }
+            let dx = x - cell.centroid[0];
+            let dy = y - cell.centroid[1];
+            let dz = z - cell.centroid[2];
+            let dist = (dx * dx + dy * dy + dz * dz).sqrt();
+            // A cell holding the node itself is always opened.
+            if 2.0 * cell.half < theta * dist && !cell.contains(x, y, z) {
+                push(dx, dy, dz, cell.mass);
+                continue;
+            }
+            for &child in cell.children.iter().rev() {
+                if child != NO_CHILD {
+                    stack.push(child);
+                }
+            }
+        }
+        force
+    }
+}
+
+pub struct BarnesHutLayout {
+    px: Vec<f64>,
+    py: Vec<f64>,
+    pz: Vec<f64>,
+    edges: Vec<(u32, u32, f64)>,
+    k: f64,
+    theta: f64,
+    temperature: f64,
+    iterations_run: u32,
+}
+
+impl BarnesHutLayout {
+    /// Nodes are `0..node_count` in the caller's (sorted) order. `initial`
+    /// holds `x, y, z` per node; a node with any non-finite coordinate, or
+    /// every node when `initial` is `None`, is placed like the exact engine
+    /// places it, drawing from `seed` in node order.
+    pub fn new(
+        node_count: usize,
+        edges: Vec<(u32, u32, f64)>,
+        initial: Option<&[f64]>,
+        seed: u32,
+        options: &NativeLayoutSessionOptions,
+    ) -> Result<Self, String> {
+        if let Some(&(from, to, _)) = edges
+            .iter()
+            .find(|&&(from, to, _)| from as usize >= node_count || to as usize >= node_count)
+        {
+            return Err(format!(
+                "edge {from} -> {to} is out of range for {node_count} nodes"
+            ));
+        }
+        if initial.is_some_and(|values| values.len() != node_count * 3) {
+            return Err("initial positions must hold x, y, z for every node".to_string());
+        }
+        let width = 100.0_f64.max((node_count.max(1) as f64).sqrt() * 100.0);
+        let k = (width * width / node_count.max(1) as f64).sqrt();
+        let mut rand = Mulberry32::new(seed);
+        let mut px = vec![0.0; node_count];
+        let mut py = vec![0.0; node_count];
+        let mut pz = vec![0.0; node_count];
+        for i in 0..node_count {
+            let given = initial
+                .map(|values| &values[i * 3..i * 3 + 3])
+                .filter(|point| point.iter().all(|value| value.is_finite()));
+            match given {
+                Some(point) => {
+                    px[i] = point[0];
+                    py[i] = point[1];
+                    pz[i] = point[2];
+                }
+                None => {
+                    let point = initial_point(&mut rand, width);
+                    px[i] = point.x;
+                    py[i] = point.y;
+                    pz[i] = point.z;
+                }
+            }
+        }
+        let theta = options.theta.filter(|&t| t > 0.0).unwrap_or(DEFAULT_THETA);
+        let temperature = options
+            .initial_temperature
+            .filter(|&t| t > 0.0)
+            .unwrap_or(width / 10.0);
+        Ok(Self {
+            px,
+            py,
+            pz,
+            edges,
+            k,
+            theta,
+            temperature,
+            iterations_run: 0,
+        })
+    }
+
+    pub fn iterations_run(&self) -> u32 {
+        self.iterations_run
+    }
+
+    pub fn step(&mut self, iterations: u32) {
+        let count = self.px.len();
+        let k = self.k;
+        let k2 = k * k;
+        for _ in 0..iterations {
+            let tree = Octree::build(&self.px, &self.py, &self.pz);
+            let (px, py, pz) = (&self.px, &self.py, &self.pz);
+            let mut disp: Vec<[f64; 3]> = (0..count)
+                .into_par_iter()
+                .map_init(Vec::new, |stack, node| {
+                    tree.repulsion(node, px, py, pz, k2, self.theta, stack)
+                })
+                .collect();
+
+            for &(from, to, weight) in &self.edges {
+                let (from, to) = (from as usize, to as usize);
+                let dx = px[from] - px[to];
+                let dy = py[from] - py[to];
+                let dz = pz[from] - pz[to];
+                let dist = (dx * dx + dy * dy + dz * dz).sqrt().max(EPSILON);
+                let force = ((dist * dist) / k) * weight.max(0.1);
+                let f = [
+                    (dx / dist) * force,
+                    (dy / dist) * force,
+                    (dz / dist) * force,
+                ];
+                for axis in 0..3 {
+                    disp[from][axis] -= f[axis];
+                    disp[to][axis] += f[axis];
+                }
+            }
+
+            let temp = self.temperature;
+            for (i, d) in disp.iter().enumerate() {
+                let len = (d[0] * d[0] + d[1] * d[1] + d[2] * d[2])
+                    .sqrt()
+                    .max(EPSILON);
+                self.px[i] += (d[0] / len) * len.min(temp);
+                self.py[i] += (d[1] / len) * len.min(temp);
+                self.pz[i] += (d[2] / len) * len.min(temp);
+            }
+            self.temperature *= 0.95;
+            self.iterations_run += 1;
+        }
+    }
+
+    /// Current positions as `x, y, z` per node.
+    pub fn positions(&self) -> Vec<f64> {
+        let mut out = Vec::with_capacity(self.px.len() * 3);
+        for i in 0..self.px.len() {
+            out.extend_from_slice(&[self.px[i], self.py[i], self.pz[i]]);
+        }
+        out
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn ring(n: u32) -> Vec<(u32, u32, f64)> {
+        (0..n).map(|i| (i, (i + 1) % n, 1.0)).collect()
+    }
+
+    /// The exact engine's loop on the same arrays, for comparison.
+    fn exact(node_count: usize, edges: &[(u32, u32, f64)], seed: u32, iterations: u32) -> Vec<f64> {
+        let mut layout = BarnesHutLayout::new(
+            node_count,
+            edges.to_vec(),
+            None,
+            seed,
+            &NativeLayoutSessionOptions::default(),
+        )
+        .unwrap();
+        let k2 = layout.k * layout.k;
+        for _ in 0..iterations {
+            let mut disp = vec![[0.0; 3]; node_count];
+            for i in 0..node_count {
+                for j in (i + 1)..node_count {
+                    let dx = layout.px[i] - layout.px[j];
+                    let dy = layout.py[i] - layout.py[j];
+                    let dz = layout.pz[i] - layout.pz[j];
+                    let dist = (dx * dx + dy * dy + dz * dz).sqrt().max(EPSILON);
+                    let f = [
+                        dx / dist * k2 / dist,
+                        dy / dist * k2 / dist,
+                        dz / dist * k2 / dist,
+                    ];
+                    for axis in 0..3 {
+                        disp[i][axis] += f[axis];
+                        disp[j][axis] -= f[axis];
+                    }
+                }
+            }
+            for &(from, to, weight) in edges {
+                let (from, to) = (from as usize, to as usize);
+                let dx = layout.px[from] - layout.px[to];
+                let dy = layout.py[from] - layout.py[to];
+                let dz = layout.pz[from] - layout.pz[to];
+                let dist = (dx * dx + dy * dy + dz * dz).sqrt().max(EPSILON);
+                let force = dist * dist / layout.k * weight.max(0.1);
+                let f = [dx / dist * force, dy / dist * force, dz / dist * force];
+                for axis in 0..3 {
+                    disp[from][axis] -= f[axis];
+                    disp[to][axis] += f[axis];
+                }
+            }
+            for (i, d) in disp.iter().enumerate() {
+                let len = (d[0] * d[0] + d[1] * d[1] + d[2] * d[2])
+                    .sqrt()
+                    .max(EPSILON);
+                let temp = layout.temperature;
+                layout.px[i] += d[0] / len * len.min(temp);
+                layout.py[i] += d[1] / len * len.min(temp);
+                layout.pz[i] += d[2] / len * len.min(temp);
+            }
+            layout.temperature *= 0.95;
+        }
+        layout.positions()
+    }
+
+    #[test]
+    fn tiny_theta_matches_the_exact_pass() {
+        let edges = ring(40);
+        let expected = exact(40, &edges, 7, 15);
+        let options = NativeLayoutSessionOptions {
+            theta: Some(1e-6),
+            initial_temperature: None,
+        };
+        let mut layout = BarnesHutLayout::new(40, edges, None, 7, &options).unwrap();
+        layout.step(15);
+        for (a, b) in layout.positions().iter().zip(&expected) {
+            assert!((a - b).abs() < 1e-6, "{a} vs {b}");
+        }
+    }
+
+    #[test]
+    fn default_theta_stays_close_to_the_exact_pass() {
+        let n = 300u32;
+        let mut edges = ring(n);
+        edges.extend((0..n).map(|i| (i, (i * 7 + 3) % n, 2.0)));
+        let expected = exact(n as usize, &edges, 11, 1);
+        let mut layout = BarnesHutLayout::new(
+            n as usize,
+            edges,
+            None,
+            11,
+            &NativeLayoutSessionOptions::default(),
+        )
+        .unwrap();
+        let start = layout.positions();
+        layout.step(1);
+        let actual = layout.positions();
+        let mut error = 0.0;
+        let mut moved = 0.0;
+        for i in 0..actual.len() {
+            error += (actual[i] - expected[i]).abs();
+            moved += (expected[i] - start[i]).abs();
+        }
+        assert!(error < moved * 0.1, "error {error} vs movement {moved}");
+    }
+
+    #[test]
+    fn split_steps_match_one_run() {
+        let edges = ring(100);
+        let options = NativeLayoutSessionOptions::default();
+        let mut whole = BarnesHutLayout::new(100, edges.clone(), None, 3, &options).unwrap();
+        whole.step(20);
+        let mut split = BarnesHutLayout::new(100, edges, None, 3, &options).unwrap();
+        split.step(5);
+        split.step(15);
+        assert_eq!(split.iterations_run(), 20);
+        assert_eq!(whole.positions(), split.positions());
+        assert!(whole.positions().iter().all(|value| value.is_finite()));
+    }
+
+    #[test]
+    fn warm_start_keeps_given_positions_and_places_the_rest() {
+        let mut initial = vec![f64::NAN; 9];
+        initial[3..6].copy_from_slice(&[1.0, 2.0, 3.0]);
+        let options = NativeLayoutSessionOptions::default();
+        let layout = BarnesHutLayout::new(3, Vec::new(), Some(&initial), 5, &options).unwrap();
+        let positions = layout.positions();
+        assert_eq!(&positions[3..6], &[1.0, 2.0, 3.0]);
+        // Fresh nodes draw from the seed in node order, skipping given ones.
+        let mut rand = Mulberry32::new(5);
+        let first = initial_point(&mut rand, 100.0_f64.max(3f64.sqrt() * 100.0));
+        let second = initial_point(&mut rand, 100.0_f64.max(3f64.sqrt() * 100.0));
+        assert_eq!(&positions[0..3], &[first.x, first.y, first.z]);
+        assert_eq!(&positions[6..9], &[second.x, second.y, second.z]);
+    }
+
+    #[test]
+    fn coincident_nodes_stay_finite() {
+        let initial = vec![5.0; 3 * 50];
+        let options = NativeLayoutSessionOptions::default();
+        let mut layout = BarnesHutLayout::new(50, ring(50), Some(&initial), 1, &options).unwrap();
+        layout.step(3);
+        assert!(layout.positions().iter().all(|value| value.is_finite()));
+    }
+
+    #[test]
+    fn rejects_bad_input() {
+        let options = NativeLayoutSessionOptions::default();
+        assert!(BarnesHutLayout::new(2, vec![(0, 2, 1.0)], None, 0, &options).is_err());
+        assert!(BarnesHutLayout::new(2, Vec::new(), Some(&[0.0; 3]), 0, &options).is_err());
+        let mut empty = BarnesHutLayout::new(0, Vec::new(), None, 0, &options).unwrap();
+        empty.step(2);
+        assert!(empty.positions().is_empty());
+    }
+}
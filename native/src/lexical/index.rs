@@ -0,0 +1,495 @@
+use std::collections::{BTreeMap, HashMap, HashSet};
+
+use rayon::prelude::*;
+
+use crate::extract::search_text::split_identifier_like_text;
+
+/// BM25 term-frequency saturation; LadybugDB's FTS runs with the same `K`.
+const BM25_K1: f64 = 1.2;
+/// BM25 document-length normalisation.
+const BM25_B: f64 = 0.75;
+/// Tombstones tolerated before `compact` runs, however few live documents.
+const MIN_DEAD_BEFORE_COMPACT: usize = 1024;
+
+struct Doc {
+    symbol_id: String,
+    name: String,
+    name_lower: String,
+    /// `(term, frequency)` pairs, kept to unwind document frequencies on
+    /// removal and to rebuild postings on compaction.
+    terms: Vec<(u32, u32)>,
+    len: u32,
+    live: bool,
+}
+
+/// One document tokenised off the index, so batches can prepare in parallel.
+struct Prepared {
+    name_lower: String,
+    terms: Vec<(String, u32)>,
+    len: u32,
+}
+
+#[derive(Default)]
+pub struct LexicalIndex {
+    docs: Vec<Doc>,
+    /// Live documents by symbol ID; ordered for ID-prefix lookups.
+    by_id: BTreeMap<String, u32>,
+    /// Live documents by exact (case-sensitive) name.
+    by_name: HashMap<String, Vec<u32>>,
+    term_ids: HashMap<String, u32>,
+    /// Per term, `(doc, frequency)` in ascending doc order. May name dead
+    /// documents until the next compaction.
+    postings: Vec<Vec<(u32, u32)>>,
+    /// Live documents containing each term.
+    doc_freq: Vec<u32>,
+    /// Per packed name trigram, ascending doc numbers.
+    trigrams: HashMap<u32, Vec<u32>>,
+    total_len: u64,
+    dead: usize,
+}
+
+impl LexicalIndex {
+    /// Index `symbol_ids[i]` with `names[i]` and `search_texts[i]`. The
+    /// slices must be the same length.
+    pub fn build(symbol_ids: &[String], names: &[String], search_texts: &[String]) -> Self {
+        let mut index = Self::default();
+        index.upsert(symbol_ids, names, search_texts);
+        index
+    }
+
+    /// Live documents.
+    pub fn len(&self) -> usize {
+        self.by_id.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.by_id.is_empty()
+    }
+
+    pub fn contains(&self, symbol_id: &str) -> bool {
+        self.by_id.contains_key(symbol_id)
+    }
+
+    /// Insert or replace each symbol's document. Later duplicates within
+    /// one batch win.
+    pub fn upsert(&mut self, symbol_ids: &[String], names: &[String], search_texts: &[String]) {
+        let count = symbol_ids.len().min(names.len()).min(search_texts.len());
+        let prepared: Vec<Prepared> = (0..count)
+            .into_par_iter()
+            .map(|i| prepare(&names[i], &search_texts[i]))
+            .collect();
+        for (i, doc) in prepared.into_iter().enumerate() {
+            self.remove_one(&symbol_ids[i]);
+            self.insert(symbol_ids[i].clone(), names[i].clone(), doc);
+        }
+        self.maybe_compact();
+    }
+
+    pub fn remove(&mut self, symbol_ids: &[String]) {
+        for symbol_id in symbol_ids {
+            self.remove_one(symbol_id);
+        }
+        self.maybe_compact();
+    }
+
+    /// Top `limit` documents by BM25 over the query's words and, unless
+    /// `conjunctive`, their camelCase and snake_case fragments. Conjunctive
+    /// queries only match documents holding every word.
+    pub fn search(&self, query: &str, limit: usize, conjunctive: bool) -> Vec<(String, f64)> {
+        let live = self.len();
+        if live == 0 || limit == 0 {
+            return Vec::new();
+        }
+        let terms = query_terms(query, conjunctive);
+        if terms.is_empty() {
+            return Vec::new();
+        }
+        let avg_len = (self.total_len as f64 / live as f64).max(1.0);
+        // Dense accumulators: common terms touch a large share of the
+        // documents, where hashing per posting costs more than the scan.
+        let mut scores = vec![0.0f64; self.docs.len()];
+        let mut matched = vec![0u32; self.docs.len()];
+        let mut touched = Vec::new();
+        for term in &terms {
+            let Some(term_id) = self
+                .term_ids
+                .get(term)
+                .map(|&term_id| term_id as usize)
+                .filter(|&term_id| self.doc_freq[term_id] > 0)
+            else {
+                if conjunctive {
+                    return Vec::new();
+                }
+                continue;
+            };
+            let df = self.doc_freq[term_id] as f64;
+            let idf = (1.0 + (live as f64 - df + 0.5) / (df + 0.5)).ln();
+            for &(doc, tf) in &self.postings[term_id] {
+                let entry = &self.docs[doc as usize];
+                if !entry.live {
+                    continue;
+                }
+                let tf = tf as f64;
+                let norm = 1.0 - BM25_B + BM25_B * entry.len as f64 / avg_len;
+                if matched[doc as usize] == 0 {
+                    touched.push(doc);
+                }
+                scores[doc as usize] += idf * tf * (BM25_K1 + 1.0) / (tf + BM25_K1 * norm);
+                matched[doc as usize] += 1;
+            }
+        }
+        let required = if conjunctive { terms.len() as u32 } else { 1 };
+        let hits = touched
+            .into_iter()
+            .filter(|&doc| matched[doc as usize] >= required)
+            .map(|doc| (doc, scores[doc as usize]));
+        self.top(hits, limit)
+    }
+
+    /// Top `limit` documents whose name contains `query`, ignoring case,
+    /// scored by the share of the name the query covers.
+    pub fn search_substring(&self, query: &str, limit: usize) -> Vec<(String, f64)> {
+        let needle = query.trim().to_lowercase();
+        if needle.is_empty() || limit == 0 {
+            return Vec::new();
+        }
+        let hits = self
+            .name_candidates(&needle)
+            .into_iter()
+            .filter_map(|doc| {
+                let name = &self.docs[doc as usize].name_lower;
+                name.contains(&needle)
+                    .then(|| (doc, needle.len() as f64 / name.len() as f64))
+            })
+            .collect::<Vec<_>>();
+        self.top(hits.into_iter(), limit)
+    }
+
+    /// Symbols named exactly `name`, or whose name starts with it when
+    /// `prefix`, compared case-sensitively and returned in symbol ID order.
+    pub fn find_by_name(&self, name: &str, prefix: bool, limit: usize) -> Vec<String> {
+        let mut docs: Vec<u32> = if prefix {
+            self.name_candidates(&name.to_lowercase())
+                .into_iter()
+                .filter(|&doc| self.docs[doc as usize].name.starts_with(name))
+                .collect()
+        } else {
+            self.by_name.get(name).cloned().unwrap_or_default()
+        };
+        docs.sort_unstable_by(|&a, &b| {
+            self.docs[a as usize]
+                .symbol_id
+                .cmp(&self.docs[b as usize].symbol_id)
+        });
+        docs.into_iter()
+            .take(limit)
+            .map(|doc| self.docs[doc as usize].symbol_id.clone())
+            .collect()
+    }
+
+    /// Symbol IDs starting with `prefix`, in order.
+    pub fn find_by_id_prefix(&self, prefix: &str, limit: usize) -> Vec<String> {
+        self.by_id
+            .range::<str, _>((
+                std::ops::Bound::Included(prefix),
+                std::ops::Bound::Unbounded,
+            ))
+            .take_while(|(symbol_id, _)| symbol_id.starts_with(prefix))
+            .take(limit)
+            .map(|(symbol_id, _)| symbol_id.clone())
+            .collect()
+    }
+
+    fn insert(&mut self, symbol_id: String, name: String, prepared: Prepared) {
+        let doc = self.docs.len() as u32;
+        let mut terms = Vec::with_capacity(prepared.terms.len());
+        for (term, tf) in prepared.terms {
+            let next = self.term_ids.len() as u32;
+            let term_id = *self.term_ids.entry(term).or_insert(next);
+            if term_id == next {
+                self.postings.push(Vec::new());
+                self.doc_freq.push(0);
+            }
+            self.postings[term_id as usize].push((doc, tf));
+            self.doc_freq[term_id as usize] += 1;
+            terms.push((term_id, tf));
+        }
+        for trigram in name_trigrams(&prepared.name_lower) {
+            self.trigrams.entry(trigram).or_default().push(doc);
+        }
+        self.by_id.insert(symbol_id.clone(), doc);
+        self.by_name.entry(name.clone()).or_default().push(doc);
+        self.total_len += prepared.len as u64;
+        self.docs.push(Doc {
+            symbol_id,
+            name,
+            name_lower: prepared.name_lower,
+            terms,
+            len: prepared.len,
+            live: true,
+        });
+    }
+
+    fn remove_one(&mut self, symbol_id: &str) {
+        let Some(doc) = self.by_id.remove(symbol_id) else {
+            return;
+        };
+        let entry = &mut self.docs[doc as usize];
+        entry.live = false;
+        for &(term_id, _) in &entry.terms {
+            self.doc_freq[term_id as usize] -= 1;
+        }
+        self.total_len -= entry.len as u64;
+        if let Some(docs) = self.by_name.get_mut(&entry.name) {
+            docs.retain(|&other| other != doc);
+            if docs.is_empty() {
+                self.by_name.remove(&entry.name);
+            }
+        }
+        self.dead += 1;
+    }
+
+    fn maybe_compact(&mut self) {
+        if self.dead >= MIN_DEAD_BEFORE_COMPACT && self.dead > self.len() {
+            self.compact();
+        }
+    }
+
+    /// Renumber the live documents and rebuild every posting list without
+    /// the tombstoned ones. Term IDs are kept.
+    fn compact(&mut self) {
+        let docs = std::mem::take(&mut self.docs);
+        for postings in &mut self.postings {
+            postings.clear();
+        }
+        self.trigrams.clear();
+        self.by_id.clear();
+        self.by_name.clear();
+        for entry in docs.into_iter().filter(|entry| entry.live) {
+            let doc = self.docs.len() as u32;
+            for &(term_id, tf) in &entry.terms {
+                self.postings[term_id as usize].push((doc, tf));
+            }
+            for trigram in name_trigrams(&entry.name_lower) {
+                self.trigrams.entry(trigram).or_default().push(doc);
+            }
+            self.by_id.insert(entry.symbol_id.clone(), doc);
+            self.by_name
+                .entry(entry.name.clone())
+                .or_default()
+                .push(doc);
+            self.docs.push(entry);
+        }
+        self.dead = 0;
+    }
+
+    /// Live documents whose lowercased name may contain `needle`: those
+    /// holding all its trigrams, or every live document for needles too
+    /// short to have one. Callers verify each candidate.
+    fn name_candidates(&self, needle: &str) -> Vec<u32> {
+        let grams = name_trigrams(needle);
+        if grams.is_empty() {
+            return self.by_id.values().copied().collect();
+        }
+        let mut lists = Vec::with_capacity(grams.len());
+        for gram in &grams {
+            match self.trigrams.get(gram) {
+                Some(list) => lists.push(list),
+                None => return Vec::new(),
+            }
+        }
+        lists.sort_unstable_by_key(|list| list.len());
+        let (shortest, rest) = lists.split_first().expect("needle has a trigram");
+        shortest
+            .iter()
+            .copied()
+            .filter(|&doc| self.docs[doc as usize].live)
+            .filter(|doc| rest.iter().all(|list| list.binary_search(doc).is_ok()))
+            .collect()
+    }
+
+    fn top(&self, hits: impl Iterator<Item = (u32, f64)>, limit: usize) -> Vec<(String, f64)> {
+        let mut hits: Vec<(u32, f64)> = hits.collect();
+        let order = |a: &(u32, f64), b: &(u32, f64)| {
+            b.1.total_cmp(&a.1).then_with(|| {
+                self.docs[a.0 as usize]
+                    .symbol_id
+                    .cmp(&self.docs[b.0 as usize].symbol_id)
+            })
+        };
+        if hits.len() > limit {
+            hits.select_nth_unstable_by(limit, order);
+            hits.truncate(limit);
+        }
+        hits.sort_unstable_by(order);
+        hits.into_iter()
+            .map(|(doc, score)| (self.docs[doc as usize].symbol_id.clone(), score))
+            .collect()
+    }
+}
+
+fn prepare(name: &str, search_text: &str) -> Prepared {
+    let mut counts: HashMap<String, u32> = HashMap::new();
+    let mut len = 0u32;
+    for token in words(search_text) {
+        *counts.entry(token.to_lowercase()).or_insert(0) += 1;
+        len += 1;
+    }
+    let mut terms: Vec<(String, u32)> = counts.into_iter().collect();
+    terms.sort_unstable();
+    Prepared {
+        name_lower: name.to_lowercase(),
+        terms,
+        len,
+    }
+}
+
+fn words(text: &str) -> impl Iterator<Item = &str> {
+    text.split(|ch: char| !ch.is_alphanumeric())
+        .filter(|word| !word.is_empty())
+}
+
+/// Lowercased query words, plus their identifier fragments unless
+/// `conjunctive`, deduplicated in first-seen order.
+fn query_terms(query: &str, conjunctive: bool) -> Vec<String> {
+    let mut seen = HashSet::new();
+    let mut terms = Vec::new();
+    for word in query.split_whitespace() {
+        let mut parts = vec![word.to_string()];
+        if !conjunctive {
+            parts.extend(split_identifier_like_text(word));
+        }
+        for part in parts {
+            for token in words(&part) {
+                let token = token.to_lowercase();
+                if seen.insert(token.clone()) {
+                    terms.push(token);
+                }
+            }
+        }
+    }
+    terms
+}
+
+/// Distinct byte trigrams of `text`, packed into the low 24 bits. Byte
+/// trigrams keep substring matching exact for UTF-8 text.
+fn name_trigrams(text: &str) -> Vec<u32> {
+    let mut grams: Vec<u32> = text
+        .as_bytes()
+        .windows(3)
+        .map(|w| (w[0] as u32) << 16 | (w[1] as u32) << 8 | w[2] as u32)
+        .collect();
+    grams.sort_unstable();
+    grams.dedup();
+    grams
+}
+
+#[cfg(test)]
+mod tests {
+    use super::LexicalIndex;
+
+    fn strings(values: &[&str]) -> Vec<String> {
+        values.iter().map(|value| value.to_string()).collect()
+    }
+
+    fn sample() -> LexicalIndex {
+        LexicalIndex::build(
+            &strings(&["id-a", "id-b", "id-c"]),
+            &strings(&["handleLoginRequest", "LoginForm", "parseConfig"]),
+            &strings(&[
+                "handleloginrequest handle login request function auth",
+                "loginform login form class ui",
+                "parseconfig parse config function config loader",
+            ]),
+        )
+    }
+
+    fn ids(hits: Vec<(String, f64)>) -> Vec<String> {
+        hits.into_iter().map(|(id, _)| id).collect()
+    }
+
+    #[test]
+    fn ranks_token_matches_by_bm25() {
+        let index = sample();
+        assert_eq!(ids(index.search("login", 10, false)), ["id-b", "id-a"]);
+        // The camelCase query splits into fragments that match both.
+        assert_eq!(
+            ids(index.search("handleLogin", 10, false)),
+            ["id-a", "id-b"]
+        );
+        // A repeated term outscores a single occurrence.
+        assert_eq!(ids(index.search("config", 10, false))[0], "id-c");
+        assert!(index.search("missing", 10, false).is_empty());
+    }
+
+    #[test]
+    fn conjunctive_search_requires_every_word() {
+        let index = sample();
+        assert_eq!(ids(index.search("login function", 10, true)), ["id-a"]);
+        assert!(index.search("login missing", 10, true).is_empty());
+        assert_eq!(index.search("login function", 10, false).len(), 3);
+    }
+
+    #[test]
+    fn finds_names_by_substring_prefix_and_exact_match() {
+        let index = sample();
+        assert_eq!(ids(index.search_substring("LOGIN", 10)), ["id-b", "id-a"]);
+        assert_eq!(ids(index.search_substring("fi", 10)), ["id-c"]);
+        assert_eq!(index.find_by_name("Login", true, 10), ["id-b"]);
+        assert_eq!(index.find_by_name("ha", true, 10), ["id-a"]);
+        assert!(index.find_by_name("login", true, 10).is_empty());
+        assert_eq!(index.find_by_name("parseConfig", false, 10), ["id-c"]);
+        assert!(index.find_by_name("parse", false, 10).is_empty());
+    }
+
+    #[test]
+    fn finds_symbol_ids_by_prefix() {
+        let index = sample();
+        assert_eq!(index.find_by_id_prefix("id-", 2), ["id-a", "id-b"]);
+        assert_eq!(index.find_by_id_prefix("id-c", 2), ["id-c"]);
+        assert!(index.find_by_id_prefix("x", 2).is_empty());
+    }
+
+    #[test]
+    fn upserts_and_removals_patch_every_lookup() {
+        let mut index = sample();
+        index.upsert(
+            &strings(&["id-b"]),
+            &strings(&["SignupForm"]),
+            &strings(&["signupform signup form class ui"]),
+        );
+        index.remove(&strings(&["id-c"]));
+        assert_eq!(index.len(), 2);
+        assert!(!index.contains("id-c"));
+        assert_eq!(ids(index.search("login", 10, false)), ["id-a"]);
+        assert_eq!(ids(index.search("signup", 10, false)), ["id-b"]);
+        assert!(index.search("config", 10, false).is_empty());
+        assert!(index.find_by_name("LoginForm", false, 10).is_empty());
+        assert_eq!(index.find_by_name("Signup", true, 10), ["id-b"]);
+        assert!(index.search_substring("parse", 10).is_empty());
+        assert_eq!(index.find_by_id_prefix("id-", 10), ["id-a", "id-b"]);
+    }
+
+    #[test]
+    fn compaction_keeps_results_unchanged() {
+        let count = 3000;
+        let symbol_ids: Vec<String> = (0..count).map(|i| format!("id-{i:05}")).collect();
+        let names: Vec<String> = (0..count).map(|i| format!("symbolNumber{i}")).collect();
+        let texts: Vec<String> = (0..count)
+            .map(|i| format!("symbolnumber{i} symbol number {}", i % 7))
+            .collect();
+        let mut index = LexicalIndex::build(&symbol_ids, &names, &texts);
+        index.remove(&symbol_ids[..2000]);
+        assert_eq!(index.dead, 0, "removing most documents compacts");
+        assert_eq!(index.docs.len(), 1000);
+        assert_eq!(index.len(), 1000);
+        assert_eq!(ids(index.search_substring("Number2999", 10)), ["id-02999"]);
+        assert_eq!(
+            index.find_by_name("symbolNumber2500", false, 1),
+            ["id-02500"]
+        );
+        let hits = index.search("symbol", count, false);
+        assert_eq!(hits.len(), 1000);
+        assert!(hits.iter().all(|(id, _)| id.as_str() >= "id-02000"));
+    }
+}
@@ -0,0 +1,15 @@
+//! In-memory lexical index over symbol names and `search_text`.
+//!
+//! Each repo's symbols are held as documents with three lookups: a term
+//! dictionary with per-term postings, scored with BM25 the way LadybugDB's
+//! FTS index scores `searchText`; trigram postings over lowercased names for
+//! prefix and substring candidates, verified against the name before they
+//! are returned; and exact name and sorted symbol ID maps for seed
+//! resolution. Upserts and removals patch the index in place; removed
+//! documents are tombstoned and swept once they outnumber the live ones.
+
+pub mod index;
+pub mod types;
+
+pub use index::LexicalIndex;
+pub use types::NativeLexicalHit;
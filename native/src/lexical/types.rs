@@ -0,0 +1,12 @@
+//! Napi-rs payload types for the lexical index exports.
+
+use napi_derive::napi;
+
+#[napi(object)]
+#[derive(Debug, Clone)]
+pub struct NativeLexicalHit {
+    pub symbol_id: String,
+    /// BM25 score for token search; matched share of the name for
+    /// substring search.
+    pub score: f64,
+}
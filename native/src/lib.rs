@@ -3,19 +3,26 @@ extern crate napi_derive;
 
 use std::collections::HashMap;
 
+use napi::bindgen_prelude::{Float64Array, Uint32Array, Uint8Array};
 use regex::Regex;
 
+pub mod centrality;
 pub mod cluster;
+pub mod csr;
 pub mod error;
 pub mod extract;
 pub mod lang;
 pub mod layout;
+pub mod lexical;
 pub mod pagerank;
 pub mod parse;
 pub mod process;
 pub mod scanner;
 pub mod scip;
+pub mod slice;
+pub mod stats;
 pub mod types;
+pub mod vector;
 pub mod windows_loader;
 
 #[napi]
@@ -31,7 +38,9 @@ pub fn release_windows_library(token: u32) -> napi::Result<()> {
 }
 
 use types::{
-    NativeClusterAssignment, NativeClusterEdge, NativeClusterSymbol, NativeFileInput,
+    NativeClusterAssignment, NativeClusterEdge, NativeClusterSymbol, NativeCsrProcessTraces,
+    NativeFileHash, NativeFileHashInput, NativeFileInput, NativeIncrementalParseInput,
+    NativeIncrementalParseResult, NativePackedParseBatch, NativeParseEngineStatus,
     NativeParsedFile, NativeProcess, NativeProcessCallEdge, NativeProcessStep, NativeProcessSymbol,
 };
 
@@ -81,6 +90,332 @@ pub fn parse_files_async(
     })
 }
 
+fn into_packed_batch(batch: parse::packed::PackedBatch) -> NativePackedParseBatch {
+    NativePackedParseBatch {
+        files: batch.files,
+        symbol_counts: batch.symbol_counts,
+        symbols: batch.bytes.into(),
+    }
+}
+
+pub struct ParseFilesPackedTask {
+    files: Vec<NativeFileInput>,
+    thread_count: usize,
+}
+
+impl napi::Task for ParseFilesPackedTask {
+    type Output = parse::packed::PackedBatch;
+    type JsValue = NativePackedParseBatch;
+
+    fn compute(&mut self) -> napi::Result<Self::Output> {
+        Ok(parse::packed::pack_files(parse::parse_files_parallel(
+            &self.files,
+            self.thread_count,
+        )))
+    }
+
+    fn resolve(&mut self, _env: napi::Env, output: Self::Output) -> napi::Result<Self::JsValue> {
+        Ok(into_packed_batch(output))
+    }
+}
+
+/// Packed-output variant of `parseFilesAsync`: symbols come back as one
+/// columnar buffer per batch instead of nested objects.
+#[napi]
+pub fn parse_files_packed_async(
+    files: Vec<NativeFileInput>,
+    thread_count: u32,
+) -> napi::bindgen_prelude::AsyncTask<ParseFilesPackedTask> {
+    let count = if thread_count == 0 {
+        num_cpus()
+    } else {
+        thread_count as usize
+    };
+
+    napi::bindgen_prelude::AsyncTask::new(ParseFilesPackedTask {
+        files,
+        thread_count: count,
+    })
+}
+
+#[napi]
+pub struct ParseStreamHandle {
+    state: Arc<parse::stream::ParseStreamState>,
+}
+
+/// Start parsing a batch like `parseFilesAsync`, but hand results back in
+/// chunks of up to `chunkSize` files as they complete (completion order).
+/// Pull chunks with `nextChunk()` until it resolves to `null`.
+#[napi]
+pub fn parse_files_stream(
+    files: Vec<NativeFileInput>,
+    thread_count: u32,
+    chunk_size: u32,
+) -> napi::Result<ParseStreamHandle> {
+    let count = if thread_count == 0 {
+        num_cpus()
+    } else {
+        thread_count as usize
+    };
+    let state = parse::stream::ParseStreamState::start(
+        files,
+        count,
+        (chunk_size as usize).max(1),
+        parse::stream::DEFAULT_QUEUE_CHUNKS,
+    )
+    .map_err(|e| napi::Error::from_reason(format!("failed to start parse stream: {e}")))?;
+    Ok(ParseStreamHandle {
+        state: Arc::new(state),
+    })
+}
+
+pub struct NextParseChunkTask {
+    state: Arc<parse::stream::ParseStreamState>,
+}
+
+impl napi::Task for NextParseChunkTask {
+    type Output = Option<Vec<NativeParsedFile>>;
+    type JsValue = Option<Vec<NativeParsedFile>>;
+
+    fn compute(&mut self) -> napi::Result<Self::Output> {
+        Ok(self.state.next_chunk())
+    }
+
+    fn resolve(&mut self, _env: napi::Env, output: Self::Output) -> napi::Result<Self::JsValue> {
+        Ok(output)
+    }
+}
+
+pub struct NextPackedParseChunkTask {
+    state: Arc<parse::stream::ParseStreamState>,
+}
+
+impl napi::Task for NextPackedParseChunkTask {
+    type Output = Option<parse::packed::PackedBatch>;
+    type JsValue = Option<NativePackedParseBatch>;
+
+    fn compute(&mut self) -> napi::Result<Self::Output> {
+        Ok(self.state.next_chunk().map(parse::packed::pack_files))
+    }
+
+    fn resolve(&mut self, _env: napi::Env, output: Self::Output) -> napi::Result<Self::JsValue> {
+        Ok(output.map(into_packed_batch))
+    }
+}
+
+#[napi]
+impl ParseStreamHandle {
+    /// Number of files in the batch.
+    #[napi(getter)]
+    pub fn total_files(&self) -> u32 {
+        self.state.total_files() as u32
+    }
+
+    /// Resolve with the next completed chunk, or `null` once every file has
+    /// been delivered or the stream was cancelled.
+    #[napi(ts_return_type = "Promise<Array<NativeParsedFile> | null>")]
+    pub fn next_chunk(&self) -> napi::bindgen_prelude::AsyncTask<NextParseChunkTask> {
+        napi::bindgen_prelude::AsyncTask::new(NextParseChunkTask {
+            state: Arc::clone(&self.state),
+        })
+    }
+
+    /// Like `nextChunk`, but with the chunk's symbols packed into one
+    /// columnar buffer.
+    #[napi(ts_return_type = "Promise<NativePackedParseBatch | null>")]
+    pub fn next_packed_chunk(&self) -> napi::bindgen_prelude::AsyncTask<NextPackedParseChunkTask> {
+        napi::bindgen_prelude::AsyncTask::new(NextPackedParseChunkTask {
+            state: Arc::clone(&self.state),
+        })
+    }
+
+    /// Stop parsing files that have not started yet.
+    #[napi]
+    pub fn cancel(&self) {
+        self.state.cancel();
+    }
+}
+
+pub struct ScanRepositoryFilesTask {
+    root_path: String,
+    options: NativeScanOptions,
+}
+
+impl napi::Task for ScanRepositoryFilesTask {
+    type Output = Vec<NativeScannedFile>;
+    type JsValue = Vec<NativeScannedFile>;
+
+    fn compute(&mut self) -> napi::Result<Self::Output> {
+        scanner::scan_repository_files(&self.root_path, &self.options)
+            .map_err(napi::Error::from_reason)
+    }
+
+    fn resolve(&mut self, _env: napi::Env, output: Self::Output) -> napi::Result<Self::JsValue> {
+        Ok(output)
+    }
+}
+
+/// Walk a repository on a parallel walker and return matching files with
+/// their size and mtime, sorted by relative path.
+#[napi]
+pub fn scan_repository_files_async(
+    root_path: String,
+    options: NativeScanOptions,
+) -> napi::bindgen_prelude::AsyncTask<ScanRepositoryFilesTask> {
+    napi::bindgen_prelude::AsyncTask::new(ScanRepositoryFilesTask { root_path, options })
+}
+
+pub struct HashFilesTask {
+    files: Vec<NativeFileHashInput>,
+    thread_count: usize,
+}
+
+impl napi::Task for HashFilesTask {
+    type Output = Vec<NativeFileHash>;
+    type JsValue = Vec<NativeFileHash>;
+
+    fn compute(&mut self) -> napi::Result<Self::Output> {
+        Ok(parse::file_hash::hash_files_parallel(
+            &self.files,
+            self.thread_count,
+        ))
+    }
+
+    fn resolve(&mut self, _env: napi::Env, output: Self::Output) -> napi::Result<Self::JsValue> {
+        Ok(output)
+    }
+}
+
+/// Hash files' raw bytes on the parse pool: a fast digest always, SHA-256
+/// only for files whose fast digest no longer matches `knownFastHash`.
+/// Files over the native parse limit are memory-mapped rather than read.
+#[napi]
+pub fn hash_files_async(
+    files: Vec<NativeFileHashInput>,
+    thread_count: u32,
+) -> napi::bindgen_prelude::AsyncTask<HashFilesTask> {
+    let count = if thread_count == 0 {
+        num_cpus()
+    } else {
+        thread_count as usize
+    };
+
+    napi::bindgen_prelude::AsyncTask::new(HashFilesTask {
+        files,
+        thread_count: count,
+    })
+}
+
+/// Name of the digest `hashFilesAsync` returns as `contentFastHash`.
+#[napi]
+pub fn content_fast_hash_algorithm() -> String {
+    parse::content_hash::FAST_HASH_ALGORITHM.to_string()
+}
+
+/// Re-parse a live-index draft, reusing the previous tree and enrichment
+/// cached for the same (repo, relPath).
+#[napi]
+pub fn parse_file_incremental(input: NativeIncrementalParseInput) -> NativeIncrementalParseResult {
+    parse::incremental::parse_incremental(&input)
+}
+
+pub struct ParseFileIncrementalTask {
+    input: NativeIncrementalParseInput,
+}
+
+impl napi::Task for ParseFileIncrementalTask {
+    type Output = NativeIncrementalParseResult;
+    type JsValue = NativeIncrementalParseResult;
+
+    fn compute(&mut self) -> napi::Result<Self::Output> {
+        Ok(parse::incremental::parse_incremental(&self.input))
+    }
+
+    fn resolve(&mut self, _env: napi::Env, output: Self::Output) -> napi::Result<Self::JsValue> {
+        Ok(output)
+    }
+}
+
+#[napi]
+pub fn parse_file_incremental_async(
+    input: NativeIncrementalParseInput,
+) -> napi::bindgen_prelude::AsyncTask<ParseFileIncrementalTask> {
+    napi::bindgen_prelude::AsyncTask::new(ParseFileIncrementalTask { input })
+}
+
+/// Drop cached incremental-parse state for one draft, or for every draft of
+/// the repo when `rel_path` is omitted. Returns the number of entries removed.
+#[napi]
+pub fn forget_incremental_parse(repo_id: String, rel_path: Option<String>) -> u32 {
+    parse::incremental::forget(&repo_id, rel_path.as_deref())
+}
+
+/// Configure the process-wide parse engine. `thread_count = 0` selects the
+/// default (available cores minus one). This is the only call that resizes
+/// the pool: it swaps in a new one, and batches already running finish on the
+/// previous one. Per-call thread counts only cap a batch's share of the pool.
+#[napi]
+pub fn configure_parse_engine(thread_count: u32) -> NativeParseEngineStatus {
+    let count = if thread_count == 0 {
+        num_cpus()
+    } else {
+        thread_count as usize
+    };
+    parse::engine::configure(count);
+    parse_engine_status()
+}
+
+#[napi]
+pub fn parse_engine_status() -> NativeParseEngineStatus {
+    let stats = parse::engine::stats();
+    NativeParseEngineStatus {
+        thread_count: stats.thread_count as u32,
+        pool_builds: stats.pool_builds.min(u32::MAX as u64) as u32,
+        batches_parsed: stats.batches_parsed.min(u32::MAX as u64) as u32,
+        files_parsed: stats.files_parsed.min(u32::MAX as u64) as u32,
+        ast_fingerprint_mode: extract::fingerprint::fingerprint_mode()
+            .as_str()
+            .to_string(),
+    }
+}
+
+/// Select how symbol AST fingerprints are computed: `"native"` (default) or
+/// `"ts-compat"` for byte-exact parity with the TypeScript engine. Applies to
+/// files parsed after the call.
+#[napi]
+pub fn set_ast_fingerprint_mode(mode: String) -> napi::Result<()> {
+    let parsed = extract::fingerprint::FingerprintMode::parse(&mode)
+        .ok_or_else(|| napi::Error::from_reason(format!("unknown AST fingerprint mode: {mode}")))?;
+    extract::fingerprint::set_fingerprint_mode(parsed);
+    Ok(())
+}
+
+/// Release the parse engine's worker pool. The next parse call rebuilds it.
+#[napi]
+pub fn shutdown_parse_engine() {
+    parse::engine::shutdown();
+}
+
+/// Per-phase latency histograms summed over every native thread. Phases with
+/// no samples yet are omitted.
+#[napi]
+pub fn native_phase_stats() -> Vec<stats::types::NativePhaseHistogram> {
+    stats::snapshot()
+}
+
+/// Recent native phase spans (each thread keeps its last 2048) that started
+/// at or after `since_micros`, in wall-clock microseconds since the epoch.
+#[napi]
+pub fn native_phase_spans(since_micros: f64) -> Vec<stats::types::NativePhaseSpan> {
+    stats::spans_since(since_micros.max(0.0) as u64)
+}
+
+/// Turn native phase recording on or off. On by default.
+#[napi]
+pub fn set_native_phase_stats_enabled(enabled: bool) {
+    stats::set_enabled(enabled);
+}
+
 #[napi]
 pub fn hash_content_native(content: String) -> String {
     parse::content_hash::hash_content(&content)
@@ -143,22 +478,9 @@ pub fn compute_clusters(
 
     let result = cluster::label_propagation(&edge_pairs, symbol_ids.len(), 100);
 
-    // Drop oversized communities. Even after edge-type filtering upstream,
-    // dispatcher-like functions can still pull hundreds of unrelated symbols
-    // into one community via transitive call chains. A group this large is
-    // not a meaningful cohesive cluster and only serves to pollute labels.
-    const MAX_CLUSTER_SIZE: usize = 250;
-
     let mut assignments: Vec<NativeClusterAssignment> = Vec::new();
 
-    for (_label, members) in result.communities {
-        if members.len() < min_size {
-            continue;
-        }
-        if members.len() > MAX_CLUSTER_SIZE {
-            continue;
-        }
-
+    for members in cluster::select_communities(result, min_size) {
         let mut member_ids: Vec<&String> = members
             .iter()
             .filter_map(|idx| symbol_ids.get(*idx))
@@ -185,11 +507,278 @@ pub fn compute_clusters(
     assignments
 }
 
+/// Label propagation over a CSR graph whose node IDs follow sorted symbol ID
+/// order (as built by `src/graph/csr-snapshot.ts`). Edges are treated as
+/// undirected; `edge_type_mask` selects edge type codes (0 = all) and nodes
+/// flagged in `excluded` never join a community.
+///
+/// Returns one label per node: the lowest node ID of its community, or
+/// `u32::MAX` when the node is unclustered or its community was dropped by
+/// the same size bounds as `compute_clusters`. The caller derives cluster IDs
+/// from the member symbol IDs.
+#[napi]
+pub fn compute_clusters_csr(
+    offsets: Uint32Array,
+    neighbors: Uint32Array,
+    edge_types: Option<Uint8Array>,
+    edge_type_mask: u32,
+    excluded: Option<Uint8Array>,
+    min_cluster_size: u32,
+) -> napi::Result<Uint32Array> {
+    let graph = csr::CsrGraph::new(&offsets, &neighbors, None, edge_types.as_deref())
+        .map_err(napi::Error::from_reason)?;
+    let min_size = if min_cluster_size == 0 {
+        3usize
+    } else {
+        min_cluster_size as usize
+    };
+
+    let node_count = graph.node_count();
+    let edge_pairs = cluster::undirected_edges(&graph, edge_type_mask, excluded.as_deref());
+    let result = cluster::label_propagation(&edge_pairs, node_count, 100);
+
+    let mut labels = vec![u32::MAX; node_count];
+    for members in cluster::select_communities(result, min_size) {
+        let label = members[0] as u32;
+        for node in members {
+            labels[node] = label;
+        }
+    }
+    Ok(Uint32Array::new(labels))
+}
+
+/// Parallel label propagation over the same CSR input as
+/// `compute_clusters_csr`, with an incremental mode.
+///
+/// Without `previous_groups` every node starts from its own label. With it,
+/// `previous_groups[node]` keys the node's community from an earlier run
+/// (`u32::MAX` for none) and `changed` flags the nodes whose edges moved;
+/// only changed nodes are reset and only their neighborhood is re-evaluated.
+///
+/// Returns one raw label per node, before any size bounds: the lowest node ID
+/// of its connected community, or `u32::MAX` for nodes without edges. The
+/// labels can be passed back as `previous_groups` on the next run.
+#[napi]
+#[allow(clippy::too_many_arguments)]
+pub fn compute_communities_csr(
+    offsets: Uint32Array,
+    neighbors: Uint32Array,
+    edge_types: Option<Uint8Array>,
+    edge_type_mask: u32,
+    excluded: Option<Uint8Array>,
+    previous_groups: Option<Uint32Array>,
+    changed: Option<Uint8Array>,
+    max_iterations: u32,
+) -> napi::Result<Uint32Array> {
+    let graph = csr::CsrGraph::new(&offsets, &neighbors, None, edge_types.as_deref())
+        .map_err(napi::Error::from_reason)?;
+    let node_count = graph.node_count();
+    let max_iterations = if max_iterations == 0 {
+        100
+    } else {
+        max_iterations as usize
+    };
+
+    let edge_pairs = cluster::undirected_edges(&graph, edge_type_mask, excluded.as_deref());
+    let undirected = cluster::parallel::UndirectedGraph::from_pairs(&edge_pairs, node_count);
+    let labels = match previous_groups.as_deref() {
+        Some(groups) => {
+            if groups.len() != node_count {
+                return Err(napi::Error::from_reason(
+                    "previous_groups must have one entry per node",
+                ));
+            }
+            let changed = changed.as_deref().unwrap_or(&[]);
+            if !changed.is_empty() && changed.len() != node_count {
+                return Err(napi::Error::from_reason(
+                    "changed must have one entry per node",
+                ));
+            }
+            let (seed, active) =
+                cluster::parallel::seed_from_previous(&undirected, groups, changed);
+            cluster::parallel::propagate_incremental(&undirected, seed, active, max_iterations)
+        }
+        None => cluster::parallel::propagate_full(&undirected, max_iterations),
+    };
+    Ok(Uint32Array::new(cluster::parallel::connected_communities(
+        &undirected,
+        &labels,
+    )))
+}
+
+pub struct ComputeCentralityTask {
+    offsets: Vec<u32>,
+    neighbors: Vec<u32>,
+    previous_page_rank: Option<Vec<f64>>,
+    options: centrality::NativeCentralityOptions,
+}
+
+impl napi::Task for ComputeCentralityTask {
+    type Output = (Vec<f64>, Vec<u32>, usize);
+    type JsValue = centrality::NativeCentrality;
+
+    fn compute(&mut self) -> napi::Result<Self::Output> {
+        let graph = csr::CsrGraph::new(&self.offsets, &self.neighbors, None, None)
+            .map_err(napi::Error::from_reason)?;
+        let options = &self.options;
+        let (page_rank, iterations) = if options.page_rank {
+            let max_iterations = if options.max_iterations == 0 {
+                20
+            } else {
+                options.max_iterations as usize
+            };
+            let result = centrality::rank::page_rank(
+                &graph,
+                options.damping,
+                max_iterations,
+                options.tolerance,
+                self.previous_page_rank.as_deref(),
+            );
+            (result.scores, result.iterations)
+        } else {
+            (Vec::new(), 0)
+        };
+        let k_core = if options.k_core {
+            centrality::kcore::core_numbers(&graph)
+        } else {
+            Vec::new()
+        };
+        Ok((page_rank, k_core, iterations))
+    }
+
+    fn resolve(&mut self, _env: napi::Env, output: Self::Output) -> napi::Result<Self::JsValue> {
+        let (page_rank, k_core, iterations) = output;
+        Ok(centrality::NativeCentrality {
+            page_rank: Float64Array::new(page_rank),
+            k_core: Uint32Array::new(k_core),
+            page_rank_iterations: iterations as u32,
+        })
+    }
+}
+
+/// Global PageRank and k-core over a directed CSR call graph, computed off
+/// the JS thread. `previous_page_rank` (one score per node, e.g. from the
+/// last metrics refresh) warm-starts the power iteration; entries that are
+/// not finite and non-negative fall back to the uniform start.
+#[napi(ts_return_type = "Promise<NativeCentrality>")]
+pub fn compute_centrality_csr(
+    offsets: Uint32Array,
+    neighbors: Uint32Array,
+    previous_page_rank: Option<Float64Array>,
+    options: centrality::NativeCentralityOptions,
+) -> napi::Result<napi::bindgen_prelude::AsyncTask<ComputeCentralityTask>> {
+    csr::CsrGraph::new(&offsets, &neighbors, None, None).map_err(napi::Error::from_reason)?;
+    if previous_page_rank
+        .as_ref()
+        .is_some_and(|values| values.len() != offsets.len() - 1)
+    {
+        return Err(napi::Error::from_reason(
+            "previous_page_rank must have one entry per node",
+        ));
+    }
+    Ok(napi::bindgen_prelude::AsyncTask::new(
+        ComputeCentralityTask {
+            offsets: offsets.to_vec(),
+            neighbors: neighbors.to_vec(),
+            previous_page_rank: previous_page_rank.map(|values| values.to_vec()),
+            options,
+        },
+    ))
+}
+
 #[napi]
 pub fn compute_layout(input_json: String, seed: u32, iterations: u32) -> napi::Result<String> {
     layout::compute_layout_json(&input_json, seed, iterations)
 }
 
+use layout::barnes_hut::{BarnesHutLayout, NativeLayoutSessionOptions};
+use std::sync::Mutex;
+
+#[napi]
+pub struct LayoutSessionHandle {
+    state: Arc<Mutex<BarnesHutLayout>>,
+}
+
+/// Start a Barnes–Hut layout over nodes `0..nodeCount`. Edge `i` runs
+/// `edgeFrom[i] -> edgeTo[i]` with `edgeWeight[i]`. `initialPositions`
+/// holds `x, y, z` per node; nodes with a NaN coordinate are placed from
+/// `seed`. Advance with `step()`, which resolves to the positions so far.
+#[napi]
+pub fn start_layout_session(
+    node_count: u32,
+    edge_from: Uint32Array,
+    edge_to: Uint32Array,
+    edge_weight: Float64Array,
+    initial_positions: Option<Float64Array>,
+    seed: u32,
+    options: Option<NativeLayoutSessionOptions>,
+) -> napi::Result<LayoutSessionHandle> {
+    if edge_to.len() != edge_from.len() || edge_weight.len() != edge_from.len() {
+        return Err(napi::Error::from_reason(
+            "edge_from, edge_to and edge_weight must have the same length",
+        ));
+    }
+    let edges = (0..edge_from.len())
+        .map(|e| (edge_from[e], edge_to[e], edge_weight[e]))
+        .collect();
+    let state = BarnesHutLayout::new(
+        node_count as usize,
+        edges,
+        initial_positions.as_deref(),
+        seed,
+        &options.unwrap_or_default(),
+    )
+    .map_err(napi::Error::from_reason)?;
+    Ok(LayoutSessionHandle {
+        state: Arc::new(Mutex::new(state)),
+    })
+}
+
+pub struct LayoutStepTask {
+    state: Arc<Mutex<BarnesHutLayout>>,
+    iterations: u32,
+}
+
+impl napi::Task for LayoutStepTask {
+    type Output = Vec<f64>;
+    type JsValue = Float64Array;
+
+    fn compute(&mut self) -> napi::Result<Self::Output> {
+        let mut state = self
+            .state
+            .lock()
+            .map_err(|_| napi::Error::from_reason("layout session poisoned"))?;
+        state.step(self.iterations);
+        Ok(state.positions())
+    }
+
+    fn resolve(&mut self, _env: napi::Env, output: Self::Output) -> napi::Result<Self::JsValue> {
+        Ok(Float64Array::new(output))
+    }
+}
+
+#[napi]
+impl LayoutSessionHandle {
+    /// Iterations run so far across every `step()`.
+    #[napi(getter)]
+    pub fn iterations_run(&self) -> napi::Result<u32> {
+        self.state
+            .lock()
+            .map(|state| state.iterations_run())
+            .map_err(|_| napi::Error::from_reason("layout session poisoned"))
+    }
+
+    /// Run `iterations` more iterations off the main thread and resolve with
+    /// every node's `x, y, z`. Concurrent steps run one after another.
+    #[napi(ts_return_type = "Promise<Float64Array>")]
+    pub fn step(&self, iterations: u32) -> napi::bindgen_prelude::AsyncTask<LayoutStepTask> {
+        napi::bindgen_prelude::AsyncTask::new(LayoutStepTask {
+            state: Arc::clone(&self.state),
+            iterations,
+        })
+    }
+}
+
 #[napi]
 pub fn compute_personalized_pagerank(
     adjacency: Vec<Vec<pagerank::NativePprAdjEntry>>,
@@ -201,6 +790,70 @@ pub fn compute_personalized_pagerank(
     pagerank::push::run(adjacency, seeds, alpha, epsilon, max_nodes_touched as usize)
 }
 
+/// [`compute_personalized_pagerank`] over a CSR adjacency. The typed arrays
+/// are read in place, so a snapshot's adjacency is never re-marshalled.
+#[napi]
+pub fn compute_personalized_pagerank_csr(
+    offsets: Uint32Array,
+    neighbors: Uint32Array,
+    weights: Float64Array,
+    seeds: Vec<pagerank::NativePprSeed>,
+    alpha: f64,
+    epsilon: f64,
+    max_nodes_touched: u32,
+) -> napi::Result<Vec<pagerank::NativePprScore>> {
+    let graph = csr::CsrGraph::new(&offsets, &neighbors, Some(&weights), None)
+        .map_err(napi::Error::from_reason)?;
+    Ok(pagerank::push::run_csr(
+        &graph,
+        &seeds,
+        alpha,
+        epsilon,
+        max_nodes_touched as usize,
+    ))
+}
+
+/// Unit-seed PPR vectors for every node in `seed_nodes`, computed in one
+/// batch over a CSR adjacency (see [`pagerank::push::run_csr_batch`]).
+#[napi]
+pub fn compute_personalized_pagerank_csr_batch(
+    offsets: Uint32Array,
+    neighbors: Uint32Array,
+    weights: Float64Array,
+    seed_nodes: Uint32Array,
+    alpha: f64,
+    epsilon: f64,
+    max_nodes_touched: u32,
+) -> napi::Result<pagerank::NativePprBatch> {
+    let graph = csr::CsrGraph::new(&offsets, &neighbors, Some(&weights), None)
+        .map_err(napi::Error::from_reason)?;
+    let vectors = pagerank::push::run_csr_batch(
+        &graph,
+        &seed_nodes,
+        alpha,
+        epsilon,
+        max_nodes_touched as usize,
+    );
+
+    let total: usize = vectors.iter().map(Vec::len).sum();
+    let mut vector_offsets = Vec::with_capacity(vectors.len() + 1);
+    let mut nodes = Vec::with_capacity(total);
+    let mut scores = Vec::with_capacity(total);
+    vector_offsets.push(0u32);
+    for vector in vectors {
+        for entry in vector {
+            nodes.push(entry.node);
+            scores.push(entry.score);
+        }
+        vector_offsets.push(nodes.len() as u32);
+    }
+    Ok(pagerank::NativePprBatch {
+        offsets: Uint32Array::new(vector_offsets),
+        nodes: Uint32Array::new(nodes),
+        scores: Float64Array::new(scores),
+    })
+}
+
 #[napi]
 pub fn trace_processes(
     symbols: Vec<NativeProcessSymbol>,
@@ -274,11 +927,48 @@ pub fn trace_processes(
         .collect()
 }
 
+/// Process tracing over a CSR call graph. `entry_nodes` are dense node IDs
+/// (selected by the caller); each is traced with the same depth-first rules
+/// as `trace_processes`, following only edges that pass `edge_type_mask`
+/// (0 = all). Entries are traced in parallel with results in input order.
+#[napi]
+pub fn trace_processes_csr(
+    offsets: Uint32Array,
+    neighbors: Uint32Array,
+    edge_types: Option<Uint8Array>,
+    edge_type_mask: u32,
+    entry_nodes: Uint32Array,
+    max_depth: u32,
+) -> napi::Result<NativeCsrProcessTraces> {
+    let graph = csr::CsrGraph::new(&offsets, &neighbors, None, edge_types.as_deref())
+        .map_err(napi::Error::from_reason)?;
+    let tracer = process::ProcessTracer::new(Some(process::TracerConfig {
+        max_depth: if max_depth == 0 {
+            process::DEFAULT_MAX_DEPTH
+        } else {
+            max_depth
+        },
+    }));
+
+    let traces = tracer.trace_csr(&graph, edge_type_mask, &entry_nodes);
+    let mut step_offsets = Vec::with_capacity(traces.len() + 1);
+    let mut steps = Vec::new();
+    let mut depths = Vec::with_capacity(traces.len());
+    step_offsets.push(0u32);
+    for trace in traces {
+        steps.extend_from_slice(&trace.steps);
+        step_offsets.push(steps.len() as u32);
+        depths.push(trace.depth);
+    }
+    Ok(NativeCsrProcessTraces {
+        step_offsets: Uint32Array::new(step_offsets),
+        steps: Uint32Array::new(steps),
+        depths: Uint32Array::new(depths),
+    })
+}
+
 fn num_cpus() -> usize {
-    let cpus = std::thread::available_parallelism()
-        .map(|n| n.get())
-        .unwrap_or(1);
-    cpus.saturating_sub(1).max(1)
+    parse::engine::default_thread_count()
 }
 
 // --- SCIP decoder napi exports ---
@@ -299,6 +989,29 @@ pub fn scip_decode_start(file_path: String) -> napi::Result<ScipDecodeHandle> {
     })
 }
 
+/// Encoded payload budget for one `nextDocuments` batch, so a run of very
+/// large documents does not build one oversized JS array.
+const SCIP_DOCUMENT_BATCH_MAX_BYTES: usize = 8 * 1024 * 1024;
+
+pub struct NextScipDocumentsTask {
+    state: Arc<ScipDecodeState>,
+    max_documents: usize,
+}
+
+impl napi::Task for NextScipDocumentsTask {
+    type Output = Vec<scip::types::NapiScipDocument>;
+    type JsValue = Vec<scip::types::NapiScipDocument>;
+
+    fn compute(&mut self) -> napi::Result<Self::Output> {
+        self.state
+            .next_documents(self.max_documents, SCIP_DOCUMENT_BATCH_MAX_BYTES)
+    }
+
+    fn resolve(&mut self, _env: napi::Env, output: Self::Output) -> napi::Result<Self::JsValue> {
+        Ok(output)
+    }
+}
+
 #[napi]
 impl ScipDecodeHandle {
     #[napi]
@@ -311,8 +1024,350 @@ impl ScipDecodeHandle {
         self.state.next_document()
     }
 
+    /// Decode up to `maxDocuments` documents on the libuv thread pool, so the
+    /// caller can keep working on the previous batch meanwhile. Resolves to an
+    /// empty array once every document has been consumed.
+    #[napi(ts_return_type = "Promise<Array<NapiScipDocument>>")]
+    pub fn next_documents(
+        &self,
+        max_documents: u32,
+    ) -> napi::bindgen_prelude::AsyncTask<NextScipDocumentsTask> {
+        napi::bindgen_prelude::AsyncTask::new(NextScipDocumentsTask {
+            state: Arc::clone(&self.state),
+            max_documents: max_documents as usize,
+        })
+    }
+
     #[napi]
     pub fn external_symbols(&self) -> napi::Result<Vec<scip::types::NapiScipExternalSymbol>> {
         self.state.external_symbols()
     }
 }
+
+pub struct BuildEmbeddingIndexTask {
+    path: String,
+    dimension: usize,
+    symbol_ids: Vec<String>,
+    vectors: Vec<f32>,
+    options: vector::NativeEmbeddingIndexOptions,
+}
+
+impl napi::Task for BuildEmbeddingIndexTask {
+    type Output = u32;
+    type JsValue = u32;
+
+    fn compute(&mut self) -> napi::Result<Self::Output> {
+        let iterations = match self.options.iterations.unwrap_or(0) {
+            0 => vector::ivf::DEFAULT_ITERATIONS,
+            n => n as usize,
+        };
+        vector::store::write_index(
+            std::path::Path::new(&self.path),
+            self.dimension,
+            &self.symbol_ids,
+            &self.vectors,
+            self.options.lists.unwrap_or(0) as usize,
+            iterations,
+        )
+        .map(|rows| rows as u32)
+        .map_err(napi::Error::from_reason)
+    }
+
+    fn resolve(&mut self, _env: napi::Env, output: Self::Output) -> napi::Result<Self::JsValue> {
+        Ok(output)
+    }
+}
+
+/// Quantise `vectors` (`dimension` floats per symbol, in `symbolIds` order)
+/// into an IVF embedding index at `path`, replacing any previous file
+/// atomically. Runs on the libuv thread pool and resolves to the row count.
+#[napi(ts_return_type = "Promise<number>")]
+pub fn build_embedding_index(
+    path: String,
+    dimension: u32,
+    symbol_ids: Vec<String>,
+    vectors: napi::bindgen_prelude::Float32Array,
+    options: Option<vector::NativeEmbeddingIndexOptions>,
+) -> napi::bindgen_prelude::AsyncTask<BuildEmbeddingIndexTask> {
+    napi::bindgen_prelude::AsyncTask::new(BuildEmbeddingIndexTask {
+        path,
+        dimension: dimension as usize,
+        symbol_ids,
+        vectors: vectors.to_vec(),
+        options: options.unwrap_or_default(),
+    })
+}
+
+#[napi]
+pub struct EmbeddingIndexHandle {
+    /// `None` once closed. Closing unmaps the file right away instead of
+    /// whenever the JS object is collected, so it can be replaced or removed
+    /// (Windows refuses both while a mapping is open).
+    index: std::sync::RwLock<Option<vector::EmbeddingIndex>>,
+}
+
+/// Memory-map an index written by `buildEmbeddingIndex`.
+#[napi]
+pub fn open_embedding_index(path: String) -> napi::Result<EmbeddingIndexHandle> {
+    let index = vector::EmbeddingIndex::open(std::path::Path::new(&path))
+        .map_err(napi::Error::from_reason)?;
+    Ok(EmbeddingIndexHandle {
+        index: std::sync::RwLock::new(Some(index)),
+    })
+}
+
+impl EmbeddingIndexHandle {
+    fn with_index<T>(&self, f: impl FnOnce(&vector::EmbeddingIndex) -> T) -> Option<T> {
+        let guard = self.index.read().unwrap_or_else(|e| e.into_inner());
+        guard.as_ref().map(f)
+    }
+}
+
+#[napi]
+impl EmbeddingIndexHandle {
+    /// 0 once closed.
+    #[napi(getter)]
+    pub fn dimension(&self) -> u32 {
+        self.with_index(|index| index.dimension() as u32).unwrap_or(0)
+    }
+
+    /// 0 once closed.
+    #[napi(getter)]
+    pub fn rows(&self) -> u32 {
+        self.with_index(|index| index.rows() as u32).unwrap_or(0)
+    }
+
+    #[napi(getter)]
+    pub fn lists(&self) -> u32 {
+        self.with_index(|index| index.lists() as u32).unwrap_or(0)
+    }
+
+    /// Top `k` symbols by approximate cosine similarity to `query`, best
+    /// first, scanning the `nprobe` closest lists (0 = a sixteenth, at
+    /// least 8).
+    #[napi]
+    pub fn search(
+        &self,
+        query: napi::bindgen_prelude::Float32Array,
+        k: u32,
+        nprobe: u32,
+    ) -> napi::Result<Vec<vector::NativeVectorHit>> {
+        let hits = self
+            .with_index(|index| index.search(&query, k as usize, nprobe as usize))
+            .unwrap_or_else(|| Err("embedding index is closed".to_string()))
+            .map_err(napi::Error::from_reason)?;
+        Ok(hits
+            .into_iter()
+            .map(|(symbol_id, score)| vector::NativeVectorHit {
+                symbol_id,
+                score: score as f64,
+            })
+            .collect())
+    }
+
+    /// Unmap the index file. Later calls see an empty, closed index.
+    #[napi]
+    pub fn close(&self) {
+        self.index.write().unwrap_or_else(|e| e.into_inner()).take();
+    }
+}
+
+// --- Lexical index napi exports ---
+
+#[napi]
+pub struct LexicalIndexHandle {
+    index: lexical::LexicalIndex,
+}
+
+fn check_lexical_columns(
+    symbol_ids: &[String],
+    names: &[String],
+    search_texts: &[String],
+) -> napi::Result<()> {
+    if names.len() != symbol_ids.len() || search_texts.len() != symbol_ids.len() {
+        return Err(napi::Error::from_reason(format!(
+            "lexical index columns differ in length: {} symbol IDs, {} names, {} search texts",
+            symbol_ids.len(),
+            names.len(),
+            search_texts.len()
+        )));
+    }
+    Ok(())
+}
+
+fn lexical_hits(hits: Vec<(String, f64)>) -> Vec<lexical::NativeLexicalHit> {
+    hits.into_iter()
+        .map(|(symbol_id, score)| lexical::NativeLexicalHit { symbol_id, score })
+        .collect()
+}
+
+/// Index symbol names and search text in memory, one entry per
+/// `symbolIds` position.
+#[napi]
+pub fn lexical_index_build(
+    symbol_ids: Vec<String>,
+    names: Vec<String>,
+    search_texts: Vec<String>,
+) -> napi::Result<LexicalIndexHandle> {
+    check_lexical_columns(&symbol_ids, &names, &search_texts)?;
+    Ok(LexicalIndexHandle {
+        index: lexical::LexicalIndex::build(&symbol_ids, &names, &search_texts),
+    })
+}
+
+#[napi]
+impl LexicalIndexHandle {
+    #[napi(getter)]
+    pub fn size(&self) -> u32 {
+        self.index.len() as u32
+    }
+
+    /// Insert or replace each symbol's entry.
+    #[napi]
+    pub fn upsert(
+        &mut self,
+        symbol_ids: Vec<String>,
+        names: Vec<String>,
+        search_texts: Vec<String>,
+    ) -> napi::Result<()> {
+        check_lexical_columns(&symbol_ids, &names, &search_texts)?;
+        self.index.upsert(&symbol_ids, &names, &search_texts);
+        Ok(())
+    }
+
+    #[napi]
+    pub fn remove(&mut self, symbol_ids: Vec<String>) {
+        self.index.remove(&symbol_ids);
+    }
+
+    /// Top `limit` symbols by BM25 over the query's words and their
+    /// identifier fragments, best first. Conjunctive queries match only
+    /// symbols holding every word.
+    #[napi]
+    pub fn search(
+        &self,
+        query: String,
+        limit: u32,
+        conjunctive: bool,
+    ) -> Vec<lexical::NativeLexicalHit> {
+        lexical_hits(self.index.search(&query, limit as usize, conjunctive))
+    }
+
+    /// Top `limit` symbols whose name contains `query`, ignoring case.
+    #[napi]
+    pub fn search_substring(&self, query: String, limit: u32) -> Vec<lexical::NativeLexicalHit> {
+        lexical_hits(self.index.search_substring(&query, limit as usize))
+    }
+
+    /// Symbols named exactly `name`, or starting with it when `prefix`,
+    /// case-sensitively and in symbol ID order.
+    #[napi]
+    pub fn find_by_name(&self, name: String, prefix: bool, limit: u32) -> Vec<String> {
+        self.index.find_by_name(&name, prefix, limit as usize)
+    }
+
+    /// Symbol IDs starting with `prefix`, in order.
+    #[napi]
+    pub fn find_by_id_prefix(&self, prefix: String, limit: u32) -> Vec<String> {
+        self.index.find_by_id_prefix(&prefix, limit as usize)
+    }
+
+    #[napi]
+    pub fn contains(&self, symbol_id: String) -> bool {
+        self.index.contains(&symbol_id)
+    }
+}
+
+// --- Slice beam search napi exports ---
+
+#[napi]
+pub struct SliceGraphHandle {
+    graph: slice::SliceGraph,
+}
+
+/// Pack a graph snapshot for `SliceGraphHandle.beamSearch`. Built once per
+/// snapshot; every slice request over it reuses the handle.
+#[napi]
+pub fn slice_graph_build(input: slice::NativeSliceGraphInput) -> napi::Result<SliceGraphHandle> {
+    let graph = slice::SliceGraph {
+        offsets: input.offsets.to_vec(),
+        neighbors: input.neighbors.to_vec(),
+        edge_types: input.edge_types.to_vec(),
+        confidences: input.confidences.to_vec(),
+        names: input.names,
+        node_files: input.node_files.to_vec(),
+        range_start_lines: input.range_start_lines.to_vec(),
+        range_end_lines: input.range_end_lines.to_vec(),
+        file_paths: input.file_paths,
+        file_paths_lower: input.file_paths_lower,
+        structure: input.structure.to_vec(),
+        kind: input.kind.to_vec(),
+        hotness: input.hotness.to_vec(),
+        centrality: input.centrality.to_vec(),
+        card_tokens: input.card_tokens.to_vec(),
+        external: input.external.iter().map(|&flag| flag != 0).collect(),
+        node_clusters: input.node_clusters.to_vec(),
+    };
+    graph.validate().map_err(napi::Error::from_reason)?;
+    Ok(SliceGraphHandle { graph })
+}
+
+#[napi]
+impl SliceGraphHandle {
+    #[napi(getter)]
+    pub fn node_count(&self) -> u32 {
+        self.graph.node_count() as u32
+    }
+
+    /// Run the slice beam search synchronously; results match the
+    /// TypeScript `beamSearch` over the same snapshot.
+    #[napi]
+    pub fn beam_search(
+        &self,
+        request: slice::NativeSliceRequest,
+    ) -> napi::Result<slice::NativeSliceResult> {
+        let beam_request = slice::BeamRequest {
+            start_nodes: &request.start_nodes,
+            start_scores: &request.start_scores,
+            forced_nodes: &request.forced_nodes,
+            entry_nodes: &request.entry_nodes,
+            required_entry_coverage: request.required_entry_coverage as usize,
+            query_tokens: &request.query_tokens,
+            stack_trace: request.stack_trace.as_deref(),
+            edge_weights: &request.edge_weights,
+            cluster_boost: &request.cluster_boost,
+            min_confidence: request.min_confidence,
+            max_cards: request.max_cards as usize,
+            max_estimated_tokens: request.max_estimated_tokens,
+            record_events: request.record_events,
+        };
+        slice::validate_request(&self.graph, &beam_request).map_err(napi::Error::from_reason)?;
+        let out = slice::beam_search(&self.graph, &beam_request);
+        let slice_nodes = Uint32Array::new(out.slice);
+        let frontier = &out.frontier;
+        let events = &out.events;
+        Ok(slice::NativeSliceResult {
+            slice_nodes,
+            frontier_nodes: Uint32Array::new(frontier.iter().map(|i| i.node).collect()),
+            frontier_scores: Float64Array::new(frontier.iter().map(|i| i.score).collect()),
+            frontier_priorities: Uint8Array::new(frontier.iter().map(|i| i.priority).collect()),
+            frontier_sequences: Uint32Array::new(frontier.iter().map(|i| i.sequence).collect()),
+            frontier_starts: Uint32Array::new(frontier.iter().map(|i| i.start).collect()),
+            frontier_edge_types: Uint8Array::new(frontier.iter().map(|i| i.edge_type).collect()),
+            was_truncated: out.was_truncated,
+            dropped_candidates: out.dropped_candidates,
+            max_frontier_size: out.max_frontier_size,
+            accepted: out.accepted,
+            evicted: out.evicted,
+            rejected: out.rejected,
+            event_kinds: Uint8Array::new(events.iter().map(|e| e.kind).collect()),
+            event_nodes: Uint32Array::new(events.iter().map(|e| e.node).collect()),
+            event_scores: Float64Array::new(events.iter().map(|e| e.score).collect()),
+            event_from: Uint32Array::new(events.iter().map(|e| e.from).collect()),
+            event_edge_types: Uint8Array::new(events.iter().map(|e| e.edge_type).collect()),
+            event_edge_weights: Float64Array::new(events.iter().map(|e| e.edge_weight).collect()),
+            event_iterations: Uint32Array::new(events.iter().map(|e| e.iteration).collect()),
+            event_causes: Uint8Array::new(events.iter().map(|e| e.cause).collect()),
+        })
+    }
+}
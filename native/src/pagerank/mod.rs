@@ -4,10 +4,14 @@
 //! to within numerical noise (≤ 1e-3). The napi-rs entry point lives in
 //! `native/src/lib.rs` and dispatches to [`push::run`].
 //!
-//! The adjacency is owned by the TypeScript layer and passed across the FFI as
-//! a `Vec<Vec<NativePprAdjEntry>>`; this keeps the snapshot single-sourced.
+//! The adjacency is owned by the TypeScript layer and passed across the FFI
+//! either as CSR typed arrays borrowed in place ([`push::run_csr`], built once
+//! per graph snapshot) or as a `Vec<Vec<NativePprAdjEntry>>` ([`push::run`]);
+//! this keeps the snapshot single-sourced. [`push::run_csr_batch`] computes
+//! unit-seed vectors for many seeds at once; the TypeScript layer caches them
+//! per snapshot and combines them linearly for weighted seed sets.
 
 pub mod push;
 pub mod types;
 
-pub use types::{NativePprAdjEntry, NativePprScore, NativePprSeed};
+pub use types::{NativePprAdjEntry, NativePprBatch, NativePprScore, NativePprSeed};
@@ -7,7 +7,10 @@
 
 use std::collections::VecDeque;
 
+use rayon::prelude::*;
+
 use super::types::{NativePprAdjEntry, NativePprScore, NativePprSeed};
+use crate::csr::{CsrGraph, OwnedCsr};
 
 /// Run forward-push PPR.
 ///
@@ -24,134 +27,255 @@ pub fn run(
     epsilon: f64,
     max_nodes_touched: usize,
 ) -> Vec<NativePprScore> {
-    let n = adjacency.len();
+    let csr = OwnedCsr::from_rows(
+        adjacency
+            .into_iter()
+            .map(|row| row.into_iter().map(|e| (e.neighbor, e.weight))),
+    );
+    run_csr(&csr.view(), &seeds, alpha, epsilon, max_nodes_touched)
+}
+
+/// [`run`] over a CSR adjacency borrowed from the snapshot. Visits each
+/// row's edges in column order, so both entry points produce identical
+/// scores for the same rows.
+pub fn run_csr(
+    graph: &CsrGraph<'_>,
+    seeds: &[NativePprSeed],
+    alpha: f64,
+    epsilon: f64,
+    max_nodes_touched: usize,
+) -> Vec<NativePprScore> {
+    let n = graph.node_count();
     if n == 0 {
         return Vec::new();
     }
+    let params = PushParams::new(alpha, epsilon, max_nodes_touched);
+    let row_sums = row_sums(graph);
+    Workspace::new(n).push(
+        graph,
+        &row_sums,
+        &params,
+        seeds.iter().map(|s| (s.node as usize, s.weight)),
+    )
+}
 
-    let alpha = clamp01(alpha).unwrap_or(0.15);
-    let epsilon = if epsilon.is_finite() && epsilon > 0.0 {
-        epsilon
-    } else {
-        1e-4
-    };
-    let max_nodes_touched = if max_nodes_touched == 0 {
-        2000
-    } else {
-        max_nodes_touched
-    };
-
-    // Pre-compute row-sum (out-degree weighted) for the residual threshold check.
-    let mut row_sums: Vec<f64> = vec![0.0; n];
-    for (i, row) in adjacency.iter().enumerate() {
-        let mut sum = 0.0;
-        for entry in row {
-            if entry.weight.is_finite() && entry.weight > 0.0 {
-                sum += entry.weight;
+/// Unit-seed PPR vectors for each of `seed_nodes`, in order: entry `i` is
+/// exactly what [`run_csr`] returns for the single seed `(seed_nodes[i], 1.0)`.
+///
+/// Row sums are computed once for the whole batch and each worker reuses
+/// one set of dense buffers, resetting only the nodes it touched, so a batch
+/// costs little more than the pushes themselves. Because PPR is linear in
+/// the seed vector, callers can cache these and serve weighted seed sets as
+/// combinations of them.
+pub fn run_csr_batch(
+    graph: &CsrGraph<'_>,
+    seed_nodes: &[u32],
+    alpha: f64,
+    epsilon: f64,
+    max_nodes_touched: usize,
+) -> Vec<Vec<NativePprScore>> {
+    let n = graph.node_count();
+    if n == 0 {
+        return vec![Vec::new(); seed_nodes.len()];
+    }
+    let params = PushParams::new(alpha, epsilon, max_nodes_touched);
+    let row_sums = row_sums(graph);
+    seed_nodes
+        .par_iter()
+        .map_init(
+            || Workspace::new(n),
+            |workspace, &seed| {
+                workspace.push(
+                    graph,
+                    &row_sums,
+                    &params,
+                    std::iter::once((seed as usize, 1.0)),
+                )
+            },
+        )
+        .collect()
+}
+
+#[derive(Clone, Copy)]
+struct PushParams {
+    alpha: f64,
+    epsilon: f64,
+    max_nodes_touched: usize,
+}
+
+impl PushParams {
+    fn new(alpha: f64, epsilon: f64, max_nodes_touched: usize) -> Self {
+        Self {
+            alpha: clamp01(alpha).unwrap_or(0.15),
+            epsilon: if epsilon.is_finite() && epsilon > 0.0 {
+                epsilon
+            } else {
+                1e-4
+            },
+            max_nodes_touched: if max_nodes_touched == 0 {
+                2000
+            } else {
+                max_nodes_touched
+            },
+        }
+    }
+}
+
+/// Row-sum (out-degree weighted) per node, for the residual threshold check.
+fn row_sums(graph: &CsrGraph<'_>) -> Vec<f64> {
+    (0..graph.node_count())
+        .map(|i| {
+            let mut sum = 0.0;
+            for edge in graph.edges(i) {
+                let weight = graph.weight(edge);
+                if weight.is_finite() && weight > 0.0 {
+                    sum += weight;
+                }
             }
+            sum
+        })
+        .collect()
+}
+
+/// Dense per-node push state, reusable across runs on the same graph.
+struct Workspace {
+    p: Vec<f64>,
+    r: Vec<f64>,
+    in_queue: Vec<u8>,
+    touched: Vec<u8>,
+    /// Nodes with `touched == 1`, in first-touch order; sized to the run.
+    touched_nodes: Vec<usize>,
+    queue: VecDeque<usize>,
+}
+
+impl Workspace {
+    fn new(n: usize) -> Self {
+        Self {
+            p: vec![0.0; n],
+            r: vec![0.0; n],
+            in_queue: vec![0; n],
+            touched: vec![0; n],
+            touched_nodes: Vec::new(),
+            queue: VecDeque::new(),
         }
-        row_sums[i] = sum;
     }
 
-    let mut p: Vec<f64> = vec![0.0; n];
-    let mut r: Vec<f64> = vec![0.0; n];
-    let mut in_queue: Vec<u8> = vec![0; n];
-    let mut touched: Vec<u8> = vec![0; n];
-    let mut touched_count: usize = 0;
-    let mut queue: VecDeque<usize> = VecDeque::new();
-
-    let enqueue_if_above = |node: usize,
-                            r: &Vec<f64>,
-                            row_sums: &Vec<f64>,
-                            in_queue: &mut Vec<u8>,
-                            queue: &mut VecDeque<usize>| {
-        if in_queue[node] == 1 {
+    fn touch(&mut self, node: usize) {
+        if self.touched[node] == 0 {
+            self.touched[node] = 1;
+            self.touched_nodes.push(node);
+        }
+    }
+
+    fn enqueue_if_above(&mut self, node: usize, row_sums: &[f64], epsilon: f64) {
+        if self.in_queue[node] == 1 {
             return;
         }
         let deg = row_sums[node];
         if deg <= 0.0 {
             return;
         }
-        if r[node] / deg < epsilon {
+        if self.r[node] / deg < epsilon {
             return;
         }
-        queue.push_back(node);
-        in_queue[node] = 1;
-    };
-
-    for seed in seeds {
-        let idx = seed.node as usize;
-        if idx >= n {
-            continue;
-        }
-        if !seed.weight.is_finite() || seed.weight <= 0.0 {
-            continue;
-        }
-        r[idx] += seed.weight;
-        if touched[idx] == 0 {
-            touched[idx] = 1;
-            touched_count += 1;
-        }
-        enqueue_if_above(idx, &r, &row_sums, &mut in_queue, &mut queue);
+        self.queue.push_back(node);
+        self.in_queue[node] = 1;
     }
 
-    let push_safety_cap = max_nodes_touched.saturating_mul(32);
-    let mut pushed: usize = 0;
+    /// One forward push from `seeds`. Returns the sparse scores sorted by
+    /// node and leaves the workspace zeroed for the next run.
+    fn push(
+        &mut self,
+        graph: &CsrGraph<'_>,
+        row_sums: &[f64],
+        params: &PushParams,
+        seeds: impl Iterator<Item = (usize, f64)>,
+    ) -> Vec<NativePprScore> {
+        let n = self.p.len();
+        let PushParams {
+            alpha,
+            epsilon,
+            max_nodes_touched,
+        } = *params;
 
-    while let Some(u) = queue.pop_front() {
-        if touched_count >= max_nodes_touched {
-            break;
-        }
-        in_queue[u] = 0;
-        let ru = r[u];
-        if ru == 0.0 {
-            continue;
-        }
-        let deg = row_sums[u];
-        if deg <= 0.0 {
-            continue;
-        }
-        if ru / deg < epsilon {
-            continue;
+        for (idx, weight) in seeds {
+            if idx >= n {
+                continue;
+            }
+            if !weight.is_finite() || weight <= 0.0 {
+                continue;
+            }
+            self.r[idx] += weight;
+            self.touch(idx);
+            self.enqueue_if_above(idx, row_sums, epsilon);
         }
 
-        p[u] += alpha * ru;
-        let remaining = (1.0 - alpha) * ru;
-        r[u] = 0.0;
+        let push_safety_cap = max_nodes_touched.saturating_mul(32);
+        let mut pushed: usize = 0;
 
-        for entry in &adjacency[u] {
-            if !entry.weight.is_finite() || entry.weight <= 0.0 {
+        while let Some(u) = self.queue.pop_front() {
+            if self.touched_nodes.len() >= max_nodes_touched {
+                break;
+            }
+            self.in_queue[u] = 0;
+            let ru = self.r[u];
+            if ru == 0.0 {
                 continue;
             }
-            let v = entry.neighbor as usize;
-            if v >= n {
+            let deg = row_sums[u];
+            if deg <= 0.0 {
                 continue;
             }
-            let delta = remaining * (entry.weight / deg);
-            r[v] += delta;
-            if touched[v] == 0 {
-                touched[v] = 1;
-                touched_count += 1;
+            if ru / deg < epsilon {
+                continue;
             }
-            enqueue_if_above(v, &r, &row_sums, &mut in_queue, &mut queue);
-        }
 
-        pushed += 1;
-        if pushed > push_safety_cap {
-            break;
+            self.p[u] += alpha * ru;
+            let remaining = (1.0 - alpha) * ru;
+            self.r[u] = 0.0;
+
+            for edge in graph.edges(u) {
+                let weight = graph.weight(edge);
+                if !weight.is_finite() || weight <= 0.0 {
+                    continue;
+                }
+                let v = graph.neighbor(edge);
+                if v >= n {
+                    continue;
+                }
+                let delta = remaining * (weight / deg);
+                self.r[v] += delta;
+                self.touch(v);
+                self.enqueue_if_above(v, row_sums, epsilon);
+            }
+
+            pushed += 1;
+            if pushed > push_safety_cap {
+                break;
+            }
         }
-    }
 
-    let mut out: Vec<NativePprScore> = Vec::new();
-    for (idx, score) in p.into_iter().enumerate() {
-        if score > 0.0 && score.is_finite() {
-            out.push(NativePprScore {
-                node: idx as u32,
-                score,
-            });
+        // Only touched nodes can hold score; visiting them in node order
+        // keeps the output identical to a dense scan.
+        self.touched_nodes.sort_unstable();
+        let mut out: Vec<NativePprScore> = Vec::new();
+        for &idx in &self.touched_nodes {
+            let score = self.p[idx];
+            if score > 0.0 && score.is_finite() {
+                out.push(NativePprScore {
+                    node: idx as u32,
+                    score,
+                });
+            }
+            self.p[idx] = 0.0;
+            self.r[idx] = 0.0;
+            self.in_queue[idx] = 0;
+            self.touched[idx] = 0;
         }
+        self.touched_nodes.clear();
+        self.queue.clear();
+        out
     }
-    out
 }
 
 fn clamp01(x: f64) -> Option<f64> {
@@ -273,6 +397,52 @@ mod tests {
         }
     }
 
+    #[test]
+    fn csr_entry_point_matches_row_lists() {
+        let rows = six_node_graph();
+        let csr = OwnedCsr::from_rows(rows.iter().map(|row| {
+            row.iter()
+                .map(|e| (e.neighbor, e.weight))
+                .collect::<Vec<_>>()
+        }));
+        let seed = seeds(&[(0, 0.7), (3, 0.3)]);
+        let from_rows = run(rows, seed.clone(), 0.15, 1e-4, 2000);
+        let from_csr = run_csr(&csr.view(), &seed, 0.15, 1e-4, 2000);
+        assert_eq!(from_rows.len(), from_csr.len());
+        for (a, b) in from_rows.iter().zip(&from_csr) {
+            assert_eq!(a.node, b.node);
+            assert_eq!(a.score.to_bits(), b.score.to_bits());
+        }
+    }
+
+    #[test]
+    fn batch_matches_single_seed_runs() {
+        let csr = OwnedCsr::from_rows(six_node_graph().iter().map(|row| {
+            row.iter()
+                .map(|e| (e.neighbor, e.weight))
+                .collect::<Vec<_>>()
+        }));
+        let graph = csr.view();
+        // Repeats and out-of-range seeds exercise workspace reuse.
+        let nodes = [0, 3, 0, 99, 5, 1];
+        let batch = run_csr_batch(&graph, &nodes, 0.15, 1e-4, 2000);
+        assert_eq!(batch.len(), nodes.len());
+        for (vector, &node) in batch.iter().zip(&nodes) {
+            let single = run_csr(&graph, &seeds(&[(node, 1.0)]), 0.15, 1e-4, 2000);
+            assert_eq!(vector.len(), single.len(), "seed {node}");
+            for (a, b) in vector.iter().zip(&single) {
+                assert_eq!(a.node, b.node);
+                assert_eq!(a.score.to_bits(), b.score.to_bits());
+            }
+        }
+        assert!(batch[3].is_empty());
+
+        let empty = OwnedCsr::from_rows(Vec::<Vec<(u32, f64)>>::new());
+        let batch = run_csr_batch(&empty.view(), &[0], 0.15, 1e-4, 2000);
+        assert_eq!(batch.len(), 1);
+        assert!(batch[0].is_empty());
+    }
+
     #[test]
     fn touched_cap_bounds_payload() {
         // Tight cap of 3 means the seed (touched=1) plus its first push to
@@ -35,3 +35,13 @@ pub struct NativePprScore {
     pub node: u32,
     pub score: f64,
 }
+
+/// Unit-seed PPR vectors from `computePersonalizedPagerankCsrBatch`,
+/// flattened. Vector `i` (for the `i`-th seed node) is
+/// `nodes[offsets[i]..offsets[i + 1]]` with matching `scores`, sorted by node.
+#[napi(object)]
+pub struct NativePprBatch {
+    pub offsets: napi::bindgen_prelude::Uint32Array,
+    pub nodes: napi::bindgen_prelude::Uint32Array,
+    pub scores: napi::bindgen_prelude::Float64Array,
+}
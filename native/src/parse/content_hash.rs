@@ -1,4 +1,9 @@
 use sha2::{Digest, Sha256};
+use xxhash_rust::xxh3::xxh3_128;
+
+/// Name of the digest produced by [`fast_hash_bytes`]. Stored with the index
+/// so persisted fast digests are only compared against the same algorithm.
+pub const FAST_HASH_ALGORITHM: &str = "xxh3-128";
 
 /// SHA-256 hash of content, returned as lowercase hex.
 /// Exact parity with TypeScript `hashContent(content: string): string`.
@@ -14,6 +19,19 @@ pub fn hash_content(content: &str) -> String {
     hex::encode(hasher.finalize())
 }
 
+/// SHA-256 of raw file bytes as lowercase hex. Matches the TypeScript
+/// scanner's `hash("sha256", buffer, "hex")`, BOM and line endings included.
+pub fn hash_bytes(bytes: &[u8]) -> String {
+    hex::encode(Sha256::digest(bytes))
+}
+
+/// Non-cryptographic XXH3-128 digest of raw file bytes as 32 lowercase hex
+/// chars. Much cheaper than SHA-256 on large inputs, so the scanner uses it
+/// to confirm a file is unchanged before paying for [`hash_bytes`].
+pub fn fast_hash_bytes(bytes: &[u8]) -> String {
+    format!("{:032x}", xxh3_128(bytes))
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -43,4 +61,19 @@ mod tests {
         let hash = hash_content(content);
         assert_eq!(hash.len(), 64); // SHA-256 hex is always 64 chars
     }
+
+    #[test]
+    fn raw_byte_hash_matches_text_hash_for_utf8() {
+        assert_eq!(hash_bytes(b"hello world"), hash_content("hello world"));
+    }
+
+    #[test]
+    fn fast_hash_shape_and_sensitivity() {
+        // XXH3-128 with seed 0 of the empty input.
+        assert_eq!(fast_hash_bytes(b""), "99aa06d3014798d86001c324468d497f");
+        let a = fast_hash_bytes(b"export const a = 1;");
+        assert_eq!(a.len(), 32);
+        assert_ne!(a, fast_hash_bytes(b"export const a = 2;"));
+        assert_eq!(a, fast_hash_bytes(b"export const a = 1;"));
+    }
 }
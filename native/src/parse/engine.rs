@@ -0,0 +1,246 @@
+//! Process-lifetime parse engine.
+//!
+//! Owns the Rayon worker pool used by [`super::parse_files_parallel`] so that
+//! each napi batch reuses warm worker threads (and their thread-local
+//! tree-sitter parsers, see [`crate::lang::with_cached_parser`]) instead of
+//! spawning a fresh 64 MiB-stack pool per call.
+//!
+//! The pool is built once, at the size passed to [`configure`] or the default
+//! (available cores minus one) on first use. A batch's own thread count only
+//! caps how many workers it occupies ([`for_each_limited`]), so callers asking
+//! for different counts share the same threads. Only an explicit
+//! [`configure`] with a new size swaps in a new pool; batches already running
+//! on the old pool keep their `Arc` and finish undisturbed.
+
+use std::sync::atomic::{AtomicBool, AtomicU64, AtomicUsize, Ordering};
+use std::sync::{Arc, Mutex, OnceLock};
+
+use rayon::prelude::*;
+
+use super::RAYON_STACK_SIZE;
+
+/// Pool slot shared by every parse batch in the process.
+struct EngineSlot {
+    pool: Option<Arc<rayon::ThreadPool>>,
+    thread_count: usize,
+}
+
+static ENGINE: OnceLock<Mutex<EngineSlot>> = OnceLock::new();
+static POOL_BUILDS: AtomicU64 = AtomicU64::new(0);
+static BATCHES_PARSED: AtomicU64 = AtomicU64::new(0);
+static FILES_PARSED: AtomicU64 = AtomicU64::new(0);
+
+fn slot() -> &'static Mutex<EngineSlot> {
+    ENGINE.get_or_init(|| {
+        Mutex::new(EngineSlot {
+            pool: None,
+            thread_count: 0,
+        })
+    })
+}
+
+/// Snapshot of the engine's configuration and lifetime counters.
+#[derive(Debug, Clone, Copy, Default)]
+pub struct EngineStats {
+    pub thread_count: usize,
+    pub pool_builds: u64,
+    pub batches_parsed: u64,
+    pub files_parsed: u64,
+}
+
+/// Available cores minus one, leaving a core for the Node.js event loop.
+pub fn default_thread_count() -> usize {
+    std::thread::available_parallelism()
+        .map(|n| n.get())
+        .unwrap_or(1)
+        .saturating_sub(1)
+        .max(1)
+}
+
+fn build_pool(thread_count: usize) -> Result<rayon::ThreadPool, rayon::ThreadPoolBuildError> {
+    rayon::ThreadPoolBuilder::new()
+        .num_threads(thread_count)
+        .stack_size(RAYON_STACK_SIZE)
+        .thread_name(|idx| format!("sdl-parse-{idx}"))
+        .build()
+}
+
+/// Build a `thread_count` pool into `slot`. Returns `None` only when no pool
+/// can be built at all, in which case callers parse sequentially.
+fn install_pool(slot: &mut EngineSlot, thread_count: usize) -> Option<Arc<rayon::ThreadPool>> {
+    match build_pool(thread_count) {
+        Ok(pool) => {
+            POOL_BUILDS.fetch_add(1, Ordering::Relaxed);
+            let pool = Arc::new(pool);
+            slot.pool = Some(Arc::clone(&pool));
+            slot.thread_count = thread_count;
+            Some(pool)
+        }
+        Err(e1) => {
+            // Keep serving from the existing pool if a resize fails; otherwise
+            // fall back to a default-sized pool before giving up entirely.
+            if let Some(pool) = slot.pool.as_ref() {
+                eprintln!(
+                    "sdl-mcp-native: resizing parse pool to {thread_count} failed ({e1}), keeping {} threads",
+                    slot.thread_count
+                );
+                return Some(Arc::clone(pool));
+            }
+            match rayon::ThreadPoolBuilder::new().build() {
+                Ok(pool) => {
+                    eprintln!(
+                        "sdl-mcp-native: custom Rayon pool failed ({e1}), using default pool"
+                    );
+                    POOL_BUILDS.fetch_add(1, Ordering::Relaxed);
+                    let threads = pool.current_num_threads();
+                    let pool = Arc::new(pool);
+                    slot.pool = Some(Arc::clone(&pool));
+                    slot.thread_count = threads;
+                    Some(pool)
+                }
+                Err(e2) => {
+                    eprintln!(
+                        "sdl-mcp-native: all Rayon pools failed ({e1}, {e2}), parsing sequentially"
+                    );
+                    None
+                }
+            }
+        }
+    }
+}
+
+/// Return the shared pool, building it at [`default_thread_count`] on first
+/// use. Never resizes an existing pool.
+pub fn pool() -> Option<Arc<rayon::ThreadPool>> {
+    let mut guard = slot().lock().unwrap_or_else(|e| e.into_inner());
+    if let Some(pool) = guard.pool.as_ref() {
+        return Some(Arc::clone(pool));
+    }
+    install_pool(&mut guard, default_thread_count())
+}
+
+/// Run `f(state, i)` for every `i` in `0..len` on `pool`, with at most
+/// `parallelism` calls in flight at once. Each lane pulls the next index from
+/// a shared counter, so lanes stay balanced without resizing the pool, and
+/// the pool's other workers stay free for concurrent batches. `f` returns
+/// `false` to stop its lane; other lanes stop at their next index.
+pub fn for_each_limited<S, F>(
+    pool: &rayon::ThreadPool,
+    len: usize,
+    parallelism: usize,
+    init: S,
+    f: F,
+) where
+    S: Clone + Send,
+    F: Fn(&mut S, usize) -> bool + Sync,
+{
+    let lanes = parallelism
+        .clamp(1, pool.current_num_threads().max(1))
+        .min(len.max(1));
+    let next = AtomicUsize::new(0);
+    let stopped = AtomicBool::new(false);
+    pool.install(|| {
+        (0..lanes).into_par_iter().for_each_with(init, |state, _| {
+            while !stopped.load(Ordering::Relaxed) {
+                let i = next.fetch_add(1, Ordering::Relaxed);
+                if i >= len {
+                    break;
+                }
+                if !f(state, i) {
+                    stopped.store(true, Ordering::Relaxed);
+                    break;
+                }
+            }
+        });
+    });
+}
+
+/// Size the shared pool. Returns the effective thread count, or 0 when no
+/// pool could be built. A call with the current size is a no-op.
+pub fn configure(thread_count: usize) -> usize {
+    let thread_count = thread_count.max(1);
+    let mut guard = slot().lock().unwrap_or_else(|e| e.into_inner());
+    if let Some(pool) = guard.pool.as_ref() {
+        if guard.thread_count == thread_count {
+            return pool.current_num_threads();
+        }
+    }
+    match install_pool(&mut guard, thread_count) {
+        Some(pool) => pool.current_num_threads(),
+        None => 0,
+    }
+}
+
+/// Drop the shared pool. Worker threads exit once in-flight batches release
+/// their handles; the next batch rebuilds the pool on demand.
+pub fn shutdown() {
+    let mut guard = slot().lock().unwrap_or_else(|e| e.into_inner());
+    guard.pool = None;
+    guard.thread_count = 0;
+}
+
+/// Record a completed batch of `file_count` files.
+pub fn record_batch(file_count: usize) {
+    BATCHES_PARSED.fetch_add(1, Ordering::Relaxed);
+    FILES_PARSED.fetch_add(file_count as u64, Ordering::Relaxed);
+}
+
+pub fn stats() -> EngineStats {
+    let guard = slot().lock().unwrap_or_else(|e| e.into_inner());
+    EngineStats {
+        thread_count: if guard.pool.is_some() {
+            guard.thread_count
+        } else {
+            0
+        },
+        pool_builds: POOL_BUILDS.load(Ordering::Relaxed),
+        batches_parsed: BATCHES_PARSED.load(Ordering::Relaxed),
+        files_parsed: FILES_PARSED.load(Ordering::Relaxed),
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::time::Duration;
+
+    #[test]
+    fn pool_is_shared_across_thread_counts_and_rebuilt_only_by_configure() {
+        let a = pool().expect("pool");
+        let b = pool().expect("pool");
+        assert!(Arc::ptr_eq(&a, &b), "batches must share one pool");
+
+        let threads = a.current_num_threads();
+        let builds = stats().pool_builds;
+        assert_eq!(configure(threads), threads);
+        assert_eq!(stats().pool_builds, builds, "same size must not rebuild");
+
+        let c = {
+            configure(threads + 1);
+            pool().expect("pool")
+        };
+        assert!(!Arc::ptr_eq(&a, &c), "resize must swap in a new pool");
+        assert_eq!(c.current_num_threads(), threads + 1);
+
+        // The old handle stays usable for work already scheduled on it.
+        assert_eq!(a.install(|| 1 + 1), 2);
+    }
+
+    #[test]
+    fn for_each_limited_caps_concurrency_and_visits_every_index() {
+        let pool = build_pool(4).expect("pool");
+        let running = AtomicUsize::new(0);
+        let peak = AtomicUsize::new(0);
+        let visited = AtomicUsize::new(0);
+        for_each_limited(&pool, 32, 2, (), |_, _| {
+            let now = running.fetch_add(1, Ordering::SeqCst) + 1;
+            peak.fetch_max(now, Ordering::SeqCst);
+            std::thread::sleep(Duration::from_millis(2));
+            running.fetch_sub(1, Ordering::SeqCst);
+            visited.fetch_add(1, Ordering::SeqCst);
+            true
+        });
+        assert_eq!(visited.load(Ordering::SeqCst), 32);
+        assert!(peak.load(Ordering::SeqCst) <= 2);
+    }
+}
@@ -0,0 +1,89 @@
+use std::sync::OnceLock;
+
+use super::{content_hash, engine, file_reader};
+use crate::types::{NativeFileHash, NativeFileHashInput};
+
+/// Hash one file's raw bytes. The XXH3 digest is always computed; SHA-256
+/// only when that digest differs from `known_fast_hash`, since a match means
+/// the caller already holds the SHA-256 of these exact bytes.
+pub fn hash_file(input: &NativeFileHashInput) -> NativeFileHash {
+    match file_reader::read_bytes(&input.absolute_path) {
+        Ok(bytes) => {
+            let fast = content_hash::fast_hash_bytes(&bytes);
+            let content_hash = (input.known_fast_hash.as_deref() != Some(fast.as_str()))
+                .then(|| content_hash::hash_bytes(&bytes));
+            NativeFileHash {
+                content_fast_hash: Some(fast),
+                content_hash,
+                error: None,
+            }
+        }
+        Err(e) => NativeFileHash {
+            content_fast_hash: None,
+            content_hash: None,
+            error: Some(format!("{e}")),
+        },
+    }
+}
+
+/// Hash a batch of files on the shared parse pool, using at most
+/// `thread_count` of its workers. Results are in input order.
+pub fn hash_files_parallel(
+    files: &[NativeFileHashInput],
+    thread_count: usize,
+) -> Vec<NativeFileHash> {
+    match engine::pool() {
+        Some(pool) => {
+            let slots: Vec<OnceLock<NativeFileHash>> =
+                files.iter().map(|_| OnceLock::new()).collect();
+            engine::for_each_limited(&pool, files.len(), thread_count, (), |_, i| {
+                let _ = slots[i].set(hash_file(&files[i]));
+                true
+            });
+            slots
+                .into_iter()
+                .map(|slot| slot.into_inner().expect("every file is hashed"))
+                .collect()
+        }
+        None => files.iter().map(hash_file).collect(),
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::fs;
+
+    #[test]
+    fn sha256_is_skipped_only_while_the_fast_digest_matches() {
+        let path =
+            std::env::temp_dir().join(format!("sdl_mcp_file_hash_{}.ts", std::process::id()));
+        fs::write(&path, "\u{FEFF}export const a = 1;\r\n").expect("write temp file");
+        let bytes = fs::read(&path).expect("read temp file");
+        let input = |known: Option<String>| NativeFileHashInput {
+            absolute_path: path.to_string_lossy().into_owned(),
+            known_fast_hash: known,
+        };
+
+        let fresh = hash_file(&input(None));
+        let fast = content_hash::fast_hash_bytes(&bytes);
+        assert_eq!(fresh.content_fast_hash.as_deref(), Some(fast.as_str()));
+        assert_eq!(fresh.content_hash, Some(content_hash::hash_bytes(&bytes)));
+
+        let unchanged = hash_file(&input(Some(fast.clone())));
+        assert_eq!(unchanged.content_fast_hash.as_deref(), Some(fast.as_str()));
+        assert_eq!(unchanged.content_hash, None);
+
+        let stale = hash_file(&input(Some("0".repeat(32))));
+        assert_eq!(stale.content_hash, fresh.content_hash);
+
+        let batch = hash_files_parallel(&[input(None), input(Some(fast))], 2);
+        assert_eq!(batch[0].content_hash, fresh.content_hash);
+        assert_eq!(batch[1].content_hash, None);
+        let _ = fs::remove_file(&path);
+
+        let missing = hash_file(&input(None));
+        assert!(missing.error.is_some());
+        assert_eq!(missing.content_fast_hash, None);
+    }
+}
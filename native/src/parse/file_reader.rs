@@ -1,19 +1,130 @@
-use std::fs;
-use std::path::Path;
+use std::borrow::Cow;
+use std::fs::File;
+use std::ops::Deref;
 
 use crate::error::IndexerError;
 
-/// Read file content as UTF-8 string, handling BOM if present.
-pub fn read_file(path: &str) -> Result<String, IndexerError> {
-    let path = Path::new(path);
-    let bytes = fs::read(path)?;
+use super::MAX_PARSE_FILE_BYTES;
 
-    // Strip UTF-8 BOM if present (0xEF 0xBB 0xBF)
-    let content = if bytes.starts_with(&[0xEF, 0xBB, 0xBF]) {
-        String::from_utf8_lossy(&bytes[3..]).into_owned()
-    } else {
-        String::from_utf8_lossy(&bytes).into_owned()
-    };
+const UTF8_BOM: [u8; 3] = [0xEF, 0xBB, 0xBF];
 
-    Ok(content)
+/// Strip a UTF-8 BOM and convert to `String`, copying only when the bytes
+/// need replacement characters.
+///
+/// Valid UTF-8 (the common case) is adopted in place: the buffer the file
+/// was read into becomes the returned `String` without a second copy.
+pub fn decode_utf8(mut bytes: Vec<u8>) -> String {
+    if bytes.starts_with(&UTF8_BOM) {
+        bytes.drain(..UTF8_BOM.len());
+    }
+    match String::from_utf8(bytes) {
+        Ok(content) => content,
+        Err(e) => String::from_utf8_lossy(e.as_bytes()).into_owned(),
+    }
+}
+
+/// Raw bytes of a file: read into memory, or memory-mapped when the file is
+/// larger than [`MAX_PARSE_FILE_BYTES`]. Files that big are only hashed,
+/// never parsed, so mapping them skips an allocation and copy the size of
+/// the file.
+pub enum FileBytes {
+    Read(Vec<u8>),
+    Mapped(memmap2::Mmap),
+}
+
+impl Deref for FileBytes {
+    type Target = [u8];
+
+    fn deref(&self) -> &[u8] {
+        match self {
+            FileBytes::Read(bytes) => bytes,
+            FileBytes::Mapped(map) => map,
+        }
+    }
+}
+
+/// Open `path` as [`FileBytes`], mapping it when it exceeds the parse limit.
+pub fn read_bytes(path: &str) -> Result<FileBytes, IndexerError> {
+    let mut file = File::open(path)?;
+    let len = file.metadata()?.len();
+    if len > MAX_PARSE_FILE_BYTES as u64 {
+        // SAFETY: the mapping is only read while hashing. A file truncated
+        // underneath it by another process can fault, the same exposure the
+        // embedding index accepts for its mapped files.
+        return Ok(FileBytes::Mapped(unsafe { memmap2::Mmap::map(&file)? }));
+    }
+    let mut bytes = Vec::with_capacity(len as usize);
+    std::io::Read::read_to_end(&mut file, &mut bytes)?;
+    Ok(FileBytes::Read(bytes))
+}
+
+/// Decoded view of raw bytes with the same BOM and lossy handling as
+/// [`decode_utf8`], borrowing instead of copying when they are valid UTF-8.
+pub fn decode_utf8_borrowed(bytes: &[u8]) -> Cow<'_, str> {
+    String::from_utf8_lossy(bytes.strip_prefix(&UTF8_BOM).unwrap_or(bytes))
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::fs;
+
+    #[test]
+    fn valid_utf8_reuses_the_read_buffer() {
+        let bytes = "const x = '🎉';".as_bytes().to_vec();
+        let ptr = bytes.as_ptr();
+        let content = decode_utf8(bytes);
+        assert_eq!(content, "const x = '🎉';");
+        assert_eq!(content.as_ptr(), ptr);
+    }
+
+    #[test]
+    fn bom_is_stripped() {
+        let mut bytes = UTF8_BOM.to_vec();
+        bytes.extend_from_slice(b"let a = 1;");
+        assert_eq!(decode_utf8(bytes), "let a = 1;");
+    }
+
+    #[test]
+    fn borrowed_decode_matches_owned_decode() {
+        let mut bytes = UTF8_BOM.to_vec();
+        bytes.extend_from_slice(b"let a = 1;");
+        assert!(matches!(
+            decode_utf8_borrowed(&bytes),
+            Cow::Borrowed("let a = 1;")
+        ));
+        let invalid = [b'a', 0xFF, b'b'];
+        assert_eq!(
+            decode_utf8_borrowed(&invalid),
+            decode_utf8(invalid.to_vec())
+        );
+    }
+
+    #[test]
+    fn oversized_files_are_mapped() {
+        let path = std::env::temp_dir().join(format!(
+            "sdl_mcp_read_bytes_{}_{:?}.txt",
+            std::process::id(),
+            std::thread::current().id()
+        ));
+        let small = b"fn main() {}".to_vec();
+        fs::write(&path, &small).expect("write small file");
+        let read = read_bytes(path.to_str().unwrap()).expect("read small file");
+        assert!(matches!(read, FileBytes::Read(_)));
+        assert_eq!(&*read, small.as_slice());
+
+        let large = vec![b'x'; MAX_PARSE_FILE_BYTES + 1];
+        fs::write(&path, &large).expect("write large file");
+        let mapped = read_bytes(path.to_str().unwrap()).expect("map large file");
+        assert!(matches!(mapped, FileBytes::Mapped(_)));
+        assert_eq!(mapped.len(), large.len());
+        drop(mapped);
+        let _ = fs::remove_file(path);
+    }
+
+    #[test]
+    fn invalid_sequences_are_replaced() {
+        let bytes = vec![b'a', 0xFF, b'b'];
+        assert_eq!(decode_utf8(bytes), "a\u{FFFD}b");
+    }
 }
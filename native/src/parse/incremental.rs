@@ -0,0 +1,860 @@
+//! Incremental re-parse for live-index draft buffers.
+//!
+//! Keeps the previous tree-sitter `Tree`, content, and parse result per
+//! (repo, relPath). A new buffer version is applied to the old tree via
+//! `Tree::edit` and re-parsed with it, so tree-sitter only re-lexes the
+//! edited region. The expensive text enrichment (summary, invariants, side
+//! effects, search text) is carried over for every symbol whose source window
+//! lies outside the changed lines.
+//!
+//! Symbols are re-extracted only from the top-level declarations that
+//! intersect the edit or tree-sitter's `changed_ranges`; the previous symbols
+//! of every other declaration are carried over, shifted past the edit. A
+//! symbol depends only on its own subtree and its ancestors, so an untouched
+//! declaration yields the same symbols. Imports and calls are still extracted
+//! from the whole tree: call classification looks callees up in the file-wide
+//! symbol table, so an edit in one declaration can change calls in another.
+
+use std::collections::{HashMap, VecDeque};
+use std::panic;
+use std::sync::{Mutex, OnceLock};
+
+use tree_sitter::{InputEdit, Node, Point, Range, Tree};
+
+use super::{content_hash, enrich_symbol, MAX_PARSE_FILE_BYTES};
+use crate::extract;
+use crate::extract::calls::common::make_node_id;
+use crate::extract::file_context::FileContext;
+use crate::extract::symbols::common::extract_range;
+use crate::lang;
+use crate::types::{
+    NativeIncrementalParseInput, NativeIncrementalParseResult, NativeParsedFile,
+    NativeParsedSymbol, NativeRange, NativeTextEdit,
+};
+
+/// Maximum number of drafts whose trees are kept alive. Matches the live
+/// index's default draft limit with some headroom for multiple repos.
+pub const DEFAULT_MAX_CACHED_DRAFTS: usize = 256;
+
+/// Explicit edit lists longer than this are ignored in favour of a single
+/// covering edit derived from the old and new contents.
+const MAX_EXPLICIT_EDITS: usize = 64;
+
+struct CachedDraft {
+    language: String,
+    content: String,
+    tree: Tree,
+    file: NativeParsedFile,
+}
+
+struct DraftCache {
+    entries: HashMap<String, CachedDraft>,
+    order: VecDeque<String>,
+    capacity: usize,
+}
+
+impl DraftCache {
+    fn take(&mut self, key: &str) -> Option<CachedDraft> {
+        let entry = self.entries.remove(key);
+        if entry.is_some() {
+            self.order.retain(|k| k != key);
+        }
+        entry
+    }
+
+    fn put(&mut self, key: String, draft: CachedDraft) {
+        self.order.retain(|k| k != &key);
+        self.order.push_back(key.clone());
+        self.entries.insert(key, draft);
+        while self.entries.len() > self.capacity {
+            let Some(oldest) = self.order.pop_front() else {
+                break;
+            };
+            self.entries.remove(&oldest);
+        }
+    }
+}
+
+static DRAFTS: OnceLock<Mutex<DraftCache>> = OnceLock::new();
+
+fn drafts() -> &'static Mutex<DraftCache> {
+    DRAFTS.get_or_init(|| {
+        Mutex::new(DraftCache {
+            entries: HashMap::new(),
+            order: VecDeque::new(),
+            capacity: DEFAULT_MAX_CACHED_DRAFTS,
+        })
+    })
+}
+
+fn cache_key(repo_id: &str, rel_path: &str) -> String {
+    format!("{repo_id}\0{rel_path}")
+}
+
+/// Drop cached state for one draft, or for every draft of `repo_id` when
+/// `rel_path` is `None`. Returns the number of entries removed.
+pub fn forget(repo_id: &str, rel_path: Option<&str>) -> u32 {
+    let mut cache = drafts().lock().unwrap_or_else(|e| e.into_inner());
+    match rel_path {
+        Some(rel_path) => cache.take(&cache_key(repo_id, rel_path)).map_or(0, |_| 1),
+        None => {
+            let prefix = cache_key(repo_id, "");
+            let keys: Vec<String> = cache
+                .entries
+                .keys()
+                .filter(|k| k.starts_with(&prefix))
+                .cloned()
+                .collect();
+            for key in &keys {
+                cache.take(key);
+            }
+            keys.len() as u32
+        }
+    }
+}
+
+/// Re-parse a draft, reusing the previous tree and enrichment when one is
+/// cached for the same (repo, relPath, language).
+///
+/// Panics are caught and reported as a `parse_error`; the cached state for
+/// the draft is discarded in that case so the next call starts clean.
+pub fn parse_incremental(input: &NativeIncrementalParseInput) -> NativeIncrementalParseResult {
+    let key = cache_key(&input.repo_id, &input.rel_path);
+    let previous = drafts()
+        .lock()
+        .unwrap_or_else(|e| e.into_inner())
+        .take(&key);
+
+    match panic::catch_unwind(panic::AssertUnwindSafe(|| {
+        parse_with_previous(input, previous)
+    })) {
+        Ok((result, next)) => {
+            if let Some(next) = next {
+                drafts()
+                    .lock()
+                    .unwrap_or_else(|e| e.into_inner())
+                    .put(key, next);
+            }
+            result
+        }
+        Err(payload) => {
+            let msg = if let Some(s) = payload.downcast_ref::<&str>() {
+                format!("panic during parse: {s}")
+            } else if let Some(s) = payload.downcast_ref::<String>() {
+                format!("panic during parse: {s}")
+            } else {
+                "panic during parse: unknown payload".to_string()
+            };
+            failed(input, String::new(), msg)
+        }
+    }
+}
+
+fn failed(
+    input: &NativeIncrementalParseInput,
+    content_hash: String,
+    msg: String,
+) -> NativeIncrementalParseResult {
+    NativeIncrementalParseResult {
+        file: NativeParsedFile {
+            rel_path: input.rel_path.clone(),
+            content_hash,
+            content: None,
+            symbols: vec![],
+            imports: vec![],
+            calls: vec![],
+            parse_error: Some(msg),
+        },
+        reused_tree: false,
+        changed_start_line: 0,
+        changed_end_line: 0,
+        symbols_reused: 0,
+        symbols_enriched: 0,
+        symbols_extracted: 0,
+    }
+}
+
+fn parse_with_previous(
+    input: &NativeIncrementalParseInput,
+    previous: Option<CachedDraft>,
+) -> (NativeIncrementalParseResult, Option<CachedDraft>) {
+    let content = input.content.as_str();
+    let content_hash = content_hash::hash_content(content);
+
+    if lang::get_language(&input.language).is_none() {
+        let msg = format!("Unsupported language: {}", input.language);
+        return (failed(input, content_hash, msg), None);
+    }
+    if content.len() > MAX_PARSE_FILE_BYTES {
+        let msg = format!(
+            "File too large for native parser ({} bytes, limit {})",
+            content.len(),
+            MAX_PARSE_FILE_BYTES
+        );
+        return (failed(input, content_hash, msg), None);
+    }
+
+    let previous = previous.filter(|p| p.language == input.language);
+    let diff = previous
+        .as_ref()
+        .and_then(|p| diff_region(p.content.as_bytes(), content.as_bytes()));
+
+    // Unchanged buffer (e.g. a save right after the last change event):
+    // serve the previous result as-is.
+    if let Some(prev) = previous {
+        if diff.is_none() {
+            let symbol_count = prev.file.symbols.len() as u32;
+            let result = NativeIncrementalParseResult {
+                file: prev.file.clone(),
+                reused_tree: true,
+                changed_start_line: 0,
+                changed_end_line: 0,
+                symbols_reused: symbol_count,
+                symbols_enriched: 0,
+                symbols_extracted: 0,
+            };
+            return (result, Some(prev));
+        }
+        return parse_edited(input, content_hash, Some(prev), diff);
+    }
+    parse_edited(input, content_hash, None, None)
+}
+
+fn parse_edited(
+    input: &NativeIncrementalParseInput,
+    content_hash: String,
+    previous: Option<CachedDraft>,
+    diff: Option<ByteEdit>,
+) -> (NativeIncrementalParseResult, Option<CachedDraft>) {
+    let content = input.content.as_str();
+    let new_bytes = content.as_bytes();
+
+    let (old_tree, old_symbols, old_end_row) = match previous {
+        Some(prev) => {
+            let old_end_row = diff.map(|d| point_at(prev.content.as_bytes(), d.old_end).row);
+            let mut tree = prev.tree;
+            let edits = input
+                .edits
+                .as_deref()
+                .and_then(|edits| explicit_input_edits(&prev.content, content, edits))
+                .or_else(|| {
+                    diff.map(|d| vec![covering_input_edit(prev.content.as_bytes(), new_bytes, d)])
+                })
+                .unwrap_or_default();
+            for edit in &edits {
+                tree.edit(edit);
+            }
+            (Some(tree), prev.file.symbols, old_end_row)
+        }
+        None => (None, Vec::new(), None),
+    };
+
+    let parsed = lang::with_cached_parser(&input.language, |p| p.parse(content, old_tree.as_ref()))
+        .flatten();
+    let Some(tree) = parsed else {
+        let msg = "tree-sitter parse returned None".to_string();
+        return (failed(input, content_hash, msg), None);
+    };
+
+    // Changed lines in new-content coordinates. Enrichment reuse is keyed on
+    // the textual diff alone: a symbol whose source window is byte-identical
+    // produces identical enrichment regardless of how the tree shifted.
+    let text_rows = diff.map(|d| {
+        (
+            point_at(new_bytes, d.start).row,
+            point_at(new_bytes, d.new_end).row,
+        )
+    });
+    let changed: Vec<Range> = old_tree
+        .as_ref()
+        .map(|old| old.changed_ranges(&tree).collect())
+        .unwrap_or_default();
+    let mut reported_rows = text_rows;
+    for range in &changed {
+        let (start, end) = reported_rows.unwrap_or((range.start_point.row, range.end_point.row));
+        reported_rows = Some((
+            start.min(range.start_point.row),
+            end.max(range.end_point.row),
+        ));
+    }
+
+    let root = tree.root_node();
+    let row_delta = text_rows.map_or(0, |(_, new_end_row)| {
+        old_end_row.unwrap_or(new_end_row) as i64 - new_end_row as i64
+    });
+    let carried = match (diff, text_rows) {
+        (Some(edit), Some((_, new_end_row))) if extracts_per_declaration(&input.language) => {
+            extract_changed_symbols(
+                input,
+                root,
+                new_bytes,
+                &old_symbols,
+                &ChangedRegion {
+                    edit,
+                    new_end_row,
+                    row_delta,
+                    ranges: &changed,
+                },
+            )
+        }
+        _ => None,
+    };
+    let (mut symbols, symbols_extracted) = carried.unwrap_or_else(|| {
+        let symbols = extract::symbols::extract_symbols(
+            root,
+            new_bytes,
+            &input.repo_id,
+            &input.rel_path,
+            &input.language,
+        );
+        let count = symbols.len() as u32;
+        (symbols, count)
+    });
+
+    let reuse = text_rows.map(|(start_row, new_end_row)| EnrichmentReuse {
+        previous: old_symbols
+            .iter()
+            .map(|s| {
+                (
+                    (s.symbol_id.as_str(), s.range.start_line, s.range.start_col),
+                    s,
+                )
+            })
+            .collect(),
+        line_starts: line_starts(content),
+        start_row,
+        new_end_row,
+        row_delta,
+    });
+
+    let mut symbols_reused = 0u32;
+    let mut symbols_enriched = 0u32;
+    let mut analysis = None;
+    for symbol in &mut symbols {
+        if reuse.as_ref().is_some_and(|r| r.apply(symbol, content)) {
+            symbols_reused += 1;
+        } else {
+            let analysis =
+                analysis.get_or_insert_with(|| FileContext::new(content, &input.language));
+            enrich_symbol(symbol, analysis, &input.rel_path);
+            symbols_enriched += 1;
+        }
+    }
+
+    let imports = extract::imports::extract_imports(root, new_bytes, &input.language);
+    let calls = extract::calls::extract_calls(root, new_bytes, &symbols, &input.language);
+
+    let file = NativeParsedFile {
+        rel_path: input.rel_path.clone(),
+        content_hash,
+        content: None,
+        symbols,
+        imports,
+        calls,
+        parse_error: None,
+    };
+    let (changed_start_line, changed_end_line) = reported_rows
+        .map(|(start, end)| (start as u32 + 1, end as u32 + 1))
+        .unwrap_or((0, 0));
+
+    let result = NativeIncrementalParseResult {
+        file: file.clone(),
+        reused_tree: old_tree.is_some(),
+        changed_start_line,
+        changed_end_line,
+        symbols_reused,
+        symbols_enriched,
+        symbols_extracted,
+    };
+    let next = CachedDraft {
+        language: input.language.clone(),
+        content: input.content.clone(),
+        tree,
+        file,
+    };
+    (result, Some(next))
+}
+
+/// Whether a symbol extracted for `language` depends only on its own subtree
+/// and its ancestors. Go emits a package symbol spanning the whole file and
+/// PHP carries the current namespace across top-level siblings, so both
+/// always re-extract the whole tree.
+fn extracts_per_declaration(language: &str) -> bool {
+    !matches!(language, "go" | "php")
+}
+
+/// Where a re-parse differs from the previous one, in new-content
+/// coordinates.
+struct ChangedRegion<'a> {
+    edit: ByteEdit,
+    /// Row of `edit.new_end`.
+    new_end_row: usize,
+    /// Old row minus new row for lines after the edit.
+    row_delta: i64,
+    /// Ranges whose syntax changed, from `Tree::changed_ranges`.
+    ranges: &'a [Range],
+}
+
+/// Symbols of the new tree, extracting only the top-level declarations the
+/// change touches and carrying over the previous symbols of the others.
+/// Returns the symbols in full-extraction order and the number extracted,
+/// or `None` when a previous symbol cannot be placed, in which case the
+/// caller extracts the whole tree.
+fn extract_changed_symbols(
+    input: &NativeIncrementalParseInput,
+    root: Node<'_>,
+    source: &[u8],
+    previous: &[NativeParsedSymbol],
+    region: &ChangedRegion<'_>,
+) -> Option<(Vec<NativeParsedSymbol>, u32)> {
+    // Each declaration is either re-extracted or mapped to its span in the
+    // previous content. A declaration wholly before the edit kept its
+    // position; one starting on a row after the edit only moved by whole
+    // rows.
+    let mut cursor = root.walk();
+    let mut plan: Vec<(Node<'_>, Option<i64>)> = Vec::new();
+    for child in root.children(&mut cursor) {
+        let (start, end) = (child.start_byte(), child.end_byte());
+        let touched = region
+            .ranges
+            .iter()
+            .any(|r| r.start_byte <= end && start <= r.end_byte);
+        let shift = if touched {
+            None
+        } else if end < region.edit.start {
+            Some(0)
+        } else if start > region.edit.new_end && child.start_position().row > region.new_end_row {
+            Some(region.row_delta)
+        } else {
+            None
+        };
+        plan.push((child, shift));
+    }
+
+    // Previous spans of the carried declarations, in order; they are
+    // disjoint, so each previous symbol belongs to at most one.
+    let spans: Vec<(usize, NativeRange)> = plan
+        .iter()
+        .enumerate()
+        .filter_map(|(i, (child, shift))| {
+            shift.map(|delta| (i, shifted_range(extract_range(*child), delta)))
+        })
+        .collect();
+    let mut carried: Vec<Vec<NativeParsedSymbol>> = vec![Vec::new(); plan.len()];
+    for symbol in previous {
+        let start = (symbol.range.start_line, symbol.range.start_col);
+        let at = spans.partition_point(|(_, span)| (span.start_line, span.start_col) <= start);
+        let Some((index, span)) = at.checked_sub(1).map(|at| &spans[at]) else {
+            continue;
+        };
+        if start > (span.end_line, span.end_col) {
+            continue;
+        }
+        if (symbol.range.end_line, symbol.range.end_col) > (span.end_line, span.end_col) {
+            return None;
+        }
+        let delta = plan[*index].1.unwrap_or(0);
+        carried[*index].push(shift_symbol(symbol, delta)?);
+    }
+
+    let mut symbols = Vec::with_capacity(previous.len());
+    let mut extracted = 0u32;
+    for ((child, shift), carried) in plan.into_iter().zip(carried) {
+        if shift.is_some() {
+            symbols.extend(carried);
+            continue;
+        }
+        let fresh = extract::symbols::extract_symbols(
+            child,
+            source,
+            &input.repo_id,
+            &input.rel_path,
+            &input.language,
+        );
+        extracted += fresh.len() as u32;
+        symbols.extend(fresh);
+    }
+    Some((symbols, extracted))
+}
+
+/// `range` of a new-content node in previous-content rows.
+fn shifted_range(range: NativeRange, row_delta: i64) -> NativeRange {
+    let shift = |line: u32| (line as i64 + row_delta).max(0) as u32;
+    NativeRange {
+        start_line: shift(range.start_line),
+        end_line: shift(range.end_line),
+        ..range
+    }
+}
+
+/// A previous symbol moved back into new-content rows. `None` when its
+/// `node_id` is not the positional form this module knows how to move.
+fn shift_symbol(symbol: &NativeParsedSymbol, row_delta: i64) -> Option<NativeParsedSymbol> {
+    if row_delta == 0 {
+        return Some(symbol.clone());
+    }
+    let range = &symbol.range;
+    if symbol.node_id != make_node_id(&symbol.name, range) {
+        return None;
+    }
+    let mut moved = symbol.clone();
+    moved.range = shifted_range(range.clone(), -row_delta);
+    moved.node_id = make_node_id(&moved.name, &moved.range);
+    Some(moved)
+}
+
+/// Single byte-range replacement turning old content into new content.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+struct ByteEdit {
+    start: usize,
+    old_end: usize,
+    new_end: usize,
+}
+
+/// Smallest single edit (common prefix / common suffix) between two
+/// contents, or `None` when they are identical.
+fn diff_region(old: &[u8], new: &[u8]) -> Option<ByteEdit> {
+    if old == new {
+        return None;
+    }
+    let prefix = old.iter().zip(new).take_while(|(a, b)| a == b).count();
+    let suffix = old[prefix..]
+        .iter()
+        .rev()
+        .zip(new[prefix..].iter().rev())
+        .take_while(|(a, b)| a == b)
+        .count();
+    Some(ByteEdit {
+        start: prefix,
+        old_end: old.len() - suffix,
+        new_end: new.len() - suffix,
+    })
+}
+
+/// Row/column (byte) position of `byte` within `text`.
+fn point_at(text: &[u8], byte: usize) -> Point {
+    let byte = byte.min(text.len());
+    let head = &text[..byte];
+    let row = head.iter().filter(|&&b| b == b'\n').count();
+    let column = match head.iter().rposition(|&b| b == b'\n') {
+        Some(nl) => byte - nl - 1,
+        None => byte,
+    };
+    Point { row, column }
+}
+
+fn covering_input_edit(old: &[u8], new: &[u8], edit: ByteEdit) -> InputEdit {
+    InputEdit {
+        start_byte: edit.start,
+        old_end_byte: edit.old_end,
+        new_end_byte: edit.new_end,
+        start_position: point_at(new, edit.start),
+        old_end_position: point_at(old, edit.old_end),
+        new_end_position: point_at(new, edit.new_end),
+    }
+}
+
+/// Convert caller-supplied sequential edits into tree-sitter edits. Returns
+/// `None` when the edits are out of bounds or do not reproduce `new`.
+fn explicit_input_edits(old: &str, new: &str, edits: &[NativeTextEdit]) -> Option<Vec<InputEdit>> {
+    if edits.is_empty() || edits.len() > MAX_EXPLICIT_EDITS {
+        return None;
+    }
+    let mut working: Vec<u8> = old.as_bytes().to_vec();
+    let mut out = Vec::with_capacity(edits.len());
+    for edit in edits {
+        let start = edit.start_byte as usize;
+        let old_end = edit.old_end_byte as usize;
+        if start > old_end || old_end > working.len() {
+            return None;
+        }
+        let start_position = point_at(&working, start);
+        let old_end_position = point_at(&working, old_end);
+        working.splice(start..old_end, edit.text.bytes());
+        let new_end = start + edit.text.len();
+        out.push(InputEdit {
+            start_byte: start,
+            old_end_byte: old_end,
+            new_end_byte: new_end,
+            start_position,
+            old_end_position,
+            new_end_position: point_at(&working, new_end),
+        });
+    }
+    if working != new.as_bytes() {
+        return None;
+    }
+    Some(out)
+}
+
+/// Byte offset at which each line of `content` starts.
+fn line_starts(content: &str) -> Vec<usize> {
+    let mut starts = vec![0];
+    starts.extend(
+        content
+            .bytes()
+            .enumerate()
+            .filter(|(_, b)| *b == b'\n')
+            .map(|(i, _)| i + 1),
+    );
+    starts
+}
+
+fn line_text<'a>(content: &'a str, starts: &[usize], row: usize) -> &'a str {
+    let Some(&start) = starts.get(row) else {
+        return "";
+    };
+    let end = starts.get(row + 1).copied().unwrap_or(content.len());
+    content.get(start..end).unwrap_or("")
+}
+
+/// First row of the text that enrichment reads for a symbol starting at
+/// `start_row`: the doc-comment scans in `summary.rs` / `invariants.rs` walk
+/// backwards over blank and comment lines and stop at the first other line,
+/// so that stopping line is part of the window too.
+fn doc_window_start(content: &str, starts: &[usize], start_row: usize) -> usize {
+    let mut row = start_row;
+    let mut in_block = false;
+    while row > 0 {
+        let line = line_text(content, starts, row - 1).trim();
+        if in_block {
+            if line.contains("/*") {
+                in_block = false;
+            }
+            row -= 1;
+            continue;
+        }
+        let comment_like = line.is_empty()
+            || line.starts_with("//")
+            || line.starts_with('#')
+            || line.starts_with('*')
+            || line.starts_with("/*")
+            || line.contains("*/");
+        if comment_like {
+            if line.contains("*/") && !line.contains("/*") {
+                in_block = true;
+            }
+            row -= 1;
+            continue;
+        }
+        return row - 1;
+    }
+    0
+}
+
+/// Last row of the enrichment window for a symbol ending at `end_row`. The
+/// Python docstring scan can run past a one-line body over blank lines, so
+/// the window extends to the next non-blank line.
+fn doc_window_end(content: &str, starts: &[usize], end_row: usize) -> usize {
+    let last_row = starts.len().saturating_sub(1);
+    let mut row = end_row;
+    while row < last_row {
+        row += 1;
+        if !line_text(content, starts, row).trim().is_empty() {
+            break;
+        }
+    }
+    row
+}
+
+/// Carries enrichment across re-parses for symbols outside the edit.
+struct EnrichmentReuse<'a> {
+    /// Previous symbols keyed by (symbol_id, start_line, start_col) in old
+    /// coordinates.
+    previous: HashMap<(&'a str, u32, u32), &'a NativeParsedSymbol>,
+    line_starts: Vec<usize>,
+    /// Changed rows (0-indexed, new content), inclusive.
+    start_row: usize,
+    new_end_row: usize,
+    /// Old row minus new row for lines after the edit.
+    row_delta: i64,
+}
+
+impl EnrichmentReuse<'_> {
+    /// Copy enrichment from the matching previous symbol when the symbol's
+    /// source window is untouched. Returns false when it must be recomputed.
+    fn apply(&self, symbol: &mut NativeParsedSymbol, content: &str) -> bool {
+        let start_row = (symbol.range.start_line as usize).saturating_sub(1);
+        let end_row = (symbol.range.end_line as usize).saturating_sub(1);
+        let window_start = doc_window_start(content, &self.line_starts, start_row);
+        let window_end = doc_window_end(content, &self.line_starts, end_row);
+
+        let old_start_line = if window_end < self.start_row {
+            symbol.range.start_line as i64
+        } else if window_start > self.new_end_row {
+            symbol.range.start_line as i64 + self.row_delta
+        } else {
+            return false;
+        };
+        if old_start_line < 1 {
+            return false;
+        }
+
+        let key = (
+            symbol.symbol_id.as_str(),
+            old_start_line as u32,
+            symbol.range.start_col,
+        );
+        let Some(prev) = self.previous.get(&key) else {
+            return false;
+        };
+        if prev.kind != symbol.kind
+            || prev.exported != symbol.exported
+            || prev.visibility != symbol.visibility
+        {
+            return false;
+        }
+
+        symbol.summary = prev.summary.clone();
+        symbol.summary_quality = prev.summary_quality;
+        symbol.invariants = prev.invariants.clone();
+        symbol.side_effects = prev.side_effects.clone();
+        symbol.role_tags = prev.role_tags.clone();
+        symbol.search_text = prev.search_text.clone();
+        true
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::types::NativeFileInput;
+
+    fn input(rel_path: &str, content: &str) -> NativeIncrementalParseInput {
+        NativeIncrementalParseInput {
+            repo_id: "incremental-test".to_string(),
+            rel_path: rel_path.to_string(),
+            language: "ts".to_string(),
+            content: content.to_string(),
+            edits: None,
+        }
+    }
+
+    fn full_parse(rel_path: &str, content: &str) -> NativeParsedFile {
+        let file_path = std::env::temp_dir().join(format!(
+            "sdl_mcp_incremental_{}_{}.ts",
+            std::process::id(),
+            rel_path.replace('/', "_")
+        ));
+        std::fs::write(&file_path, content).expect("write temp file");
+        let parsed = super::super::parse_single_file(&NativeFileInput {
+            rel_path: rel_path.to_string(),
+            absolute_path: file_path.to_string_lossy().into_owned(),
+            repo_id: "incremental-test".to_string(),
+            language: "ts".to_string(),
+        });
+        let _ = std::fs::remove_file(file_path);
+        parsed
+    }
+
+    const BEFORE: &str = r#"/** Adds two numbers. */
+export function add(a: number, b: number): number {
+  return a + b;
+}
+
+/** Multiplies two numbers. */
+export function mul(a: number, b: number): number {
+  return a * b;
+}
+"#;
+
+    #[test]
+    fn diff_region_finds_common_prefix_and_suffix() {
+        assert_eq!(diff_region(b"abc", b"abc"), None);
+        assert_eq!(
+            diff_region(b"hello world", b"hello brave world"),
+            Some(ByteEdit {
+                start: 6,
+                old_end: 6,
+                new_end: 12
+            })
+        );
+        assert_eq!(
+            diff_region(b"aXXb", b"ab"),
+            Some(ByteEdit {
+                start: 1,
+                old_end: 3,
+                new_end: 1
+            })
+        );
+    }
+
+    #[test]
+    fn explicit_edits_must_reproduce_new_content() {
+        let edits = vec![NativeTextEdit {
+            start_byte: 1,
+            old_end_byte: 2,
+            text: "ZZ".to_string(),
+        }];
+        assert!(explicit_input_edits("abc", "aZZc", &edits).is_some());
+        assert!(explicit_input_edits("abc", "abc", &edits).is_none());
+    }
+
+    #[test]
+    fn incremental_reparse_matches_full_parse_and_reuses_untouched_symbols() {
+        let rel_path = "src/incremental-reuse.ts";
+        forget("incremental-test", Some(rel_path));
+
+        let first = parse_incremental(&input(rel_path, BEFORE));
+        assert!(!first.reused_tree);
+        assert_eq!(first.symbols_reused, 0);
+
+        // Edit only the body of `mul`.
+        let after = BEFORE.replace("return a * b;", "return b * a;");
+        let second = parse_incremental(&input(rel_path, &after));
+        assert!(second.reused_tree);
+        assert_eq!(second.file.parse_error, None);
+        assert!(second.symbols_reused >= 1, "add() should be carried over");
+        assert!(second.symbols_enriched >= 1, "mul() should be re-enriched");
+        assert!(
+            second.symbols_extracted < second.file.symbols.len() as u32,
+            "add() should not be re-extracted"
+        );
+
+        let expected = full_parse(rel_path, &after);
+        assert_eq!(second.file.symbols.len(), expected.symbols.len());
+        for (got, want) in second.file.symbols.iter().zip(&expected.symbols) {
+            assert_eq!(got.symbol_id, want.symbol_id);
+            assert_eq!(got.node_id, want.node_id);
+            assert_eq!(got.summary, want.summary);
+            assert_eq!(got.search_text, want.search_text);
+            assert_eq!(got.invariants, want.invariants);
+            assert_eq!(got.side_effects, want.side_effects);
+        }
+        assert_eq!(second.file.calls.len(), expected.calls.len());
+        forget("incremental-test", Some(rel_path));
+    }
+
+    #[test]
+    fn edits_above_a_symbol_shift_it_without_re_enrichment() {
+        let rel_path = "src/incremental-shift.ts";
+        forget("incremental-test", Some(rel_path));
+        parse_incremental(&input(rel_path, BEFORE));
+
+        let after = format!("import {{ x }} from \"./x\";\n\n{BEFORE}");
+        let second = parse_incremental(&input(rel_path, &after));
+        let expected = full_parse(rel_path, &after);
+        assert_eq!(second.symbols_extracted, 0);
+        assert_eq!(second.file.symbols.len(), expected.symbols.len());
+        for (got, want) in second.file.symbols.iter().zip(&expected.symbols) {
+            assert_eq!(got.range.start_line, want.range.start_line);
+            assert_eq!(got.range.end_line, want.range.end_line);
+            assert_eq!(got.node_id, want.node_id);
+            assert_eq!(got.summary, want.summary);
+        }
+        assert_eq!(second.file.imports.len(), 1);
+        forget("incremental-test", Some(rel_path));
+    }
+
+    #[test]
+    fn unchanged_content_is_served_from_cache() {
+        let rel_path = "src/incremental-same.ts";
+        forget("incremental-test", Some(rel_path));
+        let first = parse_incremental(&input(rel_path, BEFORE));
+        let second = parse_incremental(&input(rel_path, BEFORE));
+        assert!(second.reused_tree);
+        assert_eq!(second.symbols_enriched, 0);
+        assert_eq!(second.file.symbols.len(), first.file.symbols.len());
+        assert_eq!(forget("incremental-test", Some(rel_path)), 1);
+    }
+}
@@ -1,31 +1,41 @@
 pub mod content_hash;
+pub mod engine;
+pub mod file_hash;
 pub mod file_reader;
+pub mod incremental;
+pub mod packed;
+pub mod stream;
 
 use std::panic;
-
-use rayon::prelude::*;
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::mpsc;
+use std::sync::OnceLock;
 
 use crate::extract;
 use crate::lang;
-use crate::types::{NativeFileInput, NativeParsedFile};
+use crate::stats::{self, Phase};
+use crate::types::{NativeFileInput, NativeParsedFile, NativeParsedSymbol};
 
 /// Stack size per Rayon worker thread (64 MiB). Tree-sitter's C-based parser
 /// can recurse deeply on complex/generated files (e.g. LLVM's deeply-nested
 /// C++ templates); the default stack may not suffice and cause a hard crash
 /// (STATUS_STACK_BUFFER_OVERRUN on Windows). 64 MiB provides headroom for
 /// both tree-sitter C recursion and the Rust AST walkers.
-const RAYON_STACK_SIZE: usize = 64 * 1024 * 1024;
+pub(crate) const RAYON_STACK_SIZE: usize = 64 * 1024 * 1024;
 
 /// Maximum file size in bytes that the native parser will attempt to parse.
 /// Files larger than this are skipped with a parse error. This prevents
 /// pathological cases (e.g. 16 MB generated test files in LLVM) from
 /// consuming excessive memory or triggering stack overflows in tree-sitter.
-const MAX_PARSE_FILE_BYTES: usize = 1_500_000; // 1.5 MB
+pub(crate) const MAX_PARSE_FILE_BYTES: usize = 1_500_000; // 1.5 MB
 
 /// Parse and extract symbols/imports/calls from a batch of files in parallel.
 ///
-/// Uses Rayon's work-stealing thread pool. Each thread gets its own
-/// thread-local tree-sitter parser instance.
+/// Runs on the process-lifetime pool owned by [`engine`], so repeated batches
+/// reuse warm worker threads. Each worker keeps a thread-local tree-sitter
+/// parser per language (see [`lang::with_cached_parser`]). `thread_count`
+/// caps how many of the pool's workers this batch uses; it never resizes the
+/// pool.
 ///
 /// Individual file panics (e.g. tree-sitter C-level crashes) are caught via
 /// `catch_unwind` so they produce a per-file `parse_error` instead of
@@ -34,43 +44,110 @@ pub fn parse_files_parallel(
     files: &[NativeFileInput],
     thread_count: usize,
 ) -> Vec<NativeParsedFile> {
-    // Build a custom thread pool with large stacks. If both the custom pool
-    // and global pool fail to build (e.g. OOM under heavy load), we fall back
+    // If no pool can be built at all (e.g. OOM under heavy load), fall back
     // to single-threaded sequential parsing rather than panicking.
-    let pool = match rayon::ThreadPoolBuilder::new()
-        .num_threads(thread_count)
-        .stack_size(RAYON_STACK_SIZE)
-        .build()
-    {
-        Ok(pool) => pool,
-        Err(e1) => match rayon::ThreadPoolBuilder::new().build() {
-            Ok(pool) => {
-                eprintln!("sdl-mcp-native: custom Rayon pool failed ({e1}), using global pool");
-                pool
-            }
-            Err(e2) => {
-                eprintln!(
-                    "sdl-mcp-native: all Rayon pools failed ({e1}, {e2}), parsing sequentially"
-                );
-                // Sequential fallback — no parallelism but no crash
-                return files.iter().map(|f| parse_single_file_safe(f)).collect();
-            }
-        },
+    let results = match engine::pool() {
+        Some(pool) => {
+            let slots: Vec<OnceLock<NativeParsedFile>> =
+                files.iter().map(|_| OnceLock::new()).collect();
+            engine::for_each_limited(&pool, files.len(), thread_count, (), |_, i| {
+                let _ = slots[i].set(parse_single_file_safe(&files[i]));
+                true
+            });
+            slots
+                .into_iter()
+                .map(|slot| slot.into_inner().expect("every file is parsed"))
+                .collect()
+        }
+        None => files.iter().map(|f| parse_single_file_safe(f)).collect(),
     };
+    engine::record_batch(files.len());
+    results
+}
 
-    pool.install(|| {
-        files
-            .par_iter()
-            .map(|file| parse_single_file_safe(file))
-            .collect()
-    })
+/// Streaming variant of [`parse_files_parallel`]: hands completed files to
+/// `emit` in chunks of up to `chunk_size` as soon as they finish, in
+/// completion order, instead of collecting the whole batch first.
+///
+/// `emit` runs on the calling thread and returns whether to keep going.
+/// Workers feed it through a bounded channel, so a slow consumer stalls
+/// parsing instead of buffering the whole batch; returning `false` stops
+/// workers from starting further files. Returns the number of files emitted.
+pub fn parse_files_streaming<F>(
+    files: &[NativeFileInput],
+    thread_count: usize,
+    chunk_size: usize,
+    mut emit: F,
+) -> usize
+where
+    F: FnMut(Vec<NativeParsedFile>) -> bool,
+{
+    let chunk_size = chunk_size.max(1);
+    let mut emitted = 0usize;
+    match engine::pool() {
+        Some(pool) => {
+            let stop = AtomicBool::new(false);
+            let (tx, rx) = mpsc::sync_channel::<NativeParsedFile>(chunk_size.saturating_mul(2));
+            std::thread::scope(|scope| {
+                let stop = &stop;
+                let pool = &pool;
+                scope.spawn(move || {
+                    engine::for_each_limited(pool, files.len(), thread_count, tx, |tx, i| {
+                        if stop.load(Ordering::Relaxed) {
+                            return false;
+                        }
+                        if tx.send(parse_single_file_safe(&files[i])).is_err() {
+                            stop.store(true, Ordering::Relaxed);
+                            return false;
+                        }
+                        true
+                    });
+                });
+
+                let mut pending = Vec::with_capacity(chunk_size);
+                for parsed in rx.iter() {
+                    pending.push(parsed);
+                    if pending.len() < chunk_size {
+                        continue;
+                    }
+                    emitted += pending.len();
+                    let chunk = std::mem::replace(&mut pending, Vec::with_capacity(chunk_size));
+                    if !emit(chunk) {
+                        stop.store(true, Ordering::Relaxed);
+                        break;
+                    }
+                }
+                if !pending.is_empty() && !stop.load(Ordering::Relaxed) {
+                    emitted += pending.len();
+                    emit(pending);
+                }
+                // Dropping the receiver unblocks any worker still sending.
+                drop(rx);
+            });
+        }
+        None => {
+            for chunk in files.chunks(chunk_size) {
+                let parsed: Vec<NativeParsedFile> =
+                    chunk.iter().map(parse_single_file_safe).collect();
+                emitted += parsed.len();
+                if !emit(parsed) {
+                    break;
+                }
+            }
+        }
+    }
+    engine::record_batch(emitted);
+    emitted
 }
 
 /// Wrapper around `parse_single_file` that catches panics from tree-sitter's
 /// C code (or any other unexpected panic) and converts them to a parse error.
 fn parse_single_file_safe(input: &NativeFileInput) -> NativeParsedFile {
     let rel_path = input.rel_path.clone();
-    match panic::catch_unwind(panic::AssertUnwindSafe(|| parse_single_file(input))) {
+    let started = stats::start();
+    let outcome = panic::catch_unwind(panic::AssertUnwindSafe(|| parse_single_file(input)));
+    stats::record(Phase::ParseFile, started);
+    match outcome {
         Ok(result) => result,
         Err(payload) => {
             let msg = if let Some(s) = payload.downcast_ref::<&str>() {
@@ -95,8 +172,12 @@ fn parse_single_file_safe(input: &NativeFileInput) -> NativeParsedFile {
 
 /// Parse a single file: read content, compute hash, parse AST, extract all.
 fn parse_single_file(input: &NativeFileInput) -> NativeParsedFile {
-    let content = match file_reader::read_file(&input.absolute_path) {
-        Ok(c) => c,
+    let started = stats::start();
+    let read = file_reader::read_bytes(&input.absolute_path);
+    stats::record(Phase::ReadFile, started);
+    let content = match read {
+        Ok(file_reader::FileBytes::Read(bytes)) => file_reader::decode_utf8(bytes),
+        Ok(file_reader::FileBytes::Mapped(map)) => return oversized_file(input, &map),
         Err(e) => {
             return NativeParsedFile {
                 rel_path: input.rel_path.clone(),
@@ -142,8 +223,10 @@ fn parse_single_file(input: &NativeFileInput) -> NativeParsedFile {
         };
     }
 
-    let mut parser = lang::create_parser(&input.language);
-    let tree = match parser.as_mut().and_then(|p| p.parse(&content, None)) {
+    let started = stats::start();
+    let parsed = lang::with_cached_parser(&input.language, |p| p.parse(&content, None)).flatten();
+    stats::record(Phase::TreeSitter, started);
+    let tree = match parsed {
         Some(t) => t,
         None => {
             return NativeParsedFile {
@@ -161,6 +244,7 @@ fn parse_single_file(input: &NativeFileInput) -> NativeParsedFile {
     let root = tree.root_node();
 
     // Extract symbols
+    let started = stats::start();
     let mut symbols = extract::symbols::extract_symbols(
         root,
         content.as_bytes(),
@@ -168,44 +252,22 @@ fn parse_single_file(input: &NativeFileInput) -> NativeParsedFile {
         &input.rel_path,
         &input.language,
     );
+    stats::record(Phase::ExtractSymbols, started);
 
+    let started = stats::start();
+    let analysis = extract::file_context::FileContext::new(&content, &input.language);
     for symbol in &mut symbols {
-        symbol.summary = extract::summary::generate_summary(symbol, &content, &input.language);
-
-        // Compute summary quality score
-        symbol.summary_quality = if !symbol.summary.is_empty() {
-            // Check if summary came from a doc comment by re-extracting
-            // (doc comment summaries tend to be longer and don't match auto-gen patterns)
-            let has_doc_comment =
-                extract::summary::has_doc_comment(symbol, &content, &input.language);
-            if has_doc_comment {
-                Some(1.0)
-            } else if matches!(symbol.kind.as_str(), "function" | "method" | "constructor") {
-                Some(0.4)
-            } else {
-                Some(0.3)
-            }
-        } else {
-            Some(0.0)
-        };
-
-        let invariants = extract::invariants::extract_invariants(symbol, &content);
-        symbol.invariants = invariants;
-
-        let side_effects = extract::side_effects::extract_side_effects(symbol, &content);
-        symbol.side_effects = side_effects;
-
-        let role_tags = extract::roles::extract_role_tags(symbol, &input.rel_path);
-        symbol.role_tags = role_tags.clone();
-        symbol.search_text =
-            extract::search_text::build_search_text(symbol, &input.rel_path, &role_tags);
+        enrich_symbol(symbol, &analysis, &input.rel_path);
     }
+    stats::record(Phase::Enrich, started);
 
+    let started = stats::start();
     // Extract imports
     let imports = extract::imports::extract_imports(root, content.as_bytes(), &input.language);
 
     // Extract calls
     let calls = extract::calls::extract_calls(root, content.as_bytes(), &symbols, &input.language);
+    stats::record(Phase::ExtractRefs, started);
 
     NativeParsedFile {
         rel_path: input.rel_path.clone(),
@@ -218,6 +280,64 @@ fn parse_single_file(input: &NativeFileInput) -> NativeParsedFile {
     }
 }
 
+/// Result for a file over [`MAX_PARSE_FILE_BYTES`]: hashed straight from its
+/// mapping, never decoded into an owned `String` or parsed.
+fn oversized_file(input: &NativeFileInput, bytes: &[u8]) -> NativeParsedFile {
+    let content_hash = content_hash::hash_content(&file_reader::decode_utf8_borrowed(bytes));
+    let parse_error = if lang::get_language(&input.language).is_none() {
+        format!("Unsupported language: {}", input.language)
+    } else {
+        format!(
+            "File too large for native parser ({} bytes, limit {})",
+            bytes.len(),
+            MAX_PARSE_FILE_BYTES
+        )
+    };
+    NativeParsedFile {
+        rel_path: input.rel_path.clone(),
+        content_hash,
+        content: None,
+        symbols: vec![],
+        imports: vec![],
+        calls: vec![],
+        parse_error: Some(parse_error),
+    }
+}
+
+/// Fill the enrichment fields (summary, quality, invariants, side effects,
+/// role tags, search text) of a freshly extracted symbol. `analysis` is
+/// built once per file and shared by every symbol in it.
+pub(crate) fn enrich_symbol(
+    symbol: &mut NativeParsedSymbol,
+    analysis: &extract::file_context::FileContext,
+    rel_path: &str,
+) {
+    symbol.summary = extract::summary::generate_summary(symbol, analysis);
+
+    // Compute summary quality score
+    symbol.summary_quality = if !symbol.summary.is_empty() {
+        // Check if summary came from a doc comment by re-extracting
+        // (doc comment summaries tend to be longer and don't match auto-gen patterns)
+        let has_doc_comment = extract::summary::has_doc_comment(symbol, analysis);
+        if has_doc_comment {
+            Some(1.0)
+        } else if matches!(symbol.kind.as_str(), "function" | "method" | "constructor") {
+            Some(0.4)
+        } else {
+            Some(0.3)
+        }
+    } else {
+        Some(0.0)
+    };
+
+    symbol.invariants = extract::invariants::extract_invariants(symbol, analysis);
+    symbol.side_effects = extract::side_effects::extract_side_effects(symbol, analysis);
+
+    let role_tags = extract::roles::extract_role_tags(symbol, rel_path);
+    symbol.role_tags = role_tags.clone();
+    symbol.search_text = extract::search_text::build_search_text(symbol, rel_path, &role_tags);
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -253,6 +373,7 @@ func add(a int, b int) int { return a + b }
         let _ = fs::remove_file(file_path);
 
         assert_eq!(parsed.parse_error.as_deref(), None);
+        assert_eq!(parsed.content_hash, content_hash::hash_content(source));
         assert!(
             parsed.symbols.iter().any(|symbol| symbol.name == "main"),
             "expected Go parser to emit main symbol, got {:?}",
@@ -291,4 +412,55 @@ func add(a int, b int) int { return a + b }
             Some("Unsupported language: unsupported-language")
         );
     }
+
+    #[test]
+    fn streaming_parse_emits_every_file_in_bounded_chunks() {
+        let unique = SystemTime::now()
+            .duration_since(UNIX_EPOCH)
+            .expect("system clock before UNIX_EPOCH")
+            .as_nanos();
+        let mut inputs = Vec::new();
+        let mut paths = Vec::new();
+        for i in 0..7 {
+            let file_path = std::env::temp_dir().join(format!("sdl_mcp_stream_{unique}_{i}.go"));
+            fs::write(
+                &file_path,
+                format!("package main\n\nfunc f{i}() int {{ return {i} }}\n"),
+            )
+            .expect("failed to write temporary Go file");
+            inputs.push(NativeFileInput {
+                rel_path: format!("tmp/stream_{i}.go"),
+                absolute_path: file_path.to_string_lossy().into_owned(),
+                repo_id: "test-repo".to_string(),
+                language: "go".to_string(),
+            });
+            paths.push(file_path);
+        }
+
+        let mut chunks: Vec<Vec<NativeParsedFile>> = Vec::new();
+        let emitted = parse_files_streaming(&inputs, 2, 3, |chunk| {
+            chunks.push(chunk);
+            true
+        });
+        for path in paths {
+            let _ = fs::remove_file(path);
+        }
+
+        assert_eq!(emitted, inputs.len());
+        assert!(chunks
+            .iter()
+            .all(|chunk| !chunk.is_empty() && chunk.len() <= 3));
+        let mut rel_paths: Vec<String> = chunks
+            .into_iter()
+            .flatten()
+            .map(|parsed| {
+                assert_eq!(parsed.parse_error.as_deref(), None);
+                parsed.rel_path
+            })
+            .collect();
+        rel_paths.sort();
+        let mut expected: Vec<String> = inputs.iter().map(|i| i.rel_path.clone()).collect();
+        expected.sort();
+        assert_eq!(rel_paths, expected);
+    }
 }
@@ -0,0 +1,340 @@
+//! Columnar symbol encoding for the packed parse exports.
+//!
+//! Converting `NativeParsedSymbol` → `NativeRange` → `NativeSymbolSignature`
+//! into JS objects costs one napi property call per field. The packed mode
+//! instead moves every symbol of a batch into a single byte buffer that
+//! `rustIndexer.ts` decodes with plain typed reads. Files keep their imports
+//! and calls as objects; their `symbols` are left empty and each file's
+//! symbols occupy the next `symbol_counts[i]` rows of the buffer.
+//!
+//! Layout (all integers little-endian):
+//!
+//! ```text
+//! header   u32 × 6   magic, version, symbol_count, dict_count,
+//!                    string_fields, string_bytes
+//! dict     (u32 offset, u32 len) × dict_count    kind/visibility strings
+//! kind     u16 × symbol_count                    dict index
+//! vis      u16 × symbol_count                    dict index
+//! exported u8  × symbol_count
+//! padding  to a 4-byte boundary
+//! range    (u32 × 4) × symbol_count              startLine, startCol,
+//!                                                endLine, endCol
+//! strings  (u32 offset, u32 len) × string_fields × symbol_count
+//! bytes    UTF-8 string data; offsets are relative to its start
+//! ```
+//!
+//! String fields, in order: nodeId, symbolId, astFingerprint, name, summary,
+//! searchText, then JSON for signature, invariants, sideEffects, roleTags and
+//! decorators. A zero-length JSON field means "absent / empty array".
+//!
+//! `summary_quality` is not packed: the object path does not forward it
+//! either, because the TypeScript row builder scores summaries itself.
+
+use std::collections::HashMap;
+
+use crate::types::{NativeParsedFile, NativeParsedSymbol, NativeSymbolSignature};
+
+/// "SDLS" read as a little-endian u32.
+pub const PACKED_SYMBOLS_MAGIC: u32 = u32::from_le_bytes(*b"SDLS");
+pub const PACKED_SYMBOLS_VERSION: u32 = 1;
+pub const PACKED_STRING_FIELDS: usize = 11;
+
+/// Packed batch before conversion to napi values (kept `Send` so it can be
+/// produced on a libuv worker thread).
+pub struct PackedBatch {
+    pub files: Vec<NativeParsedFile>,
+    pub symbol_counts: Vec<u32>,
+    pub bytes: Vec<u8>,
+}
+
+#[derive(Default)]
+struct StringData {
+    bytes: Vec<u8>,
+}
+
+impl StringData {
+    fn push(&mut self, s: &str) -> (u32, u32) {
+        if s.is_empty() {
+            return (0, 0);
+        }
+        let offset = self.bytes.len() as u32;
+        self.bytes.extend_from_slice(s.as_bytes());
+        (offset, s.len() as u32)
+    }
+}
+
+/// Small interned dictionary for the low-cardinality kind/visibility columns.
+#[derive(Default)]
+struct Dict {
+    index: HashMap<String, u16>,
+    refs: Vec<(u32, u32)>,
+}
+
+impl Dict {
+    fn code(&mut self, value: &str, strings: &mut StringData) -> u16 {
+        if let Some(&code) = self.index.get(value) {
+            return code;
+        }
+        let code = self.refs.len() as u16;
+        self.refs.push(strings.push(value));
+        self.index.insert(value.to_string(), code);
+        code
+    }
+}
+
+fn json_string_array(values: &[String]) -> String {
+    if values.is_empty() {
+        String::new()
+    } else {
+        serde_json::to_string(values).unwrap_or_default()
+    }
+}
+
+/// Serialise a signature in the shape `mapNativeSymbol` produces: `params`
+/// is always present, `type`/`returns`/`generics` only when set.
+fn signature_json(signature: Option<&NativeSymbolSignature>) -> String {
+    let Some(sig) = signature else {
+        return String::new();
+    };
+    let params: Vec<serde_json::Value> = sig
+        .params
+        .as_deref()
+        .unwrap_or_default()
+        .iter()
+        .map(|p| {
+            let mut obj = serde_json::Map::new();
+            obj.insert("name".into(), serde_json::Value::String(p.name.clone()));
+            if let Some(type_name) = &p.type_name {
+                obj.insert("type".into(), serde_json::Value::String(type_name.clone()));
+            }
+            serde_json::Value::Object(obj)
+        })
+        .collect();
+    let mut obj = serde_json::Map::new();
+    obj.insert("params".into(), serde_json::Value::Array(params));
+    if let Some(returns) = &sig.returns {
+        obj.insert("returns".into(), serde_json::Value::String(returns.clone()));
+    }
+    if let Some(generics) = &sig.generics {
+        obj.insert(
+            "generics".into(),
+            serde_json::Value::Array(
+                generics
+                    .iter()
+                    .map(|g| serde_json::Value::String(g.clone()))
+                    .collect(),
+            ),
+        );
+    }
+    serde_json::Value::Object(obj).to_string()
+}
+
+fn push_u32(out: &mut Vec<u8>, value: u32) {
+    out.extend_from_slice(&value.to_le_bytes());
+}
+
+/// Column buffers accumulated while walking a batch.
+#[derive(Default)]
+struct Columns {
+    strings: StringData,
+    dict: Dict,
+    kinds: Vec<u16>,
+    visibility: Vec<u16>,
+    exported: Vec<u8>,
+    ranges: Vec<u32>,
+    refs: Vec<(u32, u32)>,
+}
+
+impl Columns {
+    fn with_capacity(symbol_count: usize) -> Self {
+        Self {
+            kinds: Vec::with_capacity(symbol_count),
+            visibility: Vec::with_capacity(symbol_count),
+            exported: Vec::with_capacity(symbol_count),
+            ranges: Vec::with_capacity(symbol_count * 4),
+            refs: Vec::with_capacity(symbol_count * PACKED_STRING_FIELDS),
+            ..Self::default()
+        }
+    }
+
+    fn push(&mut self, sym: &NativeParsedSymbol) {
+        let strings = &mut self.strings;
+        self.kinds.push(self.dict.code(&sym.kind, strings));
+        self.visibility
+            .push(self.dict.code(&sym.visibility, strings));
+        self.exported.push(u8::from(sym.exported));
+        self.ranges.extend_from_slice(&[
+            sym.range.start_line,
+            sym.range.start_col,
+            sym.range.end_line,
+            sym.range.end_col,
+        ]);
+        self.refs.extend_from_slice(&[
+            strings.push(&sym.node_id),
+            strings.push(&sym.symbol_id),
+            strings.push(&sym.ast_fingerprint),
+            strings.push(&sym.name),
+            strings.push(&sym.summary),
+            strings.push(&sym.search_text),
+            strings.push(&signature_json(sym.signature.as_ref())),
+            strings.push(&json_string_array(&sym.invariants)),
+            strings.push(&json_string_array(&sym.side_effects)),
+            strings.push(&json_string_array(&sym.role_tags)),
+            strings.push(&json_string_array(&sym.decorators)),
+        ]);
+    }
+
+    fn encode(self) -> Vec<u8> {
+        let symbol_count = self.kinds.len();
+        let mut bytes = Vec::with_capacity(
+            24 + self.dict.refs.len() * 8
+                + symbol_count * (5 + 16 + PACKED_STRING_FIELDS * 8)
+                + 3
+                + self.strings.bytes.len(),
+        );
+        push_u32(&mut bytes, PACKED_SYMBOLS_MAGIC);
+        push_u32(&mut bytes, PACKED_SYMBOLS_VERSION);
+        push_u32(&mut bytes, symbol_count as u32);
+        push_u32(&mut bytes, self.dict.refs.len() as u32);
+        push_u32(&mut bytes, PACKED_STRING_FIELDS as u32);
+        push_u32(&mut bytes, self.strings.bytes.len() as u32);
+        for &(offset, len) in &self.dict.refs {
+            push_u32(&mut bytes, offset);
+            push_u32(&mut bytes, len);
+        }
+        for code in self.kinds.iter().chain(&self.visibility) {
+            bytes.extend_from_slice(&code.to_le_bytes());
+        }
+        bytes.extend_from_slice(&self.exported);
+        while bytes.len() % 4 != 0 {
+            bytes.push(0);
+        }
+        for &value in &self.ranges {
+            push_u32(&mut bytes, value);
+        }
+        for &(offset, len) in &self.refs {
+            push_u32(&mut bytes, offset);
+            push_u32(&mut bytes, len);
+        }
+        bytes.extend_from_slice(&self.strings.bytes);
+        bytes
+    }
+}
+
+/// Move every file's symbols into one columnar buffer.
+pub fn pack_files(mut files: Vec<NativeParsedFile>) -> PackedBatch {
+    let symbol_count: usize = files.iter().map(|f| f.symbols.len()).sum();
+    let mut columns = Columns::with_capacity(symbol_count);
+    let mut symbol_counts = Vec::with_capacity(files.len());
+
+    for file in &mut files {
+        symbol_counts.push(file.symbols.len() as u32);
+        for sym in file.symbols.drain(..) {
+            columns.push(&sym);
+        }
+    }
+
+    PackedBatch {
+        files,
+        symbol_counts,
+        bytes: columns.encode(),
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::types::{NativeRange, NativeSymbolSignatureParam};
+
+    fn symbol(name: &str, kind: &str) -> NativeParsedSymbol {
+        NativeParsedSymbol {
+            node_id: format!("{name}:1:0"),
+            symbol_id: format!("id-{name}"),
+            ast_fingerprint: "fp".into(),
+            kind: kind.into(),
+            name: name.into(),
+            exported: true,
+            visibility: String::new(),
+            range: NativeRange {
+                start_line: 1,
+                start_col: 0,
+                end_line: 3,
+                end_col: 1,
+            },
+            signature: Some(NativeSymbolSignature {
+                params: Some(vec![NativeSymbolSignatureParam {
+                    name: "a".into(),
+                    type_name: None,
+                }]),
+                returns: Some("number".into()),
+                generics: None,
+            }),
+            summary: "Adds \"numbers\"".into(),
+            invariants: vec![],
+            side_effects: vec!["io".into()],
+            role_tags: vec![],
+            decorators: vec![],
+            search_text: "add numbers".into(),
+            summary_quality: Some(0.4),
+        }
+    }
+
+    fn file(rel_path: &str, symbols: Vec<NativeParsedSymbol>) -> NativeParsedFile {
+        NativeParsedFile {
+            rel_path: rel_path.into(),
+            content_hash: String::new(),
+            content: None,
+            symbols,
+            imports: vec![],
+            calls: vec![],
+            parse_error: None,
+        }
+    }
+
+    fn u32_at(bytes: &[u8], at: usize) -> u32 {
+        u32::from_le_bytes(bytes[at..at + 4].try_into().unwrap())
+    }
+
+    #[test]
+    fn packs_symbols_into_columns_and_empties_files() {
+        let batch = pack_files(vec![
+            file(
+                "a.ts",
+                vec![symbol("add", "function"), symbol("Calc", "class")],
+            ),
+            file("b.ts", vec![]),
+            file("c.ts", vec![symbol("sub", "function")]),
+        ]);
+
+        assert_eq!(batch.symbol_counts, vec![2, 0, 1]);
+        assert!(batch.files.iter().all(|f| f.symbols.is_empty()));
+
+        let bytes = &batch.bytes;
+        assert_eq!(u32_at(bytes, 0), PACKED_SYMBOLS_MAGIC);
+        assert_eq!(u32_at(bytes, 4), PACKED_SYMBOLS_VERSION);
+        assert_eq!(u32_at(bytes, 8), 3);
+        // "function", "" (visibility), "class"
+        assert_eq!(u32_at(bytes, 12), 3);
+        assert_eq!(u32_at(bytes, 16), PACKED_STRING_FIELDS as u32);
+
+        let string_bytes = u32_at(bytes, 20) as usize;
+        let strings = &bytes[bytes.len() - string_bytes..];
+        let refs_start = bytes.len() - string_bytes - 3 * PACKED_STRING_FIELDS * 8;
+        let field = |sym: usize, f: usize| {
+            let at = refs_start + (sym * PACKED_STRING_FIELDS + f) * 8;
+            let (off, len) = (u32_at(bytes, at) as usize, u32_at(bytes, at + 4) as usize);
+            std::str::from_utf8(&strings[off..off + len])
+                .unwrap()
+                .to_string()
+        };
+        assert_eq!(field(0, 3), "add");
+        assert_eq!(field(2, 3), "sub");
+        assert_eq!(field(0, 4), "Adds \"numbers\"");
+        assert_eq!(
+            field(0, 6),
+            r#"{"params":[{"name":"a"}],"returns":"number"}"#
+        );
+        assert_eq!(field(0, 7), "");
+        assert_eq!(field(0, 8), r#"["io"]"#);
+    }
+}
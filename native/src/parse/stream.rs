@@ -0,0 +1,176 @@
+//! Pull-based parse stream.
+//!
+//! [`ParseStreamState::start`] parses a batch on the shared engine pool from a
+//! background driver thread and queues completed chunks in a bounded channel.
+//! JS pulls chunks one at a time (`ParseStreamHandle.nextChunk()`), so the
+//! indexer can persist early files while later ones are still parsing, and a
+//! slow consumer applies backpressure instead of letting converted results
+//! pile up on the JS heap.
+
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::mpsc::{self, Receiver};
+use std::sync::{Arc, Mutex, TryLockError};
+
+use crate::types::{NativeFileInput, NativeParsedFile};
+
+/// Completed chunks buffered ahead of the consumer before workers block.
+pub const DEFAULT_QUEUE_CHUNKS: usize = 2;
+
+pub struct ParseStreamState {
+    total_files: usize,
+    /// Taken (dropped) on cancel, so a driver blocked in `send` on a full
+    /// queue fails instead of holding engine pool workers forever.
+    rx: Mutex<Option<Receiver<Vec<NativeParsedFile>>>>,
+    /// Checked by the driver before each send. Kept outside `rx`'s lock so
+    /// `cancel` never blocks behind a pending `next_chunk`.
+    cancelled: Arc<AtomicBool>,
+}
+
+impl ParseStreamState {
+    pub fn start(
+        files: Vec<NativeFileInput>,
+        thread_count: usize,
+        chunk_size: usize,
+        queue_chunks: usize,
+    ) -> std::io::Result<Self> {
+        let total_files = files.len();
+        let (tx, rx) = mpsc::sync_channel::<Vec<NativeParsedFile>>(queue_chunks.max(1));
+        let cancelled = Arc::new(AtomicBool::new(false));
+        let driver_cancelled = Arc::clone(&cancelled);
+        std::thread::Builder::new()
+            .name("sdl-parse-stream".into())
+            .spawn(move || {
+                super::parse_files_streaming(&files, thread_count, chunk_size, |chunk| {
+                    !driver_cancelled.load(Ordering::Relaxed) && tx.send(chunk).is_ok()
+                });
+            })?;
+        Ok(Self {
+            total_files,
+            rx: Mutex::new(Some(rx)),
+            cancelled,
+        })
+    }
+
+    pub fn total_files(&self) -> usize {
+        self.total_files
+    }
+
+    /// Block until the next chunk is ready. Returns `None` once every file
+    /// has been delivered or the stream was cancelled.
+    pub fn next_chunk(&self) -> Option<Vec<NativeParsedFile>> {
+        if self.cancelled.load(Ordering::Relaxed) {
+            return None;
+        }
+        let mut rx = self.rx.lock().unwrap_or_else(|e| e.into_inner());
+        let chunk = rx.as_ref()?.recv().ok();
+        if chunk.is_none() || self.cancelled.load(Ordering::Relaxed) {
+            // A cancel that arrived while we held the lock could not drop the
+            // receiver itself; do it here.
+            *rx = None;
+            return None;
+        }
+        chunk
+    }
+
+    /// Stop parsing files that have not started yet. Chunks already queued are
+    /// discarded; a pending [`Self::next_chunk`] resolves to `None`.
+    ///
+    /// Dropping the receiver makes a driver blocked on a full queue fail its
+    /// `send` and stop, which in turn releases the pool workers feeding it.
+    /// When a `next_chunk` holds the lock it is waiting in `recv`, so the
+    /// queue is empty and the driver is not blocked; that call drops the
+    /// receiver once it wakes.
+    pub fn cancel(&self) {
+        self.cancelled.store(true, Ordering::Relaxed);
+        match self.rx.try_lock() {
+            Ok(mut rx) => *rx = None,
+            Err(TryLockError::Poisoned(e)) => *e.into_inner() = None,
+            Err(TryLockError::WouldBlock) => {}
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::time::Duration;
+
+    #[test]
+    fn stream_delivers_every_file_then_ends() {
+        let inputs: Vec<NativeFileInput> = (0..5)
+            .map(|i| NativeFileInput {
+                rel_path: format!("missing/{i}.go"),
+                absolute_path: format!("/nonexistent/sdl_mcp_stream/{i}.go"),
+                repo_id: "test-repo".to_string(),
+                language: "go".to_string(),
+            })
+            .collect();
+
+        let stream = ParseStreamState::start(inputs, 2, 2, 1).expect("driver thread");
+        assert_eq!(stream.total_files(), 5);
+
+        let mut delivered = 0;
+        while let Some(chunk) = stream.next_chunk() {
+            assert!(!chunk.is_empty() && chunk.len() <= 2);
+            // Unreadable files still produce a per-file parse error.
+            assert!(chunk.iter().all(|f| f.parse_error.is_some()));
+            delivered += chunk.len();
+        }
+        assert_eq!(delivered, 5);
+        assert!(stream.next_chunk().is_none());
+    }
+
+    #[test]
+    fn cancelled_stream_ends_immediately() {
+        let inputs: Vec<NativeFileInput> = (0..4)
+            .map(|i| NativeFileInput {
+                rel_path: format!("missing/{i}.go"),
+                absolute_path: format!("/nonexistent/sdl_mcp_stream/{i}.go"),
+                repo_id: "test-repo".to_string(),
+                language: "go".to_string(),
+            })
+            .collect();
+
+        let stream = ParseStreamState::start(inputs, 1, 1, 1).expect("driver thread");
+        stream.cancel();
+        assert!(stream.next_chunk().is_none());
+    }
+
+    #[test]
+    fn cancelling_a_full_queue_releases_the_engine_pool() {
+        let inputs: Vec<NativeFileInput> = (0..256)
+            .map(|i| NativeFileInput {
+                rel_path: format!("missing/{i}.go"),
+                absolute_path: format!("/nonexistent/sdl_mcp_stream_full/{i}.go"),
+                repo_id: "test-repo".to_string(),
+                language: "go".to_string(),
+            })
+            .collect();
+
+        let stream = ParseStreamState::start(inputs, 2, 1, 1).expect("driver thread");
+        assert!(stream.next_chunk().is_some());
+        // Let the driver fill the one-chunk queue and block in `send`, and
+        // the workers fill the inner channel behind it.
+        std::thread::sleep(Duration::from_millis(100));
+        stream.cancel();
+        assert!(stream.next_chunk().is_none());
+
+        let (done_tx, done_rx) = mpsc::channel();
+        std::thread::spawn(move || {
+            let files: Vec<NativeFileInput> = (0..4)
+                .map(|i| NativeFileInput {
+                    rel_path: format!("after/{i}.go"),
+                    absolute_path: format!("/nonexistent/sdl_mcp_stream_after/{i}.go"),
+                    repo_id: "test-repo".to_string(),
+                    language: "go".to_string(),
+                })
+                .collect();
+            let _ = done_tx.send(super::super::parse_files_parallel(&files, 2).len());
+        });
+        assert_eq!(
+            done_rx.recv_timeout(Duration::from_secs(10)),
+            Ok(4),
+            "a later batch must not hang behind the cancelled stream"
+        );
+    }
+}
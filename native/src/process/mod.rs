@@ -2,4 +2,7 @@ pub mod tracer;
 pub mod types;
 
 pub use tracer::*;
-pub use types::{NativeProcess, NativeProcessCallEdge, NativeProcessStep, NativeProcessSymbol};
+pub use types::{
+    NativeCsrProcessTraces, NativeProcess, NativeProcessCallEdge, NativeProcessStep,
+    NativeProcessSymbol,
+};
@@ -1,4 +1,10 @@
 use std::collections::{HashMap, HashSet};
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::{Arc, RwLock};
+
+use rayon::prelude::*;
+
+use crate::csr::CsrGraph;
 
 pub const DEFAULT_MAX_DEPTH: u32 = 20;
 
@@ -195,6 +201,200 @@ impl ProcessTracer {
     }
 }
 
+/// One DFS trace over a CSR call graph, as dense node IDs in visit order.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct CsrTrace {
+    pub steps: Vec<u32>,
+    pub depth: u32,
+}
+
+/// No visited-node rejection below a subtree; see [`ProcessTracer::visit_csr`].
+const UNBLOCKED: u32 = u32::MAX;
+
+/// Upper bound on the steps held by one call's suffix memo (16 MiB).
+const MEMO_MAX_STEPS: usize = 1 << 22;
+
+/// A shared callee's subtree as a trace from it with nothing else visited
+/// would produce it, entered at a given depth.
+struct Suffix {
+    steps: Vec<u32>,
+    /// Deepest absolute depth reached inside the suffix.
+    depth: u32,
+}
+
+/// Suffix traces of shared callees, keyed by (node, entry depth) and shared
+/// by every worker of one `trace_csr` call.
+struct SuffixMemo {
+    suffixes: RwLock<HashMap<(u32, u32), Arc<Suffix>>>,
+    steps: AtomicUsize,
+}
+
+impl SuffixMemo {
+    fn get(&self, node: usize, depth: u32) -> Option<Arc<Suffix>> {
+        let suffixes = self.suffixes.read().unwrap_or_else(|e| e.into_inner());
+        suffixes.get(&(node as u32, depth)).cloned()
+    }
+
+    fn insert(&self, node: usize, depth: u32, suffix: Suffix) {
+        let len = suffix.steps.len();
+        if self.steps.fetch_add(len, Ordering::Relaxed) + len > MEMO_MAX_STEPS {
+            self.steps.fetch_sub(len, Ordering::Relaxed);
+            return;
+        }
+        let mut suffixes = self.suffixes.write().unwrap_or_else(|e| e.into_inner());
+        suffixes
+            .entry((node as u32, depth))
+            .or_insert_with(|| Arc::new(suffix));
+    }
+}
+
+/// Read-only inputs of one `trace_csr` call.
+struct CsrTraceContext<'g, 'a> {
+    graph: &'g CsrGraph<'a>,
+    type_mask: u32,
+    /// Nodes with two or more incoming traced edges; only these are memoised.
+    shared: Vec<bool>,
+    memo: SuffixMemo,
+}
+
+/// Per-worker scratch. `visited[node] == generation` marks the node as seen
+/// by the current trace, so buffers are reused across entries without
+/// clearing; `position[node]` is then its index in the trace.
+struct CsrTraceWorker {
+    visited: Vec<u32>,
+    position: Vec<u32>,
+    generation: u32,
+}
+
+impl ProcessTracer {
+    /// Trace every entry node over `graph`, following only edges that pass
+    /// `type_mask`. Callees are visited in row order, so rows sorted by node
+    /// ID (the snapshot's interning order) give deterministic traces.
+    ///
+    /// Entries are traced in parallel. Subtrees of shared callees are
+    /// memoised and replayed when a later trace reaches the same callee at
+    /// the same depth with none of the suffix's nodes visited yet; under that
+    /// condition the replay is exactly what the depth-first search would have
+    /// produced, so results match a sequential trace step for step.
+    pub fn trace_csr(
+        &self,
+        graph: &CsrGraph<'_>,
+        type_mask: u32,
+        entry_nodes: &[u32],
+    ) -> Vec<CsrTrace> {
+        let n = graph.node_count();
+        let mut in_degree = vec![0u32; n];
+        for node in 0..n {
+            for edge in graph.edges(node) {
+                let callee = graph.neighbor(edge);
+                if callee < n && graph.includes(edge, type_mask) {
+                    in_degree[callee] = in_degree[callee].saturating_add(1);
+                }
+            }
+        }
+        let ctx = CsrTraceContext {
+            graph,
+            type_mask,
+            shared: in_degree.into_iter().map(|d| d >= 2).collect(),
+            memo: SuffixMemo {
+                suffixes: RwLock::new(HashMap::new()),
+                steps: AtomicUsize::new(0),
+            },
+        };
+        entry_nodes
+            .par_iter()
+            .map_init(
+                || CsrTraceWorker {
+                    visited: vec![0; n],
+                    position: vec![0; n],
+                    generation: 0,
+                },
+                |worker, &entry| {
+                    worker.generation += 1;
+                    let mut trace = CsrTrace {
+                        steps: Vec::new(),
+                        depth: 0,
+                    };
+                    if (entry as usize) < n {
+                        let (_, depth) =
+                            self.visit_csr(&ctx, worker, entry as usize, 0, &mut trace);
+                        trace.depth = depth;
+                    }
+                    trace
+                },
+            )
+            .collect()
+    }
+
+    /// Visit the unvisited `current` at `depth` (within the limit) and its
+    /// callees. Returns the smallest trace position of an already-visited
+    /// node the subtree ran into ([`UNBLOCKED`] if none) and the deepest
+    /// depth it reached. A subtree that only ran into its own nodes is what
+    /// a fresh trace from `current` would produce, so it can be memoised.
+    fn visit_csr(
+        &self,
+        ctx: &CsrTraceContext<'_, '_>,
+        worker: &mut CsrTraceWorker,
+        current: usize,
+        depth: u32,
+        trace: &mut CsrTrace,
+    ) -> (u32, u32) {
+        let generation = worker.generation;
+        if ctx.shared[current] {
+            if let Some(suffix) = ctx.memo.get(current, depth) {
+                if suffix
+                    .steps
+                    .iter()
+                    .all(|&node| worker.visited[node as usize] != generation)
+                {
+                    for &node in &suffix.steps {
+                        worker.visited[node as usize] = generation;
+                        worker.position[node as usize] = trace.steps.len() as u32;
+                        trace.steps.push(node);
+                    }
+                    return (UNBLOCKED, suffix.depth);
+                }
+            }
+        }
+
+        let start = trace.steps.len();
+        worker.visited[current] = generation;
+        worker.position[current] = start as u32;
+        trace.steps.push(current as u32);
+
+        let mut blocked = UNBLOCKED;
+        let mut deepest = depth;
+        if depth < self.config.max_depth {
+            for edge in ctx.graph.edges(current) {
+                let callee = ctx.graph.neighbor(edge);
+                if callee >= worker.visited.len() || !ctx.graph.includes(edge, ctx.type_mask) {
+                    continue;
+                }
+                if worker.visited[callee] == generation {
+                    blocked = blocked.min(worker.position[callee]);
+                    continue;
+                }
+                let (child_blocked, child_depth) =
+                    self.visit_csr(ctx, worker, callee, depth + 1, trace);
+                blocked = blocked.min(child_blocked);
+                deepest = deepest.max(child_depth);
+            }
+        }
+
+        if ctx.shared[current] && blocked >= start as u32 && trace.steps.len() - start >= 2 {
+            ctx.memo.insert(
+                current,
+                depth,
+                Suffix {
+                    steps: trace.steps[start..].to_vec(),
+                    depth: deepest,
+                },
+            );
+        }
+        (blocked, deepest)
+    }
+}
+
 impl TraceResult {
     pub fn symbol_ids(&self) -> Vec<&str> {
         self.steps.iter().map(|s| s.symbol_id.as_str()).collect()
@@ -408,4 +608,128 @@ mod tests {
         assert_eq!(config.max_depth, DEFAULT_MAX_DEPTH);
         assert_eq!(DEFAULT_MAX_DEPTH, 20);
     }
+
+    #[test]
+    fn test_csr_trace_matches_string_trace_for_sorted_rows() {
+        // Nodes a..e interned in order; rows sorted by node ID. The import
+        // edge (type 1) from a to e is ignored under a call-only mask.
+        let offsets = [0, 3, 4, 5, 6, 6];
+        let neighbors = [1, 2, 4, 3, 3, 0];
+        let types = [0, 0, 1, 0, 0, 0];
+        let graph = CsrGraph::new(&offsets, &neighbors, None, Some(&types)).unwrap();
+        let tracer = ProcessTracer::new(None);
+
+        let traces = tracer.trace_csr(&graph, 0b01, &[0, 2, 7]);
+        assert_eq!(traces[0].steps, vec![0, 1, 3, 2]);
+        assert_eq!(traces[0].depth, 2);
+        // The visited buffer is reset between entries.
+        assert_eq!(traces[1].steps, vec![2, 3, 0, 1]);
+        assert!(traces[2].steps.is_empty());
+
+        let edges = vec![
+            edge("a", "b"),
+            edge("a", "c"),
+            edge("b", "d"),
+            edge("c", "d"),
+            edge("d", "a"),
+        ];
+        let expected: Vec<String> = tracer
+            .trace("a", &edges)
+            .steps
+            .into_iter()
+            .map(|s| s.symbol_id)
+            .collect();
+        let names = ["a", "b", "c", "d", "e"];
+        let actual: Vec<&str> = traces[0].steps.iter().map(|&i| names[i as usize]).collect();
+        assert_eq!(actual, expected);
+
+        let shallow = ProcessTracer::new(Some(TracerConfig { max_depth: 1 }));
+        assert_eq!(
+            shallow.trace_csr(&graph, 0, &[0])[0].steps,
+            vec![0, 1, 2, 4]
+        );
+    }
+
+    /// Plain sequential DFS the memoised tracer must reproduce.
+    fn reference_trace(graph: &CsrGraph<'_>, max_depth: u32, mask: u32, entry: usize) -> CsrTrace {
+        fn visit(
+            graph: &CsrGraph<'_>,
+            max_depth: u32,
+            mask: u32,
+            current: usize,
+            depth: u32,
+            seen: &mut [bool],
+            trace: &mut CsrTrace,
+        ) {
+            if depth > max_depth || seen[current] {
+                return;
+            }
+            trace.depth = trace.depth.max(depth);
+            seen[current] = true;
+            trace.steps.push(current as u32);
+            for edge in graph.edges(current) {
+                if graph.includes(edge, mask) {
+                    let callee = graph.neighbor(edge);
+                    visit(graph, max_depth, mask, callee, depth + 1, seen, trace);
+                }
+            }
+        }
+        let mut trace = CsrTrace {
+            steps: Vec::new(),
+            depth: 0,
+        };
+        let mut seen = vec![false; graph.node_count()];
+        visit(graph, max_depth, mask, entry, 0, &mut seen, &mut trace);
+        trace
+    }
+
+    #[test]
+    fn test_csr_trace_with_shared_callees_matches_plain_dfs() {
+        // Layered graphs where many callers fan into a few shared utility
+        // nodes, plus back edges, so suffixes are both replayed and rejected.
+        let mut seed = 0x2545_f491_4f6c_dd1du64;
+        let mut next = move |bound: usize| {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            (seed % bound as u64) as usize
+        };
+        for round in 0..40 {
+            let n = 20 + next(60);
+            let mut rows: Vec<Vec<(u32, u8)>> = vec![Vec::new(); n];
+            for (node, row) in rows.iter_mut().enumerate() {
+                for _ in 0..next(4) {
+                    let callee = if next(4) == 0 {
+                        next(n)
+                    } else {
+                        (node + 1 + next(6)).min(n - 1)
+                    };
+                    row.push((callee as u32, (next(5) == 0) as u8));
+                }
+                row.sort_unstable();
+                row.dedup_by_key(|(callee, _)| *callee);
+            }
+            let mut offsets = vec![0u32];
+            let mut neighbors = Vec::new();
+            let mut types = Vec::new();
+            for row in &rows {
+                for &(callee, kind) in row {
+                    neighbors.push(callee);
+                    types.push(kind);
+                }
+                offsets.push(neighbors.len() as u32);
+            }
+            let graph = CsrGraph::new(&offsets, &neighbors, None, Some(&types)).unwrap();
+            let max_depth = 2 + (round % 7) as u32;
+            let mask = if round % 3 == 0 { 0 } else { 0b01 };
+            let tracer = ProcessTracer::new(Some(TracerConfig { max_depth }));
+            let entries: Vec<u32> = (0..n as u32).chain((0..n as u32).rev()).collect();
+
+            let traces = tracer.trace_csr(&graph, mask, &entries);
+            for (trace, &entry) in traces.iter().zip(&entries) {
+                let expected = reference_trace(&graph, max_depth, mask, entry as usize);
+                assert_eq!(trace, &expected, "round {round}, entry {entry}");
+            }
+        }
+    }
 }
@@ -29,3 +29,13 @@ pub struct NativeProcess {
     pub steps: Vec<NativeProcessStep>,
     pub depth: u32,
 }
+
+/// Traces returned by `traceProcessesCsr`, flattened. Trace `i` (for the
+/// `i`-th entry node) visits `steps[step_offsets[i]..step_offsets[i + 1]]`,
+/// as dense node IDs, and reached `depths[i]`.
+#[napi(object)]
+pub struct NativeCsrProcessTraces {
+    pub step_offsets: napi::bindgen_prelude::Uint32Array,
+    pub steps: napi::bindgen_prelude::Uint32Array,
+    pub depths: napi::bindgen_prelude::Uint32Array,
+}
@@ -1,12 +1,115 @@
-use ignore::WalkBuilder;
+//! Parallel repository scanner.
+//!
+//! Both entry points walk with `WalkBuilder::build_parallel`, compile every
+//! ignore pattern into a single override set, read size/mtime from the walk
+//! entry's own metadata (free on Windows, one `lstat` elsewhere) and return
+//! results sorted by relative path so output is deterministic regardless of
+//! walker scheduling.
+
+use ignore::overrides::{Override, OverrideBuilder};
+use ignore::{DirEntry, WalkBuilder, WalkState};
 use std::path::Path;
+use std::sync::mpsc;
+use std::time::UNIX_EPOCH;
 
 use crate::lang::extension_to_language;
-use crate::types::NativeFileInput;
+use crate::types::{NativeFileInput, NativeScanOptions, NativeScannedFile};
+
+/// Rewrite a config glob into override syntax with the TS walker's meaning.
+/// Config globs are matched against the whole relative path, but gitignore
+/// syntax floats slash-less patterns (`*.min.js`, `build/`) to every depth,
+/// so those are anchored to the root.
+fn anchored_pattern(pattern: &str) -> String {
+    let pattern = pattern.replace('\\', "/");
+    if pattern.starts_with('/') || pattern.trim_end_matches('/').contains('/') {
+        pattern
+    } else {
+        format!("/{pattern}")
+    }
+}
+
+/// Compile all ignore patterns into one override set. Patterns are negated
+/// (`!pattern`) so they only ever exclude. A trailing `/**` also gets a
+/// directory-only form so the walker prunes `node_modules/` itself instead of
+/// descending into it and rejecting each child.
+fn build_ignore_overrides(root: &Path, ignore_patterns: &[String]) -> Option<Override> {
+    if ignore_patterns.is_empty() {
+        return None;
+    }
+    let mut builder = OverrideBuilder::new(root);
+    for pattern in ignore_patterns {
+        let pattern = anchored_pattern(pattern);
+        if builder.add(&format!("!{pattern}")).is_err() {
+            eprintln!("sdl-mcp-native: ignoring invalid scan pattern {pattern:?}");
+            continue;
+        }
+        if let Some(dir) = pattern.strip_suffix("/**") {
+            if !dir.is_empty() {
+                let _ = builder.add(&format!("!{}/", anchored_pattern(dir)));
+            }
+        }
+    }
+    match builder.build() {
+        Ok(overrides) => Some(overrides),
+        Err(e) => {
+            eprintln!("sdl-mcp-native: failed to build scan overrides ({e}), scanning unfiltered");
+            None
+        }
+    }
+}
+
+#[cfg(unix)]
+fn inode(metadata: &std::fs::Metadata) -> f64 {
+    use std::os::unix::fs::MetadataExt;
+    metadata.ino() as f64
+}
+
+#[cfg(not(unix))]
+fn inode(_metadata: &std::fs::Metadata) -> f64 {
+    0.0
+}
+
+fn relative_path(root: &Path, path: &Path) -> Option<String> {
+    path.strip_prefix(root)
+        .ok()
+        .map(|rel| rel.to_string_lossy().replace('\\', "/"))
+}
+
+/// Walk `builder` in parallel, mapping each regular file through `visit`, and
+/// return the collected values sorted by `key`.
+fn walk_parallel<T, F, K>(builder: &WalkBuilder, visit: F, key: K) -> Vec<T>
+where
+    T: Send,
+    F: Fn(&DirEntry) -> Option<T> + Sync,
+    K: Fn(&T) -> &str,
+{
+    let (tx, rx) = mpsc::channel::<T>();
+    let visit = &visit;
+    builder.build_parallel().run(|| {
+        let tx = tx.clone();
+        Box::new(move |entry| {
+            let Ok(entry) = entry else {
+                return WalkState::Continue;
+            };
+            if entry.file_type().is_some_and(|ft| ft.is_file()) {
+                if let Some(value) = visit(&entry) {
+                    let _ = tx.send(value);
+                }
+            }
+            WalkState::Continue
+        })
+    });
+    drop(tx);
+
+    let mut out: Vec<T> = rx.into_iter().collect();
+    out.sort_unstable_by(|a, b| key(a).cmp(key(b)));
+    out
+}
 
 /// Scan a directory for source files, respecting .gitignore and ignore patterns.
 ///
-/// Returns NativeFileInput entries ready for parse_files_parallel.
+/// Returns NativeFileInput entries ready for parse_files_parallel, sorted by
+/// relative path.
 pub fn scan_directory(
     root_path: &str,
     repo_id: &str,
@@ -15,71 +118,187 @@ pub fn scan_directory(
     max_file_bytes: u64,
 ) -> Vec<NativeFileInput> {
     let root = Path::new(root_path);
-    let mut files = Vec::new();
 
     let mut builder = WalkBuilder::new(root);
     builder.hidden(false).git_ignore(true).git_global(false);
+    if let Some(overrides) = build_ignore_overrides(root, ignore_patterns) {
+        builder.overrides(overrides);
+    }
 
-    // Add custom ignore patterns
-    for pattern in ignore_patterns {
-        let mut override_builder = ignore::overrides::OverrideBuilder::new(root);
-        if let Ok(_) = override_builder.add(&format!("!{pattern}")) {
-            if let Ok(overrides) = override_builder.build() {
-                builder.overrides(overrides);
+    walk_parallel(
+        &builder,
+        |entry| {
+            let path = entry.path();
+            if let Ok(metadata) = entry.metadata() {
+                if metadata.len() > max_file_bytes {
+                    return None;
+                }
             }
-        }
-    }
 
-    let walker = builder.build();
+            let ext = path.extension().and_then(|e| e.to_str()).unwrap_or("");
+            let lang = extension_to_language(ext)?;
+            if !languages.is_empty() && !languages.iter().any(|l| l == lang) {
+                return None;
+            }
 
-    for entry in walker {
-        let entry = match entry {
-            Ok(e) => e,
-            Err(_) => continue,
-        };
+            Some(NativeFileInput {
+                rel_path: relative_path(root, path)?,
+                absolute_path: path.to_string_lossy().to_string(),
+                repo_id: repo_id.to_string(),
+                language: lang.to_string(),
+            })
+        },
+        |file| file.rel_path.as_str(),
+    )
+}
 
-        // Skip directories
-        if entry.file_type().map(|ft| ft.is_dir()).unwrap_or(true) {
-            continue;
-        }
+/// Scan for files whose name ends with one of `options.include_extensions`,
+/// mirroring `walkRepositoryFiles` in `src/indexer/fileWalker.ts`: no
+/// gitignore handling, hidden entries included, symlinks not followed.
+/// Files over `options.max_file_bytes` are dropped; size, mtime and inode come
+/// back with each entry so the caller does not need to stat again.
+pub fn scan_repository_files(
+    root_path: &str,
+    options: &NativeScanOptions,
+) -> Result<Vec<NativeScannedFile>, String> {
+    let root = Path::new(root_path);
+    if !root.is_dir() {
+        return Err(format!("scan root is not a directory: {root_path}"));
+    }
 
-        let path = entry.path();
+    let mut builder = WalkBuilder::new(root);
+    builder.standard_filters(false).follow_links(false);
+    if options.thread_count > 0 {
+        builder.threads(options.thread_count as usize);
+    }
+    if let Some(overrides) = build_ignore_overrides(root, &options.ignore_patterns) {
+        builder.overrides(overrides);
+    }
 
-        // Check file size
-        if let Ok(metadata) = path.metadata() {
-            if metadata.len() > max_file_bytes {
-                continue;
-            }
-        }
+    let max_file_bytes = options.max_file_bytes.map(|b| b.max(0.0) as u64);
+    let extensions = &options.include_extensions;
 
-        // Check file extension and language
-        let ext = path.extension().and_then(|e| e.to_str()).unwrap_or("");
+    Ok(walk_parallel(
+        &builder,
+        |entry| {
+            let rel_path = relative_path(root, entry.path())?;
+            if !extensions
+                .iter()
+                .any(|ext| rel_path.ends_with(ext.as_str()))
+            {
+                return None;
+            }
+            let metadata = entry.metadata().ok()?;
+            if max_file_bytes.is_some_and(|max| metadata.len() > max) {
+                return None;
+            }
+            let mtime_ms = metadata
+                .modified()
+                .ok()
+                .and_then(|t| t.duration_since(UNIX_EPOCH).ok())
+                .map(|d| d.as_secs_f64() * 1000.0)
+                .unwrap_or(0.0);
+            Some(NativeScannedFile {
+                rel_path,
+                size: metadata.len() as f64,
+                mtime_ms,
+                inode: inode(&metadata),
+            })
+        },
+        |file| file.rel_path.as_str(),
+    ))
+}
 
-        let lang = match extension_to_language(ext) {
-            Some(l) => l,
-            None => continue,
-        };
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::fs;
+    use std::time::SystemTime;
 
-        // Filter by configured languages
-        if !languages.is_empty() && !languages.iter().any(|l| l == lang) {
-            continue;
+    fn fixture() -> std::path::PathBuf {
+        let unique = SystemTime::now()
+            .duration_since(UNIX_EPOCH)
+            .expect("system clock before UNIX_EPOCH")
+            .as_nanos();
+        let root = std::env::temp_dir().join(format!("sdl_mcp_scan_{unique}"));
+        let big = "x".repeat(4096);
+        for (rel, body) in [
+            ("src/b.ts", "export const b = 1;\n"),
+            ("src/a.ts", "export const a = 1;\n"),
+            ("src/nested/c.ts", "export const c = 1;\n"),
+            ("src/readme.md", "# docs\n"),
+            ("node_modules/pkg/index.ts", "export {};\n"),
+            ("dist/out.ts", "export {};\n"),
+            (".hidden/h.ts", "export {};\n"),
+            ("big.ts", big.as_str()),
+            ("root.gen.ts", "export {};\n"),
+            ("src/keep.gen.ts", "export {};\n"),
+        ] {
+            let path = root.join(rel);
+            fs::create_dir_all(path.parent().unwrap()).unwrap();
+            fs::write(path, body).unwrap();
         }
+        root
+    }
 
-        // Compute relative path
-        let rel_path = match path.strip_prefix(root) {
-            Ok(rel) => rel.to_string_lossy().replace('\\', "/"),
-            Err(_) => continue,
+    #[test]
+    fn scan_repository_files_applies_every_ignore_pattern_and_sorts() {
+        let root = fixture();
+        let options = NativeScanOptions {
+            include_extensions: vec![".ts".into()],
+            ignore_patterns: vec![
+                "**/node_modules/**".into(),
+                "**/dist/**".into(),
+                "*.gen.ts".into(),
+            ],
+            max_file_bytes: Some(1024.0),
+            thread_count: 2,
         };
+        let files = scan_repository_files(root.to_str().unwrap(), &options).unwrap();
+        let _ = fs::remove_dir_all(&root);
 
-        let absolute_path = path.to_string_lossy().to_string();
-
-        files.push(NativeFileInput {
-            rel_path,
-            absolute_path,
-            repo_id: repo_id.to_string(),
-            language: lang.to_string(),
-        });
+        let paths: Vec<&str> = files.iter().map(|f| f.rel_path.as_str()).collect();
+        // Every ignore pattern applies (the old loop kept only the last one),
+        // slash-less globs stay root-anchored, oversized files are dropped and
+        // hidden files are kept.
+        assert_eq!(
+            paths,
+            vec![
+                ".hidden/h.ts",
+                "src/a.ts",
+                "src/b.ts",
+                "src/keep.gen.ts",
+                "src/nested/c.ts"
+            ]
+        );
+        assert!(files.iter().all(|f| f.size > 0.0 && f.mtime_ms > 0.0));
+        #[cfg(unix)]
+        assert!(files.iter().all(|f| f.inode > 0.0));
     }
 
-    files
+    #[test]
+    fn scan_directory_merges_ignore_patterns() {
+        let root = fixture();
+        let files = scan_directory(
+            root.to_str().unwrap(),
+            "repo",
+            &["**/node_modules/**".into(), "**/dist/**".into()],
+            &[],
+            1024,
+        );
+        let _ = fs::remove_dir_all(&root);
+
+        let paths: Vec<&str> = files.iter().map(|f| f.rel_path.as_str()).collect();
+        assert_eq!(
+            paths,
+            vec![
+                ".hidden/h.ts",
+                "root.gen.ts",
+                "src/a.ts",
+                "src/b.ts",
+                "src/keep.gen.ts",
+                "src/nested/c.ts"
+            ]
+        );
+    }
 }
@@ -1,5 +1,6 @@
 use napi::Result as NapiResult;
 use prost::Message;
+use std::fs::File;
 use std::sync::Mutex;
 
 // Include the prost-generated code from build.rs output.
@@ -8,19 +9,26 @@ use std::sync::Mutex;
 #[path = "scip.rs"]
 mod scip_proto;
 
+use super::stream::{
+    IndexFieldReader, INDEX_DOCUMENTS_FIELD, INDEX_EXTERNAL_SYMBOLS_FIELD, INDEX_METADATA_FIELD,
+};
 use super::types::*;
 use scip_proto::*;
 
 struct DocumentIterState {
-    docs: Vec<Document>,
-    cursor: usize,
+    fields: IndexFieldReader<File>,
+    /// Payload buffer reused across documents; sized to the largest so far.
+    buf: Vec<u8>,
+    done: bool,
 }
 
-/// Holds the decoded SCIP index with progressive memory release.
+/// Streams a SCIP index from disk one document at a time.
 ///
-/// Documents are taken (std::mem::take) from the vec as they're consumed,
-/// freeing each document's occurrences/symbols immediately after napi
-/// conversion instead of holding the entire decoded index in memory.
+/// Construction makes one pass over the file's top-level fields, decoding
+/// metadata and external symbols and seeking past every document. Documents
+/// are then decoded on demand from a second reader, so peak memory scales
+/// with the largest single document rather than with the whole index, and
+/// there is no whole-file size cap.
 pub struct ScipDecodeState {
     metadata: Option<Metadata>,
     external_symbols: Vec<SymbolInformation>,
@@ -28,28 +36,39 @@ pub struct ScipDecodeState {
 }
 
 impl ScipDecodeState {
-    /// Parse a SCIP index file from disk into an in-memory protobuf structure.
+    /// Open a SCIP index file and read its metadata and external symbols.
     pub fn new(file_path: &str) -> NapiResult<Self> {
-        const MAX_SCIP_INDEX_BYTES: u64 = 512 * 1024 * 1024;
-        let metadata = std::fs::metadata(file_path)
-            .map_err(|e| napi::Error::from_reason(format!("Failed to stat SCIP file: {}", e)))?;
-        if metadata.len() > MAX_SCIP_INDEX_BYTES {
-            return Err(napi::Error::from_reason(format!(
-                "SCIP index file too large: {} bytes (max {} bytes)",
-                metadata.len(),
-                MAX_SCIP_INDEX_BYTES
-            )));
+        let mut metadata: Option<Metadata> = None;
+        let mut external_symbols = Vec::new();
+        let mut fields = open_fields(file_path)?;
+        let mut buf = Vec::new();
+        while let Some(field) = fields.next_field().map_err(decode_error)? {
+            match field.number {
+                INDEX_METADATA_FIELD => {
+                    fields.read_payload(field, &mut buf).map_err(read_error)?;
+                    // Protobuf merges repeated occurrences of a singular
+                    // message field, exactly as a whole-index decode would.
+                    metadata
+                        .get_or_insert_with(Metadata::default)
+                        .merge(&buf[..])
+                        .map_err(decode_error)?;
+                }
+                INDEX_EXTERNAL_SYMBOLS_FIELD => {
+                    fields.read_payload(field, &mut buf).map_err(read_error)?;
+                    external_symbols
+                        .push(SymbolInformation::decode(&buf[..]).map_err(decode_error)?);
+                }
+                _ => fields.skip_payload(field).map_err(decode_error)?,
+            }
         }
-        let bytes = std::fs::read(file_path)
-            .map_err(|e| napi::Error::from_reason(format!("Failed to read SCIP file: {}", e)))?;
-        let index = Index::decode(&bytes[..])
-            .map_err(|e| napi::Error::from_reason(format!("Failed to decode SCIP index: {}", e)))?;
+
         Ok(Self {
-            metadata: index.metadata,
-            external_symbols: index.external_symbols,
+            metadata,
+            external_symbols,
             doc_state: Mutex::new(DocumentIterState {
-                docs: index.documents,
-                cursor: 0,
+                fields: open_fields(file_path)?,
+                buf: Vec::new(),
+                done: false,
             }),
         })
     }
@@ -75,24 +94,40 @@ impl ScipDecodeState {
         })
     }
 
-    /// Return the next document from the index, advancing the internal cursor.
+    /// Decode and return the next document from the index.
     /// Returns None when all documents have been consumed.
-    ///
-    /// Each consumed document is replaced with `Default::default()` via
-    /// `std::mem::take`, releasing its occurrences and symbol data immediately
-    /// rather than keeping the full decoded index resident until drop.
     pub fn next_document(&self) -> NapiResult<Option<NapiScipDocument>> {
-        let mut state = self
-            .doc_state
-            .lock()
-            .map_err(|e| napi::Error::from_reason(format!("Lock poisoned: {}", e)))?;
-        let idx = state.cursor;
-        if idx >= state.docs.len() {
-            return Ok(None);
+        let mut guard = self.lock_documents()?;
+        decode_next_document(&mut guard)
+    }
+
+    /// Decode up to `max_documents` documents, stopping early once the batch
+    /// holds `max_bytes` of encoded payload (always at least one document).
+    /// An empty batch means every document has been consumed.
+    pub fn next_documents(
+        &self,
+        max_documents: usize,
+        max_bytes: usize,
+    ) -> NapiResult<Vec<NapiScipDocument>> {
+        let mut guard = self.lock_documents()?;
+        let mut batch = Vec::new();
+        let mut bytes = 0;
+        while batch.len() < max_documents.max(1) && bytes < max_bytes {
+            match decode_next_document(&mut guard)? {
+                Some(doc) => {
+                    bytes += guard.buf.len();
+                    batch.push(doc);
+                }
+                None => break,
+            }
         }
-        let doc = std::mem::take(&mut state.docs[idx]);
-        state.cursor += 1;
-        Ok(Some(convert_document(&doc)))
+        Ok(batch)
+    }
+
+    fn lock_documents(&self) -> NapiResult<std::sync::MutexGuard<'_, DocumentIterState>> {
+        self.doc_state
+            .lock()
+            .map_err(|e| napi::Error::from_reason(format!("Lock poisoned: {}", e)))
     }
 
     /// Return all external symbols from the SCIP index.
@@ -105,6 +140,45 @@ impl ScipDecodeState {
     }
 }
 
+fn decode_next_document(state: &mut DocumentIterState) -> NapiResult<Option<NapiScipDocument>> {
+    if state.done {
+        return Ok(None);
+    }
+    while let Some(field) = state.fields.next_field().map_err(decode_error)? {
+        if field.number != INDEX_DOCUMENTS_FIELD {
+            state.fields.skip_payload(field).map_err(decode_error)?;
+            continue;
+        }
+        state
+            .fields
+            .read_payload(field, &mut state.buf)
+            .map_err(read_error)?;
+        let doc = Document::decode(&state.buf[..]).map_err(decode_error)?;
+        return Ok(Some(convert_document(&doc)));
+    }
+    state.done = true;
+    state.buf = Vec::new();
+    Ok(None)
+}
+
+fn open_fields(file_path: &str) -> NapiResult<IndexFieldReader<File>> {
+    let file = File::open(file_path)
+        .map_err(|e| napi::Error::from_reason(format!("Failed to read SCIP file: {}", e)))?;
+    let len = file
+        .metadata()
+        .map_err(|e| napi::Error::from_reason(format!("Failed to stat SCIP file: {}", e)))?
+        .len();
+    Ok(IndexFieldReader::new(file, len))
+}
+
+fn read_error(e: std::io::Error) -> napi::Error {
+    napi::Error::from_reason(format!("Failed to read SCIP file: {}", e))
+}
+
+fn decode_error(e: impl std::fmt::Display) -> napi::Error {
+    napi::Error::from_reason(format!("Failed to decode SCIP index: {}", e))
+}
+
 // --- Conversion functions ---
 
 fn convert_document(doc: &Document) -> NapiScipDocument {
@@ -208,3 +282,145 @@ fn convert_diagnostic(diag: &Diagnostic) -> NapiScipDiagnostic {
         range: None,
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::time::{SystemTime, UNIX_EPOCH};
+
+    fn symbol(name: &str) -> SymbolInformation {
+        SymbolInformation {
+            symbol: name.to_string(),
+            display_name: name.to_string(),
+            ..Default::default()
+        }
+    }
+
+    fn document(path: &str, occurrences: usize) -> Document {
+        Document {
+            language: "cpp".to_string(),
+            relative_path: path.to_string(),
+            occurrences: (0..occurrences)
+                .map(|i| Occurrence {
+                    range: vec![i as i32, 0, 4],
+                    symbol: format!("local {i}"),
+                    ..Default::default()
+                })
+                .collect(),
+            symbols: vec![symbol(&format!("{path}#sym"))],
+            ..Default::default()
+        }
+    }
+
+    /// Encode `index`, splitting `external_symbols` around the documents the
+    /// way streaming writers may emit them.
+    fn write_fixture(
+        name: &str,
+        index: &Index,
+        trailing_externals: &[SymbolInformation],
+    ) -> String {
+        let unique = SystemTime::now()
+            .duration_since(UNIX_EPOCH)
+            .expect("system clock before UNIX_EPOCH")
+            .as_nanos();
+        let path = std::env::temp_dir().join(format!("sdl_mcp_scip_{name}_{unique}.scip"));
+        let mut bytes = index.encode_to_vec();
+        bytes.extend(
+            Index {
+                external_symbols: trailing_externals.to_vec(),
+                ..Default::default()
+            }
+            .encode_to_vec(),
+        );
+        std::fs::write(&path, bytes).expect("write fixture");
+        path.to_string_lossy().into_owned()
+    }
+
+    #[test]
+    fn streams_documents_and_collects_trailing_external_symbols() {
+        let index = Index {
+            metadata: Some(Metadata {
+                version: 0,
+                tool_info: Some(ToolInfo {
+                    name: "scip-clang".to_string(),
+                    version: "0.3".to_string(),
+                    arguments: vec![],
+                }),
+                project_root: "file:///repo".to_string(),
+                text_document_encoding: 1,
+            }),
+            documents: vec![document("a.cc", 3), document("b.cc", 2000)],
+            external_symbols: vec![symbol("ext-1")],
+        };
+        let path = write_fixture("stream", &index, &[symbol("ext-2")]);
+
+        let state = ScipDecodeState::new(&path).expect("open");
+        let meta = state.metadata().unwrap();
+        assert_eq!(meta.tool_name, "scip-clang");
+        assert_eq!(meta.project_root, "file:///repo");
+        assert_eq!(meta.text_document_encoding, "UTF8");
+
+        // Externals after the documents are available before streaming.
+        let externals: Vec<String> = state
+            .external_symbols()
+            .unwrap()
+            .into_iter()
+            .map(|s| s.symbol)
+            .collect();
+        assert_eq!(externals, vec!["ext-1", "ext-2"]);
+
+        let first = state.next_document().unwrap().expect("first document");
+        assert_eq!(first.relative_path, "a.cc");
+        assert_eq!(first.occurrences.len(), 3);
+        assert_eq!(first.occurrences[1].range.start_line, 1);
+        let second = state.next_document().unwrap().expect("second document");
+        assert_eq!(second.relative_path, "b.cc");
+        assert_eq!(second.occurrences.len(), 2000);
+        assert!(state.next_document().unwrap().is_none());
+        assert!(state.next_document().unwrap().is_none());
+        let _ = std::fs::remove_file(path);
+    }
+
+    #[test]
+    fn batches_documents_by_count_and_bytes() {
+        let index = Index {
+            documents: (0..5).map(|i| document(&format!("f{i}.cc"), 4)).collect(),
+            ..Default::default()
+        };
+        let path = write_fixture("batch", &index, &[]);
+        let state = ScipDecodeState::new(&path).expect("open");
+        let paths = |docs: Vec<NapiScipDocument>| -> Vec<String> {
+            docs.into_iter().map(|d| d.relative_path).collect()
+        };
+
+        assert_eq!(
+            paths(state.next_documents(2, usize::MAX).unwrap()),
+            ["f0.cc", "f1.cc"]
+        );
+        // A byte budget smaller than one document still yields one.
+        assert_eq!(paths(state.next_documents(10, 1).unwrap()), ["f2.cc"]);
+        assert_eq!(
+            state.next_document().unwrap().unwrap().relative_path,
+            "f3.cc"
+        );
+        assert_eq!(
+            paths(state.next_documents(10, usize::MAX).unwrap()),
+            ["f4.cc"]
+        );
+        assert!(state.next_documents(10, usize::MAX).unwrap().is_empty());
+        let _ = std::fs::remove_file(path);
+    }
+
+    #[test]
+    fn rejects_truncated_index() {
+        let index = Index {
+            documents: vec![document("a.cc", 10)],
+            ..Default::default()
+        };
+        let bytes = index.encode_to_vec();
+        let path = write_fixture("truncated", &Index::default(), &[]);
+        std::fs::write(&path, &bytes[..bytes.len() - 5]).unwrap();
+        assert!(ScipDecodeState::new(&path).is_err());
+        let _ = std::fs::remove_file(path);
+    }
+}
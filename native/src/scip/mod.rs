@@ -1,2 +1,3 @@
 pub mod decoder;
+pub mod stream;
 pub mod types;
@@ -0,0 +1,238 @@
+//! Incremental reader over the top-level fields of a SCIP `Index` message.
+//!
+//! An `Index` is a sequence of protobuf fields: `metadata` (1), `documents`
+//! (2) and `external_symbols` (3), all length-delimited and allowed in any
+//! order. [`IndexFieldReader`] walks those field headers straight from a
+//! buffered reader, so callers decode one field payload at a time and skip
+//! the ones they do not need without reading them. Memory then scales with
+//! the largest single field rather than with the whole index.
+
+use std::io::{self, BufRead, BufReader, Read, Seek};
+
+pub const INDEX_METADATA_FIELD: u32 = 1;
+pub const INDEX_DOCUMENTS_FIELD: u32 = 2;
+pub const INDEX_EXTERNAL_SYMBOLS_FIELD: u32 = 3;
+
+const WIRE_VARINT: u64 = 0;
+const WIRE_FIXED64: u64 = 1;
+const WIRE_LENGTH_DELIMITED: u64 = 2;
+const WIRE_FIXED32: u64 = 5;
+
+/// Header of a length-delimited top-level field; the reader is positioned at
+/// the start of its payload.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct IndexField {
+    pub number: u32,
+    pub len: usize,
+}
+
+pub struct IndexFieldReader<R> {
+    reader: BufReader<R>,
+    position: u64,
+    total_len: u64,
+}
+
+impl<R: Read + Seek> IndexFieldReader<R> {
+    /// `total_len` is the byte length of the encoded `Index` (the file size).
+    pub fn new(reader: R, total_len: u64) -> Self {
+        Self {
+            reader: BufReader::with_capacity(64 * 1024, reader),
+            position: 0,
+            total_len,
+        }
+    }
+
+    /// Advance to the next length-delimited field. Scalar fields (unknown to
+    /// `Index`) are skipped here; `None` means the index ended cleanly on a
+    /// field boundary.
+    pub fn next_field(&mut self) -> io::Result<Option<IndexField>> {
+        loop {
+            if self.reader.fill_buf()?.is_empty() {
+                if self.position != self.total_len {
+                    return Err(invalid(format!(
+                        "SCIP index ended at byte {} of {}",
+                        self.position, self.total_len
+                    )));
+                }
+                return Ok(None);
+            }
+            let key = self.read_varint()?;
+            let number = key >> 3;
+            if number == 0 || number > u64::from(u32::MAX >> 3) {
+                return Err(invalid(format!(
+                    "invalid SCIP field number {number} at byte {}",
+                    self.position
+                )));
+            }
+            match key & 7 {
+                WIRE_VARINT => {
+                    self.read_varint()?;
+                }
+                WIRE_FIXED64 => self.skip(8)?,
+                WIRE_FIXED32 => self.skip(4)?,
+                WIRE_LENGTH_DELIMITED => {
+                    let len = self.read_varint()?;
+                    if len > self.remaining() {
+                        return Err(invalid(format!(
+                            "SCIP field {number} at byte {} claims {len} bytes, past the end of the index",
+                            self.position
+                        )));
+                    }
+                    let len = usize::try_from(len)
+                        .map_err(|_| invalid(format!("SCIP field {number} is too large")))?;
+                    return Ok(Some(IndexField {
+                        number: number as u32,
+                        len,
+                    }));
+                }
+                wire => {
+                    return Err(invalid(format!(
+                        "unsupported protobuf wire type {wire} for SCIP field {number}"
+                    )));
+                }
+            }
+        }
+    }
+
+    /// Read the current field's payload into `buf` (replacing its contents).
+    pub fn read_payload(&mut self, field: IndexField, buf: &mut Vec<u8>) -> io::Result<()> {
+        buf.clear();
+        buf.resize(field.len, 0);
+        self.reader.read_exact(buf)?;
+        self.position += field.len as u64;
+        Ok(())
+    }
+
+    /// Skip the current field's payload without reading it.
+    pub fn skip_payload(&mut self, field: IndexField) -> io::Result<()> {
+        self.skip(field.len as u64)
+    }
+
+    fn skip(&mut self, len: u64) -> io::Result<()> {
+        if len > self.remaining() {
+            return Err(invalid(format!(
+                "SCIP index truncated at byte {}",
+                self.position
+            )));
+        }
+        let offset =
+            i64::try_from(len).map_err(|_| invalid("SCIP skip offset too large".to_string()))?;
+        self.reader.seek_relative(offset)?;
+        self.position += len;
+        Ok(())
+    }
+
+    fn remaining(&self) -> u64 {
+        self.total_len.saturating_sub(self.position)
+    }
+
+    fn read_varint(&mut self) -> io::Result<u64> {
+        let mut value: u64 = 0;
+        for shift in (0..64).step_by(7) {
+            let mut byte = [0u8; 1];
+            self.reader.read_exact(&mut byte)?;
+            self.position += 1;
+            value |= u64::from(byte[0] & 0x7f) << shift;
+            if byte[0] & 0x80 == 0 {
+                return Ok(value);
+            }
+        }
+        Err(invalid(format!(
+            "malformed varint in SCIP index at byte {}",
+            self.position
+        )))
+    }
+}
+
+fn invalid(message: String) -> io::Error {
+    io::Error::new(io::ErrorKind::InvalidData, message)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::io::Cursor;
+
+    fn varint(mut value: u64, out: &mut Vec<u8>) {
+        while value >= 0x80 {
+            out.push((value as u8) | 0x80);
+            value >>= 7;
+        }
+        out.push(value as u8);
+    }
+
+    fn field(number: u32, payload: &[u8], out: &mut Vec<u8>) {
+        varint(u64::from(number) << 3 | WIRE_LENGTH_DELIMITED, out);
+        varint(payload.len() as u64, out);
+        out.extend_from_slice(payload);
+    }
+
+    fn reader(bytes: Vec<u8>) -> IndexFieldReader<Cursor<Vec<u8>>> {
+        let len = bytes.len() as u64;
+        IndexFieldReader::new(Cursor::new(bytes), len)
+    }
+
+    #[test]
+    fn walks_fields_in_order_and_skips_scalars_and_payloads() {
+        let big = vec![7u8; 200_000];
+        let mut bytes = Vec::new();
+        field(INDEX_METADATA_FIELD, b"meta", &mut bytes);
+        // Unknown scalar fields: varint, fixed64, fixed32.
+        varint(9 << 3 | WIRE_VARINT, &mut bytes);
+        varint(300, &mut bytes);
+        varint(10 << 3 | WIRE_FIXED64, &mut bytes);
+        bytes.extend_from_slice(&[0; 8]);
+        varint(11 << 3 | WIRE_FIXED32, &mut bytes);
+        bytes.extend_from_slice(&[0; 4]);
+        field(INDEX_DOCUMENTS_FIELD, &big, &mut bytes);
+        field(INDEX_EXTERNAL_SYMBOLS_FIELD, b"ext", &mut bytes);
+        field(INDEX_DOCUMENTS_FIELD, b"doc2", &mut bytes);
+
+        let mut fields = reader(bytes);
+        let mut buf = Vec::new();
+        let meta = fields.next_field().unwrap().unwrap();
+        assert_eq!(meta, IndexField { number: 1, len: 4 });
+        fields.read_payload(meta, &mut buf).unwrap();
+        assert_eq!(buf, b"meta");
+
+        let doc = fields.next_field().unwrap().unwrap();
+        assert_eq!(
+            doc,
+            IndexField {
+                number: 2,
+                len: big.len()
+            }
+        );
+        fields.skip_payload(doc).unwrap();
+
+        let ext = fields.next_field().unwrap().unwrap();
+        fields.read_payload(ext, &mut buf).unwrap();
+        assert_eq!(buf, b"ext");
+
+        let doc2 = fields.next_field().unwrap().unwrap();
+        fields.read_payload(doc2, &mut buf).unwrap();
+        assert_eq!(buf, b"doc2");
+        assert!(fields.next_field().unwrap().is_none());
+    }
+
+    #[test]
+    fn rejects_truncated_and_malformed_input() {
+        let mut bytes = Vec::new();
+        field(INDEX_DOCUMENTS_FIELD, b"document", &mut bytes);
+        bytes.truncate(bytes.len() - 3);
+        assert!(reader(bytes).next_field().is_err());
+
+        // Group wire types are not valid in SCIP.
+        let mut bytes = Vec::new();
+        varint(2 << 3 | 3, &mut bytes);
+        assert!(reader(bytes).next_field().is_err());
+
+        // Field number 0.
+        assert!(reader(vec![0x02, 0x00]).next_field().is_err());
+
+        // Key cut off mid-varint.
+        assert!(reader(vec![0x92]).next_field().is_err());
+
+        assert!(reader(Vec::new()).next_field().unwrap().is_none());
+    }
+}
@@ -0,0 +1,683 @@
+//! The beam loop, a port of `beamSearch` in
+//! `src/graph/slice/beam-search-engine.ts`.
+//!
+//! [`Frontier`] reproduces the TypeScript `MinHeap` operation for operation,
+//! including `replaceAt`'s bubble-up-then-down at the original index, so the
+//! returned frontier is in the same heap-array order and spillover pages
+//! match.
+
+use std::collections::VecDeque;
+
+use super::graph::{SliceGraph, NO_INDEX};
+use super::score::{apply_centrality_tiebreak, Scorer};
+
+/// `SLICE_SCORE_THRESHOLD`.
+pub const SLICE_SCORE_THRESHOLD: f64 = 0.2;
+/// `MAX_FRONTIER`.
+pub const MAX_FRONTIER: usize = 1000;
+const DYNAMIC_CAP_MIN_CARDS: usize = 6;
+const DYNAMIC_CAP_HIGH_CONFIDENCE_MARGIN: f64 = 0.2;
+const DYNAMIC_CAP_RECENT_SCORE_WINDOW: usize = 6;
+const DYNAMIC_CAP_MIN_ENTRY_COVERAGE: f64 = 0.9;
+const DYNAMIC_CAP_FRONTIER_SCORE_MARGIN: f64 = 0.08;
+const DYNAMIC_CAP_FRONTIER_DROP_FACTOR: f64 = 0.67;
+/// Consecutive below-threshold pops that end the search.
+const MAX_BELOW_THRESHOLD: u32 = 5;
+/// Edge weight for types the request gives no weight.
+const DEFAULT_EDGE_WEIGHT: f64 = 0.5;
+/// `edge_type` of items and events that did not come from an edge.
+pub const NO_EDGE_TYPE: u8 = u8::MAX;
+
+pub const EVENT_ACCEPT: u8 = 0;
+pub const EVENT_EVICT: u8 = 1;
+pub const EVENT_REJECT: u8 = 2;
+
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub struct Item {
+    pub node: u32,
+    /// Negated score: lower is better.
+    pub score: f64,
+    pub priority: u8,
+    pub sequence: u32,
+    /// Index into the request's start nodes, or [`NO_INDEX`].
+    pub start: u32,
+    pub from: u32,
+    pub edge_type: u8,
+    pub edge_weight: f64,
+}
+
+/// `compareFrontierItems`, NaN behaviour included.
+fn compare(a: &Item, b: &Item) -> f64 {
+    if a.score != b.score {
+        return a.score - b.score;
+    }
+    if a.priority != b.priority {
+        return f64::from(a.priority) - f64::from(b.priority);
+    }
+    f64::from(a.sequence) - f64::from(b.sequence)
+}
+
+#[derive(Debug, Default)]
+pub struct Frontier {
+    heap: Vec<Item>,
+}
+
+impl Frontier {
+    pub fn len(&self) -> usize {
+        self.heap.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.heap.is_empty()
+    }
+
+    pub fn peek(&self) -> Option<&Item> {
+        self.heap.first()
+    }
+
+    pub fn insert(&mut self, item: Item) {
+        self.heap.push(item);
+        self.bubble_up(self.heap.len() - 1);
+    }
+
+    pub fn extract_min(&mut self) -> Option<Item> {
+        if self.heap.len() <= 1 {
+            return self.heap.pop();
+        }
+        let last = self.heap.pop()?;
+        let min = std::mem::replace(&mut self.heap[0], last);
+        self.bubble_down(0);
+        Some(min)
+    }
+
+    /// The worst item and its index; in a min-heap it is always a leaf.
+    pub fn find_worst(&self) -> Option<(usize, Item)> {
+        let n = self.heap.len();
+        if n == 0 {
+            return None;
+        }
+        let mut worst = n / 2;
+        for i in n / 2 + 1..n {
+            if compare(&self.heap[i], &self.heap[worst]) > 0.0 {
+                worst = i;
+            }
+        }
+        Some((worst, self.heap[worst]))
+    }
+
+    pub fn replace_at(&mut self, index: usize, item: Item) {
+        if index >= self.heap.len() {
+            return;
+        }
+        self.heap[index] = item;
+        self.bubble_up(index);
+        self.bubble_down(index);
+    }
+
+    pub fn into_heap_order(self) -> Vec<Item> {
+        self.heap
+    }
+
+    fn bubble_up(&mut self, mut index: usize) {
+        while index > 0 {
+            let parent = (index - 1) / 2;
+            if compare(&self.heap[parent], &self.heap[index]) <= 0.0 {
+                break;
+            }
+            self.heap.swap(parent, index);
+            index = parent;
+        }
+    }
+
+    fn bubble_down(&mut self, mut index: usize) {
+        let len = self.heap.len();
+        loop {
+            let mut smallest = index;
+            let left = 2 * index + 1;
+            let right = left + 1;
+            if left < len && compare(&self.heap[left], &self.heap[smallest]) < 0.0 {
+                smallest = left;
+            }
+            if right < len && compare(&self.heap[right], &self.heap[smallest]) < 0.0 {
+                smallest = right;
+            }
+            if smallest == index {
+                break;
+            }
+            self.heap.swap(smallest, index);
+            index = smallest;
+        }
+    }
+}
+
+/// One beam decision, for the beam-explain trace.
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub struct Event {
+    pub kind: u8,
+    pub node: u32,
+    /// The trace's `totalScore` (positive is better).
+    pub score: f64,
+    pub from: u32,
+    pub edge_type: u8,
+    pub edge_weight: f64,
+    pub iteration: u32,
+    /// Edge type of the candidate that caused an eviction or rejection.
+    pub cause: u8,
+}
+
+pub struct BeamRequest<'a> {
+    pub start_nodes: &'a [u32],
+    /// Frontier score per start node (negated, as in `START_NODE_SOURCE_SCORE`).
+    pub start_scores: &'a [f64],
+    /// Nodes that bypass the score threshold (edited-file start nodes).
+    pub forced_nodes: &'a [u32],
+    pub entry_nodes: &'a [u32],
+    /// Distinct requested entry symbols, including any outside the graph.
+    pub required_entry_coverage: usize,
+    pub query_tokens: &'a [String],
+    pub stack_trace: Option<&'a str>,
+    /// Base weight per edge type code.
+    pub edge_weights: &'a [f64],
+    /// Cohesion boost per cluster index; empty when cohesion is off.
+    pub cluster_boost: &'a [f64],
+    pub min_confidence: f64,
+    pub max_cards: usize,
+    pub max_estimated_tokens: f64,
+    pub record_events: bool,
+}
+
+#[derive(Debug, Default)]
+pub struct BeamOutcome {
+    /// Accepted nodes, in acceptance order.
+    pub slice: Vec<u32>,
+    pub frontier: Vec<Item>,
+    pub was_truncated: bool,
+    pub dropped_candidates: u32,
+    pub max_frontier_size: u32,
+    pub accepted: u32,
+    pub evicted: u32,
+    pub rejected: u32,
+    pub events: Vec<Event>,
+}
+
+/// `computeMinCardsForDynamicCap`.
+fn min_cards_for_dynamic_cap(max_cards: usize, entry_count: usize) -> usize {
+    let entry_floor = if entry_count > 0 {
+        entry_count + 2
+    } else {
+        DYNAMIC_CAP_MIN_CARDS
+    };
+    max_cards
+        .min(DYNAMIC_CAP_MIN_CARDS)
+        .max(max_cards.min(entry_floor))
+}
+
+/// `getAdaptiveMinConfidence`.
+fn adaptive_min_confidence(min_confidence: f64, used: f64, max: f64) -> f64 {
+    let clamped = min_confidence.min(1.0).max(0.0);
+    if max <= 0.0 {
+        return clamped;
+    }
+    let ratio = used / max;
+    if ratio > 0.9 {
+        return min_confidence.max(0.95);
+    }
+    if ratio > 0.7 {
+        return min_confidence.max(0.8);
+    }
+    clamped
+}
+
+struct State<'a> {
+    request: &'a BeamRequest<'a>,
+    in_slice: Vec<bool>,
+    visited: Vec<bool>,
+    is_entry: Vec<bool>,
+    frontier: Frontier,
+    sequence: u32,
+    covered_entries: usize,
+    high_confidence: usize,
+    recent: VecDeque<f64>,
+    iteration: u32,
+    out: BeamOutcome,
+}
+
+impl State<'_> {
+    fn track_frontier(&mut self) {
+        self.out.max_frontier_size = self.out.max_frontier_size.max(self.frontier.len() as u32);
+    }
+
+    fn accept(&mut self, node: u32, score: f64, from: Option<&Item>) {
+        self.in_slice[node as usize] = true;
+        self.out.slice.push(node);
+        if self.is_entry[node as usize] {
+            self.covered_entries += 1;
+        }
+        if score >= SLICE_SCORE_THRESHOLD + DYNAMIC_CAP_HIGH_CONFIDENCE_MARGIN {
+            self.high_confidence += 1;
+        }
+        self.recent.push_back(score);
+        if self.recent.len() > DYNAMIC_CAP_RECENT_SCORE_WINDOW {
+            self.recent.pop_front();
+        }
+        self.out.accepted += 1;
+        if self.request.record_events {
+            self.out.events.push(Event {
+                kind: EVENT_ACCEPT,
+                node,
+                score,
+                from: from.map_or(NO_INDEX, |item| item.from),
+                edge_type: from.map_or(NO_EDGE_TYPE, |item| item.edge_type),
+                edge_weight: from.map_or(f64::NAN, |item| item.edge_weight),
+                iteration: self.iteration,
+                cause: NO_EDGE_TYPE,
+            });
+        }
+    }
+
+    fn rollback(&mut self, node: u32, score: f64) {
+        // The node was accepted immediately before, so it is last.
+        self.out.slice.pop();
+        self.in_slice[node as usize] = false;
+        if self.is_entry[node as usize] {
+            self.covered_entries = self.covered_entries.saturating_sub(1);
+        }
+        if score >= SLICE_SCORE_THRESHOLD + DYNAMIC_CAP_HIGH_CONFIDENCE_MARGIN {
+            self.high_confidence = self.high_confidence.saturating_sub(1);
+        }
+        self.recent.pop_back();
+    }
+
+    /// `insertCandidateIntoFrontier`.
+    fn insert_candidate(&mut self, item: Item) {
+        if self.frontier.len() < MAX_FRONTIER {
+            self.frontier.insert(item);
+            self.track_frontier();
+            return;
+        }
+        let Some((index, worst)) = self.frontier.find_worst() else {
+            return;
+        };
+        if compare(&item, &worst) < 0.0 {
+            self.frontier.replace_at(index, item);
+            self.track_frontier();
+            self.out.evicted += 1;
+            if self.request.record_events {
+                self.out.events.push(Event {
+                    kind: EVENT_EVICT,
+                    node: worst.node,
+                    score: -worst.score,
+                    from: worst.from,
+                    edge_type: worst.edge_type,
+                    edge_weight: worst.edge_weight,
+                    iteration: self.iteration,
+                    cause: item.edge_type,
+                });
+            }
+        } else {
+            self.out.dropped_candidates += 1;
+            self.out.rejected += 1;
+            if self.request.record_events {
+                self.out.events.push(Event {
+                    kind: EVENT_REJECT,
+                    node: item.node,
+                    score: -item.score,
+                    from: item.from,
+                    edge_type: item.edge_type,
+                    edge_weight: item.edge_weight,
+                    iteration: self.iteration,
+                    cause: item.edge_type,
+                });
+            }
+        }
+    }
+
+    /// `shouldTightenDynamicCardCap`.
+    fn should_tighten(&self, min_cards: usize) -> bool {
+        let size = self.out.slice.len();
+        if size < min_cards {
+            return false;
+        }
+        let Some(next) = self.frontier.peek() else {
+            return false;
+        };
+        if self.recent.is_empty() {
+            return false;
+        }
+        let high_ratio = self.high_confidence as f64 / size.max(1) as f64;
+        if high_ratio < 0.6 {
+            return false;
+        }
+        let required = self.request.required_entry_coverage;
+        if required > 0 {
+            let coverage = self.covered_entries as f64 / required.max(1) as f64;
+            if coverage < DYNAMIC_CAP_MIN_ENTRY_COVERAGE {
+                return false;
+            }
+        }
+        let recent_avg = self.recent.iter().fold(0.0, |sum, s| sum + s) / self.recent.len() as f64;
+        let drop_threshold = (SLICE_SCORE_THRESHOLD + DYNAMIC_CAP_FRONTIER_SCORE_MARGIN)
+            .max(recent_avg * DYNAMIC_CAP_FRONTIER_DROP_FACTOR);
+        -next.score < drop_threshold
+    }
+}
+
+pub fn validate_request(graph: &SliceGraph, request: &BeamRequest) -> Result<(), String> {
+    let n = graph.node_count();
+    if request.start_nodes.len() != request.start_scores.len() {
+        return Err("start_scores must have one entry per start node".into());
+    }
+    for (name, nodes) in [
+        ("start_nodes", request.start_nodes),
+        ("forced_nodes", request.forced_nodes),
+        ("entry_nodes", request.entry_nodes),
+    ] {
+        if nodes.iter().any(|&node| node as usize >= n) {
+            return Err(format!("{name} contains a node out of range"));
+        }
+    }
+    Ok(())
+}
+
+/// Run the beam over `graph`. The request must pass [`validate_request`].
+pub fn beam_search(graph: &SliceGraph, request: &BeamRequest) -> BeamOutcome {
+    let n = graph.node_count();
+    let mut forced = vec![false; n];
+    for &node in request.forced_nodes {
+        forced[node as usize] = true;
+    }
+    let mut is_entry = vec![false; n];
+    for &node in request.entry_nodes {
+        is_entry[node as usize] = true;
+    }
+    let mut state = State {
+        request,
+        in_slice: vec![false; n],
+        visited: vec![false; n],
+        is_entry,
+        frontier: Frontier::default(),
+        sequence: 0,
+        covered_entries: 0,
+        high_confidence: 0,
+        recent: VecDeque::with_capacity(DYNAMIC_CAP_RECENT_SCORE_WINDOW + 1),
+        iteration: 0,
+        out: BeamOutcome::default(),
+    };
+    let min_cards = min_cards_for_dynamic_cap(request.max_cards, request.required_entry_coverage);
+    let mut card_cap = request.max_cards;
+    let mut total_tokens = 0.0;
+    let mut below_threshold = 0u32;
+    let mut scorer = Scorer::new(graph, request.query_tokens, request.stack_trace);
+
+    for (start, (&node, &score)) in request
+        .start_nodes
+        .iter()
+        .zip(request.start_scores)
+        .enumerate()
+    {
+        if state.visited[node as usize] {
+            continue;
+        }
+        let item = Item {
+            node,
+            score,
+            priority: 0,
+            sequence: state.sequence,
+            start: start as u32,
+            from: NO_INDEX,
+            edge_type: NO_EDGE_TYPE,
+            edge_weight: f64::NAN,
+        };
+        state.sequence += 1;
+        state.frontier.insert(item);
+        state.track_frontier();
+        state.visited[node as usize] = true;
+    }
+
+    while !state.frontier.is_empty() && state.out.slice.len() < card_cap {
+        state.iteration += 1;
+        let min_confidence = adaptive_min_confidence(
+            request.min_confidence,
+            total_tokens,
+            request.max_estimated_tokens,
+        );
+        let Some(current) = state.frontier.extract_min() else {
+            break;
+        };
+        let node = current.node as usize;
+        let actual = -current.score;
+        if actual < SLICE_SCORE_THRESHOLD && !forced[node] {
+            below_threshold += 1;
+            if below_threshold >= MAX_BELOW_THRESHOLD {
+                break;
+            }
+            continue;
+        }
+        below_threshold = 0;
+
+        state.accept(current.node, actual, Some(&current));
+        let tokens = graph.card_tokens[node];
+        total_tokens += tokens;
+        if total_tokens > request.max_estimated_tokens {
+            state.rollback(current.node, actual);
+            state.out.was_truncated = true;
+            state.out.dropped_candidates += 1;
+            break;
+        }
+
+        let row = graph.offsets[node] as usize..graph.offsets[node + 1] as usize;
+        let open = row.clone().any(|edge| {
+            let v = graph.neighbors[edge] as usize;
+            !state.visited[v] && !state.in_slice[v]
+        });
+        if !open {
+            continue;
+        }
+        for edge in row {
+            let neighbor = graph.neighbors[edge];
+            let v = neighbor as usize;
+            if state.visited[v] || state.in_slice[v] {
+                continue;
+            }
+            state.visited[v] = true;
+            if graph.external[v] {
+                state.accept(neighbor, 0.0, None);
+                continue;
+            }
+            let confidence = graph.confidences[edge];
+            if confidence < min_confidence {
+                state.out.dropped_candidates += 1;
+                continue;
+            }
+            let edge_type = graph.edge_types[edge];
+            let edge_weight = request
+                .edge_weights
+                .get(edge_type as usize)
+                .copied()
+                .unwrap_or(DEFAULT_EDGE_WEIGHT)
+                * confidence;
+            let cluster = graph.node_clusters[v];
+            let cluster_boost = if cluster == NO_INDEX {
+                0.0
+            } else {
+                request
+                    .cluster_boost
+                    .get(cluster as usize)
+                    .copied()
+                    .unwrap_or(0.0)
+            };
+            let final_score = apply_centrality_tiebreak(
+                scorer.primary_score(v) * edge_weight + cluster_boost,
+                graph.centrality[v],
+            );
+            let neighbor_score = -final_score;
+            if -neighbor_score < SLICE_SCORE_THRESHOLD {
+                state.out.dropped_candidates += 1;
+                continue;
+            }
+            let item = Item {
+                node: neighbor,
+                score: neighbor_score,
+                priority: 10,
+                sequence: state.sequence,
+                start: NO_INDEX,
+                from: current.node,
+                edge_type,
+                edge_weight,
+            };
+            state.sequence += 1;
+            state.insert_candidate(item);
+        }
+
+        if state.should_tighten(min_cards) {
+            card_cap = card_cap.min(state.out.slice.len());
+        }
+    }
+
+    if state.out.slice.len() >= request.max_cards {
+        state.out.was_truncated = true;
+    }
+    let mut out = state.out;
+    out.frontier = state.frontier.into_heap_order();
+    out
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    /// A chain 0 → 1 → … with node 0 also pointing at every other node.
+    fn fan_graph(n: usize, external: &[usize]) -> SliceGraph {
+        let mut offsets = vec![0u32];
+        let mut neighbors = Vec::new();
+        for u in 0..n {
+            if u == 0 {
+                neighbors.extend(1..n as u32);
+            } else if u + 1 < n {
+                neighbors.push(u as u32 + 1);
+            }
+            offsets.push(neighbors.len() as u32);
+        }
+        let m = neighbors.len();
+        SliceGraph {
+            offsets,
+            neighbors,
+            edge_types: vec![0; m],
+            confidences: vec![1.0; m],
+            names: (0..n).map(|i| format!("sym{i}")).collect(),
+            node_files: vec![NO_INDEX; n],
+            range_start_lines: vec![1.0; n],
+            range_end_lines: vec![2.0; n],
+            structure: vec![0.8; n],
+            kind: (0..n).map(|i| 1.0 - i as f64 * 0.01).collect(),
+            hotness: vec![0.0; n],
+            centrality: vec![0.0; n],
+            card_tokens: vec![60.0; n],
+            external: (0..n).map(|i| external.contains(&i)).collect(),
+            node_clusters: vec![NO_INDEX; n],
+            ..SliceGraph::default()
+        }
+    }
+
+    fn request<'a>(starts: &'a [u32], scores: &'a [f64], tokens: &'a [String]) -> BeamRequest<'a> {
+        BeamRequest {
+            start_nodes: starts,
+            start_scores: scores,
+            forced_nodes: &[],
+            entry_nodes: &[],
+            required_entry_coverage: 0,
+            query_tokens: tokens,
+            stack_trace: None,
+            edge_weights: &[1.0, 0.6, 0.8, 0.7],
+            cluster_boost: &[],
+            min_confidence: 0.5,
+            max_cards: 50,
+            max_estimated_tokens: 1e9,
+            record_events: true,
+        }
+    }
+
+    #[test]
+    fn heap_matches_the_typescript_min_heap() {
+        let item = |score: f64, sequence: u32| Item {
+            node: sequence,
+            score,
+            priority: 10,
+            sequence,
+            start: NO_INDEX,
+            from: NO_INDEX,
+            edge_type: 0,
+            edge_weight: 1.0,
+        };
+        let mut heap = Frontier::default();
+        for (seq, score) in [-0.5, -0.9, -0.2, -0.9, -0.7, -0.1].iter().enumerate() {
+            heap.insert(item(*score, seq as u32));
+        }
+        // Same order MinHeap produces for this insertion sequence.
+        let order: Vec<u32> = heap.heap.iter().map(|i| i.sequence).collect();
+        assert_eq!(order, vec![1, 3, 2, 0, 4, 5]);
+        let (worst, _) = heap.find_worst().unwrap();
+        assert_eq!(heap.heap[worst].sequence, 5);
+        heap.replace_at(worst, item(-1.0, 6));
+        assert_eq!(heap.extract_min().unwrap().sequence, 6);
+        assert_eq!(heap.extract_min().unwrap().sequence, 1);
+        assert_eq!(heap.extract_min().unwrap().sequence, 3);
+    }
+
+    #[test]
+    fn expands_from_start_nodes_and_scores_neighbors() {
+        let graph = fan_graph(6, &[]);
+        let tokens = vec!["sym".to_string()];
+        let out = beam_search(&graph, &request(&[0], &[-1.4], &tokens));
+        assert_eq!(out.slice[0], 0);
+        assert_eq!(out.slice.len(), 6);
+        // Neighbours of 0 score by kind specificity: 1 ranks above 2, etc.
+        assert_eq!(out.slice, vec![0, 1, 2, 3, 4, 5]);
+        assert!(out.frontier.is_empty());
+        assert_eq!(out.accepted, 6);
+        assert_eq!(out.events.len(), 6);
+        assert_eq!(out.events[1].from, 0);
+        assert_eq!(out.events[1].edge_type, 0);
+    }
+
+    #[test]
+    fn external_neighbors_are_leaves_and_budget_rolls_back() {
+        let graph = fan_graph(5, &[2]);
+        let tokens = vec!["sym".to_string()];
+        let out = beam_search(&graph, &request(&[0], &[-1.4], &tokens));
+        // 2 is accepted straight away while expanding 0, with score 0.
+        assert_eq!(&out.slice[..2], &[0, 2]);
+        assert_eq!(out.events[1].score, 0.0);
+        assert_eq!(out.events[1].from, NO_INDEX);
+
+        let mut tight = request(&[0], &[-1.4], &tokens);
+        tight.max_estimated_tokens = 150.0;
+        let out = beam_search(&graph, &tight);
+        assert!(out.was_truncated);
+        // 0 (60), then 2 (external, free), then 1 (120); 3 would exceed 150.
+        assert_eq!(out.slice, vec![0, 2, 1]);
+        assert_eq!(out.accepted, 4);
+        assert_eq!(out.dropped_candidates, 1);
+    }
+
+    #[test]
+    fn below_threshold_and_low_confidence_candidates_are_dropped() {
+        let mut graph = fan_graph(4, &[]);
+        graph.confidences[0] = 0.1;
+        let out = beam_search(&graph, &request(&[0], &[-1.4], &[]));
+        // Without query tokens a neighbour scores 0.8·0.15 + kind·0.1 ≈ 0.22,
+        // just over the threshold; 1 is dropped for its edge confidence.
+        assert_eq!(out.slice, vec![0, 2, 3]);
+        assert_eq!(out.dropped_candidates, 1);
+    }
+
+    #[test]
+    fn validates_request_nodes() {
+        let graph = fan_graph(3, &[]);
+        let mut bad = request(&[7], &[-1.0], &[]);
+        assert!(validate_request(&graph, &bad).is_err());
+        bad.start_nodes = &[0, 1];
+        assert!(validate_request(&graph, &bad).is_err());
+        assert!(graph.validate().is_ok());
+    }
+}
@@ -0,0 +1,88 @@
+//! A graph snapshot packed for the native beam search.
+//!
+//! Node IDs are the dense IDs of the snapshot's CSR view. Each row keeps the
+//! TypeScript engine's neighbour order, i.e. first appearance in
+//! `adjacencyOut`, with one entry per target that carries the last edge's type
+//! and confidence. Frontier sequence numbers follow that order, and so do
+//! tie-breaks.
+//!
+//! Scoring inputs that do not depend on the request are computed once, in
+//! TypeScript, when the snapshot is packed: structural and kind specificity,
+//! hotness, centrality signal and the card token estimate. That keeps the
+//! regex-based path rules in one place.
+
+use crate::csr::CsrGraph;
+
+/// Marks a missing file or cluster index.
+pub const NO_INDEX: u32 = u32::MAX;
+
+#[derive(Debug, Default)]
+pub struct SliceGraph {
+    pub offsets: Vec<u32>,
+    pub neighbors: Vec<u32>,
+    /// `CSR_EDGE_TYPES` code per edge; unknown types use any other value.
+    pub edge_types: Vec<u8>,
+    /// Normalised (clamped to `0..=1`) confidence per edge.
+    pub confidences: Vec<f64>,
+    /// Lower-cased symbol name per node.
+    pub names: Vec<String>,
+    /// Index into `file_paths` per node, or [`NO_INDEX`].
+    pub node_files: Vec<u32>,
+    pub range_start_lines: Vec<f64>,
+    pub range_end_lines: Vec<f64>,
+    pub file_paths: Vec<String>,
+    pub file_paths_lower: Vec<String>,
+    pub structure: Vec<f64>,
+    pub kind: Vec<f64>,
+    pub hotness: Vec<f64>,
+    pub centrality: Vec<f64>,
+    pub card_tokens: Vec<f64>,
+    /// External (SCIP) symbols are accepted as leaves and never expanded.
+    pub external: Vec<bool>,
+    /// Cluster index per node, or [`NO_INDEX`].
+    pub node_clusters: Vec<u32>,
+}
+
+impl SliceGraph {
+    pub fn node_count(&self) -> usize {
+        self.names.len()
+    }
+
+    pub fn validate(&self) -> Result<(), String> {
+        let csr = CsrGraph::new(&self.offsets, &self.neighbors, None, Some(&self.edge_types))?;
+        let n = csr.node_count();
+        if self.confidences.len() != csr.edge_count() {
+            return Err("slice graph confidences must have one entry per edge".into());
+        }
+        let per_node = [
+            ("names", self.names.len()),
+            ("node_files", self.node_files.len()),
+            ("range_start_lines", self.range_start_lines.len()),
+            ("range_end_lines", self.range_end_lines.len()),
+            ("structure", self.structure.len()),
+            ("kind", self.kind.len()),
+            ("hotness", self.hotness.len()),
+            ("centrality", self.centrality.len()),
+            ("card_tokens", self.card_tokens.len()),
+            ("external", self.external.len()),
+            ("node_clusters", self.node_clusters.len()),
+        ];
+        if let Some((name, _)) = per_node.iter().find(|(_, len)| *len != n) {
+            return Err(format!("slice graph {name} must have one entry per node"));
+        }
+        if self.file_paths.len() != self.file_paths_lower.len() {
+            return Err("slice graph file path columns differ in length".into());
+        }
+        if self.neighbors.iter().any(|&v| v as usize >= n) {
+            return Err("slice graph neighbor out of range".into());
+        }
+        if self
+            .node_files
+            .iter()
+            .any(|&f| f != NO_INDEX && f as usize >= self.file_paths.len())
+        {
+            return Err("slice graph file index out of range".into());
+        }
+        Ok(())
+    }
+}
@@ -0,0 +1,15 @@
+//! Native slice beam search.
+//!
+//! A [`SliceGraph`] is packed once per graph snapshot. [`beam_search`] then
+//! runs the whole in-memory beam against it: frontier heap, edge-confidence
+//! weighting, scoring, centrality tie-break and the dynamic card cap.
+//! Per-request work crosses napi once instead of once per frontier batch.
+
+pub mod beam;
+pub mod graph;
+pub mod score;
+pub mod types;
+
+pub use beam::{beam_search, validate_request, BeamOutcome, BeamRequest};
+pub use graph::SliceGraph;
+pub use types::{NativeSliceGraphInput, NativeSliceRequest, NativeSliceResult};
@@ -0,0 +1,197 @@
+//! Request-dependent scoring, mirroring `src/graph/score.ts`.
+//!
+//! Arithmetic follows the TypeScript order term for term, so scores are
+//! bit-identical and the beam makes the same decisions in both engines.
+
+use std::collections::HashMap;
+
+use super::graph::{SliceGraph, NO_INDEX};
+
+/// `CENTRALITY_TIEBREAK_EPSILON`.
+const CENTRALITY_TIEBREAK_EPSILON: f64 = 0.001;
+
+/// `calculateQueryOverlapWithFile`.
+pub fn query_overlap(tokens: &[String], name: &str, path: &str) -> f64 {
+    if tokens.is_empty() {
+        return 0.0;
+    }
+    let mut weighted = 0.0;
+    for token in tokens {
+        let token = token.as_str();
+        if name == token {
+            weighted += 1.25;
+        } else if name.starts_with(token) {
+            weighted += 1.0;
+        } else if name.contains(token) {
+            weighted += 0.75;
+        } else if path.contains(token) {
+            weighted += 0.4;
+        }
+    }
+    (weighted / tokens.len() as f64).min(1.0)
+}
+
+/// The number `/:(\d+)(?::(\d+))?/` captures first in `line`, if any.
+fn line_number(line: &str) -> Option<f64> {
+    let bytes = line.as_bytes();
+    for (at, &byte) in bytes.iter().enumerate() {
+        if byte != b':' {
+            continue;
+        }
+        let digits = bytes[at + 1..]
+            .iter()
+            .take_while(|b| b.is_ascii_digit())
+            .count();
+        if digits > 0 {
+            return line[at + 1..at + 1 + digits].parse().ok();
+        }
+    }
+    None
+}
+
+/// Scorer for one request. Stack-trace lookups depend only on the file, so
+/// they are cached per file.
+pub struct Scorer<'a> {
+    graph: &'a SliceGraph,
+    tokens: &'a [String],
+    stack_lines: Option<Vec<&'a str>>,
+    /// File index (or `NO_INDEX`) → the first stack line naming the file,
+    /// reduced to its line number: `None` when no line names it.
+    stack_matches: HashMap<u32, Option<Option<f64>>>,
+}
+
+impl<'a> Scorer<'a> {
+    pub fn new(graph: &'a SliceGraph, tokens: &'a [String], stack_trace: Option<&'a str>) -> Self {
+        Self {
+            graph,
+            tokens,
+            stack_lines: stack_trace
+                .filter(|trace| !trace.is_empty())
+                .map(|trace| trace.split('\n').collect()),
+            stack_matches: HashMap::new(),
+        }
+    }
+
+    /// `calculateStacktraceLocalityWithFile`.
+    fn stack_locality(&mut self, node: usize) -> f64 {
+        let Some(lines) = &self.stack_lines else {
+            return 0.0;
+        };
+        let file = self.graph.node_files[node];
+        let path = if file == NO_INDEX {
+            ""
+        } else {
+            self.graph.file_paths[file as usize].as_str()
+        };
+        let matched = *self.stack_matches.entry(file).or_insert_with(|| {
+            lines
+                .iter()
+                .find(|line| line.contains(path))
+                .map(|line| line_number(line))
+        });
+        match matched {
+            None => 0.0,
+            Some(Some(line))
+                if line >= self.graph.range_start_lines[node]
+                    && line <= self.graph.range_end_lines[node] =>
+            {
+                1.0
+            }
+            Some(_) => 0.5,
+        }
+    }
+
+    /// `scoreSymbolWithMetrics`: the weighted mean of the five factors.
+    pub fn primary_score(&mut self, node: usize) -> f64 {
+        let graph = self.graph;
+        let file = graph.node_files[node];
+        let path = if file == NO_INDEX {
+            ""
+        } else {
+            graph.file_paths_lower[file as usize].as_str()
+        };
+        let query = query_overlap(self.tokens, &graph.names[node], path);
+        let stacktrace = self.stack_locality(node);
+
+        let mut total = 0.0;
+        let mut weight = 0.0;
+        for (score, w) in [
+            (query, 0.4),
+            (stacktrace, 0.2),
+            (graph.structure[node], 0.15),
+            (graph.kind[node], 0.1),
+            (graph.hotness[node], 0.15),
+        ] {
+            total += score * w;
+            weight += w;
+        }
+        if weight > 0.0 {
+            total / weight
+        } else {
+            0.0
+        }
+    }
+}
+
+/// `applyCentralityTiebreak`.
+pub fn apply_centrality_tiebreak(score: f64, centrality: f64) -> f64 {
+    if !centrality.is_finite() || centrality <= 0.0 {
+        return score;
+    }
+    score + CENTRALITY_TIEBREAK_EPSILON * centrality.min(1.0)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn tokens(values: &[&str]) -> Vec<String> {
+        values.iter().map(|s| s.to_string()).collect()
+    }
+
+    #[test]
+    fn query_overlap_weights_match_kinds() {
+        let t = tokens(&["parse", "file", "src", "zzz"]);
+        // parse: prefix (1.0), file: contained (0.75), src: path (0.4), zzz: none.
+        let score = query_overlap(&t, "parsefile", "src/parser.ts");
+        assert_eq!(score, (1.0 + 0.75 + 0.4) / 4.0);
+        assert_eq!(query_overlap(&tokens(&["a"]), "a", ""), 1.0);
+        assert_eq!(query_overlap(&[], "a", ""), 0.0);
+    }
+
+    #[test]
+    fn line_numbers_follow_the_regex() {
+        assert_eq!(line_number("at f (src/a.ts:12:5)"), Some(12.0));
+        assert_eq!(line_number("C:\\x\\a.ts:7"), Some(7.0));
+        assert_eq!(line_number("no numbers: here"), None);
+        assert_eq!(line_number(":007"), Some(7.0));
+    }
+
+    #[test]
+    fn stack_locality_uses_the_first_line_naming_the_file() {
+        let graph = SliceGraph {
+            names: vec!["a".into(), "b".into(), "c".into()],
+            node_files: vec![0, 0, NO_INDEX],
+            range_start_lines: vec![10.0, 30.0, 1.0],
+            range_end_lines: vec![20.0, 40.0, 2.0],
+            file_paths: vec!["src/a.ts".into()],
+            file_paths_lower: vec!["src/a.ts".into()],
+            ..SliceGraph::default()
+        };
+        let trace = "Error\n  at f (src/a.ts:15:3)\n  at g (src/a.ts:35:1)";
+        let mut scorer = Scorer::new(&graph, &[], Some(trace));
+        assert_eq!(scorer.stack_locality(0), 1.0);
+        assert_eq!(scorer.stack_locality(1), 0.5);
+        // No file: "" is in every line, and the first has no line number.
+        assert_eq!(scorer.stack_locality(2), 0.5);
+        let mut none = Scorer::new(&graph, &[], Some(""));
+        assert_eq!(none.stack_locality(0), 0.0);
+    }
+
+    #[test]
+    fn tiebreak_is_bounded() {
+        assert_eq!(apply_centrality_tiebreak(0.5, 0.0), 0.5);
+        assert_eq!(apply_centrality_tiebreak(0.5, f64::NAN), 0.5);
+        assert_eq!(apply_centrality_tiebreak(0.5, 3.0), 0.5 + 0.001);
+    }
+}
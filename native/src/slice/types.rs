@@ -0,0 +1,77 @@
+use napi::bindgen_prelude::{Float64Array, Uint32Array, Uint8Array};
+use napi_derive::napi;
+
+/// A graph snapshot packed for `sliceGraphBuild`. Per-edge columns follow
+/// `offsets`; per-node columns have one entry per node; file and cluster
+/// indexes are `0xFFFFFFFF` when absent.
+#[napi(object)]
+pub struct NativeSliceGraphInput {
+    pub offsets: Uint32Array,
+    pub neighbors: Uint32Array,
+    pub edge_types: Uint8Array,
+    pub confidences: Float64Array,
+    /// Lower-cased symbol names.
+    pub names: Vec<String>,
+    pub node_files: Uint32Array,
+    pub range_start_lines: Float64Array,
+    pub range_end_lines: Float64Array,
+    pub file_paths: Vec<String>,
+    pub file_paths_lower: Vec<String>,
+    pub structure: Float64Array,
+    pub kind: Float64Array,
+    pub hotness: Float64Array,
+    pub centrality: Float64Array,
+    pub card_tokens: Float64Array,
+    pub external: Uint8Array,
+    pub node_clusters: Uint32Array,
+}
+
+#[napi(object)]
+pub struct NativeSliceRequest {
+    pub start_nodes: Uint32Array,
+    pub start_scores: Float64Array,
+    pub forced_nodes: Uint32Array,
+    pub entry_nodes: Uint32Array,
+    pub required_entry_coverage: u32,
+    pub query_tokens: Vec<String>,
+    pub stack_trace: Option<String>,
+    /// Base weight per edge type code.
+    pub edge_weights: Float64Array,
+    /// Cohesion boost per cluster index; empty disables cohesion.
+    pub cluster_boost: Float64Array,
+    pub min_confidence: f64,
+    pub max_cards: u32,
+    pub max_estimated_tokens: f64,
+    /// Return the accept/evict/reject trace in the `event*` columns.
+    pub record_events: bool,
+}
+
+/// Beam result. Frontier entries are in heap-array order; `frontierStarts`
+/// is the start-node index of seeded entries (`0xFFFFFFFF` otherwise) and
+/// `frontierEdgeTypes` the edge type of the others (255 for seeded).
+/// Event columns are empty unless `recordEvents` was set; event kinds are
+/// 0 accept, 1 evict, 2 reject.
+#[napi(object)]
+pub struct NativeSliceResult {
+    pub slice_nodes: Uint32Array,
+    pub frontier_nodes: Uint32Array,
+    pub frontier_scores: Float64Array,
+    pub frontier_priorities: Uint8Array,
+    pub frontier_sequences: Uint32Array,
+    pub frontier_starts: Uint32Array,
+    pub frontier_edge_types: Uint8Array,
+    pub was_truncated: bool,
+    pub dropped_candidates: u32,
+    pub max_frontier_size: u32,
+    pub accepted: u32,
+    pub evicted: u32,
+    pub rejected: u32,
+    pub event_kinds: Uint8Array,
+    pub event_nodes: Uint32Array,
+    pub event_scores: Float64Array,
+    pub event_from: Uint32Array,
+    pub event_edge_types: Uint8Array,
+    pub event_edge_weights: Float64Array,
+    pub event_iterations: Uint32Array,
+    pub event_causes: Uint8Array,
+}
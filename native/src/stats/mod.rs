@@ -0,0 +1,414 @@
+//! Always-on latency histograms and trace spans for native hot paths.
+//!
+//! Every thread that records gets its own [`ThreadSlot`]: one log-linear
+//! histogram per [`Phase`] plus a small ring of recent spans. Only the owning
+//! thread writes to a slot, so recording is a handful of relaxed atomic
+//! loads and stores with no lock and no read-modify-write. Slots are
+//! registered once per thread and retired when the thread exits (the only
+//! locks on the write side): retiring folds the slot's histograms into a
+//! process-wide aggregate and frees the slot, so counts survive a parse-pool
+//! rebuild without the pool's old threads keeping their slots alive. Spans of
+//! exited threads are dropped with their slot.
+//!
+//! [`snapshot`] sums the retired aggregate and every live slot. A snapshot
+//! taken while workers are recording may miss their latest samples, and span
+//! reads can see a cell that is being overwritten; both are acceptable for
+//! monitoring.
+//!
+//! The bucket layout (microseconds, 32 linear sub-buckets per power of two,
+//! ~3% relative error) is mirrored by `src/observability/latency-histogram.ts`
+//! so the TypeScript side can merge native histograms with its own.
+
+pub mod types;
+
+use std::cell::OnceCell;
+use std::sync::atomic::{AtomicBool, AtomicU32, AtomicU64, Ordering};
+use std::sync::{Arc, Mutex, OnceLock};
+use std::time::{Instant, SystemTime, UNIX_EPOCH};
+
+use types::{NativePhaseHistogram, NativePhaseSpan};
+
+/// log2 of the linear sub-buckets per power of two.
+pub const SUB_BUCKET_BITS: u32 = 5;
+const SUB_BUCKETS: u64 = 1 << SUB_BUCKET_BITS;
+/// Largest exponent; values from 2^37 µs (~38 h) up share the last bucket.
+const MAX_EXPONENT: u32 = 31;
+/// Buckets per histogram.
+pub const BUCKET_COUNT: usize = (MAX_EXPONENT as usize + 2) * SUB_BUCKETS as usize;
+/// Recent spans kept per thread for trace dumps.
+const SPAN_CAPACITY: usize = 2048;
+
+/// Native phases with their own histogram.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+#[repr(u8)]
+pub enum Phase {
+    /// One whole file in `parse_files_parallel` and its streaming variants.
+    ParseFile = 0,
+    ReadFile = 1,
+    TreeSitter = 2,
+    ExtractSymbols = 3,
+    /// Summary, invariant, side-effect, role and search-text enrichment.
+    Enrich = 4,
+    /// Import and call extraction.
+    ExtractRefs = 5,
+}
+
+pub const PHASE_COUNT: usize = 6;
+
+impl Phase {
+    pub const ALL: [Phase; PHASE_COUNT] = [
+        Phase::ParseFile,
+        Phase::ReadFile,
+        Phase::TreeSitter,
+        Phase::ExtractSymbols,
+        Phase::Enrich,
+        Phase::ExtractRefs,
+    ];
+
+    pub fn name(self) -> &'static str {
+        match self {
+            Phase::ParseFile => "native.parseFile",
+            Phase::ReadFile => "native.readFile",
+            Phase::TreeSitter => "native.treeSitter",
+            Phase::ExtractSymbols => "native.extractSymbols",
+            Phase::Enrich => "native.enrich",
+            Phase::ExtractRefs => "native.extractRefs",
+        }
+    }
+}
+
+/// Histogram bucket for a latency in microseconds.
+pub fn bucket_index(micros: u64) -> usize {
+    let msb = 63 - micros.max(1).leading_zeros();
+    let exponent = msb.saturating_sub(SUB_BUCKET_BITS).min(MAX_EXPONENT);
+    let mantissa = (micros >> exponent).min(2 * SUB_BUCKETS - 1);
+    (exponent as u64 * SUB_BUCKETS + mantissa) as usize
+}
+
+struct SpanCell {
+    phase: AtomicU32,
+    start_micros: AtomicU64,
+    duration_micros: AtomicU64,
+}
+
+struct ThreadSlot {
+    thread_id: u32,
+    thread_name: String,
+    counts: Box<[AtomicU64]>,
+    totals: [AtomicU64; PHASE_COUNT],
+    maxes: [AtomicU64; PHASE_COUNT],
+    spans: Box<[SpanCell]>,
+    /// Spans written so far; the ring holds the last `SPAN_CAPACITY`.
+    span_head: AtomicU64,
+}
+
+impl ThreadSlot {
+    fn new(thread_id: u32, thread_name: String) -> Self {
+        Self {
+            thread_id,
+            thread_name,
+            counts: (0..PHASE_COUNT * BUCKET_COUNT)
+                .map(|_| AtomicU64::new(0))
+                .collect(),
+            totals: std::array::from_fn(|_| AtomicU64::new(0)),
+            maxes: std::array::from_fn(|_| AtomicU64::new(0)),
+            spans: (0..SPAN_CAPACITY)
+                .map(|_| SpanCell {
+                    phase: AtomicU32::new(0),
+                    start_micros: AtomicU64::new(0),
+                    duration_micros: AtomicU64::new(0),
+                })
+                .collect(),
+            span_head: AtomicU64::new(0),
+        }
+    }
+
+    /// Owner-thread only: single-writer increments need no RMW.
+    fn record(&self, phase: Phase, start_micros: u64, micros: u64) {
+        let p = phase as usize;
+        bump(&self.counts[p * BUCKET_COUNT + bucket_index(micros)], 1);
+        bump(&self.totals[p], micros);
+        if micros > self.maxes[p].load(Ordering::Relaxed) {
+            self.maxes[p].store(micros, Ordering::Relaxed);
+        }
+
+        let head = self.span_head.load(Ordering::Relaxed);
+        let cell = &self.spans[(head % SPAN_CAPACITY as u64) as usize];
+        cell.phase.store(p as u32, Ordering::Relaxed);
+        cell.start_micros.store(start_micros, Ordering::Relaxed);
+        cell.duration_micros.store(micros, Ordering::Relaxed);
+        self.span_head.store(head + 1, Ordering::Release);
+    }
+}
+
+/// Histograms of threads that have exited.
+struct Retired {
+    /// Empty until the first slot retires.
+    counts: Vec<u64>,
+    totals: [u64; PHASE_COUNT],
+    maxes: [u64; PHASE_COUNT],
+}
+
+impl Retired {
+    fn absorb(&mut self, slot: &ThreadSlot) {
+        if self.counts.is_empty() {
+            self.counts = vec![0; PHASE_COUNT * BUCKET_COUNT];
+        }
+        for (sum, cell) in self.counts.iter_mut().zip(slot.counts.iter()) {
+            *sum += cell.load(Ordering::Relaxed);
+        }
+        for p in 0..PHASE_COUNT {
+            self.totals[p] += slot.totals[p].load(Ordering::Relaxed);
+            self.maxes[p] = self.maxes[p].max(slot.maxes[p].load(Ordering::Relaxed));
+        }
+    }
+}
+
+struct Registry {
+    live: Vec<Arc<ThreadSlot>>,
+    retired: Retired,
+}
+
+/// Owned by the thread-local; retires the slot when the thread exits.
+struct SlotGuard(Arc<ThreadSlot>);
+
+impl Drop for SlotGuard {
+    fn drop(&mut self) {
+        let mut registry = registry();
+        registry.live.retain(|live| !Arc::ptr_eq(live, &self.0));
+        registry.retired.absorb(&self.0);
+    }
+}
+
+fn bump(cell: &AtomicU64, by: u64) {
+    cell.store(
+        cell.load(Ordering::Relaxed).wrapping_add(by),
+        Ordering::Relaxed,
+    );
+}
+
+static ENABLED: AtomicBool = AtomicBool::new(true);
+static NEXT_THREAD_ID: AtomicU32 = AtomicU32::new(1);
+static REGISTRY: Mutex<Registry> = Mutex::new(Registry {
+    live: Vec::new(),
+    retired: Retired {
+        counts: Vec::new(),
+        totals: [0; PHASE_COUNT],
+        maxes: [0; PHASE_COUNT],
+    },
+});
+/// (monotonic anchor, wall-clock microseconds at that anchor)
+static CLOCK_ANCHOR: OnceLock<(Instant, u64)> = OnceLock::new();
+
+thread_local! {
+    static SLOT: OnceCell<SlotGuard> = const { OnceCell::new() };
+}
+
+fn clock_anchor() -> &'static (Instant, u64) {
+    CLOCK_ANCHOR.get_or_init(|| {
+        let epoch = SystemTime::now()
+            .duration_since(UNIX_EPOCH)
+            .map(|d| d.as_micros() as u64)
+            .unwrap_or(0);
+        (Instant::now(), epoch)
+    })
+}
+
+fn registry() -> std::sync::MutexGuard<'static, Registry> {
+    REGISTRY.lock().unwrap_or_else(|e| e.into_inner())
+}
+
+fn register_slot() -> SlotGuard {
+    let current = std::thread::current();
+    let thread_id = NEXT_THREAD_ID.fetch_add(1, Ordering::Relaxed);
+    let name = current
+        .name()
+        .map(str::to_string)
+        .unwrap_or_else(|| format!("native-{thread_id}"));
+    let slot = Arc::new(ThreadSlot::new(thread_id, name));
+    registry().live.push(Arc::clone(&slot));
+    SlotGuard(slot)
+}
+
+/// Turn recording on or off process-wide. On by default.
+pub fn set_enabled(enabled: bool) {
+    ENABLED.store(enabled, Ordering::Relaxed);
+}
+
+pub fn is_enabled() -> bool {
+    ENABLED.load(Ordering::Relaxed)
+}
+
+/// Start timing a phase; `None` while recording is disabled.
+#[inline]
+pub fn start() -> Option<Instant> {
+    if is_enabled() {
+        Some(Instant::now())
+    } else {
+        None
+    }
+}
+
+/// Record `phase` as running from `started` until now on this thread.
+#[inline]
+pub fn record(phase: Phase, started: Option<Instant>) {
+    let Some(started) = started else { return };
+    let now = Instant::now();
+    let micros = now.duration_since(started).as_micros() as u64;
+    let (anchor, anchor_epoch) = clock_anchor();
+    let start_micros =
+        anchor_epoch.saturating_add(started.saturating_duration_since(*anchor).as_micros() as u64);
+    // Fails only while this thread's locals are being destroyed.
+    let _ = SLOT.try_with(|cell| {
+        cell.get_or_init(register_slot)
+            .0
+            .record(phase, start_micros, micros);
+    });
+}
+
+/// Per-phase histograms summed over every thread. Phases with no samples
+/// are omitted; bucket counts are sparse (index, count) columns.
+pub fn snapshot() -> Vec<NativePhaseHistogram> {
+    let registry = registry();
+    let retired = &registry.retired;
+    let mut out = Vec::new();
+    for phase in Phase::ALL {
+        let p = phase as usize;
+        let mut buckets = if retired.counts.is_empty() {
+            vec![0u64; BUCKET_COUNT]
+        } else {
+            retired.counts[p * BUCKET_COUNT..(p + 1) * BUCKET_COUNT].to_vec()
+        };
+        let mut total = retired.totals[p];
+        let mut max = retired.maxes[p];
+        for slot in &registry.live {
+            let row = &slot.counts[p * BUCKET_COUNT..(p + 1) * BUCKET_COUNT];
+            for (sum, cell) in buckets.iter_mut().zip(row) {
+                *sum += cell.load(Ordering::Relaxed);
+            }
+            total += slot.totals[p].load(Ordering::Relaxed);
+            max = max.max(slot.maxes[p].load(Ordering::Relaxed));
+        }
+        let count: u64 = buckets.iter().sum();
+        if count == 0 {
+            continue;
+        }
+        let mut bucket_indices = Vec::new();
+        let mut bucket_counts = Vec::new();
+        for (index, &n) in buckets.iter().enumerate() {
+            if n > 0 {
+                bucket_indices.push(index as u32);
+                bucket_counts.push(n as f64);
+            }
+        }
+        out.push(NativePhaseHistogram {
+            phase: phase.name().to_string(),
+            count: count as f64,
+            total_micros: total as f64,
+            max_micros: max as f64,
+            bucket_indices,
+            bucket_counts,
+        });
+    }
+    out
+}
+
+/// Spans that started at or after `since_micros` (wall clock), per thread
+/// oldest first, from each thread's ring of recent spans.
+pub fn spans_since(since_micros: u64) -> Vec<NativePhaseSpan> {
+    let mut out = Vec::new();
+    for slot in &registry().live {
+        let head = slot.span_head.load(Ordering::Acquire);
+        let first = head.saturating_sub(SPAN_CAPACITY as u64);
+        for i in first..head {
+            let cell = &slot.spans[(i % SPAN_CAPACITY as u64) as usize];
+            let start = cell.start_micros.load(Ordering::Relaxed);
+            if start < since_micros {
+                continue;
+            }
+            let Some(phase) = Phase::ALL
+                .get(cell.phase.load(Ordering::Relaxed) as usize)
+                .copied()
+            else {
+                continue;
+            };
+            out.push(NativePhaseSpan {
+                phase: phase.name().to_string(),
+                thread_id: slot.thread_id,
+                thread_name: slot.thread_name.clone(),
+                start_micros: start as f64,
+                duration_micros: cell.duration_micros.load(Ordering::Relaxed) as f64,
+            });
+        }
+    }
+    out
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn buckets_are_contiguous_and_monotonic() {
+        assert_eq!(bucket_index(0), 0);
+        assert_eq!(bucket_index(63), 63);
+        assert_eq!(bucket_index(64), 64);
+        assert_eq!(bucket_index(127), 95);
+        assert_eq!(bucket_index(128), 96);
+        let mut last = 0;
+        for v in (0..1_000_000u64).step_by(97) {
+            let b = bucket_index(v);
+            assert!(b >= last);
+            last = b;
+        }
+        assert_eq!(bucket_index(u64::MAX), BUCKET_COUNT - 1);
+    }
+
+    #[test]
+    fn exited_threads_fold_into_the_snapshot_and_free_their_slot() {
+        let phase_count = || {
+            snapshot()
+                .into_iter()
+                .find(|h| h.phase == "native.enrich")
+                .map_or(0.0, |h| h.count)
+        };
+        let before = phase_count();
+        let slot = std::thread::spawn(|| {
+            for _ in 0..5 {
+                record(Phase::Enrich, start());
+            }
+            SLOT.with(|cell| Arc::downgrade(&cell.get().expect("slot").0))
+        })
+        .join()
+        .expect("worker");
+        assert!(slot.upgrade().is_none());
+        assert!(phase_count() - before >= 5.0);
+    }
+
+    #[test]
+    fn records_from_worker_threads_show_up_in_snapshot() {
+        let before = snapshot()
+            .into_iter()
+            .find(|h| h.phase == "native.extractRefs")
+            .map_or(0.0, |h| h.count);
+        std::thread::scope(|scope| {
+            for _ in 0..4 {
+                scope.spawn(|| {
+                    for _ in 0..10 {
+                        record(Phase::ExtractRefs, start());
+                    }
+                });
+            }
+        });
+        let after = snapshot()
+            .into_iter()
+            .find(|h| h.phase == "native.extractRefs")
+            .expect("phase recorded");
+        // Parse tests running alongside may add samples of their own.
+        assert!(after.count - before >= 40.0);
+        assert_eq!(after.bucket_indices.len(), after.bucket_counts.len());
+        assert!(spans_since(0)
+            .iter()
+            .any(|span| span.phase == "native.extractRefs"));
+    }
+}
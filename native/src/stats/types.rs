@@ -0,0 +1,29 @@
+//! Napi-rs payload types for the native phase statistics exports.
+
+use napi_derive::napi;
+
+/// One phase's latency histogram summed over every native thread.
+#[napi(object)]
+#[derive(Debug, Clone)]
+pub struct NativePhaseHistogram {
+    pub phase: String,
+    pub count: f64,
+    pub total_micros: f64,
+    pub max_micros: f64,
+    /// Non-empty bucket indices in the shared log-linear layout.
+    pub bucket_indices: Vec<u32>,
+    /// Sample count of the bucket at the same position in `bucket_indices`.
+    pub bucket_counts: Vec<f64>,
+}
+
+/// One recorded phase span, for trace dumps.
+#[napi(object)]
+#[derive(Debug, Clone)]
+pub struct NativePhaseSpan {
+    pub phase: String,
+    pub thread_id: u32,
+    pub thread_name: String,
+    /// Wall-clock start in microseconds since the Unix epoch.
+    pub start_micros: f64,
+    pub duration_micros: f64,
+}
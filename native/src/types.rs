@@ -162,8 +162,144 @@ pub struct NativeParsedFile {
     pub parse_error: Option<String>,
 }
 
+/// Parse results with symbols moved into one columnar buffer (see
+/// `parse::packed` for the layout). `files[i].symbols` is empty; its symbols
+/// are the next `symbol_counts[i]` rows of `symbols`.
+#[napi(object)]
+pub struct NativePackedParseBatch {
+    /// Parse results in input order, without symbols.
+    pub files: Vec<NativeParsedFile>,
+    /// Number of packed symbols belonging to each entry of `files`.
+    pub symbol_counts: Vec<u32>,
+    /// Packed symbol columns and string data.
+    pub symbols: napi::bindgen_prelude::Buffer,
+}
+
+/// Options for `scanRepositoryFilesAsync`.
+#[napi(object)]
+#[derive(Debug, Clone)]
+pub struct NativeScanOptions {
+    /// File-name suffixes to keep (e.g. `[".ts", ".tsx"]`).
+    pub include_extensions: Vec<String>,
+    /// Glob patterns to exclude, relative to the scan root.
+    pub ignore_patterns: Vec<String>,
+    /// Drop files larger than this many bytes.
+    pub max_file_bytes: Option<f64>,
+    /// Walker threads (0 = automatic).
+    pub thread_count: u32,
+}
+
+/// A file found by `scanRepositoryFilesAsync`.
+#[napi(object)]
+#[derive(Debug, Clone)]
+pub struct NativeScannedFile {
+    /// Relative path from the scan root (forward slashes).
+    pub rel_path: String,
+    /// File size in bytes.
+    pub size: f64,
+    /// Modification time in milliseconds since the Unix epoch.
+    pub mtime_ms: f64,
+    /// Inode number on Unix, 0 elsewhere. Part of the parse cache key so a
+    /// file replaced by another with the same size and mtime still misses.
+    pub inode: f64,
+}
+
+/// A file to hash with `hashFilesAsync`.
+#[napi(object)]
+#[derive(Debug, Clone)]
+pub struct NativeFileHashInput {
+    /// Absolute path on disk.
+    pub absolute_path: String,
+    /// The file's stored fast digest, if any. While the file still hashes to
+    /// it, SHA-256 is not computed.
+    pub known_fast_hash: Option<String>,
+}
+
+/// Digests of one file from `hashFilesAsync`, both over its raw bytes.
+#[napi(object)]
+#[derive(Debug, Clone)]
+pub struct NativeFileHash {
+    /// Fast digest (algorithm named by `contentFastHashAlgorithm()`).
+    pub content_fast_hash: Option<String>,
+    /// SHA-256 hex digest. `None` when the fast digest matched
+    /// `known_fast_hash`, and when the file could not be read.
+    pub content_hash: Option<String>,
+    /// Read error, when the file could not be hashed.
+    pub error: Option<String>,
+}
+
+/// Configuration and lifetime counters of the process-wide parse engine.
+#[napi(object)]
+#[derive(Debug, Clone)]
+pub struct NativeParseEngineStatus {
+    /// Worker threads in the current pool (0 when no pool is alive).
+    pub thread_count: u32,
+    /// Number of times a pool was built (first use + each resize).
+    pub pool_builds: u32,
+    /// Number of `parse_files*` batches completed.
+    pub batches_parsed: u32,
+    /// Number of files parsed across all batches.
+    pub files_parsed: u32,
+    /// Current AST fingerprint mode ("native" or "ts-compat").
+    pub ast_fingerprint_mode: String,
+}
+
+/// One buffer edit, applied in order against the previously parsed content
+/// of the same draft. Offsets are UTF-8 byte offsets.
+#[napi(object)]
+#[derive(Debug, Clone)]
+pub struct NativeTextEdit {
+    /// Start of the replaced range.
+    pub start_byte: u32,
+    /// End (exclusive) of the replaced range, before the edit.
+    pub old_end_byte: u32,
+    /// Replacement text.
+    pub text: String,
+}
+
+/// Input for an incremental draft re-parse.
+#[napi(object)]
+#[derive(Debug, Clone)]
+pub struct NativeIncrementalParseInput {
+    /// Repository identifier.
+    pub repo_id: String,
+    /// Relative path from repo root (forward slashes).
+    pub rel_path: String,
+    /// Language identifier (e.g., "ts", "cpp").
+    pub language: String,
+    /// Full current buffer content.
+    pub content: String,
+    /// Optional edits that transform the previously parsed content into
+    /// `content`. When absent or inconsistent, the changed region is derived
+    /// from the two contents instead.
+    pub edits: Option<Vec<NativeTextEdit>>,
+}
+
+/// Result of an incremental draft re-parse.
+#[napi(object)]
+#[derive(Debug, Clone)]
+pub struct NativeIncrementalParseResult {
+    /// Parse result for the whole file. `content` is always `None`; the
+    /// caller already holds the buffer.
+    pub file: NativeParsedFile,
+    /// Whether the previous tree for this draft was reused.
+    pub reused_tree: bool,
+    /// First changed line (1-indexed, new content); 0 when nothing changed.
+    pub changed_start_line: u32,
+    /// Last changed line (1-indexed, new content); 0 when nothing changed.
+    pub changed_end_line: u32,
+    /// Symbols whose enrichment was carried over from the previous parse.
+    pub symbols_reused: u32,
+    /// Symbols whose enrichment was recomputed.
+    pub symbols_enriched: u32,
+    /// Symbols extracted from re-parsed declarations; the rest were carried
+    /// over from the previous parse.
+    pub symbols_extracted: u32,
+}
+
 // Cluster + process analysis types (see native/src/cluster/types.rs, native/src/process/types.rs)
 pub use crate::cluster::types::{NativeClusterAssignment, NativeClusterEdge, NativeClusterSymbol};
 pub use crate::process::types::{
-    NativeProcess, NativeProcessCallEdge, NativeProcessStep, NativeProcessSymbol,
+    NativeCsrProcessTraces, NativeProcess, NativeProcessCallEdge, NativeProcessStep,
+    NativeProcessSymbol,
 };
@@ -0,0 +1,361 @@
+//! Inverted-file (IVF) partitioning and search.
+//!
+//! Training is spherical k-means over unit vectors: centroids start at
+//! evenly spaced rows, refine on an evenly strided sample of at most
+//! `SAMPLE_PER_LIST` rows per list, and are re-normalised after each pass.
+//! Everything is index-ordered, so the same vectors always produce the same
+//! file.
+
+use std::cmp::Ordering;
+use std::collections::BinaryHeap;
+
+use rayon::prelude::*;
+
+use super::simd::{dot_f32, dot_i8, normalize, quantize};
+
+/// Below this many rows a single list (an exhaustive int8 scan) is as fast
+/// as any partition.
+pub const FLAT_MAX_ROWS: usize = 4096;
+pub const DEFAULT_ITERATIONS: usize = 8;
+const SAMPLE_PER_LIST: usize = 64;
+const MAX_LISTS: usize = 65_536;
+/// Lists probed when the caller passes 0: a sixteenth, but at least this many.
+const MIN_DEFAULT_PROBES: usize = 8;
+
+pub fn default_lists(rows: usize) -> usize {
+    if rows <= FLAT_MAX_ROWS {
+        1
+    } else {
+        ((rows as f64).sqrt().round() as usize).clamp(1, MAX_LISTS)
+    }
+}
+
+pub fn default_probes(lists: usize) -> usize {
+    lists.div_ceil(16).max(MIN_DEFAULT_PROBES).min(lists)
+}
+
+fn nearest(vector: &[f32], centroids: &[f32], dim: usize) -> u32 {
+    let mut best = 0u32;
+    let mut best_score = f32::NEG_INFINITY;
+    for (list, centroid) in centroids.chunks_exact(dim).enumerate() {
+        let score = dot_f32(vector, centroid);
+        if score > best_score {
+            best_score = score;
+            best = list as u32;
+        }
+    }
+    best
+}
+
+/// Rows grouped by list: slot `s` holds original row `order[s]`, and list
+/// `l` covers slots `offsets[l]..offsets[l + 1]`.
+pub struct Partition {
+    pub centroids: Vec<f32>,
+    pub offsets: Vec<u32>,
+    pub order: Vec<u32>,
+}
+
+/// Partition unit-length `vectors` (`dim` floats per row) into `lists` lists.
+pub fn train(vectors: &[f32], dim: usize, lists: usize, iterations: usize) -> Partition {
+    let rows = if dim == 0 { 0 } else { vectors.len() / dim };
+    let lists = lists.clamp(1, rows.max(1));
+    let row = |r: usize| &vectors[r * dim..(r + 1) * dim];
+
+    let mut centroids = vec![0.0f32; lists * dim];
+    if rows > 0 {
+        for list in 0..lists {
+            centroids[list * dim..(list + 1) * dim].copy_from_slice(row(list * rows / lists));
+        }
+    }
+    if lists > 1 {
+        let stride = (rows / (lists * SAMPLE_PER_LIST)).max(1);
+        let sample: Vec<usize> = (0..rows).step_by(stride).collect();
+        for _ in 0..iterations {
+            let assigned: Vec<u32> = sample
+                .par_iter()
+                .map(|&r| nearest(row(r), &centroids, dim))
+                .collect();
+            let mut sums = vec![0.0f32; lists * dim];
+            let mut counts = vec![0usize; lists];
+            for (&r, &list) in sample.iter().zip(&assigned) {
+                let list = list as usize;
+                counts[list] += 1;
+                for (sum, value) in sums[list * dim..(list + 1) * dim].iter_mut().zip(row(r)) {
+                    *sum += value;
+                }
+            }
+            for list in 0..lists {
+                // An emptied list keeps its centroid rather than collapsing.
+                if counts[list] == 0 {
+                    continue;
+                }
+                let sum = &mut sums[list * dim..(list + 1) * dim];
+                normalize(sum);
+                centroids[list * dim..(list + 1) * dim].copy_from_slice(sum);
+            }
+        }
+    }
+
+    let all: Vec<usize> = (0..rows).collect();
+    let assigned: Vec<u32> = if lists > 1 {
+        all.par_iter()
+            .map(|&r| nearest(row(r), &centroids, dim))
+            .collect()
+    } else {
+        vec![0; rows]
+    };
+    let mut offsets = vec![0u32; lists + 1];
+    for &list in &assigned {
+        offsets[list as usize + 1] += 1;
+    }
+    for list in 0..lists {
+        offsets[list + 1] += offsets[list];
+    }
+    let mut cursor = offsets.clone();
+    let mut order = vec![0u32; rows];
+    for (r, &list) in assigned.iter().enumerate() {
+        order[cursor[list as usize] as usize] = r as u32;
+        cursor[list as usize] += 1;
+    }
+    Partition {
+        centroids,
+        offsets,
+        order,
+    }
+}
+
+/// Borrowed view of a built index; `codes` and `scales` are in slot order.
+pub struct IvfView<'a> {
+    pub dim: usize,
+    pub centroids: &'a [f32],
+    pub offsets: &'a [u32],
+    pub scales: &'a [f32],
+    pub codes: &'a [i8],
+}
+
+#[derive(Clone, Copy, Debug, PartialEq)]
+pub struct Hit {
+    pub slot: u32,
+    pub score: f32,
+}
+
+impl Eq for Hit {}
+
+/// "Greater" means worse, so a `BinaryHeap<Hit>` keeps the worst kept hit on
+/// top and `into_sorted_vec` lists the best first. Ties go to the lower slot.
+impl Ord for Hit {
+    fn cmp(&self, other: &Self) -> Ordering {
+        other
+            .score
+            .total_cmp(&self.score)
+            .then(self.slot.cmp(&other.slot))
+    }
+}
+
+impl PartialOrd for Hit {
+    fn partial_cmp(&self, other: &Self) -> Option<Ordering> {
+        Some(self.cmp(other))
+    }
+}
+
+fn push_bounded(heap: &mut BinaryHeap<Hit>, hit: Hit, k: usize) {
+    if heap.len() < k {
+        heap.push(hit);
+    } else if heap.peek().is_some_and(|worst| hit < *worst) {
+        heap.pop();
+        heap.push(hit);
+    }
+}
+
+impl IvfView<'_> {
+    pub fn lists(&self) -> usize {
+        self.offsets.len() - 1
+    }
+
+    /// Top `k` slots by approximate cosine similarity to `query`, scanning
+    /// the `probes` lists whose centroids are closest (0 = default).
+    pub fn search(&self, query: &[f32], k: usize, probes: usize) -> Vec<Hit> {
+        let lists = self.lists();
+        if k == 0 || self.scales.is_empty() {
+            return Vec::new();
+        }
+        let mut query = query.to_vec();
+        normalize(&mut query);
+        let probes = if probes == 0 {
+            default_probes(lists)
+        } else {
+            probes.min(lists)
+        };
+
+        let probed: Vec<u32> = if probes >= lists {
+            (0..lists as u32).collect()
+        } else {
+            let mut ranked: BinaryHeap<Hit> = BinaryHeap::with_capacity(probes + 1);
+            for (list, centroid) in self.centroids.chunks_exact(self.dim).enumerate() {
+                let hit = Hit {
+                    slot: list as u32,
+                    score: dot_f32(&query, centroid),
+                };
+                push_bounded(&mut ranked, hit, probes);
+            }
+            ranked.into_vec().into_iter().map(|hit| hit.slot).collect()
+        };
+
+        let mut codes = vec![0i8; self.dim];
+        let query_scale = quantize(&query, &mut codes);
+        let partial: Vec<BinaryHeap<Hit>> = probed
+            .par_iter()
+            .map(|&list| {
+                let mut heap = BinaryHeap::with_capacity(k + 1);
+                let start = self.offsets[list as usize] as usize;
+                let end = self.offsets[list as usize + 1] as usize;
+                for slot in start..end {
+                    let row = &self.codes[slot * self.dim..(slot + 1) * self.dim];
+                    let score = dot_i8(&codes, row) as f32 * query_scale * self.scales[slot];
+                    push_bounded(
+                        &mut heap,
+                        Hit {
+                            slot: slot as u32,
+                            score,
+                        },
+                        k,
+                    );
+                }
+                heap
+            })
+            .collect();
+
+        let mut merged = BinaryHeap::with_capacity(k + 1);
+        for heap in partial {
+            for hit in heap {
+                push_bounded(&mut merged, hit, k);
+            }
+        }
+        merged.into_sorted_vec()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::layout::Mulberry32;
+
+    fn random_unit_vectors(rows: usize, dim: usize, seed: u32) -> Vec<f32> {
+        let mut rand = Mulberry32::new(seed);
+        let mut vectors: Vec<f32> = (0..rows * dim).map(|_| rand.next() as f32 - 0.5).collect();
+        for row in vectors.chunks_exact_mut(dim) {
+            normalize(row);
+        }
+        vectors
+    }
+
+    struct Built {
+        partition: Partition,
+        scales: Vec<f32>,
+        codes: Vec<i8>,
+    }
+
+    fn build(vectors: &[f32], dim: usize, lists: usize) -> Built {
+        let partition = train(vectors, dim, lists, DEFAULT_ITERATIONS);
+        let mut codes = vec![0i8; vectors.len()];
+        let mut scales = Vec::new();
+        for (slot, &row) in partition.order.iter().enumerate() {
+            let row = row as usize;
+            scales.push(quantize(
+                &vectors[row * dim..(row + 1) * dim],
+                &mut codes[slot * dim..(slot + 1) * dim],
+            ));
+        }
+        Built {
+            partition,
+            scales,
+            codes,
+        }
+    }
+
+    fn view<'a>(built: &'a Built, dim: usize) -> IvfView<'a> {
+        IvfView {
+            dim,
+            centroids: &built.partition.centroids,
+            offsets: &built.partition.offsets,
+            scales: &built.scales,
+            codes: &built.codes,
+        }
+    }
+
+    #[test]
+    fn partition_covers_every_row_once() {
+        let dim = 8;
+        let vectors = random_unit_vectors(500, dim, 1);
+        let partition = train(&vectors, dim, 10, 4);
+        assert_eq!(partition.offsets.len(), 11);
+        assert_eq!(partition.offsets[10], 500);
+        let mut seen = partition.order.clone();
+        seen.sort_unstable();
+        assert_eq!(seen, (0..500).collect::<Vec<u32>>());
+        // Deterministic.
+        assert_eq!(train(&vectors, dim, 10, 4).order, partition.order);
+    }
+
+    #[test]
+    fn single_list_search_finds_each_row_first() {
+        let dim = 32;
+        let vectors = random_unit_vectors(300, dim, 2);
+        let built = build(&vectors, dim, 1);
+        let view = view(&built, dim);
+        for row in [0usize, 17, 299] {
+            let hits = view.search(&vectors[row * dim..(row + 1) * dim], 3, 0);
+            assert_eq!(hits.len(), 3);
+            assert_eq!(built.partition.order[hits[0].slot as usize] as usize, row);
+            assert!(hits[0].score > 0.98 && hits[0].score >= hits[1].score);
+        }
+    }
+
+    #[test]
+    fn ivf_recall_is_high_with_default_probes() {
+        let dim = 16;
+        let rows = 6000;
+        // Embeddings cluster by topic: noisy copies of a few dozen centres.
+        let centres = random_unit_vectors(60, dim, 3);
+        let noise = random_unit_vectors(rows, dim, 5);
+        let mut vectors: Vec<f32> = (0..rows * dim)
+            .map(|i| centres[((i / dim) % 60) * dim + i % dim] + 0.4 * noise[i])
+            .collect();
+        for row in vectors.chunks_exact_mut(dim) {
+            normalize(row);
+        }
+        let lists = default_lists(rows);
+        assert!(lists > 1);
+        let built = build(&vectors, dim, lists);
+        let view = view(&built, dim);
+        let k = 10;
+        let mut found = 0;
+        let queries = 40;
+        for q in 0..queries {
+            let query = &vectors[q * 97 * dim..(q * 97 + 1) * dim];
+            let mut exact: Vec<(f32, usize)> = (0..rows)
+                .map(|r| (dot_f32(query, &vectors[r * dim..(r + 1) * dim]), r))
+                .collect();
+            exact.sort_by(|a, b| b.0.total_cmp(&a.0));
+            let truth: Vec<usize> = exact[..k].iter().map(|&(_, r)| r).collect();
+            let hits = view.search(query, k, 0);
+            found += hits
+                .iter()
+                .filter(|hit| truth.contains(&(built.partition.order[hit.slot as usize] as usize)))
+                .count();
+        }
+        let recall = found as f64 / (queries * k) as f64;
+        assert!(recall > 0.9, "recall {recall}");
+    }
+
+    #[test]
+    fn empty_and_zero_k_return_nothing() {
+        let built = build(&[], 4, 1);
+        assert!(view(&built, 4)
+            .search(&[1.0, 0.0, 0.0, 0.0], 5, 0)
+            .is_empty());
+        let vectors = random_unit_vectors(10, 4, 4);
+        let built = build(&vectors, 4, 1);
+        assert!(view(&built, 4).search(&vectors[..4], 0, 0).is_empty());
+    }
+}
@@ -0,0 +1,16 @@
+//! On-disk approximate nearest-neighbour index for symbol embeddings.
+//!
+//! Vectors are L2-normalised and quantised to int8 with one scale per row,
+//! then grouped into inverted lists around k-means centroids (IVF). A query
+//! scores the centroids, scans the `nprobe` closest lists with int8 dot
+//! products (AVX2 or NEON where available), and returns the top `k` rows by
+//! approximate cosine similarity. The index file is memory-mapped, so the
+//! codes stay in the page cache rather than on the V8 heap.
+
+pub mod ivf;
+pub mod simd;
+pub mod store;
+pub mod types;
+
+pub use store::EmbeddingIndex;
+pub use types::{NativeEmbeddingIndexOptions, NativeVectorHit};
@@ -0,0 +1,141 @@
+//! Quantisation and dot-product kernels.
+//!
+//! `dot_i8` picks an explicit AVX2 path on x86-64 CPUs that report it and a
+//! NEON path on aarch64 (where NEON is baseline); everything else takes the
+//! scalar loop. All paths return the exact same integer.
+
+/// Scale `vector` to unit length in place; a zero vector stays zero.
+pub fn normalize(vector: &mut [f32]) {
+    let norm = dot_f32(vector, vector).sqrt();
+    if norm > 1e-12 {
+        for value in vector {
+            *value /= norm;
+        }
+    }
+}
+
+pub fn dot_f32(a: &[f32], b: &[f32]) -> f32 {
+    a.iter().zip(b).map(|(x, y)| x * y).sum()
+}
+
+/// Symmetric int8 quantisation. Writes `codes` and returns the scale, so
+/// `vector[i] ≈ codes[i] as f32 * scale`. Codes stay in `-127..=127`.
+pub fn quantize(vector: &[f32], codes: &mut [i8]) -> f32 {
+    let max = vector
+        .iter()
+        .fold(0.0f32, |max, value| max.max(value.abs()));
+    if max <= 0.0 {
+        codes.fill(0);
+        return 0.0;
+    }
+    let scale = max / 127.0;
+    for (code, value) in codes.iter_mut().zip(vector) {
+        *code = (value / scale).round().clamp(-127.0, 127.0) as i8;
+    }
+    scale
+}
+
+#[cfg(target_arch = "x86_64")]
+pub fn dot_i8(a: &[i8], b: &[i8]) -> i32 {
+    debug_assert_eq!(a.len(), b.len());
+    if std::arch::is_x86_feature_detected!("avx2") {
+        // SAFETY: the CPU supports AVX2, checked just above.
+        return unsafe { dot_i8_avx2(a, b) };
+    }
+    dot_i8_scalar(a, b)
+}
+
+#[cfg(target_arch = "aarch64")]
+pub fn dot_i8(a: &[i8], b: &[i8]) -> i32 {
+    debug_assert_eq!(a.len(), b.len());
+    // SAFETY: NEON is part of the aarch64 baseline.
+    unsafe { dot_i8_neon(a, b) }
+}
+
+#[cfg(not(any(target_arch = "x86_64", target_arch = "aarch64")))]
+pub fn dot_i8(a: &[i8], b: &[i8]) -> i32 {
+    dot_i8_scalar(a, b)
+}
+
+pub fn dot_i8_scalar(a: &[i8], b: &[i8]) -> i32 {
+    a.iter().zip(b).map(|(&x, &y)| x as i32 * y as i32).sum()
+}
+
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "avx2")]
+unsafe fn dot_i8_avx2(a: &[i8], b: &[i8]) -> i32 {
+    use std::arch::x86_64::*;
+
+    let len = a.len().min(b.len());
+    let mut acc = _mm256_setzero_si256();
+    let mut i = 0;
+    // Sign-extend 16 codes to i16, multiply pairwise and add adjacent
+    // products into i32 lanes. |127 * 127 * 2| fits easily.
+    while i + 16 <= len {
+        let va = _mm256_cvtepi8_epi16(_mm_loadu_si128(a.as_ptr().add(i) as *const __m128i));
+        let vb = _mm256_cvtepi8_epi16(_mm_loadu_si128(b.as_ptr().add(i) as *const __m128i));
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(va, vb));
+        i += 16;
+    }
+    let mut lanes = [0i32; 8];
+    _mm256_storeu_si256(lanes.as_mut_ptr() as *mut __m256i, acc);
+    lanes.iter().sum::<i32>() + dot_i8_scalar(&a[i..len], &b[i..len])
+}
+
+#[cfg(target_arch = "aarch64")]
+unsafe fn dot_i8_neon(a: &[i8], b: &[i8]) -> i32 {
+    use std::arch::aarch64::*;
+
+    let len = a.len().min(b.len());
+    let mut acc = vdupq_n_s32(0);
+    let mut i = 0;
+    while i + 16 <= len {
+        let va = vld1q_s8(a.as_ptr().add(i));
+        let vb = vld1q_s8(b.as_ptr().add(i));
+        acc = vpadalq_s16(acc, vmull_s8(vget_low_s8(va), vget_low_s8(vb)));
+        acc = vpadalq_s16(acc, vmull_high_s8(va, vb));
+        i += 16;
+    }
+    vaddvq_s32(acc) + dot_i8_scalar(&a[i..len], &b[i..len])
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn dot_i8_matches_scalar_across_lengths() {
+        for len in [0usize, 1, 15, 16, 17, 64, 100, 768] {
+            let a: Vec<i8> = (0..len).map(|i| ((i * 37) % 255) as i8).collect();
+            let b: Vec<i8> = (0..len)
+                .map(|i| (127 - ((i * 11) % 255) as i32) as i8)
+                .collect();
+            assert_eq!(dot_i8(&a, &b), dot_i8_scalar(&a, &b), "len {len}");
+        }
+        let extreme = vec![-127i8; 1024];
+        assert_eq!(dot_i8(&extreme, &extreme), 127 * 127 * 1024);
+    }
+
+    #[test]
+    fn quantize_round_trips_within_half_a_step() {
+        let vector = [0.5f32, -1.0, 0.25, 0.0, 0.999];
+        let mut codes = [0i8; 5];
+        let scale = quantize(&vector, &mut codes);
+        assert_eq!(codes[1], -127);
+        for (code, value) in codes.iter().zip(vector) {
+            assert!((*code as f32 * scale - value).abs() <= scale / 2.0 + 1e-6);
+        }
+        assert_eq!(quantize(&[0.0; 3], &mut codes[..3]), 0.0);
+        assert_eq!(&codes[..3], &[0, 0, 0]);
+    }
+
+    #[test]
+    fn normalize_leaves_zero_vectors_alone() {
+        let mut zero = [0.0f32; 4];
+        normalize(&mut zero);
+        assert_eq!(zero, [0.0; 4]);
+        let mut v = [3.0f32, 4.0];
+        normalize(&mut v);
+        assert!((v[0] - 0.6).abs() < 1e-6 && (v[1] - 0.8).abs() < 1e-6);
+    }
+}
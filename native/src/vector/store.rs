@@ -0,0 +1,311 @@
+//! Embedding index file format.
+//!
+//! Little-endian, one file per repo and model:
+//!
+//! ```text
+//! magic "SDLVEC01" | dim u32 | rows u32 | lists u32 | reserved u32
+//! centroids  f32 × lists·dim
+//! offsets    u32 × (lists + 1)   slot range per list
+//! scales     f32 × rows          per-slot dequantisation scale
+//! id_offsets u32 × (rows + 1)    byte range per slot in the id blob
+//! codes      i8  × rows·dim      slot order
+//! ids        utf-8 symbol IDs, concatenated
+//! ```
+//!
+//! Opening reads the small columns into memory and maps the rest; codes and
+//! IDs are only touched for the lists a query probes. Files are written to a
+//! temporary sibling and renamed into place, so readers never see a torn
+//! index.
+
+use std::fs::File;
+use std::io::{BufWriter, Write};
+use std::path::Path;
+
+use super::ivf::{self, IvfView};
+use super::simd::{normalize, quantize};
+
+const MAGIC: &[u8; 8] = b"SDLVEC01";
+const HEADER_BYTES: usize = 24;
+
+fn write_u32s(out: &mut impl Write, values: &[u32]) -> std::io::Result<()> {
+    for value in values {
+        out.write_all(&value.to_le_bytes())?;
+    }
+    Ok(())
+}
+
+fn write_f32s(out: &mut impl Write, values: &[f32]) -> std::io::Result<()> {
+    for value in values {
+        out.write_all(&value.to_le_bytes())?;
+    }
+    Ok(())
+}
+
+/// Build an index over `symbol_ids` (row `i` is `vectors[i·dim..][..dim]`)
+/// and write it to `path`. Returns the number of rows written.
+pub fn write_index(
+    path: &Path,
+    dim: usize,
+    symbol_ids: &[String],
+    vectors: &[f32],
+    lists: usize,
+    iterations: usize,
+) -> Result<usize, String> {
+    if dim == 0 {
+        return Err("dimension must be positive".to_string());
+    }
+    if vectors.len() != symbol_ids.len() * dim {
+        return Err(format!(
+            "expected {} floats for {} rows of {dim}, got {}",
+            symbol_ids.len() * dim,
+            symbol_ids.len(),
+            vectors.len()
+        ));
+    }
+    if vectors.iter().any(|value| !value.is_finite()) {
+        return Err("vectors must be finite".to_string());
+    }
+    let rows = symbol_ids.len();
+    let mut unit = vectors.to_vec();
+    for row in unit.chunks_exact_mut(dim) {
+        normalize(row);
+    }
+    let lists = if lists == 0 {
+        ivf::default_lists(rows)
+    } else {
+        lists
+    };
+    let partition = ivf::train(&unit, dim, lists, iterations);
+
+    let mut codes = vec![0i8; rows * dim];
+    let mut scales = Vec::with_capacity(rows);
+    let mut id_offsets = Vec::with_capacity(rows + 1);
+    let mut id_bytes = 0usize;
+    id_offsets.push(0u32);
+    for (slot, &row) in partition.order.iter().enumerate() {
+        let row = row as usize;
+        scales.push(quantize(
+            &unit[row * dim..(row + 1) * dim],
+            &mut codes[slot * dim..(slot + 1) * dim],
+        ));
+        id_bytes += symbol_ids[row].len();
+        id_offsets
+            .push(u32::try_from(id_bytes).map_err(|_| "symbol IDs exceed 4 GiB".to_string())?);
+    }
+
+    let tmp = path.with_extension(format!("tmp-{}", std::process::id()));
+    let written = (|| -> std::io::Result<()> {
+        if let Some(parent) = path.parent() {
+            std::fs::create_dir_all(parent)?;
+        }
+        let mut out = BufWriter::new(File::create(&tmp)?);
+        out.write_all(MAGIC)?;
+        let lists = partition.offsets.len() - 1;
+        write_u32s(&mut out, &[dim as u32, rows as u32, lists as u32, 0])?;
+        write_f32s(&mut out, &partition.centroids)?;
+        write_u32s(&mut out, &partition.offsets)?;
+        write_f32s(&mut out, &scales)?;
+        write_u32s(&mut out, &id_offsets)?;
+        out.write_all(&codes.iter().map(|&code| code as u8).collect::<Vec<u8>>())?;
+        for &row in &partition.order {
+            out.write_all(symbol_ids[row as usize].as_bytes())?;
+        }
+        out.into_inner()?.sync_all()?;
+        std::fs::rename(&tmp, path)
+    })();
+    if let Err(error) = written {
+        let _ = std::fs::remove_file(&tmp);
+        return Err(format!("failed to write {}: {error}", path.display()));
+    }
+    Ok(rows)
+}
+
+struct Reader<'a> {
+    bytes: &'a [u8],
+    at: usize,
+}
+
+impl<'a> Reader<'a> {
+    fn take(&mut self, len: usize) -> Result<&'a [u8], String> {
+        let end = self
+            .at
+            .checked_add(len)
+            .filter(|&end| end <= self.bytes.len())
+            .ok_or_else(|| "embedding index is truncated".to_string())?;
+        let slice = &self.bytes[self.at..end];
+        self.at = end;
+        Ok(slice)
+    }
+
+    fn u32s(&mut self, count: usize) -> Result<Vec<u32>, String> {
+        Ok(self
+            .take(count.checked_mul(4).ok_or("embedding index is corrupt")?)?
+            .chunks_exact(4)
+            .map(|b| u32::from_le_bytes([b[0], b[1], b[2], b[3]]))
+            .collect())
+    }
+
+    fn f32s(&mut self, count: usize) -> Result<Vec<f32>, String> {
+        Ok(self.u32s(count)?.into_iter().map(f32::from_bits).collect())
+    }
+}
+
+pub struct EmbeddingIndex {
+    map: memmap2::Mmap,
+    dim: usize,
+    centroids: Vec<f32>,
+    offsets: Vec<u32>,
+    scales: Vec<f32>,
+    id_offsets: Vec<u32>,
+    codes_at: usize,
+    ids_at: usize,
+}
+
+impl EmbeddingIndex {
+    pub fn open(path: &Path) -> Result<Self, String> {
+        let file =
+            File::open(path).map_err(|e| format!("failed to open {}: {e}", path.display()))?;
+        // SAFETY: index files are only ever replaced by rename, never
+        // rewritten in place, so the mapping stays valid while it is open.
+        let map = unsafe { memmap2::Mmap::map(&file) }
+            .map_err(|e| format!("failed to map {}: {e}", path.display()))?;
+        let mut reader = Reader { bytes: &map, at: 0 };
+        if reader.take(MAGIC.len())? != MAGIC {
+            return Err(format!("{} is not an embedding index", path.display()));
+        }
+        let header = reader.u32s((HEADER_BYTES - MAGIC.len()) / 4)?;
+        let (dim, rows, lists) = (header[0] as usize, header[1] as usize, header[2] as usize);
+        if dim == 0 || lists == 0 {
+            return Err("embedding index is corrupt".to_string());
+        }
+        let centroids = reader.f32s(lists.checked_mul(dim).ok_or("embedding index is corrupt")?)?;
+        let offsets = reader.u32s(lists + 1)?;
+        let scales = reader.f32s(rows)?;
+        let id_offsets = reader.u32s(rows + 1)?;
+        let codes_at = reader.at;
+        reader.take(rows.checked_mul(dim).ok_or("embedding index is corrupt")?)?;
+        let ids_at = reader.at;
+        let id_bytes = map.len() - ids_at;
+        if offsets[0] != 0
+            || offsets.windows(2).any(|w| w[0] > w[1])
+            || offsets[lists] as usize != rows
+            || id_offsets[0] != 0
+            || id_offsets.windows(2).any(|w| w[0] > w[1])
+            || id_offsets[rows] as usize != id_bytes
+        {
+            return Err("embedding index is corrupt".to_string());
+        }
+        Ok(Self {
+            map,
+            dim,
+            centroids,
+            offsets,
+            scales,
+            id_offsets,
+            codes_at,
+            ids_at,
+        })
+    }
+
+    pub fn dimension(&self) -> usize {
+        self.dim
+    }
+
+    pub fn rows(&self) -> usize {
+        self.scales.len()
+    }
+
+    pub fn lists(&self) -> usize {
+        self.offsets.len() - 1
+    }
+
+    fn symbol_id(&self, slot: usize) -> String {
+        let start = self.ids_at + self.id_offsets[slot] as usize;
+        let end = self.ids_at + self.id_offsets[slot + 1] as usize;
+        String::from_utf8_lossy(&self.map[start..end]).into_owned()
+    }
+
+    /// Top `k` symbols by approximate cosine similarity, best first.
+    pub fn search(
+        &self,
+        query: &[f32],
+        k: usize,
+        probes: usize,
+    ) -> Result<Vec<(String, f32)>, String> {
+        if query.len() != self.dim {
+            return Err(format!(
+                "query has {} dimensions; the index has {}",
+                query.len(),
+                self.dim
+            ));
+        }
+        if query.iter().any(|value| !value.is_finite()) {
+            return Err("query must be finite".to_string());
+        }
+        let codes = &self.map[self.codes_at..self.ids_at];
+        // SAFETY: i8 and u8 have the same size and alignment.
+        let codes = unsafe { std::slice::from_raw_parts(codes.as_ptr() as *const i8, codes.len()) };
+        let view = IvfView {
+            dim: self.dim,
+            centroids: &self.centroids,
+            offsets: &self.offsets,
+            scales: &self.scales,
+            codes,
+        };
+        Ok(view
+            .search(query, k, probes)
+            .into_iter()
+            .map(|hit| (self.symbol_id(hit.slot as usize), hit.score))
+            .collect())
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn temp_path(name: &str) -> std::path::PathBuf {
+        std::env::temp_dir()
+            .join(format!("sdl-vector-{}-{name}", std::process::id()))
+            .join("index.sdlvec")
+    }
+
+    #[test]
+    fn round_trips_through_a_file() {
+        let path = temp_path("round-trip");
+        let ids: Vec<String> = ["alpha", "beta", "gamma", "délta"]
+            .iter()
+            .map(|s| s.to_string())
+            .collect();
+        let vectors = [
+            1.0, 0.0, 0.0, //
+            0.0, 2.0, 0.0, //
+            0.0, 0.0, 3.0, //
+            1.0, 1.0, 0.0,
+        ];
+        assert_eq!(write_index(&path, 3, &ids, &vectors, 0, 8).unwrap(), 4);
+        let index = EmbeddingIndex::open(&path).unwrap();
+        assert_eq!((index.dimension(), index.rows(), index.lists()), (3, 4, 1));
+        let hits = index.search(&[0.0, 5.0, 0.1], 2, 0).unwrap();
+        assert_eq!(hits[0].0, "beta");
+        assert!((hits[0].1 - 1.0).abs() < 0.01);
+        assert_eq!(hits[1].0, "délta");
+        assert!(index.search(&[1.0, 0.0], 2, 0).is_err());
+        std::fs::remove_dir_all(path.parent().unwrap()).unwrap();
+    }
+
+    #[test]
+    fn rejects_bad_input_and_corrupt_files() {
+        let path = temp_path("corrupt");
+        let ids = vec!["a".to_string()];
+        assert!(write_index(&path, 2, &ids, &[1.0], 0, 8).is_err());
+        assert!(write_index(&path, 2, &ids, &[1.0, f32::NAN], 0, 8).is_err());
+        write_index(&path, 2, &ids, &[1.0, 0.0], 0, 8).unwrap();
+        let bytes = std::fs::read(&path).unwrap();
+        std::fs::write(&path, &bytes[..bytes.len() - 1]).unwrap();
+        assert!(EmbeddingIndex::open(&path).is_err());
+        std::fs::write(&path, b"not an index at all, no").unwrap();
+        assert!(EmbeddingIndex::open(&path).is_err());
+        std::fs::remove_dir_all(path.parent().unwrap()).unwrap();
+    }
+}
@@ -0,0 +1,20 @@
+//! Napi-rs payload types for the embedding index exports.
+
+use napi_derive::napi;
+
+#[napi(object)]
+#[derive(Debug, Clone, Default)]
+pub struct NativeEmbeddingIndexOptions {
+    /// Inverted lists (0 = about sqrt(rows); small indexes use one list).
+    pub lists: Option<u32>,
+    /// k-means refinement passes (0 = 8).
+    pub iterations: Option<u32>,
+}
+
+#[napi(object)]
+#[derive(Debug, Clone)]
+pub struct NativeVectorHit {
+    pub symbol_id: String,
+    /// Approximate cosine similarity in `[-1, 1]`.
+    pub score: f64,
+}
@@ -0,0 +1,182 @@
+#!/usr/bin/env tsx
+/**
+ * Native engine regression gate.
+ *
+ * Measures end-to-end native parse throughput (files/sec, MB/sec, peak RSS)
+ * over tests/stress/fixtures and every benchmarks/real-world external repo
+ * checked out under .tmp/external-benchmarks, merges in the latest Criterion
+ * results from native/target/criterion (run `npm run bench:native` first to
+ * include them), and evaluates everything against the `native` thresholds.
+ *
+ * Usage:
+ *   npm run benchmark:native
+ *   npm run benchmark:native -- --save-baseline
+ *   npm run benchmark:native -- --threshold config/benchmark.native.config.json \
+ *     --criterion native/target/criterion --out .benchmark/native-throughput.json
+ *
+ * Exits 1 when a threshold fails.
+ */
+
+import { existsSync, mkdirSync, readFileSync, writeFileSync } from "node:fs";
+import { dirname, resolve } from "node:path";
+
+import {
+  collectThroughputCorpus,
+  loadNativeBaseline,
+  measureCorpusThroughput,
+  nativeBenchmarkMetrics,
+  readCriterionEstimates,
+  type CorpusThroughput,
+  type ThroughputCorpus,
+} from "../../dist/benchmark/native-throughput.js";
+import { RegressionReportGenerator } from "../../dist/benchmark/regression.js";
+import {
+  ThresholdEvaluator,
+  loadThresholdConfig,
+} from "../../dist/benchmark/threshold.js";
+import {
+  getRustEngineStatus,
+  parseFilesRust,
+} from "../../dist/indexer/rustIndexer.js";
+
+function getArg(name: string, fallback?: string): string | undefined {
+  const flag = `--${name}`;
+  const idx = process.argv.findIndex(
+    (a) => a === flag || a.startsWith(`${flag}=`),
+  );
+  if (idx === -1) return fallback;
+  const arg = process.argv[idx];
+  if (arg.includes("=")) return arg.split("=", 2)[1];
+  return process.argv[idx + 1] ?? fallback;
+}
+
+function hasFlag(name: string): boolean {
+  return process.argv.includes(`--${name}`);
+}
+
+const cwd = process.cwd();
+const thresholdPath = resolve(
+  cwd,
+  getArg("threshold", "config/benchmark.native.config.json")!,
+);
+const criterionDir = resolve(
+  cwd,
+  getArg("criterion", "native/target/criterion")!,
+);
+const outPath = resolve(
+  cwd,
+  getArg("out", ".benchmark/native-throughput.json")!,
+);
+const threadCount = Number(getArg("threads", "0"));
+
+function corpora(): ThroughputCorpus[] {
+  const result = [
+    collectThroughputCorpus(
+      "stress-fixtures",
+      resolve(cwd, "tests/stress/fixtures"),
+    ),
+  ];
+  const configPath = resolve(
+    cwd,
+    "benchmarks/real-world/external-repos.config.json",
+  );
+  if (existsSync(configPath)) {
+    const config = JSON.parse(readFileSync(configPath, "utf-8")) as {
+      repos?: Array<{ repoId: string; rootPath: string }>;
+    };
+    for (const repo of config.repos ?? []) {
+      const root = resolve(cwd, repo.rootPath);
+      if (!existsSync(root)) {
+        console.log(
+          `- ${repo.repoId}: not checked out (npm run benchmark:setup-external)`,
+        );
+        continue;
+      }
+      result.push(collectThroughputCorpus(repo.repoId, root));
+    }
+  }
+  return result.filter((corpus) => corpus.files.length > 0);
+}
+
+function main(): number {
+  const thresholds = loadThresholdConfig(thresholdPath);
+  const engine = getRustEngineStatus();
+  if (!engine.available) {
+    console.error(`Native addon unavailable: ${engine.reason}`);
+    return 1;
+  }
+
+  const throughput: CorpusThroughput[] = [];
+  for (const corpus of corpora()) {
+    const result = measureCorpusThroughput(corpus, parseFilesRust, {
+      threadCount,
+      rounds: thresholds.smoothing.sampleRuns,
+    });
+    if (!result) {
+      console.error(`Native parse failed on ${corpus.name}`);
+      return 1;
+    }
+    throughput.push(result);
+    console.log(
+      `- ${result.corpus}: ${result.files} files, ${(result.bytes / 1024 / 1024).toFixed(1)} MB, ` +
+        `${result.filesPerSec.toFixed(0)} files/s, ${result.mbPerSec.toFixed(2)} MB/s, ` +
+        `peak RSS ${result.peakRssMb.toFixed(0)} MB` +
+        (result.parseErrors > 0 ? `, ${result.parseErrors} parse errors` : ""),
+    );
+  }
+
+  const criterion = readCriterionEstimates(criterionDir);
+  const criterionCount = Object.keys(criterion).length;
+  console.log(
+    criterionCount > 0
+      ? `Loaded ${criterionCount} Criterion results from ${criterionDir}`
+      : `No Criterion results in ${criterionDir}; run npm run bench:native to include them`,
+  );
+
+  const currentMetrics = nativeBenchmarkMetrics(throughput, criterion);
+  const baselinePath = resolve(cwd, thresholds.baseline.filePath);
+  const baselineMetrics = loadNativeBaseline(baselinePath);
+  const evaluation = new ThresholdEvaluator(thresholds).evaluate(
+    currentMetrics,
+    baselineMetrics,
+  );
+  const report = new RegressionReportGenerator().generate({
+    timestamp: new Date().toISOString(),
+    repoId: "native",
+    currentMetrics,
+    baselineMetrics,
+    thresholds: thresholds.thresholds,
+    evaluations: evaluation.evaluations,
+  });
+
+  mkdirSync(dirname(outPath), { recursive: true });
+  writeFileSync(
+    outPath,
+    JSON.stringify(
+      { timestamp: new Date().toISOString(), throughput, criterion, report },
+      null,
+      2,
+    ),
+    "utf-8",
+  );
+  console.log(`\nReport written to ${outPath}`);
+
+  if (hasFlag("save-baseline")) {
+    mkdirSync(dirname(baselinePath), { recursive: true });
+    writeFileSync(
+      baselinePath,
+      JSON.stringify({ repoId: "native", metrics: currentMetrics }, null, 2),
+      "utf-8",
+    );
+    console.log(`Baseline saved to ${baselinePath}`);
+  }
+
+  console.log(
+    `\nThresholds: ${evaluation.summary.passed}/${evaluation.summary.total} passed` +
+      (baselineMetrics ? "" : " (no baseline; only absolute limits applied)"),
+  );
+  for (const rec of report.recommendations) console.log(rec);
+  return evaluation.passed ? 0 : 1;
+}
+
+process.exitCode = main();
@@ -23,3 +23,15 @@ export {
   type MetricMeasurement,
   type SmoothingResult,
 } from "./smoothing.js";
+
+export {
+  collectThroughputCorpus,
+  measureCorpusThroughput,
+  readCriterionEstimates,
+  nativeBenchmarkMetrics,
+  loadNativeBaseline,
+  type ThroughputCorpus,
+  type CorpusThroughput,
+  type CriterionEstimate,
+  type NativeParseFn,
+} from "./native-throughput.js";
@@ -0,0 +1,289 @@
+/**
+ * End-to-end native parse throughput: files/sec, MB/sec and memory for
+ * whole corpora pushed through `parseFilesRust`, plus the reader for the
+ * Criterion micro-benchmarks in `native/benches`. Both feed flat metric
+ * maps that `ThresholdEvaluator` checks against the `native` threshold
+ * category (`config/benchmark.native.config.json`).
+ */
+
+import { existsSync, readdirSync, readFileSync, statSync } from "node:fs";
+import { join, relative } from "node:path";
+import { performance } from "node:perf_hooks";
+
+import type { FileMetadata } from "../indexer/fileScanner.js";
+import type { RustParseResult } from "../indexer/rustIndexer.js";
+
+/** Extensions `parseFilesRust` hands to the addon (Kotlin stays on TS). */
+const NATIVE_EXTENSIONS = new Set([
+  "ts",
+  "tsx",
+  "js",
+  "mjs",
+  "cjs",
+  "jsx",
+  "py",
+  "go",
+  "java",
+  "cs",
+  "c",
+  "h",
+  "cpp",
+  "cc",
+  "cxx",
+  "hpp",
+  "php",
+  "rs",
+  "sh",
+  "bash",
+  "zsh",
+]);
+
+const IGNORED_DIRS = new Set([
+  ".git",
+  "node_modules",
+  "dist",
+  "build",
+  "target",
+  "coverage",
+  "vendor",
+]);
+
+const MB = 1024 * 1024;
+
+export interface ThroughputCorpus {
+  name: string;
+  root: string;
+  files: FileMetadata[];
+  bytes: number;
+}
+
+export interface CorpusThroughput {
+  corpus: string;
+  files: number;
+  bytes: number;
+  symbols: number;
+  parseErrors: number;
+  rounds: number;
+  /** Median wall time of one pass over the corpus. */
+  elapsedMs: number;
+  filesPerSec: number;
+  mbPerSec: number;
+  /** Process RSS high-water mark after the corpus ran. */
+  peakRssMb: number;
+  /** RSS growth across the timed rounds. */
+  rssGrowthMb: number;
+  heapUsedMb: number;
+}
+
+/** `parseFilesRust`'s signature; injected so tests need no addon. */
+export type NativeParseFn = (
+  repoId: string,
+  repoRoot: string,
+  files: FileMetadata[],
+  threadCount?: number,
+) => Array<RustParseResult | null> | null;
+
+/**
+ * Every natively parsed source file under `root`, sorted by path. Build
+ * output, dependencies and VCS directories are skipped.
+ */
+export function collectThroughputCorpus(
+  name: string,
+  root: string,
+  options: { maxFiles?: number; maxFileBytes?: number } = {},
+): ThroughputCorpus {
+  const maxFiles = options.maxFiles ?? Number.POSITIVE_INFINITY;
+  const maxFileBytes = options.maxFileBytes ?? 2 * MB;
+  const files: FileMetadata[] = [];
+  const pending = [root];
+  while (pending.length > 0) {
+    const dir = pending.pop()!;
+    let entries;
+    try {
+      entries = readdirSync(dir, { withFileTypes: true });
+    } catch {
+      continue;
+    }
+    for (const entry of entries) {
+      const path = join(dir, entry.name);
+      if (entry.isDirectory()) {
+        if (!IGNORED_DIRS.has(entry.name)) pending.push(path);
+        continue;
+      }
+      if (!entry.isFile()) continue;
+      const ext = entry.name.split(".").pop()?.toLowerCase() ?? "";
+      if (!NATIVE_EXTENSIONS.has(ext)) continue;
+      const stat = statSync(path);
+      if (stat.size > maxFileBytes) continue;
+      files.push({
+        path: relative(root, path).replace(/\\/g, "/"),
+        size: stat.size,
+        mtime: stat.mtimeMs,
+      });
+    }
+  }
+  files.sort((a, b) => a.path.localeCompare(b.path));
+  const kept = files.slice(0, maxFiles);
+  return {
+    name,
+    root,
+    files: kept,
+    bytes: kept.reduce((sum, file) => sum + file.size, 0),
+  };
+}
+
+function median(values: number[]): number {
+  const sorted = [...values].sort((a, b) => a - b);
+  const mid = Math.floor(sorted.length / 2);
+  return sorted.length % 2 === 1
+    ? sorted[mid]
+    : (sorted[mid - 1] + sorted[mid]) / 2;
+}
+
+/**
+ * Parse `corpus` once untimed (warms parsers and the thread pool), then
+ * `rounds` timed passes. Returns null when the native engine is unavailable.
+ */
+export function measureCorpusThroughput(
+  corpus: ThroughputCorpus,
+  parse: NativeParseFn,
+  options: { threadCount?: number; rounds?: number } = {},
+): CorpusThroughput | null {
+  const threadCount = options.threadCount ?? 0;
+  const rounds = Math.max(1, options.rounds ?? 3);
+  const repoId = `bench-${corpus.name}`;
+  if (!parse(repoId, corpus.root, corpus.files, threadCount)) return null;
+
+  const rssBefore = process.memoryUsage().rss;
+  const timings: number[] = [];
+  let symbols = 0;
+  let parseErrors = 0;
+  for (let round = 0; round < rounds; round++) {
+    const startedAt = performance.now();
+    const results = parse(repoId, corpus.root, corpus.files, threadCount);
+    timings.push(performance.now() - startedAt);
+    if (!results) return null;
+    if (round === 0) {
+      for (const result of results) {
+        if (!result) continue;
+        symbols += result.symbols.length;
+        if (result.parseError) parseErrors++;
+      }
+    }
+  }
+  const memory = process.memoryUsage();
+  const elapsedMs = median(timings);
+  const seconds = elapsedMs / 1000;
+  return {
+    corpus: corpus.name,
+    files: corpus.files.length,
+    bytes: corpus.bytes,
+    symbols,
+    parseErrors,
+    rounds,
+    elapsedMs,
+    filesPerSec: seconds > 0 ? corpus.files.length / seconds : 0,
+    mbPerSec: seconds > 0 ? corpus.bytes / MB / seconds : 0,
+    // resourceUsage().maxRSS is in KiB.
+    peakRssMb: (process.resourceUsage().maxRSS * 1024) / MB,
+    rssGrowthMb: Math.max(0, memory.rss - rssBefore) / MB,
+    heapUsedMb: memory.heapUsed / MB,
+  };
+}
+
+export interface CriterionEstimate {
+  meanMs: number;
+  /** From `peak_heap.json`, written by the benches' counting allocator. */
+  peakHeapBytes?: number;
+}
+
+/**
+ * Latest Criterion results under `criterionDir` (`native/target/criterion`
+ * by default), keyed `<group>/<id>`.
+ */
+export function readCriterionEstimates(
+  criterionDir: string,
+): Record<string, CriterionEstimate> {
+  const estimates: Record<string, CriterionEstimate> = {};
+  if (!existsSync(criterionDir)) return estimates;
+  for (const group of readdirSync(criterionDir, { withFileTypes: true })) {
+    if (!group.isDirectory() || group.name === "report") continue;
+    const groupDir = join(criterionDir, group.name);
+    for (const bench of readdirSync(groupDir, { withFileTypes: true })) {
+      if (!bench.isDirectory() || bench.name === "report") continue;
+      const benchDir = join(groupDir, bench.name);
+      const estimatesPath = join(benchDir, "new", "estimates.json");
+      if (!existsSync(estimatesPath)) continue;
+      try {
+        const parsed = JSON.parse(readFileSync(estimatesPath, "utf-8")) as {
+          mean?: { point_estimate?: number };
+        };
+        const meanNs = parsed.mean?.point_estimate;
+        if (typeof meanNs !== "number") continue;
+        const estimate: CriterionEstimate = { meanMs: meanNs / 1e6 };
+        const peakPath = join(benchDir, "peak_heap.json");
+        if (existsSync(peakPath)) {
+          const peak = JSON.parse(readFileSync(peakPath, "utf-8")) as {
+            peakHeapBytes?: number;
+          };
+          if (typeof peak.peakHeapBytes === "number") {
+            estimate.peakHeapBytes = peak.peakHeapBytes;
+          }
+        }
+        estimates[`${group.name}/${bench.name}`] = estimate;
+      } catch {
+        // A half-written result from an interrupted run; skip it.
+      }
+    }
+  }
+  return estimates;
+}
+
+/**
+ * Flatten throughput and Criterion results into threshold metric names:
+ * `nativeFilesPerSec` / `nativeMbPerSec` / `nativePeakRssMb` over all
+ * corpora, `throughput.<corpus>.*` per corpus and
+ * `criterion.<group>/<id>.meanMs|peakHeapMb` per micro-benchmark.
+ */
+export function nativeBenchmarkMetrics(
+  throughput: CorpusThroughput[],
+  criterion: Record<string, CriterionEstimate> = {},
+): Record<string, number> {
+  const metrics: Record<string, number> = {};
+  let files = 0;
+  let bytes = 0;
+  let ms = 0;
+  let peakRssMb = 0;
+  for (const result of throughput) {
+    metrics[`throughput.${result.corpus}.filesPerSec`] = result.filesPerSec;
+    metrics[`throughput.${result.corpus}.mbPerSec`] = result.mbPerSec;
+    metrics[`throughput.${result.corpus}.peakRssMb`] = result.peakRssMb;
+    files += result.files;
+    bytes += result.bytes;
+    ms += result.elapsedMs;
+    peakRssMb = Math.max(peakRssMb, result.peakRssMb);
+  }
+  if (throughput.length > 0 && ms > 0) {
+    metrics.nativeFilesPerSec = files / (ms / 1000);
+    metrics.nativeMbPerSec = bytes / MB / (ms / 1000);
+    metrics.nativePeakRssMb = peakRssMb;
+  }
+  for (const [id, estimate] of Object.entries(criterion)) {
+    metrics[`criterion.${id}.meanMs`] = estimate.meanMs;
+    if (estimate.peakHeapBytes !== undefined) {
+      metrics[`criterion.${id}.peakHeapMb`] = estimate.peakHeapBytes / MB;
+    }
+  }
+  return metrics;
+}
+
+/** Metrics saved by an earlier `--save-baseline` run, if any. */
+export function loadNativeBaseline(
+  path: string,
+): Record<string, number> | undefined {
+  if (!existsSync(path)) return undefined;
+  const parsed = JSON.parse(readFileSync(path, "utf-8")) as {
+    metrics?: Record<string, number>;
+  };
+  return parsed.metrics;
+}
@@ -210,6 +210,19 @@ export class RegressionReportGenerator {
         );
       }
 
+      const nativeFailures = failingEvaluations.filter(
+        (e) => e.category === "native",
+      );
+      if (nativeFailures.length > 0) {
+        recommendations.push(
+          "Native engine performance regressed. Check:",
+          "  - Criterion reports under native/target/criterion for the slow group",
+          "  - Native phase histograms (sdl://observability/phase-latency) for the slow parse step",
+          "  - New allocations or locks in native/src hot loops",
+          "  - Parse thread count and batch size on the benchmark machine",
+        );
+      }
+
       const coverageFailures = failingEvaluations.filter(
         (e) => e.category === "coverage",
       );
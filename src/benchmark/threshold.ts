@@ -5,6 +5,8 @@ export interface MetricThreshold {
   minValue?: number;
   maxMs?: number;
   maxTokens?: number;
+  /** Unit-free ceiling, e.g. peak RSS in MB. */
+  maxValue?: number;
   minPercent?: number;
   trend: "higher-is-better" | "lower-is-better";
   allowableIncreasePercent?: number;
@@ -24,6 +26,8 @@ export interface BenchmarkThresholds {
     performance: ThresholdCategory;
     tokenEfficiency: ThresholdCategory;
     coverage: ThresholdCategory;
+    /** Native engine micro-benchmarks and parse throughput. */
+    native?: ThresholdCategory;
   };
   smoothing: {
     warmupRuns: number;
@@ -174,6 +178,18 @@ export class ThresholdEvaluator {
       }
     }
 
+    if (threshold.maxValue !== undefined) {
+      const baselineAlreadyAboveMax =
+        baselineValue !== undefined && baselineValue > threshold.maxValue;
+
+      if (currentValue > threshold.maxValue && !baselineAlreadyAboveMax) {
+        passed = false;
+        message = message
+          ? `${message} and exceeds max ${threshold.maxValue}`
+          : `Exceeds max ${threshold.maxValue}`;
+      }
+    }
+
     if (threshold.minValue !== undefined) {
       const baselineAlreadyBelowMin =
         baselineValue !== undefined && baselineValue < threshold.minValue;
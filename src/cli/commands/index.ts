@@ -1,5 +1,6 @@
 import { IndexOptions } from "../types.js";
 import { loadConfig } from "../../config/loadConfig.js";
+import { configureNativeParseEngineOnStartup } from "../../startup/native-engine-startup.js";
 import {
   indexRepo,
   watchRepository,
@@ -2226,6 +2227,7 @@ export async function indexCommand(options: IndexOptions): Promise<void> {
 
   const configPath = activateCliConfigPath(options.config);
   const config = loadConfig(configPath);
+  configureNativeParseEngineOnStartup(config);
 
   // Check if an HTTP server is already running on this database.
   const graphDbPath = resolveGraphDbPath(config, configPath);
@@ -19,6 +19,9 @@ import { persistUsageSnapshot } from "../../db/ladybug-usage.js";
 import { createWalCheckpointMaintenance } from "../../db/wal-maintenance.js";
 import { printBanner } from "../../util/banner.js";
 import { startPrefetchPolicy } from "../../startup/prefetch-startup.js";
+import { startGraphSnapshotRestore } from "../../startup/graph-snapshot-startup.js";
+import { configureNativeParseEngineOnStartup } from "../../startup/native-engine-startup.js";
+import { shutdownRustParseEngine } from "../../indexer/rustIndexer.js";
 import {
   configureDefaultLiveIndexCoordinator,
   getDefaultLiveIndexCoordinator,
@@ -179,6 +182,7 @@ export async function serveCommand(options: ServeOptions): Promise<void> {
   });
   shutdownMgr.addCleanup("graphIntegrityVerifier", stopGraphIntegrityVerifier);
   shutdownMgr.addCleanup("db", closeLadybugDbAfterDrainingWork);
+  shutdownMgr.addCleanup("parseEngine", shutdownRustParseEngine);
   shutdownMgr.addCleanup("logger", () => shutdownLogger());
   shutdownMgr.registerSignals(); // SIGINT, SIGTERM, SIGHUP
   if (options.transport === "stdio") {
@@ -197,6 +201,7 @@ export async function serveCommand(options: ServeOptions): Promise<void> {
   writeServeStderrLine(`[sdl-mcp] Config: ${configPath} (${configSource})`);
   const config = loadConfig(configPath);
   setViewerRuntimeConfig(config.viewer, configPath);
+  configureNativeParseEngineOnStartup(config);
 
   configureLogger(options.logLevel ?? "info", options.logFormat ?? "pretty");
 
@@ -318,6 +323,8 @@ export async function serveCommand(options: ServeOptions): Promise<void> {
       writeServeStderrLine(message);
     });
 
+    startGraphSnapshotRestore(config);
+
     await startPrefetchPolicy(config);
   } else {
     writeServeStderrLine(
@@ -47,6 +47,7 @@ import type {
   ObservabilitySnapshot,
   TimeseriesWindow,
 } from "../../observability/index.js";
+import { buildPhaseTrace } from "../../observability/index.js";
 
 const __dirname = fileURLToPath(new URL(".", import.meta.url));
 const UI_DIR_CANDIDATE = join(__dirname, "..", "..", "ui");
@@ -784,6 +785,20 @@ async function routeObservabilityApiRequest(
     return true;
   }
 
+  if (
+    req.method === "GET" &&
+    pathname === "/api/observability/phase-trace"
+  ) {
+    // Process-wide spans; no repoId and no dependency on the service.
+    const since = Number(url.searchParams.get("since") ?? 0);
+    if (!Number.isFinite(since) || since < 0) {
+      json(res, 400, { error: "invalid_since" });
+      return true;
+    }
+    json(res, 200, buildPhaseTrace(since));
+    return true;
+  }
+
   if (
     req.method === "GET" &&
     pathname === "/api/observability/beam-explain"
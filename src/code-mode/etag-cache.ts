@@ -1,7 +1,13 @@
 const MAX_ETAG_CACHE_SIZE = 2000;
 const MAX_KNOWN_CARD_ETAGS = 1000;
+const MAX_CARD_FRAGMENTS = 5000;
+const MAX_CARD_FRAGMENT_CHARS = 8 * 1024 * 1024;
 
 import { getObservabilityTap } from "../observability/event-tap.js";
+import {
+  isStreamingSerializerEnabled,
+  type CardFragmentSource,
+} from "../util/streaming-json.js";
 
 interface WorkflowEtagCacheScope {
   repoId: string;
@@ -251,3 +257,106 @@ function emitEtagCacheBatch(hits: number, count: number, t0: number): void {
     // observability is best-effort
   }
 }
+
+interface CardFragment {
+  json: string;
+  shape: string;
+}
+
+function cardShape(card: Record<string, unknown>): string {
+  return Object.keys(card).join(",");
+}
+
+/**
+ * Serialized symbol cards keyed by content etag, shared by every workflow
+ * in the process. An etag hashes the card it was issued for, so the JSON
+ * written for one step result is reusable verbatim in the next; the field
+ * list guards against the same etag arriving under another projection.
+ * Least recently used fragments go first once either the entry or the
+ * character cap is reached.
+ */
+export class CardFragmentCache implements CardFragmentSource {
+  private fragments: Map<string, CardFragment> = new Map();
+  private chars = 0;
+  private lookups = 0;
+  private hits = 0;
+  private lookupMs = 0;
+
+  constructor(
+    private readonly maxEntries = MAX_CARD_FRAGMENTS,
+    private readonly maxChars = MAX_CARD_FRAGMENT_CHARS,
+  ) {}
+
+  get(etag: string, card: Record<string, unknown>): string | undefined {
+    const t0 = performance.now();
+    const fragment = this.fragments.get(etag);
+    const hit = fragment !== undefined && fragment.shape === cardShape(card);
+    this.lookups++;
+    this.lookupMs += performance.now() - t0;
+    if (!hit) return undefined;
+    this.hits++;
+    this.fragments.delete(etag);
+    this.fragments.set(etag, fragment);
+    return fragment.json;
+  }
+
+  set(etag: string, card: Record<string, unknown>, json: string): void {
+    if (json.length > this.maxChars) return;
+    const previous = this.fragments.get(etag);
+    if (previous) {
+      this.chars -= previous.json.length;
+      this.fragments.delete(etag);
+    }
+    this.fragments.set(etag, { json, shape: cardShape(card) });
+    this.chars += json.length;
+    while (
+      this.fragments.size > this.maxEntries ||
+      this.chars > this.maxChars
+    ) {
+      const oldest = this.fragments.entries().next().value;
+      if (oldest === undefined) break;
+      this.fragments.delete(oldest[0]);
+      this.chars -= oldest[1].json.length;
+    }
+  }
+
+  /** Report lookups since the last flush as one batch cache event. */
+  flushLookups(): void {
+    if (this.lookups === 0) return;
+    try {
+      getObservabilityTap()?.cacheLookup({
+        source: "card-fragment",
+        hit: this.hits > 0,
+        latencyMs: this.lookupMs,
+        count: this.lookups,
+        hits: this.hits,
+      });
+    } catch {
+      // observability is best-effort
+    }
+    this.lookups = 0;
+    this.hits = 0;
+    this.lookupMs = 0;
+  }
+
+  get size(): number {
+    return this.fragments.size;
+  }
+
+  clear(): void {
+    this.fragments.clear();
+    this.chars = 0;
+    this.lookups = 0;
+    this.hits = 0;
+    this.lookupMs = 0;
+  }
+}
+
+let cardFragmentCache: CardFragmentCache | undefined;
+
+/** The process-wide fragment cache, or null when `SDL_MCP_STREAMING_SERIALIZER=0`. */
+export function getCardFragmentCache(): CardFragmentCache | null {
+  if (!isStreamingSerializerEnabled()) return null;
+  cardFragmentCache ??= new CardFragmentCache();
+  return cardFragmentCache;
+}
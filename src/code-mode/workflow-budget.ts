@@ -1,4 +1,6 @@
+import { serializeJson } from "../util/streaming-json.js";
 import { estimateTokens } from "../util/tokenize.js";
+import { getCardFragmentCache } from "./etag-cache.js";
 import type { WorkflowBudget } from "./types.js";
 
 function minNullable(a: number | null, b: number | null): number | null {
@@ -119,7 +121,14 @@ export class WorkflowBudgetTracker {
     };
   }
 
+  /**
+   * Cards that arrive with an etag are taken from the process-wide fragment
+   * cache, so a card repeated across steps and workflows is serialized once.
+   */
   static estimateResultTokens(result: unknown): number {
-    return estimateTokens(JSON.stringify(result));
+    const fragments = getCardFragmentCache();
+    const { json } = serializeJson(result, { fragments: fragments ?? undefined });
+    fragments?.flushLookups();
+    return estimateTokens(json ?? "");
   }
 }
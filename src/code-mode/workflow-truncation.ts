@@ -1,24 +1,30 @@
 import { randomBytes } from "node:crypto";
 
+import {
+  safeJsonReplacer,
+  serializeJson,
+  type SerializedSize,
+} from "../util/streaming-json.js";
 import { estimateTokensCoarse } from "../util/tokenize.js";
 
 // --- Token estimation ---
 
 function safeJsonStringify(value: unknown): string {
   try {
-    const json = JSON.stringify(value, (_key, item) => {
-      if (typeof item === "bigint") return item.toString();
-      if (typeof item === "function") return "[Function]";
-      if (typeof item === "symbol") return item.toString();
-      if (item === undefined) return null;
-      return item;
-    });
-    return json ?? "null";
+    return JSON.stringify(value, safeJsonReplacer) ?? "null";
   } catch {
     return JSON.stringify(String(value));
   }
 }
 
+/** Serialized length of `value`, read from `size` when it was measured. */
+function serializedLength(
+  value: unknown,
+  size: SerializedSize | undefined,
+): number {
+  return size?.length ?? safeJsonStringify(value).length;
+}
+
 // --- Continuation store ---
 
 interface ContinuationEntry {
@@ -107,17 +113,27 @@ function stringChunk(
 
 // --- Smart truncation ---
 
-function smartTruncate(result: unknown, maxTokens: number): unknown {
+/**
+ * Keep the leading items or keys that fit `maxTokens`. Member sizes come
+ * from `size` (recorded when the full result was serialized) wherever the
+ * serializer walked that deep, so kept members are not stringified again.
+ */
+function smartTruncate(
+  result: unknown,
+  maxTokens: number,
+  size?: SerializedSize,
+): unknown {
   const maxChars = maxTokens * 4;
 
   if (Array.isArray(result)) {
     const kept: unknown[] = [];
     let chars = 2; // []
-    for (const item of result) {
-      const itemJson = safeJsonStringify(item);
-      if (chars + itemJson.length + 1 > maxChars) break;
+    for (let i = 0; i < result.length; i++) {
+      const item = result[i];
+      const itemLength = serializedLength(item, size?.items?.[i]);
+      if (chars + itemLength + 1 > maxChars) break;
       kept.push(item);
-      chars += itemJson.length + 1;
+      chars += itemLength + 1;
     }
     if (result.length > 0 && kept.length === 0) {
       return truncationMarker();
@@ -131,8 +147,8 @@ function smartTruncate(result: unknown, maxTokens: number): unknown {
     let chars = 2; // {}
 
     for (const [key, value] of Object.entries(obj)) {
-      const valueJson = safeJsonStringify(value);
-      const entrySize = key.length + valueJson.length + 4; // "key":value,
+      const valueSize = size?.entries?.get(key);
+      const entrySize = key.length + serializedLength(value, valueSize) + 4; // "key":value,
 
       if (chars + entrySize > maxChars) {
         // Try to include with truncated value
@@ -141,7 +157,7 @@ function smartTruncate(result: unknown, maxTokens: number): unknown {
             50,
             Math.floor((maxChars - chars) / 4),
           );
-          truncatedObj[key] = smartTruncate(value, remainingBudget);
+          truncatedObj[key] = smartTruncate(value, remainingBudget, valueSize);
           break;
         }
         if (typeof value === "string" && value.length > 100) {
@@ -241,7 +257,10 @@ export function truncateStepResult(
   result: unknown,
   maxTokens: number,
 ): TruncationResult {
-  const json = safeJsonStringify(result);
+  // One serialization feeds the token count, the continuation store and
+  // the member sizes smartTruncate budgets with.
+  const serialized = serializeJson(result, { mode: "safe" });
+  const json = serialized.json ?? "null";
   const originalTokens = estimateTokensCoarse(json);
 
   if (originalTokens <= maxTokens) {
@@ -271,7 +290,7 @@ export function truncateStepResult(
   });
 
   const truncated = ensureVisibleTruncationPreview(
-    smartTruncate(result, maxTokens),
+    smartTruncate(result, maxTokens, serialized.size),
     result,
   );
   const keptTokens = estimateTokensCoarse(safeJsonStringify(truncated));
@@ -574,6 +574,19 @@ export const DEFAULT_EMBEDDING_BATCH_SIZE = 32;
  */
 export const MAX_EMBEDDING_BATCH_SIZE = 128;
 
+/**
+ * Latency the pipelined symbol-embedding refresh aims for per inference
+ * batch. Batches of short inputs grow to the configured batch size; long
+ * inputs get fewer rows per batch so one batch never stalls the pipeline.
+ */
+export const EMBEDDING_TARGET_BATCH_MS = 400;
+
+/**
+ * Embedded rows the pipelined refresh may hold ahead of LadybugDB. Beyond
+ * this, inference waits for the write in flight before embedding more.
+ */
+export const EMBEDDING_WRITE_QUEUE_MAX_ROWS = 2048;
+
 /**
  * FileSummary payloads are much larger than symbol-card payloads because they
  * include file path, language, exports, and representative symbol facts. Keep
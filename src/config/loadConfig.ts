@@ -60,6 +60,21 @@ let cachedConfig: AppConfig | null = null;
 let cachedConfigPath: string | null = null;
 let cachedConfigMtimeMs: number | null = null;
 
+type ConfigLoadListener = (config: AppConfig) => void;
+const configLoadListeners = new Set<ConfigLoadListener>();
+
+/**
+ * Call `listener` with every config `loadConfig` reads from disk, i.e. at
+ * first load and after the file changes or the cache is invalidated; cache
+ * hits do not notify. Returns a function that removes the listener.
+ */
+export function onConfigLoaded(listener: ConfigLoadListener): () => void {
+  configLoadListeners.add(listener);
+  return () => {
+    configLoadListeners.delete(listener);
+  };
+}
+
 export function loadConfig(configPath?: string): AppConfig {
   const filePath = resolveCliConfigPath(configPath, "read");
 
@@ -245,6 +260,14 @@ export function loadConfig(configPath?: string): AppConfig {
     cachedConfigPath = filePath;
     cachedConfigMtimeMs = mtimeBeforeRead;
 
+    for (const listener of configLoadListeners) {
+      try {
+        listener(finalConfig);
+      } catch {
+        // A listener failure must not fail config loading.
+      }
+    }
+
     return finalConfig;
   } catch (err) {
     if (err instanceof Error && "code" in err && err.code === "ENOENT") {
@@ -1,3 +1,5 @@
+import { recordPhaseDuration } from "../observability/latency-histogram.js";
+
 export const LADYBUG_WRITE_CHUNK_SIZE_LIMIT = 4096;
 
 export const LADYBUG_WRITE_CHUNK_SIZES = {
@@ -36,3 +38,107 @@ export function resolveLadybugWriteChunkSize(
   }
   return chunkSize;
 }
+
+/**
+ * Latency-driven chunk sizing for the incremental UNWIND writers.
+ *
+ * Each kind starts at its fixed default. A chunk slower than the target
+ * halves the size; a run of fast full chunks doubles it, up to the kind's
+ * ceiling. Sizes change between batches, never inside one, so a batch
+ * never mixes chunk shapes. Full index builds load through COPY and do not
+ * pass through here. Set `SDL_MCP_ADAPTIVE_WRITE_CHUNKS=0` to pin the
+ * defaults.
+ */
+const ADAPTIVE_TARGET_CHUNK_MS = 200;
+const ADAPTIVE_FAST_CHUNK_MS = ADAPTIVE_TARGET_CHUNK_MS / 4;
+const ADAPTIVE_GROW_AFTER_FAST_CHUNKS = 4;
+const ADAPTIVE_MIN_CHUNK_SIZE = 16;
+
+const ADAPTIVE_MAX_CHUNK_SIZES: Partial<Record<LadybugWriteBatchKind, number>> =
+  {
+    // Symbol rows are the widest; growth stops well short of the hard limit.
+    symbols: 1024,
+  };
+
+interface AdaptiveChunkState {
+  size: number;
+  fastChunks: number;
+}
+
+const adaptiveChunkStates = new Map<
+  LadybugWriteBatchKind,
+  AdaptiveChunkState
+>();
+
+export function isAdaptiveLadybugWriteChunkingEnabled(
+  env: NodeJS.ProcessEnv = process.env,
+): boolean {
+  return env.SDL_MCP_ADAPTIVE_WRITE_CHUNKS?.trim() !== "0";
+}
+
+function adaptiveChunkState(kind: LadybugWriteBatchKind): AdaptiveChunkState {
+  let state = adaptiveChunkStates.get(kind);
+  if (!state) {
+    state = { size: LADYBUG_WRITE_CHUNK_SIZES[kind], fastChunks: 0 };
+    adaptiveChunkStates.set(kind, state);
+  }
+  return state;
+}
+
+/**
+ * Chunk size for the next batch of `kind`. An explicit `chunkSize` wins and
+ * is validated as in `resolveLadybugWriteChunkSize`.
+ */
+export function adaptiveLadybugWriteChunkSize(
+  kind: LadybugWriteBatchKind,
+  chunkSize?: number,
+): number {
+  if (chunkSize !== undefined || !isAdaptiveLadybugWriteChunkingEnabled()) {
+    return resolveLadybugWriteChunkSize(kind, chunkSize);
+  }
+  return adaptiveChunkState(kind).size;
+}
+
+/**
+ * Feed one written chunk's latency back into the sizing for `kind`. Only
+ * chunks written at the current adaptive size count towards growth; a
+ * short tail chunk says nothing about whether a larger one would fit.
+ */
+export function recordLadybugWriteChunk(
+  kind: LadybugWriteBatchKind,
+  rows: number,
+  elapsedMs: number,
+): void {
+  recordPhaseDuration(`db.writeChunk.${kind}`, elapsedMs);
+  if (!isAdaptiveLadybugWriteChunkingEnabled()) return;
+  const state = adaptiveChunkState(kind);
+  if (elapsedMs > ADAPTIVE_TARGET_CHUNK_MS) {
+    state.size = Math.max(ADAPTIVE_MIN_CHUNK_SIZE, Math.floor(state.size / 2));
+    state.fastChunks = 0;
+    return;
+  }
+  if (rows < state.size || elapsedMs > ADAPTIVE_FAST_CHUNK_MS) {
+    state.fastChunks = 0;
+    return;
+  }
+  state.fastChunks += 1;
+  if (state.fastChunks < ADAPTIVE_GROW_AFTER_FAST_CHUNKS) return;
+  const ceiling =
+    ADAPTIVE_MAX_CHUNK_SIZES[kind] ?? LADYBUG_WRITE_CHUNK_SIZE_LIMIT;
+  state.size = Math.min(ceiling, state.size * 2);
+  state.fastChunks = 0;
+}
+
+/** Current adaptive chunk size per kind that has recorded writes. */
+export function getLadybugWriteChunkSizes(): Partial<
+  Record<LadybugWriteBatchKind, number>
+> {
+  const sizes: Partial<Record<LadybugWriteBatchKind, number>> = {};
+  for (const [kind, state] of adaptiveChunkStates) sizes[kind] = state.size;
+  return sizes;
+}
+
+/** @internal exported for tests; do not import from product code. */
+export function resetLadybugWriteChunkSizing(): void {
+  adaptiveChunkStates.clear();
+}
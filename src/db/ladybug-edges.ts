@@ -25,6 +25,8 @@ import {
   type SymbolPlaceholderMeta,
 } from "./symbol-placeholders.js";
 import {
+  adaptiveLadybugWriteChunkSize,
+  recordLadybugWriteChunk,
   resolveLadybugWriteChunkSize,
   type LadybugWriteChunkOptions,
 } from "./ladybug-batching.js";
@@ -391,8 +393,9 @@ export async function insertEdges(
   });
 
   // UNWIND-batched MERGE: chunked to keep param payload bounded. Side-effect
-  // mode only (no RETURN) to avoid LadybugDB issue #285.
-  const chunkSize = resolveLadybugWriteChunkSize("edges", options?.chunkSize);
+  // mode only (no RETURN) to avoid LadybugDB issue #285. Chunk size adapts to
+  // measured write latency between calls.
+  const chunkSize = adaptiveLadybugWriteChunkSize("edges", options?.chunkSize);
   const writeEdges = async (txConn: Connection): Promise<void> => {
     const edgesByRepo = await measurePhase("groupByRepo", () => {
       const grouped = new Map<string, EdgeRow[]>();
@@ -440,6 +443,7 @@ export async function insertEdges(
       }
 
       for (let i = 0; i < repoEdges.length; i += chunkSize) {
+        const chunkStartedAt = performance.now();
         const edgeChunk = repoEdges.slice(i, i + chunkSize);
         const { rows, sourceEndpointRows, targetEndpointRows, targetRows } =
           await measurePhase("prepareRows", () => {
@@ -634,6 +638,11 @@ export async function insertEdges(
             ),
           );
         }
+        recordLadybugWriteChunk(
+          "edges",
+          edgeChunk.length,
+          performance.now() - chunkStartedAt,
+        );
       }
     }
   };
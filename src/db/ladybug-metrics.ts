@@ -1011,6 +1011,31 @@ export async function getMetricsByRepo(
   return result;
 }
 
+/**
+ * Stored PageRank per symbol of `repoId`, for warm-starting the next
+ * centrality refresh. Symbols without a positive score are omitted.
+ */
+export async function getPageRankByRepo(
+  conn: Connection,
+  repoId: string,
+): Promise<Map<string, number>> {
+  const rows = await queryAll<{ symbolId: string; pageRank: unknown }>(
+    conn,
+    `MATCH (r:Repo {repoId: $repoId})<-[:SYMBOL_IN_REPO]-(s:Symbol)
+     MATCH (m:Metrics {symbolId: s.symbolId})
+     WHERE m.pageRank > 0.0
+     RETURN m.symbolId AS symbolId,
+            m.pageRank AS pageRank`,
+    { repoId },
+  );
+
+  const result = new Map<string, number>();
+  for (const row of rows) {
+    result.set(row.symbolId, toNumber(row.pageRank));
+  }
+  return result;
+}
+
 export async function getTopSymbolsByChurn(
   conn: Connection,
   repoId: string,
@@ -14,7 +14,8 @@ import {
 import { normalizePath } from "../util/paths.js";
 import { DEFAULT_QUERY_LIMIT } from "../config/constants.js";
 import {
-  resolveLadybugWriteChunkSize,
+  adaptiveLadybugWriteChunkSize,
+  recordLadybugWriteChunk,
   type LadybugWriteChunkOptions,
 } from "./ladybug-batching.js";
 import { deleteGraphIntegrityManifestInTransaction } from "./ladybug-graph-integrity.js";
@@ -63,6 +64,12 @@ export interface FileRow {
   byteSize: number;
   lastIndexedAt: string | null;
   directory: string;
+  /**
+   * Fast digest of the same bytes as `contentHash`, in the repo's
+   * `contentFastHashAlgorithm`. Empty or null when unknown. Writes that set
+   * `contentHash` without it clear it, so it never vouches for older bytes.
+   */
+  contentFastHash?: string | null;
 }
 
 function computeDirectory(relPath: string): string {
@@ -399,6 +406,7 @@ export async function upsertFile(
      MERGE (f:File {fileId: $fileId})
      SET f.relPath = $relPath,
          f.contentHash = $contentHash,
+         f.contentFastHash = $contentFastHash,
          f.language = $language,
          f.byteSize = $byteSize,
          f.lastIndexedAt = $lastIndexedAt,
@@ -409,6 +417,7 @@ export async function upsertFile(
       repoId: file.repoId,
       relPath,
       contentHash: file.contentHash,
+      contentFastHash: file.contentFastHash ?? "",
       language: file.language,
       byteSize: file.byteSize,
       lastIndexedAt: file.lastIndexedAt,
@@ -452,9 +461,10 @@ export async function upsertFileBatch(
     return true;
   });
 
-  const chunkSize = resolveLadybugWriteChunkSize("files", options?.chunkSize);
+  const chunkSize = adaptiveLadybugWriteChunkSize("files", options?.chunkSize);
   await withTransaction(conn, async (txConn) => {
     for (let i = 0; i < dedup.length; i += chunkSize) {
+      const chunkStartedAt = performance.now();
       const chunk = dedup.slice(i, i + chunkSize);
       const rows = chunk.map((file) => {
         const relPath = normalizePath(file.relPath);
@@ -463,6 +473,7 @@ export async function upsertFileBatch(
           repoId: file.repoId,
           relPath,
           contentHash: file.contentHash,
+          contentFastHash: file.contentFastHash ?? "",
           language: file.language,
           byteSize: file.byteSize,
           lastIndexedAt: file.lastIndexedAt ?? "",
@@ -477,6 +488,7 @@ export async function upsertFileBatch(
          MERGE (f:File {fileId: row.fileId})
          SET f.relPath = row.relPath,
              f.contentHash = row.contentHash,
+             f.contentFastHash = row.contentFastHash,
              f.language = row.language,
              f.byteSize = row.byteSize,
              f.lastIndexedAt = row.lastIndexedAt,
@@ -494,6 +506,11 @@ export async function upsertFileBatch(
          CREATE (f)-[:FILE_IN_REPO]->(r)`,
         { rows },
       );
+      recordLadybugWriteChunk(
+        "files",
+        chunk.length,
+        performance.now() - chunkStartedAt,
+      );
     }
   });
 }
@@ -511,7 +528,8 @@ export async function getFilesByRepo(
             f.language AS language,
             f.byteSize AS byteSize,
             f.lastIndexedAt AS lastIndexedAt,
-            f.directory AS directory`,
+            f.directory AS directory,
+            f.contentFastHash AS contentFastHash`,
     { repoId },
   );
 
@@ -520,9 +538,67 @@ export async function getFilesByRepo(
     repoId,
     byteSize: toNumber(row.byteSize),
     lastIndexedAt: row.lastIndexedAt ?? null,
+    contentFastHash: row.contentFastHash || null,
   }));
 }
 
+/**
+ * Fast digest algorithm the repo's `File.contentFastHash` values were
+ * written with, or null when none has been recorded.
+ */
+export async function getRepoContentFastHashAlgorithm(
+  conn: Connection,
+  repoId: string,
+): Promise<string | null> {
+  const row = await querySingle<{ algorithm: string | null }>(
+    conn,
+    `MATCH (r:Repo {repoId: $repoId})
+     RETURN r.contentFastHashAlgorithm AS algorithm`,
+    { repoId },
+  );
+  return row?.algorithm || null;
+}
+
+/**
+ * Record fast digests for files whose bytes were confirmed unchanged, and
+ * mark the repo's digests as `algorithm`. Each row only lands while the
+ * stored `contentHash` still equals the one it was computed alongside.
+ */
+export async function recordFileContentFastHashes(
+  conn: Connection,
+  repoId: string,
+  algorithm: string,
+  files: Array<{ fileId: string; contentHash: string; contentFastHash: string }>,
+  options?: UpsertFileBatchOptions,
+): Promise<void> {
+  const chunkSize = adaptiveLadybugWriteChunkSize("files", options?.chunkSize);
+  await withTransaction(conn, async (txConn) => {
+    await exec(
+      txConn,
+      `MATCH (r:Repo {repoId: $repoId})
+       SET r.contentFastHashAlgorithm = $algorithm`,
+      { repoId, algorithm },
+    );
+    for (let i = 0; i < files.length; i += chunkSize) {
+      const chunkStartedAt = performance.now();
+      const rows = files.slice(i, i + chunkSize);
+      await exec(
+        txConn,
+        `UNWIND $rows AS row
+         MATCH (f:File {fileId: row.fileId})
+         WHERE f.contentHash = row.contentHash
+         SET f.contentFastHash = row.contentFastHash`,
+        { rows },
+      );
+      recordLadybugWriteChunk(
+        "files",
+        rows.length,
+        performance.now() - chunkStartedAt,
+      );
+    }
+  });
+}
+
 export async function getFileByRepoPath(
   conn: Connection,
   repoId: string,
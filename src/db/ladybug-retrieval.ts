@@ -58,3 +58,43 @@ export async function findRetrievalSeedSymbolsByName(
     { repoId, name },
   );
 }
+
+export interface RetrievalLexicalRow {
+  symbolId: string;
+  name: string;
+  searchText: string;
+}
+
+/** Page Symbol names and search text in symbol ID order. */
+export async function getRetrievalLexicalRowPage(
+  conn: Connection,
+  repoId: string,
+  options: { afterSymbolId?: string; limit: number },
+): Promise<RetrievalLexicalRow[]> {
+  const hasCursor = options.afterSymbolId !== undefined;
+  const rows = await queryAll<{
+    symbolId: string;
+    name: string | null;
+    searchText: string | null;
+  }>(
+    conn,
+    `MATCH (s:Symbol)
+     WHERE s.repoId = $repoId
+     ${hasCursor ? "AND s.symbolId > $afterSymbolId" : ""}
+     RETURN s.symbolId AS symbolId,
+            s.name AS name,
+            s.searchText AS searchText
+     ORDER BY s.symbolId ASC
+     LIMIT $limit`,
+    {
+      repoId,
+      afterSymbolId: options.afterSymbolId ?? "",
+      limit: options.limit,
+    },
+  );
+  return rows.map((row) => ({
+    symbolId: row.symbolId,
+    name: row.name ?? "",
+    searchText: row.searchText ?? "",
+  }));
+}
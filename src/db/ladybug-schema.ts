@@ -42,7 +42,8 @@ export const NODE_TABLES: string[] = [
     repoId STRING PRIMARY KEY,
     rootPath STRING,
     configJson STRING,
-    createdAt STRING
+    createdAt STRING,
+    contentFastHashAlgorithm STRING
   )`,
 
   `CREATE NODE TABLE IF NOT EXISTS File (
@@ -52,7 +53,8 @@ export const NODE_TABLES: string[] = [
     language STRING,
     byteSize INT64,
     lastIndexedAt STRING,
-    directory STRING
+    directory STRING,
+    contentFastHash STRING
   )`,
 
   `CREATE NODE TABLE IF NOT EXISTS Symbol (
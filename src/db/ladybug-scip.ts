@@ -57,6 +57,43 @@ export async function mergeScipSymbolProperties(
   );
 }
 
+/**
+ * Batch variant of mergeScipSymbolProperties for symbols without package
+ * info (package fields are cleared, as the single-row call does when they
+ * are omitted). One UNWIND per chunk inside a single transaction.
+ */
+export async function batchMergeScipSymbolProperties(
+  conn: Connection,
+  updates: ReadonlyArray<{
+    symbolId: string;
+    scipSymbol: string;
+    source: "both" | "scip";
+  }>,
+): Promise<void> {
+  if (updates.length === 0) return;
+
+  const chunkSize = resolveLadybugWriteChunkSize("symbols", SYMBOL_BATCH_SIZE);
+  await withTransaction(conn, async (txConn) => {
+    for (let i = 0; i < updates.length; i += chunkSize) {
+      const rows = updates.slice(i, i + chunkSize).map((update) => ({
+        symbolId: update.symbolId,
+        scipSymbol: update.scipSymbol,
+        source: update.source,
+      }));
+      await exec(
+        txConn,
+        `UNWIND $rows AS row
+         MATCH (s:Symbol {symbolId: row.symbolId})
+         SET s.scipSymbol = row.scipSymbol,
+             s.source = row.source,
+             s.packageName = NULL,
+             s.packageVersion = NULL`,
+        { rows },
+      );
+    }
+  });
+}
+
 // ---------------------------------------------------------------------------
 // 2. insertScipSymbol — insert a new symbol from SCIP (in-repo or external)
 // ---------------------------------------------------------------------------
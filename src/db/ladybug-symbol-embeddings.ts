@@ -246,6 +246,49 @@ export async function getSymbolEmbeddingsFromNodes(
   return result;
 }
 
+/** One stored embedding blob, as returned by the repo-wide page reader. */
+export interface SymbolEmbeddingBlobRow {
+  symbolId: string;
+  vector: string;
+}
+
+/**
+ * Read one page of stored embedding blobs for the real, non-external symbols
+ * of `repoId`, in symbol ID order. Pass the last `symbolId` of a page as
+ * `afterSymbolId` to read the next one; a short page is the last.
+ */
+export async function getSymbolEmbeddingBlobPage(
+  conn: Connection,
+  repoId: string,
+  model: string,
+  options: { afterSymbolId?: string; limit: number },
+): Promise<SymbolEmbeddingBlobRow[]> {
+  const { vectorProp } = resolvePropertyNames(model);
+  const hasCursor = options.afterSymbolId !== undefined;
+  const rows = await queryAll<{ symbolId: string; vector: string | null }>(
+    conn,
+    `MATCH (s:Symbol)
+     WHERE s.repoId = $repoId
+       AND coalesce(s.symbolStatus, 'real') = 'real'
+       AND coalesce(s.external, false) = false
+       AND s.${vectorProp} IS NOT NULL
+     ${hasCursor ? "AND s.symbolId > $afterSymbolId" : ""}
+     RETURN s.symbolId AS symbolId,
+            s.${vectorProp} AS vector
+     ORDER BY s.symbolId ASC
+     LIMIT $limit`,
+    {
+      repoId,
+      afterSymbolId: options.afterSymbolId ?? "",
+      limit: options.limit,
+    },
+  );
+  return rows.map((row) => ({
+    symbolId: row.symbolId,
+    vector: row.vector ?? "",
+  }));
+}
+
 // ---------------------------------------------------------------------------
 // Write: batch
 // ---------------------------------------------------------------------------
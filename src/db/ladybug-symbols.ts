@@ -27,6 +27,8 @@ import {
   type SymbolStatus,
 } from "./symbol-placeholders.js";
 import {
+  adaptiveLadybugWriteChunkSize,
+  recordLadybugWriteChunk,
   resolveLadybugWriteChunkSize,
   type LadybugWriteChunkOptions,
 } from "./ladybug-batching.js";
@@ -476,8 +478,9 @@ export async function upsertSymbolBatch(
 
   // UNWIND-batched MERGE: collapses N round-trips to one statement per chunk
   // while preserving idempotency (MERGE) and side-effect-only semantics (no
-  // RETURN — avoids LadybugDB issue #285 cardinality bug).
-  const chunkSize = resolveLadybugWriteChunkSize(
+  // RETURN — avoids LadybugDB issue #285 cardinality bug). Chunk size adapts
+  // to measured write latency between calls.
+  const chunkSize = adaptiveLadybugWriteChunkSize(
     "symbols",
     options?.chunkSize,
   );
@@ -485,6 +488,7 @@ export async function upsertSymbolBatch(
     // Coerce nullable STRING fields to '' — kuzu binder picks ANY type when a
     // struct field is uniformly null. Empty string keeps the shape stable.
     for (const rows of symbolBatchRowGroups(symbols, chunkSize)) {
+      const chunkStartedAt = performance.now();
       // Three-pass W3 workaround for LadybugDB UNWIND+MERGE-rel runtime bug:
       // (1) MERGE node + SET props, (2) idempotent SYMBOL_IN_FILE,
       // (3) idempotent SYMBOL_IN_REPO. Plain MERGE-rel inside UNWIND throws
@@ -512,6 +516,11 @@ export async function upsertSymbolBatch(
          CREATE (s)-[:SYMBOL_IN_REPO]->(r)`,
         { rows },
       );
+      recordLadybugWriteChunk(
+        "symbols",
+        rows.length,
+        performance.now() - chunkStartedAt,
+      );
     }
   });
 }
@@ -7,6 +7,7 @@ import {
 } from "../db/ladybug-graph-read.js";
 import { shortestPath } from "../db/ladybug-algorithms.js";
 import { logger } from "../util/logger.js";
+import type { GraphMap } from "./overlay-map.js";
 
 export const LAZY_GRAPH_LOADING_DEFAULT_HOPS = 4;
 export const LAZY_GRAPH_LOADING_MAX_SYMBOLS = 15000;
@@ -73,14 +74,16 @@ export interface NeighborhoodSubgraph {
  *
  * New LadybugDB-backed graph operations should prefer `NeighborhoodSubgraph` or
  * direct Cypher traversal helpers instead of materializing full-repo maps.
+ * Map fields are plain `Map`s after a full load and `OverlayMap`s after a
+ * snapshot patch.
  */
 export interface Graph {
   repoId: RepoId;
-  symbols: Map<SymbolId, SymbolRow>;
+  symbols: GraphMap<SymbolId, SymbolRow>;
   edges: EdgeRow[];
-  adjacencyIn: Map<SymbolId, EdgeRow[]>;
-  adjacencyOut: Map<SymbolId, EdgeRow[]>;
-  metrics?: Map<SymbolId, MetricsRow>;
+  adjacencyIn: GraphMap<SymbolId, EdgeRow[]>;
+  adjacencyOut: GraphMap<SymbolId, EdgeRow[]>;
+  metrics?: GraphMap<SymbolId, MetricsRow>;
   /**
    * Cached centrality stats derived from `metrics`. Pre-computed once when
    * the Graph snapshot is built so repeated beam-search calls on the same
@@ -90,8 +93,8 @@ export interface Graph {
    * `loadRepoCentralityStats` instead.
    */
   centralityStats?: import("./score.js").CentralityStats;
-  files?: Map<number, FileRow>;
-  clusters?: Map<SymbolId, string>;
+  files?: GraphMap<number, FileRow>;
+  clusters?: GraphMap<SymbolId, string>;
 }
 
 export async function getNeighbors(
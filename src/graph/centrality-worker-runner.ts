@@ -1,10 +1,26 @@
 import { Worker } from "node:worker_threads";
 
+import {
+  computeCentralityCsrRust,
+  supportsRustCentrality,
+} from "../indexer/rustIndexer.js";
+import { logger } from "../util/logger.js";
 import type {
   KCoreResult,
   PageRankResult,
 } from "./centrality-algorithms.js";
 import type { CentralityWorkerData } from "./centrality-worker-thread.js";
+import { buildCsrGraph } from "./csr-snapshot.js";
+
+/**
+ * Native PageRank runs, cold or warm, iterate until an iteration moves less
+ * than this much rank (L1). Sharing one stopping rule means a stored vector
+ * is already converged, so a refresh of an unchanged graph stops after one
+ * iteration and returns the stored scores. Cold runs therefore go past the
+ * 20 fixed iterations of `computePageRank`, which the worker fallback uses.
+ */
+const PAGE_RANK_MAX_ITERATIONS = 100;
+const PAGE_RANK_TOLERANCE = 1e-9;
 
 export class CentralityWorkerTimeoutError extends Error {
   constructor(timeoutMs: number) {
@@ -58,3 +74,106 @@ export async function runCentralityWorker(
     });
   });
 }
+
+export interface CentralityRunOptions {
+  /** Last stored PageRank per symbol, used to warm-start the native kernel. */
+  loadPreviousPageRank?: () => Promise<ReadonlyMap<string, number>>;
+  env?: NodeJS.ProcessEnv;
+}
+
+/**
+ * Whether centrality runs in the native kernel when the addon provides it.
+ * On by default; `SDL_MCP_NATIVE_CENTRALITY=0` always uses the worker.
+ */
+export function shouldUseNativeCentrality(
+  env: NodeJS.ProcessEnv = process.env,
+): boolean {
+  return !/^(0|false|no)$/i.test(
+    (env.SDL_MCP_NATIVE_CENTRALITY ?? "").trim(),
+  );
+}
+
+/**
+ * PageRank and k-core for `input`: in the native kernel on the libuv thread
+ * pool when available, otherwise on a worker thread bounded by `timeoutMs`.
+ * The native kernel cannot be interrupted, so `timeoutMs` does not apply to
+ * it; PageRank is bounded by its iteration cap instead.
+ */
+export async function runCentrality(
+  input: CentralityWorkerData,
+  timeoutMs: number,
+  options: CentralityRunOptions = {},
+): Promise<CentralityWorkerResult> {
+  if (shouldUseNativeCentrality(options.env) && supportsRustCentrality()) {
+    const result = await computeCentralityNative(input, options);
+    if (result) return result;
+  }
+  return runCentralityWorker(input, timeoutMs);
+}
+
+async function computeCentralityNative(
+  input: CentralityWorkerData,
+  options: CentralityRunOptions,
+): Promise<CentralityWorkerResult | null> {
+  const graph = buildCsrGraph(input.symbolIds, (emit) => {
+    for (const edge of input.callEdges) emit(edge.callerId, edge.calleeId);
+  });
+  let previous: Float64Array | null = null;
+  if (input.pageRankEnabled && options.loadPreviousPageRank) {
+    try {
+      previous = previousPageRankColumn(
+        graph.symbolIds,
+        await options.loadPreviousPageRank(),
+      );
+    } catch (error) {
+      logger.warn("Could not load previous PageRank; starting cold", {
+        error: error instanceof Error ? error.message : String(error),
+      });
+    }
+  }
+  const result = await computeCentralityCsrRust(
+    graph,
+    {
+      pageRank: input.pageRankEnabled,
+      kCore: input.kCoreEnabled,
+      maxIterations: PAGE_RANK_MAX_ITERATIONS,
+      tolerance: PAGE_RANK_TOLERANCE,
+    },
+    previous,
+  );
+  if (!result) return null;
+  return {
+    pageRank: input.pageRankEnabled
+      ? graph.symbolIds.map((symbolId, node) => ({
+          symbolId,
+          score: result.pageRank[node] ?? 0,
+        }))
+      : [],
+    kCore: input.kCoreEnabled
+      ? graph.symbolIds.map((symbolId, node) => ({
+          symbolId,
+          coreness: result.kCore[node] ?? 0,
+        }))
+      : [],
+  };
+}
+
+/**
+ * Stored PageRank in CSR node order, NaN where unknown; null when no node
+ * has a positive stored score (nothing to warm-start from).
+ */
+export function previousPageRankColumn(
+  symbolIds: readonly string[],
+  stored: ReadonlyMap<string, number>,
+): Float64Array | null {
+  const column = new Float64Array(symbolIds.length).fill(Number.NaN);
+  let known = 0;
+  for (let node = 0; node < symbolIds.length; node++) {
+    const score = stored.get(symbolIds[node]);
+    if (score !== undefined && Number.isFinite(score) && score > 0) {
+      column[node] = score;
+      known++;
+    }
+  }
+  return known > 0 ? column : null;
+}
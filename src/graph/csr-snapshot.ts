@@ -0,0 +1,290 @@
+/**
+ * Compact CSR (compressed sparse row) view of a graph.
+ *
+ * Symbol IDs are interned once into dense `u32` node IDs, in sorted symbol ID
+ * order, and edges are stored column-wise in typed arrays: node `u`'s edges
+ * are `offsets[u]..offsets[u + 1]` of `neighbors` / `weights` / `edgeTypes`,
+ * with each row sorted by neighbor. The native PPR, LPA and process-tracer
+ * kernels read these arrays in place, so a snapshot crosses napi without
+ * per-edge objects or strings, and the JS fallbacks walk the same arrays.
+ *
+ * `getCsrSnapshot` builds the view once per `Graph` object, i.e. once per
+ * `graphSnapshotCache` entry.
+ *
+ * The view is held in addition to the graph's row maps, not instead of
+ * them: slice, beam-search and start-node code still reads `symbols` and
+ * the adjacency maps. A cached snapshot therefore carries about 13 bytes
+ * per edge and 4 bytes per node of typed arrays, plus the symbol ID index,
+ * on top of its rows; `getGraphSnapshotStats` reports the typed-array part
+ * as `csrBytes`.
+ *
+ * @module graph/csr-snapshot
+ */
+
+import type { EdgeType } from "../domain/types.js";
+import type { Graph } from "./buildGraph.js";
+
+/** Edge type codes stored in `CsrGraph.edgeTypes` (index = code). */
+export const CSR_EDGE_TYPES: readonly EdgeType[] = [
+  "call",
+  "import",
+  "config",
+  "implements",
+];
+
+/** Code for edges whose type is missing or unrecognised. */
+const UNKNOWN_EDGE_TYPE = 255;
+
+/** Rows at most this long are sorted in place by insertion sort. */
+const INSERTION_SORT_MAX = 16;
+
+/** Kernel edge-type mask selecting `types` (an empty list selects all). */
+export function csrEdgeTypeMask(...types: EdgeType[]): number {
+  let mask = 0;
+  for (const type of types) {
+    const code = CSR_EDGE_TYPES.indexOf(type);
+    if (code >= 0) mask |= 1 << code;
+  }
+  return mask;
+}
+
+/**
+ * Structural strength of an edge, `weight × confidence` (defaults 1.0).
+ * Negative or non-finite inputs yield 0.
+ */
+export function edgeStrength(weight?: number, confidence?: number): number {
+  const w = weight ?? 1.0;
+  const c = confidence ?? 1.0;
+  if (!Number.isFinite(w) || !Number.isFinite(c)) return 0;
+  return Math.max(0, w) * Math.max(0, Math.min(1, c));
+}
+
+export class CsrGraph {
+  private readonly index: Map<string, number>;
+
+  constructor(
+    /** Dense node ID → symbol ID, ascending. */
+    readonly symbolIds: readonly string[],
+    /** Row boundaries; length `nodeCount + 1`. */
+    readonly offsets: Uint32Array,
+    readonly neighbors: Uint32Array,
+    /** {@link edgeStrength} of each edge. */
+    readonly weights: Float64Array,
+    /** {@link CSR_EDGE_TYPES} code of each edge. */
+    readonly edgeTypes: Uint8Array,
+    /**
+     * `1` for nodes that are edge endpoints but not in the symbol set; only
+     * present when built with `includeUnknownEndpoints`.
+     */
+    readonly external?: Uint8Array,
+  ) {
+    this.index = new Map(symbolIds.map((id, node) => [id, node]));
+  }
+
+  get nodeCount(): number {
+    return this.symbolIds.length;
+  }
+
+  get edgeCount(): number {
+    return this.neighbors.length;
+  }
+
+  /** Bytes held by the typed-array columns. */
+  get byteLength(): number {
+    return (
+      this.offsets.byteLength +
+      this.neighbors.byteLength +
+      this.weights.byteLength +
+      this.edgeTypes.byteLength +
+      (this.external?.byteLength ?? 0)
+    );
+  }
+
+  nodeOf(symbolId: string): number | undefined {
+    return this.index.get(symbolId);
+  }
+}
+
+/**
+ * Whether `node`'s row in `graph` and `previousNode`'s row in `previous` hold
+ * the same edge types to the same symbols, in the same order.
+ */
+export function sameCsrRow(
+  graph: CsrGraph,
+  node: number,
+  previous: CsrGraph,
+  previousNode: number,
+): boolean {
+  const start = graph.offsets[node];
+  const end = graph.offsets[node + 1];
+  const previousStart = previous.offsets[previousNode];
+  if (end - start !== previous.offsets[previousNode + 1] - previousStart) {
+    return false;
+  }
+  for (let e = start, p = previousStart; e < end; e++, p++) {
+    if (
+      graph.edgeTypes[e] !== previous.edgeTypes[p] ||
+      graph.symbolIds[graph.neighbors[e]] !==
+        previous.symbolIds[previous.neighbors[p]]
+    ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+export type CsrEdgeSink = (
+  from: string,
+  to: string,
+  type?: EdgeType,
+  weight?: number,
+  confidence?: number,
+) => void;
+
+/**
+ * Build a CSR graph over `symbolIds`.
+ *
+ * `forEachEdge` is called two or three times and must emit the same edges
+ * each time; this lets callers stream edges out of existing structures
+ * without materialising an intermediate list. Edges with an endpoint outside
+ * `symbolIds` are dropped unless `includeUnknownEndpoints` is set, in which
+ * case those endpoints become nodes flagged in `external`. Self-loops and
+ * duplicate edges are kept; each row's order is by neighbor, then emission.
+ */
+export function buildCsrGraph(
+  symbolIds: Iterable<string>,
+  forEachEdge: (emit: CsrEdgeSink) => void,
+  options: { includeUnknownEndpoints?: boolean } = {},
+): CsrGraph {
+  const known = new Set(symbolIds);
+  const ids = new Set(known);
+  if (options.includeUnknownEndpoints) {
+    forEachEdge((from, to) => {
+      ids.add(from);
+      ids.add(to);
+    });
+  }
+  const sorted = Array.from(ids).sort();
+  const index = new Map<string, number>();
+  for (let node = 0; node < sorted.length; node++) {
+    index.set(sorted[node], node);
+  }
+
+  const n = sorted.length;
+  const offsets = new Uint32Array(n + 1);
+  forEachEdge((from, to) => {
+    const u = index.get(from);
+    if (u === undefined || !index.has(to)) return;
+    offsets[u + 1]++;
+  });
+  for (let u = 0; u < n; u++) offsets[u + 1] += offsets[u];
+
+  const edgeCount = offsets[n];
+  const neighbors = new Uint32Array(edgeCount);
+  const weights = new Float64Array(edgeCount);
+  const edgeTypes = new Uint8Array(edgeCount);
+  const cursor = offsets.slice(0, n);
+  forEachEdge((from, to, type, weight, confidence) => {
+    const u = index.get(from);
+    const v = index.get(to);
+    if (u === undefined || v === undefined) return;
+    const at = cursor[u]++;
+    neighbors[at] = v;
+    weights[at] = edgeStrength(weight, confidence);
+    const code = type === undefined ? -1 : CSR_EDGE_TYPES.indexOf(type);
+    edgeTypes[at] = code >= 0 ? code : UNKNOWN_EDGE_TYPE;
+  });
+
+  for (let u = 0; u < n; u++) {
+    sortRow(neighbors, weights, edgeTypes, offsets[u], offsets[u + 1]);
+  }
+
+  let external: Uint8Array | undefined;
+  if (options.includeUnknownEndpoints) {
+    external = new Uint8Array(n);
+    for (let node = 0; node < n; node++) {
+      if (!known.has(sorted[node])) external[node] = 1;
+    }
+  }
+
+  return new CsrGraph(sorted, offsets, neighbors, weights, edgeTypes, external);
+}
+
+/** Stable sort of `[start, end)` by neighbor, moving the other columns too. */
+function sortRow(
+  neighbors: Uint32Array,
+  weights: Float64Array,
+  edgeTypes: Uint8Array,
+  start: number,
+  end: number,
+): void {
+  const len = end - start;
+  if (len < 2) return;
+  if (len <= INSERTION_SORT_MAX) {
+    for (let i = start + 1; i < end; i++) {
+      const v = neighbors[i];
+      const w = weights[i];
+      const t = edgeTypes[i];
+      let j = i - 1;
+      while (j >= start && neighbors[j] > v) {
+        neighbors[j + 1] = neighbors[j];
+        weights[j + 1] = weights[j];
+        edgeTypes[j + 1] = edgeTypes[j];
+        j--;
+      }
+      neighbors[j + 1] = v;
+      weights[j + 1] = w;
+      edgeTypes[j + 1] = t;
+    }
+    return;
+  }
+
+  let sorted = true;
+  for (let i = start + 1; i < end && sorted; i++) {
+    sorted = neighbors[i - 1] <= neighbors[i];
+  }
+  if (sorted) return;
+
+  const order = Array.from({ length: len }, (_, i) => start + i);
+  order.sort((a, b) => neighbors[a] - neighbors[b] || a - b);
+  const n = order.map((i) => neighbors[i]);
+  const w = order.map((i) => weights[i]);
+  const t = order.map((i) => edgeTypes[i]);
+  neighbors.set(n, start);
+  weights.set(w, start);
+  edgeTypes.set(t, start);
+}
+
+const csrByGraph = new WeakMap<Graph, CsrGraph>();
+
+/**
+ * The CSR view of `graph` (its symbols and `adjacencyOut` edges), built on
+ * first use and then shared by every caller holding the same snapshot.
+ */
+export function getCsrSnapshot(graph: Graph): CsrGraph {
+  let csr = csrByGraph.get(graph);
+  if (!csr) {
+    csr = buildCsrGraph(graph.symbols.keys(), (emit) => {
+      for (const [fromId, edges] of graph.adjacencyOut) {
+        for (const e of edges) {
+          emit(fromId, e.to_symbol_id, e.type, e.weight, e.confidence);
+        }
+      }
+    });
+    csrByGraph.set(graph, csr);
+  }
+  return csr;
+}
+
+/**
+ * Use `csr` as the CSR view of `graph`, e.g. one loaded from a snapshot file
+ * alongside the rows it was built from.
+ */
+export function primeCsrSnapshot(graph: Graph, csr: CsrGraph): void {
+  csrByGraph.set(graph, csr);
+}
+
+/** The CSR view of `graph` if one was already built, without building it. */
+export function peekCsrSnapshot(graph: Graph): CsrGraph | undefined {
+  return csrByGraph.get(graph);
+}
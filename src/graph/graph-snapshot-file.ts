@@ -0,0 +1,639 @@
+/**
+ * Persisted graph snapshots kept next to the graph database.
+ *
+ * Warming `graphSnapshotCache` from LadybugDB reads every symbol, edge,
+ * metric, file and cluster row of the repo, which takes seconds on large
+ * repos and happens again after every server restart. Indexing writes the
+ * same data to `<graph db>.graph-snapshots/<repo>.bin` once derived state is
+ * computed, and a restarted server rebuilds its snapshot from that file.
+ *
+ * The file is a versioned binary layout: a fixed prefix, a JSON header and
+ * 8-byte aligned sections. Every table is stored column-wise (string columns
+ * as `u32` references into one string table, numeric columns as `f64`), and
+ * the CSR view of the graph is stored as-is, so a load is one sequential
+ * read plus typed-array views over it; the CSR columns are used in place.
+ * A file is only used when its version ID matches the repo's latest version.
+ *
+ * The file is read rather than memory-mapped through the native addon's
+ * memmap2 support: the CSR views live as long as the cached snapshot, and
+ * on Windows a mapped file cannot be replaced by the rename that every
+ * rewrite ends with.
+ *
+ * @module graph/graph-snapshot-file
+ */
+
+import { mkdir, readFile, rename, unlink, writeFile } from "fs/promises";
+import { dirname } from "path";
+
+import type { RepoId } from "../domain/types.js";
+import { getLadybugDbPath } from "../db/ladybug.js";
+import { getPackageVersion } from "../util/package-info.js";
+import { logger } from "../util/logger.js";
+import type { Graph } from "./buildGraph.js";
+import { CsrGraph } from "./csr-snapshot.js";
+import type { CentralityStats } from "./score.js";
+
+type SymbolRow = Graph extends { symbols: ReadonlyMap<string, infer S> }
+  ? S
+  : never;
+type EdgeRow = Graph extends { edges: (infer E)[] } ? E : never;
+type MetricsRow = Graph extends { metrics?: ReadonlyMap<string, infer M> }
+  ? M
+  : never;
+type FileRow = Graph extends { files?: ReadonlyMap<number, infer F> }
+  ? F
+  : never;
+
+const MAGIC = "SDLGRAPH";
+const GRAPH_SNAPSHOT_FORMAT_VERSION = 1;
+/** Written in host order; a mismatch means the file came from another host. */
+const BYTE_ORDER_MARK = 0x01020304;
+/** Magic, format version, byte-order mark, header length. */
+const PREFIX_BYTES = MAGIC.length + 12;
+const ALIGNMENT = 8;
+
+/** Edge flag bit set for edges written by the SCIP resolver. */
+const SCIP_EDGE_FLAG = 1;
+
+type ColumnKind = "string" | "number";
+type Columns<Row> = ReadonlyArray<readonly [keyof Row & string, ColumnKind]>;
+
+/** The fields `graphSnapshotCache` fills on each legacy row. */
+const SYMBOL_COLUMNS: Columns<SymbolRow> = [
+  ["symbol_id", "string"],
+  ["repo_id", "string"],
+  ["file_id", "number"],
+  ["kind", "string"],
+  ["name", "string"],
+  ["exported", "number"],
+  ["visibility", "string"],
+  ["language", "string"],
+  ["range_start_line", "number"],
+  ["range_start_col", "number"],
+  ["range_end_line", "number"],
+  ["range_end_col", "number"],
+  ["ast_fingerprint", "string"],
+  ["signature_json", "string"],
+  ["summary", "string"],
+  ["invariants_json", "string"],
+  ["side_effects_json", "string"],
+  ["external", "number"],
+  ["package_name", "string"],
+  ["package_version", "string"],
+  ["scip_symbol", "string"],
+  ["updated_at", "string"],
+];
+
+const EDGE_COLUMNS: Columns<EdgeRow> = [
+  ["from_symbol_id", "string"],
+  ["to_symbol_id", "string"],
+  ["type", "string"],
+  ["weight", "number"],
+  ["confidence", "number"],
+];
+
+const METRICS_COLUMNS: Columns<MetricsRow> = [
+  ["symbol_id", "string"],
+  ["fan_in", "number"],
+  ["fan_out", "number"],
+  ["churn_30d", "number"],
+  ["test_refs_json", "string"],
+  ["canonical_test_json", "string"],
+  ["page_rank", "number"],
+  ["k_core", "number"],
+  ["updated_at", "string"],
+];
+
+const FILE_COLUMNS: Columns<FileRow> = [
+  ["file_id", "number"],
+  ["repo_id", "string"],
+  ["rel_path", "string"],
+  ["content_hash", "string"],
+  ["language", "string"],
+  ["byte_size", "number"],
+  ["last_indexed_at", "string"],
+  ["directory", "string"],
+];
+
+interface ClusterRow {
+  symbol_id: string;
+  cluster_id: string;
+}
+
+const CLUSTER_COLUMNS: Columns<ClusterRow> = [
+  ["symbol_id", "string"],
+  ["cluster_id", "string"],
+];
+
+interface GraphSnapshotFileHeader {
+  repoId: RepoId;
+  versionId: string;
+  engineVersion: string;
+  counts: {
+    symbols: number;
+    edges: number;
+    metrics: number;
+    files: number;
+    clusters: number;
+    csrNodes: number;
+    csrEdges: number;
+  };
+  centralityStats: CentralityStats | null;
+  /** Section name → [byte offset from the data start, byte length]. */
+  sections: Record<string, [number, number]>;
+}
+
+/** Everything needed to rebuild a snapshot, as stored in the file. */
+export interface GraphSnapshotFileContents {
+  repoId: RepoId;
+  versionId: string;
+  symbols: SymbolRow[];
+  /** In the order they were loaded; adjacency lists follow this order. */
+  edges: EdgeRow[];
+  scipEdges: WeakSet<EdgeRow>;
+  metrics: MetricsRow[];
+  files: FileRow[];
+  clusters: Map<string, string>;
+  centralityStats: CentralityStats | undefined;
+  /** CSR view of the graph whose columns are views over the file bytes. */
+  csr: CsrGraph;
+}
+
+/**
+ * Graph snapshot files are written and read by default whenever a graph
+ * database is open. Set SDL_MCP_GRAPH_SNAPSHOT_FILE=0 to always warm
+ * snapshots from LadybugDB.
+ */
+export function shouldUseGraphSnapshotFile(
+  env: NodeJS.ProcessEnv = process.env,
+): boolean {
+  return !/^(0|false|no)$/i.test(
+    (env.SDL_MCP_GRAPH_SNAPSHOT_FILE ?? "").trim(),
+  );
+}
+
+/** `<graph db>.graph-snapshots/<repo>.bin` */
+export function resolveGraphSnapshotPath(
+  graphDbPath: string,
+  repoId: RepoId,
+): string {
+  return `${graphDbPath}.graph-snapshots/${encodeURIComponent(repoId)}.bin`;
+}
+
+/**
+ * The snapshot file path for `repoId` next to the open graph database, or
+ * null when snapshot files are disabled or no database is open.
+ */
+export function graphSnapshotPathFor(repoId: RepoId): string | null {
+  if (!shouldUseGraphSnapshotFile()) return null;
+  const graphDbPath = getLadybugDbPath();
+  return graphDbPath ? resolveGraphSnapshotPath(graphDbPath, repoId) : null;
+}
+
+// ---------------------------------------------------------------------------
+// Encoding
+// ---------------------------------------------------------------------------
+
+class StringTable {
+  private readonly refs = new Map<string, number>();
+  private readonly values: string[] = [];
+
+  /** `0` for null, otherwise the string's index plus one. */
+  ref(value: unknown): number {
+    if (value === null || value === undefined) return 0;
+    const text = String(value);
+    let ref = this.refs.get(text);
+    if (ref === undefined) {
+      this.values.push(text);
+      ref = this.values.length;
+      this.refs.set(text, ref);
+    }
+    return ref;
+  }
+
+  encode(): { offsets: Uint32Array; bytes: Uint8Array } {
+    const encoder = new TextEncoder();
+    const encoded = this.values.map((value) => encoder.encode(value));
+    const offsets = new Uint32Array(encoded.length + 1);
+    for (let i = 0; i < encoded.length; i++) {
+      offsets[i + 1] = offsets[i] + encoded[i].length;
+    }
+    const bytes = new Uint8Array(offsets[encoded.length]);
+    for (let i = 0; i < encoded.length; i++) bytes.set(encoded[i], offsets[i]);
+    return { offsets, bytes };
+  }
+}
+
+class SectionWriter {
+  readonly sections: Record<string, [number, number]> = {};
+  private readonly chunks: Uint8Array[] = [];
+  private length = 0;
+
+  add(name: string, view: ArrayBufferView): void {
+    const padding = alignUp(this.length) - this.length;
+    if (padding > 0) {
+      this.chunks.push(new Uint8Array(padding));
+      this.length += padding;
+    }
+    this.sections[name] = [this.length, view.byteLength];
+    this.chunks.push(
+      new Uint8Array(view.buffer, view.byteOffset, view.byteLength),
+    );
+    this.length += view.byteLength;
+  }
+
+  get byteLength(): number {
+    return this.length;
+  }
+
+  writeTo(target: Uint8Array, at: number): void {
+    for (const chunk of this.chunks) {
+      target.set(chunk, at);
+      at += chunk.length;
+    }
+  }
+}
+
+function addTable<Row>(
+  writer: SectionWriter,
+  strings: StringTable,
+  table: string,
+  rows: readonly Row[],
+  columns: Columns<Row>,
+): void {
+  for (const [field, kind] of columns) {
+    if (kind === "string") {
+      const refs = new Uint32Array(rows.length);
+      for (let i = 0; i < rows.length; i++) {
+        refs[i] = strings.ref(rows[i][field]);
+      }
+      writer.add(`${table}.${field}`, refs);
+    } else {
+      const values = new Float64Array(rows.length);
+      for (let i = 0; i < rows.length; i++) {
+        const value = rows[i][field];
+        values[i] =
+          value === null || value === undefined ? NaN : Number(value);
+      }
+      writer.add(`${table}.${field}`, values);
+    }
+  }
+}
+
+/**
+ * Encode `graph` and its CSR view as a snapshot of `versionId`. Edges in
+ * `scipEdges` keep their SCIP identity when the file is loaded.
+ */
+export function encodeGraphSnapshot(
+  graph: Graph,
+  csr: CsrGraph,
+  options: { versionId: string; scipEdges: WeakSet<EdgeRow> },
+): Uint8Array {
+  const strings = new StringTable();
+  const writer = new SectionWriter();
+  const symbols = Array.from(graph.symbols.values());
+  const metrics = Array.from(graph.metrics?.values() ?? []);
+  const files = Array.from(graph.files?.values() ?? []);
+  const clusters = Array.from(
+    graph.clusters ?? [],
+    ([symbol_id, cluster_id]): ClusterRow => ({ symbol_id, cluster_id }),
+  );
+
+  addTable(writer, strings, "symbols", symbols, SYMBOL_COLUMNS);
+  addTable(writer, strings, "edges", graph.edges, EDGE_COLUMNS);
+  const edgeFlags = new Uint8Array(graph.edges.length);
+  for (let i = 0; i < graph.edges.length; i++) {
+    if (options.scipEdges.has(graph.edges[i])) edgeFlags[i] = SCIP_EDGE_FLAG;
+  }
+  writer.add("edges.flags", edgeFlags);
+  addTable(writer, strings, "metrics", metrics, METRICS_COLUMNS);
+  addTable(writer, strings, "files", files, FILE_COLUMNS);
+  addTable(writer, strings, "clusters", clusters, CLUSTER_COLUMNS);
+
+  writer.add(
+    "csr.symbolIds",
+    Uint32Array.from(csr.symbolIds, (id) => strings.ref(id)),
+  );
+  writer.add("csr.offsets", csr.offsets);
+  writer.add("csr.neighbors", csr.neighbors);
+  writer.add("csr.weights", csr.weights);
+  writer.add("csr.edgeTypes", csr.edgeTypes);
+
+  const table = strings.encode();
+  writer.add("strings.offsets", table.offsets);
+  writer.add("strings.bytes", table.bytes);
+
+  const header: GraphSnapshotFileHeader = {
+    repoId: graph.repoId,
+    versionId: options.versionId,
+    engineVersion: getPackageVersion(),
+    counts: {
+      symbols: symbols.length,
+      edges: graph.edges.length,
+      metrics: metrics.length,
+      files: files.length,
+      clusters: clusters.length,
+      csrNodes: csr.nodeCount,
+      csrEdges: csr.edgeCount,
+    },
+    centralityStats: graph.centralityStats ?? null,
+    sections: writer.sections,
+  };
+  const headerBytes = new TextEncoder().encode(JSON.stringify(header));
+  const dataStart = alignUp(PREFIX_BYTES + headerBytes.length);
+  const bytes = new Uint8Array(dataStart + writer.byteLength);
+  const prefix = new DataView(bytes.buffer);
+  for (let i = 0; i < MAGIC.length; i++) bytes[i] = MAGIC.charCodeAt(i);
+  prefix.setUint32(MAGIC.length, GRAPH_SNAPSHOT_FORMAT_VERSION, true);
+  new Uint32Array(bytes.buffer, MAGIC.length + 4, 1)[0] = BYTE_ORDER_MARK;
+  prefix.setUint32(MAGIC.length + 8, headerBytes.length, true);
+  bytes.set(headerBytes, PREFIX_BYTES);
+  writer.writeTo(bytes, dataStart);
+  return bytes;
+}
+
+// ---------------------------------------------------------------------------
+// Decoding
+// ---------------------------------------------------------------------------
+
+class GraphSnapshotFormatError extends Error {}
+
+function corrupt(detail: string): never {
+  throw new GraphSnapshotFormatError(`graph snapshot is corrupt: ${detail}`);
+}
+
+type ColumnArray = Uint32Array | Float64Array | Uint8Array;
+type ColumnConstructor<T extends ColumnArray> = {
+  new (buffer: ArrayBufferLike, byteOffset: number, length: number): T;
+  readonly BYTES_PER_ELEMENT: number;
+};
+
+class SnapshotReader {
+  readonly header: GraphSnapshotFileHeader;
+  private readonly dataStart: number;
+  private strings: (string | null)[] = [];
+
+  constructor(private readonly bytes: Uint8Array) {
+    if (bytes.length < PREFIX_BYTES) corrupt("truncated prefix");
+    for (let i = 0; i < MAGIC.length; i++) {
+      if (bytes[i] !== MAGIC.charCodeAt(i)) corrupt("bad magic");
+    }
+    const prefix = new DataView(bytes.buffer, bytes.byteOffset, PREFIX_BYTES);
+    const formatVersion = prefix.getUint32(MAGIC.length, true);
+    if (formatVersion !== GRAPH_SNAPSHOT_FORMAT_VERSION) {
+      corrupt(`unsupported format version ${formatVersion}`);
+    }
+    const byteOrder = new Uint32Array(
+      bytes.slice(MAGIC.length + 4, MAGIC.length + 8).buffer,
+    )[0];
+    if (byteOrder !== BYTE_ORDER_MARK) corrupt("foreign byte order");
+    const headerLength = prefix.getUint32(MAGIC.length + 8, true);
+    if (PREFIX_BYTES + headerLength > bytes.length) {
+      corrupt("truncated header");
+    }
+    this.header = JSON.parse(
+      new TextDecoder().decode(
+        bytes.subarray(PREFIX_BYTES, PREFIX_BYTES + headerLength),
+      ),
+    ) as GraphSnapshotFileHeader;
+    this.dataStart = alignUp(PREFIX_BYTES + headerLength);
+  }
+
+  section<T extends ColumnArray>(
+    name: string,
+    Column: ColumnConstructor<T>,
+    expectedLength?: number,
+  ): T {
+    const entry = this.header.sections?.[name];
+    if (!entry) corrupt(`missing section ${name}`);
+    const [offset, byteLength] = entry;
+    const start = this.bytes.byteOffset + this.dataStart + offset;
+    if (
+      this.dataStart + offset + byteLength > this.bytes.length ||
+      start % Column.BYTES_PER_ELEMENT !== 0 ||
+      byteLength % Column.BYTES_PER_ELEMENT !== 0
+    ) {
+      corrupt(`section ${name} is out of bounds`);
+    }
+    const column = new Column(
+      this.bytes.buffer,
+      start,
+      byteLength / Column.BYTES_PER_ELEMENT,
+    );
+    if (expectedLength !== undefined && column.length !== expectedLength) {
+      corrupt(`section ${name} has ${column.length} entries`);
+    }
+    return column;
+  }
+
+  /** Decode the string table; every later `string` lookup indexes it. */
+  loadStrings(): void {
+    const offsets = this.section("strings.offsets", Uint32Array);
+    const bytes = this.section("strings.bytes", Uint8Array);
+    if (offsets.length === 0 || offsets[offsets.length - 1] !== bytes.length) {
+      corrupt("string table offsets");
+    }
+    const decoder = new TextDecoder();
+    const strings: (string | null)[] = [null];
+    for (let i = 0; i + 1 < offsets.length; i++) {
+      if (offsets[i] > offsets[i + 1]) corrupt("string table offsets");
+      strings.push(decoder.decode(bytes.subarray(offsets[i], offsets[i + 1])));
+    }
+    this.strings = strings;
+  }
+
+  string(ref: number): string | null {
+    if (ref >= this.strings.length) corrupt(`string ref ${ref}`);
+    return this.strings[ref];
+  }
+
+  table<Row>(table: string, count: number, columns: Columns<Row>): Row[] {
+    const rows = Array.from({ length: count }, () => ({}) as Row);
+    for (const [field, kind] of columns) {
+      const name = `${table}.${field}`;
+      if (kind === "string") {
+        const refs = this.section(name, Uint32Array, count);
+        for (let i = 0; i < count; i++) {
+          (rows[i] as Record<string, unknown>)[field] = this.string(refs[i]);
+        }
+      } else {
+        const values = this.section(name, Float64Array, count);
+        for (let i = 0; i < count; i++) {
+          const value = values[i];
+          (rows[i] as Record<string, unknown>)[field] = Number.isNaN(value)
+            ? null
+            : value;
+        }
+      }
+    }
+    return rows;
+  }
+}
+
+/** The repo and version a snapshot file was written for. */
+export function readGraphSnapshotVersion(
+  bytes: Uint8Array,
+): { repoId: RepoId; versionId: string; symbolCount: number } | null {
+  try {
+    const { header } = new SnapshotReader(bytes);
+    if (header.engineVersion !== getPackageVersion()) return null;
+    return {
+      repoId: header.repoId,
+      versionId: header.versionId,
+      symbolCount: header.counts.symbols,
+    };
+  } catch {
+    return null;
+  }
+}
+
+/**
+ * Decode a snapshot file. Returns null for files written by another package
+ * version; throws when the file is corrupt.
+ */
+export function decodeGraphSnapshot(
+  bytes: Uint8Array,
+): GraphSnapshotFileContents | null {
+  const reader = new SnapshotReader(bytes);
+  const { header } = reader;
+  if (header.engineVersion !== getPackageVersion()) return null;
+  const { counts } = header;
+  reader.loadStrings();
+
+  const symbols = reader.table("symbols", counts.symbols, SYMBOL_COLUMNS);
+  const edges = reader.table("edges", counts.edges, EDGE_COLUMNS);
+  const edgeFlags = reader.section("edges.flags", Uint8Array, counts.edges);
+  const scipEdges = new WeakSet<EdgeRow>();
+  for (let i = 0; i < edges.length; i++) {
+    if (edgeFlags[i] & SCIP_EDGE_FLAG) scipEdges.add(edges[i]);
+  }
+  const metrics = reader.table("metrics", counts.metrics, METRICS_COLUMNS);
+  const files = reader.table("files", counts.files, FILE_COLUMNS);
+  const clusters = new Map<string, string>();
+  for (const row of reader.table(
+    "clusters",
+    counts.clusters,
+    CLUSTER_COLUMNS,
+  )) {
+    clusters.set(row.symbol_id, row.cluster_id);
+  }
+
+  const csrRefs = reader.section("csr.symbolIds", Uint32Array, counts.csrNodes);
+  const csrSymbolIds = Array.from(csrRefs, (ref) => {
+    const id = reader.string(ref);
+    if (id === null) corrupt("null CSR symbol");
+    return id;
+  });
+  const offsets = reader.section(
+    "csr.offsets",
+    Uint32Array,
+    counts.csrNodes + 1,
+  );
+  const neighbors = reader.section(
+    "csr.neighbors",
+    Uint32Array,
+    counts.csrEdges,
+  );
+  if (offsets[0] !== 0 || offsets[counts.csrNodes] !== counts.csrEdges) {
+    corrupt("CSR offsets");
+  }
+  for (let node = 0; node < counts.csrNodes; node++) {
+    if (offsets[node] > offsets[node + 1]) corrupt("CSR offsets");
+  }
+  for (const neighbor of neighbors) {
+    if (neighbor >= counts.csrNodes) corrupt("CSR neighbor");
+  }
+  const csr = new CsrGraph(
+    csrSymbolIds,
+    offsets,
+    neighbors,
+    reader.section("csr.weights", Float64Array, counts.csrEdges),
+    reader.section("csr.edgeTypes", Uint8Array, counts.csrEdges),
+  );
+
+  return {
+    repoId: header.repoId,
+    versionId: header.versionId,
+    symbols,
+    edges,
+    scipEdges,
+    metrics,
+    files,
+    clusters,
+    centralityStats: header.centralityStats ?? undefined,
+    csr,
+  };
+}
+
+// ---------------------------------------------------------------------------
+// Files
+// ---------------------------------------------------------------------------
+
+/**
+ * Read a snapshot file into one buffer whose start is aligned for every
+ * column type. Missing or unreadable files yield null.
+ */
+export async function readGraphSnapshotFile(
+  path: string,
+): Promise<Uint8Array | null> {
+  try {
+    const bytes = await readFile(path);
+    if (bytes.byteOffset % ALIGNMENT === 0) return bytes;
+    return new Uint8Array(bytes);
+  } catch (err) {
+    const code = (err as NodeJS.ErrnoException).code;
+    if (code !== "ENOENT") {
+      logger.debug("graph snapshot file read failed", {
+        snapshotPath: path,
+        error: err instanceof Error ? err.message : String(err),
+      });
+    }
+    return null;
+  }
+}
+
+/**
+ * Replace the snapshot file atomically, so readers never see a partial
+ * file. Failures are logged, never thrown.
+ */
+export async function writeGraphSnapshotFile(
+  path: string,
+  bytes: Uint8Array,
+): Promise<boolean> {
+  const tempPath = `${path}.${process.pid}.${Date.now()}.tmp`;
+  try {
+    await mkdir(dirname(path), { recursive: true });
+    await writeFile(tempPath, bytes);
+    await rename(tempPath, path);
+    return true;
+  } catch (err) {
+    logger.debug("graph snapshot file write failed", {
+      snapshotPath: path,
+      error: err instanceof Error ? err.message : String(err),
+    });
+    await unlink(tempPath).catch(() => undefined);
+    return false;
+  }
+}
+
+/**
+ * Delete the repo's snapshot file. Called when the graph changes without a
+ * new version (live saves until the file is rewritten, repo removal), which
+ * the version check on load cannot see.
+ */
+export async function discardGraphSnapshotFile(repoId: RepoId): Promise<void> {
+  const path = graphSnapshotPathFor(repoId);
+  if (!path) return;
+  await unlink(path).catch((err: NodeJS.ErrnoException) => {
+    if (err.code !== "ENOENT") {
+      logger.debug("graph snapshot file delete failed", {
+        snapshotPath: path,
+        error: err.message,
+      });
+    }
+  });
+}
+
+function alignUp(value: number): number {
+  return Math.ceil(value / ALIGNMENT) * ALIGNMENT;
+}
@@ -6,7 +6,17 @@
  * the DB-backed beamSearchLadybug when a recent snapshot is available.
  *
  * Snapshots are populated by explicit warm-up callers. Subsequent builds within
- * the TTL window reuse the cached graph.
+ * the TTL window reuse the cached graph. Live-index saves patch the cached
+ * snapshot copy-on-write (`applyGraphSnapshotPatch`) instead of dropping it,
+ * so the graph stays current between full loads. Patched maps are
+ * `OverlayMap`s over the loaded ones and the edge list is rebuilt on first
+ * read, so a patch costs the rows it changes.
+ *
+ * Full loads first try the repo's persisted snapshot file
+ * (`graph-snapshot-file.ts`), written when indexing finalizes derived state,
+ * and only read LadybugDB when the file is missing or belongs to an older
+ * version. Live patches remove the file and rewrite it from the patched
+ * snapshot once saves go quiet (`scheduleGraphSnapshotFileRewrite`).
  *
  * @module graph/graphSnapshotCache
  */
@@ -14,8 +24,25 @@
 import type { Connection } from "kuzu";
 import type { RepoId, SymbolId, EdgeType } from "../domain/types.js";
 import type { Graph } from "./buildGraph.js";
+import { OverlayMap, type GraphMap } from "./overlay-map.js";
+import {
+  getCsrSnapshot,
+  peekCsrSnapshot,
+  primeCsrSnapshot,
+  type CsrGraph,
+} from "./csr-snapshot.js";
+import {
+  decodeGraphSnapshot,
+  discardGraphSnapshotFile,
+  encodeGraphSnapshot,
+  graphSnapshotPathFor,
+  readGraphSnapshotFile,
+  readGraphSnapshotVersion,
+  writeGraphSnapshotFile,
+} from "./graph-snapshot-file.js";
 import { computeCentralityStats } from "./score.js";
 import * as ladybugDb from "../db/ladybug-queries.js";
+import { getLadybugConn } from "../db/ladybug.js";
 import { logger } from "../util/logger.js";
 import {
   captureActiveRepoEpoch,
@@ -25,20 +52,49 @@ import {
 // ---------------------------------------------------------------------------
 // Legacy SymbolRow / EdgeRow shapes for the in-memory Graph interface
 // ---------------------------------------------------------------------------
-type SymbolRow = Graph extends { symbols: Map<string, infer S> } ? S : never;
+type SymbolRow = Graph extends { symbols: ReadonlyMap<string, infer S> }
+  ? S
+  : never;
 type EdgeRow = Graph extends { edges: (infer E)[] } ? E : never;
-type MetricsRow = Graph extends { metrics?: Map<string, infer M> } ? M : never;
-type FileRow = Graph extends { files?: Map<number, infer F> } ? F : never;
+type MetricsRow = Graph extends { metrics?: ReadonlyMap<string, infer M> }
+  ? M
+  : never;
+type FileRow = Graph extends { files?: ReadonlyMap<number, infer F> }
+  ? F
+  : never;
 
 interface GraphSnapshot {
   graph: Graph;
   repoEpoch: number;
+  /** Identity of this graph version; patches assign a new one. */
   createdAt: number;
+  /** When the graph was last fully loaded; the TTL runs from here. */
+  loadedAt: number;
+  /** Edges written by the SCIP resolver, which saved-file patches keep. */
+  scipEdges: WeakSet<EdgeRow>;
+  /** Edge changes since the last full edge list; set once patched. */
+  edgeLog?: EdgeLog;
+  /** Numeric file ids by path; built by the first patch. */
+  fileIds?: Map<string, number>;
+  nextFileId?: number;
   symbolCount: number;
   edgeCount: number;
   clusterCount: number;
 }
 
+/**
+ * A patched snapshot's edge list as the edges of the last full list minus
+ * `dropped` plus `added`, so a patch does not copy every edge.
+ */
+interface EdgeLog {
+  base: EdgeRow[];
+  dropped: Set<EdgeRow>;
+  added: EdgeRow[];
+}
+
+/** Edge logs larger than this fraction of their base are materialized. */
+const MAX_EDGE_LOG_RATIO = 0.25;
+
 // ---------------------------------------------------------------------------
 // Configuration
 // ---------------------------------------------------------------------------
@@ -51,11 +107,47 @@ let maxSnapshotSymbols = 15_000;
 
 const MAX_CACHED_REPOS = 3;
 const snapshotsByRepo = new Map<RepoId, GraphSnapshot>();
+
+/** Snapshot `createdAt` values remembered per lineage. */
+const MAX_LINEAGE_SNAPSHOTS = 16;
+
+/**
+ * Snapshots of a repo that replaced each other without an invalidation,
+ * i.e. TTL rebuilds. Live-index deltas between them are invalidated symbol
+ * by symbol, so a cache entry computed on one is still valid on the next.
+ * `invalidateGraphSnapshot` and epoch changes start a new lineage.
+ */
+const lineageByRepo = new Map<
+  RepoId,
+  { repoEpoch: number; createdAts: number[] }
+>();
 const loadingPromises = new Map<
   RepoId,
   { repoEpoch: number; promise: Promise<Graph | null> }
 >();
 
+/**
+ * Count of patches seen per repo. A load that started before a patch may
+ * have read the pre-patch rows, so it is not cached.
+ */
+const patchSeqByRepo = new Map<RepoId, number>();
+
+/** Quiet period after a live patch before the snapshot file is rewritten. */
+const SNAPSHOT_FILE_REWRITE_DELAY_MS = 2_000;
+
+/**
+ * A repo whose snapshot file was removed by a live patch and is due to be
+ * rewritten. The entry is dropped once a rewrite lands with no patch after
+ * it.
+ */
+interface SnapshotFileRewrite {
+  timer: NodeJS.Timeout | null;
+  running: Promise<void> | null;
+  /** A patch landed while `running` was writing. */
+  dirty: boolean;
+}
+const snapshotFileRewrites = new Map<RepoId, SnapshotFileRewrite>();
+
 /**
  * Configure cache settings.
  */
@@ -84,14 +176,15 @@ export function getGraphSnapshot(repoId: RepoId): Graph | null {
 
   if (!isRepoEpochCurrent(repoId, entry.repoEpoch)) {
     snapshotsByRepo.delete(repoId);
+    lineageByRepo.delete(repoId);
     return null;
   }
 
-  if (Date.now() - entry.createdAt > snapshotTtlMs) {
+  if (Date.now() - entry.loadedAt > snapshotTtlMs) {
     snapshotsByRepo.delete(repoId);
     logger.debug("Graph snapshot expired", {
       repoId,
-      ageMs: Date.now() - entry.createdAt,
+      ageMs: Date.now() - entry.loadedAt,
     });
     return null;
   }
@@ -107,10 +200,37 @@ export function getGraphSnapshot(repoId: RepoId): Graph | null {
 export function getGraphSnapshotCreatedAt(repoId: RepoId): number | null {
   const entry = snapshotsByRepo.get(repoId);
   if (!entry) return null;
-  if (Date.now() - entry.createdAt > snapshotTtlMs) return null;
+  if (Date.now() - entry.loadedAt > snapshotTtlMs) return null;
   return entry.createdAt;
 }
 
+/**
+ * True when the snapshots created at `earlier` and `later` belong to the
+ * same lineage, so results cached against `earlier` whose symbols no delta
+ * touched can be served for `later`.
+ */
+export function sharesGraphSnapshotLineage(
+  repoId: RepoId,
+  earlier: number,
+  later: number,
+): boolean {
+  const lineage = lineageByRepo.get(repoId);
+  if (!lineage || !isRepoEpochCurrent(repoId, lineage.repoEpoch)) {
+    return false;
+  }
+  return (
+    lineage.createdAts.includes(earlier) && lineage.createdAts.includes(later)
+  );
+}
+
+/**
+ * The compact CSR view of the cached snapshot, or null when no live snapshot
+ * exists. Built on first request and shared until the snapshot is replaced.
+ */
+export function getGraphSnapshotCsr(repoId: RepoId): CsrGraph | null {
+  const graph = getGraphSnapshot(repoId);
+  return graph ? getCsrSnapshot(graph) : null;
+}
 
 /**
  * Check if a valid snapshot exists without returning it.
@@ -126,6 +246,7 @@ export function setGraphSnapshot(
   repoId: RepoId,
   graph: Graph,
   expectedEpoch = captureActiveRepoEpoch(repoId),
+  scipEdges: WeakSet<EdgeRow> = new WeakSet(),
 ): boolean {
   if (
     expectedEpoch === undefined ||
@@ -133,10 +254,13 @@ export function setGraphSnapshot(
   ) {
     return false;
   }
+  const createdAt = pushLineage(repoId, expectedEpoch);
   snapshotsByRepo.set(repoId, {
     graph,
     repoEpoch: expectedEpoch,
-    createdAt: Date.now(),
+    createdAt,
+    loadedAt: Date.now(),
+    scipEdges,
     symbolCount: graph.symbols.size,
     edgeCount: graph.edges.length,
     clusterCount: graph.clusters?.size ?? 0,
@@ -167,20 +291,230 @@ export function setGraphSnapshot(
   return true;
 }
 
+/**
+ * Record a new snapshot version in the repo's lineage and return its
+ * `createdAt`, kept strictly increasing so a patch landing in the same
+ * millisecond as the load still gets its own identity.
+ */
+function pushLineage(repoId: RepoId, repoEpoch: number): number {
+  let lineage = lineageByRepo.get(repoId);
+  if (!lineage || lineage.repoEpoch !== repoEpoch) {
+    lineage = { repoEpoch, createdAts: [] };
+    lineageByRepo.set(repoId, lineage);
+  }
+  const last = lineage.createdAts[lineage.createdAts.length - 1] ?? 0;
+  const createdAt = Math.max(Date.now(), last + 1);
+  lineage.createdAts.push(createdAt);
+  if (lineage.createdAts.length > MAX_LINEAGE_SNAPSHOTS) {
+    lineage.createdAts.shift();
+  }
+  return createdAt;
+}
+
+/**
+ * One saved file's committed changes, in LadybugDB row shapes.
+ */
+export interface GraphSnapshotPatch {
+  file: ladybugDb.FileRow;
+  /** Symbols written for the file, matched ones under their stable IDs. */
+  symbols: ladybugDb.SymbolRow[];
+  removedSymbolIds: SymbolId[];
+  /** Symbols whose non-SCIP outgoing edges were replaced by `edges`. */
+  refreshedSymbolIds: SymbolId[];
+  /** Outgoing edges of `symbols` as inserted. */
+  edges: ladybugDb.EdgeRow[];
+}
+
+/**
+ * Apply a saved-file patch to the cached snapshot, mirroring the writes
+ * `patchSavedFile` made: refreshed symbols lose their non-SCIP outgoing
+ * edges, removed symbols lose all their edges, then the new rows and edges
+ * are added. Matched symbols keep their package and SCIP identity.
+ *
+ * The update is copy-on-write. The patched snapshot is a new `Graph` whose
+ * maps are `OverlayMap`s sharing every untouched row and adjacency list,
+ * and whose `edges` list is built on first read; readers holding the
+ * previous graph are unaffected. A patch costs the rows it touches plus
+ * the overlay carried since the last full load. Metrics, clusters and
+ * centrality stats are shared as-is until the next full load.
+ *
+ * Returns false when no live snapshot exists for the repo.
+ */
+export function applyGraphSnapshotPatch(
+  repoId: RepoId,
+  patch: GraphSnapshotPatch,
+): boolean {
+  patchSeqByRepo.set(repoId, (patchSeqByRepo.get(repoId) ?? 0) + 1);
+  const entry = snapshotsByRepo.get(repoId);
+  if (!entry || getGraphSnapshot(repoId) === null) return false;
+
+  const base = entry.graph;
+  const symbols = OverlayMap.over(base.symbols);
+  const adjacencyOut = OverlayMap.over(base.adjacencyOut);
+  const adjacencyIn = OverlayMap.over(base.adjacencyIn);
+  const files = OverlayMap.over<number, FileRow>(base.files ?? new Map());
+
+  const removed = new Set(patch.removedSymbolIds);
+  const dropped = new Set<EdgeRow>();
+  for (const symbolId of patch.refreshedSymbolIds) {
+    for (const edge of adjacencyOut.get(symbolId) ?? []) {
+      if (!entry.scipEdges.has(edge)) dropped.add(edge);
+    }
+  }
+  for (const symbolId of removed) {
+    for (const edge of adjacencyOut.get(symbolId) ?? []) dropped.add(edge);
+    for (const edge of adjacencyIn.get(symbolId) ?? []) dropped.add(edge);
+  }
+
+  // Lists copied by this patch, which may then be mutated in place.
+  const ownedOut = new Set<SymbolId>();
+  const ownedIn = new Set<SymbolId>();
+  const own = (
+    adjacency: GraphMap<SymbolId, EdgeRow[]>,
+    owned: Set<SymbolId>,
+    symbolId: SymbolId,
+  ): EdgeRow[] | undefined => {
+    const list = adjacency.get(symbolId);
+    if (!list || owned.has(symbolId)) return list;
+    const copy = list.filter((edge) => !dropped.has(edge));
+    adjacency.set(symbolId, copy);
+    owned.add(symbolId);
+    return copy;
+  };
+  for (const edge of dropped) {
+    own(adjacencyOut, ownedOut, edge.from_symbol_id);
+    own(adjacencyIn, ownedIn, edge.to_symbol_id);
+  }
+  for (const symbolId of removed) {
+    symbols.delete(symbolId);
+    adjacencyOut.delete(symbolId);
+    adjacencyIn.delete(symbolId);
+  }
+
+  const fileIds = entry.fileIds
+    ? OverlayMap.over(entry.fileIds)
+    : new Map<string, number>();
+  let nextFileId = entry.nextFileId ?? 1;
+  if (!entry.fileIds) {
+    for (const [id, row] of files) {
+      fileIds.set(row.rel_path, id);
+      nextFileId = Math.max(nextFileId, id + 1);
+    }
+  }
+  let fileId = fileIds.get(patch.file.relPath);
+  if (fileId === undefined) {
+    fileId = nextFileId++;
+    fileIds.set(patch.file.relPath, fileId);
+  }
+  files.set(fileId, toLegacyFile(patch.file, repoId, fileId));
+  for (const sym of patch.symbols) {
+    const previous = symbols.get(sym.symbolId);
+    const row = toLegacySymbol(sym, fileId);
+    if (previous) {
+      row.package_name = previous.package_name;
+      row.package_version = previous.package_version;
+      row.scip_symbol = previous.scip_symbol;
+    } else {
+      adjacencyOut.set(sym.symbolId, []);
+      adjacencyIn.set(sym.symbolId, []);
+      ownedOut.add(sym.symbolId);
+      ownedIn.add(sym.symbolId);
+    }
+    symbols.set(sym.symbolId, row);
+  }
+
+  const added: EdgeRow[] = [];
+  for (const edge of patch.edges) {
+    if (removed.has(edge.toSymbolId)) continue;
+    const legacyEdge = toLegacyEdge(edge);
+    added.push(legacyEdge);
+    own(adjacencyOut, ownedOut, edge.fromSymbolId)?.push(legacyEdge);
+    own(adjacencyIn, ownedIn, edge.toSymbolId)?.push(legacyEdge);
+  }
+
+  let edgeLog: EdgeLog = entry.edgeLog
+    ? {
+        base: entry.edgeLog.base,
+        dropped: new Set([...entry.edgeLog.dropped, ...dropped]),
+        added: [...entry.edgeLog.added, ...added],
+      }
+    : { base: base.edges, dropped, added };
+  if (
+    edgeLog.dropped.size + edgeLog.added.length >
+    edgeLog.base.length * MAX_EDGE_LOG_RATIO
+  ) {
+    edgeLog = { base: materializeEdges(edgeLog), dropped: new Set(), added: [] };
+  }
+
+  const graph = {
+    repoId: base.repoId,
+    symbols,
+    adjacencyIn,
+    adjacencyOut,
+    metrics: base.metrics,
+    centralityStats: base.centralityStats,
+    files,
+    clusters: base.clusters,
+  } as Graph;
+  const log = edgeLog;
+  let edges: EdgeRow[] | undefined;
+  Object.defineProperty(graph, "edges", {
+    enumerable: true,
+    get: () => (edges ??= materializeEdges(log)),
+  });
+  snapshotsByRepo.set(repoId, {
+    ...entry,
+    graph,
+    createdAt: pushLineage(repoId, entry.repoEpoch),
+    edgeLog,
+    fileIds,
+    nextFileId,
+    symbolCount: symbols.size,
+    edgeCount: entry.edgeCount - dropped.size + added.length,
+  });
+  logger.debug("Graph snapshot patched", {
+    repoId,
+    filePath: patch.file.relPath,
+    symbolsUpserted: patch.symbols.length,
+    symbolsRemoved: removed.size,
+    edgesRemoved: dropped.size,
+    edgesAdded: added.length,
+  });
+  return true;
+}
+
+/** The full edge list `log` describes, in load order then patch order. */
+function materializeEdges(log: EdgeLog): EdgeRow[] {
+  const edges =
+    log.dropped.size > 0
+      ? log.base.filter((edge) => !log.dropped.has(edge))
+      : log.base.slice();
+  for (const edge of log.added) {
+    if (!log.dropped.has(edge)) edges.push(edge);
+  }
+  return edges;
+}
+
 /**
  * Invalidate a repo's cached snapshot (e.g., after re-indexing).
  */
 export function invalidateGraphSnapshot(repoId: RepoId): void {
+  cancelGraphSnapshotFileRewrite(repoId);
   snapshotsByRepo.delete(repoId);
   loadingPromises.delete(repoId);
+  lineageByRepo.delete(repoId);
 }
 
 /**
  * Clear all cached snapshots.
  */
 export function clearGraphSnapshots(): void {
+  for (const repoId of snapshotFileRewrites.keys()) {
+    cancelGraphSnapshotFileRewrite(repoId);
+  }
   snapshotsByRepo.clear();
   loadingPromises.clear();
+  lineageByRepo.clear();
 }
 
 /**
@@ -194,6 +528,8 @@ export function getGraphSnapshotStats(): {
     edgeCount: number;
     clusterCount: number;
     ageMs: number;
+    /** Bytes held by the snapshot's CSR view; 0 until it is first built. */
+    csrBytes: number;
   }>;
 } {
   const now = Date.now();
@@ -203,6 +539,7 @@ export function getGraphSnapshotStats(): {
     edgeCount: number;
     clusterCount: number;
     ageMs: number;
+    csrBytes: number;
   }> = [];
   for (const [repoId, entry] of snapshotsByRepo) {
     entries.push({
@@ -210,7 +547,8 @@ export function getGraphSnapshotStats(): {
       symbolCount: entry.symbolCount,
       edgeCount: entry.edgeCount,
       clusterCount: entry.clusterCount,
-      ageMs: now - entry.createdAt,
+      ageMs: now - entry.loadedAt,
+      csrBytes: peekCsrSnapshot(entry.graph)?.byteLength ?? 0,
     });
   }
   return { cachedRepos: snapshotsByRepo.size, entries };
@@ -249,11 +587,298 @@ export async function loadAndCacheGraphSnapshot(
   }
 }
 
+/** A full-repo graph read from LadybugDB or a snapshot file. */
+interface LoadedGraph {
+  graph: Graph;
+  scipEdges: WeakSet<EdgeRow>;
+  /** CSR view stored with the graph, when it came from a snapshot file. */
+  csr?: CsrGraph;
+  source: "ladybug" | "file";
+}
+
 async function _loadGraphSnapshot(
   conn: Connection,
   repoId: RepoId,
   repoEpoch: number,
 ): Promise<Graph | null> {
+  const patchSeq = patchSeqByRepo.get(repoId) ?? 0;
+  const loaded =
+    (await readGraphFromFile(conn, repoId)) ??
+    (await readGraphFromLadybug(conn, repoId));
+  if (!loaded) return null;
+  return publishLoadedGraph(repoId, repoEpoch, patchSeq, loaded);
+}
+
+/**
+ * Cache a graph read by `_loadGraphSnapshot` or a file restore. Returns the
+ * graph, uncached, when a live patch landed during the read, and null when
+ * the repo epoch moved on.
+ */
+function publishLoadedGraph(
+  repoId: RepoId,
+  repoEpoch: number,
+  patchSeq: number,
+  loaded: LoadedGraph,
+): Graph | null {
+  const { graph } = loaded;
+  if ((patchSeqByRepo.get(repoId) ?? 0) !== patchSeq) {
+    logger.debug("Graph snapshot load raced a live patch; not caching", {
+      repoId,
+    });
+    return graph;
+  }
+  if (!setGraphSnapshot(repoId, graph, repoEpoch, loaded.scipEdges)) {
+    return null;
+  }
+  if (loaded.csr && loaded.csr.nodeCount === graph.symbols.size) {
+    primeCsrSnapshot(graph, loaded.csr);
+  }
+
+  logger.info("Graph snapshot loaded and cached", {
+    repoId,
+    source: loaded.source,
+    symbolCount: graph.symbols.size,
+    edgeCount: graph.edges.length,
+    fileCount: graph.files?.size ?? 0,
+    clusterCount: graph.clusters?.size ?? 0,
+  });
+
+  return graph;
+}
+
+/**
+ * Seat the repo's snapshot from its persisted file, without falling back to
+ * LadybugDB. Used at server startup so the first slice takes the in-memory
+ * path. Returns false when a snapshot is already cached or loading, the
+ * file is missing or stale, or the repo epoch changed while reading it.
+ */
+export async function restoreGraphSnapshotFromFile(
+  conn: Connection,
+  repoId: RepoId,
+): Promise<boolean> {
+  const repoEpoch = captureActiveRepoEpoch(repoId);
+  if (
+    repoEpoch === undefined ||
+    hasGraphSnapshot(repoId) ||
+    loadingPromises.get(repoId)?.repoEpoch === repoEpoch
+  ) {
+    return false;
+  }
+  const patchSeq = patchSeqByRepo.get(repoId) ?? 0;
+  const loaded = await readGraphFromFile(conn, repoId);
+  if (!loaded) return false;
+  const published = publishLoadedGraph(repoId, repoEpoch, patchSeq, loaded);
+  return published !== null && getGraphSnapshot(repoId) === published;
+}
+
+/**
+ * Write the repo's snapshot file for `versionId` from LadybugDB. Called
+ * once derived state (metrics, clusters) for the version is stored. Repos
+ * too large for the snapshot cache get no file. Failures are logged, never
+ * thrown.
+ */
+export async function persistGraphSnapshotFile(
+  conn: Connection,
+  repoId: RepoId,
+  versionId: string,
+): Promise<boolean> {
+  const path = graphSnapshotPathFor(repoId);
+  if (!path) return false;
+  const loaded = await readGraphFromLadybug(conn, repoId);
+  if (!loaded) {
+    await discardGraphSnapshotFile(repoId);
+    return false;
+  }
+  const csr = getCsrSnapshot(loaded.graph);
+  const bytes = encodeGraphSnapshot(loaded.graph, csr, {
+    versionId,
+    scipEdges: loaded.scipEdges,
+  });
+  const written = await writeGraphSnapshotFile(path, bytes);
+  if (written) {
+    logger.debug("Graph snapshot file written", {
+      repoId,
+      versionId,
+      snapshotPath: path,
+      byteLength: bytes.byteLength,
+    });
+  }
+  return written;
+}
+
+/**
+ * Called after a live patch. The saved file changed the graph without a new
+ * version, so the snapshot file is removed when it first goes stale, which
+ * keeps a restart in the meantime from loading it, and rewritten from the
+ * patched in-memory snapshot once no patch has landed for
+ * {@link SNAPSHOT_FILE_REWRITE_DELAY_MS}. A burst of saves costs one
+ * removal and one write.
+ */
+export async function scheduleGraphSnapshotFileRewrite(
+  repoId: RepoId,
+): Promise<void> {
+  if (!graphSnapshotPathFor(repoId)) return;
+  let rewrite = snapshotFileRewrites.get(repoId);
+  const stale = !rewrite;
+  if (!rewrite) {
+    rewrite = { timer: null, running: null, dirty: false };
+    snapshotFileRewrites.set(repoId, rewrite);
+  } else if (rewrite.running) {
+    rewrite.dirty = true;
+  }
+  if (rewrite.timer) clearTimeout(rewrite.timer);
+  const pending = rewrite;
+  pending.timer = setTimeout(() => {
+    pending.timer = null;
+    const previous = pending.running ?? Promise.resolve();
+    const running = previous.then(() => rewriteGraphSnapshotFile(repoId, pending));
+    pending.running = running;
+    void running.finally(() => {
+      if (pending.running === running) pending.running = null;
+    });
+  }, SNAPSHOT_FILE_REWRITE_DELAY_MS);
+  pending.timer.unref?.();
+  if (stale) await discardGraphSnapshotFile(repoId);
+}
+
+function cancelGraphSnapshotFileRewrite(repoId: RepoId): void {
+  const rewrite = snapshotFileRewrites.get(repoId);
+  if (rewrite?.timer) clearTimeout(rewrite.timer);
+  snapshotFileRewrites.delete(repoId);
+}
+
+/**
+ * Write the cached snapshot to the repo's file under its latest version.
+ * Leaves the file absent when the snapshot is gone or another patch landed
+ * during the write. Failures are logged, never thrown.
+ */
+async function rewriteGraphSnapshotFile(
+  repoId: RepoId,
+  rewrite: SnapshotFileRewrite,
+): Promise<void> {
+  if (snapshotFileRewrites.get(repoId) !== rewrite) return;
+  rewrite.dirty = false;
+  const path = graphSnapshotPathFor(repoId);
+  const graph = getGraphSnapshot(repoId);
+  const entry = snapshotsByRepo.get(repoId);
+  let written = false;
+  if (path && graph && entry) {
+    try {
+      const conn = await getLadybugConn();
+      const latest = await ladybugDb.getLatestVersion(conn, repoId);
+      // A reindex between the patch and now invalidates the snapshot, and
+      // finalizing it writes the file itself.
+      if (latest && snapshotsByRepo.get(repoId)?.graph === graph) {
+        const bytes = encodeGraphSnapshot(graph, getCsrSnapshot(graph), {
+          versionId: latest.versionId,
+          scipEdges: entry.scipEdges,
+        });
+        written = await writeGraphSnapshotFile(path, bytes);
+        if (written) {
+          logger.debug("Graph snapshot file rewritten after live patches", {
+            repoId,
+            versionId: latest.versionId,
+            byteLength: bytes.byteLength,
+          });
+        }
+      }
+    } catch (error) {
+      logger.debug("Graph snapshot file rewrite failed", {
+        repoId,
+        error: error instanceof Error ? error.message : String(error),
+      });
+    }
+  }
+  if (snapshotFileRewrites.get(repoId) !== rewrite) {
+    // Invalidated mid-write; whoever invalidated owns the file now.
+    if (written) await discardGraphSnapshotFile(repoId);
+    return;
+  }
+  if (rewrite.dirty || rewrite.timer) {
+    // Patched during the write: the file is stale again until the pending
+    // rewrite runs.
+    if (written) await discardGraphSnapshotFile(repoId);
+    return;
+  }
+  snapshotFileRewrites.delete(repoId);
+}
+
+/**
+ * The repo's graph from its snapshot file, or null when snapshot files are
+ * disabled, the file is missing, unreadable or corrupt, or it was written
+ * for another version than the repo's latest.
+ */
+async function readGraphFromFile(
+  conn: Connection,
+  repoId: RepoId,
+): Promise<LoadedGraph | null> {
+  const path = graphSnapshotPathFor(repoId);
+  if (!path) return null;
+  const bytes = await readGraphSnapshotFile(path);
+  if (!bytes) return null;
+  const stamp = readGraphSnapshotVersion(bytes);
+  if (
+    !stamp ||
+    stamp.repoId !== repoId ||
+    stamp.symbolCount > maxSnapshotSymbols
+  ) {
+    return null;
+  }
+  const latest = await ladybugDb.getLatestVersion(conn, repoId);
+  if (latest?.versionId !== stamp.versionId) {
+    logger.debug("Graph snapshot file is stale", {
+      repoId,
+      fileVersionId: stamp.versionId,
+      latestVersionId: latest?.versionId ?? null,
+    });
+    return null;
+  }
+
+  let contents: ReturnType<typeof decodeGraphSnapshot>;
+  try {
+    contents = decodeGraphSnapshot(bytes);
+  } catch (error) {
+    logger.debug("Graph snapshot file is unreadable", {
+      repoId,
+      snapshotPath: path,
+      error: error instanceof Error ? error.message : String(error),
+    });
+    return null;
+  }
+  if (!contents || contents.symbols.length === 0) return null;
+
+  const symbols = new Map<SymbolId, SymbolRow>();
+  for (const symbol of contents.symbols) symbols.set(symbol.symbol_id, symbol);
+  const metrics = new Map<SymbolId, MetricsRow>();
+  for (const row of contents.metrics) metrics.set(row.symbol_id, row);
+  const files = new Map<number, FileRow>();
+  for (const row of contents.files) files.set(row.file_id, row);
+
+  const graph = assembleGraph(repoId, {
+    symbols,
+    edges: contents.edges,
+    metrics,
+    centralityStats:
+      contents.centralityStats ?? computeCentralityStats(metrics.values()),
+    files,
+    clusters: contents.clusters,
+  });
+  return {
+    graph,
+    scipEdges: contents.scipEdges,
+    csr: contents.csr,
+    source: "file",
+  };
+}
+
+/**
+ * The repo's full graph from LadybugDB, or null when the repo is empty or
+ * has more symbols than `maxSnapshotSymbols`.
+ */
+async function readGraphFromLadybug(
+  conn: Connection,
+  repoId: RepoId,
+): Promise<LoadedGraph | null> {
   // Check symbol count first to avoid loading huge repos
   const symbolCount = await ladybugDb.getSymbolCount(conn, repoId);
   if (symbolCount > maxSnapshotSymbols) {
@@ -309,16 +934,7 @@ async function _loadGraphSnapshot(
   for (const f of allFiles) {
     const numericId = nextFileId++;
     fileIdMap.set(f.fileId, numericId);
-    files.set(numericId, {
-      file_id: numericId,
-      repo_id: repoId,
-      rel_path: f.relPath,
-      content_hash: f.contentHash,
-      language: f.language,
-      byte_size: f.byteSize,
-      last_indexed_at: f.lastIndexedAt,
-      directory: f.directory,
-    } as FileRow);
+    files.set(numericId, toLegacyFile(f, repoId, numericId));
   }
 
   // Build cluster map
@@ -330,60 +946,19 @@ async function _loadGraphSnapshot(
   // Build symbol map (converting ladybugDb.SymbolRow -> legacy SymbolRow)
   const symbols = new Map<SymbolId, SymbolRow>();
   for (const sym of allSymbols) {
-    const fileId = fileIdMap.get(sym.fileId) ?? 0;
-    symbols.set(sym.symbolId, {
-      symbol_id: sym.symbolId,
-      repo_id: sym.repoId,
-      file_id: fileId,
-      kind: sym.kind as SymbolRow["kind"],
-      name: sym.name,
-      exported: sym.exported ? 1 : 0,
-      visibility: sym.visibility as SymbolRow["visibility"],
-      language: sym.language,
-      range_start_line: sym.rangeStartLine,
-      range_start_col: sym.rangeStartCol,
-      range_end_line: sym.rangeEndLine,
-      range_end_col: sym.rangeEndCol,
-      ast_fingerprint: sym.astFingerprint,
-      signature_json: sym.signatureJson,
-      summary: sym.summary,
-      invariants_json: sym.invariantsJson,
-      side_effects_json: sym.sideEffectsJson,
-      external: sym.external ? 1 : 0,
-      package_name: sym.packageName,
-      package_version: sym.packageVersion,
-      scip_symbol: sym.scipSymbol,
-      updated_at: sym.updatedAt,
-    } as SymbolRow);
-  }
-
-  // Build edge list + adjacency maps (converting ladybugDb.EdgeRow -> legacy EdgeRow)
-  const edges: EdgeRow[] = [];
-  const adjacencyOut = new Map<SymbolId, EdgeRow[]>();
-  const adjacencyIn = new Map<SymbolId, EdgeRow[]>();
-
-  // Init adjacency maps for all symbols
-  for (const symbolId of symbols.keys()) {
-    adjacencyOut.set(symbolId, []);
-    adjacencyIn.set(symbolId, []);
+    symbols.set(
+      sym.symbolId,
+      toLegacySymbol(sym, fileIdMap.get(sym.fileId) ?? 0),
+    );
   }
 
+  // Build edge list (converting ladybugDb.EdgeRow -> legacy EdgeRow)
+  const edges: EdgeRow[] = [];
+  const scipEdges = new WeakSet<EdgeRow>();
   for (const edge of allEdges) {
-    const legacyEdge = {
-      from_symbol_id: edge.fromSymbolId,
-      to_symbol_id: edge.toSymbolId,
-      type: edge.edgeType as EdgeType,
-      weight: edge.weight,
-      confidence: edge.confidence,
-    } as EdgeRow;
-
+    const legacyEdge = toLegacyEdge(edge);
     edges.push(legacyEdge);
-
-    const outList = adjacencyOut.get(edge.fromSymbolId);
-    if (outList) outList.push(legacyEdge);
-
-    const inList = adjacencyIn.get(edge.toSymbolId);
-    if (inList) inList.push(legacyEdge);
+    if (edge.resolverId === "scip") scipEdges.add(legacyEdge);
   }
 
   // Pre-compute centralityStats once per snapshot so every subsequent
@@ -391,27 +966,101 @@ async function _loadGraphSnapshot(
   // maxPageRank/maxKCore values (keeps tie-break behavior consistent
   // across calls until the snapshot is invalidated).
   const centralityStats = computeCentralityStats(metrics.values());
-  const graph: Graph = {
-    repoId,
+  const graph = assembleGraph(repoId, {
     symbols,
     edges,
-    adjacencyIn,
-    adjacencyOut,
     metrics,
     centralityStats,
     files,
     clusters,
-  };
+  });
+  return { graph, scipEdges, source: "ladybug" };
+}
 
-  if (!setGraphSnapshot(repoId, graph, repoEpoch)) return null;
+/** The legacy `Graph` over `parts`, with adjacency lists in edge order. */
+function assembleGraph(
+  repoId: RepoId,
+  parts: Required<
+    Pick<
+      Graph,
+      "symbols" | "edges" | "metrics" | "centralityStats" | "files" | "clusters"
+    >
+  >,
+): Graph {
+  const adjacencyOut = new Map<SymbolId, EdgeRow[]>();
+  const adjacencyIn = new Map<SymbolId, EdgeRow[]>();
 
-  logger.info("Graph snapshot loaded and cached", {
-    repoId,
-    symbolCount: symbols.size,
-    edgeCount: edges.length,
-    fileCount: files.size,
-    clusterCount: clusters.size,
-  });
+  // Init adjacency maps for all symbols
+  for (const symbolId of parts.symbols.keys()) {
+    adjacencyOut.set(symbolId, []);
+    adjacencyIn.set(symbolId, []);
+  }
 
-  return graph;
+  for (const edge of parts.edges) {
+    const outList = adjacencyOut.get(edge.from_symbol_id);
+    if (outList) outList.push(edge);
+
+    const inList = adjacencyIn.get(edge.to_symbol_id);
+    if (inList) inList.push(edge);
+  }
+
+  return { repoId, ...parts, adjacencyIn, adjacencyOut };
+}
+
+// ---------------------------------------------------------------------------
+// LadybugDB row -> legacy row conversion
+// ---------------------------------------------------------------------------
+
+function toLegacyFile(
+  f: ladybugDb.FileRow,
+  repoId: RepoId,
+  numericId: number,
+): FileRow {
+  return {
+    file_id: numericId,
+    repo_id: repoId,
+    rel_path: f.relPath,
+    content_hash: f.contentHash,
+    language: f.language,
+    byte_size: f.byteSize,
+    last_indexed_at: f.lastIndexedAt,
+    directory: f.directory,
+  } as FileRow;
+}
+
+function toLegacySymbol(sym: ladybugDb.SymbolRow, fileId: number): SymbolRow {
+  return {
+    symbol_id: sym.symbolId,
+    repo_id: sym.repoId,
+    file_id: fileId,
+    kind: sym.kind as SymbolRow["kind"],
+    name: sym.name,
+    exported: sym.exported ? 1 : 0,
+    visibility: sym.visibility as SymbolRow["visibility"],
+    language: sym.language,
+    range_start_line: sym.rangeStartLine,
+    range_start_col: sym.rangeStartCol,
+    range_end_line: sym.rangeEndLine,
+    range_end_col: sym.rangeEndCol,
+    ast_fingerprint: sym.astFingerprint,
+    signature_json: sym.signatureJson,
+    summary: sym.summary,
+    invariants_json: sym.invariantsJson,
+    side_effects_json: sym.sideEffectsJson,
+    external: sym.external ? 1 : 0,
+    package_name: sym.packageName,
+    package_version: sym.packageVersion,
+    scip_symbol: sym.scipSymbol,
+    updated_at: sym.updatedAt,
+  } as SymbolRow;
+}
+
+function toLegacyEdge(edge: ladybugDb.EdgeRow): EdgeRow {
+  return {
+    from_symbol_id: edge.fromSymbolId,
+    to_symbol_id: edge.toSymbolId,
+    type: edge.edgeType as EdgeType,
+    weight: edge.weight,
+    confidence: edge.confidence,
+  } as EdgeRow;
 }
@@ -25,6 +25,7 @@ export {
   getCachedSlice,
   setCachedSlice,
   invalidateVersion,
+  invalidateSliceCacheForSymbols,
   getSliceCacheStats,
 } from "./sliceCache.js";
 
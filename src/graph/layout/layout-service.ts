@@ -7,7 +7,7 @@ import {
   getSymbolLayoutInputRows,
 } from "../../db/ladybug-graph-read.js";
 import { computeForceLayout, hashLayoutInput } from "./force-layout.js";
-import { computeNativeLayout } from "./native-engine.js";
+import { computeNativeLayout, isNativeBarnesHutAvailable, streamNativeBarnesHutLayout } from "./native-engine.js";
 import { fnv1a32, mulberry32 } from "./prng.js";
 import { LAYOUT_SCHEMA_VERSION, type LayoutInput, type LayoutResult } from "./types.js";
 
@@ -18,6 +18,10 @@ export type LayoutServiceOptions = {
   iterations: number;
   maxSymbolsPerClusterExpand: number;
   cacheDir?: string | null;
+  /** Receives intermediate Barnes–Hut layouts while a large graph settles. */
+  onProgress?: (frame: LayoutResult) => void;
+  /** Iterations between `onProgress` frames. */
+  progressEvery?: number;
 };
 
 export type LayoutCacheArtifact = {
@@ -30,6 +34,12 @@ export type LayoutCacheArtifact = {
 const TIER1_SIZE_DRIFT_TOLERANCE = 0.1;
 // Deterministic jitter radius for warm-start placement of new nodes.
 const WARM_START_JITTER = 20;
+// Past the point where effectiveIterations starts trimming the exact pass,
+// the native Barnes–Hut engine runs the full iteration count instead.
+export const BARNES_HUT_MIN_NODES = 1500;
+// Warm-started Barnes–Hut runs begin cooler so surviving nodes stay put.
+const WARM_START_TEMPERATURE_SCALE = 0.25;
+const DEFAULT_PROGRESS_EVERY = 25;
 
 function cacheRoot(options: LayoutServiceOptions): string {
   return resolve(options.cacheDir ?? resolve(process.cwd(), "viewer-layout-cache"));
@@ -147,6 +157,34 @@ async function computeWithEngine(
   return nativeResult ?? computeForceLayout(input, seed, iterations);
 }
 
+/**
+ * Whether `nodeCount` nodes lay out with the native Barnes–Hut engine
+ * rather than the exact pass.
+ */
+export function usesBarnesHut(nodeCount: number, engine: LayoutServiceOptions["engine"]): boolean {
+  return engine !== "typescript" && nodeCount > BARNES_HUT_MIN_NODES && isNativeBarnesHutAvailable();
+}
+
+async function computeBarnesHut(
+  input: LayoutInput,
+  seed: number,
+  iterations: number,
+  warm: boolean,
+  options: LayoutServiceOptions,
+): Promise<LayoutResult> {
+  const width = Math.max(100, Math.sqrt(Math.max(input.nodes.length, 1)) * 100);
+  let result: LayoutResult | null = null;
+  for await (const frame of streamNativeBarnesHutLayout(input, seed, iterations, {
+    initialTemperature: warm ? (width / 10) * WARM_START_TEMPERATURE_SCALE : undefined,
+    frameEvery: options.onProgress ? (options.progressEvery ?? DEFAULT_PROGRESS_EVERY) : iterations,
+  })) {
+    if (result) options.onProgress?.(result);
+    result = frame;
+  }
+  if (!result) throw new Error("native layout engine unavailable");
+  return result;
+}
+
 /**
  * Iteration budget for large graphs: a full O(n^2) force pass at the
  * configured iteration count is too slow past ~1,500 nodes, so the count
@@ -171,7 +209,8 @@ export async function getLayout(
     throw new Error("cluster expansion limit exceeded");
   }
   const seed = fnv1a32(`${repoId}:${clusterId ?? "cluster"}:${LAYOUT_SCHEMA_VERSION}`);
-  const iterations = effectiveIterations(input.nodes.length, options.iterations);
+  const barnesHut = usesBarnesHut(input.nodes.length, options.engine);
+  const iterations = barnesHut ? options.iterations : effectiveIterations(input.nodes.length, options.iterations);
   const inputHash = hashLayoutInput(input);
   const file = lod === "cluster"
     ? resolve(cacheRoot(options), cacheSegment(repoId), "tier1.json")
@@ -180,9 +219,11 @@ export async function getLayout(
   if (cached && cached.result.inputHash === inputHash) return cached.result;
   if (cached && lod === "cluster" && withinTier1Drift(cached, input)) return cached.result;
   const warmStart = cached ? planWarmStart(cached, input, seed, iterations) : null;
-  const result = warmStart
-    ? await computeWithEngine({ ...input, initialPositions: warmStart.initialPositions }, seed, warmStart.iterations, options.engine)
-    : await computeWithEngine(input, seed, iterations, options.engine);
+  const start = warmStart ? { ...input, initialPositions: warmStart.initialPositions } : input;
+  const runIterations = warmStart?.iterations ?? iterations;
+  const result = barnesHut
+    ? await computeBarnesHut(start, seed, runIterations, warmStart !== null, options)
+    : await computeWithEngine(start, seed, runIterations, options.engine);
   await writeCachedArtifact(file, { result, inputSizes: inputSizeMap(input) });
   return result;
 }
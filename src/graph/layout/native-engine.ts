@@ -4,10 +4,34 @@ import {
   loadNativeAddon,
 } from "../../native/addon-loader.js";
 
-import type { LayoutInput, LayoutResult } from "./types.js";
+import { hashLayoutInput } from "./force-layout.js";
+import { LAYOUT_SCHEMA_VERSION, type LayoutInput, type LayoutResult } from "./types.js";
+
+interface NativeLayoutSession {
+  readonly iterationsRun: number;
+  step(iterations: number): Promise<Float64Array>;
+}
+
+export type BarnesHutOptions = {
+  /** Opening threshold; smaller is slower and closer to the exact layout. */
+  theta?: number;
+  /** Largest first-step move; defaults to the exact engine's width / 10. */
+  initialTemperature?: number;
+  /** Yield intermediate positions every this many iterations. */
+  frameEvery?: number;
+};
 
 interface NativeLayoutAddon {
   computeLayout(inputJson: string, seed: number, iterations: number): string;
+  startLayoutSession?(
+    nodeCount: number,
+    edgeFrom: Uint32Array,
+    edgeTo: Uint32Array,
+    edgeWeight: Float64Array,
+    initialPositions: Float64Array | null,
+    seed: number,
+    options: { theta?: number; initialTemperature?: number },
+  ): NativeLayoutSession;
 }
 
 let nativeAddon: NativeLayoutAddon | null | undefined;
@@ -57,3 +81,72 @@ export function computeNativeLayout(input: LayoutInput, seed: number, iterations
   const json = computeNativeLayoutJson(input, seed, iterations);
   return json ? (JSON.parse(json) as LayoutResult) : null;
 }
+
+export function isNativeBarnesHutAvailable(): boolean {
+  return typeof loadNativeLayoutAddon()?.startLayoutSession === "function";
+}
+
+function round6(value: number): number {
+  return Math.round(value * 1_000_000) / 1_000_000;
+}
+
+/**
+ * Barnes–Hut layout in the native addon, for graphs too large for the exact
+ * O(n^2) pass. Yields a snapshot every `frameEvery` iterations and the final
+ * layout last; the final positions do not depend on `frameEvery`. Yields
+ * nothing when the addon lacks the engine.
+ */
+export async function* streamNativeBarnesHutLayout(
+  input: LayoutInput,
+  seed: number,
+  iterations: number,
+  options: BarnesHutOptions = {},
+): AsyncGenerator<LayoutResult> {
+  const addon = loadNativeLayoutAddon();
+  if (!addon?.startLayoutSession) return;
+  const nodes = [...input.nodes].sort((a, b) => a.id.localeCompare(b.id));
+  const indexById = new Map<string, number>();
+  for (let i = 0; i < nodes.length; i += 1) indexById.set(nodes[i].id, i);
+  const edges = input.edges.filter((edge) => indexById.has(edge.from) && indexById.has(edge.to));
+  const edgeFrom = new Uint32Array(edges.length);
+  const edgeTo = new Uint32Array(edges.length);
+  const edgeWeight = new Float64Array(edges.length);
+  edges.forEach((edge, e) => {
+    edgeFrom[e] = indexById.get(edge.from) ?? 0;
+    edgeTo[e] = indexById.get(edge.to) ?? 0;
+    edgeWeight[e] = edge.weight;
+  });
+  let initialPositions: Float64Array | null = null;
+  if (input.initialPositions) {
+    initialPositions = new Float64Array(nodes.length * 3).fill(Number.NaN);
+    nodes.forEach((node, i) => {
+      const point = input.initialPositions?.[node.id];
+      if (!point) return;
+      initialPositions?.set([point.x, point.y, point.z], i * 3);
+    });
+  }
+  const session = addon.startLayoutSession(nodes.length, edgeFrom, edgeTo, edgeWeight, initialPositions, seed, {
+    theta: options.theta,
+    initialTemperature: options.initialTemperature,
+  });
+  const inputHash = hashLayoutInput(input);
+  const frameEvery = Math.max(1, Math.floor(options.frameEvery ?? iterations));
+  let done = 0;
+  do {
+    const batch = Math.min(frameEvery, iterations - done);
+    const positions = await session.step(batch);
+    done += batch;
+    yield {
+      layoutSchemaVersion: LAYOUT_SCHEMA_VERSION,
+      seed,
+      iterations: done,
+      inputHash,
+      positions: nodes.map((node, i) => ({
+        id: node.id,
+        x: round6(positions[i * 3]),
+        y: round6(positions[i * 3 + 1]),
+        z: round6(positions[i * 3 + 2]),
+      })),
+    };
+  } while (done < iterations);
+}
@@ -19,7 +19,7 @@ import { logger } from "../util/logger.js";
 import { safeJsonParse, ConfigObjectSchema } from "../util/safeJson.js";
 import {
   CentralityWorkerTimeoutError,
-  runCentralityWorker,
+  runCentrality,
 } from "./centrality-worker-runner.js";
 
 const execFileAsync = promisify(execFile);
@@ -1186,6 +1186,7 @@ async function maybeComputeFoldedCentrality(params: {
   algorithmRefresh: AlgorithmRefreshConfig | undefined;
   symbolIds: string[];
   callEdges: Array<{ callerId: string; calleeId: string }>;
+  loadPreviousPageRank?: () => Promise<ReadonlyMap<string, number>>;
   measureSubphase: <T>(phaseName: string, fn: () => Promise<T>) => Promise<T>;
 }): Promise<FoldedCentralityValues | undefined> {
   const algorithmRefresh = params.algorithmRefresh;
@@ -1207,7 +1208,7 @@ async function maybeComputeFoldedCentrality(params: {
 
   try {
     const result = await params.measureSubphase("centralityFold", () =>
-      runCentralityWorker(
+      runCentrality(
         {
           symbolIds: params.symbolIds,
           callEdges: params.callEdges,
@@ -1215,6 +1216,7 @@ async function maybeComputeFoldedCentrality(params: {
           kCoreEnabled,
         },
         algorithmRefresh?.workerTimeoutMs ?? 120_000,
+        { loadPreviousPageRank: params.loadPreviousPageRank },
       ),
     );
     const bySymbolId = new Map<string, { pageRank: number; kCore: number }>();
@@ -1434,6 +1436,7 @@ export async function updateMetricsForRepo(
     algorithmRefresh: options?.algorithmRefresh,
     symbolIds: [...symbolIds].sort(),
     callEdges: sharedCallEdges,
+    loadPreviousPageRank: () => ladybugDb.getPageRankByRepo(conn, repoId),
     measureSubphase,
   });
   const centralityBySymbolId =
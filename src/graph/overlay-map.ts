@@ -0,0 +1,153 @@
+/**
+ * Copy-on-write Map layered over a shared base map.
+ *
+ * Writes land in a small overlay of changed and deleted keys; reads fall
+ * through to the base. Taking a writable copy of an overlay map copies only
+ * its overlay, so a graph snapshot patch costs the rows changed since the
+ * last full load rather than the whole repo. Once an overlay grows past a
+ * quarter of its base, the next copy flattens it into a plain map.
+ *
+ * Reads behave like a `Map`'s, including iteration order. It is not a `Map`
+ * subclass, because structured clone (`postMessage`, `v8.serialize`) would
+ * copy such a subclass as an empty `Map` without complaint. Copy an overlay
+ * with `new Map(map)` before sending it to another thread.
+ *
+ * @module graph/overlay-map
+ */
+
+/** Overlays larger than this fraction of their base are flattened. */
+const MAX_OVERLAY_RATIO = 0.25;
+
+/** A writable graph map: a plain `Map` or an {@link OverlayMap} over one. */
+export type GraphMap<K, V> = Map<K, V> | OverlayMap<K, V>;
+
+export class OverlayMap<K, V> implements ReadonlyMap<K, V> {
+  private base: ReadonlyMap<K, V>;
+  /** Changed or added entries, in insertion order. */
+  private readonly changes: Map<K, V>;
+  /** Base keys that were deleted, or re-added and so iterate last. */
+  private readonly deleted: Set<K>;
+  private count: number;
+
+  private constructor(
+    base: ReadonlyMap<K, V>,
+    changes: Map<K, V>,
+    deleted: Set<K>,
+    count: number,
+  ) {
+    this.base = base;
+    this.changes = changes;
+    this.deleted = deleted;
+    this.count = count;
+  }
+
+  /**
+   * A writable copy of `map` that shares its entries. Costs O(1) for a
+   * plain map and the size of the overlay for an `OverlayMap`. Writes to
+   * the copy never show through `map`.
+   */
+  static over<K, V>(map: ReadonlyMap<K, V>): OverlayMap<K, V> {
+    if (!(map instanceof OverlayMap)) {
+      return new OverlayMap(map, new Map(), new Set(), map.size);
+    }
+    const source = map as OverlayMap<K, V>;
+    if (
+      source.changes.size + source.deleted.size >
+      source.base.size * MAX_OVERLAY_RATIO
+    ) {
+      return new OverlayMap(new Map(source), new Map(), new Set(), source.count);
+    }
+    return new OverlayMap(
+      source.base,
+      new Map(source.changes),
+      new Set(source.deleted),
+      source.count,
+    );
+  }
+
+  get size(): number {
+    return this.count;
+  }
+
+  get(key: K): V | undefined {
+    if (this.changes.has(key)) return this.changes.get(key);
+    return this.deleted.has(key) ? undefined : this.base.get(key);
+  }
+
+  has(key: K): boolean {
+    return (
+      this.changes.has(key) || (!this.deleted.has(key) && this.base.has(key))
+    );
+  }
+
+  set(key: K, value: V): this {
+    // A deleted base key stays in `deleted`, so it comes back at the end
+    // as in a plain Map.
+    if (!this.has(key)) this.count++;
+    this.changes.set(key, value);
+    return this;
+  }
+
+  delete(key: K): boolean {
+    if (!this.has(key)) return false;
+    this.changes.delete(key);
+    if (this.base.has(key)) this.deleted.add(key);
+    this.count--;
+    return true;
+  }
+
+  clear(): void {
+    this.base = new Map();
+    this.changes.clear();
+    this.deleted.clear();
+    this.count = 0;
+  }
+
+  forEach(
+    callbackfn: (value: V, key: K, map: ReadonlyMap<K, V>) => void,
+    thisArg?: unknown,
+  ): void {
+    for (const [key, value] of this.walk()) {
+      callbackfn.call(thisArg, value, key, this);
+    }
+  }
+
+  entries(): MapIterator<[K, V]> {
+    return this.walk();
+  }
+
+  keys(): MapIterator<K> {
+    return mapIterator(this.walk(), ([key]) => key);
+  }
+
+  values(): MapIterator<V> {
+    return mapIterator(this.walk(), ([, value]) => value);
+  }
+
+  [Symbol.iterator](): MapIterator<[K, V]> {
+    return this.walk();
+  }
+
+  /**
+   * Base entries in order with changed values substituted, then added
+   * entries in insertion order.
+   */
+  private *walk(): Generator<[K, V], undefined> {
+    for (const [key, value] of this.base) {
+      if (this.deleted.has(key)) continue;
+      yield [key, this.changes.has(key) ? this.changes.get(key)! : value];
+    }
+    for (const [key, value] of this.changes) {
+      if (this.deleted.has(key) || !this.base.has(key)) yield [key, value];
+    }
+    return undefined;
+  }
+}
+
+function* mapIterator<T, U>(
+  source: Iterable<T>,
+  project: (item: T) => U,
+): Generator<U, undefined> {
+  for (const item of source) yield project(item);
+  return undefined;
+}
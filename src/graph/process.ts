@@ -3,6 +3,7 @@ import * as ladybugDb from "../db/ladybug-queries.js";
 import { hashContent } from "../util/hashing.js";
 import { safeCompileRegex } from "../util/safeRegex.js";
 
+import { sameCsrRow, type CsrGraph } from "./csr-snapshot.js";
 import type { ProcessTrace, ProcessTraceStep } from "./process-types.js";
 
 function compileEntryPatterns(entryPatterns: string[]): RegExp[] {
@@ -90,3 +91,117 @@ export async function traceProcessesTS(
 
   return entrySymbolIds.map(trace);
 }
+
+/**
+ * Traces from the last process refresh of a repo, with the call graph and
+ * depth limit they were traced under.
+ */
+export interface ProcessSnapshot {
+  graph: CsrGraph;
+  maxDepth: number;
+  traces: readonly ProcessTrace[];
+}
+
+/** Processes an incremental refresh can carry over, and entries to retrace. */
+export interface IncrementalProcessPlan {
+  reused: Map<string, ProcessTrace>;
+  retrace: string[];
+}
+
+const processSnapshots = new Map<string, ProcessSnapshot>();
+
+/**
+ * Whether process refreshes reuse traces whose steps did not change. On by
+ * default; `SDL_MCP_INCREMENTAL_PROCESSES=0` retraces every entry point.
+ */
+export function shouldUseIncrementalProcesses(
+  env: NodeJS.ProcessEnv = process.env,
+): boolean {
+  return !/^(0|false|no)$/i.test(
+    (env.SDL_MCP_INCREMENTAL_PROCESSES ?? "").trim(),
+  );
+}
+
+export function recallProcesses(repoId: string): ProcessSnapshot | undefined {
+  return processSnapshots.get(repoId);
+}
+
+export function rememberProcesses(
+  repoId: string,
+  snapshot: ProcessSnapshot,
+): void {
+  processSnapshots.set(repoId, snapshot);
+}
+
+/** Drop the snapshot for `repoId`, or every snapshot when omitted. */
+export function forgetProcesses(repoId?: string): void {
+  if (repoId === undefined) processSnapshots.clear();
+  else processSnapshots.delete(repoId);
+}
+
+/**
+ * Split `entrySymbolIds` into traces carried from `previous` and entries to
+ * retrace over `graph`. A depth-first trace is fixed by the call rows of the
+ * steps it visits, so a previous trace is reused exactly when every step
+ * still has the same row; only the rows of visited steps are compared.
+ */
+export function planIncrementalProcesses(
+  previous: ProcessSnapshot,
+  graph: CsrGraph,
+  entrySymbolIds: readonly string[],
+  maxDepth: number,
+): IncrementalProcessPlan {
+  const reused = new Map<string, ProcessTrace>();
+  if (previous.maxDepth !== maxDepth) {
+    return { reused, retrace: [...entrySymbolIds] };
+  }
+
+  const old = previous.graph;
+  // 0 = not compared yet, 1 = same row, 2 = changed or new.
+  const rowState = new Uint8Array(graph.symbolIds.length);
+  const unchanged = (symbolId: string): boolean => {
+    const node = graph.nodeOf(symbolId);
+    if (node === undefined) return false;
+    if (rowState[node] === 0) {
+      const oldNode = old.nodeOf(symbolId);
+      rowState[node] =
+        oldNode !== undefined && sameCsrRow(graph, node, old, oldNode) ? 1 : 2;
+    }
+    return rowState[node] === 1;
+  };
+
+  const previousByEntry = new Map(
+    previous.traces.map((trace) => [trace.entrySymbolId, trace]),
+  );
+  const retrace: string[] = [];
+  for (const entrySymbolId of entrySymbolIds) {
+    const trace = previousByEntry.get(entrySymbolId);
+    if (trace && trace.steps.every((step) => unchanged(step.symbolId))) {
+      reused.set(entrySymbolId, trace);
+    } else {
+      retrace.push(entrySymbolId);
+    }
+  }
+  return { reused, retrace };
+}
+
+/**
+ * Reused and retraced processes in `entrySymbolIds` order, matching what a
+ * full trace of the same entries returns.
+ */
+export function mergeIncrementalProcesses(
+  entrySymbolIds: readonly string[],
+  plan: IncrementalProcessPlan,
+  retraced: readonly ProcessTrace[],
+): ProcessTrace[] {
+  const byEntry = new Map(
+    retraced.map((trace) => [trace.entrySymbolId, trace]),
+  );
+  const merged: ProcessTrace[] = [];
+  for (const entrySymbolId of entrySymbolIds) {
+    const trace =
+      plan.reused.get(entrySymbolId) ?? byEntry.get(entrySymbolId);
+    if (trace) merged.push(trace);
+  }
+  return merged;
+}
@@ -158,7 +158,7 @@ function calculateStacktraceLocalityWithFile(
   return 0;
 }
 
-function calculateStructuralSpecificity(file?: FileRow): number {
+export function calculateStructuralSpecificity(file?: FileRow): number {
   if (!file?.rel_path) return 0.8;
 
   const relPath = file.rel_path.toLowerCase();
@@ -210,7 +210,7 @@ function calculateStructuralSpecificity(file?: FileRow): number {
   return Math.max(0.15, Math.min(1, specificity));
 }
 
-function calculateSymbolKindSpecificity(symbol: SymbolRow): number {
+export function calculateSymbolKindSpecificity(symbol: SymbolRow): number {
   switch (symbol.kind) {
     case "class":
       return 1;
@@ -22,15 +22,22 @@ import { getSliceCacheKey, getCachedSlice, setCachedSlice, configureSliceCache }
 
 import { resolveStartNodes, resolveStartNodesLadybug, type StartNodeSource, type ResolvedStartNode, type StartNodeResolutionResult, type StartNodeLimits, START_NODE_SOURCE_PRIORITY, START_NODE_SOURCE_SCORE, TASK_TEXT_STOP_WORDS } from "./slice/start-node-resolver.js";
 
-import { beamSearch, beamSearchLadybug, applyEdgeConfidenceWeight, getAdaptiveMinConfidence, type FrontierItem, type BeamTraceCollector } from "./slice/beam-search-engine.js";
+import { beamSearchLadybug, applyEdgeConfidenceWeight, getAdaptiveMinConfidence, type FrontierItem, type BeamTraceCollector } from "./slice/beam-search-engine.js";
+import { beamSearchInMemory } from "./slice/native-beam-search.js";
 import { SLICE_SCORE_THRESHOLD as TRACE_SLICE_SCORE_THRESHOLD, MAX_FRONTIER as TRACE_MAX_FRONTIER } from "../config/constants.js";
 import type { BeamExplainEntry } from "../observability/types.js";
 import { getBeamExplainStore } from "../observability/index.js";
 import { getObservabilityTap } from "../observability/event-tap.js";
+import {
+  phaseStart,
+  recordPhaseLatency,
+} from "../observability/latency-histogram.js";
 
 import { getGraphSnapshot } from "./graphSnapshotCache.js";
 
-import { buildPayloadCardsAndRefs, toSliceSymbolCard, filterDepsBySliceSymbolSet, encodeEdgesWithSymbolIndex, estimateTokens } from "./slice/slice-serializer.js";
+import { buildPayloadCardsAndRefs, streamPayloadCards, toSliceSymbolCard, filterDepsBySliceSymbolSet, encodeEdgesWithSymbolIndex, estimateTokens } from "./slice/slice-serializer.js";
+import { admitCardsWithinTokenBudget } from "./slice/truncation-handler.js";
+import { isStreamingSerializerEnabled } from "../util/streaming-json.js";
 
 import { type SliceResult, type SliceError, sliceOk, sliceErr } from "./slice/result.js";
 import { getOverlaySnapshot } from "../live-index/overlay-reader.js";
@@ -256,7 +263,7 @@ export async function buildSlice(
       graphSymbols: cachedGraph.symbols.size,
       graphEdges: cachedGraph.edges.length,
     });
-    const result = beamSearch(
+    const result = beamSearchInMemory(
       cachedGraph,
       startNodes,
       budget,
@@ -291,6 +298,7 @@ export async function buildSlice(
     maxFrontierSize = result.maxFrontierSize;
   }
 
+  recordPhaseLatency("slice.beamSearch", beamStartedAt);
   try {
     getObservabilityTap()?.sliceBuild({
       repoId: request.repoId,
@@ -314,7 +322,8 @@ export async function buildSlice(
   const budgetAdaptive =
     request.adaptiveDetail !== false && effectiveLevel !== requestedLevel;
 
-  const { cards, sliceDepsBySymbol } = await loadSymbolCards(
+  const hydrationStartedAt = phaseStart();
+  const { cards: hydratedCards, sliceDepsBySymbol } = await loadSymbolCards(
     conn,
     Array.from(sliceCards),
     request.versionId,
@@ -324,12 +333,35 @@ export async function buildSlice(
     request.includeResolutionMetadata,
     overlaySnapshot,
   );
-  const { cardsForPayload, cardRefs } = buildPayloadCardsAndRefs(
-    cards,
-    request.knownCardEtags,
-    sliceDepsBySymbol,
-    sliceCards,
-  );
+  recordPhaseLatency("slice.cardHydration", hydrationStartedAt);
+
+  // Cards past the token budget are dropped before any wire card is built,
+  // and leave the slice so deps and edges never point at them. A slice that
+  // will be cached is served to clients with other known ETags, so it is
+  // admitted at full card cost; known ETags then only shrink this payload.
+  const cacheable = canUseCache && repoEpoch !== undefined;
+  const { admitted: cards, dropped: budgetDropped } =
+    isStreamingSerializerEnabled()
+      ? admitCardsWithinTokenBudget(
+          hydratedCards,
+          sliceCards,
+          budget.maxEstimatedTokens,
+          cacheable ? undefined : request.knownCardEtags,
+        )
+      : { admitted: hydratedCards, dropped: [] as string[] };
+  if (budgetDropped.length > 0) {
+    for (const symbolId of budgetDropped) sliceCards.delete(symbolId);
+    wasTruncated = true;
+    droppedCandidates += budgetDropped.length;
+  }
+
+  const { cardsForPayload, cardRefs, fullCards, estimatedTokens } =
+    streamPayloadCards(cards, {
+      knownCardEtags: request.knownCardEtags,
+      sliceDepsBySymbol,
+      sliceSymbolSet: sliceCards,
+      retainFullCards: cacheable,
+    });
   const { symbolIndex, edges, confidenceDistribution } =
     await loadEdgesBetweenSymbols(
       conn,
@@ -339,7 +371,6 @@ export async function buildSlice(
       minCallConfidence,
       overlaySnapshot,
     );
-  const estimatedTokens = estimateTokens(cardsForPayload);
   const slice: GraphSlice = {
     repoId: request.repoId,
     versionId: request.versionId,
@@ -366,7 +397,9 @@ export async function buildSlice(
     }));
     // Determine the reason for truncation
     const hitCardLimit = cards.length >= budget.maxCards;
-    const hitTokenLimit = estimatedTokens >= budget.maxEstimatedTokens;
+    const hitTokenLimit =
+      budgetDropped.length > 0 ||
+      estimatedTokens >= budget.maxEstimatedTokens;
     const reasons: string[] = [];
     if (hitCardLimit) reasons.push(`card limit (${budget.maxCards})`);
     if (hitTokenLimit)
@@ -398,21 +431,23 @@ export async function buildSlice(
   // Cache the full slice (before ETag dedup) so that cache hits serve
   // complete data regardless of the requesting client's known ETags.
   if (canUseCache && repoEpoch !== undefined) {
-    const hasKnownEtags =
-      request.knownCardEtags && Object.keys(request.knownCardEtags).length > 0;
-    if (hasKnownEtags) {
-      // Rebuild full cards (without ETag dedup) for caching
-      const { cardsForPayload: fullCards } = buildPayloadCardsAndRefs(
-        cards,
-        undefined,
-        sliceDepsBySymbol,
-        sliceCards,
-      );
+    if (fullCards) {
       const fullSlice: GraphSlice = {
         ...slice,
         cards: fullCards,
         cardRefs: undefined,
       };
+      if (slice.truncation?.budgetUsed && cardRefs) {
+        const fullTokens = estimateTokens(fullCards);
+        fullSlice.truncation = {
+          ...slice.truncation,
+          budgetUsed: {
+            ...slice.truncation.budgetUsed,
+            estimatedTokens: fullTokens,
+          },
+          howToResume: { type: "token", value: fullTokens },
+        };
+      }
       setCachedSlice(cacheKey, fullSlice, repoEpoch);
     } else {
       setCachedSlice(cacheKey, slice, repoEpoch);
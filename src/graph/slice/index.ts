@@ -67,6 +67,7 @@ export {
   toCompactCard,
   toSliceSymbolCard,
   buildPayloadCardsAndRefs,
+  streamPayloadCards,
   encodeEdgesWithSymbolIndex,
   estimateTokens,
   SYMBOL_CARD_MAX_DEPS_PER_KIND,
@@ -0,0 +1,535 @@
+// =============================================================================
+// graph/slice/native-beam-search.ts — Native (Rust) in-memory beam search.
+//
+// Public exports:
+//   - NativeBeamSearchMode, nativeBeamSearchMode(env?)
+//   - packSliceGraph(graph)
+//   - beamSearchNative(...)
+//   - beamSearchInMemory(...)
+// =============================================================================
+
+/**
+ * Native slice beam search.
+ *
+ * The whole beam loop (frontier heap, threshold gating, token budget,
+ * neighbour expansion, scoring and dynamic cap) runs in the Rust addon over
+ * a packed copy of the graph snapshot, and only the accepted IDs, the final
+ * frontier and the optional explain trace come back. The packed copy is
+ * built once per `Graph` object, keyed like `getCsrSnapshot`, and uses the
+ * snapshot's CSR node IDs.
+ *
+ * Request-independent scoring inputs (structural and kind specificity,
+ * hotness, centrality signal, card token estimate) are computed here with
+ * the same helpers `beamSearch` uses, so the native engine only ports the
+ * request-dependent arithmetic and returns identical slices.
+ *
+ * `SDL_MCP_NATIVE_BEAM_SEARCH=parity` runs both engines, logs the first
+ * difference and returns the TypeScript result.
+ *
+ * @module graph/slice/native-beam-search
+ */
+
+import type { EdgeType, SliceBudget, SymbolId } from "../../domain/types.js";
+import type { EdgeRow } from "../../db/schema.js";
+import {
+  buildSliceGraphRust,
+  type RustSliceGraph,
+  type RustSliceGraphInput,
+  type RustSliceResult,
+} from "../../indexer/rustIndexer.js";
+import type { BeamExplainEntry } from "../../observability/types.js";
+import { logger } from "../../util/logger.js";
+import { tokenize } from "../../util/tokenize.js";
+
+import type { Graph } from "../buildGraph.js";
+import {
+  CSR_EDGE_TYPES,
+  getCsrSnapshot,
+  type CsrGraph,
+} from "../csr-snapshot.js";
+import {
+  calculateClusterCohesion,
+  calculateHotness,
+  calculateStructuralSpecificity,
+  calculateSymbolKindSpecificity,
+  computeCentralitySignal,
+  computeCentralityStats,
+} from "../score.js";
+import {
+  beamSearch,
+  estimateCardTokens,
+  getEdgeWhy,
+  normalizeEdgeConfidence,
+  type BeamSearchRequest,
+  type BeamSearchResult,
+  type BeamTraceCollector,
+  type FrontierItem,
+} from "./beam-search-engine.js";
+import {
+  START_NODE_SOURCE_SCORE,
+  getStartNodeWhy,
+  type ResolvedStartNode,
+} from "./start-node-resolver.js";
+
+export type NativeBeamSearchMode = "off" | "on" | "parity";
+
+/** Marks a missing file or cluster index in the packed columns. */
+const NO_INDEX = 0xffffffff;
+/** Edge type code for types outside `CSR_EDGE_TYPES`. */
+const UNKNOWN_EDGE_TYPE = 255;
+/** `edgeWeights[type] ?? 0.5` in `beamSearch`. */
+const DEFAULT_EDGE_WEIGHT = 0.5;
+
+const EVENT_ACCEPT = 0;
+const EVENT_EVICT = 1;
+
+interface PackedSliceGraph {
+  csr: CsrGraph;
+  native: RustSliceGraph | null;
+  /** Distinct cluster IDs; `nodeClusters` indexes into this. */
+  clusterIds: string[];
+}
+
+const packedByGraph = new WeakMap<Graph, PackedSliceGraph>();
+
+/**
+ * `SDL_MCP_NATIVE_BEAM_SEARCH`: on unless `0`/`false`/`no`; `parity` runs
+ * both engines and compares them.
+ */
+export function nativeBeamSearchMode(
+  env: NodeJS.ProcessEnv = process.env,
+): NativeBeamSearchMode {
+  const value = (env.SDL_MCP_NATIVE_BEAM_SEARCH ?? "").trim();
+  if (/^(0|false|no)$/i.test(value)) return "off";
+  if (/^parity$/i.test(value)) return "parity";
+  return "on";
+}
+
+function edgeTypeCode(type: string | undefined): number {
+  const code = CSR_EDGE_TYPES.indexOf(type as EdgeType);
+  return code >= 0 ? code : UNKNOWN_EDGE_TYPE;
+}
+
+/**
+ * Pack `graph` into the native slice graph columns. Rows follow each
+ * symbol's `adjacencyOut` order with one entry per target, carrying the last
+ * edge to it, which is the neighbour order `beamSearch` expands in.
+ */
+export function packSliceGraph(graph: Graph): {
+  csr: CsrGraph;
+  input: RustSliceGraphInput;
+  clusterIds: string[];
+} {
+  const csr = getCsrSnapshot(graph);
+  const n = csr.nodeCount;
+  const rows: Array<Map<number, EdgeRow>> = new Array(n);
+  const offsets = new Uint32Array(n + 1);
+  for (let node = 0; node < n; node++) {
+    const row = new Map<number, EdgeRow>();
+    for (const edge of graph.adjacencyOut.get(csr.symbolIds[node]) ?? []) {
+      const target = csr.nodeOf(edge.to_symbol_id);
+      if (target !== undefined) row.set(target, edge);
+    }
+    rows[node] = row;
+    offsets[node + 1] = offsets[node] + row.size;
+  }
+
+  const neighbors = new Uint32Array(offsets[n]);
+  const edgeTypes = new Uint8Array(offsets[n]);
+  const confidences = new Float64Array(offsets[n]);
+  for (let node = 0; node < n; node++) {
+    let at = offsets[node];
+    for (const [target, edge] of rows[node]) {
+      neighbors[at] = target;
+      edgeTypes[at] = edgeTypeCode(edge.type);
+      confidences[at] = normalizeEdgeConfidence(edge.confidence);
+      at++;
+    }
+  }
+
+  const centralityStats =
+    graph.centralityStats ??
+    (graph.metrics
+      ? computeCentralityStats(graph.metrics.values())
+      : { maxPageRank: 0, maxKCore: 0 });
+  const fileIndex = new Map<number, number>();
+  const filePaths: string[] = [];
+  const clusterIndex = new Map<string, number>();
+  const clusterIds: string[] = [];
+
+  const names: string[] = new Array(n);
+  const nodeFiles = new Uint32Array(n);
+  const rangeStartLines = new Float64Array(n);
+  const rangeEndLines = new Float64Array(n);
+  const structure = new Float64Array(n);
+  const kind = new Float64Array(n);
+  const hotness = new Float64Array(n);
+  const centrality = new Float64Array(n);
+  const cardTokens = new Float64Array(n);
+  const external = new Uint8Array(n);
+  const nodeClusters = new Uint32Array(n).fill(NO_INDEX);
+
+  for (let node = 0; node < n; node++) {
+    const symbolId = csr.symbolIds[node];
+    const symbol = graph.symbols.get(symbolId)!;
+    const file = symbol.file_id
+      ? graph.files?.get(symbol.file_id)
+      : undefined;
+    const metrics = graph.metrics?.get(symbolId) ?? null;
+
+    names[node] = symbol.name.toLowerCase();
+    if (file) {
+      let index = fileIndex.get(symbol.file_id);
+      if (index === undefined) {
+        index = filePaths.length;
+        fileIndex.set(symbol.file_id, index);
+        filePaths.push(file.rel_path);
+      }
+      nodeFiles[node] = index;
+    } else {
+      nodeFiles[node] = NO_INDEX;
+    }
+    rangeStartLines[node] = symbol.range_start_line;
+    rangeEndLines[node] = symbol.range_end_line;
+    structure[node] = calculateStructuralSpecificity(file);
+    kind[node] = calculateSymbolKindSpecificity(symbol);
+    hotness[node] = calculateHotness(metrics);
+    centrality[node] = metrics
+      ? computeCentralitySignal(
+          metrics.page_rank,
+          metrics.k_core,
+          centralityStats,
+        )
+      : 0;
+    cardTokens[node] = estimateCardTokens(symbolId, graph);
+    external[node] = symbol.external ? 1 : 0;
+
+    const clusterId = graph.clusters?.get(symbolId);
+    if (clusterId) {
+      let index = clusterIndex.get(clusterId);
+      if (index === undefined) {
+        index = clusterIds.length;
+        clusterIndex.set(clusterId, index);
+        clusterIds.push(clusterId);
+      }
+      nodeClusters[node] = index;
+    }
+  }
+
+  return {
+    csr,
+    clusterIds,
+    input: {
+      offsets,
+      neighbors,
+      edgeTypes,
+      confidences,
+      names,
+      nodeFiles,
+      rangeStartLines,
+      rangeEndLines,
+      filePaths,
+      filePathsLower: filePaths.map((path) => path.toLowerCase()),
+      structure,
+      kind,
+      hotness,
+      centrality,
+      cardTokens,
+      external,
+      nodeClusters,
+    },
+  };
+}
+
+function getPackedSliceGraph(graph: Graph): PackedSliceGraph {
+  let packed = packedByGraph.get(graph);
+  if (!packed) {
+    const { csr, input, clusterIds } = packSliceGraph(graph);
+    packed = { csr, native: buildSliceGraphRust(input), clusterIds };
+    packedByGraph.set(graph, packed);
+  }
+  return packed;
+}
+
+function edgeTypeOf(code: number): EdgeType | undefined {
+  return CSR_EDGE_TYPES[code];
+}
+
+function replayEvents(
+  result: RustSliceResult,
+  csr: CsrGraph,
+  traceCollector: BeamTraceCollector,
+): void {
+  const timestamp = Date.now();
+  for (let i = 0; i < result.eventKinds.length; i++) {
+    const kind = result.eventKinds[i];
+    const edgeType = edgeTypeOf(result.eventEdgeTypes[i]);
+    const from = result.eventFrom[i];
+    const edgeWeight = result.eventEdgeWeights[i];
+    const cause = edgeTypeOf(result.eventCauses[i]);
+    const causeWhy = cause ? getEdgeWhy(cause) : "";
+    const entry: BeamExplainEntry = {
+      symbolId: csr.symbolIds[result.eventNodes[i]],
+      decision:
+        kind === EVENT_ACCEPT
+          ? "accepted"
+          : kind === EVENT_EVICT
+            ? "evicted"
+            : "rejected",
+      totalScore: result.eventScores[i],
+      components: {
+        query: 0,
+        stacktrace: 0,
+        hotness: 0,
+        structure: 0,
+        kind: 0,
+      },
+      why:
+        kind === EVENT_ACCEPT
+          ? edgeType
+            ? `accept via ${edgeType}`
+            : "accept"
+          : kind === EVENT_EVICT
+            ? `evicted by better frontier candidate (${causeWhy})`
+            : `rejected: frontier full and worse than worst (${causeWhy})`,
+      edgeFromSymbolId: from === NO_INDEX ? undefined : csr.symbolIds[from],
+      edgeType,
+      edgeWeight: Number.isNaN(edgeWeight) ? undefined : edgeWeight,
+      iteration: result.eventIterations[i],
+      timestamp,
+    };
+    try {
+      if (kind === EVENT_ACCEPT) traceCollector.recordAccept(entry);
+      else if (kind === EVENT_EVICT) traceCollector.recordEvict(entry);
+      else traceCollector.recordReject(entry);
+    } catch (err) {
+      logger.warn("beam trace replay failed", { error: String(err) });
+    }
+  }
+}
+
+/**
+ * `beamSearch` in the native engine, or null when the addon is unavailable
+ * (or the search was already aborted) so the caller runs the TypeScript one.
+ */
+export function beamSearchNative(
+  graph: Graph,
+  startNodes: ResolvedStartNode[],
+  budget: Required<SliceBudget>,
+  request: BeamSearchRequest,
+  edgeWeights: Record<EdgeType, number>,
+  minConfidence: number,
+  signal?: AbortSignal,
+  traceCollector?: BeamTraceCollector | null,
+): BeamSearchResult | null {
+  if (signal?.aborted) return null;
+  const { csr, native, clusterIds } = getPackedSliceGraph(graph);
+  if (!native) return null;
+
+  const seeds = startNodes.filter(
+    (start) => csr.nodeOf(start.symbolId) !== undefined,
+  );
+  const nodesOf = (ids: Iterable<SymbolId>): Uint32Array => {
+    const nodes: number[] = [];
+    for (const id of ids) {
+      const node = csr.nodeOf(id);
+      if (node !== undefined) nodes.push(node);
+    }
+    return Uint32Array.from(nodes);
+  };
+  const entrySymbols = new Set(request.entrySymbols ?? []);
+  const entryClusterIds = new Set<string>(
+    request.clusterContext?.entryClusterIds ?? [],
+  );
+  const relatedClusterIds = new Set<string>(
+    request.clusterContext?.relatedClusterIds ?? [],
+  );
+  const clusterCohesionEnabled =
+    (entryClusterIds.size > 0 || relatedClusterIds.size > 0) &&
+    !!graph.clusters;
+
+  let result: RustSliceResult;
+  try {
+    result = native.beamSearch({
+      startNodes: nodesOf(seeds.map((start) => start.symbolId)),
+      startScores: Float64Array.from(
+        seeds,
+        (start) => START_NODE_SOURCE_SCORE[start.source],
+      ),
+      forcedNodes: nodesOf(
+        seeds
+          .filter((start) => start.source === "editedFile")
+          .map((start) => start.symbolId),
+      ),
+      entryNodes: nodesOf(entrySymbols),
+      requiredEntryCoverage: entrySymbols.size,
+      queryTokens: tokenize(request.taskText ?? ""),
+      stackTrace: request.stackTrace || undefined,
+      edgeWeights: Float64Array.from(
+        CSR_EDGE_TYPES,
+        (type) => edgeWeights[type] ?? DEFAULT_EDGE_WEIGHT,
+      ),
+      clusterBoost: clusterCohesionEnabled
+        ? Float64Array.from(clusterIds, (symbolClusterId) =>
+            calculateClusterCohesion({
+              symbolClusterId,
+              entryClusterIds,
+              relatedClusterIds,
+            }),
+          )
+        : new Float64Array(0),
+      minConfidence,
+      maxCards: budget.maxCards,
+      maxEstimatedTokens: budget.maxEstimatedTokens,
+      recordEvents: !!traceCollector,
+    });
+  } catch (error) {
+    logger.error(
+      "Native Rust beam search failed; falling back to TypeScript",
+      { error: error instanceof Error ? error.message : String(error) },
+    );
+    return null;
+  }
+
+  if (traceCollector) replayEvents(result, csr, traceCollector);
+
+  const frontier: FrontierItem[] = new Array(result.frontierNodes.length);
+  for (let i = 0; i < frontier.length; i++) {
+    const start = result.frontierStarts[i];
+    const edgeType = edgeTypeOf(result.frontierEdgeTypes[i]);
+    frontier[i] = {
+      symbolId: csr.symbolIds[result.frontierNodes[i]],
+      score: -result.frontierScores[i],
+      why:
+        start !== NO_INDEX
+          ? getStartNodeWhy(seeds[start].source)
+          : edgeType
+            ? getEdgeWhy(edgeType)
+            : "",
+      priority: result.frontierPriorities[i],
+      sequence: result.frontierSequences[i],
+    };
+  }
+
+  const sliceCards = new Set<SymbolId>();
+  for (const node of result.sliceNodes) sliceCards.add(csr.symbolIds[node]);
+
+  return {
+    sliceCards,
+    frontier,
+    wasTruncated: result.wasTruncated,
+    droppedCandidates: result.droppedCandidates,
+    maxFrontierSize: result.maxFrontierSize,
+  };
+}
+
+/** The first difference between two beam results, or null. */
+function diffBeamResults(
+  expected: BeamSearchResult,
+  actual: BeamSearchResult,
+): string | null {
+  const expectedCards = Array.from(expected.sliceCards);
+  const actualCards = Array.from(actual.sliceCards);
+  if (expectedCards.length !== actualCards.length) {
+    return `slice size ${expectedCards.length} vs ${actualCards.length}`;
+  }
+  for (let i = 0; i < expectedCards.length; i++) {
+    if (expectedCards[i] !== actualCards[i]) {
+      return `slice card ${i}: ${expectedCards[i]} vs ${actualCards[i]}`;
+    }
+  }
+  if (expected.frontier.length !== actual.frontier.length) {
+    return (
+      `frontier size ${expected.frontier.length} vs ` +
+      `${actual.frontier.length}`
+    );
+  }
+  for (let i = 0; i < expected.frontier.length; i++) {
+    const a = expected.frontier[i];
+    const b = actual.frontier[i];
+    if (
+      a.symbolId !== b.symbolId ||
+      a.score !== b.score ||
+      a.sequence !== b.sequence ||
+      a.priority !== b.priority ||
+      a.why !== b.why
+    ) {
+      return (
+        `frontier item ${i}: ${a.symbolId}@${a.score} vs ` +
+        `${b.symbolId}@${b.score}`
+      );
+    }
+  }
+  for (const key of [
+    "wasTruncated",
+    "droppedCandidates",
+    "maxFrontierSize",
+  ] as const) {
+    if (expected[key] !== actual[key]) {
+      return `${key} ${expected[key]} vs ${actual[key]}`;
+    }
+  }
+  return null;
+}
+
+/**
+ * The in-memory beam search used by `buildSlice`: the native engine when
+ * available and enabled, otherwise `beamSearch`.
+ */
+export function beamSearchInMemory(
+  graph: Graph,
+  startNodes: ResolvedStartNode[],
+  budget: Required<SliceBudget>,
+  request: BeamSearchRequest,
+  edgeWeights: Record<EdgeType, number>,
+  minConfidence: number,
+  signal?: AbortSignal,
+  traceCollector?: BeamTraceCollector | null,
+): BeamSearchResult {
+  const mode = nativeBeamSearchMode();
+  if (mode === "off") {
+    return beamSearch(
+      graph,
+      startNodes,
+      budget,
+      request,
+      edgeWeights,
+      minConfidence,
+      signal,
+      traceCollector,
+    );
+  }
+
+  const native = beamSearchNative(
+    graph,
+    startNodes,
+    budget,
+    request,
+    edgeWeights,
+    minConfidence,
+    signal,
+    mode === "parity" ? null : traceCollector,
+  );
+  if (native && mode === "on") return native;
+
+  const result = beamSearch(
+    graph,
+    startNodes,
+    budget,
+    request,
+    edgeWeights,
+    minConfidence,
+    signal,
+    traceCollector,
+  );
+  if (native && !signal?.aborted) {
+    const difference = diffBeamResults(result, native);
+    if (difference) {
+      logger.warn("Native beam search differs from TypeScript", {
+        repoId: graph.repoId,
+        difference,
+      });
+    }
+  }
+  return result;
+}
@@ -412,95 +412,119 @@ export function toSliceSymbolCard(
   return sliceCard;
 }
 
-export function buildPayloadCardsAndRefs(
-  cards: SymbolCard[],
-  knownCardEtags?: Record<SymbolId, string>,
-  sliceDepsBySymbol?: Map<SymbolId, SliceSymbolDeps>,
-  sliceSymbolSet?: Set<SymbolId>,
-): {
+export interface PayloadCardStream {
   cardsForPayload: SliceSymbolCard[];
   cardRefs?: Array<{
     symbolId: SymbolId;
     etag: string;
     detailLevel: CardDetailLevel;
   }>;
-} {
-  const hasKnownCardEtags = Boolean(
-    knownCardEtags && Object.keys(knownCardEtags).length > 0,
-  );
+  /**
+   * Every card built, including ones the client already holds; set when
+   * `retainFullCards` was requested and `knownCardEtags` removed cards.
+   */
+  fullCards?: SliceSymbolCard[];
+  /** `estimateTokens(cardsForPayload)`, summed as each card is written. */
+  estimatedTokens: number;
+}
 
-  if (!hasKnownCardEtags) {
-    return {
-      cardsForPayload: cards.map((card) => {
-        const detailLevel = card.detailLevel ?? "compact";
-        const normalized: SymbolCard = {
-          ...card,
-          detailLevel,
-        };
-        delete normalized.etag;
-        const deps = resolveSliceDeps(
-          normalized,
-          sliceDepsBySymbol,
-          sliceSymbolSet,
-        );
-        const callResolution = sliceSymbolSet
-          ? filterCallResolutionBySliceSymbolSet(
-              normalized.callResolution,
-              sliceSymbolSet,
-            )
-          : normalized.callResolution;
-        return toSliceSymbolCard(normalized, deps, callResolution);
-      }),
-    };
-  }
+function toPayloadCard(
+  card: SymbolCard,
+  sliceDepsBySymbol?: Map<SymbolId, SliceSymbolDeps>,
+  sliceSymbolSet?: Set<SymbolId>,
+): SliceSymbolCard {
+  const normalized: SymbolCard = {
+    ...card,
+    detailLevel: card.detailLevel ?? "compact",
+  };
+  delete normalized.etag;
+  const deps = resolveSliceDeps(normalized, sliceDepsBySymbol, sliceSymbolSet);
+  const callResolution = sliceSymbolSet
+    ? filterCallResolutionBySliceSymbolSet(
+        normalized.callResolution,
+        sliceSymbolSet,
+      )
+    : normalized.callResolution;
+  return toSliceSymbolCard(normalized, deps, callResolution);
+}
 
+/**
+ * Build wire cards in a single pass over hydrated cards: each card is
+ * converted, hashed when the client sent `knownCardEtags`, and charged
+ * against the running token estimate as it is written. With
+ * `retainFullCards` the ETag-free card list for the slice cache comes out
+ * of the same pass instead of a second build.
+ */
+export function streamPayloadCards(
+  cards: Iterable<SymbolCard>,
+  options: {
+    knownCardEtags?: Record<SymbolId, string>;
+    sliceDepsBySymbol?: Map<SymbolId, SliceSymbolDeps>;
+    sliceSymbolSet?: Set<SymbolId>;
+    retainFullCards?: boolean;
+  } = {},
+): PayloadCardStream {
+  const knownEtags =
+    options.knownCardEtags && Object.keys(options.knownCardEtags).length > 0
+      ? options.knownCardEtags
+      : undefined;
   const cardsForPayload: SliceSymbolCard[] = [];
-  const cardRefs: Array<{
-    symbolId: SymbolId;
-    etag: string;
-    detailLevel: CardDetailLevel;
-  }> = [];
-
-  const knownEtags = knownCardEtags ?? {};
+  const cardRefs: PayloadCardStream["cardRefs"] = knownEtags ? [] : undefined;
+  const fullCards =
+    knownEtags && options.retainFullCards ? ([] as SliceSymbolCard[]) : undefined;
+  let estimatedTokens = 0;
 
   for (const card of cards) {
-    const detailLevel = card.detailLevel ?? "compact";
-    const cardWithoutEtag: SymbolCard = { ...card };
-    cardWithoutEtag.detailLevel = detailLevel;
-    delete cardWithoutEtag.etag;
-    const deps = resolveSliceDeps(
-      cardWithoutEtag,
-      sliceDepsBySymbol,
-      sliceSymbolSet,
+    const payloadCard = toPayloadCard(
+      card,
+      options.sliceDepsBySymbol,
+      options.sliceSymbolSet,
     );
-    const callResolution = sliceSymbolSet
-      ? filterCallResolutionBySliceSymbolSet(
-          cardWithoutEtag.callResolution,
-          sliceSymbolSet,
-        )
-      : cardWithoutEtag.callResolution;
-    const payloadCard = toSliceSymbolCard(cardWithoutEtag, deps, callResolution);
-    const etag = hashCard(payloadCard as unknown as SymbolCard);
-
-    cardRefs.push({
-      symbolId: card.symbolId,
-      etag,
-      detailLevel,
-    });
-
-    if (knownEtags[card.symbolId] === etag) {
-      continue;
+    if (knownEtags && cardRefs) {
+      const etag = hashCard(payloadCard as unknown as SymbolCard);
+      cardRefs.push({
+        symbolId: card.symbolId,
+        etag,
+        detailLevel: payloadCard.detailLevel,
+      });
+      fullCards?.push(payloadCard);
+      if (knownEtags[card.symbolId] === etag) {
+        continue;
+      }
     }
-
     cardsForPayload.push(payloadCard);
+    estimatedTokens += estimateTokens([payloadCard]);
   }
 
   return {
     cardsForPayload,
-    cardRefs,
+    ...(cardRefs ? { cardRefs } : {}),
+    ...(fullCards ? { fullCards } : {}),
+    estimatedTokens,
   };
 }
 
+export function buildPayloadCardsAndRefs(
+  cards: SymbolCard[],
+  knownCardEtags?: Record<SymbolId, string>,
+  sliceDepsBySymbol?: Map<SymbolId, SliceSymbolDeps>,
+  sliceSymbolSet?: Set<SymbolId>,
+): {
+  cardsForPayload: SliceSymbolCard[];
+  cardRefs?: Array<{
+    symbolId: SymbolId;
+    etag: string;
+    detailLevel: CardDetailLevel;
+  }>;
+} {
+  const { cardsForPayload, cardRefs } = streamPayloadCards(cards, {
+    knownCardEtags,
+    sliceDepsBySymbol,
+    sliceSymbolSet,
+  });
+  return cardRefs ? { cardsForPayload, cardRefs } : { cardsForPayload };
+}
+
 export function encodeEdgesWithSymbolIndex(
   symbolIds: SymbolId[],
   dbEdges: ReadonlyArray<{
@@ -7,7 +7,9 @@
  * @module graph/slice/truncation-handler
  */
 
+import type { SymbolCard, SymbolId } from "../../domain/types.js";
 import { SLICE_SCORE_THRESHOLD } from "../../config/constants.js";
+import { estimateTokens } from "./slice-serializer.js";
 
 export const DYNAMIC_CAP_MIN_CARDS = 6;
 export const DYNAMIC_CAP_HIGH_CONFIDENCE_MARGIN = 0.2;
@@ -64,6 +66,66 @@ export function shouldTightenDynamicCardCap(state: DynamicCapState): boolean {
   return state.nextFrontierScore < dropThreshold;
 }
 
+export interface CardAdmission {
+  /** Hydrated cards that fit the budget, in hydration order. */
+  admitted: SymbolCard[];
+  /** Symbols whose cards were left unbuilt once the budget ran out. */
+  dropped: SymbolId[];
+}
+
+/**
+ * Charge hydrated cards against `maxEstimatedTokens` in slice priority
+ * order (beam acceptance order) and admit them until the next card would
+ * overflow, so the serializer never builds, hashes or writes cards past the
+ * budget. Charges are estimated from the hydrated card, which tracks its
+ * wire card closely. Cards listed in `knownCardEtags` are free, since the
+ * client usually gets only a ref for them. The first card is always
+ * admitted.
+ */
+export function admitCardsWithinTokenBudget(
+  cards: SymbolCard[],
+  priority: Iterable<SymbolId>,
+  maxEstimatedTokens: number,
+  knownCardEtags?: Record<SymbolId, string>,
+): CardAdmission {
+  const pending = new Map(cards.map((card) => [card.symbolId, card]));
+  const admittedIds = new Set<SymbolId>();
+  const dropped: SymbolId[] = [];
+  let usedTokens = 0;
+  let budgetReached = false;
+
+  const charge = (card: SymbolCard): void => {
+    pending.delete(card.symbolId);
+    if (!budgetReached) {
+      const cost =
+        knownCardEtags?.[card.symbolId] !== undefined
+          ? 0
+          : estimateTokens([card]);
+      if (admittedIds.size === 0 || usedTokens + cost <= maxEstimatedTokens) {
+        usedTokens += cost;
+        admittedIds.add(card.symbolId);
+        return;
+      }
+      budgetReached = true;
+    }
+    dropped.push(card.symbolId);
+  };
+
+  for (const symbolId of priority) {
+    const card = pending.get(symbolId);
+    if (card) charge(card);
+  }
+  for (const card of [...pending.values()]) charge(card);
+
+  return {
+    admitted:
+      dropped.length === 0
+        ? cards
+        : cards.filter((card) => admittedIds.has(card.symbolId)),
+    dropped,
+  };
+}
+
 export interface TruncationInfo {
   truncated: boolean;
   droppedCards: number;
@@ -5,6 +5,7 @@ import {
   captureActiveRepoEpoch,
   isRepoEpochCurrent,
 } from "../services/repo-lifecycle.js";
+import { SymbolIdFilter } from "./symbol-filter.js";
 
 interface SliceBuildRequest {
   repoId: RepoId;
@@ -30,6 +31,8 @@ interface SliceCacheEntry {
   repoEpoch: number;
   expiresAt: number;
   createdAt: number;
+  /** Start, card and frontier symbols, for delta invalidation. */
+  symbols: SymbolIdFilter;
 }
 
 const DEFAULT_SLICE_CACHE_TTL_MS = 60_000;
@@ -56,6 +59,8 @@ interface SliceCacheStats {
   hits: number;
   misses: number;
   evictions: number;
+  /** Entries dropped by {@link invalidateSliceCacheForSymbols}. */
+  deltaInvalidations: number;
   currentSize: number;
   hitRate: number;
 }
@@ -64,6 +69,7 @@ let cacheStats: SliceCacheStats = {
   hits: 0,
   misses: 0,
   evictions: 0,
+  deltaInvalidations: 0,
   currentSize: 0,
   hitRate: 0,
 };
@@ -185,12 +191,44 @@ export function setCachedSlice(
     repoEpoch: expectedEpoch,
     expiresAt: now + sliceCacheTtlMs,
     createdAt: now,
+    symbols: SymbolIdFilter.from(sliceSymbolIds(slice)),
   });
   accessOrderMap.set(key, true);
   cacheStats.currentSize++;
   return true;
 }
 
+function sliceSymbolIds(slice: GraphSlice): SymbolId[] {
+  return [
+    ...(slice.startSymbols ?? []),
+    ...(slice.symbolIndex ?? []),
+    ...(slice.frontier ?? []).map((item) => item.symbolId),
+  ];
+}
+
+/**
+ * Evict the repo's cached slices that may include any of `symbolIds`, e.g.
+ * the dependency frontier of a live-index patch. Other slices stay cached.
+ * Returns the number of entries evicted.
+ */
+export function invalidateSliceCacheForSymbols(
+  repoId: RepoId,
+  symbolIds: readonly SymbolId[],
+): number {
+  if (symbolIds.length === 0) return 0;
+  let evicted = 0;
+  for (const [key, entry] of Array.from(sliceCache.entries())) {
+    if (entry.slice.repoId !== repoId) continue;
+    if (!entry.symbols.intersects(symbolIds)) continue;
+    sliceCache.delete(key);
+    removeFromAccessOrder(key);
+    cacheStats.currentSize--;
+    evicted++;
+  }
+  cacheStats.deltaInvalidations += evicted;
+  return evicted;
+}
+
 export function invalidateVersion(versionId: VersionId): void {
   const keysToDelete: string[] = [];
   for (const key of sliceCache.keys()) {
@@ -212,6 +250,7 @@ export function clearSliceCache(): void {
     hits: 0,
     misses: 0,
     evictions: 0,
+    deltaInvalidations: 0,
     currentSize: 0,
     hitRate: 0,
   };
@@ -235,6 +274,7 @@ export function resetSliceCacheStats(): void {
     hits: 0,
     misses: 0,
     evictions: 0,
+    deltaInvalidations: 0,
     currentSize: sliceCache.size,
     hitRate: 0,
   };
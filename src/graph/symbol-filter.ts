@@ -0,0 +1,88 @@
+/**
+ * Compact membership filter over symbol IDs.
+ *
+ * A Bloom filter sized at roughly ten bits per symbol with five probes
+ * (about 1% false positives). Cache entries record the symbols they were
+ * built from in one of these, so a live-index delta can evict only the
+ * entries it may affect: a false positive costs one unnecessary eviction,
+ * never a stale hit.
+ *
+ * @module graph/symbol-filter
+ */
+
+const BITS_PER_SYMBOL = 10;
+const PROBES = 5;
+const MIN_BITS = 64;
+
+/** FNV-1a, 32-bit. */
+function fnv1a(value: string): number {
+  let hash = 0x811c9dc5;
+  for (let i = 0; i < value.length; i++) {
+    hash ^= value.charCodeAt(i);
+    hash = Math.imul(hash, 0x01000193);
+  }
+  return hash >>> 0;
+}
+
+/** Finaliser from MurmurHash3, used to derive the second probe hash. */
+function mix(hash: number): number {
+  hash ^= hash >>> 16;
+  hash = Math.imul(hash, 0x85ebca6b);
+  hash ^= hash >>> 13;
+  hash = Math.imul(hash, 0xc2b2ae35);
+  hash ^= hash >>> 16;
+  return hash >>> 0;
+}
+
+export class SymbolIdFilter {
+  private readonly bits: Uint32Array;
+  /** Bit count minus one; the bit count is a power of two. */
+  private readonly mask: number;
+
+  private constructor(bitCount: number) {
+    this.bits = new Uint32Array(bitCount >>> 5);
+    this.mask = bitCount - 1;
+  }
+
+  /** A filter holding `ids`, sized for their count. */
+  static from(ids: Iterable<string>): SymbolIdFilter {
+    const list = Array.isArray(ids) ? (ids as string[]) : Array.from(ids);
+    let bitCount = MIN_BITS;
+    while (bitCount < list.length * BITS_PER_SYMBOL) bitCount *= 2;
+    const filter = new SymbolIdFilter(bitCount);
+    for (const id of list) filter.add(id);
+    return filter;
+  }
+
+  add(id: string): void {
+    const h1 = fnv1a(id);
+    const h2 = mix(h1) | 1;
+    for (let i = 0; i < PROBES; i++) {
+      const bit = (h1 + Math.imul(i, h2)) & this.mask;
+      this.bits[bit >>> 5] |= 1 << (bit & 31);
+    }
+  }
+
+  /** False only when `id` was never added. */
+  mightContain(id: string): boolean {
+    const h1 = fnv1a(id);
+    const h2 = mix(h1) | 1;
+    for (let i = 0; i < PROBES; i++) {
+      const bit = (h1 + Math.imul(i, h2)) & this.mask;
+      if ((this.bits[bit >>> 5] & (1 << (bit & 31))) === 0) return false;
+    }
+    return true;
+  }
+
+  /** True when any of `ids` may have been added. */
+  intersects(ids: Iterable<string>): boolean {
+    for (const id of ids) {
+      if (this.mightContain(id)) return true;
+    }
+    return false;
+  }
+
+  get byteLength(): number {
+    return this.bits.byteLength;
+  }
+}
@@ -0,0 +1,115 @@
+/**
+ * Incremental community detection state.
+ *
+ * Each cluster refresh keeps the call graph it clustered and the raw native
+ * community labels per repo, in process. The next refresh diffs its graph
+ * against that snapshot: nodes whose call rows changed (plus the endpoints of
+ * edges that appeared or vanished) are flagged, every other node carries its
+ * previous community, and the native kernel only relabels the flagged
+ * neighborhood. Large diffs, and the first refresh after start-up, fall back
+ * to a full run.
+ *
+ * @module indexer/cluster-incremental
+ */
+
+import { sameCsrRow, type CsrGraph } from "../graph/csr-snapshot.js";
+import {
+  UNCLUSTERED_LABEL,
+  type PreviousCommunities,
+} from "./rustIndexer.js";
+
+/** Above this share of changed nodes a full run is as cheap and cleaner. */
+export const INCREMENTAL_MAX_CHANGED_FRACTION = 0.25;
+
+/** A clustered call graph and its raw per-node community labels. */
+export interface CommunitySnapshot {
+  graph: CsrGraph;
+  labels: Uint32Array;
+}
+
+const snapshots = new Map<string, CommunitySnapshot>();
+
+/**
+ * Whether cluster refreshes reuse the previous refresh's communities. On by
+ * default; `SDL_MCP_INCREMENTAL_CLUSTERS=0` relabels the whole graph every
+ * time.
+ */
+export function shouldUseIncrementalClusters(
+  env: NodeJS.ProcessEnv = process.env,
+): boolean {
+  return !/^(0|false|no)$/i.test(
+    (env.SDL_MCP_INCREMENTAL_CLUSTERS ?? "").trim(),
+  );
+}
+
+export function recallCommunities(
+  repoId: string,
+): CommunitySnapshot | undefined {
+  return snapshots.get(repoId);
+}
+
+export function rememberCommunities(
+  repoId: string,
+  snapshot: CommunitySnapshot,
+): void {
+  snapshots.set(repoId, snapshot);
+}
+
+/** Drop the snapshot for `repoId`, or every snapshot when omitted. */
+export function forgetCommunities(repoId?: string): void {
+  if (repoId === undefined) snapshots.clear();
+  else snapshots.delete(repoId);
+}
+
+/**
+ * Seed labels for an incremental run of `graph` from `previous`, or null when
+ * more than `maxChangedFraction` of the nodes changed.
+ */
+export function planIncrementalCommunities(
+  previous: CommunitySnapshot,
+  graph: CsrGraph,
+  maxChangedFraction: number = INCREMENTAL_MAX_CHANGED_FRACTION,
+): PreviousCommunities | null {
+  const nodeCount = graph.symbolIds.length;
+  const groups = new Uint32Array(nodeCount).fill(UNCLUSTERED_LABEL);
+  const changed = new Uint8Array(nodeCount);
+  let changedCount = 0;
+  const mark = (node: number | undefined): void => {
+    if (node !== undefined && changed[node] === 0) {
+      changed[node] = 1;
+      changedCount++;
+    }
+  };
+  const markTargets = (g: CsrGraph, node: number): void => {
+    for (let e = g.offsets[node]; e < g.offsets[node + 1]; e++) {
+      mark(graph.nodeOf(g.symbolIds[g.neighbors[e]]));
+    }
+  };
+
+  const old = previous.graph;
+  const kept = new Uint8Array(old.symbolIds.length);
+  for (let node = 0; node < nodeCount; node++) {
+    const oldNode = old.nodeOf(graph.symbolIds[node]);
+    if (oldNode === undefined) {
+      mark(node);
+      continue;
+    }
+    kept[oldNode] = 1;
+    groups[node] = previous.labels[oldNode];
+    if (
+      (graph.external?.[node] ?? 0) !== (old.external?.[oldNode] ?? 0) ||
+      !sameCsrRow(graph, node, old, oldNode)
+    ) {
+      mark(node);
+      markTargets(graph, node);
+      markTargets(old, oldNode);
+    }
+  }
+  // Callers that disappeared take their edges with them.
+  for (let oldNode = 0; oldNode < kept.length; oldNode++) {
+    if (kept[oldNode] === 0) markTargets(old, oldNode);
+  }
+
+  if (changedCount > nodeCount * maxChangedFraction) return null;
+  return { groups, changed };
+}
@@ -8,8 +8,32 @@ import { logger } from "../util/logger.js";
 import { normalizePath } from "../util/paths.js";
 import { computeClustersTS } from "../graph/cluster.js";
 import type { FoldedCentralityResult } from "../graph/metrics.js";
-import { traceProcessesTS } from "../graph/process.js";
-import { computeClustersRust, traceProcessesRust } from "./rustIndexer.js";
+import {
+  mergeIncrementalProcesses,
+  planIncrementalProcesses,
+  recallProcesses,
+  rememberProcesses,
+  shouldUseIncrementalProcesses,
+  traceProcessesTS,
+} from "../graph/process.js";
+import { buildCsrGraph, type CsrGraph } from "../graph/csr-snapshot.js";
+import { safeCompileRegex } from "../util/safeRegex.js";
+import {
+  clusterAssignmentsFromLabels,
+  computeClustersCsrRust,
+  computeClustersRust,
+  computeCommunitiesCsrRust,
+  supportsRustCsrKernels,
+  traceProcessesCsrRust,
+  traceProcessesRust,
+} from "./rustIndexer.js";
+import {
+  planIncrementalCommunities,
+  recallCommunities,
+  rememberCommunities,
+  shouldUseIncrementalClusters,
+} from "./cluster-incremental.js";
+import type { ClusterAssignment, ProcessTrace } from "./cluster-types.js";
 import {
   detectAlgoCapability,
   resetRepoGraphProjection,
@@ -30,7 +54,7 @@ import type { AlgorithmRefreshConfig } from "../config/types.js";
 import { DEFAULT_LOUVAIN_MAX_CALL_EDGES } from "../config/constants.js";
 import {
   CentralityWorkerTimeoutError,
-  runCentralityWorker,
+  runCentrality,
   type CentralityWorkerResult,
 } from "../graph/centrality-worker-runner.js";
 
@@ -45,6 +69,85 @@ const DEFAULT_ENTRY_PATTERNS = [
   "^start$",
 ];
 
+/**
+ * Native clusters for the CSR call graph. The parallel community kernel
+ * reuses the previous refresh's communities when few nodes changed; older
+ * addons without it run the sequential CSR kernel.
+ */
+function computeCallGraphClusters(
+  repoId: string,
+  graph: CsrGraph,
+  minClusterSize: number,
+): ClusterAssignment[] | null {
+  const incremental = shouldUseIncrementalClusters();
+  const previous = incremental ? recallCommunities(repoId) : undefined;
+  const plan = previous ? planIncrementalCommunities(previous, graph) : null;
+  const labels = computeCommunitiesCsrRust(graph, plan);
+  if (!labels) return computeClustersCsrRust(graph, minClusterSize);
+
+  if (incremental) rememberCommunities(repoId, { graph, labels });
+  logger.debug("cluster-orchestrator: communities computed", {
+    repoId,
+    mode: plan ? "incremental" : "full",
+    nodeCount: graph.symbolIds.length,
+  });
+  return clusterAssignmentsFromLabels(graph, labels, minClusterSize);
+}
+
+/**
+ * Native process traces over the CSR call graph. Entries whose previous
+ * trace only visited unchanged call rows keep that trace; the rest are
+ * retraced in one native call. Null when the addon lacks the CSR tracer.
+ */
+function traceCallGraphProcesses(
+  repoId: string,
+  graph: CsrGraph,
+  entrySymbolIds: string[],
+  maxDepth: number,
+): ProcessTrace[] | null {
+  const incremental = shouldUseIncrementalProcesses();
+  const previous = incremental ? recallProcesses(repoId) : undefined;
+  const plan = previous
+    ? planIncrementalProcesses(previous, graph, entrySymbolIds, maxDepth)
+    : null;
+  const retraced = traceProcessesCsrRust(
+    graph,
+    plan ? plan.retrace : entrySymbolIds,
+    maxDepth,
+  );
+  if (!retraced) return null;
+
+  const traces = plan
+    ? mergeIncrementalProcesses(entrySymbolIds, plan, retraced)
+    : retraced;
+  if (incremental) rememberProcesses(repoId, { graph, maxDepth, traces });
+  logger.debug("cluster-orchestrator: processes traced", {
+    repoId,
+    mode: plan ? "incremental" : "full",
+    entryCount: entrySymbolIds.length,
+    retracedCount: plan ? plan.retrace.length : entrySymbolIds.length,
+  });
+  return traces;
+}
+
+/** Sorted, unique IDs of symbols whose name matches an entry pattern. */
+function selectEntrySymbolIds(
+  symbols: readonly { symbolId: string; name: string }[],
+  entryPatterns: readonly string[],
+): string[] {
+  const patterns = entryPatterns
+    .map((pattern) => safeCompileRegex(pattern))
+    .filter((re): re is RegExp => re !== null);
+  if (patterns.length === 0) return [];
+  return [
+    ...new Set(
+      symbols
+        .filter((s) => patterns.some((re) => re.test(s.name)))
+        .map((s) => s.symbolId),
+    ),
+  ].sort();
+}
+
 const DEFAULT_ALGORITHM_REFRESH_CONFIG: AlgorithmRefreshConfig = {
   enabled: true,
   pageRank: { enabled: true },
@@ -243,7 +346,10 @@ export async function computeAndStoreClustersAndProcesses(params: {
     minClusterSize = DEFAULT_MIN_CLUSTER_SIZE,
     maxProcessDepth = DEFAULT_MAX_PROCESS_DEPTH,
     algorithmRefresh: rawAlgorithmRefresh,
-    centralityRunner = runCentralityWorker,
+    centralityRunner = (input, timeoutMs) =>
+      runCentrality(input, timeoutMs, {
+        loadPreviousPageRank: () => ladybugDb.getPageRankByRepo(conn, repoId),
+      }),
     algorithmCapabilityDetector = detectAlgoCapability,
     louvainRunner = runLouvain,
     includeTimings = false,
@@ -375,11 +481,28 @@ export async function computeAndStoreClustersAndProcesses(params: {
     };
   }
 
+  // One CSR call graph feeds both native kernels. Callee endpoints outside
+  // the symbol set stay as (flagged) nodes so process traces still reach
+  // them; clustering ignores them.
+  const callGraph = supportsRustCsrKernels()
+    ? buildCsrGraph(
+        symbolIds,
+        (emit) => {
+          for (const edge of callEdges) {
+            emit(edge.callerId, edge.calleeId, "call");
+          }
+        },
+        { includeUnknownEndpoints: true },
+      )
+    : null;
+
   emitSubstage("clusterRefresh");
   const clustersStartMs = Date.now();
   const clusterAssignments = await measureSubphase(
     "clusterCompute",
     async () =>
+      (callGraph &&
+        computeCallGraphClusters(repoId, callGraph, minClusterSize)) ??
       computeClustersRust(
         symbolIds.map((symbolId) => ({ symbolId })),
         clusterEdges,
@@ -604,6 +727,13 @@ export async function computeAndStoreClustersAndProcesses(params: {
   const processes = await measureSubphase(
     "processCompute",
     async () =>
+      (callGraph &&
+        traceCallGraphProcesses(
+          repoId,
+          callGraph,
+          selectEntrySymbolIds(symbols, entryPatterns),
+          maxProcessDepth,
+        )) ??
       traceProcessesRust(
         symbols.map((symbol) => ({
           symbolId: symbol.symbolId,
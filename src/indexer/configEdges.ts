@@ -21,7 +21,7 @@ export interface PerTreeConfigEdgeContext {
   config: RepoConfig;
   tree: Parser.Tree;
   fileSymbols: LadybugSymbolRow[];
-  allSymbolsByName: Map<string, SymbolLiteRow[]>;
+  allSymbolsByName: ReadonlyMap<string, SymbolLiteRow[]>;
 }
 
 const EXPRESS_CONFIG_EXTENSIONS = new Set([
@@ -144,7 +144,7 @@ function extractHandlerName(node: Parser.SyntaxNode | null | undefined): string
 function resolveHandlerSymbol(
   handlerName: string,
   fileSymbols: LadybugSymbolRow[],
-  nameToSymbols: Map<string, SymbolLiteRow[]>,
+  nameToSymbols: ReadonlyMap<string, SymbolLiteRow[]>,
 ): { symbolId: string; name: string; exported: boolean } | null {
   const localMatches = fileSymbols.filter(
     (symbol) => symbol.name === handlerName,
@@ -62,8 +62,8 @@ export function resolveCallTarget(
   importedNameToSymbolIds: Map<string, string[]>,
   namespaceImports: Map<string, Map<string, string>>,
   adapter?: LanguageAdapter | null,
-  globalNameToSymbolIds?: Map<string, string[]>,
-  globalPreferredSymbolId?: Map<string, string>,
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>,
+  globalPreferredSymbolId?: ReadonlyMap<string, string>,
 ): ResolvedCallTarget | null {
   if (adapter?.resolveCall) {
     const adapterResolved = adapter.resolveCall({
@@ -62,6 +62,7 @@ export async function resolveImportTargets(
       specifier: imp.specifier,
       extensions,
       knownRepoPaths: cache?.fileByRelPath,
+      includePathIndex: cache?.includePathIndex,
     });
 
     const importedNames = new Set<string>();
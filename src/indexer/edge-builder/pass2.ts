@@ -33,8 +33,8 @@ async function resolveTsCallEdgesPass2(params: {
   tsResolver: TsCallResolver | null;
   languages: string[];
   createdCallEdges: Set<string>;
-  globalNameToSymbolIds?: Map<string, string[]>;
-  globalPreferredSymbolId?: Map<string, string>;
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>;
+  globalPreferredSymbolId?: ReadonlyMap<string, string>;
   telemetry?: CallResolutionTelemetry;
   mode?: "full" | "incremental";
   submitEdgeWrite?: SubmitEdgeWrite;
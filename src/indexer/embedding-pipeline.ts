@@ -0,0 +1,178 @@
+/**
+ * Batching and write-behind for the symbol-embedding refresh.
+ *
+ * The refresh sorts its inputs by text length, so neighbouring inputs pad
+ * to similar sequence lengths. `EmbeddingBatcher` cuts that order into
+ * batches whose padded size (rows times the longest input, which is what
+ * the tokenizer pads every row to) fits a target latency, learned from the
+ * batches already embedded. Short inputs fill whole batches; long ones get
+ * smaller batches instead of one multi-second stall.
+ *
+ * `EmbeddingWriteQueue` takes finished vectors off the inference loop and
+ * writes them in coalesced chunks in the background, one write at a time,
+ * so ONNX keeps running while LadybugDB commits. Once too many rows are
+ * queued, pushes wait for the write in flight, so inference never runs
+ * unboundedly ahead of the database.
+ *
+ * Set `SDL_MCP_EMBEDDING_PIPELINE=0` to keep fixed-size batches and wait on
+ * every write before embedding the next batch.
+ *
+ * @module indexer/embedding-pipeline
+ */
+
+/** Weight of the newest batch in the per-unit latency estimate. */
+const COST_SMOOTHING = 0.3;
+
+export function isEmbeddingPipelineEnabled(
+  env: NodeJS.ProcessEnv = process.env,
+): boolean {
+  return !/^(0|false|no)$/i.test(
+    (env.SDL_MCP_EMBEDDING_PIPELINE ?? "").trim(),
+  );
+}
+
+export interface EmbeddingBatcherOptions {
+  /** Upper bound on rows per batch. */
+  maxBatchSize: number;
+  /** Latency one batch should take, once a batch has been measured. */
+  targetBatchMs: number;
+  /** When false, every batch takes `maxBatchSize` rows. */
+  adaptive: boolean;
+}
+
+export class EmbeddingBatcher<T> {
+  private cursor = 0;
+  /** Smoothed milliseconds per padded input unit; unset until measured. */
+  private msPerUnit: number | undefined;
+
+  /**
+   * @param items Inputs sorted by ascending `size`.
+   * @param size Input length in the units latency scales with, e.g. the
+   *   text length as a proxy for its token count.
+   */
+  constructor(
+    private readonly items: readonly T[],
+    private readonly size: (item: T) => number,
+    private readonly options: EmbeddingBatcherOptions,
+  ) {}
+
+  get remaining(): number {
+    return this.items.length - this.cursor;
+  }
+
+  /** The next batch in input order, or null once every input is taken. */
+  next(): T[] | null {
+    if (this.cursor >= this.items.length) return null;
+    const start = this.cursor;
+    const maxEnd = Math.min(
+      this.items.length,
+      start + Math.max(1, this.options.maxBatchSize),
+    );
+    const budget =
+      this.options.adaptive && this.msPerUnit !== undefined && this.msPerUnit > 0
+        ? this.options.targetBatchMs / this.msPerUnit
+        : Infinity;
+    let end = start + 1;
+    let longest = this.unitSize(this.items[start]);
+    while (end < maxEnd) {
+      const candidate = Math.max(longest, this.unitSize(this.items[end]));
+      if ((end - start + 1) * candidate > budget) break;
+      longest = candidate;
+      end++;
+    }
+    this.cursor = end;
+    return this.items.slice(start, end);
+  }
+
+  /** Feed one embedded batch's latency into the sizing of later batches. */
+  record(batch: readonly T[], elapsedMs: number): void {
+    if (!this.options.adaptive || batch.length === 0) return;
+    let longest = 1;
+    for (const item of batch) longest = Math.max(longest, this.unitSize(item));
+    const sample = Math.max(0, elapsedMs) / (batch.length * longest);
+    this.msPerUnit =
+      this.msPerUnit === undefined
+        ? sample
+        : this.msPerUnit + COST_SMOOTHING * (sample - this.msPerUnit);
+  }
+
+  private unitSize(item: T): number {
+    return Math.max(1, this.size(item));
+  }
+}
+
+export interface EmbeddingWriteQueueOptions {
+  /** Rows that start a background write. */
+  flushSize: number;
+  /** Queued rows beyond which `push` waits for the write in flight. */
+  maxQueued: number;
+  /** A background write failed; its rows stay queued for the next one. */
+  onWriteError?: (error: unknown, queued: number) => void;
+}
+
+export class EmbeddingWriteQueue<T> {
+  private buffer: T[] = [];
+  private writing = 0;
+  private inFlight: Promise<void> | null = null;
+
+  constructor(
+    private readonly write: (rows: T[]) => Promise<void>,
+    private readonly options: EmbeddingWriteQueueOptions,
+  ) {}
+
+  /** Rows pushed but not yet written, including the write in flight. */
+  get queued(): number {
+    return this.buffer.length + this.writing;
+  }
+
+  /**
+   * Queue `rows`, starting a background write once `flushSize` rows are
+   * waiting. Resolves once the queue is back under `maxQueued`, or once
+   * the write in flight settles.
+   */
+  async push(rows: readonly T[]): Promise<void> {
+    this.buffer.push(...rows);
+    if (this.buffer.length >= this.options.flushSize) this.startWrite();
+    if (this.queued > this.options.maxQueued && this.inFlight) {
+      await this.inFlight;
+    }
+  }
+
+  /**
+   * Wait for the write in flight, then write everything still queued,
+   * including rows a failed background write left behind. Rejects, with
+   * those rows still queued, when that last write fails.
+   */
+  async drain(): Promise<void> {
+    while (this.inFlight) await this.inFlight;
+    if (this.buffer.length === 0) return;
+    const rows = this.buffer.splice(0);
+    try {
+      await this.write(rows);
+    } catch (error) {
+      this.buffer.unshift(...rows);
+      throw error;
+    }
+  }
+
+  private startWrite(): void {
+    if (this.inFlight || this.buffer.length === 0) return;
+    const rows = this.buffer.splice(0);
+    this.writing = rows.length;
+    let failed = false;
+    this.inFlight = this.write(rows)
+      .catch((error: unknown) => {
+        failed = true;
+        this.buffer.unshift(...rows);
+        this.options.onWriteError?.(error, this.buffer.length);
+      })
+      .finally(() => {
+        this.writing = 0;
+        this.inFlight = null;
+        // After a failure the next push retries, rather than a hot loop.
+        if (!failed && this.buffer.length >= this.options.flushSize) {
+          this.startWrite();
+        }
+      });
+  }
+}
@@ -326,6 +326,20 @@ async function createOnnxSessionInternal(
     `ONNX model "${modelName}" loaded (dim=${dimension}, maxSeqLen=${modelInfo.maxSequenceLength})`,
   );
 
+  // Inference lane: ORT already spreads one run across its intra-op pool,
+  // so runs are queued one at a time per session. Tokenization stays off
+  // the lane (encodeBatch runs on the libuv pool), which lets the next
+  // batch tokenize while the current one is inferring, including batches
+  // from concurrent embed() calls.
+  let inferenceLane: Promise<unknown> = Promise.resolve();
+  const infer = (batch: TokenizedBatch): Promise<number[][]> => {
+    const run = inferenceLane.then(() =>
+      runInference(session, batch, dimension, ort),
+    );
+    inferenceLane = run.catch(() => undefined);
+    return run;
+  };
+
   const onnxSession: OnnxEmbeddingSession = {
     dimension,
     modelName,
@@ -337,17 +351,25 @@ async function createOnnxSessionInternal(
 
       const allEmbeddings: number[][] = [];
 
-      // Process in batches of INFERENCE_BATCH_SIZE
+      // Process in batches of INFERENCE_BATCH_SIZE, tokenizing batch i+1
+      // while batch i runs.
+      let pending = tokenizeBatch(
+        tokenizer,
+        texts.slice(0, INFERENCE_BATCH_SIZE),
+      );
       for (let i = 0; i < texts.length; i += INFERENCE_BATCH_SIZE) {
-        const batch = texts.slice(i, i + INFERENCE_BATCH_SIZE);
-        const batchEmbeddings = await runBatchInference(
-          session,
-          tokenizer,
-          batch,
-          dimension,
-          ort,
-        );
-        allEmbeddings.push(...batchEmbeddings);
+        const tokenized = await pending;
+        const next = i + INFERENCE_BATCH_SIZE;
+        if (next < texts.length) {
+          pending = tokenizeBatch(
+            tokenizer,
+            texts.slice(next, next + INFERENCE_BATCH_SIZE),
+          );
+          // Surfaced by the next iteration's await; never left unhandled
+          // when this batch's inference throws first.
+          pending.catch(() => undefined);
+        }
+        allEmbeddings.push(...(await infer(tokenized)));
       }
 
       return allEmbeddings;
@@ -363,13 +385,19 @@ async function createOnnxSessionInternal(
 
 // ── Inference internals ──────────────────────────────────────────────────────
 
-async function runBatchInference(
-  session: OrtSession,
+/** One batch tokenized and padded into ONNX input columns. */
+interface TokenizedBatch {
+  batchSize: number;
+  seqLen: number;
+  inputIds: BigInt64Array;
+  attentionMask: BigInt64Array;
+  tokenTypeIds: BigInt64Array;
+}
+
+async function tokenizeBatch(
   tokenizer: HfTokenizer,
   texts: string[],
-  dimension: number,
-  ort: OrtModule,
-): Promise<number[][]> {
+): Promise<TokenizedBatch> {
   const batchSize = texts.length;
 
   // 1. Tokenize batch (async) — setPadding ensures all sequences padded to batch-max
@@ -398,6 +426,17 @@ async function runBatchInference(
     }
   }
 
+  return { batchSize, seqLen, inputIds, attentionMask, tokenTypeIds };
+}
+
+async function runInference(
+  session: OrtSession,
+  batch: TokenizedBatch,
+  dimension: number,
+  ort: OrtModule,
+): Promise<number[][]> {
+  const { batchSize, seqLen, inputIds, attentionMask, tokenTypeIds } = batch;
+
   // 4. Create ONNX tensor feeds
   const dims = [batchSize, seqLen] as const;
   const feeds: Record<string, unknown> = {
@@ -1,3 +1,5 @@
+import { performance } from "node:perf_hooks";
+
 import {
   getLadybugConn,
   runWalCheckpoint,
@@ -8,6 +10,8 @@ import { hashContent } from "../util/hashing.js";
 import { logger } from "../util/logger.js";
 import {
   DEFAULT_EMBEDDING_BATCH_SIZE,
+  EMBEDDING_TARGET_BATCH_MS,
+  EMBEDDING_WRITE_QUEUE_MAX_ROWS,
   MAX_EMBEDDING_BATCH_SIZE,
   MAX_EMBEDDING_CONCURRENCY,
   SYMBOL_VECTOR_REBUILD_MIN_ROWS,
@@ -28,6 +32,7 @@ import {
   setSymbolEmbeddingBatchOnNode,
   type SymbolEmbeddingBatchItem,
 } from "../db/ladybug-symbol-embeddings.js";
+import { syncEmbeddingIndex } from "../retrieval/embedding-index.js";
 import {
   createVectorIndex,
   dropVectorIndex,
@@ -40,6 +45,11 @@ import {
 import { prepareSymbolEmbeddingInputs } from "./symbol-embedding-context.js";
 import { buildSymbolEmbeddingText } from "./symbol-embedding-text.js";
 import { IndexError } from "../domain/errors.js";
+import {
+  EmbeddingBatcher,
+  EmbeddingWriteQueue,
+  isEmbeddingPipelineEnabled,
+} from "./embedding-pipeline.js";
 
 /** Legacy dimension constant — only used by MockEmbeddingProvider */
 export const EMBEDDING_DIMENSION = 64;
@@ -418,6 +428,9 @@ export async function refreshSymbolEmbeddings(params: {
         threshold: rebuildMinUncachedRows,
       });
     }
+    // Nothing is written, but a repo embedded before the native index
+    // existed still needs its first build.
+    await syncEmbeddingIndex(conn, params.repoId, storageModel, false);
     return { embedded: 0, skipped, deferred: uncachedItems.length };
   }
 
@@ -505,15 +518,30 @@ export async function refreshSymbolEmbeddings(params: {
     ),
   );
 
-  // Split uncached items into batches of `batchSize`.
   type UncachedBatch = Array<{
     symbol: ladybugDb.SymbolRow;
     prefixedText: string;
     cardHash: string;
   }>;
+
+  // Pipelined mode cuts the length-sorted items into latency-sized batches
+  // (see embedding-pipeline.ts) and hands writes to a background queue;
+  // otherwise the items split into fixed `batchSize` batches up front.
+  const pipelined = isEmbeddingPipelineEnabled();
+  const batcher = new EmbeddingBatcher(
+    uncachedItems,
+    (item) => item.prefixedText.length,
+    {
+      maxBatchSize: batchSize,
+      targetBatchMs: EMBEDDING_TARGET_BATCH_MS,
+      adaptive: pipelined,
+    },
+  );
   const batches: UncachedBatch[] = [];
-  for (let i = 0; i < uncachedItems.length; i += batchSize) {
-    batches.push(uncachedItems.slice(i, i + batchSize));
+  if (!pipelined) {
+    for (let batch = batcher.next(); batch; batch = batcher.next()) {
+      batches.push(batch);
+    }
   }
 
   // Shared mutable counters — updated inside processBatch results (not inside
@@ -549,11 +577,47 @@ export async function refreshSymbolEmbeddings(params: {
     });
   };
 
+  const writeQueue = pipelined
+    ? new EmbeddingWriteQueue<SymbolEmbeddingBatchItem>(
+        (rows) =>
+          withWriteConn(async (wConn) => {
+            await setSymbolEmbeddingBatchOnNode(wConn, storageModel, rows, {
+              hnswIndexDropped: indexDropped,
+            });
+          }),
+        {
+          flushSize: indexDropped ? COALESCE_WRITE_BUFFER_SIZE : batchSize,
+          maxQueued: EMBEDDING_WRITE_QUEUE_MAX_ROWS,
+          onWriteError: (err, queued) => {
+            logger.warn(
+              "[embeddings] Background embedding write failed (will retry)",
+              {
+                error: err instanceof Error ? err.message : String(err),
+                pending: queued,
+              },
+            );
+          },
+        },
+      )
+    : null;
+
+  // Batch latency for the batcher runs from when the batch could first use
+  // the inference lane: its own start, or the previous batch's finish when
+  // it had to queue behind it.
+  let lastEmbedFinishedAt = 0;
+
   const processBatch = async (batch: UncachedBatch): Promise<BatchResult> => {
     const batchTexts = batch.map((item) => item.prefixedText);
     let batchVectors: number[][];
     try {
+      const startedAt = performance.now();
       batchVectors = await provider.embed(batchTexts);
+      const finishedAt = performance.now();
+      batcher.record(
+        batch,
+        finishedAt - Math.max(startedAt, lastEmbedFinishedAt),
+      );
+      lastEmbedFinishedAt = finishedAt;
     } catch (error) {
       recordEmbeddingFailure();
       logger.warn("Batch embedding failed, continuing to next batch", {
@@ -627,7 +691,12 @@ export async function refreshSymbolEmbeddings(params: {
     }
 
     if (batchItems.length > 0) {
-      if (indexDropped) {
+      if (writeQueue) {
+        // Pipelined path: the write runs behind the next batch's inference.
+        // Resolves late only when the queue is full, which holds this batch
+        // slot and so pauses inference until LadybugDB catches up.
+        await writeQueue.push(batchItems);
+      } else if (indexDropped) {
         // Coalesced path: append to shared buffer; flush is driven by the
         // chunk-boundary in the dispatch loop (and the force-flush in
         // `finally` before HNSW rebuild).
@@ -659,45 +728,71 @@ export async function refreshSymbolEmbeddings(params: {
   let degraded = false;
   let failedBatches = 0;
   let processedBatches = 0;
+  const recordBatchResult = (res: BatchResult): void => {
+    embedded += res.embedded;
+    skipped += res.skipped;
+    processedBatches++;
+    if (res.failed) failedBatches++;
+    if (res.degraded) degraded = true;
+    if (res.terminal) aborted = true;
+    fireProgress();
+  };
+  const recordBatchRejection = (reason: unknown): void => {
+    // processBatch should not throw (all errors handled internally),
+    // but guard defensively.
+    logger.warn("Unexpected processBatch rejection", {
+      reason: String(reason),
+    });
+    recordEmbeddingFailure();
+    failedBatches++;
+    processedBatches++;
+  };
+  const failureRateExceeded = (): boolean =>
+    processedBatches > 0 && failedBatches / processedBatches > 0.5;
+
   try {
+    if (pipelined) {
+      // Sliding window of concurrency + 1 batches, so one batch is always
+      // tokenizing while another holds the session's inference lane.
+      const window = maxConcurrency + 1;
+      const inFlight = new Set<Promise<void>>();
+      let tooManyFailures = false;
+      while (!aborted && !tooManyFailures) {
+        while (inFlight.size < window && !aborted) {
+          const batch = batcher.next();
+          if (!batch) break;
+          const task: Promise<void> = processBatch(batch)
+            .then(recordBatchResult)
+            .catch(recordBatchRejection)
+            .finally(() => {
+              inFlight.delete(task);
+            });
+          inFlight.add(task);
+        }
+        if (inFlight.size === 0) break;
+        await Promise.race(inFlight);
+        tooManyFailures = failureRateExceeded();
+      }
+      // Let batches already running finish before the final drain below.
+      await Promise.allSettled(inFlight);
+      if (tooManyFailures) {
+        throw new IndexError("Embedding failure rate exceeds 50%");
+      }
+    }
     for (
       let chunkStart = 0;
-      chunkStart < batches.length && !aborted;
+      !pipelined && chunkStart < batches.length && !aborted;
       chunkStart += maxConcurrency
     ) {
       const chunk = batches.slice(chunkStart, chunkStart + maxConcurrency);
       // P6: fire progress as each batch settles, not after the chunk wraps.
-      const settled = await Promise.allSettled(
-        chunk.map(async (b) => {
-          const res = await processBatch(b);
-          embedded += res.embedded;
-          skipped += res.skipped;
-          processedBatches++;
-          if (res.failed) failedBatches++;
-          if (res.degraded) degraded = true;
-          fireProgress();
-          return res;
-        }),
+      await Promise.all(
+        chunk.map((b) =>
+          processBatch(b).then(recordBatchResult).catch(recordBatchRejection),
+        ),
       );
 
-      for (const result of settled) {
-        if (result.status === "fulfilled") {
-          if (result.value.terminal) {
-            aborted = true;
-          }
-        } else {
-          // processBatch should not throw (all errors handled internally),
-          // but guard defensively.
-          logger.warn("Unexpected processBatch rejection", {
-            reason: String(result.reason),
-          });
-          recordEmbeddingFailure();
-          failedBatches++;
-          processedBatches++;
-        }
-      }
-
-      if (processedBatches > 0 && failedBatches / processedBatches > 0.5) {
+      if (failureRateExceeded()) {
         throw new IndexError("Embedding failure rate exceeds 50%");
       }
 
@@ -722,6 +817,17 @@ export async function refreshSymbolEmbeddings(params: {
       }
     }
   } finally {
+    if (writeQueue && writeQueue.queued > 0) {
+      try {
+        await writeQueue.drain();
+      } catch (err) {
+        logger.error(
+          `[embeddings] Final embedding write failed — ${writeQueue.queued} vectors will not be persisted; vector retrieval may be stale`,
+          { error: err instanceof Error ? err.message : String(err) },
+        );
+      }
+    }
+
     // P2.b: drain any remaining coalesced writes BEFORE rebuilding the
     // index. The rebuild scans Symbol.<vecProp>, so unflushed items would
     // not appear in HNSW until the next refresh. Failures here are logged
@@ -779,6 +885,9 @@ export async function refreshSymbolEmbeddings(params: {
   // made beyond the last tick; for partial/aborted runs that means
   // honest "current < total" rather than a dishonest forced-to-total.
   fireProgress();
+  // The native index is rebuilt from every stored blob, not just this run's,
+  // so it matches the Symbol nodes even after a partial write.
+  await syncEmbeddingIndex(conn, params.repoId, storageModel, embedded > 0);
   return degraded
     ? { embedded, skipped, degraded: true }
     : { embedded, skipped };
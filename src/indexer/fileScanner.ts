@@ -10,7 +10,16 @@ import {
 } from "../util/asyncFs.js";
 import { logger } from "../util/logger.js";
 
-import { walkRepositoryFiles } from "./fileWalker.js";
+import {
+  createIgnoredPathMatcher,
+  walkRepositoryFiles,
+} from "./fileWalker.js";
+import type { ParseCache } from "./parse-cache.js";
+import {
+  hashFilesRust,
+  scanRepositoryFilesRust,
+  type RustFileHash,
+} from "./rustIndexer.js";
 import {
   getLanguageIdForExtension,
   getSupportedExtensions,
@@ -24,13 +33,35 @@ export interface FileMetadata {
   path: string;
   size: number;
   mtime: number;
+  /** Inode from the scan, when known; part of the parse cache key. */
+  inode?: number;
   contentHash?: string;
+  /**
+   * Fast digest of the same bytes as `contentHash`, when the native addon
+   * hashed the file (see `getRustContentFastHashAlgorithm`).
+   */
+  contentFastHash?: string;
 }
 
 export interface ScannedFileMetadata extends FileMetadata {
   contentHash: string;
 }
 
+/** A file's hashes as stored by the last index run. */
+export interface KnownFileHashes {
+  contentHash: string;
+  /** Only set when written with the addon's current fast digest algorithm. */
+  contentFastHash?: string;
+}
+
+/** A discovered path, with stat fields when the walker already has them. */
+interface DiscoveredFile {
+  path: string;
+  size?: number;
+  mtime?: number;
+  inode?: number;
+}
+
 const EXACT_CONFIG_LANGUAGE_EXTENSIONS = new Map<string, readonly string[]>([
   ["ts", [".ts"]],
   ["tsx", [".tsx"]],
@@ -193,10 +224,10 @@ async function resolveWorkspaces(
 async function discoverFiles(
   repoPath: string,
   config: RepoConfig,
-): Promise<string[]> {
+): Promise<DiscoveredFile[]> {
   const explicitFileList = await readSourceFileList(repoPath, config);
   if (explicitFileList) {
-    return explicitFileList;
+    return explicitFileList.map((path) => ({ path }));
   }
 
   const extensions = getLanguageExtensions(config.languages);
@@ -218,10 +249,25 @@ async function discoverFiles(
     );
   }
 
-  return walkRepositoryFiles(repoPath, {
+  // The native scanner walks in parallel and returns size/mtime with each
+  // path. Its override globs prune the same directories the TS walker skips;
+  // re-checking with the TS matcher keeps the result identical for any
+  // pattern the two glob dialects read differently.
+  const nativeFiles = await scanRepositoryFilesRust(repoPath, {
+    extensions,
+    ignorePatterns,
+    maxFileBytes: config.maxFileBytes,
+  });
+  if (nativeFiles) {
+    const isIgnored = createIgnoredPathMatcher(ignorePatterns);
+    return nativeFiles.filter((file) => !isIgnored(file.path));
+  }
+
+  const walked = await walkRepositoryFiles(repoPath, {
     patterns,
     ignorePatterns,
   });
+  return walked.map((path) => ({ path }));
 }
 
 async function readSourceFileList(
@@ -267,19 +313,31 @@ async function readSourceFileList(
 }
 
 async function filterFilesBySize(
-  files: string[],
+  files: DiscoveredFile[],
   repoPath: string,
   maxBytes: number,
+  parseCache: ParseCache | null,
+  knownHashes: ReadonlyMap<string, KnownFileHashes> | null,
 ): Promise<ScannedFileMetadata[]> {
   const metadata: ScannedFileMetadata[] = [];
 
+  // Only stat entries the walker did not already describe.
   const stats = await Promise.allSettled(
-    files.map((file) => statAsync(resolve(repoPath, file))),
+    files.map((file) =>
+      file.size !== undefined && file.mtime !== undefined
+        ? Promise.resolve({
+            size: file.size,
+            mtimeMs: file.mtime,
+            ino: file.inode,
+          })
+        : statAsync(resolve(repoPath, file.path)),
+    ),
   );
   const candidates: Array<{
     file: string;
     size: number;
     mtime: number;
+    inode?: number;
   }> = [];
 
   for (let i = 0; i < files.length; i++) {
@@ -287,24 +345,54 @@ async function filterFilesBySize(
 
     if (result.status === "fulfilled" && result.value.size <= maxBytes) {
       candidates.push({
-        file: files[i],
+        file: files[i].path,
         size: result.value.size,
         mtime: result.value.mtimeMs,
+        inode: result.value.ino,
       });
     }
   }
 
+  const keys = candidates.map((candidate) => ({
+    path: normalizePath(candidate.file),
+    size: candidate.size,
+    mtime: candidate.mtime,
+    inode: candidate.inode,
+  }));
+  // An identical stat means the bytes hashed last run are unchanged.
+  const cachedHashes = keys.map((key) => parseCache?.contentHashFor(key));
+  const nativeHashes = await hashUncachedFilesNative(
+    repoPath,
+    candidates.map((candidate) => candidate.file),
+    keys.map((key, i) =>
+      cachedHashes[i] === undefined
+        ? (knownHashes?.get(key.path)?.contentFastHash ?? null)
+        : undefined,
+    ),
+  );
+
   const hashed = await Promise.allSettled(
-    candidates.map(async (candidate) => {
-      const content = await readFileBufferAsync(
-        resolve(repoPath, candidate.file),
-      );
-      return {
-        path: normalizePath(candidate.file),
-        size: candidate.size,
-        mtime: candidate.mtime,
-        contentHash: hash("sha256", content, "hex"),
-      };
+    keys.map(async (key, i) => {
+      let contentHash = cachedHashes[i];
+      let contentFastHash: string | undefined;
+      if (contentHash === undefined) {
+        const native = nativeHashes?.get(i);
+        if (native) {
+          if (native.error !== undefined) throw new Error(native.error);
+          contentFastHash = native.contentFastHash;
+          // No SHA-256 back means the fast digest matched the stored one.
+          contentHash =
+            native.contentHash ?? knownHashes?.get(key.path)?.contentHash;
+        }
+        if (contentHash === undefined) {
+          const content = await readFileBufferAsync(
+            resolve(repoPath, candidates[i].file),
+          );
+          contentHash = hash("sha256", content, "hex");
+        }
+        parseCache?.recordContentHash(key, contentHash);
+      }
+      return { ...key, contentHash, contentFastHash };
     }),
   );
 
@@ -315,6 +403,33 @@ async function filterFilesBySize(
   return metadata;
 }
 
+/**
+ * Hash the files whose `knownFastHashes` entry is not `undefined` on the
+ * native parse pool, keyed by input index. A `null` entry has no stored
+ * digest to match, so its SHA-256 is always computed. Returns null when the
+ * addon cannot hash files, leaving every file to the TypeScript path.
+ */
+async function hashUncachedFilesNative(
+  repoPath: string,
+  files: readonly string[],
+  knownFastHashes: ReadonlyArray<string | null | undefined>,
+): Promise<Map<number, RustFileHash> | null> {
+  const indices: number[] = [];
+  for (let i = 0; i < files.length; i++) {
+    if (knownFastHashes[i] !== undefined) indices.push(i);
+  }
+  if (indices.length === 0) return null;
+
+  const results = await hashFilesRust(
+    indices.map((i) => ({
+      absolutePath: resolve(repoPath, files[i]),
+      knownFastHash: knownFastHashes[i] ?? undefined,
+    })),
+  );
+  if (!results) return null;
+  return new Map(indices.map((fileIndex, i) => [fileIndex, results[i]]));
+}
+
 const TS_SUPERSEDES_JS: Record<string, string> = {
   ".js": ".ts",
   ".jsx": ".tsx",
@@ -341,11 +456,20 @@ function deduplicateCompiledJs<TFile extends FileMetadata>(
  *
  * @param repoPath - Absolute path to repository root
  * @param config - Repository configuration with languages, ignore patterns, and limits
+ * @param options.parseCache - Supplies hashes for files whose stat is unchanged
  * @returns Array of file metadata sorted by path
  */
 export async function scanRepository(
   repoPath: string,
   config: RepoConfig,
+  options: {
+    parseCache?: ParseCache | null;
+    /**
+     * Stored hashes by relative path. A file whose fast digest still matches
+     * takes the stored SHA-256 instead of computing it.
+     */
+    knownHashes?: ReadonlyMap<string, KnownFileHashes> | null;
+  } = {},
 ): Promise<ScannedFileMetadata[]> {
   await ensureConfiguredLanguagePackAdapters(config.languages);
   const discoveredFiles = await discoverFiles(repoPath, config);
@@ -353,6 +477,8 @@ export async function scanRepository(
     discoveredFiles,
     repoPath,
     config.maxFileBytes,
+    options.parseCache ?? null,
+    options.knownHashes ?? null,
   );
 
   const deduplicated = deduplicateCompiledJs(metadata);
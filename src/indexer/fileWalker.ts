@@ -51,6 +51,41 @@ function shouldIgnorePath(
   return isDirectory && matchesAnyPattern(`${path}/`, ignorePatterns);
 }
 
+/**
+ * Build a predicate that reports whether a file path is excluded by
+ * `ignorePatterns` exactly as {@link walkRepositoryFiles} would exclude it,
+ * either directly or through an ignored ancestor directory. Ancestor
+ * verdicts are memoised, so checking a large pre-walked file list (e.g. from
+ * the native scanner) costs roughly one regex pass per directory.
+ */
+export function createIgnoredPathMatcher(
+  ignorePatterns: string[],
+): (relativePath: string) => boolean {
+  const compiled = compilePatterns(ignorePatterns);
+  if (compiled.length === 0) {
+    return () => false;
+  }
+  const ignoredDirectories = new Map<string, boolean>();
+  const isDirectoryIgnored = (directory: string): boolean => {
+    const cached = ignoredDirectories.get(directory);
+    if (cached !== undefined) return cached;
+    const slash = directory.lastIndexOf("/");
+    const ignored =
+      (slash > 0 && isDirectoryIgnored(directory.slice(0, slash))) ||
+      shouldIgnorePath(directory, compiled, true);
+    ignoredDirectories.set(directory, ignored);
+    return ignored;
+  };
+
+  return (relativePath: string): boolean => {
+    const slash = relativePath.lastIndexOf("/");
+    if (slash > 0 && isDirectoryIgnored(relativePath.slice(0, slash))) {
+      return true;
+    }
+    return shouldIgnorePath(relativePath, compiled, false);
+  };
+}
+
 function isFileLikeEntry(entry: DirectoryEntryLike): boolean {
   if (typeof entry.isFile === "function") {
     return entry.isFile();
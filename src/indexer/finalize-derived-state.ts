@@ -1,5 +1,6 @@
 import type { Connection } from "kuzu";
 
+import { persistGraphSnapshotFile } from "../graph/graphSnapshotCache.js";
 import type { FoldedCentralityResult } from "../graph/metrics.js";
 import {
   computeAndStoreClustersAndProcesses,
@@ -131,6 +132,18 @@ export async function finalizeDerivedState(
         algorithmDiagnostics.failures.join("; ") || "algorithm refresh failed",
       );
     }
+    // Lets a restarted server seat its graph snapshot without reading
+    // every row back from LadybugDB.
+    try {
+      await measurePhase("graphSnapshotFile", () =>
+        persistGraphSnapshotFile(conn, repoId, versionId),
+      );
+    } catch (error) {
+      logger.debug("graph snapshot file skipped", {
+        repoId,
+        error: error instanceof Error ? error.message : String(error),
+      });
+    }
   } catch (error) {
     logger.warn("Cluster/process computation failed; continuing without it", {
       repoId,
@@ -3,6 +3,11 @@ import { dirname, join } from "path";
 import { existsAsync } from "../../util/asyncFs.js";
 import { normalizePath } from "../../util/paths.js";
 
+import {
+  C_INCLUDE_ROOTS,
+  isTrieResolvableSpecifier,
+} from "./include-path-index.js";
+
 import type {
   ImportResolutionAdapter,
   ResolveImportCandidatePathsParams,
@@ -48,6 +53,18 @@ export class CIncludeImportResolutionAdapter implements ImportResolutionAdapter
     params: ResolveImportCandidatePathsParams,
   ): Promise<string[]> {
     const importerDir = dirname(params.importerRelPath);
+    if (
+      params.includePathIndex &&
+      isTrieResolvableSpecifier(params.specifier)
+    ) {
+      const resolved = params.includePathIndex.resolve(
+        importerDir,
+        params.specifier,
+        params.extensions,
+      );
+      return resolved ? [resolved] : [];
+    }
+
     const specifierCandidates = buildSpecifierCandidates(
       params.specifier,
       params.extensions,
@@ -69,7 +86,7 @@ export class CIncludeImportResolutionAdapter implements ImportResolutionAdapter
       }
     }
 
-    for (const includeDir of ["include", "inc", "src"]) {
+    for (const includeDir of C_INCLUDE_ROOTS.slice(1)) {
       for (const specifierCandidate of specifierCandidates) {
         const includeCandidate = normalizePath(
           join(includeDir, specifierCandidate),
@@ -0,0 +1,165 @@
+/**
+ * In-memory resolution of C/C++ `#include` specifiers.
+ *
+ * The include adapter tries each specifier relative to the including file,
+ * the repo root and the conventional `include/`, `inc/` and `src/` roots,
+ * with and without every known extension. Probing those candidates through
+ * the filesystem (or even through a path set, which needs one normalized
+ * string per candidate) repeats the same work for every file that includes
+ * a popular header. This index keeps the repo's file list as a trie of path
+ * segments, resolves each candidate by walking it, and memoises the winner
+ * per (including directory, specifier).
+ *
+ * @module indexer/import-resolution/include-path-index
+ */
+
+/** Roots tried after the including directory, in order. */
+export const C_INCLUDE_ROOTS: readonly string[] = [
+  "",
+  "include",
+  "inc",
+  "src",
+];
+
+interface PathNode {
+  children: Map<string, PathNode> | undefined;
+  isFile: boolean;
+}
+
+function newNode(): PathNode {
+  return { children: undefined, isFile: false };
+}
+
+/**
+ * Whether the trie walk matches `normalizePath(join(base, specifier))`
+ * exactly for `specifier`. Absolute, drive-letter, backslashed and
+ * directory-like specifiers go through the path-based fallback instead.
+ */
+export function isTrieResolvableSpecifier(specifier: string): boolean {
+  if (specifier === "" || specifier.startsWith("/")) return false;
+  if (specifier.endsWith("/") || /[\\:]/.test(specifier)) return false;
+  const last = specifier.slice(specifier.lastIndexOf("/") + 1);
+  return last !== "." && last !== "..";
+}
+
+export class IncludePathIndex {
+  private root: PathNode | undefined;
+  /** Resolutions per extension list, keyed by directory and specifier. */
+  private readonly memo = new Map<string, Map<string, string | null>>();
+
+  /**
+   * @param paths Normalized repo-relative file paths. Iterated on the first
+   *   lookup, so passing a live collection such as a map's keys is fine.
+   */
+  constructor(private readonly paths: Iterable<string>) {}
+
+  /** Number of memoised (directory, specifier) resolutions. */
+  get memoSize(): number {
+    let size = 0;
+    for (const resolutions of this.memo.values()) size += resolutions.size;
+    return size;
+  }
+
+  /**
+   * The first existing candidate for `specifier` included from
+   * `importerDir`, trying the same candidates in the same order as the
+   * path-based adapter, or null when none is a repo file.
+   */
+  resolve(
+    importerDir: string,
+    specifier: string,
+    extensions: readonly string[],
+  ): string | null {
+    const extensionKey = extensions.join("\0");
+    let resolutions = this.memo.get(extensionKey);
+    if (!resolutions) {
+      resolutions = new Map();
+      this.memo.set(extensionKey, resolutions);
+    }
+    const key = `${importerDir}\0${specifier}`;
+    const cached = resolutions.get(key);
+    if (cached !== undefined) return cached;
+
+    const resolved = this.resolveUncached(importerDir, specifier, extensions);
+    resolutions.set(key, resolved);
+    return resolved;
+  }
+
+  private resolveUncached(
+    importerDir: string,
+    specifier: string,
+    extensions: readonly string[],
+  ): string | null {
+    const specifierSegments = specifier.split("/");
+    const basename = specifierSegments.pop()!;
+    const names = extensions.some((extension) => basename.endsWith(extension))
+      ? [basename]
+      : [basename, ...extensions.map((extension) => basename + extension)];
+
+    for (const base of [importerDir, ...C_INCLUDE_ROOTS]) {
+      const segments = normalizeSegments(base, specifierSegments);
+      if (!segments) continue;
+      const dir = this.walk(segments);
+      if (!dir?.children) continue;
+      for (const name of names) {
+        if (dir.children.get(name)?.isFile) {
+          return [...segments, name].join("/");
+        }
+      }
+    }
+    return null;
+  }
+
+  private walk(segments: readonly string[]): PathNode | undefined {
+    let node: PathNode | undefined = this.trie();
+    for (const segment of segments) {
+      node = node.children?.get(segment);
+      if (!node) return undefined;
+    }
+    return node;
+  }
+
+  private trie(): PathNode {
+    if (this.root) return this.root;
+    const root = newNode();
+    for (const path of this.paths) {
+      let node = root;
+      for (const segment of path.split("/")) {
+        node.children ??= new Map();
+        let child = node.children.get(segment);
+        if (!child) {
+          child = newNode();
+          node.children.set(segment, child);
+        }
+        node = child;
+      }
+      node.isFile = true;
+    }
+    this.root = root;
+    return root;
+  }
+}
+
+/**
+ * `base` joined with the directory segments of a specifier, with `.` and
+ * empty segments dropped and `..` applied. Null when `..` climbs above the
+ * repo root, where no repo file can live.
+ */
+function normalizeSegments(
+  base: string,
+  specifierSegments: readonly string[],
+): string[] | null {
+  const segments: string[] = [];
+  for (const part of [base.split("/"), specifierSegments]) {
+    for (const segment of part) {
+      if (segment === "" || segment === ".") continue;
+      if (segment === "..") {
+        if (segments.length === 0) return null;
+        segments.pop();
+        continue;
+      }
+      segments.push(segment);
+    }
+  }
+  return segments;
+}
@@ -1,3 +1,5 @@
+import type { IncludePathIndex } from "./include-path-index.js";
+
 export interface ResolveImportCandidatePathsParams {
   language: string;
   repoRoot: string;
@@ -5,6 +7,8 @@ export interface ResolveImportCandidatePathsParams {
   specifier: string;
   extensions: string[];
   knownRepoPaths?: { has(relPath: string): boolean };
+  /** Trie over the same file set as `knownRepoPaths`, for C/C++ includes. */
+  includePathIndex?: IncludePathIndex;
 }
 
 export interface ImportResolutionAdapter {
@@ -175,9 +175,9 @@ export interface Pass1Params {
   pendingCallEdges: PendingCallEdge[];
   createdCallEdges: Set<string>;
   tsResolver: TsCallResolver | null;
-  allSymbolsByName: Map<string, ladybugDb.SymbolLiteRow[]>;
-  globalNameToSymbolIds: Map<string, string[]>;
-  globalPreferredSymbolId: Map<string, string>;
+  allSymbolsByName: ReadonlyMap<string, ladybugDb.SymbolLiteRow[]>;
+  globalNameToSymbolIds: ReadonlyMap<string, string[]>;
+  globalPreferredSymbolId: ReadonlyMap<string, string>;
   pass2ResolverRegistry: Pass2ResolverRegistry;
   supportsPass2FilePath: (relPath: string) => boolean;
   concurrency: number;
@@ -220,9 +220,9 @@ export async function loadExistingSymbolMaps(
   removedFileIds: Iterable<string> = [],
 ): Promise<{
   symbolMapCache: SymbolMapCache;
-  allSymbolsByName: Map<string, ladybugDb.SymbolLiteRow[]>;
-  globalNameToSymbolIds: Map<string, string[]>;
-  globalPreferredSymbolId: Map<string, string>;
+  allSymbolsByName: ReadonlyMap<string, ladybugDb.SymbolLiteRow[]>;
+  globalNameToSymbolIds: ReadonlyMap<string, string[]>;
+  globalPreferredSymbolId: ReadonlyMap<string, string>;
 }> {
   const symbolMapCache = await getOrLoadSymbolMapCache(conn, repoId);
   removeFilesFromSymbolMapCache(symbolMapCache, removedFileIds);
@@ -242,7 +242,7 @@ export async function loadExistingSymbolMaps(
  * files (non-exported `let`/`const`).
  */
 export function buildGlobalPreferredSymbolIds(
-  allSymbolsByName: Map<string, ladybugDb.SymbolLiteRow[]>,
+  allSymbolsByName: ReadonlyMap<string, ladybugDb.SymbolLiteRow[]>,
 ): Map<string, string> {
   const preferred = new Map<string, string>();
   for (const [name, symbols] of allSymbolsByName) {
@@ -3,11 +3,17 @@ import { ParserWorkerPool } from "./workerPool.js";
 import {
   parseFilesRust,
   parseFilesRustAsync,
+  parseFilesRustStream,
   type RustParseResult,
 } from "./rustIndexer.js";
 import { BatchPersistAccumulator } from "./parser/batch-persist.js";
+import { openParseCache, releaseParseCache } from "./parse-cache.js";
 import { toPass2Target } from "./pass2/registry.js";
 import { logger } from "../util/logger.js";
+import {
+  phaseStart,
+  recordPhaseLatency,
+} from "../observability/latency-histogram.js";
 import type { FileMetadata } from "./fileScanner.js";
 import type { SymbolIndex } from "./edge-builder.js";
 import {
@@ -156,18 +162,52 @@ export async function runPass1WithRustEngine(
   });
 
   // --- Native chunk processing ---
-  // Default mode parses chunk N+1 (async, on libuv thread) while processing
-  // chunk N's results on the main thread. Set SDL_MCP_NATIVE_PASS1_SERIAL=1 to
-  // isolate native-addon crashes by removing that overlap while still using
-  // the async native parser for each chunk.
+  // Default mode streams every native file through one parseFilesRustStream
+  // call: results arrive in NATIVE_STREAM_CHUNK_SIZE chunks as workers finish
+  // them, so result processing and batch-persist writes start while later
+  // files are still parsing. Addons without the streaming export parse
+  // CHUNK_SIZE chunks instead, prefetching chunk N+1 (async, on a libuv
+  // thread) while chunk N's results are processed on the main thread. Set
+  // SDL_MCP_NATIVE_PASS1_SERIAL=1 to isolate native-addon crashes by removing
+  // that overlap while still using the async native parser for each chunk.
+  interface NativeChunk {
+    chunkFiles: FileMetadata[];
+    chunkResults: Array<RustParseResult | null>;
+    fromCache?: boolean;
+  }
+
+  // Files whose stat and content hash match the parse cache reuse their
+  // stored extraction and never reach the native parser.
+  const parseCache = await openParseCache(repoId);
+  const cachedChunk: NativeChunk = {
+    chunkFiles: [],
+    chunkResults: [],
+    fromCache: true,
+  };
+  if (parseCache) {
+    rustFiles = rustFiles.filter((file) => {
+      const cached = parseCache.resultFor(file);
+      if (!cached) return true;
+      cachedChunk.chunkFiles.push(file);
+      cachedChunk.chunkResults.push(cached);
+      return false;
+    });
+    if (cachedChunk.chunkFiles.length > 0) {
+      logger.debug("Native pass 1 parse cache hits", {
+        repoId,
+        cached: cachedChunk.chunkFiles.length,
+        toParse: rustFiles.length,
+      });
+    }
+  }
+
   const chunks: FileMetadata[][] = [];
   for (let i = 0; i < rustFiles.length; i += CHUNK_SIZE) {
     chunks.push(rustFiles.slice(i, i + CHUNK_SIZE));
   }
 
-  let pendingParse: Promise<Array<RustParseResult | null> | null> | null = null;
-  let pendingChunkIdx = -1;
-
+  // Every chunk below runs on the persistent native worker pool; passing
+  // `concurrency` per call caps its share of the pool without resizing it.
   if (serializeNativePass1Chunks) {
     logger.info(
       "Native pass 1 chunk prefetch disabled by SDL_MCP_NATIVE_PASS1_SERIAL",
@@ -175,64 +215,143 @@ export async function runPass1WithRustEngine(
     );
   }
 
-  // Kick off first chunk parse (async) when pipelining is enabled.
-  if (chunks.length > 0 && !serializeNativePass1Chunks) {
-    pendingParse = parseFilesRustAsync(
-      repoId,
-      repoRoot,
-      chunks[0],
-      concurrency,
-    );
-    pendingChunkIdx = 0;
-  }
+  async function* prefetchedNativeChunks(): AsyncGenerator<NativeChunk> {
+    let pendingParse: Promise<Array<RustParseResult | null> | null> | null =
+      null;
+    let pendingChunkIdx = -1;
 
-  for (let ci = 0; ci < chunks.length; ci++) {
-    if (params.signal?.aborted) break;
-    if (batchAccumulator.error) break;
-
-    // Await the parse that was kicked off previously
-    let chunkResults: Array<RustParseResult | null> | null;
-    if (pendingParse && pendingChunkIdx === ci) {
-      chunkResults = await pendingParse;
-      pendingParse = null;
-    } else if (serializeNativePass1Chunks) {
-      chunkResults = await parseFilesRustAsync(
+    // Kick off first chunk parse (async) when pipelining is enabled.
+    if (chunks.length > 0 && !serializeNativePass1Chunks) {
+      pendingParse = parseFilesRustAsync(
         repoId,
         repoRoot,
-        chunks[ci],
+        chunks[0],
         concurrency,
       );
-    } else {
-      chunkResults = parseFilesRust(repoId, repoRoot, chunks[ci], concurrency);
+      pendingChunkIdx = 0;
+    }
+
+    for (let ci = 0; ci < chunks.length; ci++) {
+      // Await the parse that was kicked off previously
+      let chunkResults: Array<RustParseResult | null> | null;
+      if (pendingParse && pendingChunkIdx === ci) {
+        chunkResults = await pendingParse;
+        pendingParse = null;
+      } else if (serializeNativePass1Chunks) {
+        chunkResults = await parseFilesRustAsync(
+          repoId,
+          repoRoot,
+          chunks[ci],
+          concurrency,
+        );
+      } else {
+        chunkResults = parseFilesRust(
+          repoId,
+          repoRoot,
+          chunks[ci],
+          concurrency,
+        );
+      }
+
+      if (!chunkResults) {
+        logger.warn(
+          "Rust engine returned null mid-run, falling back to TS for remaining files",
+        );
+        for (let j = ci; j < chunks.length; j++) {
+          for (const f of chunks[j]) tsFallbackFiles.push(f);
+        }
+        return;
+      }
+
+      // Kick off NEXT chunk parse after confirming current chunk succeeded
+      if (!serializeNativePass1Chunks && ci + 1 < chunks.length) {
+        pendingParse = parseFilesRustAsync(
+          repoId,
+          repoRoot,
+          chunks[ci + 1],
+          concurrency,
+        );
+        pendingChunkIdx = ci + 1;
+      }
+
+      yield { chunkFiles: chunks[ci], chunkResults };
     }
+  }
 
-    if (!chunkResults) {
+  async function* streamedNativeChunks(
+    stream: AsyncGenerator<RustParseResult[], void, undefined>,
+  ): AsyncGenerator<NativeChunk> {
+    const rustFileByPath = new Map(rustFiles.map((file) => [file.path, file]));
+    const notYetReceived = new Set(rustFileByPath.keys());
+    try {
+      for await (const chunkResults of stream) {
+        const chunkFiles: FileMetadata[] = [];
+        for (const result of chunkResults) {
+          const file = rustFileByPath.get(result.relPath);
+          if (file && notYetReceived.delete(result.relPath)) {
+            chunkFiles.push(file);
+          }
+        }
+        yield { chunkFiles, chunkResults };
+      }
+    } catch (error) {
       logger.warn(
-        "Rust engine returned null mid-run, falling back to TS for remaining files",
+        "Rust engine stream failed mid-run, falling back to TS for remaining files",
+        { error: error instanceof Error ? error.message : String(error) },
       );
-      for (let j = ci; j < chunks.length; j++) {
-        for (const f of chunks[j]) tsFallbackFiles.push(f);
+      for (const path of notYetReceived) {
+        const file = rustFileByPath.get(path);
+        if (file) tsFallbackFiles.push(file);
       }
-      pendingParse = null;
-      break;
     }
+  }
 
-    // Kick off NEXT chunk parse after confirming current chunk succeeded
-    if (!serializeNativePass1Chunks && ci + 1 < chunks.length) {
-      pendingParse = parseFilesRustAsync(
-        repoId,
-        repoRoot,
-        chunks[ci + 1],
-        concurrency,
-      );
-      pendingChunkIdx = ci + 1;
+  const nativeStream =
+    rustFiles.length > 0 && !serializeNativePass1Chunks
+      ? parseFilesRustStream(repoId, repoRoot, rustFiles, concurrency)
+      : null;
+  async function* withCachedChunk(
+    parsed: AsyncGenerator<NativeChunk>,
+  ): AsyncGenerator<NativeChunk> {
+    if (cachedChunk.chunkFiles.length === 0 || !nativeStream) {
+      if (cachedChunk.chunkFiles.length > 0) yield cachedChunk;
+      yield* parsed;
+      return;
+    }
+    // Pull on the native stream before replaying cached results, so its
+    // workers parse while the cached chunk is persisted. The early pull's
+    // failure surfaces when it is awaited below.
+    const first = parsed.next();
+    first.catch(() => undefined);
+    try {
+      yield cachedChunk;
+      const head = await first;
+      if (head.done) return;
+      yield head.value;
+      yield* parsed;
+    } finally {
+      // Stops native work when the consumer bails out during the replay.
+      await parsed.return(undefined);
     }
+  }
+
+  const nativeChunks = withCachedChunk(
+    nativeStream
+      ? streamedNativeChunks(nativeStream)
+      : prefetchedNativeChunks(),
+  );
+
+  let chunkNumber = 0;
+  for await (const { chunkFiles, chunkResults, fromCache } of nativeChunks) {
+    chunkNumber++;
+    if (params.signal?.aborted) break;
+    if (batchAccumulator.error) break;
 
     logger.debug("Native parseFilesRust chunk completed", {
       repoId,
-      chunk: ci + 1,
-      totalChunks: chunks.length,
-      chunkSize: chunks[ci].length,
+      chunk: chunkNumber,
+      streaming: nativeStream !== null,
+      chunkSize: chunkFiles.length,
       totalFiles: rustFiles.length,
       resultCount: chunkResults.length,
     });
@@ -245,8 +364,7 @@ export async function runPass1WithRustEngine(
       file: FileMetadata;
       rustResult: RustParseResult;
     }> = [];
-    for (let i = 0; i < chunks[ci].length; i++) {
-      const file = chunks[ci][i];
+    for (const file of chunkFiles) {
       const rustResult = resultByPath.get(file.path);
       if (!rustResult) {
         acc.filesProcessed++;
@@ -271,6 +389,8 @@ export async function runPass1WithRustEngine(
         continue;
       }
 
+      // Snapshot before processing: call resolution mutates rustResult.calls.
+      if (!fromCache) parseCache?.recordResult(file, rustResult);
       processable.push({ file, rustResult });
     }
 
@@ -360,6 +480,10 @@ export async function runPass1WithRustEngine(
       await batchAccumulator.waitForIdle();
     }
   }
+  if (parseCache) {
+    await parseCache.flush();
+    releaseParseCache(repoId);
+  }
 
   // Background drain continues from this point — no await here. Rust-batch
   // writes already issued via maybeEnqueue() keep flowing through the
@@ -391,6 +515,7 @@ export async function runPass1WithRustEngine(
       toPass2Target(file),
     );
     try {
+      const fileStartedAt = phaseStart();
       const result = await processFile({
         repoId,
         repoRoot,
@@ -410,6 +535,7 @@ export async function runPass1WithRustEngine(
         globalPreferredSymbolId,
         supportsPass2FilePath,
       });
+      recordPhaseLatency("pass1.file", fileStartedAt);
       acc.filesProcessed++;
       acc.tsFilesProcessed++;
       if (result.changed) {
@@ -553,6 +679,7 @@ export async function runPass1WithTsEngine(
         toPass2Target(file),
       );
       try {
+        const fileStartedAt = phaseStart();
         const result = await processFile({
           repoId,
           repoRoot,
@@ -575,6 +702,7 @@ export async function runPass1WithTsEngine(
           batchAccumulator: batchAccumulator ?? undefined,
           pass1Extractions: acc.pass1Extractions,
         });
+        recordPhaseLatency("pass1.file", fileStartedAt);
         acc.filesProcessed++;
         acc.tsFilesProcessed++;
         if (result.changed) {
@@ -1,5 +1,6 @@
 import * as ladybugDb from "../db/ladybug-queries.js";
 import { getLadybugConn } from "../db/ladybug.js";
+import { IncludePathIndex } from "./import-resolution/include-path-index.js";
 import type {
   Pass2ExportedSymbolFull,
   Pass2ImportCache,
@@ -176,5 +177,6 @@ export async function buildPass2ImportCache(
     fileByRelPath,
     exportedSymbolsByFileId,
     exportedFullSymbolsByFileId,
+    includePathIndex: new IncludePathIndex(fileByRelPath.keys()),
   };
 }
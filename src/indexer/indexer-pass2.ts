@@ -27,6 +27,7 @@ import {
 import { getPoolStats } from "../db/ladybug.js";
 
 import { logger } from "../util/logger.js";
+import { recordPhaseDuration } from "../observability/latency-histogram.js";
 import { type IndexProgress } from "./indexer-init.js";
 import {
   buildPass2ImportCache,
@@ -75,8 +76,8 @@ async function runOnePass2Resolver(params: {
    * canonical set.  Re-adding pre-existing keys is a Set no-op.
    */
   localCreatedCallEdges: Set<string>;
-  globalNameToSymbolIds: Map<string, string[]>;
-  globalPreferredSymbolId: Map<string, string>;
+  globalNameToSymbolIds: ReadonlyMap<string, string[]>;
+  globalPreferredSymbolId: ReadonlyMap<string, string>;
   callResolutionTelemetry: CallResolutionTelemetry;
   pass2ResolverCache: Map<string, unknown>;
   submitEdgeWrite: SubmitEdgeWrite;
@@ -161,12 +162,14 @@ async function runOnePass2Resolver(params: {
       ),
   });
 
+  const elapsedMs = Date.now() - resolverStartedAt;
+  recordPhaseDuration("pass2.resolve", elapsedMs);
   return {
     edgesCreated: pass2Result.edgesCreated,
     // Return the mutated local set; caller does a union merge into canonical.
     localEdgeKeys: localCreatedCallEdges,
     resolverId: resolver.id,
-    elapsedMs: Date.now() - resolverStartedAt,
+    elapsedMs,
   };
 }
 
@@ -185,8 +188,8 @@ export async function runPass2Resolvers(params: {
   /** Number of files to resolve in parallel. Sourced from appConfig.indexing.pass2Concurrency. */
   pass2Concurrency?: number;
   createdCallEdges: Set<string>;
-  globalNameToSymbolIds: Map<string, string[]>;
-  globalPreferredSymbolId: Map<string, string>;
+  globalNameToSymbolIds: ReadonlyMap<string, string[]>;
+  globalPreferredSymbolId: ReadonlyMap<string, string>;
   callResolutionTelemetry: CallResolutionTelemetry;
   onProgress: ((progress: IndexProgress) => void) | undefined;
   signal?: AbortSignal;
@@ -615,10 +618,12 @@ export async function runPass2Resolvers(params: {
             ),
         },
       );
+      const elapsedMs = Date.now() - resolverStartedAt;
+      recordPhaseDuration("pass2.resolve", elapsedMs);
       pendingResolverTelemetryCredits.push({
         resolverId: resolver.id,
         edgesCreated: pass2Result.edgesCreated,
-        elapsedMs: Date.now() - resolverStartedAt,
+        elapsedMs,
       });
       filesSinceWriteFlush++;
       filesPendingTelemetryCredit++;
@@ -62,6 +62,7 @@ import { hashValue } from "../util/hashing.js";
 import { normalizePath } from "../util/paths.js";
 import { flushIndexEvent } from "../mcp/telemetry.js";
 import { getObservabilityTap } from "../observability/event-tap.js";
+import { recordPhaseDuration } from "../observability/latency-histogram.js";
 import { isRustEngineAvailable } from "./rustIndexer.js";
 import {
   clearTsCallResolverCache,
@@ -69,6 +70,7 @@ import {
 } from "./ts/tsParser.js";
 import { ParserWorkerPool } from "./workerPool.js";
 import { invalidateGraphSnapshot } from "../graph/graphSnapshotCache.js";
+import { invalidateLexicalIndex } from "../retrieval/lexical-index.js";
 import { recoverMissingMetricsForRepo } from "../graph/metrics-recovery.js";
 import { clearSliceCache } from "../graph/sliceCache.js";
 import { clearOverviewCache } from "../graph/overview.js";
@@ -96,6 +98,7 @@ import {
   runPass1WithRustEngine,
   runPass1WithTsEngine,
 } from "./indexer-pass1.js";
+import { releaseParseCache } from "./parse-cache.js";
 import {
   countExistingProviderPrimaryFiles,
   resolvePass1BatchSymbolWriteMode,
@@ -119,6 +122,7 @@ import {
 import {
   applySymbolMapFileUpdates,
   clearSymbolMapCache,
+  releaseSymbolMapCache,
   syncSymbolIndexFromCache,
 } from "./symbol-map-cache.js";
 import {
@@ -700,6 +704,7 @@ function formatScipFailureReason(failure: ScipFailureDiagnostic): string {
 
 function invalidateIndexResultCaches(repoId: string): void {
   invalidateGraphSnapshot(repoId);
+  invalidateLexicalIndex(repoId);
   clearOverviewCache();
   clearSliceCache();
   clearFingerprintCollisionLog();
@@ -1622,7 +1627,12 @@ function skippedProviderFirstShadowBuild(params: {
 
 function applyScannedFileMetadataToProviderRows(params: {
   rows: Awaited<ReturnType<typeof executeProviderFirstScipFull>>["rows"];
-  scannedFiles: readonly { path: string; size: number; contentHash: string }[];
+  scannedFiles: readonly {
+    path: string;
+    size: number;
+    contentHash: string;
+    contentFastHash?: string;
+  }[];
 }): void {
   const scannedByPath = new Map(
     params.scannedFiles.map((file) => [file.path, file]),
@@ -1632,6 +1642,7 @@ function applyScannedFileMetadataToProviderRows(params: {
     if (scanned) {
       row.byteSize = scanned.size;
       row.contentHash = scanned.contentHash;
+      row.contentFastHash = scanned.contentFastHash;
     }
   }
 }
@@ -2036,6 +2047,8 @@ export async function indexRepo(
     await failActiveGraphIntegrityVerification(repoId);
     throw error;
   } finally {
+    // Runs that skip native pass 1 still opened the cache in the scanner.
+    releaseParseCache(repoId);
     // Only clear if we're still the active lock holder.
     if (indexLocks.get(repoId) === resultPromise) {
       indexLocks.delete(repoId);
@@ -2081,6 +2094,7 @@ async function indexRepoImpl(
     } finally {
       const durationMs = Date.now() - phaseStart;
       if (phaseTimings) phaseTimings[phaseName] = durationMs;
+      recordPhaseDuration(`index.${phaseName}`, durationMs);
       if (providerFirstLegacyFallbackStartedAt !== undefined) {
         providerFirstLegacyFallbackPhaseTimings[phaseName] =
           (providerFirstLegacyFallbackPhaseTimings[phaseName] ?? 0) +
@@ -4209,12 +4223,8 @@ async function indexRepoImpl(
     symbolIndex.clear();
     symbolMapFileUpdates.clear();
     pass1Acc.pass1Extractions.clear();
-    symbolMapCache.symbolsByFileId.clear();
-    symbolMapCache.filePathById.clear();
-    allSymbolsByName.clear();
-    globalNameToSymbolIds.clear();
-    globalPreferredSymbolId.clear();
-    symbolMapCache.symbolIndex.clear();
+    // The name maps are views over the cache's packed table.
+    releaseSymbolMapCache(symbolMapCache);
     clearSymbolMapCache(repoId);
     allConfigEdges.length = 0;
 
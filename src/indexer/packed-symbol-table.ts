@@ -0,0 +1,366 @@
+/**
+ * Packed symbol storage behind the pass-1/pass-2 symbol map cache.
+ *
+ * The cache used to keep every symbol as a `SymbolLiteRow` object referenced
+ * from a per-file list, a per-name list, a sorted per-name ID list and a
+ * nested per-file symbol index, each with its own Map entries, and every row
+ * carried its own copies of the repo ID, file ID and kind strings read back
+ * from the database. On large repos that is gigabytes of long-lived heap
+ * that every full GC has to trace.
+ *
+ * This table keeps symbols as struct-of-arrays rows:
+ *
+ * - symbol IDs in one string array, names, file IDs, kinds and repo IDs as
+ *   references into intern tables, and the exported flag as a byte;
+ * - name → rows and file → rows as ranges over counting-sorted row orders,
+ *   with a second order that sorts each name range by symbol ID.
+ *
+ * Removing a file marks its rows dead and appending rows marks the orders
+ * stale; the next lookup compacts live rows (keeping insertion order) and
+ * rebuilds the orders in linear time plus the per-name ID sorts. Lookups
+ * materialise small arrays on demand; those die young instead of living in
+ * the old generation for the whole pass.
+ *
+ * @module indexer/packed-symbol-table
+ */
+
+import type { SymbolLiteRow } from "../db/ladybug-symbols.js";
+
+const INITIAL_CAPACITY = 1024;
+
+/** Dense string ↔ reference table; references are assigned in order. */
+export class StringInternTable {
+  private readonly refs = new Map<string, number>();
+  private readonly values: string[] = [];
+
+  get size(): number {
+    return this.values.length;
+  }
+
+  intern(value: string): number {
+    let ref = this.refs.get(value);
+    if (ref === undefined) {
+      ref = this.values.length;
+      this.refs.set(value, ref);
+      this.values.push(value);
+    }
+    return ref;
+  }
+
+  refOf(value: string): number | undefined {
+    return this.refs.get(value);
+  }
+
+  valueOf(ref: number): string {
+    return this.values[ref];
+  }
+}
+
+/** Rows `order[offsets[key]..offsets[key + 1]]` belong to `key`. */
+interface RowGroups {
+  order: Uint32Array;
+  offsets: Uint32Array;
+}
+
+function groupRows(
+  keys: Uint32Array,
+  rowCount: number,
+  keyCount: number,
+): RowGroups {
+  const offsets = new Uint32Array(keyCount + 1);
+  for (let row = 0; row < rowCount; row++) offsets[keys[row] + 1]++;
+  for (let key = 0; key < keyCount; key++) offsets[key + 1] += offsets[key];
+  const next = offsets.slice(0, keyCount);
+  const order = new Uint32Array(rowCount);
+  for (let row = 0; row < rowCount; row++) order[next[keys[row]]++] = row;
+  return { order, offsets };
+}
+
+function grown<T extends Uint8Array | Uint16Array | Uint32Array>(
+  next: T,
+  previous: T,
+  used: number,
+): T {
+  next.set(previous.subarray(0, used));
+  return next;
+}
+
+export class PackedSymbolTable {
+  private readonly names = new StringInternTable();
+  private readonly fileIds = new StringInternTable();
+  private readonly kinds = new StringInternTable();
+  private readonly repoIds = new StringInternTable();
+
+  private symbolIds: string[] = [];
+  private nameRefs = new Uint32Array(INITIAL_CAPACITY);
+  private fileRefs = new Uint32Array(INITIAL_CAPACITY);
+  private kindRefs = new Uint16Array(INITIAL_CAPACITY);
+  private repoRefs = new Uint16Array(INITIAL_CAPACITY);
+  private exported = new Uint8Array(INITIAL_CAPACITY);
+  private dead = new Uint8Array(INITIAL_CAPACITY);
+  private rowCount = 0;
+  private deadCount = 0;
+
+  /** Valid while `stale` is false. */
+  private byName: RowGroups = groupRows(new Uint32Array(0), 0, 0);
+  private byNameSortedIds = new Uint32Array(0);
+  private byFile: RowGroups = groupRows(new Uint32Array(0), 0, 0);
+  private liveNameCount = 0;
+  /** Rows of files touched since the last rebuild. */
+  private fileOverrides = new Map<number, number[]>();
+  private stale = false;
+
+  /** Live symbol rows. */
+  get symbolCount(): number {
+    return this.rowCount - this.deadCount;
+  }
+
+  /** Bytes held by the typed-array columns and orders. */
+  get columnBytes(): number {
+    return (
+      this.nameRefs.byteLength +
+      this.fileRefs.byteLength +
+      this.kindRefs.byteLength +
+      this.repoRefs.byteLength +
+      this.exported.byteLength +
+      this.dead.byteLength +
+      this.byName.order.byteLength +
+      this.byName.offsets.byteLength +
+      this.byNameSortedIds.byteLength +
+      this.byFile.order.byteLength +
+      this.byFile.offsets.byteLength
+    );
+  }
+
+  add(symbol: SymbolLiteRow): void {
+    const row = this.push(symbol);
+    // Keep `fileId`'s row list current while the orders are stale.
+    const fileRef = this.fileRefs[row];
+    const rows = this.fileOverrides.get(fileRef);
+    if (rows) {
+      rows.push(row);
+    } else {
+      this.fileOverrides.set(fileRef, [...this.packedFileRows(fileRef), row]);
+    }
+    this.stale = true;
+  }
+
+  /** Append many rows and rebuild the orders once. */
+  addAll(symbols: Iterable<SymbolLiteRow>): void {
+    for (const symbol of symbols) this.push(symbol);
+    this.stale = true;
+    this.rebuild();
+  }
+
+  /** Mark every row of `fileId` dead. */
+  removeFile(fileId: string): void {
+    const fileRef = this.fileIds.refOf(fileId);
+    if (fileRef === undefined) return;
+    for (const row of this.rowsOfFileRef(fileRef)) {
+      if (this.dead[row] === 0) {
+        this.dead[row] = 1;
+        this.deadCount++;
+      }
+    }
+    this.fileOverrides.set(fileRef, []);
+    this.stale = true;
+  }
+
+  /** Live rows of `fileId`, in insertion order. */
+  symbolsOfFile(fileId: string): SymbolLiteRow[] | undefined {
+    const fileRef = this.fileIds.refOf(fileId);
+    if (fileRef === undefined) return undefined;
+    const rows = this.rowsOfFileRef(fileRef);
+    return rows.length > 0 ? rows.map((row) => this.rowAt(row)) : undefined;
+  }
+
+  /** Live rows named `name`, in insertion order. */
+  symbolsNamed(name: string): SymbolLiteRow[] | undefined {
+    const range = this.nameRange(name);
+    if (!range) return undefined;
+    const symbols: SymbolLiteRow[] = [];
+    for (let at = range[0]; at < range[1]; at++) {
+      symbols.push(this.rowAt(this.byName.order[at]));
+    }
+    return symbols;
+  }
+
+  /** Sorted, unique IDs of symbols named `name`. */
+  symbolIdsNamed(name: string): string[] | undefined {
+    const range = this.nameRange(name);
+    if (!range) return undefined;
+    const ids: string[] = [];
+    for (let at = range[0]; at < range[1]; at++) {
+      const id = this.symbolIds[this.byNameSortedIds[at]];
+      if (ids.length === 0 || ids[ids.length - 1] !== id) ids.push(id);
+    }
+    return ids;
+  }
+
+  /**
+   * The one exported symbol among several named `name`, when exactly one of
+   * them is exported.
+   */
+  preferredSymbolIdNamed(name: string): string | undefined {
+    const range = this.nameRange(name);
+    if (!range || range[1] - range[0] <= 1) return undefined;
+    let preferred: string | undefined;
+    for (let at = range[0]; at < range[1]; at++) {
+      const row = this.byName.order[at];
+      if (this.exported[row] === 0) continue;
+      if (preferred !== undefined) return undefined;
+      preferred = this.symbolIds[row];
+    }
+    return preferred;
+  }
+
+  /** Names with at least one live row. */
+  liveNames(): string[] {
+    this.rebuild();
+    const names: string[] = [];
+    const { offsets } = this.byName;
+    for (let ref = 0; ref + 1 < offsets.length; ref++) {
+      if (offsets[ref + 1] > offsets[ref]) names.push(this.names.valueOf(ref));
+    }
+    return names;
+  }
+
+  /** Number of names with at least one live row. */
+  get nameCount(): number {
+    this.rebuild();
+    return this.liveNameCount;
+  }
+
+  /** Every live row grouped by file ID, in insertion order. */
+  *files(): IterableIterator<[string, SymbolLiteRow[]]> {
+    this.rebuild();
+    const { order, offsets } = this.byFile;
+    for (let ref = 0; ref + 1 < offsets.length; ref++) {
+      if (offsets[ref + 1] === offsets[ref]) continue;
+      const symbols: SymbolLiteRow[] = [];
+      for (let at = offsets[ref]; at < offsets[ref + 1]; at++) {
+        symbols.push(this.rowAt(order[at]));
+      }
+      yield [this.fileIds.valueOf(ref), symbols];
+    }
+  }
+
+  /** Drop every row and release the columns; intern tables are kept. */
+  clear(): void {
+    this.symbolIds = [];
+    this.nameRefs = new Uint32Array(INITIAL_CAPACITY);
+    this.fileRefs = new Uint32Array(INITIAL_CAPACITY);
+    this.kindRefs = new Uint16Array(INITIAL_CAPACITY);
+    this.repoRefs = new Uint16Array(INITIAL_CAPACITY);
+    this.exported = new Uint8Array(INITIAL_CAPACITY);
+    this.dead = new Uint8Array(INITIAL_CAPACITY);
+    this.rowCount = 0;
+    this.deadCount = 0;
+    this.stale = true;
+    this.rebuild();
+  }
+
+  private push(symbol: SymbolLiteRow): number {
+    if (this.rowCount === this.nameRefs.length) {
+      this.grow(this.rowCount * 2);
+    }
+    const row = this.rowCount++;
+    this.symbolIds.push(symbol.symbolId);
+    this.nameRefs[row] = this.names.intern(symbol.name);
+    this.fileRefs[row] = this.fileIds.intern(symbol.fileId);
+    this.kindRefs[row] = this.kinds.intern(symbol.kind);
+    this.repoRefs[row] = this.repoIds.intern(symbol.repoId);
+    this.exported[row] = symbol.exported ? 1 : 0;
+    return row;
+  }
+
+  private rowAt(row: number): SymbolLiteRow {
+    return {
+      symbolId: this.symbolIds[row],
+      repoId: this.repoIds.valueOf(this.repoRefs[row]),
+      fileId: this.fileIds.valueOf(this.fileRefs[row]),
+      name: this.names.valueOf(this.nameRefs[row]),
+      kind: this.kinds.valueOf(this.kindRefs[row]),
+      exported: this.exported[row] === 1,
+    };
+  }
+
+  private nameRange(name: string): [number, number] | undefined {
+    this.rebuild();
+    const ref = this.names.refOf(name);
+    const { offsets } = this.byName;
+    if (ref === undefined || ref + 1 >= offsets.length) return undefined;
+    const start = offsets[ref];
+    const end = offsets[ref + 1];
+    return end > start ? [start, end] : undefined;
+  }
+
+  private rowsOfFileRef(fileRef: number): readonly number[] {
+    return this.fileOverrides.get(fileRef) ?? this.packedFileRows(fileRef);
+  }
+
+  private packedFileRows(fileRef: number): number[] {
+    const { order, offsets } = this.byFile;
+    if (fileRef + 1 >= offsets.length) return [];
+    return Array.from(order.subarray(offsets[fileRef], offsets[fileRef + 1]));
+  }
+
+  private grow(capacity: number): void {
+    const used = this.rowCount;
+    this.nameRefs = grown(new Uint32Array(capacity), this.nameRefs, used);
+    this.fileRefs = grown(new Uint32Array(capacity), this.fileRefs, used);
+    this.kindRefs = grown(new Uint16Array(capacity), this.kindRefs, used);
+    this.repoRefs = grown(new Uint16Array(capacity), this.repoRefs, used);
+    this.exported = grown(new Uint8Array(capacity), this.exported, used);
+    this.dead = grown(new Uint8Array(capacity), this.dead, used);
+  }
+
+  /** Compact live rows and rebuild the orders, if anything changed. */
+  private rebuild(): void {
+    if (!this.stale) return;
+    if (this.deadCount > 0) this.compact();
+
+    const rowCount = this.rowCount;
+    this.byName = groupRows(this.nameRefs, rowCount, this.names.size);
+    this.byFile = groupRows(this.fileRefs, rowCount, this.fileIds.size);
+
+    const sorted = this.byName.order.slice();
+    const { offsets } = this.byName;
+    let liveNames = 0;
+    for (let ref = 0; ref + 1 < offsets.length; ref++) {
+      const start = offsets[ref];
+      const end = offsets[ref + 1];
+      if (end === start) continue;
+      liveNames++;
+      if (end - start > 1) {
+        const range = sorted.subarray(start, end);
+        const ids = this.symbolIds;
+        range.sort((a, b) => (ids[a] < ids[b] ? -1 : ids[a] > ids[b] ? 1 : 0));
+      }
+    }
+    this.byNameSortedIds = sorted;
+    this.liveNameCount = liveNames;
+    this.fileOverrides.clear();
+    this.stale = false;
+  }
+
+  private compact(): void {
+    let write = 0;
+    for (let read = 0; read < this.rowCount; read++) {
+      if (this.dead[read] === 1) continue;
+      if (write !== read) {
+        this.symbolIds[write] = this.symbolIds[read];
+        this.nameRefs[write] = this.nameRefs[read];
+        this.fileRefs[write] = this.fileRefs[read];
+        this.kindRefs[write] = this.kindRefs[read];
+        this.repoRefs[write] = this.repoRefs[read];
+        this.exported[write] = this.exported[read];
+      }
+      write++;
+    }
+    this.symbolIds.length = write;
+    this.dead.fill(0, 0, this.rowCount);
+    this.rowCount = write;
+    this.deadCount = 0;
+  }
+}
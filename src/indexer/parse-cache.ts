@@ -0,0 +1,279 @@
+/**
+ * Persistent parse cache kept next to the graph database.
+ *
+ * Entries are keyed by (relPath, size, mtime, inode). On a warm re-index the
+ * scanner takes each unchanged file's content hash from here instead of
+ * reading the file, and native pass 1 reuses the stored extraction instead
+ * of parsing it again. A stat mismatch is always a miss: the cache can only
+ * say that a file did not change, never that it did.
+ */
+import { mkdir, readFile, rename, writeFile } from "fs/promises";
+import { deserialize, serialize } from "node:v8";
+import { dirname } from "path";
+
+import { getLadybugDbPath } from "../db/ladybug.js";
+import { getPackageVersion } from "../util/package-info.js";
+import { logger } from "../util/logger.js";
+
+import { nativeFingerprintMode } from "./rustIndexer.js";
+import type { RustParseResult } from "./rustIndexer.js";
+
+const PARSE_CACHE_SCHEMA_VERSION = 1;
+
+/**
+ * Files modified this recently are not cached: a write landing in the same
+ * mtime tick as the scan would otherwise be hidden behind a stale hash.
+ */
+const RACY_MTIME_WINDOW_MS = 2_000;
+
+/**
+ * Extractions depend on the package version and on the native fingerprint
+ * mode, so switching either invalidates the cache.
+ */
+function engineVersion(): string {
+  return `${getPackageVersion()}+fp:${nativeFingerprintMode()}`;
+}
+
+/** The stat fields that key a cache entry. */
+export interface ParseCacheFileKey {
+  path: string;
+  size: number;
+  mtime: number;
+  inode?: number;
+}
+
+interface ParseCacheEntry {
+  size: number;
+  mtime: number;
+  inode: number;
+  contentHash: string;
+  /** v8-serialised {@link CachedExtraction}, snapshotted when recorded. */
+  extraction?: Uint8Array;
+}
+
+type CachedExtraction = Pick<RustParseResult, "symbols" | "imports" | "calls">;
+
+interface ParseCachePayload {
+  schemaVersion: number;
+  engineVersion: string;
+  entries: Map<string, ParseCacheEntry>;
+}
+
+/**
+ * The parse cache is on by default whenever a graph database is open. Set
+ * SDL_MCP_PARSE_CACHE=0 to always read and parse every file.
+ */
+export function shouldUseParseCache(
+  env: NodeJS.ProcessEnv = process.env,
+): boolean {
+  return !/^(0|false|no)$/i.test((env.SDL_MCP_PARSE_CACHE ?? "").trim());
+}
+
+/** `<graph db>.parse-cache/<repo>.bin` */
+export function resolveParseCachePath(
+  graphDbPath: string,
+  repoId: string,
+): string {
+  return `${graphDbPath}.parse-cache/${encodeURIComponent(repoId)}.bin`;
+}
+
+export class ParseCache {
+  private dirty = false;
+
+  constructor(
+    readonly path: string,
+    private readonly entries: Map<string, ParseCacheEntry> = new Map(),
+  ) {}
+
+  get size(): number {
+    return this.entries.size;
+  }
+
+  /** Content hash recorded for an identical stat, if any. */
+  contentHashFor(file: ParseCacheFileKey): string | undefined {
+    return this.match(file)?.contentHash;
+  }
+
+  /**
+   * Stored native extraction for `file`, or null. Requires the stat and the
+   * scanner's content hash to both match. Each call returns fresh objects,
+   * so callers may mutate the result.
+   */
+  resultFor(
+    file: ParseCacheFileKey & { contentHash?: string },
+  ): RustParseResult | null {
+    const entry = this.match(file);
+    if (!entry?.extraction || entry.contentHash !== file.contentHash) {
+      return null;
+    }
+    try {
+      const extraction = deserialize(entry.extraction) as CachedExtraction;
+      return {
+        relPath: file.path,
+        contentHash: entry.contentHash,
+        symbols: extraction.symbols,
+        imports: extraction.imports,
+        calls: extraction.calls,
+        parseError: null,
+      };
+    } catch {
+      entry.extraction = undefined;
+      this.dirty = true;
+      return null;
+    }
+  }
+
+  recordContentHash(file: ParseCacheFileKey, contentHash: string): void {
+    if (Date.now() - file.mtime < RACY_MTIME_WINDOW_MS) return;
+    const existing = this.entries.get(file.path);
+    if (existing?.contentHash === contentHash) {
+      // Same bytes under a new stat (touch, checkout): keep the extraction.
+      if (this.match(file)) return;
+      existing.size = file.size;
+      existing.mtime = file.mtime;
+      existing.inode = file.inode ?? 0;
+      this.dirty = true;
+      return;
+    }
+    this.entries.set(file.path, {
+      size: file.size,
+      mtime: file.mtime,
+      inode: file.inode ?? 0,
+      contentHash,
+    });
+    this.dirty = true;
+  }
+
+  /**
+   * Store a clean native extraction. Only applies to files whose hash the
+   * scanner recorded for the same stat, and only when the native parser saw
+   * the same bytes (its hash matches the scanner's).
+   */
+  recordResult(
+    file: ParseCacheFileKey & { contentHash?: string },
+    result: RustParseResult,
+  ): void {
+    const entry = this.match(file);
+    if (
+      !entry ||
+      entry.extraction ||
+      result.parseError ||
+      entry.contentHash !== file.contentHash ||
+      result.contentHash !== entry.contentHash
+    ) {
+      return;
+    }
+    const extraction: CachedExtraction = {
+      symbols: result.symbols,
+      imports: result.imports,
+      calls: result.calls,
+    };
+    entry.extraction = serialize(extraction);
+    this.dirty = true;
+  }
+
+  /** Drop entries for paths that are no longer part of the repository. */
+  retain(paths: ReadonlySet<string>): void {
+    for (const path of this.entries.keys()) {
+      if (!paths.has(path)) {
+        this.entries.delete(path);
+        this.dirty = true;
+      }
+    }
+  }
+
+  /** Write the cache if it changed. Failures are logged, never thrown. */
+  async flush(): Promise<void> {
+    if (!this.dirty) return;
+    const payload: ParseCachePayload = {
+      schemaVersion: PARSE_CACHE_SCHEMA_VERSION,
+      engineVersion: engineVersion(),
+      entries: this.entries,
+    };
+    const tempPath = `${this.path}.${process.pid}.${Date.now()}.tmp`;
+    try {
+      await mkdir(dirname(this.path), { recursive: true });
+      await writeFile(tempPath, serialize(payload));
+      await rename(tempPath, this.path);
+      this.dirty = false;
+    } catch (err) {
+      logger.debug("parse cache write failed", {
+        cachePath: this.path,
+        error: err instanceof Error ? err.message : String(err),
+      });
+    }
+  }
+
+  private match(file: ParseCacheFileKey): ParseCacheEntry | undefined {
+    const entry = this.entries.get(file.path);
+    if (
+      !entry ||
+      entry.size !== file.size ||
+      entry.mtime !== file.mtime ||
+      entry.inode !== (file.inode ?? 0)
+    ) {
+      return undefined;
+    }
+    return entry;
+  }
+}
+
+/**
+ * Load a cache file. Missing, unreadable or stale-version files yield an
+ * empty cache; the next flush replaces them.
+ */
+export async function loadParseCache(path: string): Promise<ParseCache> {
+  try {
+    const payload = deserialize(
+      await readFile(path),
+    ) as Partial<ParseCachePayload>;
+    if (
+      payload.schemaVersion === PARSE_CACHE_SCHEMA_VERSION &&
+      payload.engineVersion === engineVersion() &&
+      payload.entries instanceof Map
+    ) {
+      return new ParseCache(path, payload.entries);
+    }
+  } catch (err) {
+    const code = (err as NodeJS.ErrnoException).code;
+    if (code !== "ENOENT") {
+      logger.debug("parse cache read failed", {
+        cachePath: path,
+        error: err instanceof Error ? err.message : String(err),
+      });
+    }
+  }
+  return new ParseCache(path);
+}
+
+const openCaches = new Map<string, Promise<ParseCache>>();
+
+/**
+ * The process-wide cache for `repoId` next to the open graph database, or
+ * null when the cache is disabled or no database is open. Scanner and pass 1
+ * share the same instance within a run; {@link releaseParseCache} drops it
+ * once the run has flushed, so a long-running server does not keep every
+ * repo's extractions resident between index runs.
+ */
+export function openParseCache(repoId: string): Promise<ParseCache> | null {
+  if (!shouldUseParseCache()) return null;
+  const graphDbPath = getLadybugDbPath();
+  if (!graphDbPath) return null;
+  const path = resolveParseCachePath(graphDbPath, repoId);
+  let cache = openCaches.get(path);
+  if (!cache) {
+    cache = loadParseCache(path);
+    openCaches.set(path, cache);
+  }
+  return cache;
+}
+
+/**
+ * Forget the in-memory cache for `repoId` after its index run has flushed it.
+ * The next run reloads it from disk.
+ */
+export function releaseParseCache(repoId: string): void {
+  const graphDbPath = getLadybugDbPath();
+  if (!graphDbPath) return;
+  openCaches.delete(resolveParseCachePath(graphDbPath, repoId));
+}
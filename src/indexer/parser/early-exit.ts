@@ -93,6 +93,7 @@ export async function resolveFileForIndexing(params: {
         repoId,
         relPath,
         contentHash,
+        contentFastHash: fileMeta.contentFastHash,
         language: ext,
         byteSize: fileMeta.size,
       });
@@ -131,6 +132,7 @@ export async function resolveFileForIndexing(params: {
         repoId,
         relPath,
         contentHash,
+        contentFastHash: fileMeta.contentFastHash,
         language: ext,
         byteSize: fileMeta.size,
       });
@@ -158,6 +160,7 @@ export async function resolveFileForIndexing(params: {
         repoId,
         relPath,
         contentHash,
+        contentFastHash: fileMeta.contentFastHash,
         language: ext,
         byteSize: fileMeta.size,
       });
@@ -24,6 +24,7 @@ interface PersistSkippedFileParams {
   repoId: string;
   relPath: string;
   contentHash: string;
+  contentFastHash?: string;
   language: string;
   byteSize: number;
 }
@@ -92,6 +93,7 @@ export async function persistSkippedFile({
   repoId,
   relPath,
   contentHash,
+  contentFastHash,
   language,
   byteSize,
 }: PersistSkippedFileParams): Promise<void> {
@@ -104,6 +106,7 @@ export async function persistSkippedFile({
       repoId,
       relPath,
       contentHash,
+      contentFastHash,
       language: canonicalizeLanguageId(language, relPath),
       byteSize,
       lastIndexedAt: new Date().toISOString(),
@@ -237,6 +237,7 @@ export async function processFile(
           repoId,
           relPath: fileData.relPath,
           contentHash: fileData.contentHash,
+          contentFastHash: fileMeta.contentFastHash,
           language: canonicalizeLanguageId(
             adapter?.languageId ?? fileData.ext,
             fileData.relPath,
@@ -281,6 +282,7 @@ export async function processFile(
             repoId,
             relPath: fileData.relPath,
             contentHash: fileData.contentHash,
+            contentFastHash: fileMeta.contentFastHash,
             language: canonicalizeLanguageId(
               adapter?.languageId ?? fileData.ext,
               fileData.relPath,
@@ -72,10 +72,10 @@ export async function processFileFromRustResult(params: {
   createdCallEdges: Set<string>;
   tsResolver: TsCallResolver | null;
   config: RepoConfig;
-  allSymbolsByName: Map<string, ladybugDb.SymbolLiteRow[]>;
+  allSymbolsByName: ReadonlyMap<string, ladybugDb.SymbolLiteRow[]>;
   skipCallResolution: boolean;
-  globalNameToSymbolIds?: Map<string, string[]>;
-  globalPreferredSymbolId?: Map<string, string>;
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>;
+  globalPreferredSymbolId?: ReadonlyMap<string, string>;
   supportsPass2FilePath?: (relPath: string) => boolean;
   batchAccumulator?: BatchPersistAccumulator;
   pass1Extractions?: Pass1ExtractionCache;
@@ -167,6 +167,7 @@ export async function processFileFromRustResult(params: {
             repoId,
             relPath,
             contentHash,
+            contentFastHash: fileMeta.contentFastHash,
             language: canonicalizeLanguageId(ext, relPath),
             byteSize: fileMeta.size,
             lastIndexedAt: new Date().toISOString(),
@@ -395,6 +396,7 @@ export async function processFileFromRustResult(params: {
           repoId,
           relPath,
           contentHash,
+          contentFastHash: fileMeta.contentFastHash,
           language: languageId,
           byteSize: fileMeta.size,
           lastIndexedAt: new Date().toISOString(),
@@ -412,6 +414,7 @@ export async function processFileFromRustResult(params: {
             repoId,
             relPath,
             contentHash,
+            contentFastHash: fileMeta.contentFastHash,
             language: languageId,
             byteSize: fileMeta.size,
             lastIndexedAt: new Date().toISOString(),
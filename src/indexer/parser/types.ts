@@ -45,12 +45,12 @@ export interface ProcessFileParams {
   createdCallEdges?: Set<string>;
   tsResolver?: TsCallResolver | null;
   config?: RepoConfig;
-  allSymbolsByName?: Map<string, ladybugDb.SymbolLiteRow[]>;
+  allSymbolsByName?: ReadonlyMap<string, ladybugDb.SymbolLiteRow[]>;
   onProgress?: (progress: IndexProgress) => void;
   workerPool?: ParserWorkerPool | null;
   skipCallResolution?: boolean;
-  globalNameToSymbolIds?: Map<string, string[]>;
-  globalPreferredSymbolId?: Map<string, string>;
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>;
+  globalPreferredSymbolId?: ReadonlyMap<string, string>;
   supportsPass2FilePath?: (relPath: string) => boolean;
   batchAccumulator?: BatchPersistAccumulator;
   /**
@@ -187,8 +187,8 @@ export interface BuildRowsParams {
   createdCallEdges?: Set<string>;
   tsResolver?: TsCallResolver | null;
   skipCallResolution?: boolean;
-  globalNameToSymbolIds?: Map<string, string[]>;
-  globalPreferredSymbolId?: Map<string, string>;
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>;
+  globalPreferredSymbolId?: ReadonlyMap<string, string>;
   adapter?: import("../adapter/LanguageAdapter.js").LanguageAdapter | null;
 }
 
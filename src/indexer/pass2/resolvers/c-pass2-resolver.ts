@@ -606,7 +606,7 @@ function resolveCPass2CallTarget(params: {
   includedNameToSymbolIds: Map<string, string[]>;
   headerPairNameToSymbolIds: Map<string, string[]>;
   sameDirectoryNameToSymbolIds: Map<string, string[]>;
-  globalNameToSymbolIds?: Map<string, string[]>;
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>;
 }): CResolvedCall | null {
   const {
     call,
@@ -766,7 +766,7 @@ async function resolveCCallEdgesPass2(params: {
   fileMeta: FileMetadata;
   languages: string[];
   createdCallEdges: Set<string>;
-  globalNameToSymbolIds?: Map<string, string[]>;
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>;
   telemetry?: Pass2ResolverContext["telemetry"];
   cache?: Map<string, unknown>;
   mode?: "full" | "incremental";
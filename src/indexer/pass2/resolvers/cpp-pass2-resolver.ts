@@ -975,7 +975,7 @@ function resolveCppPass2CallTarget(params: {
   usingNamespaces: Set<string>;
   headerPairNameToSymbolIds: Map<string, string[]>;
   sameDirectoryNameToSymbolIds: Map<string, string[]>;
-  globalNameToSymbolIds?: Map<string, string[]>;
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>;
 }): CppResolvedCall | null {
   const {
     call,
@@ -1115,7 +1115,7 @@ async function resolveCppCallEdgesPass2(params: {
   repoRoot: string;
   fileMeta: FileMetadata;
   createdCallEdges: Set<string>;
-  globalNameToSymbolIds?: Map<string, string[]>;
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>;
   telemetry?: Pass2ResolverContext["telemetry"];
   cache?: Map<string, unknown>;
   mode?: "full" | "incremental";
@@ -789,7 +789,7 @@ function resolveCSharpPass2CallTarget(params: {
   callerClassNameByNodeId: Map<string, string>;
   localBaseByClassName: Map<string, string>;
   staticUsingNameToSymbolIds: Map<string, string[]>;
-  globalNameToSymbolIds?: Map<string, string[]>;
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>;
 }): CSharpResolvedCall | null {
   const {
     call,
@@ -932,7 +932,7 @@ async function resolveCSharpCallEdgesPass2(params: {
   repoRoot: string;
   fileMeta: FileMetadata;
   createdCallEdges: Set<string>;
-  globalNameToSymbolIds?: Map<string, string[]>;
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>;
   telemetry?: Pass2ResolverContext["telemetry"];
   cache?: Map<string, unknown>;
   mode?: "full" | "incremental";
@@ -449,7 +449,7 @@ function resolveGoPass2CallTarget(params: {
   importedNameToSymbolIds: Map<string, string[]>;
   namespaceImports: Map<string, Map<string, string>>;
   receiverNamespaces: Map<string, Map<string, string>>;
-  globalNameToSymbolIds?: Map<string, string[]>;
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>;
 }): GoResolvedCall | null {
   const {
     call,
@@ -570,7 +570,7 @@ async function resolveGoCallEdgesPass2(params: {
   fileMeta: FileMetadata;
   languages: string[];
   createdCallEdges: Set<string>;
-  globalNameToSymbolIds?: Map<string, string[]>;
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>;
   telemetry?: Pass2ResolverContext["telemetry"];
   cache?: Map<string, unknown>;
   mode?: "full" | "incremental";
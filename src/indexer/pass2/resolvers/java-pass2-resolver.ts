@@ -866,7 +866,7 @@ export function resolveJavaPass2CallTarget(params: {
   classMethodsByName: Map<string, Map<string, string[]>>;
   callerClassNameByNodeId: Map<string, string>;
   localExtendsByClassName: Map<string, string>;
-  globalNameToSymbolIds?: Map<string, string[]>;
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>;
   staticImportClassByMember?: Map<string, string>;
   callArity?: number;
   paramCountBySymbolId?: Map<string, number>;
@@ -1093,7 +1093,7 @@ async function resolveJavaCallEdgesPass2(params: {
   repoRoot: string;
   fileMeta: FileMetadata;
   createdCallEdges: Set<string>;
-  globalNameToSymbolIds?: Map<string, string[]>;
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>;
   telemetry?: Pass2ResolverContext["telemetry"];
   cache?: Map<string, unknown>;
   mode?: "full" | "incremental";
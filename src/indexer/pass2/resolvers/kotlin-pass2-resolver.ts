@@ -595,7 +595,7 @@ function matchKotlinImportedInstanceMethodCall(params: {
   callerSourceText?: string;
   importedNameToSymbolIds: Map<string, string[]>;
   classNameToSymbolIds: Map<string, string[]>;
-  globalNameToSymbolIds?: Map<string, string[]>;
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>;
   methodsByClassSymbolId: Map<string, Map<string, string[]>>;
 }): KotlinResolvedCall | null {
   const {
@@ -677,7 +677,7 @@ function resolveKotlinPass2CallTarget(params: {
   callerSourceText?: string;
   classNameToSymbolIds: Map<string, string[]>;
   methodsByClassSymbolId: Map<string, Map<string, string[]>>;
-  globalNameToSymbolIds?: Map<string, string[]>;
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>;
 }): KotlinResolvedCall | null {
   const {
     call,
@@ -809,7 +809,7 @@ async function resolveKotlinCallEdgesPass2(params: {
   repoRoot: string;
   fileMeta: FileMetadata;
   createdCallEdges: Set<string>;
-  globalNameToSymbolIds?: Map<string, string[]>;
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>;
   telemetry?: Pass2ResolverContext["telemetry"];
   cache?: Map<string, unknown>;
   mode?: "full" | "incremental";
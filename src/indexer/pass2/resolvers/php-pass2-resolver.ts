@@ -854,7 +854,7 @@ async function resolvePhpPass2CallTarget(params: {
   extensions: string[];
   cache?: Map<string, unknown>;
   callerSourceText?: string;
-  globalNameToSymbolIds?: Map<string, string[]>;
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>;
 }): Promise<PhpResolvedCall | null> {
   const {
     call,
@@ -1112,7 +1112,7 @@ async function resolvePhpCallEdgesPass2(params: {
   repoRoot: string;
   fileMeta: FileMetadata;
   createdCallEdges: Set<string>;
-  globalNameToSymbolIds?: Map<string, string[]>;
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>;
   telemetry?: Pass2ResolverContext["telemetry"];
   cache?: Map<string, unknown>;
   mode?: "full" | "incremental";
@@ -865,7 +865,7 @@ function resolveRustPass2CallTarget(params: {
   explicitImportedNames: Set<string>;
   sameModuleNameToSymbolIds: Map<string, string[]>;
   cratePathToSymbolIds: Map<string, string[]>;
-  globalNameToSymbolIds?: Map<string, string[]>;
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>;
   callerFilePath?: string;
   symbolIdDetails?: Map<string, { filePath: string; exported: boolean }>;
   // Phase 2 Task 2.4.x additions.
@@ -1164,7 +1164,7 @@ async function resolveRustCallEdgesPass2(params: {
   repoRoot: string;
   fileMeta: FileMetadata;
   createdCallEdges: Set<string>;
-  globalNameToSymbolIds?: Map<string, string[]>;
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>;
   telemetry?: Pass2ResolverContext["telemetry"];
   cache?: Map<string, unknown>;
   mode?: "full" | "incremental";
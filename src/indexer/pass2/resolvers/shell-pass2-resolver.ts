@@ -408,7 +408,7 @@ function resolveShellPass2CallTarget(params: {
   nodeIdToSymbolId: Map<string, string>;
   sourceNameToSymbolIds: Map<string, string[]>;
   sameDirectoryNameToSymbolIds: Map<string, string[]>;
-  globalNameToSymbolIds?: Map<string, string[]>;
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>;
 }): ShellResolvedCall | null {
   const {
     call,
@@ -480,7 +480,7 @@ async function resolveShellCallEdgesPass2(params: {
   repoRoot: string;
   fileMeta: FileMetadata;
   createdCallEdges: Set<string>;
-  globalNameToSymbolIds?: Map<string, string[]>;
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>;
   telemetry?: Pass2ResolverContext["telemetry"];
   cache?: Map<string, unknown>;
   mode?: "full" | "incremental";
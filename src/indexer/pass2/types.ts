@@ -6,6 +6,9 @@ import type { ExtractedImport } from "../treesitter/extractImports.js";
 import type { ExtractedCall } from "../treesitter/extractCalls.js";
 import type { ExtractedSymbol } from "../treesitter/extractSymbols.js";
 import { normalizePath } from "../../util/paths.js";
+import type {
+  IncludePathIndex,
+} from "../import-resolution/include-path-index.js";
 
 export interface Pass2Target {
   repoId?: string;
@@ -76,6 +79,12 @@ export interface Pass2ImportCache {
    * that were not preloaded.
    */
   exportedFullSymbolsByFileId?: Map<string, Pass2ExportedSymbolFull[]>;
+  /**
+   * Path trie over `fileByRelPath`'s keys, built on first use. C and C++
+   * include resolution walks it instead of probing candidate paths, and its
+   * memo is shared by every file in the pass.
+   */
+  includePathIndex?: IncludePathIndex;
 }
 
 export interface Pass2ExportedSymbolFull extends ExportedSymbolLite {
@@ -552,8 +561,8 @@ export interface Pass2ResolverContext {
   tsResolver: TsCallResolver | null;
   languages: string[];
   createdCallEdges: Set<string>;
-  globalNameToSymbolIds?: Map<string, string[]>;
-  globalPreferredSymbolId?: Map<string, string>;
+  globalNameToSymbolIds?: ReadonlyMap<string, string[]>;
+  globalPreferredSymbolId?: ReadonlyMap<string, string>;
   telemetry?: CallResolutionTelemetry;
   cache?: Map<string, unknown>;
   /**
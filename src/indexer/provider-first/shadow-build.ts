@@ -107,7 +107,13 @@ interface CsvArtifactManifest {
   kind: "node" | "relationship";
 }
 
-const REPO_COLUMNS = ["repoId", "rootPath", "configJson", "createdAt"] as const;
+const REPO_COLUMNS = [
+  "repoId",
+  "rootPath",
+  "configJson",
+  "createdAt",
+  "contentFastHashAlgorithm",
+] as const;
 
 const FILE_COLUMNS = [
   "fileId",
@@ -117,6 +123,7 @@ const FILE_COLUMNS = [
   "byteSize",
   "lastIndexedAt",
   "directory",
+  "contentFastHash",
 ] as const;
 
 const SYMBOL_COLUMNS = [
@@ -251,6 +258,7 @@ export async function stageProviderFirstShadowBuild(
           normalizePath(row.rootPath),
           row.configJson,
           row.createdAt,
+          null,
         ],
       }),
       files: await writeCsvArtifact({
@@ -268,6 +276,7 @@ export async function stageProviderFirstShadowBuild(
           row.byteSize,
           row.lastIndexedAt,
           directoryForRelPath(row.relPath),
+          row.contentFastHash ?? null,
         ],
       }),
       symbols: await writeCsvArtifact({
@@ -0,0 +1,155 @@
+/**
+ * Decoder for the native addon's packed symbol buffer (see
+ * `native/src/parse/packed.rs` for the byte layout).
+ *
+ * The packed mode replaces per-field napi object construction with one
+ * `Buffer` per batch. Symbols are decoded per file on first access, so files
+ * that pass 1 skips (unchanged content hash) never materialise theirs.
+ */
+import type { RustExtractedSymbol } from "./rustIndexer.js";
+
+/** "SDLS" read as a little-endian u32. */
+const PACKED_SYMBOLS_MAGIC = 0x534c4453;
+const PACKED_SYMBOLS_VERSION = 1;
+const HEADER_BYTES = 24;
+
+// String field order within each symbol row.
+const F_NODE_ID = 0;
+const F_SYMBOL_ID = 1;
+const F_AST_FINGERPRINT = 2;
+const F_NAME = 3;
+const F_SUMMARY = 4;
+const F_SEARCH_TEXT = 5;
+const F_SIGNATURE = 6;
+const F_INVARIANTS = 7;
+const F_SIDE_EFFECTS = 8;
+const F_ROLE_TAGS = 9;
+const F_DECORATORS = 10;
+const STRING_FIELDS = 11;
+
+type Visibility = NonNullable<RustExtractedSymbol["visibility"]>;
+
+/** Random-access view over one packed symbol buffer. */
+export class PackedSymbolReader {
+  readonly symbolCount: number;
+  private readonly view: DataView;
+  private readonly dict: string[];
+  private readonly kindOffset: number;
+  private readonly visibilityOffset: number;
+  private readonly exportedOffset: number;
+  private readonly rangeOffset: number;
+  private readonly refOffset: number;
+  private readonly stringOffset: number;
+
+  constructor(private readonly buffer: Buffer) {
+    if (buffer.byteLength < HEADER_BYTES) {
+      throw new Error("Packed symbol buffer is truncated");
+    }
+    this.view = new DataView(
+      buffer.buffer,
+      buffer.byteOffset,
+      buffer.byteLength,
+    );
+    const magic = this.view.getUint32(0, true);
+    const version = this.view.getUint32(4, true);
+    if (magic !== PACKED_SYMBOLS_MAGIC || version !== PACKED_SYMBOLS_VERSION) {
+      throw new Error(
+        `Unsupported packed symbol buffer (magic ${magic.toString(16)}, version ${version})`,
+      );
+    }
+    const symbolCount = this.view.getUint32(8, true);
+    const dictCount = this.view.getUint32(12, true);
+    const stringFields = this.view.getUint32(16, true);
+    const stringBytes = this.view.getUint32(20, true);
+    if (stringFields !== STRING_FIELDS) {
+      throw new Error(
+        `Packed symbol buffer has ${stringFields} string fields, expected ${STRING_FIELDS}`,
+      );
+    }
+
+    this.symbolCount = symbolCount;
+    const dictOffset = HEADER_BYTES;
+    this.kindOffset = dictOffset + dictCount * 8;
+    this.visibilityOffset = this.kindOffset + symbolCount * 2;
+    this.exportedOffset = this.visibilityOffset + symbolCount * 2;
+    this.rangeOffset = (this.exportedOffset + symbolCount + 3) & ~3;
+    this.refOffset = this.rangeOffset + symbolCount * 16;
+    this.stringOffset = this.refOffset + symbolCount * STRING_FIELDS * 8;
+    if (this.stringOffset + stringBytes !== buffer.byteLength) {
+      throw new Error("Packed symbol buffer length does not match its header");
+    }
+
+    this.dict = new Array<string>(dictCount);
+    for (let i = 0; i < dictCount; i++) {
+      const at = dictOffset + i * 8;
+      this.dict[i] = this.slice(
+        this.view.getUint32(at, true),
+        this.view.getUint32(at + 4, true),
+      );
+    }
+  }
+
+  /** Decode rows `[start, start + count)`. */
+  decode(start: number, count: number): RustExtractedSymbol[] {
+    if (start < 0 || start + count > this.symbolCount) {
+      throw new RangeError(
+        `Packed symbol rows ${start}..${start + count} out of bounds (${this.symbolCount})`,
+      );
+    }
+    const symbols = new Array<RustExtractedSymbol>(count);
+    for (let i = 0; i < count; i++) {
+      symbols[i] = this.decodeRow(start + i);
+    }
+    return symbols;
+  }
+
+  private decodeRow(row: number): RustExtractedSymbol {
+    const view = this.view;
+    const kind = this.dict[view.getUint16(this.kindOffset + row * 2, true)];
+    const visibility =
+      this.dict[view.getUint16(this.visibilityOffset + row * 2, true)];
+    const rangeAt = this.rangeOffset + row * 16;
+    const signatureJson = this.field(row, F_SIGNATURE);
+    const decoratorsJson = this.field(row, F_DECORATORS);
+    return {
+      nodeId: this.field(row, F_NODE_ID),
+      symbolId: this.field(row, F_SYMBOL_ID),
+      astFingerprint: this.field(row, F_AST_FINGERPRINT),
+      name: this.field(row, F_NAME),
+      kind: kind as RustExtractedSymbol["kind"],
+      exported: view.getUint8(this.exportedOffset + row) !== 0,
+      visibility: visibility ? (visibility as Visibility) : undefined,
+      range: {
+        startLine: view.getUint32(rangeAt, true),
+        startCol: view.getUint32(rangeAt + 4, true),
+        endLine: view.getUint32(rangeAt + 8, true),
+        endCol: view.getUint32(rangeAt + 12, true),
+      },
+      signature: signatureJson
+        ? (JSON.parse(signatureJson) as RustExtractedSymbol["signature"])
+        : undefined,
+      summary: this.field(row, F_SUMMARY),
+      invariantsJson: this.field(row, F_INVARIANTS) || "[]",
+      sideEffectsJson: this.field(row, F_SIDE_EFFECTS) || "[]",
+      roleTagsJson: this.field(row, F_ROLE_TAGS) || "[]",
+      decorators: decoratorsJson
+        ? (JSON.parse(decoratorsJson) as string[])
+        : undefined,
+      searchText: this.field(row, F_SEARCH_TEXT),
+    };
+  }
+
+  private field(row: number, field: number): string {
+    const at = this.refOffset + (row * STRING_FIELDS + field) * 8;
+    return this.slice(
+      this.view.getUint32(at, true),
+      this.view.getUint32(at + 4, true),
+    );
+  }
+
+  private slice(offset: number, length: number): string {
+    if (length === 0) return "";
+    const start = this.stringOffset + offset;
+    return this.buffer.toString("utf8", start, start + length);
+  }
+}
@@ -10,6 +10,7 @@
  * remains in TypeScript.
  */
 
+import { availableParallelism } from "os";
 import { join } from "path";
 
 import {
@@ -19,6 +20,7 @@ import {
   loadNativeAddon,
 } from "../native/addon-loader.js";
 import { logger } from "../util/logger.js";
+import { isPhaseStatsEnabled } from "../observability/latency-histogram.js";
 import { normalizePath } from "../util/paths.js";
 import type { ExtractedImport } from "./treesitter/extractImports.js";
 import type {
@@ -27,6 +29,11 @@ import type {
 } from "./treesitter/extractCalls.js";
 import type { FileMetadata } from "./fileScanner.js";
 import type { ClusterAssignment, ProcessTrace } from "./cluster-types.js";
+import type { CsrGraph } from "../graph/csr-snapshot.js";
+import type { AppConfig } from "../config/types.js";
+import { DEFAULT_INDEXING_CONCURRENCY } from "../config/constants.js";
+import { hashContent } from "../util/hashing.js";
+import { PackedSymbolReader } from "./rust-packed-symbols.js";
 
 
 // --- napi-rs type interfaces (mirrors native/src/types.rs) ---
@@ -101,6 +108,40 @@ interface NativeParsedFile {
   parseError: string | null;
 }
 
+interface NativeTextEdit {
+  startByte: number;
+  oldEndByte: number;
+  text: string;
+}
+
+interface NativeIncrementalParseInput {
+  repoId: string;
+  relPath: string;
+  language: string;
+  content: string;
+  edits?: NativeTextEdit[];
+}
+
+interface NativeIncrementalParseResult {
+  file: NativeParsedFile;
+  reusedTree: boolean;
+  changedStartLine: number;
+  changedEndLine: number;
+  symbolsReused: number;
+  symbolsEnriched: number;
+  /** Absent on addons that re-extract the whole tree on every edit. */
+  symbolsExtracted?: number;
+}
+
+interface NativeParseEngineStatus {
+  threadCount: number;
+  poolBuilds: number;
+  batchesParsed: number;
+  filesParsed: number;
+  /** Absent on addons that predate `setAstFingerprintMode`. */
+  astFingerprintMode?: string;
+}
+
 interface NativeClusterSymbol {
   symbolId: string;
 }
@@ -138,9 +179,82 @@ interface NativeProcess {
   depth: number;
 }
 
+/** Trace `i`'s steps are `steps[stepOffsets[i]..stepOffsets[i + 1]]`. */
+interface NativeCsrProcessTraces {
+  stepOffsets: Uint32Array;
+  steps: Uint32Array;
+  depths: Uint32Array;
+}
+
+interface NativeScanOptions {
+  includeExtensions: string[];
+  ignorePatterns: string[];
+  maxFileBytes?: number;
+  threadCount: number;
+}
+
+interface NativeScannedFile {
+  relPath: string;
+  size: number;
+  mtimeMs: number;
+  /** Absent on addons that predate the parse cache. */
+  inode?: number;
+}
+
+interface NativeFileHashInput {
+  absolutePath: string;
+  knownFastHash?: string;
+}
+
+interface NativeFileHash {
+  contentFastHash?: string | null;
+  contentHash?: string | null;
+  error?: string | null;
+}
+
+interface NativePackedParseBatch {
+  files: NativeParsedFile[];
+  symbolCounts: number[];
+  symbols: Buffer;
+}
+
+interface NativeParseStreamHandle {
+  readonly totalFiles: number;
+  nextChunk(): Promise<NativeParsedFile[] | null>;
+  nextPackedChunk?(): Promise<NativePackedParseBatch | null>;
+  cancel(): void;
+}
+
 interface NativeAddon {
   parseFiles(files: NativeFileInput[], threadCount: number): NativeParsedFile[];
   parseFilesAsync?(files: NativeFileInput[], threadCount: number): Promise<NativeParsedFile[]>;
+  parseFilesPackedAsync?(
+    files: NativeFileInput[],
+    threadCount: number,
+  ): Promise<NativePackedParseBatch>;
+  scanRepositoryFilesAsync?(
+    rootPath: string,
+    options: NativeScanOptions,
+  ): Promise<NativeScannedFile[]>;
+  hashFilesAsync?(
+    files: NativeFileHashInput[],
+    threadCount: number,
+  ): Promise<NativeFileHash[]>;
+  contentFastHashAlgorithm?(): string;
+  parseFilesStream?(
+    files: NativeFileInput[],
+    threadCount: number,
+    chunkSize: number,
+  ): NativeParseStreamHandle;
+  parseFileIncrementalAsync?(
+    input: NativeIncrementalParseInput,
+  ): Promise<NativeIncrementalParseResult>;
+  forgetIncrementalParse?(repoId: string, relPath?: string | null): number;
+  configureParseEngine?(threadCount: number): NativeParseEngineStatus;
+  parseEngineStatus?(): NativeParseEngineStatus;
+  setAstFingerprintMode?(mode: string): void;
+  shutdownParseEngine?(): void;
+  setNativePhaseStatsEnabled?(enabled: boolean): void;
   hashContentNative(content: string): string;
   generateSymbolIdNative(
     repoId: string,
@@ -167,6 +281,188 @@ interface NativeAddon {
     epsilon: number,
     maxNodesTouched: number,
   ): Array<{ node: number; score: number }>;
+  computeClustersCsr?(
+    offsets: Uint32Array,
+    neighbors: Uint32Array,
+    edgeTypes: Uint8Array | null,
+    edgeTypeMask: number,
+    excluded: Uint8Array | null,
+    minClusterSize: number,
+  ): Uint32Array;
+  computeCommunitiesCsr?(
+    offsets: Uint32Array,
+    neighbors: Uint32Array,
+    edgeTypes: Uint8Array | null,
+    edgeTypeMask: number,
+    excluded: Uint8Array | null,
+    previousGroups: Uint32Array | null,
+    changed: Uint8Array | null,
+    maxIterations: number,
+  ): Uint32Array;
+  computeCentralityCsr?(
+    offsets: Uint32Array,
+    neighbors: Uint32Array,
+    previousPageRank: Float64Array | null,
+    options: {
+      pageRank: boolean;
+      kCore: boolean;
+      maxIterations: number;
+      damping: number;
+      tolerance: number;
+    },
+  ): Promise<{
+    pageRank: Float64Array;
+    kCore: Uint32Array;
+    pageRankIterations: number;
+  }>;
+  computePersonalizedPagerankCsr?(
+    offsets: Uint32Array,
+    neighbors: Uint32Array,
+    weights: Float64Array,
+    seeds: Array<{ node: number; weight: number }>,
+    alpha: number,
+    epsilon: number,
+    maxNodesTouched: number,
+  ): Array<{ node: number; score: number }>;
+  computePersonalizedPagerankCsrBatch?(
+    offsets: Uint32Array,
+    neighbors: Uint32Array,
+    weights: Float64Array,
+    seedNodes: Uint32Array,
+    alpha: number,
+    epsilon: number,
+    maxNodesTouched: number,
+  ): { offsets: Uint32Array; nodes: Uint32Array; scores: Float64Array };
+  traceProcessesCsr?(
+    offsets: Uint32Array,
+    neighbors: Uint32Array,
+    edgeTypes: Uint8Array | null,
+    edgeTypeMask: number,
+    entryNodes: Uint32Array,
+    maxDepth: number,
+  ): NativeCsrProcessTraces;
+  buildEmbeddingIndex?(
+    path: string,
+    dimension: number,
+    symbolIds: string[],
+    vectors: Float32Array,
+    options: { lists?: number; iterations?: number } | null,
+  ): Promise<number>;
+  openEmbeddingIndex?(path: string): RustEmbeddingIndex;
+  sliceGraphBuild?(input: RustSliceGraphInput): RustSliceGraph;
+  lexicalIndexBuild?(
+    symbolIds: string[],
+    names: string[],
+    searchTexts: string[],
+  ): RustLexicalIndex;
+}
+
+/** A memory-mapped native embedding index. */
+export interface RustEmbeddingIndex {
+  readonly dimension: number;
+  readonly rows: number;
+  readonly lists: number;
+  search(
+    query: Float32Array,
+    k: number,
+    nprobe: number,
+  ): Array<{ symbolId: string; score: number }>;
+  /** Unmap the file now. Absent on addons that predate it. */
+  close?(): void;
+}
+
+/**
+ * An in-memory lexical index over symbol names and search text. Name
+ * lookups are case-sensitive; substring and token search are not.
+ */
+export interface RustLexicalIndex {
+  readonly size: number;
+  upsert(symbolIds: string[], names: string[], searchTexts: string[]): void;
+  remove(symbolIds: string[]): void;
+  search(
+    query: string,
+    limit: number,
+    conjunctive: boolean,
+  ): Array<{ symbolId: string; score: number }>;
+  searchSubstring(
+    query: string,
+    limit: number,
+  ): Array<{ symbolId: string; score: number }>;
+  findByName(name: string, prefix: boolean, limit: number): string[];
+  findByIdPrefix(prefix: string, limit: number): string[];
+  contains(symbolId: string): boolean;
+}
+
+/**
+ * A graph snapshot packed for the native slice beam search. Per-edge
+ * columns follow `offsets`; file and cluster indexes are `0xFFFFFFFF` when
+ * absent.
+ */
+export interface RustSliceGraphInput {
+  offsets: Uint32Array;
+  neighbors: Uint32Array;
+  edgeTypes: Uint8Array;
+  confidences: Float64Array;
+  names: string[];
+  nodeFiles: Uint32Array;
+  rangeStartLines: Float64Array;
+  rangeEndLines: Float64Array;
+  filePaths: string[];
+  filePathsLower: string[];
+  structure: Float64Array;
+  kind: Float64Array;
+  hotness: Float64Array;
+  centrality: Float64Array;
+  cardTokens: Float64Array;
+  external: Uint8Array;
+  nodeClusters: Uint32Array;
+}
+
+export interface RustSliceRequest {
+  startNodes: Uint32Array;
+  startScores: Float64Array;
+  forcedNodes: Uint32Array;
+  entryNodes: Uint32Array;
+  requiredEntryCoverage: number;
+  queryTokens: string[];
+  stackTrace?: string;
+  edgeWeights: Float64Array;
+  clusterBoost: Float64Array;
+  minConfidence: number;
+  maxCards: number;
+  maxEstimatedTokens: number;
+  recordEvents: boolean;
+}
+
+/** Event kinds: 0 accept, 1 evict, 2 reject. */
+export interface RustSliceResult {
+  sliceNodes: Uint32Array;
+  frontierNodes: Uint32Array;
+  frontierScores: Float64Array;
+  frontierPriorities: Uint8Array;
+  frontierSequences: Uint32Array;
+  frontierStarts: Uint32Array;
+  frontierEdgeTypes: Uint8Array;
+  wasTruncated: boolean;
+  droppedCandidates: number;
+  maxFrontierSize: number;
+  accepted: number;
+  evicted: number;
+  rejected: number;
+  eventKinds: Uint8Array;
+  eventNodes: Uint32Array;
+  eventScores: Float64Array;
+  eventFrom: Uint32Array;
+  eventEdgeTypes: Uint8Array;
+  eventEdgeWeights: Float64Array;
+  eventIterations: Uint32Array;
+  eventCauses: Uint8Array;
+}
+
+/** A packed snapshot held by the addon. */
+export interface RustSliceGraph {
+  readonly nodeCount: number;
+  beamSearch(request: RustSliceRequest): RustSliceResult;
 }
 
 // --- Addon loading ---
@@ -175,6 +471,7 @@ let nativeDisableLogged = false;
 let nativeDisabledForSession = false;
 let nativeAddonSourcePath: string | null = null;
 let nativeAddonReason = "not attempted";
+let nativeAddonConfigured = false;
 
 function isCompatibleNativeAddon(addon: unknown): addon is NativeAddon {
   if (!addon || typeof addon !== "object") return false;
@@ -216,6 +513,11 @@ function loadRustNativeAddon(): NativeAddon | null {
 
   nativeAddonSourcePath = getNativeAddonSourcePath();
   nativeAddonReason = "loaded";
+  if (!nativeAddonConfigured) {
+    nativeAddonConfigured = true;
+    loaded.setNativePhaseStatsEnabled?.(isPhaseStatsEnabled());
+    applyRustFingerprintMode(loaded, nativeFingerprintMode());
+  }
   return loaded;
 }
 
@@ -515,6 +817,44 @@ export async function parseFilesRustAsync(
 
   const batch = nativeEntries.map((entry) => entry.input);
 
+  if (
+    typeof addon.parseFilesPackedAsync === "function" &&
+    shouldUsePackedNativeSymbols()
+  ) {
+    let packed: NativePackedParseBatch;
+    try {
+      packed = await addon.parseFilesPackedAsync(batch, threadCount);
+    } catch (error) {
+      logger.error(
+        "Native Rust indexer parseFilesPackedAsync failed; disabling native addon",
+        { error, batchSize: batch.length },
+      );
+      nativeDisabledForSession = true;
+      return null;
+    }
+    if (packed.files.length !== batch.length) {
+      logger.error(
+        "Native Rust indexer packed returned unexpected result count",
+        { expected: batch.length, actual: packed.files.length },
+      );
+      nativeDisabledForSession = true;
+      return null;
+    }
+    try {
+      mapNativePackedBatch(packed).forEach((result, batchIndex) => {
+        results[nativeEntries[batchIndex].index] = result;
+      });
+    } catch (error) {
+      logger.error(
+        "Failed to map native packed results; disabling native addon",
+        { error },
+      );
+      nativeDisabledForSession = true;
+      return null;
+    }
+    return results;
+  }
+
   let nativeResults: NativeParsedFile[];
   try {
     nativeResults = await addon.parseFilesAsync(batch, threadCount);
@@ -553,6 +893,469 @@ export async function parseFilesRustAsync(
   return results;
 }
 
+/**
+ * Files per chunk handed back by {@link parseFilesRustStream}. Smaller than
+ * NATIVE_BATCH_SIZE so the first persist batches start early.
+ */
+export const NATIVE_STREAM_CHUNK_SIZE = 50;
+
+/**
+ * Packed symbol output (one columnar buffer per batch, decoded per file on
+ * demand) is opt-in: set SDL_MCP_NATIVE_PACKED_SYMBOLS=1 to use it when the
+ * addon provides it. Napi object conversion stays the default pass-1 path.
+ *
+ * Packed rows carry every field `mapNativeSymbol` reads. The native
+ * `summaryQuality` score is not packed; neither path forwards it, since
+ * build-rows derives quality from the summary itself.
+ */
+export function shouldUsePackedNativeSymbols(
+  env: NodeJS.ProcessEnv = process.env,
+): boolean {
+  return /^(1|true|yes)$/i.test(
+    (env.SDL_MCP_NATIVE_PACKED_SYMBOLS ?? "").trim(),
+  );
+}
+
+/**
+ * Streaming variant of parseFilesRustAsync. Parses the whole file list in one
+ * native call and yields results in chunks as native workers complete them
+ * (completion order, not input order), so callers can start persisting early
+ * files while later ones are still parsing. Native parsing pauses when the
+ * consumer falls more than a couple of chunks behind.
+ *
+ * Results for languages without native extraction are yielded first. Returns
+ * null when the addon (or its streaming export) is unavailable; a native
+ * failure mid-stream disables the addon and throws from the iterator, after
+ * which callers should fall back for files they have not yet received.
+ */
+export function parseFilesRustStream(
+  repoId: string,
+  repoRoot: string,
+  files: FileMetadata[],
+  threadCount: number = 0,
+  chunkSize: number = NATIVE_STREAM_CHUNK_SIZE,
+): AsyncGenerator<RustParseResult[], void, undefined> | null {
+  const addon = loadRustNativeAddon();
+  if (!addon || typeof addon.parseFilesStream !== "function") return null;
+
+  const unsupported: RustParseResult[] = [];
+  const batch: NativeFileInput[] = [];
+  for (const file of files) {
+    const ext = file.path.split(".").pop()?.toLowerCase() ?? "";
+    const language = extensionToLanguage(ext);
+
+    if (!supportsNativeExtractionLanguage(language)) {
+      unsupported.push(
+        buildUnsupportedLanguageResult(file.path, language || ext),
+      );
+      continue;
+    }
+
+    batch.push({
+      relPath: file.path,
+      absolutePath: normalizePath(join(repoRoot, file.path)),
+      repoId,
+      language,
+    });
+  }
+
+  const parseFilesStream = addon.parseFilesStream.bind(addon);
+  return streamNativeParse(unsupported, batch, () =>
+    parseFilesStream(batch, threadCount, Math.max(1, chunkSize)),
+  );
+}
+
+async function* streamNativeParse(
+  unsupported: RustParseResult[],
+  batch: NativeFileInput[],
+  open: () => NativeParseStreamHandle,
+): AsyncGenerator<RustParseResult[], void, undefined> {
+  if (batch.length === 0) {
+    if (unsupported.length > 0) yield unsupported;
+    return;
+  }
+
+  // Open before yielding anything, so native workers are already parsing
+  // while the consumer handles the first results.
+  let handle: NativeParseStreamHandle;
+  try {
+    handle = open();
+  } catch (error) {
+    logger.error(
+      "Native Rust indexer parseFilesStream failed; disabling native addon",
+      { error, batchSize: batch.length },
+    );
+    nativeDisabledForSession = true;
+    throw error;
+  }
+
+  const nextPackedChunk = shouldUsePackedNativeSymbols()
+    ? handle.nextPackedChunk?.bind(handle)
+    : undefined;
+  let received = 0;
+  try {
+    if (unsupported.length > 0) yield unsupported;
+    for (;;) {
+      let chunk: NativeParsedFile[] | NativePackedParseBatch | null;
+      try {
+        chunk = nextPackedChunk
+          ? await nextPackedChunk()
+          : await handle.nextChunk();
+      } catch (error) {
+        logger.error(
+          "Native Rust indexer stream chunk failed; disabling native addon",
+          { error, received, expected: batch.length },
+        );
+        nativeDisabledForSession = true;
+        throw error;
+      }
+      if (chunk === null) break;
+
+      let mapped: RustParseResult[];
+      try {
+        mapped = Array.isArray(chunk)
+          ? chunk.map(mapNativeResult)
+          : mapNativePackedBatch(chunk);
+      } catch (error) {
+        logger.error(
+          "Failed to map native stream results; disabling native addon",
+          { error },
+        );
+        nativeDisabledForSession = true;
+        throw error;
+      }
+      received += mapped.length;
+      yield mapped;
+    }
+
+    if (received !== batch.length) {
+      logger.error(
+        "Native Rust indexer stream returned unexpected result count",
+        { expected: batch.length, actual: received },
+      );
+      nativeDisabledForSession = true;
+      throw new Error(
+        `Native parse stream ended after ${received} of ${batch.length} files`,
+      );
+    }
+  } finally {
+    // No-op once the stream is exhausted; stops native work when the
+    // consumer bails out early (abort, persist error).
+    handle.cancel();
+  }
+}
+
+export interface RustScannedFile {
+  path: string;
+  size: number;
+  mtime: number;
+  /** Inode on Unix; 0 on other platforms or older addons. */
+  inode: number;
+}
+
+/**
+ * Walk a repository with the native parallel scanner. Mirrors
+ * `walkRepositoryFiles` (no gitignore, hidden entries included, symlinks not
+ * followed) for suffix-only include patterns, drops files over
+ * `maxFileBytes`, and returns size/mtime/inode with each path so callers can
+ * skip a per-file stat. Results are sorted by path. Returns null when the addon or
+ * its scanner export is unavailable, or when the native walk fails.
+ */
+export async function scanRepositoryFilesRust(
+  repoRoot: string,
+  options: {
+    extensions: string[];
+    ignorePatterns: string[];
+    maxFileBytes?: number;
+    threadCount?: number;
+  },
+): Promise<RustScannedFile[] | null> {
+  const addon = loadRustNativeAddon();
+  if (!addon || typeof addon.scanRepositoryFilesAsync !== "function") {
+    return null;
+  }
+
+  try {
+    const scanned = await addon.scanRepositoryFilesAsync(repoRoot, {
+      includeExtensions: options.extensions,
+      ignorePatterns: options.ignorePatterns,
+      maxFileBytes: options.maxFileBytes,
+      threadCount: options.threadCount ?? 0,
+    });
+    return scanned.map((file) => ({
+      path: file.relPath,
+      size: file.size,
+      mtime: file.mtimeMs,
+      inode: file.inode ?? 0,
+    }));
+  } catch (error) {
+    logger.warn("Native repository scan failed; using TypeScript walker", {
+      repoRoot,
+      error: error instanceof Error ? error.message : String(error),
+    });
+    return null;
+  }
+}
+
+export interface RustFileHash {
+  /** Fast digest of the raw bytes; see `getRustContentFastHashAlgorithm`. */
+  contentFastHash?: string;
+  /** Raw-byte SHA-256. Absent when `contentFastHash` matched the known one. */
+  contentHash?: string;
+  error?: string;
+}
+
+/**
+ * Name of the fast digest `hashFilesRust` returns, or null when the addon
+ * has no native file hashing.
+ */
+export function getRustContentFastHashAlgorithm(): string | null {
+  const addon = loadRustNativeAddon();
+  if (
+    !addon ||
+    typeof addon.hashFilesAsync !== "function" ||
+    typeof addon.contentFastHashAlgorithm !== "function"
+  ) {
+    return null;
+  }
+  return addon.contentFastHashAlgorithm();
+}
+
+/**
+ * Hash files' raw bytes on the native parse pool. Each result carries the
+ * fast digest, plus the SHA-256 unless the fast digest equals the file's
+ * `knownFastHash`. Results are in input order. Returns null when the addon
+ * or its hashing export is unavailable, or when the native call fails.
+ */
+export async function hashFilesRust(
+  files: Array<{ absolutePath: string; knownFastHash?: string }>,
+  threadCount = 0,
+): Promise<RustFileHash[] | null> {
+  const addon = loadRustNativeAddon();
+  if (!addon || typeof addon.hashFilesAsync !== "function") {
+    return null;
+  }
+
+  try {
+    const hashed = await addon.hashFilesAsync(files, threadCount);
+    return hashed.map((file) => ({
+      contentFastHash: file.contentFastHash ?? undefined,
+      contentHash: file.contentHash ?? undefined,
+      error: file.error ?? undefined,
+    }));
+  } catch (error) {
+    logger.warn("Native file hashing failed; hashing in TypeScript", {
+      files: files.length,
+      error: error instanceof Error ? error.message : String(error),
+    });
+    return null;
+  }
+}
+
+/**
+ * A buffer edit against the previously parsed content of the same draft.
+ * Offsets are UTF-8 byte offsets; edits apply in order.
+ */
+export type RustTextEdit = NativeTextEdit;
+
+export interface RustIncrementalParseResult {
+  file: RustParseResult;
+  /** Whether the previous tree for this draft was reused. */
+  reusedTree: boolean;
+  /** First/last changed line (1-indexed); 0 when nothing changed. */
+  changedStartLine: number;
+  changedEndLine: number;
+  /** Symbols whose enrichment was carried over from the previous parse. */
+  symbolsReused: number;
+  /** Symbols whose enrichment was recomputed. */
+  symbolsEnriched: number;
+  /** Symbols extracted from re-parsed declarations; the rest were carried over. */
+  symbolsExtracted: number;
+}
+
+/**
+ * Incrementally re-parse a live-index draft with the native engine.
+ *
+ * The addon keeps the previous tree-sitter tree per (repoId, relPath), applies
+ * the edit (explicit `edits`, or the prefix/suffix diff against the previous
+ * content), and re-parses with the old tree. Symbols are re-extracted only
+ * for top-level declarations the change touches, and enrichment is
+ * recomputed only for symbols whose source lines intersect the change.
+ *
+ * Returns null when the addon is unavailable, predates incremental parsing,
+ * or the language has no native extractor; callers fall back to a full TS
+ * parse.
+ */
+export async function parseDraftIncrementalRust(params: {
+  repoId: string;
+  relPath: string;
+  content: string;
+  edits?: RustTextEdit[];
+}): Promise<RustIncrementalParseResult | null> {
+  const addon = loadRustNativeAddon();
+  if (!addon?.parseFileIncrementalAsync) return null;
+
+  const ext = params.relPath.split(".").pop()?.toLowerCase() ?? "";
+  const language = extensionToLanguage(ext);
+  if (!supportsNativeExtractionLanguage(language)) return null;
+
+  let native: NativeIncrementalParseResult;
+  try {
+    native = await addon.parseFileIncrementalAsync({
+      repoId: params.repoId,
+      relPath: params.relPath,
+      language,
+      content: params.content,
+      ...(params.edits ? { edits: params.edits } : {}),
+    });
+  } catch (error) {
+    logger.warn("Native incremental draft parse failed; using TS parser", {
+      error: error instanceof Error ? error.message : String(error),
+      relPath: params.relPath,
+    });
+    return null;
+  }
+
+  return {
+    file: mapNativeResult(native.file),
+    reusedTree: native.reusedTree,
+    changedStartLine: native.changedStartLine,
+    changedEndLine: native.changedEndLine,
+    symbolsReused: native.symbolsReused,
+    symbolsEnriched: native.symbolsEnriched,
+    symbolsExtracted: native.symbolsExtracted ?? native.file.symbols.length,
+  };
+}
+
+/**
+ * Release native incremental-parse state for one draft, or for every draft
+ * of the repo when `relPath` is omitted.
+ */
+export function forgetDraftIncrementalParseRust(
+  repoId: string,
+  relPath?: string,
+): void {
+  const addon = loadRustNativeAddon();
+  addon?.forgetIncrementalParse?.(repoId, relPath ?? null);
+}
+
+export type RustParseEngineStatus = NativeParseEngineStatus;
+
+/**
+ * Size the native parse engine's persistent worker pool.
+ *
+ * The pool (and each worker's per-language tree-sitter parsers) lives for the
+ * whole process, so batches reuse warm threads. It is built at the native
+ * default (available cores minus one) on first use; the `threadCount` passed
+ * to a parse call only caps how many of its workers that batch uses. Calling
+ * this with a different `threadCount` resizes the pool; batches already in
+ * flight finish on the old one. `0` selects the native default.
+ *
+ * Returns null when the addon is unavailable or predates the parse engine.
+ */
+export function configureRustParseEngine(
+  threadCount: number = 0,
+): RustParseEngineStatus | null {
+  const addon = loadRustNativeAddon();
+  if (!addon?.configureParseEngine) return null;
+
+  try {
+    return addon.configureParseEngine(Math.max(0, Math.floor(threadCount)));
+  } catch (error) {
+    logger.warn("Native parse engine configuration failed", {
+      error: error instanceof Error ? error.message : String(error),
+      threadCount,
+    });
+    return null;
+  }
+}
+
+/**
+ * Size the native parse pool for `config`: `indexing.concurrency`, or the
+ * native default (cores minus one) when that is larger, so neither pass 1
+ * nor other callers are capped below what they ask for. Called at startup
+ * and whenever a changed config is loaded, never per index run. Returns
+ * null when the TypeScript engine is configured or the addon is missing.
+ */
+export function configureRustParseEngineForConfig(
+  config: Pick<AppConfig, "indexing">,
+): RustParseEngineStatus | null {
+  if (config.indexing?.engine === "typescript") return null;
+  const concurrency =
+    config.indexing?.concurrency ?? DEFAULT_INDEXING_CONCURRENCY;
+  return configureRustParseEngine(
+    Math.max(concurrency, availableParallelism() - 1, 1),
+  );
+}
+
+export type RustFingerprintMode = "native" | "ts-compat";
+
+/**
+ * AST fingerprint mode requested for the native engine. The default keeps
+ * the native engine's own fingerprints; SDL_MCP_NATIVE_FINGERPRINT_MODE=ts
+ * makes them byte-identical to `generateAstFingerprint` in fingerprints.ts,
+ * e.g. when one graph mixes native and TypeScript-parsed files.
+ */
+export function nativeFingerprintMode(
+  env: NodeJS.ProcessEnv = process.env,
+): RustFingerprintMode {
+  return /^(ts|ts-compat)$/i.test(
+    (env.SDL_MCP_NATIVE_FINGERPRINT_MODE ?? "").trim(),
+  )
+    ? "ts-compat"
+    : "native";
+}
+
+/**
+ * Apply `mode` to the native engine. The addon loader applies the
+ * environment's mode once on first load; call this only to change it.
+ * Returns false when the addon is unavailable or predates fingerprint modes
+ * (it then always uses "native").
+ */
+export function configureRustFingerprintMode(
+  mode: RustFingerprintMode = nativeFingerprintMode(),
+): boolean {
+  const addon = loadRustNativeAddon();
+  return addon ? applyRustFingerprintMode(addon, mode) : false;
+}
+
+function applyRustFingerprintMode(
+  addon: NativeAddon,
+  mode: RustFingerprintMode,
+): boolean {
+  if (!addon.setAstFingerprintMode) return false;
+
+  try {
+    addon.setAstFingerprintMode(mode);
+    return true;
+  } catch (error) {
+    logger.warn("Native fingerprint mode configuration failed", {
+      error: error instanceof Error ? error.message : String(error),
+      mode,
+    });
+    return false;
+  }
+}
+
+/**
+ * Current native parse engine configuration and lifetime counters, or null
+ * when the addon is unavailable or predates the parse engine.
+ */
+export function getRustParseEngineStatus(): RustParseEngineStatus | null {
+  const addon = loadRustNativeAddon();
+  if (!addon?.parseEngineStatus) return null;
+  return addon.parseEngineStatus();
+}
+
+/**
+ * Release the native parse engine's worker pool. Registered as a server
+ * shutdown cleanup; a parse call after it rebuilds the pool on demand.
+ */
+export function shutdownRustParseEngine(): void {
+  const addon = loadRustNativeAddon();
+  addon?.shutdownParseEngine?.();
+}
+
 /**
  * Hash content using the native Rust engine (for parity testing).
  */
@@ -640,6 +1443,357 @@ export function computePersonalizedPageRankRust(
 }
 
 
+/**
+ * CSR variant of {@link computePersonalizedPageRankRust}: the typed arrays
+ * are handed to the addon as-is. Falls back to the row-list export on addon
+ * builds that predate `computePersonalizedPagerankCsr`.
+ */
+export function computePersonalizedPageRankCsrRust(
+  adjacency: {
+    offsets: Uint32Array;
+    neighbors: Uint32Array;
+    weights: Float64Array;
+  },
+  seeds: Array<[number, number]>,
+  alpha: number,
+  epsilon: number,
+  maxNodesTouched: number,
+): Array<[number, number]> | null {
+  const addon = loadRustNativeAddon();
+  if (!addon?.computePersonalizedPagerankCsr) {
+    if (!addon?.computePersonalizedPagerank) return null;
+    const { offsets, neighbors, weights } = adjacency;
+    const rows: Array<Array<[number, number]>> = [];
+    for (let u = 0; u + 1 < offsets.length; u++) {
+      const row: Array<[number, number]> = [];
+      for (let e = offsets[u]; e < offsets[u + 1]; e++) {
+        row.push([neighbors[e], weights[e]]);
+      }
+      rows.push(row);
+    }
+    return computePersonalizedPageRankRust(
+      rows,
+      seeds,
+      alpha,
+      epsilon,
+      maxNodesTouched,
+    );
+  }
+
+  try {
+    const result = addon.computePersonalizedPagerankCsr(
+      adjacency.offsets,
+      adjacency.neighbors,
+      adjacency.weights,
+      seeds.map(([node, weight]) => ({ node, weight })),
+      alpha,
+      epsilon,
+      maxNodesTouched,
+    );
+    return result.map((s) => [s.node, s.score]);
+  } catch (error) {
+    logger.error(
+      "Native Rust personalized PageRank failed; falling back to TypeScript",
+      { error: error instanceof Error ? error.message : String(error) },
+    );
+    return null;
+  }
+}
+
+/**
+ * Unit-seed PPR vectors (seed weight 1) for each of `seedNodes`, computed in
+ * one native batch. Each vector is a view into the batch's shared arrays,
+ * sorted by node. Returns null when the addon lacks the batch export or the
+ * call throws.
+ */
+export function computePersonalizedPageRankCsrBatchRust(
+  adjacency: {
+    offsets: Uint32Array;
+    neighbors: Uint32Array;
+    weights: Float64Array;
+  },
+  seedNodes: number[],
+  alpha: number,
+  epsilon: number,
+  maxNodesTouched: number,
+): Array<{ nodes: Uint32Array; scores: Float64Array }> | null {
+  const addon = loadRustNativeAddon();
+  if (!addon?.computePersonalizedPagerankCsrBatch) return null;
+
+  try {
+    const batch = addon.computePersonalizedPagerankCsrBatch(
+      adjacency.offsets,
+      adjacency.neighbors,
+      adjacency.weights,
+      Uint32Array.from(seedNodes),
+      alpha,
+      epsilon,
+      maxNodesTouched,
+    );
+    if (batch.offsets.length !== seedNodes.length + 1) {
+      throw new Error(
+        `PPR batch has ${batch.offsets.length - 1} vectors for ${seedNodes.length} seeds`,
+      );
+    }
+    return seedNodes.map((_, i) => {
+      const start = batch.offsets[i];
+      const end = batch.offsets[i + 1];
+      return {
+        nodes: batch.nodes.subarray(start, end),
+        scores: batch.scores.subarray(start, end),
+      };
+    });
+  } catch (error) {
+    logger.error(
+      "Native Rust batched personalized PageRank failed; falling back to TypeScript",
+      { error: error instanceof Error ? error.message : String(error) },
+    );
+    return null;
+  }
+}
+
+/** CSR community label for nodes outside every community. */
+export const UNCLUSTERED_LABEL = 0xffffffff;
+
+/** Communities larger than this are dropped, as in the native kernels. */
+const MAX_CLUSTER_SIZE = 250;
+
+/** Whether the addon exposes the CSR cluster and process-tracing kernels. */
+export function supportsRustCsrKernels(): boolean {
+  const addon = loadRustNativeAddon();
+  return Boolean(addon?.computeClustersCsr && addon?.traceProcessesCsr);
+}
+
+/**
+ * Label propagation over a CSR graph. Nodes flagged in `graph.external`
+ * never join a community. Cluster IDs and ordering match
+ * {@link computeClustersRust} for the same symbols and edges.
+ */
+export function computeClustersCsrRust(
+  graph: CsrGraph,
+  minClusterSize: number = 3,
+  edgeTypeMask: number = 0,
+): ClusterAssignment[] | null {
+  const addon = loadRustNativeAddon();
+  if (!addon?.computeClustersCsr) return null;
+
+  let labels: Uint32Array;
+  try {
+    labels = addon.computeClustersCsr(
+      graph.offsets,
+      graph.neighbors,
+      graph.edgeTypes,
+      edgeTypeMask,
+      graph.external ?? null,
+      minClusterSize,
+    );
+  } catch (error) {
+    logger.error(
+      "Native Rust cluster detection failed; falling back to TypeScript",
+      { error: error instanceof Error ? error.message : String(error) },
+    );
+    return null;
+  }
+  return clusterAssignmentsFromLabels(graph, labels, minClusterSize);
+}
+
+/** Earlier community labels for {@link computeCommunitiesCsrRust}. */
+export interface PreviousCommunities {
+  /** Per-node key of the node's previous community, or `UNCLUSTERED_LABEL`. */
+  groups: Uint32Array;
+  /** Per-node flag (1) for nodes whose edges changed since that run. */
+  changed: Uint8Array;
+}
+
+/**
+ * Parallel label propagation over a CSR graph, returning raw per-node
+ * community labels (the lowest node of each connected community, or
+ * `UNCLUSTERED_LABEL`) before size bounds. With `previous`, only the changed
+ * nodes' neighborhood is relabelled; the result can seed the next call.
+ * Returns null when the kernel is unavailable or fails.
+ */
+export function computeCommunitiesCsrRust(
+  graph: CsrGraph,
+  previous: PreviousCommunities | null = null,
+  edgeTypeMask: number = 0,
+): Uint32Array | null {
+  const addon = loadRustNativeAddon();
+  if (!addon?.computeCommunitiesCsr) return null;
+
+  try {
+    return addon.computeCommunitiesCsr(
+      graph.offsets,
+      graph.neighbors,
+      graph.edgeTypes,
+      edgeTypeMask,
+      graph.external ?? null,
+      previous?.groups ?? null,
+      previous?.changed ?? null,
+      100,
+    );
+  } catch (error) {
+    logger.error(
+      "Native Rust community detection failed; falling back to TypeScript",
+      { error: error instanceof Error ? error.message : String(error) },
+    );
+    return null;
+  }
+}
+
+/**
+ * Cluster assignments from per-node community labels. Communities outside
+ * `minClusterSize..=250` members are dropped; cluster IDs hash the sorted
+ * member symbol IDs, and assignments come out in symbol ID order.
+ */
+export function clusterAssignmentsFromLabels(
+  graph: CsrGraph,
+  labels: Uint32Array,
+  minClusterSize: number = 3,
+): ClusterAssignment[] {
+  // Nodes are in sorted symbol ID order, so members come out sorted.
+  const membersByLabel = new Map<number, string[]>();
+  for (let node = 0; node < labels.length; node++) {
+    const label = labels[node];
+    if (label === UNCLUSTERED_LABEL) continue;
+    const members = membersByLabel.get(label);
+    if (members) members.push(graph.symbolIds[node]);
+    else membersByLabel.set(label, [graph.symbolIds[node]]);
+  }
+
+  const assignments: ClusterAssignment[] = [];
+  for (const members of membersByLabel.values()) {
+    if (members.length < minClusterSize || members.length > MAX_CLUSTER_SIZE) {
+      continue;
+    }
+    const clusterId = hashContent(`cluster:${members.join("|")}`);
+    for (const symbolId of members) {
+      assignments.push({ symbolId, clusterId, membershipScore: 1.0 });
+    }
+  }
+  assignments.sort((a, b) =>
+    a.symbolId < b.symbolId ? -1 : a.symbolId > b.symbolId ? 1 : 0,
+  );
+  return assignments;
+}
+
+/** Whether the addon exposes the native centrality kernel. */
+export function supportsRustCentrality(): boolean {
+  return Boolean(loadRustNativeAddon()?.computeCentralityCsr);
+}
+
+export interface RustCentralityOptions {
+  pageRank: boolean;
+  kCore: boolean;
+  /** Power iterations (default 20, as in `computePageRank`). */
+  maxIterations?: number;
+  damping?: number;
+  /** L1 change below which PageRank stops early (default 0: never). */
+  tolerance?: number;
+}
+
+export interface RustCentralityResult {
+  /** PageRank per CSR node; empty when disabled. */
+  pageRank: Float64Array;
+  /** Core number per CSR node; empty when disabled. */
+  kCore: Uint32Array;
+  pageRankIterations: number;
+}
+
+/**
+ * Global PageRank and k-core over a directed CSR call graph, computed on the
+ * libuv thread pool. `previousPageRank` (one score per node, NaN where
+ * unknown) warm-starts the power iteration. Resolves to null when the
+ * kernel is unavailable or fails.
+ */
+export async function computeCentralityCsrRust(
+  graph: CsrGraph,
+  options: RustCentralityOptions,
+  previousPageRank: Float64Array | null = null,
+): Promise<RustCentralityResult | null> {
+  const addon = loadRustNativeAddon();
+  if (!addon?.computeCentralityCsr) return null;
+
+  try {
+    return await addon.computeCentralityCsr(
+      graph.offsets,
+      graph.neighbors,
+      previousPageRank,
+      {
+        pageRank: options.pageRank,
+        kCore: options.kCore,
+        maxIterations: options.maxIterations ?? 20,
+        damping: options.damping ?? 0.85,
+        tolerance: options.tolerance ?? 0,
+      },
+    );
+  } catch (error) {
+    logger.error(
+      "Native Rust centrality failed; falling back to TypeScript",
+      { error: error instanceof Error ? error.message : String(error) },
+    );
+    return null;
+  }
+}
+
+/**
+ * Trace processes from `entrySymbolIds` over a CSR call graph. Callees are
+ * visited in symbol ID order, as in `traceProcessesTS`.
+ */
+export function traceProcessesCsrRust(
+  graph: CsrGraph,
+  entrySymbolIds: readonly string[],
+  maxDepth: number = 20,
+  edgeTypeMask: number = 0,
+): ProcessTrace[] | null {
+  const addon = loadRustNativeAddon();
+  if (!addon?.traceProcessesCsr) return null;
+
+  const entries: string[] = [];
+  const entryNodes: number[] = [];
+  for (const symbolId of entrySymbolIds) {
+    const node = graph.nodeOf(symbolId);
+    if (node === undefined) continue;
+    entries.push(symbolId);
+    entryNodes.push(node);
+  }
+
+  let traces: NativeCsrProcessTraces;
+  try {
+    traces = addon.traceProcessesCsr(
+      graph.offsets,
+      graph.neighbors,
+      graph.edgeTypes,
+      edgeTypeMask,
+      Uint32Array.from(entryNodes),
+      maxDepth,
+    );
+  } catch (error) {
+    logger.error(
+      "Native Rust process tracing failed; falling back to TypeScript",
+      { error: error instanceof Error ? error.message : String(error) },
+    );
+    return null;
+  }
+
+  return entries.map((entrySymbolId, index) => {
+    const start = traces.stepOffsets[index];
+    const end = traces.stepOffsets[index + 1];
+    const steps = [];
+    for (let at = start; at < end; at++) {
+      steps.push({
+        symbolId: graph.symbolIds[traces.steps[at]],
+        stepOrder: at - start,
+      });
+    }
+    return {
+      processId: hashContent(`process:${entrySymbolId}`),
+      entrySymbolId,
+      steps,
+      depth: traces.depths[index],
+    };
+  });
+}
+
 export function traceProcessesRust(
   symbols: NativeProcessSymbol[],
   callEdges: NativeProcessCallEdge[],
@@ -662,6 +1816,111 @@ export function traceProcessesRust(
   }
 }
 
+/** Whether the addon can build and open native embedding indexes. */
+export function supportsRustEmbeddingIndex(): boolean {
+  const addon = loadRustNativeAddon();
+  return Boolean(addon?.buildEmbeddingIndex && addon.openEmbeddingIndex);
+}
+
+/**
+ * Quantise `vectors` (`dimension` floats per symbol) into an IVF index file
+ * at `path` on the libuv thread pool. Resolves to the row count, or null
+ * when the addon lacks the index or the build fails.
+ */
+export async function buildEmbeddingIndexRust(
+  path: string,
+  dimension: number,
+  symbolIds: string[],
+  vectors: Float32Array,
+  options: { lists?: number; iterations?: number } | null = null,
+): Promise<number | null> {
+  const addon = loadRustNativeAddon();
+  if (!addon?.buildEmbeddingIndex) return null;
+
+  try {
+    return await addon.buildEmbeddingIndex(
+      path,
+      dimension,
+      symbolIds,
+      vectors,
+      options,
+    );
+  } catch (error) {
+    logger.error("Native Rust embedding index build failed", {
+      error: error instanceof Error ? error.message : String(error),
+    });
+    return null;
+  }
+}
+
+/** Open an index written by `buildEmbeddingIndexRust`, or null. */
+export function openEmbeddingIndexRust(
+  path: string,
+): RustEmbeddingIndex | null {
+  const addon = loadRustNativeAddon();
+  if (!addon?.openEmbeddingIndex) return null;
+
+  try {
+    return addon.openEmbeddingIndex(path);
+  } catch (error) {
+    logger.warn("Native Rust embedding index could not be opened", {
+      path,
+      error: error instanceof Error ? error.message : String(error),
+    });
+    return null;
+  }
+}
+
+/** Whether the addon can build native lexical indexes. */
+export function supportsRustLexicalIndex(): boolean {
+  return Boolean(loadRustNativeAddon()?.lexicalIndexBuild);
+}
+
+/**
+ * Index `names[i]` and `searchTexts[i]` under `symbolIds[i]`, or null when
+ * the addon lacks the index or the build fails.
+ */
+export function buildLexicalIndexRust(
+  symbolIds: string[],
+  names: string[],
+  searchTexts: string[],
+): RustLexicalIndex | null {
+  const addon = loadRustNativeAddon();
+  if (!addon?.lexicalIndexBuild) return null;
+
+  try {
+    return addon.lexicalIndexBuild(symbolIds, names, searchTexts);
+  } catch (error) {
+    logger.error("Native Rust lexical index build failed", {
+      error: error instanceof Error ? error.message : String(error),
+    });
+    return null;
+  }
+}
+
+/** Whether the addon can run the slice beam search. */
+export function supportsRustSliceBeamSearch(): boolean {
+  return Boolean(loadRustNativeAddon()?.sliceGraphBuild);
+}
+
+/** Hand a packed snapshot to the addon, or null when it cannot take it. */
+export function buildSliceGraphRust(
+  input: RustSliceGraphInput,
+): RustSliceGraph | null {
+  const addon = loadRustNativeAddon();
+  if (!addon?.sliceGraphBuild) return null;
+
+  try {
+    return addon.sliceGraphBuild(input);
+  } catch (error) {
+    logger.error(
+      "Native Rust slice graph build failed; falling back to TypeScript",
+      { error: error instanceof Error ? error.message : String(error) },
+    );
+    return null;
+  }
+}
+
 // --- Type mapping ---
 
 function mapNativeResult(native: NativeParsedFile): RustParseResult {
@@ -676,6 +1935,59 @@ function mapNativeResult(native: NativeParsedFile): RustParseResult {
   };
 }
 
+/**
+ * Map a packed batch. Symbols stay in the shared buffer and are decoded per
+ * file on first access of `symbols`.
+ */
+function mapNativePackedBatch(
+  batch: NativePackedParseBatch,
+): RustParseResult[] {
+  const reader = new PackedSymbolReader(batch.symbols);
+  if (batch.symbolCounts.length !== batch.files.length) {
+    throw new Error(
+      `Packed batch has ${batch.symbolCounts.length} symbol counts for ${batch.files.length} files`,
+    );
+  }
+  const total = batch.symbolCounts.reduce((sum, count) => sum + count, 0);
+  if (total !== reader.symbolCount) {
+    throw new Error(
+      `Packed batch symbol counts sum to ${total}, buffer holds ${reader.symbolCount}`,
+    );
+  }
+
+  let start = 0;
+  return batch.files.map((native, index) => {
+    const count = batch.symbolCounts[index];
+    const result = mapPackedFile(native, reader, start, count);
+    start += count;
+    return result;
+  });
+}
+
+function mapPackedFile(
+  native: NativeParsedFile,
+  reader: PackedSymbolReader,
+  start: number,
+  count: number,
+): RustParseResult {
+  let symbols: RustExtractedSymbol[] | undefined;
+  return {
+    relPath: native.relPath,
+    contentHash: native.contentHash,
+    content: native.content,
+    get symbols(): RustExtractedSymbol[] {
+      symbols ??= reader.decode(start, count);
+      return symbols;
+    },
+    set symbols(value: RustExtractedSymbol[]) {
+      symbols = value;
+    },
+    imports: native.imports.map(mapNativeImport),
+    calls: native.calls.map(mapNativeCall),
+    parseError: native.parseError,
+  };
+}
+
 function mapNativeSymbol(sym: NativeParsedSymbol): RustExtractedSymbol {
   return {
     // Phase 1 Task 1.2: Rust now emits a stable per-file nodeId
@@ -2,7 +2,13 @@ import type { RepoConfig } from "../config/types.js";
 import { getLadybugConn, withWriteConn } from "../db/ladybug.js";
 import * as ladybugDb from "../db/ladybug-queries.js";
 
-import { scanRepository, type ScannedFileMetadata } from "./fileScanner.js";
+import {
+  scanRepository,
+  type KnownFileHashes,
+  type ScannedFileMetadata,
+} from "./fileScanner.js";
+import { openParseCache } from "./parse-cache.js";
+import { getRustContentFastHashAlgorithm } from "./rustIndexer.js";
 import type { IndexProgress } from "./indexer.js";
 
 export interface ScanRepoForIndexResult {
@@ -19,6 +25,14 @@ export function isScannedFileChanged(
   existing?: ladybugDb.FileRow,
 ): boolean {
   if (!existing?.lastIndexedAt) return true;
+  // Rows write their fast digest together with contentHash, so a matching
+  // digest vouches for the stored SHA-256 as well.
+  if (
+    existing.contentFastHash &&
+    existing.contentFastHash === file.contentFastHash
+  ) {
+    return false;
+  }
   if (existing.contentHash && existing.contentHash === file.contentHash) {
     return false;
   }
@@ -30,6 +44,50 @@ export function isScannedFileChanged(
   return !Number.isFinite(lastIndexedMs) || file.mtime > lastIndexedMs;
 }
 
+/**
+ * Store the fast digest of every scanned file whose SHA-256 still matches
+ * its row but whose stored digest is missing or stale, so the next scan can
+ * confirm it unchanged without SHA-256. Changed files get theirs when pass 1
+ * rewrites the row.
+ */
+async function recordUnchangedFileFastHashes(params: {
+  repoId: string;
+  algorithm: string;
+  algorithmChanged: boolean;
+  files: readonly ScannedFileMetadata[];
+  existingByPath: ReadonlyMap<string, ladybugDb.FileRow>;
+}): Promise<void> {
+  const rows: Array<{
+    fileId: string;
+    contentHash: string;
+    contentFastHash: string;
+  }> = [];
+  for (const file of params.files) {
+    const existing = params.existingByPath.get(file.path);
+    if (
+      file.contentFastHash &&
+      existing?.contentHash === file.contentHash &&
+      existing.contentFastHash !== file.contentFastHash
+    ) {
+      rows.push({
+        fileId: existing.fileId,
+        contentHash: file.contentHash,
+        contentFastHash: file.contentFastHash,
+      });
+    }
+  }
+  if (rows.length === 0 && !params.algorithmChanged) return;
+
+  await withWriteConn(async (wConn) => {
+    await ladybugDb.recordFileContentFastHashes(
+      wConn,
+      params.repoId,
+      params.algorithm,
+      rows,
+    );
+  });
+}
+
 export async function scanRepoForIndex(params: {
   repoId: string;
   repoRoot: string;
@@ -46,8 +104,6 @@ export async function scanRepoForIndex(params: {
   } = params;
 
   onProgress?.({ stage: "scanning", current: 0, total: 0 });
-  const files = await scanRepository(repoRoot, config);
-
   const conn = await getLadybugConn();
   const existingFiles = await ladybugDb.getFilesByRepo(conn, repoId);
 
@@ -57,6 +113,44 @@ export async function scanRepoForIndex(params: {
     existingFiles.map((file) => [file.relPath, file]),
   );
 
+  // Stored fast digests are only comparable when they were written with the
+  // algorithm the loaded addon produces.
+  const fastHashAlgorithm = getRustContentFastHashAlgorithm();
+  const storedAlgorithm = fastHashAlgorithm
+    ? await ladybugDb.getRepoContentFastHashAlgorithm(conn, repoId)
+    : null;
+  const trustFastHashes =
+    fastHashAlgorithm !== null && storedAlgorithm === fastHashAlgorithm;
+  const knownHashes = new Map<string, KnownFileHashes>();
+  for (const file of existingFiles) {
+    if (!file.contentHash) continue;
+    knownHashes.set(file.relPath, {
+      contentHash: file.contentHash,
+      contentFastHash:
+        (trustFastHashes && file.contentFastHash) || undefined,
+    });
+  }
+
+  const parseCache = await openParseCache(repoId);
+  const files = await scanRepository(repoRoot, config, {
+    parseCache,
+    knownHashes,
+  });
+  if (parseCache) {
+    parseCache.retain(new Set(files.map((file) => file.path)));
+    await parseCache.flush();
+  }
+
+  if (fastHashAlgorithm) {
+    await recordUnchangedFileFastHashes({
+      repoId,
+      algorithm: fastHashAlgorithm,
+      algorithmChanged: storedAlgorithm !== fastHashAlgorithm,
+      files,
+      existingByPath,
+    });
+  }
+
   const scannedPaths = new Set(files.map((file) => file.path));
   const removedFileIds: string[] = [];
   let removedFiles = 0;
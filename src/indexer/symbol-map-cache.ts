@@ -6,6 +6,7 @@ import type { SymbolKind } from "../domain/types.js";
 import { normalizePath } from "../util/paths.js";
 import { addToSymbolIndex } from "./edge-builder.js";
 import type { SymbolIndex } from "./edge-builder.js";
+import { PackedSymbolTable } from "./packed-symbol-table.js";
 
 export interface SymbolMapFileUpdate {
   fileId: string;
@@ -13,14 +14,114 @@ export interface SymbolMapFileUpdate {
   symbols: ladybugDb.SymbolLiteRow[];
 }
 
+/**
+ * Pass-1/pass-2 symbol lookups for one repo. The name and file maps are
+ * read-only views over one {@link PackedSymbolTable}; lookups return fresh
+ * arrays, so callers may keep or sort them.
+ */
 export interface SymbolMapCache {
   repoId: string;
-  symbolsByFileId: Map<string, ladybugDb.SymbolLiteRow[]>;
+  symbols: PackedSymbolTable;
+  symbolsByFileId: ReadonlyMap<string, ladybugDb.SymbolLiteRow[]>;
   filePathById: Map<string, string>;
-  allSymbolsByName: Map<string, ladybugDb.SymbolLiteRow[]>;
-  globalNameToSymbolIds: Map<string, string[]>;
-  globalPreferredSymbolId: Map<string, string>;
-  symbolIndex: SymbolIndex;
+  allSymbolsByName: ReadonlyMap<string, ladybugDb.SymbolLiteRow[]>;
+  globalNameToSymbolIds: ReadonlyMap<string, string[]>;
+  globalPreferredSymbolId: ReadonlyMap<string, string>;
+  /** Per-file symbol index over the live rows, built on each access. */
+  readonly symbolIndex: SymbolIndex;
+}
+
+/**
+ * A read-only Map over a packed lookup. Point lookups go straight to the
+ * table; iteration (not used on hot paths) snapshots into a real Map.
+ */
+class PackedLookupView<V> implements ReadonlyMap<string, V> {
+  constructor(
+    private readonly lookup: (key: string) => V | undefined,
+    private readonly snapshot: () => Map<string, V>,
+  ) {}
+
+  get(key: string): V | undefined {
+    return this.lookup(key);
+  }
+
+  has(key: string): boolean {
+    return this.lookup(key) !== undefined;
+  }
+
+  get size(): number {
+    return this.snapshot().size;
+  }
+
+  forEach(
+    callbackfn: (value: V, key: string, map: ReadonlyMap<string, V>) => void,
+    thisArg?: unknown,
+  ): void {
+    this.snapshot().forEach((value, key) =>
+      callbackfn.call(thisArg, value, key, this),
+    );
+  }
+
+  entries(): MapIterator<[string, V]> {
+    return this.snapshot().entries();
+  }
+
+  keys(): MapIterator<string> {
+    return this.snapshot().keys();
+  }
+
+  values(): MapIterator<V> {
+    return this.snapshot().values();
+  }
+
+  [Symbol.iterator](): MapIterator<[string, V]> {
+    return this.entries();
+  }
+}
+
+function nameSnapshot<V>(
+  table: PackedSymbolTable,
+  lookup: (name: string) => V | undefined,
+): Map<string, V> {
+  const snapshot = new Map<string, V>();
+  for (const name of table.liveNames()) {
+    const value = lookup(name);
+    if (value !== undefined) snapshot.set(name, value);
+  }
+  return snapshot;
+}
+
+function createSymbolMapCache(
+  repoId: string,
+  filePathById: Map<string, string>,
+): SymbolMapCache {
+  const table = new PackedSymbolTable();
+  const named = (name: string) => table.symbolsNamed(name);
+  const idsNamed = (name: string) => table.symbolIdsNamed(name);
+  const preferred = (name: string) => table.preferredSymbolIdNamed(name);
+  return {
+    repoId,
+    symbols: table,
+    symbolsByFileId: new PackedLookupView(
+      (fileId) => table.symbolsOfFile(fileId),
+      () => new Map(table.files()),
+    ),
+    filePathById,
+    allSymbolsByName: new PackedLookupView(named, () =>
+      nameSnapshot(table, named),
+    ),
+    globalNameToSymbolIds: new PackedLookupView(idsNamed, () =>
+      nameSnapshot(table, idsNamed),
+    ),
+    globalPreferredSymbolId: new PackedLookupView(preferred, () =>
+      nameSnapshot(table, preferred),
+    ),
+    get symbolIndex(): SymbolIndex {
+      const index: SymbolIndex = new Map();
+      buildSymbolIndex(this, index);
+      return index;
+    },
+  };
 }
 
 const symbolMapCacheByRepo = new Map<string, SymbolMapCache>();
@@ -53,23 +154,13 @@ export function buildSymbolMapCacheFromRows(params: {
   symbols: ladybugDb.SymbolLiteRow[];
 }): SymbolMapCache {
   const { repoId, files, symbols } = params;
-  const cache: SymbolMapCache = {
-    repoId,
-    symbolsByFileId: new Map(),
-    filePathById: new Map(),
-    allSymbolsByName: new Map(),
-    globalNameToSymbolIds: new Map(),
-    globalPreferredSymbolId: new Map(),
-    symbolIndex: new Map(),
-  };
-
+  const filePathById = new Map<string, string>();
   for (const file of files) {
-    cache.filePathById.set(file.fileId, normalizePath(file.relPath));
+    filePathById.set(file.fileId, normalizePath(file.relPath));
   }
 
-  for (const symbol of symbols) {
-    addSymbolToCache(cache, symbol);
-  }
+  const cache = createSymbolMapCache(repoId, filePathById);
+  cache.symbols.addAll(symbols);
 
   symbolMapCacheByRepo.set(repoId, cache);
   return cache;
@@ -90,33 +181,13 @@ export function applySymbolMapFileUpdates(
 ): void {
   for (const update of updates) {
     removeFileFromCache(cache, update.fileId);
-
-    const relPath = normalizePath(update.relPath);
-    const nextSymbols = update.symbols.map((symbol) => ({
-      ...symbol,
-      fileId: update.fileId,
-      repoId: cache.repoId,
-    }));
-
-    cache.filePathById.set(update.fileId, relPath);
-
-    const fileIndex: SymbolIndex = new Map();
-    for (const symbol of nextSymbols) {
-      addSymbolToCache(cache, symbol);
-      addToSymbolIndex(
-        fileIndex,
-        relPath,
-        symbol.symbolId,
-        symbol.name,
-        symbol.kind as SymbolKind,
-      );
-    }
-
-    if (fileIndex.size > 0) {
-      const entry = fileIndex.get(relPath);
-      if (entry) {
-        cache.symbolIndex.set(relPath, entry);
-      }
+    cache.filePathById.set(update.fileId, normalizePath(update.relPath));
+    for (const symbol of update.symbols) {
+      cache.symbols.add({
+        ...symbol,
+        fileId: update.fileId,
+        repoId: cache.repoId,
+      });
     }
   }
 }
@@ -126,9 +197,7 @@ export function syncSymbolIndexFromCache(
   symbolIndex: SymbolIndex,
 ): void {
   symbolIndex.clear();
-  for (const [filePath, symbolsByName] of cache.symbolIndex) {
-    symbolIndex.set(filePath, symbolsByName);
-  }
+  buildSymbolIndex(cache, symbolIndex);
 }
 
 export function clearSymbolMapCache(repoId?: string): void {
@@ -139,97 +208,35 @@ export function clearSymbolMapCache(repoId?: string): void {
   symbolMapCacheByRepo.clear();
 }
 
-function addSymbolToCache(
-  cache: SymbolMapCache,
-  symbol: ladybugDb.SymbolLiteRow,
-): void {
-  const byFile = cache.symbolsByFileId.get(symbol.fileId) ?? [];
-  byFile.push(symbol);
-  cache.symbolsByFileId.set(symbol.fileId, byFile);
-
-  const byName = cache.allSymbolsByName.get(symbol.name) ?? [];
-  byName.push(symbol);
-  cache.allSymbolsByName.set(symbol.name, byName);
-
-  const symbolIds = cache.globalNameToSymbolIds.get(symbol.name) ?? [];
-  insertSortedUnique(symbolIds, symbol.symbolId);
-  cache.globalNameToSymbolIds.set(symbol.name, symbolIds);
-
-  const filePath = cache.filePathById.get(symbol.fileId);
-  if (filePath) {
-    addToSymbolIndex(
-      cache.symbolIndex,
-      filePath,
-      symbol.symbolId,
-      symbol.name,
-      symbol.kind as SymbolKind,
-    );
+/**
+ * Drop `cache`'s rows and file paths and forget it, so its memory can be
+ * reclaimed while the caller still holds the views.
+ */
+export function releaseSymbolMapCache(cache: SymbolMapCache): void {
+  cache.symbols.clear();
+  cache.filePathById.clear();
+  if (symbolMapCacheByRepo.get(cache.repoId) === cache) {
+    symbolMapCacheByRepo.delete(cache.repoId);
   }
-
-  updatePreferredSymbolForName(cache, symbol.name);
 }
 
-function removeFileFromCache(cache: SymbolMapCache, fileId: string): void {
-  const previousSymbols = cache.symbolsByFileId.get(fileId);
-  if (previousSymbols) {
-    for (const symbol of previousSymbols) {
-      const byName = cache.allSymbolsByName.get(symbol.name);
-      if (byName) {
-        const remainingByName = byName.filter(
-          (candidate) => candidate.symbolId !== symbol.symbolId,
-        );
-        if (remainingByName.length === 0) {
-          cache.allSymbolsByName.delete(symbol.name);
-        } else {
-          cache.allSymbolsByName.set(symbol.name, remainingByName);
-        }
-      }
-
-      const symbolIds = cache.globalNameToSymbolIds.get(symbol.name);
-      if (symbolIds) {
-        const remainingIds = symbolIds.filter((id) => id !== symbol.symbolId);
-        if (remainingIds.length === 0) {
-          cache.globalNameToSymbolIds.delete(symbol.name);
-        } else {
-          cache.globalNameToSymbolIds.set(symbol.name, remainingIds);
-        }
-      }
-
-      updatePreferredSymbolForName(cache, symbol.name);
+function buildSymbolIndex(cache: SymbolMapCache, index: SymbolIndex): void {
+  for (const [fileId, symbols] of cache.symbols.files()) {
+    const filePath = cache.filePathById.get(fileId);
+    if (!filePath) continue;
+    for (const symbol of symbols) {
+      addToSymbolIndex(
+        index,
+        filePath,
+        symbol.symbolId,
+        symbol.name,
+        symbol.kind as SymbolKind,
+      );
     }
-    cache.symbolsByFileId.delete(fileId);
-  }
-
-  const filePath = cache.filePathById.get(fileId);
-  if (filePath) {
-    cache.symbolIndex.delete(filePath);
-    cache.filePathById.delete(fileId);
-  }
-}
-
-function insertSortedUnique(ids: string[], symbolId: string): void {
-  if (ids.includes(symbolId)) {
-    return;
   }
-  ids.push(symbolId);
-  ids.sort();
 }
 
-function updatePreferredSymbolForName(
-  cache: SymbolMapCache,
-  name: string,
-): void {
-  const candidates = cache.allSymbolsByName.get(name) ?? [];
-  if (candidates.length <= 1) {
-    cache.globalPreferredSymbolId.delete(name);
-    return;
-  }
-
-  const exportedCandidates = candidates.filter((symbol) => symbol.exported);
-  if (exportedCandidates.length === 1) {
-    cache.globalPreferredSymbolId.set(name, exportedCandidates[0].symbolId);
-    return;
-  }
-
-  cache.globalPreferredSymbolId.delete(name);
+function removeFileFromCache(cache: SymbolMapCache, fileId: string): void {
+  cache.symbols.removeFile(fileId);
+  cache.filePathById.delete(fileId);
 }
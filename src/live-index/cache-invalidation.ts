@@ -0,0 +1,47 @@
+import { invalidateSliceCacheForSymbols } from "../graph/sliceCache.js";
+import { invalidatePprCacheForSymbols } from "../retrieval/ppr.js";
+import { logger } from "../util/logger.js";
+
+import type { DependencyFrontier } from "./dependency-frontier.js";
+
+/**
+ * Symbols whose cached slices and PPR results a saved-file patch may have
+ * changed: the frontier's touched and dependent symbols plus `extra`, the
+ * persisted IDs of matched and removed symbols and the patch's edge
+ * targets. Placeholder (`unresolved:`) targets are never cached.
+ */
+export function changedSymbolIds(
+  frontier: DependencyFrontier,
+  extra: Iterable<string> = [],
+): string[] {
+  const ids = new Set<string>([
+    ...frontier.touchedSymbolIds,
+    ...frontier.dependentSymbolIds,
+  ]);
+  for (const id of extra) {
+    if (!id.startsWith("unresolved:")) ids.add(id);
+  }
+  return Array.from(ids).sort();
+}
+
+/**
+ * Evict only the cached slices and PPR results that include a changed
+ * symbol; entries for the rest of the repo stay warm across the edit.
+ */
+export function invalidateCachesForChangedSymbols(
+  repoId: string,
+  symbolIds: readonly string[],
+): { slices: number; ppr: number } {
+  const evicted = {
+    slices: invalidateSliceCacheForSymbols(repoId, symbolIds),
+    ppr: invalidatePprCacheForSymbols(repoId, symbolIds),
+  };
+  if (evicted.slices > 0 || evicted.ppr > 0) {
+    logger.debug("Delta cache invalidation", {
+      repoId,
+      changedSymbols: symbolIds.length,
+      ...evicted,
+    });
+  }
+  return evicted;
+}
@@ -18,6 +18,8 @@ import {
 import { IndexError, NotFoundError } from "../domain/errors.js";
 import { withIndexingGate } from "../mcp/indexing-gate.js";
 import { getOverlayEmbeddingCache } from "./overlay-embedding-cache.js";
+import { forgetDraftIncrementalParseRust } from "../indexer/rustIndexer.js";
+import { normalizePath } from "../util/paths.js";
 
 import { logger } from "../util/logger.js";
 import { withRepoMutation } from "../services/repo-lifecycle.js";
@@ -163,6 +165,10 @@ export class InMemoryLiveIndexCoordinator implements LiveIndexCoordinator {
         );
       }
       this.overlayStore.removeDraft(input.repoId, input.filePath);
+      forgetDraftIncrementalParseRust(
+        input.repoId,
+        normalizePath(input.filePath),
+      );
 
       // Re-index from the actual disk file to restore canonical index state.
       // Without this, a previous partial/garbage buffer push that was
@@ -378,6 +384,7 @@ export class InMemoryLiveIndexCoordinator implements LiveIndexCoordinator {
       this.parseScheduler.cancel(`${repoId}:${draft.filePath}`);
     }
     this.overlayStore.clearRepo(repoId);
+    forgetDraftIncrementalParseRust(repoId);
     this.checkpointService.clearRepo(repoId);
     this.reconcileWorker.clearRepo(repoId);
     this.repoRootCache.delete(repoId);
@@ -11,6 +11,7 @@ import {
   unresolvedCallDependencyTarget,
   unresolvedCallSymbolId,
 } from "../db/symbol-placeholders.js";
+import { loadConfig } from "../config/loadConfig.js";
 import { getAdapterForExtension } from "../indexer/adapter/registry.js";
 import { logger } from "../util/logger.js";
 import {
@@ -34,9 +35,18 @@ import {
   generateSummary,
 } from "../indexer/summaries.js";
 import type { SymbolWithNodeId } from "../indexer/worker.js";
+import {
+  parseDraftIncrementalRust,
+  type RustExtractedSymbol,
+  type RustIncrementalParseResult,
+  type RustTextEdit,
+} from "../indexer/rustIndexer.js";
 import { hashContent } from "../util/hashing.js";
 import { getAbsolutePathFromRepoRoot, normalizePath } from "../util/paths.js";
 
+/** A UTF-8 byte edit against the previously parsed content of a draft. */
+export type DraftTextEdit = RustTextEdit;
+
 export interface DraftParseInput {
   repoId: string;
   repoRoot: string;
@@ -45,6 +55,12 @@ export interface DraftParseInput {
   languages: string[];
   language?: string;
   version: number;
+  /**
+   * Edits turning the previously parsed content of this draft into
+   * `content`, when the caller knows them. The native parser checks them
+   * against its cached copy and otherwise diffs the two contents itself.
+   */
+  edits?: DraftTextEdit[];
 }
 
 export interface DraftParseResult {
@@ -83,6 +99,54 @@ function buildDurableSymbolMatchKey(params: {
   return `${params.kind}:${params.name}:${params.startLine}:${params.startCol}`;
 }
 
+/**
+ * Drafts follow the configured Pass-1 engine: with the Rust engine the
+ * native addon re-parses incrementally against the draft's previous tree.
+ * `loadConfig` is cached on the config file's mtime, so this costs a stat
+ * per draft and an engine change applies from the next draft on.
+ */
+function shouldUseNativeDraftParser(): boolean {
+  try {
+    return loadConfig().indexing?.engine !== "typescript";
+  } catch {
+    return true;
+  }
+}
+
+async function parseDraftNatively(
+  repoId: string,
+  relPath: string,
+  content: string,
+  edits: RustTextEdit[] | undefined,
+): Promise<RustIncrementalParseResult | null> {
+  if (!shouldUseNativeDraftParser()) return null;
+  const result = await parseDraftIncrementalRust({
+    repoId,
+    relPath,
+    content,
+    ...(edits ? { edits } : {}),
+  });
+  if (!result || result.file.parseError) return null;
+  logger.debug("Native incremental draft parse", {
+    relPath,
+    reusedTree: result.reusedTree,
+    changedStartLine: result.changedStartLine,
+    changedEndLine: result.changedEndLine,
+    symbolsReused: result.symbolsReused,
+    symbolsEnriched: result.symbolsEnriched,
+    symbolsExtracted: result.symbolsExtracted,
+  });
+  return result;
+}
+
+function nonEmptyJsonOrNull(json: string): string | null {
+  return json && json !== "[]" ? json : null;
+}
+
+function jsonArrayOrNull(values: string[]): string | null {
+  return values.length > 0 ? JSON.stringify(values) : null;
+}
+
 export async function parseDraftFile(
   input: DraftParseInput,
 ): Promise<DraftParseResult> {
@@ -143,8 +207,14 @@ export async function parseDraftFile(
   }
 
   const absolutePath = getAbsolutePathFromRepoRoot(input.repoRoot, relPath);
-  const tree = adapter.parse(input.content, absolutePath);
-  if (!tree) {
+  const nativeDraft = await parseDraftNatively(
+    input.repoId,
+    relPath,
+    input.content,
+    input.edits,
+  );
+  const tree = nativeDraft ? null : adapter.parse(input.content, absolutePath);
+  if (!nativeDraft && !tree) {
     return {
       version: input.version,
       file,
@@ -155,23 +225,43 @@ export async function parseDraftFile(
   }
 
   try {
-    let extractedSymbols: ReturnType<typeof adapter.extractSymbols> = [];
-    try {
-      extractedSymbols = adapter.extractSymbols(
-        tree,
-        input.content,
-        absolutePath,
-      );
-    } catch (error) {
-      logger.warn("Draft symbol extraction failed", {
-        file: absolutePath,
-        error: String(error),
-      });
-      extractedSymbols = [];
-    }
+    let symbolsWithNodeIds: SymbolWithNodeId[];
+    let imports: ReturnType<typeof adapter.extractImports>;
+    let calls: ReturnType<typeof adapter.extractCalls>;
+    const nativeSymbolsByNodeId = new Map<string, RustExtractedSymbol>();
+    if (nativeDraft) {
+      for (const symbol of nativeDraft.file.symbols) {
+        nativeSymbolsByNodeId.set(symbol.nodeId, symbol);
+      }
+      symbolsWithNodeIds = nativeDraft.file.symbols.map((symbol) => ({
+        nodeId: symbol.nodeId,
+        kind: symbol.kind,
+        name: symbol.name,
+        exported: symbol.exported,
+        range: symbol.range,
+        signature: symbol.signature,
+        visibility: symbol.visibility,
+        astFingerprint: symbol.astFingerprint,
+      }));
+      imports = nativeDraft.file.imports;
+      calls = nativeDraft.file.calls;
+    } else {
+      let extractedSymbols: ReturnType<typeof adapter.extractSymbols> = [];
+      try {
+        extractedSymbols = adapter.extractSymbols(
+          tree!,
+          input.content,
+          absolutePath,
+        );
+      } catch (error) {
+        logger.warn("Draft symbol extraction failed", {
+          file: absolutePath,
+          error: String(error),
+        });
+        extractedSymbols = [];
+      }
 
-    const symbolsWithNodeIds: SymbolWithNodeId[] = extractedSymbols.map(
-      (symbol) => ({
+      symbolsWithNodeIds = extractedSymbols.map((symbol) => ({
         nodeId: symbol.nodeId,
         kind: symbol.kind,
         name: symbol.name,
@@ -180,15 +270,15 @@ export async function parseDraftFile(
         signature: symbol.signature,
         visibility: symbol.visibility,
         astFingerprint: "",
-      }),
-    );
-    const imports = adapter.extractImports(tree, input.content, absolutePath);
-    const calls = adapter.extractCalls(
-      tree,
-      input.content,
-      absolutePath,
-      symbolsWithNodeIds,
-    );
+      }));
+      imports = adapter.extractImports(tree!, input.content, absolutePath);
+      calls = adapter.extractCalls(
+        tree!,
+        input.content,
+        absolutePath,
+        symbolsWithNodeIds,
+      );
+    }
 
     const importResolution =
       imports.length > 0
@@ -213,12 +303,14 @@ export async function parseDraftFile(
 
     const symbolDetails = symbolsWithNodeIds.map((extractedSymbol) => {
       let astFingerprint = extractedSymbol.astFingerprint ?? "";
-      const matchingNode = resolveSymbolNodeForFingerprint(tree, {
-        kind: extractedSymbol.kind,
-        name: extractedSymbol.name,
-        startLine: extractedSymbol.range.startLine,
-        startCol: extractedSymbol.range.startCol,
-      });
+      const matchingNode = tree
+        ? resolveSymbolNodeForFingerprint(tree, {
+            kind: extractedSymbol.kind,
+            name: extractedSymbol.name,
+            startLine: extractedSymbol.range.startLine,
+            startCol: extractedSymbol.range.startCol,
+          })
+        : null;
       if (matchingNode) {
         astFingerprint = generateAstFingerprint(matchingNode);
       }
@@ -260,9 +352,15 @@ export async function parseDraftFile(
 
     const symbols: SymbolRow[] = symbolDetails.map((detail) => {
       const extractedSymbol = detail.extractedSymbol;
-      const summary = generateSummary(extractedSymbol, input.content);
-      const invariants = extractInvariants(extractedSymbol, input.content);
-      const sideEffects = extractSideEffects(extractedSymbol, input.content);
+      const nativeSymbol = nativeSymbolsByNodeId.get(extractedSymbol.nodeId);
+      const summary =
+        nativeSymbol?.summary ?? generateSummary(extractedSymbol, input.content);
+      const invariantsJson = nativeSymbol
+        ? nonEmptyJsonOrNull(nativeSymbol.invariantsJson)
+        : jsonArrayOrNull(extractInvariants(extractedSymbol, input.content));
+      const sideEffectsJson = nativeSymbol
+        ? nonEmptyJsonOrNull(nativeSymbol.sideEffectsJson)
+        : jsonArrayOrNull(extractSideEffects(extractedSymbol, input.content));
       const { roleTagsJson, searchText } = resolveSymbolEnrichment({
         kind: extractedSymbol.kind,
         name: extractedSymbol.name,
@@ -289,10 +387,8 @@ export async function parseDraftFile(
           ? JSON.stringify(extractedSymbol.signature)
           : null,
         summary,
-        invariantsJson:
-          invariants.length > 0 ? JSON.stringify(invariants) : null,
-        sideEffectsJson:
-          sideEffects.length > 0 ? JSON.stringify(sideEffects) : null,
+        invariantsJson,
+        sideEffectsJson,
         roleTagsJson,
         searchText,
         updatedAt: timestamp,
@@ -33,13 +33,26 @@ import {
 import { withRepoWriteHeavyLock } from "../indexer/derived-refresh-queue.js";
 import { getLadybugConn, withWriteConn } from "../db/ladybug.js";
 import * as ladybugDb from "../db/ladybug-queries.js";
+import {
+  applyGraphSnapshotPatch,
+  scheduleGraphSnapshotFileRewrite,
+} from "../graph/graphSnapshotCache.js";
+import { patchLexicalIndex } from "../retrieval/lexical-index.js";
 import { readFileAsync } from "../util/asyncFs.js";
 import { getAbsolutePathFromRepoRoot, normalizePath } from "../util/paths.js";
 import {
   buildDependencyFrontier,
   type DependencyFrontier,
 } from "./dependency-frontier.js";
-import { parseDraftFile, type DraftParseResult } from "./draft-parser.js";
+import {
+  changedSymbolIds,
+  invalidateCachesForChangedSymbols,
+} from "./cache-invalidation.js";
+import {
+  parseDraftFile,
+  type DraftParseResult,
+  type DraftTextEdit,
+} from "./draft-parser.js";
 import { IndexError } from "../domain/errors.js";
 import { logger } from "../util/logger.js";
 import {
@@ -55,6 +68,8 @@ export interface SavedFilePatchRequest {
   language?: string;
   version?: number;
   parseResult?: DraftParseResult | null;
+  /** Edits that produced `content`, passed to the incremental draft parser. */
+  edits?: DraftTextEdit[];
 }
 
 export interface SavedFilePatchResult {
@@ -197,6 +212,7 @@ async function patchSavedFileUnlocked(
       languages: repoConfig.languages,
       language: request.language,
       version: request.version ?? 0,
+      edits: request.edits,
     }));
 
   const frontier = await buildDependencyFrontier({
@@ -522,6 +538,33 @@ async function patchSavedFileUnlocked(
     throw error;
   }
 
+  invalidateCachesForChangedSymbols(
+    request.repoId,
+    changedSymbolIds(frontier, [
+      ...diff.matched.map((match) => match.old.symbolId),
+      ...diff.removed.map((symbol) => symbol.symbolId),
+      ...parseResult.edges.map((edge) => edge.toSymbolId),
+    ]),
+  );
+  const patchedSymbols = expectedSymbols.filter(
+    (symbol) => !preservedIds.has(symbol.symbolId),
+  );
+  const removedSymbolIds = diff.removed.map((symbol) => symbol.symbolId);
+  applyGraphSnapshotPatch(request.repoId, {
+    file: durableFile,
+    symbols: patchedSymbols,
+    removedSymbolIds,
+    refreshedSymbolIds: diff.matched.map((match) => match.old.symbolId),
+    edges: expectedEdges,
+  });
+  patchLexicalIndex(request.repoId, {
+    symbols: patchedSymbols,
+    removedSymbolIds,
+  });
+  // The save did not create a version, so the persisted snapshot's version
+  // check would still accept the old file until it is rewritten.
+  await scheduleGraphSnapshotFileRewrite(request.repoId);
+
   if (committedRevision !== undefined) {
     try {
       observer?.onCommitted(committedRevision);
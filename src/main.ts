@@ -32,6 +32,9 @@ import {
 import { ensureConfiguredReposRegistered } from "./startup/bootstrap.js";
 import { recoverStaleDerivedStateOnStartup } from "./startup/derived-state-recovery.js";
 import { startPrefetchPolicy } from "./startup/prefetch-startup.js";
+import { startGraphSnapshotRestore } from "./startup/graph-snapshot-startup.js";
+import { configureNativeParseEngineOnStartup } from "./startup/native-engine-startup.js";
+import { shutdownRustParseEngine } from "./indexer/rustIndexer.js";
 import { loadConfiguredAdapterPlugins } from "./startup/plugins.js";
 import { installProcessHandlers } from "./startup/process-handlers.js";
 import { safeWriteStderr } from "./util/stdio-safety.js";
@@ -127,6 +130,7 @@ async function main(): Promise<void> {
   });
   shutdownMgr.addCleanup("graphIntegrityVerifier", stopGraphIntegrityVerifier);
   shutdownMgr.addCleanup("db", closeLadybugDbAfterDrainingWork);
+  shutdownMgr.addCleanup("parseEngine", shutdownRustParseEngine);
   shutdownMgr.addCleanup("logger", () => shutdownLogger());
 
   // Hoisted so the catch handler can clean up if startup fails after the pidfile is claimed.
@@ -136,6 +140,7 @@ async function main(): Promise<void> {
     log("Loading configuration...");
     const resolvedConfigPath = activateCliConfigPath(process.env.SDL_CONFIG);
     const config = loadConfig(resolvedConfigPath);
+    configureNativeParseEngineOnStartup(config);
 
     const graphDbPath = resolveGraphDbPath(config, resolvedConfigPath);
 
@@ -159,6 +164,7 @@ async function main(): Promise<void> {
     await loadConfiguredAdapterPlugins(config, resolvedConfigPath, log);
     await ensureConfiguredReposRegistered(config, log);
     await recoverStaleDerivedStateOnStartup(config, log);
+    startGraphSnapshotRestore(config);
     await startPrefetchPolicy(config);
 
     // Dynamic imports AFTER migrations - these modules prepare SQL statements
@@ -0,0 +1,51 @@
+import {
+  buildPhaseTrace,
+  getPhaseLatencyMetrics,
+} from "../observability/latency-histogram.js";
+
+export const PHASE_LATENCY_RESOURCE_URI = "sdl://observability/phase-latency";
+export const PHASE_TRACE_RESOURCE_URI = "sdl://observability/phase-trace";
+
+export interface ObservabilityResource {
+  uri: string;
+  name: string;
+  description: string;
+  mimeType: string;
+}
+
+export function listObservabilityResources(): ObservabilityResource[] {
+  return [
+    {
+      uri: PHASE_LATENCY_RESOURCE_URI,
+      name: "Phase latency percentiles",
+      description:
+        "p50/p90/p95/p99 per hot-path phase (indexing, DB writes, PPR, slice building, native parsing) since process start",
+      mimeType: "application/json",
+    },
+    {
+      uri: PHASE_TRACE_RESOURCE_URI,
+      name: "Phase trace",
+      description:
+        "Recent phase spans in Chrome trace event format, one track per native thread; open in Perfetto or chrome://tracing",
+      mimeType: "application/json",
+    },
+  ];
+}
+
+/**
+ * Contents of an `sdl://observability/*` resource, or null for any other
+ * URI. The trace accepts `?since=<epoch ms>` to drop older spans.
+ */
+export function readObservabilityResource(uri: string): string | null {
+  const [base, query = ""] = uri.split("?", 2);
+  if (base === PHASE_LATENCY_RESOURCE_URI) {
+    return JSON.stringify(getPhaseLatencyMetrics());
+  }
+  if (base === PHASE_TRACE_RESOURCE_URI) {
+    const since = Number(new URLSearchParams(query).get("since") ?? 0);
+    return JSON.stringify(
+      buildPhaseTrace(Number.isFinite(since) && since > 0 ? since : 0),
+    );
+  }
+  return null;
+}
@@ -62,6 +62,10 @@ export function recordTokenSavings(event: {
 export async function maybeCompressToolResponse<T>(
   opts: MaybeCompressToolResponseOptions<T>,
 ): Promise<T | ResponseArtifactReference> {
+  // Inline responses are never stored; don't serialize them just to size them.
+  if ((opts.responseMode ?? "inline") === "inline") {
+    return opts.payload;
+  }
   const appConfig = loadConfig();
   const runtimeConfig = RuntimeConfigSchema.parse(appConfig.runtime ?? {});
   const payloadForStorage = stripRawContext(opts.payload);
@@ -31,6 +31,7 @@ import {
 import { logger } from "../../util/logger.js";
 import { NotFoundError, ValidationError } from "../../domain/errors.js";
 import { patchSavedFile } from "../../live-index/file-patcher.js";
+import type { DraftTextEdit } from "../../live-index/draft-parser.js";
 import type { FileWriteRequest, FileWriteResponse } from "../tools.js";
 import { SDL_SOURCE_EXTENSIONS } from "./file-read.js";
 
@@ -534,6 +535,7 @@ export async function syncLiveIndex(
   repoId: string,
   relPath: string,
   newContent: string,
+  edits?: DraftTextEdit[],
 ): Promise<FileWriteResponse["indexUpdate"] | undefined> {
   if (!isIndexedSource(relPath)) {
     return undefined;
@@ -544,6 +546,7 @@ export async function syncLiveIndex(
       repoId,
       filePath: relPath,
       content: newContent,
+      edits,
     });
     const symbolsMatched =
       patchResult.symbolsUpserted - patchResult.symbolsAdded;
@@ -62,6 +62,8 @@ import { surfaceRelevantMemories } from "../../memory/surface.js";
 import { getMemoryCapabilities } from "../../config/memory-config.js";
 import { recordToolTrace } from "../../graph/prefetch-model.js";
 import { invalidateGraphSnapshot } from "../../graph/graphSnapshotCache.js";
+import { discardGraphSnapshotFile } from "../../graph/graph-snapshot-file.js";
+import { invalidateLexicalIndex } from "../../retrieval/lexical-index.js";
 import { buildConditionalResponse } from "../../util/conditional-response.js";
 import {
   withSpan,
@@ -659,6 +661,8 @@ export async function handleRepoUnregister(
     ["live index", () => coordinator.clearRepo(repoId)],
     ["prefetch", () => invalidateRepoPrefetch(repoId)],
     ["graph snapshot", () => invalidateGraphSnapshot(repoId)],
+    ["graph snapshot file", () => discardGraphSnapshotFile(repoId)],
+    ["lexical index", () => invalidateLexicalIndex(repoId)],
     ["overview cache", () => invalidateRepoOverviewCache(repoId)],
     ["slice cache", () => invalidateRepoSliceCache(repoId)],
     ["card cache", () => symbolCardCache.invalidateRepo(repoId)],
@@ -272,6 +272,7 @@ export async function applyBatch(
         plan.repoId,
         entry.edit.relPath,
         entry.edit.newContent,
+        entry.edit.textEdits,
       );
       const matching = results.find((r) => r.file === entry.edit.relPath);
       if (matching && indexUpdate) {
@@ -15,6 +15,7 @@ import { randomBytes } from "crypto";
 
 import type { Range } from "../../../domain/types.js";
 import type { FileWriteResponse } from "../../tools.js";
+import type { DraftTextEdit } from "../../../live-index/draft-parser.js";
 
 export const PLAN_TTL_MS = 15 * 60 * 1000;
 export const PLAN_CAPACITY = 16;
@@ -40,6 +41,11 @@ export interface PlannedFileEdit {
   absPath: string;
   /** Exact new bytes for the file, already computed at preview time. */
   newContent: string;
+  /**
+   * The same change as UTF-8 byte edits against the previewed content, so
+   * the live index can re-parse only what changed. Set for indexed sources.
+   */
+  textEdits?: DraftTextEdit[];
   /** Whether to create a `.bak` backup before writing. */
   createBackup: boolean;
   fileExists: boolean;
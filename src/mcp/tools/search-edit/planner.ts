@@ -43,6 +43,7 @@ import {
 } from "../file-write-internals.js";
 import type { FileWriteRequest, FileWriteResponse } from "../../tools.js";
 import type { PlannedFileEdit, PlanPrecondition } from "./plan-store.js";
+import type { DraftTextEdit } from "../../../live-index/draft-parser.js";
 import { prepareRenameRequest, validateRenameRequest } from "./rename.js";
 import { planSignatureSearchEditPreview, type SignatureOps } from "./signature.js";
 
@@ -983,6 +984,35 @@ function changedSourceEdits(
   ];
 }
 
+/**
+ * Sorted, non-overlapping `edits` of `content` as the sequential UTF-8 byte
+ * edits the incremental draft parser applies.
+ */
+export function toDraftTextEdits(
+  content: string,
+  edits: SourceEdit[],
+): DraftTextEdit[] {
+  const out: DraftTextEdit[] = [];
+  let cursor = 0;
+  // Byte offset of `cursor` in the content after the edits so far.
+  let offset = 0;
+  for (const edit of edits) {
+    offset += Buffer.byteLength(content.slice(cursor, edit.start), "utf8");
+    const oldBytes = Buffer.byteLength(
+      content.slice(edit.start, edit.end),
+      "utf8",
+    );
+    out.push({
+      startByte: offset,
+      oldEndByte: offset + oldBytes,
+      text: edit.replacement,
+    });
+    offset += Buffer.byteLength(edit.replacement, "utf8");
+    cursor = edit.end;
+  }
+  return out;
+}
+
 export function applySourceEdits(content: string, edits: SourceEdit[]): string {
   const sorted = [...edits].sort((a, b) => a.start - b.start || a.end - b.end);
   const chunks: string[] = [];
@@ -1802,6 +1832,9 @@ async function planSearchEditBatchPreview(
       relPath: rel,
       absPath: abs,
       newContent,
+      ...(indexedSource
+        ? { textEdits: toDraftTextEdits(content, sourceEdits) }
+        : {}),
       createBackup,
       fileExists: true,
       indexedSource,
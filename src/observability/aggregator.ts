@@ -24,6 +24,7 @@ import type {
 import { getHeapStatistics } from "node:v8";
 
 import { classifyBottleneck } from "./bottleneck-classifier.js";
+import { getPhaseLatencyMetrics } from "./latency-histogram.js";
 import { RingBuffer } from "./ring-buffer.js";
 
 // V8 heap_size_limit (—max-old-space-size). Fixed for process lifetime, so
@@ -45,6 +46,7 @@ import type {
   LatencyPerTool,
   ObservabilitySnapshot,
   PackedWireMetrics,
+  PhaseLatencyMetrics,
   PoolMetrics,
   PprMetrics,
   ResourceMetrics,
@@ -1218,6 +1220,7 @@ export class Aggregator {
     const toolVolume = this.computeToolVolume();
     const auditBuffer = this.computeAuditBuffer();
     const postIndexSession = this.computePostIndexSession();
+    const phaseLatency = getPhaseLatencyMetrics();
 
     const bottleneck = classifyBottleneck({
       cpuPctAvg: resources.cpuPctAvg,
@@ -1228,7 +1231,8 @@ export class Aggregator {
       heapLimitMb: HEAP_LIMIT_MB,
       eventLoopLagP95Ms: resources.eventLoopLagP95Ms,
       dbLatencyP95Ms: percentile(this.dbLatencies, 0.95),
-      indexerParseP95Ms: percentile(this.beamBuildLatencies, 0.95),
+      indexerParseP95Ms: parseP95Ms(phaseLatency) ??
+        percentile(this.beamBuildLatencies, 0.95),
       ioThroughputMbPerSec: 0,
       ioThroughputSaturationMbPerSec: this.opts.ioThroughputSaturationMbPerSec,
       poolWriteQueuedAvg: pool.avgWriteQueued,
@@ -1258,6 +1262,7 @@ export class Aggregator {
       toolVolume,
       auditBuffer,
       postIndexSession,
+      phaseLatency,
     };
   }
 
@@ -1821,6 +1826,17 @@ function tokenSavingsLayerMetrics(
   };
 }
 
+/**
+ * Per-file parse p95 from the phase histograms: the native engine's when it
+ * has parsed anything, else the TypeScript pass-1 one. Undefined before any
+ * file has been parsed.
+ */
+function parseP95Ms(metrics: PhaseLatencyMetrics): number | undefined {
+  const phase =
+    metrics.phases["native.parseFile"] ?? metrics.phases["pass1.file"];
+  return phase && phase.count > 0 ? phase.p95Ms : undefined;
+}
+
 /**
  * Compute the p-quantile from an unsorted array. Allocates a sorted copy.
  * Returns 0 for empty input. p must be in [0,1].
@@ -96,7 +96,13 @@ export interface ResourceSampleTapEvent {
 
 export interface CacheLookupTapEvent {
   repoId?: string;
-  source: "card" | "slice" | "summary" | "symbol-map" | "etag";
+  source:
+    | "card"
+    | "slice"
+    | "summary"
+    | "symbol-map"
+    | "etag"
+    | "card-fragment";
   /**
    * For single-lookup events, set `hit` and leave `count`/`hits` undefined.
    * For batch events, set `count` (total lookups) and `hits` (subset that hit);
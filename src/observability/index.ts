@@ -25,6 +25,8 @@ export type {
   LatencyPerTool,
   ObservabilitySnapshot,
   PackedWireMetrics,
+  PhaseLatencyMetrics,
+  PhaseLatencySummary,
   PoolMetrics,
   PprMetrics,
   ResourceMetrics,
@@ -65,6 +67,15 @@ export {
 
 export { classifyBottleneck } from "./bottleneck-classifier.js";
 
+export type { PhaseTrace } from "./latency-histogram.js";
+export {
+  buildPhaseTrace,
+  getPhaseLatencyMetrics,
+  phaseStart,
+  recordPhaseDuration,
+  recordPhaseLatency,
+} from "./latency-histogram.js";
+
 export type { BeamExplainStoreLike } from "./service.js";
 export { ObservabilityService, createObservabilityService } from "./service.js";
 
@@ -0,0 +1,357 @@
+/**
+ * Always-on per-phase latency histograms and phase spans.
+ *
+ * Hot paths (pass-1 files, pass-2 resolution, DB write chunks, PPR, beam
+ * search, card hydration) record into a log-linear histogram per phase:
+ * microsecond values, 32 linear sub-buckets per power of two (~3% relative
+ * error), a fixed `Float64Array` per phase. A record is a bucket-index
+ * computation and three additions, with no allocation, so it stays on in
+ * production. Each record also writes one span into a fixed typed-array
+ * ring, for Chrome trace dumps.
+ *
+ * The native addon keeps the same bucket layout in per-thread histograms
+ * (`native/src/stats`), covering time inside `parse_files_parallel`.
+ * `getPhaseLatencyMetrics` merges those in under their `native.*` phase
+ * names, and `buildPhaseTrace` adds one track per native thread.
+ *
+ * Set `SDL_MCP_PHASE_STATS=0` to turn recording off on both sides.
+ */
+
+import { performance } from "node:perf_hooks";
+
+import {
+  isNativeAddonGloballyEnabled,
+  loadNativeAddon,
+} from "../native/addon-loader.js";
+import type { PhaseLatencyMetrics, PhaseLatencySummary } from "./types.js";
+
+const SUB_BUCKET_BITS = 5;
+const SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+const MAX_EXPONENT = 31;
+/** Buckets per histogram; matches `stats::BUCKET_COUNT` in the addon. */
+export const LATENCY_BUCKET_COUNT = (MAX_EXPONENT + 2) * SUB_BUCKETS;
+/** Distinct phase names kept; later names are dropped, not recorded. */
+const MAX_PHASES = 256;
+/** JS spans kept for trace dumps. */
+const SPAN_CAPACITY = 8192;
+const TWO_POW_32 = 2 ** 32;
+
+export function isPhaseStatsEnabled(
+  env: NodeJS.ProcessEnv = process.env,
+): boolean {
+  return !/^(0|false|no)$/i.test((env.SDL_MCP_PHASE_STATS ?? "").trim());
+}
+
+/** Histogram bucket for a latency in microseconds. */
+export function latencyBucketIndex(micros: number): number {
+  const value = Math.max(0, Math.floor(micros));
+  const msb =
+    value < TWO_POW_32
+      ? 31 - Math.clz32(Math.max(1, value))
+      : 63 - Math.clz32(Math.floor(value / TWO_POW_32));
+  const exponent = Math.min(MAX_EXPONENT, Math.max(0, msb - SUB_BUCKET_BITS));
+  const mantissa = Math.min(
+    2 * SUB_BUCKETS - 1,
+    Math.floor(value / 2 ** exponent),
+  );
+  return exponent * SUB_BUCKETS + mantissa;
+}
+
+/** Midpoint of a bucket's value range, in microseconds. */
+function bucketMidpointMicros(index: number): number {
+  if (index < 2 * SUB_BUCKETS) return index;
+  const exponent = Math.floor(index / SUB_BUCKETS) - 1;
+  const mantissa = index - exponent * SUB_BUCKETS;
+  const width = 2 ** exponent;
+  return mantissa * width + (width - 1) / 2;
+}
+
+export class LatencyHistogram {
+  readonly counts = new Float64Array(LATENCY_BUCKET_COUNT);
+  count = 0;
+  totalMicros = 0;
+  maxMicros = 0;
+
+  recordMicros(micros: number): void {
+    const value = micros > 0 ? micros : 0;
+    this.counts[latencyBucketIndex(value)] += 1;
+    this.count += 1;
+    this.totalMicros += value;
+    if (value > this.maxMicros) this.maxMicros = value;
+  }
+
+  /** Add sparse (bucket index, count) columns, e.g. from the addon. */
+  addBuckets(
+    indices: ArrayLike<number>,
+    counts: ArrayLike<number>,
+    totalMicros: number,
+    maxMicros: number,
+  ): void {
+    const n = Math.min(indices.length, counts.length);
+    for (let i = 0; i < n; i++) {
+      const index = indices[i];
+      if (index < 0 || index >= LATENCY_BUCKET_COUNT) continue;
+      this.counts[index] += counts[i];
+      this.count += counts[i];
+    }
+    this.totalMicros += totalMicros;
+    if (maxMicros > this.maxMicros) this.maxMicros = maxMicros;
+  }
+
+  /** Value at quantile `p` in [0, 1], in milliseconds; 0 when empty. */
+  percentileMs(p: number): number {
+    if (this.count === 0) return 0;
+    const quantile = Math.min(1, Math.max(0, p));
+    const rank = Math.max(1, Math.ceil(quantile * this.count));
+    let seen = 0;
+    for (let i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+      seen += this.counts[i];
+      if (seen >= rank) {
+        return Math.min(bucketMidpointMicros(i), this.maxMicros) / 1000;
+      }
+    }
+    return this.maxMicros / 1000;
+  }
+
+  summarize(source: PhaseLatencySummary["source"]): PhaseLatencySummary {
+    return {
+      source,
+      count: this.count,
+      meanMs: this.count === 0 ? 0 : this.totalMicros / this.count / 1000,
+      p50Ms: this.percentileMs(0.5),
+      p90Ms: this.percentileMs(0.9),
+      p95Ms: this.percentileMs(0.95),
+      p99Ms: this.percentileMs(0.99),
+      maxMs: this.maxMicros / 1000,
+    };
+  }
+}
+
+const histograms = new Map<string, LatencyHistogram>();
+const phaseNames: string[] = [];
+const phaseIds = new Map<string, number>();
+const spanPhase = new Uint16Array(SPAN_CAPACITY);
+const spanStartMicros = new Float64Array(SPAN_CAPACITY);
+const spanDurationMicros = new Float64Array(SPAN_CAPACITY);
+let spanHead = 0;
+let enabled = isPhaseStatsEnabled();
+
+function histogramFor(phase: string): LatencyHistogram | null {
+  let histogram = histograms.get(phase);
+  if (histogram) return histogram;
+  if (histograms.size >= MAX_PHASES) return null;
+  histogram = new LatencyHistogram();
+  histograms.set(phase, histogram);
+  phaseIds.set(phase, phaseNames.length);
+  phaseNames.push(phase);
+  return histogram;
+}
+
+/**
+ * Start timestamp for `recordPhaseLatency` (a `performance.now()` reading).
+ */
+export function phaseStart(): number {
+  return performance.now();
+}
+
+/** Record `phase` as running from `startedAt` (see `phaseStart`) until now. */
+export function recordPhaseLatency(phase: string, startedAt: number): void {
+  if (!enabled) return;
+  const now = performance.now();
+  recordSpan(phase, startedAt, now - startedAt);
+}
+
+/**
+ * Record a `phase` duration measured elsewhere, e.g. with `Date.now()`.
+ * The span is placed to end now.
+ */
+export function recordPhaseDuration(phase: string, durationMs: number): void {
+  if (!enabled || !(durationMs >= 0)) return;
+  recordSpan(phase, performance.now() - durationMs, durationMs);
+}
+
+function recordSpan(phase: string, startedAt: number, durationMs: number): void {
+  const histogram = histogramFor(phase);
+  if (!histogram) return;
+  const micros = durationMs * 1000;
+  histogram.recordMicros(micros);
+  const slot = spanHead % SPAN_CAPACITY;
+  spanPhase[slot] = phaseIds.get(phase) ?? 0;
+  spanStartMicros[slot] = (performance.timeOrigin + startedAt) * 1000;
+  spanDurationMicros[slot] = micros;
+  spanHead += 1;
+}
+
+/* ---------------------- native addon ---------------------- */
+
+interface NativePhaseHistogram {
+  phase: string;
+  count: number;
+  totalMicros: number;
+  maxMicros: number;
+  bucketIndices: number[];
+  bucketCounts: number[];
+}
+
+interface NativePhaseSpan {
+  phase: string;
+  threadId: number;
+  threadName: string;
+  startMicros: number;
+  durationMicros: number;
+}
+
+interface NativePhaseStatsAddon {
+  nativePhaseStats(): NativePhaseHistogram[];
+  nativePhaseSpans?(sinceMicros: number): NativePhaseSpan[];
+  setNativePhaseStatsEnabled?(enabled: boolean): void;
+}
+
+let nativeAddon: NativePhaseStatsAddon | null | undefined;
+
+function isNativePhaseStatsAddon(
+  addon: unknown,
+): addon is NativePhaseStatsAddon {
+  return (
+    !!addon &&
+    typeof addon === "object" &&
+    typeof (addon as Partial<NativePhaseStatsAddon>).nativePhaseStats ===
+      "function"
+  );
+}
+
+function loadNativePhaseStatsAddon(): NativePhaseStatsAddon | null {
+  if (nativeAddon !== undefined) return nativeAddon;
+  if (!isNativeAddonGloballyEnabled()) return null;
+  const loaded = loadNativeAddon(isNativePhaseStatsAddon);
+  nativeAddon = isNativePhaseStatsAddon(loaded) ? loaded : null;
+  return nativeAddon;
+}
+
+/* ---------------------- reads ---------------------- */
+
+/**
+ * p50/p90/p95/p99 per phase since process start: JS phases, plus the
+ * addon's `native.*` phases when it is loaded.
+ */
+export function getPhaseLatencyMetrics(): PhaseLatencyMetrics {
+  const phases: Record<string, PhaseLatencySummary> = {};
+  for (const [phase, histogram] of histograms) {
+    phases[phase] = histogram.summarize("js");
+  }
+  const addon = enabled ? loadNativePhaseStatsAddon() : null;
+  let nativeAvailable = false;
+  if (addon) {
+    try {
+      for (const row of addon.nativePhaseStats()) {
+        const histogram = new LatencyHistogram();
+        histogram.addBuckets(
+          row.bucketIndices,
+          row.bucketCounts,
+          row.totalMicros,
+          row.maxMicros,
+        );
+        phases[row.phase] = histogram.summarize("native");
+      }
+      nativeAvailable = true;
+    } catch {
+      // observability is best-effort
+    }
+  }
+  return { enabled, nativeAvailable, phases };
+}
+
+interface ChromeTraceEvent {
+  name: string;
+  cat: string;
+  ph: "X" | "M";
+  pid: number;
+  tid: number;
+  ts?: number;
+  dur?: number;
+  args?: Record<string, unknown>;
+}
+
+export interface PhaseTrace {
+  traceEvents: ChromeTraceEvent[];
+  displayTimeUnit: "ms";
+}
+
+/**
+ * Recent phase spans in Chrome trace event format (load in Perfetto or
+ * chrome://tracing). Node's spans share one track; each native thread gets
+ * its own. `sinceMs` (epoch milliseconds) drops older spans.
+ */
+export function buildPhaseTrace(sinceMs = 0): PhaseTrace {
+  const sinceMicros = sinceMs * 1000;
+  const pid = process.pid;
+  const events: ChromeTraceEvent[] = [
+    {
+      name: "thread_name",
+      cat: "__metadata",
+      ph: "M",
+      pid,
+      tid: 0,
+      args: { name: "node" },
+    },
+  ];
+  const first = Math.max(0, spanHead - SPAN_CAPACITY);
+  for (let i = first; i < spanHead; i++) {
+    const slot = i % SPAN_CAPACITY;
+    const ts = spanStartMicros[slot];
+    if (ts < sinceMicros) continue;
+    events.push({
+      name: phaseNames[spanPhase[slot]] ?? "unknown",
+      cat: "sdl",
+      ph: "X",
+      pid,
+      tid: 0,
+      ts: Math.round(ts),
+      dur: Math.round(spanDurationMicros[slot]),
+    });
+  }
+
+  const addon = enabled ? loadNativePhaseStatsAddon() : null;
+  if (addon?.nativePhaseSpans) {
+    try {
+      const named = new Set<number>();
+      for (const span of addon.nativePhaseSpans(sinceMicros)) {
+        if (!named.has(span.threadId)) {
+          named.add(span.threadId);
+          events.push({
+            name: "thread_name",
+            cat: "__metadata",
+            ph: "M",
+            pid,
+            tid: span.threadId,
+            args: { name: span.threadName },
+          });
+        }
+        events.push({
+          name: span.phase,
+          cat: "sdl.native",
+          ph: "X",
+          pid,
+          tid: span.threadId,
+          ts: Math.round(span.startMicros),
+          dur: Math.round(span.durationMicros),
+        });
+      }
+    } catch {
+      // observability is best-effort
+    }
+  }
+  return { traceEvents: events, displayTimeUnit: "ms" };
+}
+
+/** @internal exported for tests; do not import from product code. */
+export function resetPhaseLatency(
+  env: NodeJS.ProcessEnv = process.env,
+): void {
+  histograms.clear();
+  phaseIds.clear();
+  phaseNames.length = 0;
+  spanHead = 0;
+  enabled = isPhaseStatsEnabled(env);
+  nativeAddon = undefined;
+}
@@ -478,6 +478,32 @@ export interface PredictiveContextMetrics {
   topStrategies: PredictiveContextStrategyMetrics[];
 }
 
+export interface PhaseLatencySummary {
+  /** "js" for phases timed in Node; "native" for the addon's own phases. */
+  source: "js" | "native";
+  /** Samples since process start. */
+  count: number;
+  meanMs: number;
+  p50Ms: number;
+  p90Ms: number;
+  p95Ms: number;
+  p99Ms: number;
+  maxMs: number;
+}
+
+export interface PhaseLatencyMetrics {
+  /** False when `SDL_MCP_PHASE_STATS=0` turned recording off. */
+  enabled: boolean;
+  /** Whether the native addon's phase histograms were merged in. */
+  nativeAvailable: boolean;
+  /**
+   * Process-wide latency distribution per hot-path phase (`pass1.file`,
+   * `pass2.resolve`, `db.writeChunk.*`, `ppr`, `slice.beamSearch`,
+   * `slice.cardHydration`, `index.*`, `native.*`). Not scoped to a repo.
+   */
+  phases: Record<string, PhaseLatencySummary>;
+}
+
 export interface ObservabilitySnapshot {
   schemaVersion: 1;
   /** ISO 8601 timestamp at which the snapshot was generated. */
@@ -505,6 +531,7 @@ export interface ObservabilitySnapshot {
   toolVolume: ToolVolume;
   auditBuffer: AuditBufferMetrics;
   postIndexSession: PostIndexSessionMetrics;
+  phaseLatency: PhaseLatencyMetrics;
 }
 
 /* -------------------------------------------------------------------------- */
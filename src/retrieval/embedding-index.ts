@@ -0,0 +1,329 @@
+/**
+ * Native embedding index.
+ *
+ * Alongside the Kuzu vector index, each repo and model gets an IVF index
+ * file built by the Rust addon: vectors are normalised, quantised to int8,
+ * and grouped around k-means centroids, so a query scans a few lists with
+ * SIMD dot products instead of every vector. Files live next to the graph
+ * database under `embedding-index/<repo>/<model>.<generation>.sdlvec` and
+ * are memory-mapped on first search.
+ *
+ * Each embedding refresh rebuilds the index from the stored Symbol blobs
+ * into a new generation file, switches the open handle over, then closes
+ * and removes older generations. A mapped file is never replaced or deleted
+ * in place, which Windows would refuse. Searches return null when there is
+ * no usable index, and callers fall back to Kuzu.
+ *
+ * @module retrieval/embedding-index
+ */
+
+import { readdirSync, rmSync } from "node:fs";
+import { basename, dirname, join, resolve } from "node:path";
+import type { Connection } from "kuzu";
+
+import { getLadybugDbPath } from "../db/ladybug.js";
+import { getSymbolEmbeddingBlobPage } from "../db/ladybug-symbol-embeddings.js";
+import {
+  buildEmbeddingIndexRust,
+  openEmbeddingIndexRust,
+  supportsRustEmbeddingIndex,
+  type RustEmbeddingIndex,
+} from "../indexer/rustIndexer.js";
+import { logger } from "../util/logger.js";
+import { EMBEDDING_MODELS } from "./model-mapping.js";
+
+/** Symbol blobs read per round-trip while rebuilding. */
+const BLOB_PAGE_SIZE = 5_000;
+/** `toFloat16Blob` stores `round(x * 10000)` as little-endian Int16. */
+const BLOB_SCALE = 10_000;
+
+/**
+ * How long a search trusts its open handle before looking for a newer
+ * generation written by another process (e.g. a CLI index run).
+ */
+const GENERATION_RECHECK_MS = 5_000;
+
+interface OpenIndex {
+  index: RustEmbeddingIndex;
+  file: string;
+  checkedAt: number;
+}
+
+/** Open handles keyed by {@link embeddingIndexPath}. */
+const handles = new Map<string, OpenIndex>();
+
+/**
+ * Whether hybrid search uses the native embedding index. On by default;
+ * `SDL_MCP_NATIVE_VECTOR_INDEX=0` keeps vector retrieval on Kuzu alone.
+ */
+export function shouldUseNativeEmbeddingIndex(
+  env: NodeJS.ProcessEnv = process.env,
+): boolean {
+  return !/^(0|false|no)$/i.test(
+    (env.SDL_MCP_NATIVE_VECTOR_INDEX ?? "").trim(),
+  );
+}
+
+export function embeddingIndexPath(
+  repoId: string,
+  model: string,
+  graphDbPath: string | null = getLadybugDbPath(),
+): string | null {
+  if (!graphDbPath) return null;
+  return resolve(
+    dirname(graphDbPath),
+    "embedding-index",
+    encodeURIComponent(repoId),
+    `${encodeURIComponent(model)}.sdlvec`,
+  );
+}
+
+/**
+ * Decode a stored embedding blob into `target` at `offset`. Returns false,
+ * leaving `target` untouched, when the blob does not hold `dimension`
+ * values.
+ */
+export function decodeEmbeddingBlob(
+  blob: string,
+  target: Float32Array,
+  offset: number,
+  dimension: number,
+): boolean {
+  const bytes = Buffer.from(blob, "base64");
+  if (bytes.length !== dimension * 2) return false;
+  for (let i = 0; i < dimension; i++) {
+    target[offset + i] = bytes.readInt16LE(i * 2) / BLOB_SCALE;
+  }
+  return true;
+}
+
+const GENERATION_SUFFIX = /^\d{15}-\d+\.sdlvec$/;
+
+function generationPrefix(path: string): string {
+  return basename(path).replace(/\.sdlvec$/, "");
+}
+
+/** A new generation file next to `path`; names sort by age. */
+export function embeddingIndexGenerationPath(
+  path: string,
+  now: number = Date.now(),
+): string {
+  const generation = `${String(now).padStart(15, "0")}-${process.pid}`;
+  return join(dirname(path), `${generationPrefix(path)}.${generation}.sdlvec`);
+}
+
+/**
+ * Every index file for `path`, oldest first: the unversioned file written
+ * by earlier releases, then generation files.
+ */
+function indexFiles(path: string): string[] {
+  const prefix = `${generationPrefix(path)}.`;
+  let names: string[];
+  try {
+    names = readdirSync(dirname(path));
+  } catch {
+    return [];
+  }
+  const generations = names
+    .filter(
+      (name) =>
+        name.startsWith(prefix) &&
+        GENERATION_SUFFIX.test(name.slice(prefix.length)),
+    )
+    .sort();
+  const legacy = basename(path);
+  return [
+    ...(names.includes(legacy) ? [legacy] : []),
+    ...generations,
+  ].map((name) => join(dirname(path), name));
+}
+
+function closeHandle(open: OpenIndex | undefined): void {
+  try {
+    open?.index.close?.();
+  } catch {
+    // Already closed.
+  }
+}
+
+/** Make `file` the open index for `path`, closing the previous handle. */
+function switchIndex(path: string, file: string): RustEmbeddingIndex | null {
+  const index = openEmbeddingIndexRust(file);
+  const previous = handles.get(path);
+  if (index) {
+    handles.set(path, { index, file, checkedAt: Date.now() });
+  } else {
+    handles.delete(path);
+  }
+  if (previous?.index !== index) closeHandle(previous);
+  return index;
+}
+
+/**
+ * The open index for `path`. The directory is only listed when there is no
+ * handle yet or the handle has not been checked for a newer generation in
+ * {@link GENERATION_RECHECK_MS}, so searches do no file system work.
+ */
+function openIndex(path: string): RustEmbeddingIndex | null {
+  const cached = handles.get(path);
+  const now = Date.now();
+  if (cached && now - cached.checkedAt < GENERATION_RECHECK_MS) {
+    return cached.index;
+  }
+  const latest = indexFiles(path).at(-1);
+  if (!latest) {
+    closeHandle(cached);
+    handles.delete(path);
+    return null;
+  }
+  if (cached && cached.file === latest) {
+    cached.checkedAt = now;
+    return cached.index;
+  }
+  return switchIndex(path, latest);
+}
+
+/** Remove generations older than `keep`; files still mapped elsewhere stay. */
+function removeOldGenerations(path: string, keep: string): void {
+  for (const file of indexFiles(path)) {
+    if (file === keep) break;
+    try {
+      rmSync(file, { force: true });
+    } catch {
+      // Mapped by another process (Windows); the next rebuild retries.
+    }
+  }
+}
+
+function usableIndex(
+  repoId: string,
+  model: string,
+): RustEmbeddingIndex | null {
+  if (!shouldUseNativeEmbeddingIndex()) return null;
+  const path = embeddingIndexPath(repoId, model);
+  if (!path) return null;
+  const index = openIndex(path);
+  return index && index.rows > 0 ? index : null;
+}
+
+/** Whether `searchEmbeddingIndex` can answer for this repo and model. */
+export function hasEmbeddingIndex(repoId: string, model: string): boolean {
+  return usableIndex(repoId, model) !== null;
+}
+
+/**
+ * Top `topK` symbols by approximate cosine similarity to `query`, best
+ * first, or null when there is no usable native index.
+ */
+export function searchEmbeddingIndex(
+  repoId: string,
+  model: string,
+  query: number[],
+  topK: number,
+  nprobe: number = 0,
+): Array<{ symbolId: string; score: number }> | null {
+  const index = usableIndex(repoId, model);
+  if (!index || index.dimension !== query.length) return null;
+  try {
+    return index.search(Float32Array.from(query), topK, nprobe);
+  } catch (error) {
+    logger.warn("[hybrid-search] Native embedding index search failed", {
+      repoId,
+      model,
+      error: error instanceof Error ? error.message : String(error),
+    });
+    return null;
+  }
+}
+
+/**
+ * Rebuild the index for `repoId` and `model` from every stored Symbol blob.
+ * Resolves to the row count, or null when the native index is disabled,
+ * unsupported, or the build failed.
+ */
+export async function rebuildEmbeddingIndex(
+  conn: Connection,
+  repoId: string,
+  model: string,
+): Promise<number | null> {
+  const dimension = EMBEDDING_MODELS[model]?.dimension;
+  const path = embeddingIndexPath(repoId, model);
+  if (
+    !dimension ||
+    !path ||
+    !shouldUseNativeEmbeddingIndex() ||
+    !supportsRustEmbeddingIndex()
+  ) {
+    return null;
+  }
+
+  const symbolIds: string[] = [];
+  let vectors = new Float32Array(BLOB_PAGE_SIZE * dimension);
+  let afterSymbolId: string | undefined;
+  for (;;) {
+    const page = await getSymbolEmbeddingBlobPage(conn, repoId, model, {
+      afterSymbolId,
+      limit: BLOB_PAGE_SIZE,
+    });
+    for (const row of page) {
+      const offset = symbolIds.length * dimension;
+      if (offset + dimension > vectors.length) {
+        const grown = new Float32Array(vectors.length * 2);
+        grown.set(vectors);
+        vectors = grown;
+      }
+      if (decodeEmbeddingBlob(row.vector, vectors, offset, dimension)) {
+        symbolIds.push(row.symbolId);
+      }
+    }
+    if (page.length < BLOB_PAGE_SIZE) break;
+    afterSymbolId = page[page.length - 1].symbolId;
+  }
+
+  const file = embeddingIndexGenerationPath(path);
+  const rows = await buildEmbeddingIndexRust(
+    file,
+    dimension,
+    symbolIds,
+    vectors.subarray(0, symbolIds.length * dimension),
+  );
+  if (rows !== null) {
+    switchIndex(path, file);
+    removeOldGenerations(path, file);
+    logger.info("[embeddings] Native embedding index rebuilt", {
+      repoId,
+      model,
+      rows,
+    });
+  }
+  return rows;
+}
+
+/**
+ * Rebuild after a refresh that wrote vectors, or when no index file exists
+ * yet. Never throws: a failed rebuild leaves search on Kuzu.
+ */
+export async function syncEmbeddingIndex(
+  conn: Connection,
+  repoId: string,
+  model: string,
+  changed: boolean,
+): Promise<void> {
+  const path = embeddingIndexPath(repoId, model);
+  if (!path || (!changed && openIndex(path) !== null)) return;
+  try {
+    await rebuildEmbeddingIndex(conn, repoId, model);
+  } catch (error) {
+    logger.warn("[embeddings] Native embedding index rebuild failed", {
+      repoId,
+      model,
+      error: error instanceof Error ? error.message : String(error),
+    });
+  }
+}
+
+/** Close every open index handle. */
+export function closeEmbeddingIndexes(): void {
+  for (const open of handles.values()) closeHandle(open);
+  handles.clear();
+}
@@ -0,0 +1,270 @@
+/**
+ * Native lexical index.
+ *
+ * Each repo's Symbol names and `searchText` are held in a Rust-side
+ * postings index, so the lexical lookups on every retrieval answer in
+ * process instead of through LadybugDB: BM25 token search over the same
+ * `searchText` the FTS index covers, and the exact-name, name-prefix and
+ * symbol-ID-prefix matches seed resolution needs.
+ *
+ * The index is built from the Symbol rows on first use, dropped when an
+ * index run replaces them, and patched in place by saved-file updates from
+ * the live index. Lookups return null while there is no index, and callers
+ * fall back to LadybugDB.
+ *
+ * @module retrieval/lexical-index
+ */
+
+import type { Connection } from "kuzu";
+
+import {
+  getRetrievalLexicalRowPage,
+  type RetrievalSeedCandidateRow,
+} from "../db/ladybug-retrieval.js";
+import {
+  buildLexicalIndexRust,
+  supportsRustLexicalIndex,
+  type RustLexicalIndex,
+} from "../indexer/rustIndexer.js";
+import { logger } from "../util/logger.js";
+
+/** Symbol rows read per round-trip while building. */
+const ROW_PAGE_SIZE = 10_000;
+/** Seed lookups only need to tell one match from several. */
+const SEED_LIMIT = 2;
+
+/** Symbols changed by one saved-file patch. */
+export interface LexicalIndexPatch {
+  symbols: ReadonlyArray<{
+    symbolId: string;
+    name: string;
+    searchText?: string | null;
+  }>;
+  removedSymbolIds: readonly string[];
+}
+
+interface PendingBuild {
+  promise: Promise<RustLexicalIndex | null>;
+  /** Patches that landed mid-build, replayed onto the new index. */
+  patches: LexicalIndexPatch[];
+}
+
+const indexes = new Map<string, RustLexicalIndex>();
+const builds = new Map<string, PendingBuild>();
+
+/**
+ * Whether retrieval uses the native lexical index. On by default;
+ * `SDL_MCP_NATIVE_LEXICAL_INDEX=0` keeps every lexical lookup on
+ * LadybugDB.
+ */
+export function shouldUseNativeLexicalIndex(
+  env: NodeJS.ProcessEnv = process.env,
+): boolean {
+  return !/^(0|false|no)$/i.test(
+    (env.SDL_MCP_NATIVE_LEXICAL_INDEX ?? "").trim(),
+  );
+}
+
+function applyPatch(index: RustLexicalIndex, patch: LexicalIndexPatch): void {
+  if (patch.removedSymbolIds.length > 0) {
+    index.remove([...patch.removedSymbolIds]);
+  }
+  if (patch.symbols.length > 0) {
+    index.upsert(
+      patch.symbols.map((symbol) => symbol.symbolId),
+      patch.symbols.map((symbol) => symbol.name),
+      patch.symbols.map((symbol) => symbol.searchText ?? ""),
+    );
+  }
+}
+
+async function readIndex(
+  conn: Connection,
+  repoId: string,
+): Promise<RustLexicalIndex | null> {
+  const symbolIds: string[] = [];
+  const names: string[] = [];
+  const searchTexts: string[] = [];
+  let afterSymbolId: string | undefined;
+  for (;;) {
+    const page = await getRetrievalLexicalRowPage(conn, repoId, {
+      afterSymbolId,
+      limit: ROW_PAGE_SIZE,
+    });
+    for (const row of page) {
+      symbolIds.push(row.symbolId);
+      names.push(row.name);
+      searchTexts.push(row.searchText);
+    }
+    if (page.length < ROW_PAGE_SIZE) break;
+    afterSymbolId = page[page.length - 1].symbolId;
+  }
+  return buildLexicalIndexRust(symbolIds, names, searchTexts);
+}
+
+/**
+ * Build the index for `repoId` from its Symbol rows, sharing a build that
+ * is already running. Resolves to null when the native index is disabled,
+ * unsupported, or the build failed.
+ */
+export function buildLexicalIndex(
+  conn: Connection,
+  repoId: string,
+): Promise<RustLexicalIndex | null> {
+  if (!shouldUseNativeLexicalIndex() || !supportsRustLexicalIndex()) {
+    return Promise.resolve(null);
+  }
+  const running = builds.get(repoId);
+  if (running) return running.promise;
+
+  const startedAt = Date.now();
+  const build: PendingBuild = { patches: [], promise: Promise.resolve(null) };
+  build.promise = readIndex(conn, repoId)
+    .then((index) => {
+      // Invalidated mid-build: the rows read may already be stale.
+      if (builds.get(repoId) !== build || !index) return null;
+      for (const patch of build.patches) applyPatch(index, patch);
+      indexes.set(repoId, index);
+      logger.debug("[lexical-index] Native lexical index built", {
+        repoId,
+        symbols: index.size,
+        durationMs: Date.now() - startedAt,
+      });
+      return index;
+    })
+    .catch((error) => {
+      logger.warn("[lexical-index] Native lexical index build failed", {
+        repoId,
+        error: error instanceof Error ? error.message : String(error),
+      });
+      return null;
+    })
+    .finally(() => {
+      if (builds.get(repoId) === build) builds.delete(repoId);
+    });
+  builds.set(repoId, build);
+  return build.promise;
+}
+
+/**
+ * The repo's index, or null while there is none. A miss starts a build in
+ * the background so later lookups can use it.
+ */
+function usableIndex(
+  conn: Connection,
+  repoId: string,
+): RustLexicalIndex | null {
+  if (!shouldUseNativeLexicalIndex()) return null;
+  const index = indexes.get(repoId);
+  if (index) return index;
+  void buildLexicalIndex(conn, repoId);
+  return null;
+}
+
+function guarded<T>(repoId: string, lookup: () => T): T | null {
+  try {
+    return lookup();
+  } catch (error) {
+    logger.warn("[lexical-index] Native lexical lookup failed", {
+      repoId,
+      error: error instanceof Error ? error.message : String(error),
+    });
+    return null;
+  }
+}
+
+/**
+ * Top `limit` symbols by BM25 over `searchText`, best first, or null when
+ * there is no index or the query uses FTS wildcards.
+ */
+export function searchLexicalIndex(
+  conn: Connection,
+  repoId: string,
+  query: string,
+  limit: number,
+  conjunctive: boolean,
+): Array<{ symbolId: string; score: number }> | null {
+  if (/[*?]/.test(query)) return null;
+  const index = usableIndex(conn, repoId);
+  if (!index) return null;
+  return guarded(repoId, () => index.search(query, limit, conjunctive));
+}
+
+/**
+ * Up to two exact or prefix name matches, as
+ * `findRetrievalSeedSymbolsByName` returns them, or null when there is no
+ * index.
+ */
+export function findLexicalSeedsByName(
+  conn: Connection,
+  repoId: string,
+  name: string,
+  mode: "exact" | "prefix",
+): RetrievalSeedCandidateRow[] | null {
+  const index = usableIndex(conn, repoId);
+  if (!index) return null;
+  const symbolIds = guarded(repoId, () =>
+    index.findByName(name, mode === "prefix", SEED_LIMIT),
+  );
+  return symbolIds?.map((symbolId) => ({ symbolId, score: 1 })) ?? null;
+}
+
+/** Up to two symbol IDs starting with `prefix`, or null without an index. */
+export function findLexicalSeedsByIdPrefix(
+  conn: Connection,
+  repoId: string,
+  prefix: string,
+): string[] | null {
+  const index = usableIndex(conn, repoId);
+  if (!index) return null;
+  return guarded(repoId, () => index.findByIdPrefix(prefix, SEED_LIMIT));
+}
+
+/** Whether the index holds `symbolId`, or null without an index. */
+export function hasLexicalSymbol(
+  conn: Connection,
+  repoId: string,
+  symbolId: string,
+): boolean | null {
+  const index = usableIndex(conn, repoId);
+  if (!index) return null;
+  return guarded(repoId, () => index.contains(symbolId));
+}
+
+/**
+ * Apply a saved-file patch to the repo's index, and to any build in
+ * flight. Never throws: a failed patch drops the index so lookups fall
+ * back to LadybugDB until it is rebuilt.
+ */
+export function patchLexicalIndex(
+  repoId: string,
+  patch: LexicalIndexPatch,
+): void {
+  builds.get(repoId)?.patches.push(patch);
+  const index = indexes.get(repoId);
+  if (!index) return;
+  try {
+    applyPatch(index, patch);
+  } catch (error) {
+    indexes.delete(repoId);
+    logger.warn("[lexical-index] Native lexical index patch failed", {
+      repoId,
+      error: error instanceof Error ? error.message : String(error),
+    });
+  }
+}
+
+/**
+ * Forget the repo's index and any build in flight, after its Symbol rows
+ * were replaced. The next lookup rebuilds it.
+ */
+export function invalidateLexicalIndex(repoId: string): void {
+  indexes.delete(repoId);
+  builds.delete(repoId);
+}
+
+/** Drop every index. */
+export function closeLexicalIndexes(): void {
+  indexes.clear();
+  builds.clear();
+}
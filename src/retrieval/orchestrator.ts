@@ -55,7 +55,12 @@ import { getObservabilityTap } from "../observability/event-tap.js";
 import { getEmbeddingProvider } from "../indexer/embeddings.js";
 import { applyQueryPrefix } from "../indexer/model-registry.js";
 import { EMBEDDING_MODELS } from "./model-mapping.js";
+import { hasEmbeddingIndex, searchEmbeddingIndex } from "./embedding-index.js";
 import { ENTITY_FTS_INDEX_NAMES } from "./index-lifecycle.js";
+import {
+  searchLexicalIndex,
+  shouldUseNativeLexicalIndex,
+} from "./lexical-index.js";
 import { checkRetrievalHealth, shouldFallbackToLegacy } from "./fallback.js";
 import type {
   HybridSearchOptions,
@@ -462,19 +467,31 @@ export async function hybridSearch(
   // TODO(Stage 1): Verify Kuzu QUERY_FTS_INDEX return columns against a live
   // instance.  The extraction below handles both flat (symbolId, score) and
   // nested (node.symbolId, _node.symbolId) formats defensively.
-  if (ftsEnabled && caps.fts) {
+  if (ftsEnabled && (caps.fts || shouldUseNativeLexicalIndex())) {
     const ftsTopK = config.fts.topK ?? DEFAULT_FTS_TOP_K;
     const ftsIndexName = config.fts.indexName ?? DEFAULT_FTS_INDEX_NAME;
     const ftsConjunctive = config.fts.conjunctive ?? false;
 
+    // The repo's native lexical index scores the same searchText with
+    // BM25 in process; Kuzu FTS answers until it is built.
     const ftsStartedAt = performance.now();
-    const ftsRows = await queryFts(
-      conn,
-      ftsIndexName,
-      options.query,
-      ftsTopK,
-      ftsConjunctive,
-    );
+    const ftsRows: FtsRawRow[] =
+      searchLexicalIndex(
+        conn,
+        options.repoId,
+        options.query,
+        ftsTopK,
+        ftsConjunctive,
+      ) ??
+      (caps.fts
+        ? await queryFts(
+            conn,
+            ftsIndexName,
+            options.query,
+            ftsTopK,
+            ftsConjunctive,
+          )
+        : []);
     recordRetrievalTiming(diagnosticTimings, "fts", ftsStartedAt);
 
     if (ftsRows.length > 0) {
@@ -517,7 +534,7 @@ export async function hybridSearch(
         (source === "vector:nomic" && caps.vectorNomic) ||
         (source === "vector:jinacode" && caps.vectorJinaCode);
 
-      if (!capAvailable) {
+      if (!capAvailable && !hasEmbeddingIndex(options.repoId, modelName)) {
         logger.debug(
           `[hybrid-search] Skipping vector model '${modelName}' -- capability unavailable`,
         );
@@ -577,14 +594,19 @@ export async function hybridSearch(
         );
       }
 
-      // Query the vector index.
+      // Query the vector index: the repo's native index when it has one,
+      // otherwise Kuzu.
       const vectorStartedAt = performance.now();
-      const vecResults = await queryVectorIndex(
-        conn,
-        indexName,
-        queryEmbedding,
-        vectorTopK,
-      );
+      const vecResults =
+        searchEmbeddingIndex(
+          options.repoId,
+          modelName,
+          queryEmbedding,
+          vectorTopK,
+        ) ??
+        (capAvailable
+          ? await queryVectorIndex(conn, indexName, queryEmbedding, vectorTopK)
+          : []);
       recordRetrievalTiming(diagnosticTimings, "vector", vectorStartedAt);
       recordRetrievalTiming(
         diagnosticTimings,
@@ -9,8 +9,13 @@
  *
  * Two backends are supported:
  *   - Native Rust (preferred when the addon is loaded) via
- *     `computePersonalizedPageRankRust`.
- *   - Pure-JS fallback (`pushPpr`) — identical algorithm to within 1e-3.
+ *     `computePersonalizedPageRankCsrRust`.
+ *   - Pure-JS fallback (`pushPprCsr`) — identical algorithm to within 1e-3.
+ *
+ * Both walk the snapshot's shared CSR view (`graph/csr-snapshot`); the
+ * per-direction walk adjacency derived from it is memoized per snapshot.
+ * Seed sets are served as linear combinations of cached unit-seed vectors,
+ * computed natively in batches via `computePersonalizedPageRankCsrBatchRust`.
  *
  * The boost helper (`applyPprBoost`) re-ranks an existing fused result list
  * by multiplying each score by `1 + pprWeight * pprScore`, capped at 2× the
@@ -20,9 +25,12 @@
  */
 
 import type { Graph } from "../graph/buildGraph.js";
-import type { EdgeRow } from "../db/schema.js";
+import { getCsrSnapshot, type CsrGraph } from "../graph/csr-snapshot.js";
+import { sharesGraphSnapshotLineage } from "../graph/graphSnapshotCache.js";
+import { SymbolIdFilter } from "../graph/symbol-filter.js";
 import type { HybridSearchResultItem } from "./types.js";
 import { logger } from "../util/logger.js";
+import { recordPhaseLatency } from "../observability/latency-histogram.js";
 
 // ---------------------------------------------------------------------------
 // Tuning knobs (kept in module scope for test override)
@@ -48,6 +56,10 @@ export const PPR_BOOST_CAP = 2.0;
  * the multiplier to 2× regardless of how high `pprWeight × pprScore` climbs.
  */
 export const DEFAULT_PPR_WEIGHT = 2.0;
+/** Unit-seed vectors kept per snapshot, direction and walk parameters. */
+const SEED_VECTOR_CAP = 512;
+/** Larger seed sets run one combined push instead of per-seed vectors. */
+const SEED_VECTOR_MAX_SEEDS = 64;
 /** Minimum pprScore to count a result as "boosted" in evidence. */
 const PPR_BOOST_VISIBILITY_THRESHOLD = 1e-6;
 
@@ -85,104 +97,169 @@ export interface PprResult {
 // Adjacency construction (TS-side; fed into native or JS backend)
 // ---------------------------------------------------------------------------
 
-interface CsrAdjacency {
-  /** Index → outgoing (neighborIndex, edgeWeight) tuples for the chosen direction. */
-  rows: Array<Array<[number, number]>>;
-  /** symbolId → numeric index. */
-  idToIndex: Map<string, number>;
-  /** Numeric index → symbolId. */
-  indexToId: string[];
+/**
+ * Walk adjacency for one direction, in the snapshot's dense node order.
+ * Row `u` is `neighbors[offsets[u]..offsets[u + 1]]` with matching `weights`.
+ */
+export interface PprAdjacency {
+  offsets: Uint32Array;
+  neighbors: Uint32Array;
+  weights: Float64Array;
 }
 
-/** Pull the structural weight for an edge: `weight × confidence` (defaults 1.0). */
-function edgeStrength(edge: EdgeRow): number {
-  const weight = edge.weight ?? 1.0;
-  const confidence = edge.confidence ?? 1.0;
-  // Guard against negative / NaN values from stale rows.
-  if (!Number.isFinite(weight) || !Number.isFinite(confidence)) return 0;
-  return Math.max(0, weight) * Math.max(0, Math.min(1, confidence));
-}
+const adjacencyByCsr = new WeakMap<CsrGraph, Map<PprDirection, PprAdjacency>>();
 
 /**
- * Build a CSR-style adjacency view over the snapshot.
+ * Derive the walk adjacency for `direction` from the snapshot CSR.
  *
- * - direction "out": adjacencyOut[u] → list of (v, w)
- * - direction "in":  adjacencyIn[u]  → list of (v, w) where v is the source
+ * - direction "out": the CSR rows as-is
+ * - direction "in":  each edge reversed
  * - direction "both": union of both, with reverse direction scaled by REVERSE_EDGE_SCALE
  *
- * Self-loops are dropped. Multi-edges are summed.
+ * Self-loops and zero-strength edges are dropped. Multi-edges are summed.
+ * Memoized per CSR (i.e. per snapshot), so repeated queries skip the build.
  */
-function buildAdjacency(graph: Graph, direction: PprDirection): CsrAdjacency {
-  const idToIndex = new Map<string, number>();
-  const indexToId: string[] = [];
-
-  for (const id of graph.symbols.keys()) {
-    idToIndex.set(id, indexToId.length);
-    indexToId.push(id);
+function buildAdjacency(csr: CsrGraph, direction: PprDirection): PprAdjacency {
+  let byDirection = adjacencyByCsr.get(csr);
+  if (!byDirection) {
+    byDirection = new Map();
+    adjacencyByCsr.set(csr, byDirection);
   }
+  const cached = byDirection.get(direction);
+  if (cached) return cached;
 
-  const rows: Array<Map<number, number>> = indexToId.map(() => new Map());
-
-  const addEdge = (
-    fromId: string,
-    toId: string,
-    strength: number,
-    scale: number,
-  ): void => {
-    if (strength <= 0 || scale <= 0) return;
-    const fromIdx = idToIndex.get(fromId);
-    const toIdx = idToIndex.get(toId);
-    if (fromIdx === undefined || toIdx === undefined) return;
-    if (fromIdx === toIdx) return;
-    const row = rows[fromIdx];
-    row.set(toIdx, (row.get(toIdx) ?? 0) + strength * scale);
-  };
-
-  if (direction === "out" || direction === "both") {
-    for (const [fromId, edges] of graph.adjacencyOut) {
-      for (const e of edges) {
-        addEdge(fromId, e.to_symbol_id, edgeStrength(e), 1.0);
+  const n = csr.nodeCount;
+  const { offsets, neighbors, weights } = csr;
+  const forward = direction === "out" || direction === "both";
+  const reverse = direction === "in" || direction === "both";
+  const reverseScale = direction === "both" ? REVERSE_EDGE_SCALE : 1.0;
+
+  const counts = new Uint32Array(n + 1);
+  for (let u = 0; u < n; u++) {
+    for (let e = offsets[u]; e < offsets[u + 1]; e++) {
+      const v = neighbors[e];
+      if (v === u || weights[e] <= 0) continue;
+      if (forward) counts[u + 1]++;
+      if (reverse) counts[v + 1]++;
+    }
+  }
+  for (let u = 0; u < n; u++) counts[u + 1] += counts[u];
+
+  const rawNeighbors = new Uint32Array(counts[n]);
+  const rawWeights = new Float64Array(counts[n]);
+  const cursor = counts.slice(0, n);
+  // Forward entries first, so each row lists its own edges before reversed ones.
+  if (forward) {
+    for (let u = 0; u < n; u++) {
+      for (let e = offsets[u]; e < offsets[u + 1]; e++) {
+        const v = neighbors[e];
+        if (v === u || weights[e] <= 0) continue;
+        const at = cursor[u]++;
+        rawNeighbors[at] = v;
+        rawWeights[at] = weights[e];
       }
     }
   }
-  if (direction === "in" || direction === "both") {
-    const reverseScale = direction === "both" ? REVERSE_EDGE_SCALE : 1.0;
-    for (const [toId, edges] of graph.adjacencyIn) {
-      for (const e of edges) {
-        // adjacencyIn maps `to` -> incoming edges. To walk "incoming edges as
-        // outgoing", we treat the original `to` as the new source.
-        addEdge(toId, e.from_symbol_id, edgeStrength(e), reverseScale);
+  if (reverse) {
+    for (let u = 0; u < n; u++) {
+      for (let e = offsets[u]; e < offsets[u + 1]; e++) {
+        const v = neighbors[e];
+        if (v === u || weights[e] <= 0) continue;
+        const at = cursor[v]++;
+        rawNeighbors[at] = u;
+        rawWeights[at] = weights[e] * reverseScale;
       }
     }
   }
 
-  // Convert to arrays. (Native side prefers Vec<Vec<(u32, f32)>>.)
-  const compactRows = rows.map((m) => {
-    const arr: Array<[number, number]> = [];
-    for (const [idx, w] of m) arr.push([idx, w]);
-    return arr;
-  });
+  // Sum multi-edges, keeping each neighbor at its first position in the row.
+  const outOffsets = new Uint32Array(n + 1);
+  const outNeighbors = new Uint32Array(counts[n]);
+  const outWeights = new Float64Array(counts[n]);
+  const slot = new Int32Array(n).fill(-1);
+  let size = 0;
+  for (let u = 0; u < n; u++) {
+    const rowStart = size;
+    for (let i = counts[u]; i < counts[u + 1]; i++) {
+      const v = rawNeighbors[i];
+      if (slot[v] >= rowStart) {
+        outWeights[slot[v]] += rawWeights[i];
+      } else {
+        slot[v] = size;
+        outNeighbors[size] = v;
+        outWeights[size] = rawWeights[i];
+        size++;
+      }
+    }
+    outOffsets[u + 1] = size;
+  }
 
-  return { rows: compactRows, idToIndex, indexToId };
+  const adjacency: PprAdjacency = {
+    offsets: outOffsets,
+    neighbors: outNeighbors.slice(0, size),
+    weights: outWeights.slice(0, size),
+  };
+  byDirection.set(direction, adjacency);
+  return adjacency;
+}
+
+/** Flatten per-row `(neighbor, weight)` lists into {@link PprAdjacency}. */
+function adjacencyFromRows(
+  rows: ReadonlyArray<ReadonlyArray<readonly [number, number]>>,
+): PprAdjacency {
+  const offsets = new Uint32Array(rows.length + 1);
+  for (let i = 0; i < rows.length; i++) {
+    offsets[i + 1] = offsets[i] + rows[i].length;
+  }
+  const neighbors = new Uint32Array(offsets[rows.length]);
+  const weights = new Float64Array(offsets[rows.length]);
+  for (let i = 0; i < rows.length; i++) {
+    const row = rows[i];
+    for (let j = 0; j < row.length; j++) {
+      neighbors[offsets[i] + j] = row[j][0];
+      weights[offsets[i] + j] = row[j][1];
+    }
+  }
+  return { offsets, neighbors, weights };
 }
 
 // ---------------------------------------------------------------------------
 // JS backend: Andersen-Chung-Lang forward-push
 // ---------------------------------------------------------------------------
 
+/**
+ * Pure-JS push-PPR over per-row adjacency lists; see {@link pushPprCsr}.
+ */
+export function pushPpr(
+  adjacency: ReadonlyArray<ReadonlyArray<readonly [number, number]>>,
+  seeds: ReadonlyArray<readonly [number, number]>,
+  alpha: number,
+  epsilon: number,
+  maxNodesTouched: number,
+): Float64Array {
+  return pushPprCsr(
+    adjacencyFromRows(adjacency),
+    seeds,
+    alpha,
+    epsilon,
+    maxNodesTouched,
+  );
+}
+
 /**
  * Pure-JS push-PPR. Mirrors the native implementation byte-for-byte (within
  * 1e-3) so the property test in `ppr-property.test.ts` passes regardless of
  * which backend ran.
  */
-export function pushPpr(
-  adjacency: ReadonlyArray<ReadonlyArray<readonly [number, number]>>,
+export function pushPprCsr(
+  adjacency: PprAdjacency,
   seeds: ReadonlyArray<readonly [number, number]>,
   alpha: number,
   epsilon: number,
   maxNodesTouched: number,
 ): Float64Array {
-  const n = adjacency.length;
+  const { offsets, neighbors, weights } = adjacency;
+  const n = offsets.length - 1;
   const p = new Float64Array(n);
   const r = new Float64Array(n);
 
@@ -190,8 +267,7 @@ export function pushPpr(
   const rowSums = new Float64Array(n);
   for (let i = 0; i < n; i++) {
     let sum = 0;
-    const row = adjacency[i];
-    for (let j = 0; j < row.length; j++) sum += row[j][1];
+    for (let e = offsets[i]; e < offsets[i + 1]; e++) sum += weights[e];
     rowSums[i] = sum;
   }
 
@@ -237,10 +313,9 @@ export function pushPpr(
     const remaining = (1 - alpha) * ru;
     r[u] = 0;
 
-    const row = adjacency[u];
-    for (let i = 0; i < row.length; i++) {
-      const [v, w] = row[i];
-      const delta = remaining * (w / deg);
+    for (let e = offsets[u]; e < offsets[u + 1]; e++) {
+      const v = neighbors[e];
+      const delta = remaining * (weights[e] / deg);
       r[v] += delta;
       if (touched[v] === 0) {
         touched[v] = 1;
@@ -262,11 +337,12 @@ export function pushPpr(
 
 /** Depth-3 BFS, scoring nodes inversely with hop distance. */
 function bfsFallback(
-  adjacency: ReadonlyArray<ReadonlyArray<readonly [number, number]>>,
+  adjacency: PprAdjacency,
   seedIndices: ReadonlyArray<number>,
   maxNodesTouched: number,
 ): Float64Array {
-  const n = adjacency.length;
+  const { offsets, neighbors } = adjacency;
+  const n = offsets.length - 1;
   const p = new Float64Array(n);
   const dist = new Int32Array(n);
   for (let i = 0; i < n; i++) dist[i] = -1;
@@ -288,9 +364,8 @@ function bfsFallback(
     const d = dist[u];
     if (d >= 3) continue;
     const score = 1 / (1 + d + 1);
-    const row = adjacency[u];
-    for (let i = 0; i < row.length; i++) {
-      const [v] = row[i];
+    for (let e = offsets[u]; e < offsets[u + 1]; e++) {
+      const v = neighbors[e];
       if (dist[v] === -1) {
         dist[v] = d + 1;
         p[v] = score;
@@ -309,21 +384,35 @@ function bfsFallback(
 
 interface NativePprBinding {
   (
-    adjacencyOut: Array<Array<[number, number]>>,
+    adjacency: PprAdjacency,
     seeds: Array<[number, number]>,
     alpha: number,
     epsilon: number,
     maxNodesTouched: number,
-  ): Array<[number, number]>;
+  ): Array<[number, number]> | null;
+}
+
+interface NativePprBatchBinding {
+  (
+    adjacency: PprAdjacency,
+    seedNodes: number[],
+    alpha: number,
+    epsilon: number,
+    maxNodesTouched: number,
+  ): SeedVector[] | null;
 }
 
 let cachedNativeBinding: NativePprBinding | null | undefined = undefined;
+let cachedNativeBatchBinding: NativePprBatchBinding | null = null;
 
 async function loadNativeBinding(): Promise<NativePprBinding | null> {
   if (cachedNativeBinding !== undefined) return cachedNativeBinding;
   try {
     const mod = await import("../indexer/rustIndexer.js");
-    const fn = mod.computePersonalizedPageRankRust;
+    const fn = mod.computePersonalizedPageRankCsrRust;
+    const batch = mod.computePersonalizedPageRankCsrBatchRust;
+    cachedNativeBatchBinding =
+      typeof batch === "function" ? (batch as NativePprBatchBinding) : null;
     if (typeof fn === "function") {
       cachedNativeBinding = fn as NativePprBinding;
       return cachedNativeBinding;
@@ -342,10 +431,170 @@ async function loadNativeBinding(): Promise<NativePprBinding | null> {
 /** Test-only hook: clear the cached binding so the next call re-resolves it. */
 export function _resetNativeBindingCache(): void {
   cachedNativeBinding = undefined;
+  cachedNativeBatchBinding = null;
+}
+
+// ---------------------------------------------------------------------------
+// Unit-seed vector cache
+// ---------------------------------------------------------------------------
+
+/**
+ * PPR vector for a single seed of weight 1, sparse and sorted by node.
+ * PPR is linear in the personalization vector, so a weighted seed set is
+ * served as the weighted sum of its seeds' vectors; concurrent sessions
+ * asking about overlapping symbols then mostly merge cached vectors.
+ */
+interface SeedVector {
+  nodes: Uint32Array;
+  scores: Float64Array;
+}
+
+interface SeedVectorEntry {
+  vector: SeedVector;
+  backend: "native" | "js";
+}
+
+/** adjacency (snapshot × direction) → walk parameters → seed node → vector */
+let seedVectorsByAdjacency = new WeakMap<
+  PprAdjacency,
+  Map<string, Map<number, SeedVectorEntry>>
+>();
+let seedVectorHits = 0;
+let seedVectorMisses = 0;
+
+/**
+ * Serve seeds from cached unit-seed vectors (the default). Set
+ * SDL_MCP_PPR_SEED_CACHE=0 to run one combined push per seed set instead.
+ */
+export function shouldUsePprSeedCache(
+  env: NodeJS.ProcessEnv = process.env,
+): boolean {
+  return !/^(0|false|no)$/i.test((env.SDL_MCP_PPR_SEED_CACHE ?? "").trim());
+}
+
+/** Unit-seed vector lookups served from cache vs computed, since startup. */
+export function getPprSeedCacheStats(): { hits: number; misses: number } {
+  return { hits: seedVectorHits, misses: seedVectorMisses };
+}
+
+function sparseVector(dense: Float64Array): SeedVector {
+  let count = 0;
+  for (let i = 0; i < dense.length; i++) if (dense[i] > 0) count++;
+  const nodes = new Uint32Array(count);
+  const scores = new Float64Array(count);
+  let at = 0;
+  for (let i = 0; i < dense.length; i++) {
+    if (dense[i] > 0) {
+      nodes[at] = i;
+      scores[at] = dense[i];
+      at++;
+    }
+  }
+  return { nodes, scores };
+}
+
+/**
+ * Weighted sum of the seeds' unit vectors. Missing vectors are computed in
+ * one native batch (or per seed in JS) and cached, evicting least recently
+ * used vectors past {@link SEED_VECTOR_CAP}.
+ */
+function combineSeedVectors(
+  adjacency: PprAdjacency,
+  seeds: ReadonlyArray<readonly [number, number]>,
+  alpha: number,
+  epsilon: number,
+  maxNodesTouched: number,
+): { scores: Float64Array; backend: "native" | "js" } {
+  let byParams = seedVectorsByAdjacency.get(adjacency);
+  if (!byParams) {
+    byParams = new Map();
+    seedVectorsByAdjacency.set(adjacency, byParams);
+  }
+  const paramsKey = `${alpha}|${epsilon}|${maxNodesTouched}`;
+  let vectors = byParams.get(paramsKey);
+  if (!vectors) {
+    vectors = new Map();
+    byParams.set(paramsKey, vectors);
+  }
+
+  const missing: number[] = [];
+  for (const [node] of seeds) {
+    const entry = vectors.get(node);
+    if (entry) {
+      // Touch for LRU ordering.
+      vectors.delete(node);
+      vectors.set(node, entry);
+      seedVectorHits++;
+    } else if (!missing.includes(node)) {
+      missing.push(node);
+    }
+  }
+
+  const computed = new Map<number, SeedVectorEntry>();
+  if (missing.length > 0) {
+    seedVectorMisses += missing.length;
+    let batch: SeedVector[] | null = null;
+    if (cachedNativeBatchBinding) {
+      try {
+        batch = cachedNativeBatchBinding(
+          adjacency,
+          missing,
+          alpha,
+          epsilon,
+          maxNodesTouched,
+        );
+      } catch (err) {
+        logger.debug(
+          `[ppr] native batch failed, falling back to JS: ${
+            err instanceof Error ? err.message : String(err)
+          }`,
+        );
+        batch = null;
+      }
+    }
+    for (let i = 0; i < missing.length; i++) {
+      const entry: SeedVectorEntry = batch
+        ? { vector: batch[i], backend: "native" }
+        : {
+            vector: sparseVector(
+              pushPprCsr(
+                adjacency,
+                [[missing[i], 1.0]],
+                alpha,
+                epsilon,
+                maxNodesTouched,
+              ),
+            ),
+            backend: "js",
+          };
+      computed.set(missing[i], entry);
+      vectors.set(missing[i], entry);
+    }
+    while (vectors.size > SEED_VECTOR_CAP) {
+      const oldest = vectors.keys().next().value;
+      if (oldest === undefined) break;
+      vectors.delete(oldest);
+    }
+  }
+
+  const scores = new Float64Array(adjacency.offsets.length - 1);
+  let backend: "native" | "js" = "native";
+  for (const [node, weight] of seeds) {
+    if (!Number.isFinite(weight) || weight <= 0) continue;
+    // Eviction above may drop a vector this call still needs.
+    const entry = computed.get(node) ?? vectors.get(node);
+    if (!entry) continue;
+    if (entry.backend === "js") backend = "js";
+    const { nodes, scores: unit } = entry.vector;
+    for (let i = 0; i < nodes.length; i++) {
+      scores[nodes[i]] += weight * unit[i];
+    }
+  }
+  return { scores, backend };
 }
 
 // ---------------------------------------------------------------------------
-// LRU cache (per repoId/snapshotCreatedAt/seedHash/alpha/direction)
+// LRU cache (per repoId/seedHash/alpha/direction)
 // ---------------------------------------------------------------------------
 
 const PPR_CACHE_CAP = 64;
@@ -354,20 +603,23 @@ const PPR_CACHE_TTL_MS = 5 * 60_000;
 interface CacheEntry {
   result: PprResult;
   expiresAt: number;
+  repoId: string;
+  /** Snapshot the result was computed on, or last served for. */
+  snapshotCreatedAt: number;
+  /** Seeds and scored symbols, for delta invalidation. */
+  symbols: SymbolIdFilter;
 }
 
 const cache = new Map<string, CacheEntry>();
 
 function cacheKey(parts: {
   repoId: string;
-  snapshotCreatedAt: number;
   seedHash: string;
   alpha: number;
   direction: PprDirection;
 }): string {
   return [
     parts.repoId,
-    parts.snapshotCreatedAt,
     parts.seedHash,
     parts.alpha.toFixed(4),
     parts.direction,
@@ -384,30 +636,86 @@ function seedHash(seeds: ReadonlyMap<string, number>): string {
   return entries.map(([id, w]) => `${id}:${w.toFixed(4)}`).join("|");
 }
 
-function cacheGet(key: string): PprResult | null {
+/**
+ * A result computed on an earlier snapshot is served (and re-stamped) when
+ * that snapshot shares a lineage with the current one: deltas in between
+ * already evicted every entry they touched.
+ */
+function cacheGet(
+  key: string,
+  repoId: string,
+  snapshotCreatedAt: number,
+): PprResult | null {
   const entry = cache.get(key);
   if (!entry) return null;
   if (Date.now() > entry.expiresAt) {
     cache.delete(key);
     return null;
   }
+  if (entry.snapshotCreatedAt !== snapshotCreatedAt) {
+    if (
+      !sharesGraphSnapshotLineage(
+        repoId,
+        entry.snapshotCreatedAt,
+        snapshotCreatedAt,
+      )
+    ) {
+      cache.delete(key);
+      return null;
+    }
+    entry.snapshotCreatedAt = snapshotCreatedAt;
+  }
   // Touch for LRU ordering.
   cache.delete(key);
   cache.set(key, entry);
   return entry.result;
 }
 
-function cacheSet(key: string, result: PprResult): void {
+function cacheSet(
+  key: string,
+  result: PprResult,
+  repoId: string,
+  snapshotCreatedAt: number,
+  seeds: ReadonlyMap<string, number>,
+): void {
   if (cache.size >= PPR_CACHE_CAP) {
     const oldest = cache.keys().next().value;
     if (oldest !== undefined) cache.delete(oldest);
   }
-  cache.set(key, { result, expiresAt: Date.now() + PPR_CACHE_TTL_MS });
+  cache.set(key, {
+    result,
+    expiresAt: Date.now() + PPR_CACHE_TTL_MS,
+    repoId,
+    snapshotCreatedAt,
+    symbols: SymbolIdFilter.from([...seeds.keys(), ...result.scores.keys()]),
+  });
+}
+
+/**
+ * Evict the repo's cached PPR results whose seeds or scored symbols may
+ * include any of `symbolIds`. Returns the number of entries evicted.
+ */
+export function invalidatePprCacheForSymbols(
+  repoId: string,
+  symbolIds: readonly string[],
+): number {
+  if (symbolIds.length === 0) return 0;
+  let evicted = 0;
+  for (const [key, entry] of Array.from(cache.entries())) {
+    if (entry.repoId !== repoId) continue;
+    if (!entry.symbols.intersects(symbolIds)) continue;
+    cache.delete(key);
+    evicted++;
+  }
+  return evicted;
 }
 
 /** Test-only: clear the cache so unit tests don't observe each other's state. */
 export function _clearPprCache(): void {
   cache.clear();
+  seedVectorsByAdjacency = new WeakMap();
+  seedVectorHits = 0;
+  seedVectorMisses = 0;
 }
 
 // ---------------------------------------------------------------------------
@@ -416,7 +724,10 @@ export function _clearPprCache(): void {
 
 export interface ComputePprInput {
   graph: Graph;
-  /** Snapshot creation timestamp (used as cache invalidation key). */
+  /**
+   * Snapshot creation timestamp. Cached results from another snapshot are
+   * reused only within the same snapshot lineage.
+   */
   snapshotCreatedAt: number;
   /** repoId for cache scoping. */
   repoId: string;
@@ -447,20 +758,20 @@ export async function computePpr(input: ComputePprInput): Promise<PprResult> {
 
   const key = cacheKey({
     repoId,
-    snapshotCreatedAt,
     seedHash: seedHash(options.seeds),
     alpha,
     direction,
   });
-  const cached = cacheGet(key);
+  const cached = cacheGet(key, repoId, snapshotCreatedAt);
   if (cached) return cached;
 
-  const adjacency = buildAdjacency(graph, direction);
+  const csr = getCsrSnapshot(graph);
+  const adjacency = buildAdjacency(csr, direction);
 
   // Map seeds to indices, dropping mentions absent from the graph.
   const seedIndices: Array<[number, number]> = [];
   for (const [id, weight] of options.seeds) {
-    const idx = adjacency.idToIndex.get(id);
+    const idx = csr.nodeOf(id);
     if (idx === undefined) continue;
     seedIndices.push([idx, weight]);
   }
@@ -472,12 +783,12 @@ export async function computePpr(input: ComputePprInput): Promise<PprResult> {
       touched: 0,
       computeMs: 0,
     };
-    cacheSet(key, empty);
+    cacheSet(key, empty, repoId, snapshotCreatedAt, options.seeds);
     return empty;
   }
 
   const sinkOnly = seedIndices.every(
-    ([idx]) => adjacency.rows[idx].length === 0,
+    ([idx]) => adjacency.offsets[idx + 1] === adjacency.offsets[idx],
   );
 
   let backend: PprResult["backend"];
@@ -487,17 +798,31 @@ export async function computePpr(input: ComputePprInput): Promise<PprResult> {
   if (sinkOnly) {
     backend = "fallback-bfs";
     scoresVec = bfsFallback(
-      adjacency.rows,
+      adjacency,
       seedIndices.map(([idx]) => idx),
       maxNodes,
     );
+  } else if (
+    shouldUsePprSeedCache() &&
+    seedIndices.length <= SEED_VECTOR_MAX_SEEDS
+  ) {
+    await loadNativeBinding();
+    const combined = combineSeedVectors(
+      adjacency,
+      seedIndices,
+      alpha,
+      epsilon,
+      maxNodes,
+    );
+    backend = combined.backend;
+    scoresVec = combined.scores;
   } else {
     const native = await loadNativeBinding();
     let nativeScores: Array<[number, number]> | null = null;
     if (native) {
       try {
         nativeScores = native(
-          adjacency.rows,
+          adjacency,
           seedIndices,
           alpha,
           epsilon,
@@ -517,8 +842,8 @@ export async function computePpr(input: ComputePprInput): Promise<PprResult> {
       scoresVec = nativeScores;
     } else {
       backend = "js";
-      scoresVec = pushPpr(
-        adjacency.rows,
+      scoresVec = pushPprCsr(
+        adjacency,
         seedIndices,
         alpha,
         epsilon,
@@ -535,9 +860,9 @@ export async function computePpr(input: ComputePprInput): Promise<PprResult> {
   if (Array.isArray(scoresVec)) {
     // Native path returns sparse array of (idx, score).
     for (const [idx, score] of scoresVec) {
-      if (idx < 0 || idx >= adjacency.indexToId.length) continue;
+      if (idx < 0 || idx >= csr.nodeCount) continue;
       if (!Number.isFinite(score) || score <= 0) continue;
-      const id = adjacency.indexToId[idx];
+      const id = csr.symbolIds[idx];
       scores.set(id, score);
       if (score > maxScore) maxScore = score;
     }
@@ -545,7 +870,7 @@ export async function computePpr(input: ComputePprInput): Promise<PprResult> {
     for (let i = 0; i < scoresVec.length; i++) {
       const score = scoresVec[i];
       if (!Number.isFinite(score) || score <= 0) continue;
-      scores.set(adjacency.indexToId[i], score);
+      scores.set(csr.symbolIds[i], score);
       if (score > maxScore) maxScore = score;
     }
   }
@@ -560,7 +885,8 @@ export async function computePpr(input: ComputePprInput): Promise<PprResult> {
     touched: scores.size,
     computeMs: Math.round(performance.now() - computeStart),
   };
-  cacheSet(key, result);
+  recordPhaseLatency("ppr", computeStart);
+  cacheSet(key, result, repoId, snapshotCreatedAt, options.seeds);
   return result;
 }
 
@@ -9,6 +9,9 @@
  *   2. shortId prefix (16-63 hex)   → expanded via `STARTS WITH` lookup.
  *   3. Bare name                    → top hybrid-search hit.
  *
+ * Lookups go to the native lexical index when the repo has one, and to
+ * LadybugDB otherwise.
+ *
  * Unresolved mentions are dropped silently and surfaced in `evidence` so
  * callers can debug why a seed had no effect.
  *
@@ -23,6 +26,11 @@ import {
   type RetrievalSeedCandidateRow,
 } from "../db/ladybug-retrieval.js";
 import { logger } from "../util/logger.js";
+import {
+  findLexicalSeedsByIdPrefix,
+  findLexicalSeedsByName,
+  hasLexicalSymbol,
+} from "./lexical-index.js";
 import { extractIdentifiersFromText } from "../agent/identifier-extraction.js";
 
 /** Cap on auto-extracted mentions; conservative vs. the schema's 20-mention max. */
@@ -93,7 +101,10 @@ async function existsFullId(
   symbolId: string,
 ): Promise<boolean> {
   try {
-    return await hasRetrievalSeedSymbol(conn, repoId, symbolId);
+    return (
+      hasLexicalSymbol(conn, repoId, symbolId) ??
+      (await hasRetrievalSeedSymbol(conn, repoId, symbolId))
+    );
   } catch (err) {
     logger.debug(
       `[seed-resolver] full-id lookup failed for ${symbolId.slice(0, 16)}: ${
@@ -110,7 +121,9 @@ async function expandShortId(
   prefix: string,
 ): Promise<string | null> {
   try {
-    const rows = await findRetrievalSeedSymbolsByIdPrefix(conn, repoId, prefix);
+    const rows =
+      findLexicalSeedsByIdPrefix(conn, repoId, prefix) ??
+      (await findRetrievalSeedSymbolsByIdPrefix(conn, repoId, prefix));
     if (rows.length === 0) return null;
     if (rows.length > 1) {
       logger.debug(
@@ -134,20 +147,19 @@ async function resolveBareName(
   repoId: string,
   name: string,
 ): Promise<{ symbolId: string | null; ambiguous: boolean }> {
-  // Direct lexical search via the durable Symbol FTS index. Avoids re-entering
-  // the hybrid orchestrator (which would itself try to resolve seeds and risk
-  // recursion). Top-2 are inspected to detect ambiguity.
+  // Direct name lookup via the lexical index or the durable Symbol rows.
+  // Avoids re-entering the hybrid orchestrator (which would itself try to
+  // resolve seeds and risk recursion). Top-2 are inspected to detect
+  // ambiguity.
   try {
     const rows: RetrievalSeedCandidateRow[] =
-      await findRetrievalSeedSymbolsByName(conn, repoId, name, "exact");
+      findLexicalSeedsByName(conn, repoId, name, "exact") ??
+      (await findRetrievalSeedSymbolsByName(conn, repoId, name, "exact"));
     if (rows.length === 0) {
       // Fall back to prefix match for camelCase / partial name input.
-      const prefixRows = await findRetrievalSeedSymbolsByName(
-        conn,
-        repoId,
-        name,
-        "prefix",
-      );
+      const prefixRows =
+        findLexicalSeedsByName(conn, repoId, name, "prefix") ??
+        (await findRetrievalSeedSymbolsByName(conn, repoId, name, "prefix"));
       if (prefixRows.length === 0) {
         return { symbolId: null, ambiguous: false };
       }
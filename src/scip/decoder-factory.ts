@@ -7,6 +7,7 @@
 
 import type { ScipDecoder } from "./types.js";
 import { TypeScriptScipDecoder } from "./decoder-ts.js";
+import { SCIP_MAX_INDEX_BYTES } from "./limits.js";
 import { logger } from "../util/logger.js";
 
 /**
@@ -44,3 +45,14 @@ export async function getDecoderBackend(): Promise<"rust" | "typescript"> {
   }
   return "typescript";
 }
+
+/**
+ * Largest SCIP index file the preferred decoder accepts. The native decoder
+ * streams one document at a time and is bounded only by the largest
+ * document, so it has no whole-file cap.
+ */
+export async function getDecoderMaxIndexBytes(): Promise<number> {
+  return (await getDecoderBackend()) === "rust"
+    ? Number.POSITIVE_INFINITY
+    : SCIP_MAX_INDEX_BYTES;
+}
@@ -97,9 +97,14 @@ interface NapiScipMetadata {
 interface NapiScipDecodeHandle {
   metadata(): NapiScipMetadata;
   nextDocument(): NapiScipDocument | null;
+  /** Off-thread batch decode; absent on addons built before it existed. */
+  nextDocuments?(maxDocuments: number): Promise<NapiScipDocument[]>;
   externalSymbols(): NapiScipExternalSymbol[];
 }
 
+/** Documents requested per `nextDocuments` call. */
+const DOCUMENT_BATCH_SIZE = 16;
+
 /** Subset of the native addon that includes SCIP decoder exports. */
 interface ScipNativeAddon {
   scipDecodeStart(filePath: string): NapiScipDecodeHandle;
@@ -231,7 +236,9 @@ export function isRustScipDecoderAvailable(): boolean {
  *
  * Uses the napi-rs native addon to decode protobuf SCIP index files.
  * Documents are yielded one at a time via an async generator to support
- * streaming consumption of large SCIP indexes.
+ * streaming consumption of large SCIP indexes; when the addon exposes
+ * `nextDocuments`, the next batch decodes off the main thread while the
+ * caller consumes the current one.
  */
 export class RustScipDecoder implements ScipDecoder {
   private handle: NapiScipDecodeHandle | null = null;
@@ -268,6 +275,19 @@ export class RustScipDecoder implements ScipDecoder {
 
   async *documents(): AsyncGenerator<ScipDocument> {
     const handle = this.ensureHandle();
+    if (typeof handle.nextDocuments === "function") {
+      // Keep one batch decoding on the thread pool while the caller consumes
+      // the current one.
+      let pending = handle.nextDocuments(DOCUMENT_BATCH_SIZE);
+      for (;;) {
+        const batch = await pending;
+        if (batch.length === 0) return;
+        pending = handle.nextDocuments(DOCUMENT_BATCH_SIZE);
+        // Avoid an unhandled rejection if the caller stops iterating early.
+        pending.catch(() => {});
+        for (const doc of batch) yield mapDocument(doc);
+      }
+    }
     let doc = handle.nextDocument();
     while (doc !== null) {
       yield mapDocument(doc);
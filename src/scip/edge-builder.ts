@@ -117,12 +117,24 @@ export function findContainingSymbol(
 // buildContainingSymbolMap
 // ---------------------------------------------------------------------------
 
+/**
+ * Widest span of occurrence lines (1-based) resolved with the line sweep in
+ * {@link buildContainingSymbolMap}; wider spans (only possible with corrupt
+ * ranges) scan per occurrence instead.
+ */
+const CONTAINING_SWEEP_MAX_LINES = 1 << 20;
+
 /**
  * Build a map from occurrence index to the containing SDL symbol ID.
  *
  * For each occurrence, we find which SDL symbol's range contains it.
  * SCIP ranges are 0-based; SDL ranges are 1-based — normalization is
- * handled by {@link findContainingSymbol}.
+ * handled as in {@link findContainingSymbol}, with the same tie-breaking
+ * (narrowest range, then the earliest symbol in `sdlSymbolsInFile`).
+ *
+ * Rather than scanning every symbol per occurrence, symbols are visited
+ * narrowest first and each one claims the still-unclaimed lines it covers,
+ * so the cost is linear in occurrences, symbols and spanned lines.
  */
 export function buildContainingSymbolMap(
   occurrences: ScipOccurrence[],
@@ -133,15 +145,74 @@ export function buildContainingSymbolMap(
   }>,
 ): Map<number, SymbolId> {
   const map = new Map<number, SymbolId>();
+  if (occurrences.length === 0 || sdlSymbolsInFile.length === 0) return map;
+
+  let lo = Infinity;
+  let hi = -Infinity;
+  for (const occ of occurrences) {
+    const line = occ.range.startLine + 1;
+    if (line < lo) lo = line;
+    if (line > hi) hi = line;
+  }
+  const width = hi - lo + 1;
+  if (!Number.isSafeInteger(width) || width > CONTAINING_SWEEP_MAX_LINES) {
+    for (let i = 0; i < occurrences.length; i++) {
+      const containingId = findContainingSymbol(
+        occurrences[i].range,
+        sdlSymbolsInFile,
+      );
+      if (containingId !== null) map.set(i, containingId);
+    }
+    return map;
+  }
 
-  for (let i = 0; i < occurrences.length; i++) {
-    const occ = occurrences[i];
-    const containingId = findContainingSymbol(occ.range, sdlSymbolsInFile);
-    if (containingId !== null) {
-      map.set(i, containingId);
+  const order: number[] = [];
+  for (let s = 0; s < sdlSymbolsInFile.length; s++) {
+    const sym = sdlSymbolsInFile[s];
+    if (
+      Number.isFinite(sym.rangeStartLine) &&
+      Number.isFinite(sym.rangeEndLine) &&
+      sym.rangeStartLine <= sym.rangeEndLine
+    ) {
+      order.push(s);
+    }
+  }
+  const span = (s: number): number =>
+    sdlSymbolsInFile[s].rangeEndLine - sdlSymbolsInFile[s].rangeStartLine;
+  order.sort((a, b) => span(a) - span(b) || a - b);
+
+  // owner[line - lo] = index of the narrowest symbol covering that line.
+  // next[] links each line to the next unclaimed one (path-compressed), so
+  // every line is claimed at most once.
+  const owner = new Int32Array(width).fill(-1);
+  const next = new Int32Array(width + 1);
+  for (let i = 0; i <= width; i++) next[i] = i;
+  const unclaimedFrom = (i: number): number => {
+    let root = i;
+    while (next[root] !== root) root = next[root];
+    while (next[i] !== root) {
+      const following = next[i];
+      next[i] = root;
+      i = following;
+    }
+    return root;
+  };
+
+  for (const s of order) {
+    const sym = sdlSymbolsInFile[s];
+    const first = Math.max(Math.ceil(sym.rangeStartLine), lo) - lo;
+    const last = Math.min(Math.floor(sym.rangeEndLine), hi) - lo;
+    if (first > last) continue;
+    for (let i = unclaimedFrom(first); i <= last; i = unclaimedFrom(i + 1)) {
+      owner[i] = s;
+      next[i] = i + 1;
     }
   }
 
+  for (let i = 0; i < occurrences.length; i++) {
+    const s = owner[occurrences[i].range.startLine + 1 - lo];
+    if (s >= 0) map.set(i, sdlSymbolsInFile[s].symbolId);
+  }
   return map;
 }
 
@@ -16,7 +16,7 @@ import { resolve, isAbsolute } from "node:path";
 import type { ScipConfig } from "../config/types.js";
 import { getRepo, getFileByRepoPath } from "../db/ladybug-repos.js";
 import {
-  mergeScipSymbolProperties,
+  batchMergeScipSymbolProperties,
   batchMergeScipEdges,
   batchMergeExternalSymbols,
   mergeScipIngestionRecord,
@@ -33,6 +33,7 @@ import {
 import { withTransaction } from "../db/ladybug-core.js";
 import { ScipFileNotFoundError, ScipIngestionError } from "../domain/errors.js";
 import type { SymbolId } from "../domain/types.js";
+import { BoundedQueue } from "../util/concurrency.js";
 import { logger } from "../util/logger.js";
 import {
   getRelativePath,
@@ -54,11 +55,14 @@ import { createExternalSymbol } from "./external-symbols.js";
 import type { ExternalSymbolRow } from "./external-symbols.js";
 import { isExternalSymbol } from "./kind-mapping.js";
 import { buildSymbolMatchMap, SCIP_ROLE_DEFINITION } from "./symbol-matcher.js";
+import type { SdlSymbolForMatching } from "./symbol-matcher.js";
 import type {
   ScipDecoder,
+  ScipDocument,
   ScipFileCoverage,
   ScipIngestRequest,
   ScipIngestResponse,
+  ScipSymbolMatch,
 } from "./types.js";
 
 // ---------------------------------------------------------------------------
@@ -139,6 +143,218 @@ function scopedIngestionRecordPath(
   return `${normalizedIndexPath}#languages=${[...languageFilter].join(",")}`;
 }
 
+// ---------------------------------------------------------------------------
+// Pipelined document stages
+// ---------------------------------------------------------------------------
+
+/** Documents the prefetch stage may run ahead of the matching loop. */
+const SCIP_PREFETCH_DOCUMENTS = 8;
+
+/** A write batch is submitted once it spans this many documents... */
+const SCIP_WRITE_BATCH_DOCUMENTS = 32;
+
+/** ...or holds this many property/edge rows, whichever comes first. */
+const SCIP_WRITE_BATCH_ROWS = 4096;
+
+/** Submitted write batches allowed to wait on the write connection. */
+const SCIP_WRITE_QUEUE_DEPTH = 2;
+
+/**
+ * Whether SCIP ingestion overlaps decoding, symbol loading, matching and
+ * graph writes. On by default; `SDL_MCP_SCIP_PIPELINE=0` steps the stages in
+ * lockstep with one write transaction per document.
+ */
+export function shouldPipelineScipIngest(
+  env: NodeJS.ProcessEnv = process.env,
+): boolean {
+  return !/^(0|false|no)$/i.test((env.SDL_MCP_SCIP_PIPELINE ?? "").trim());
+}
+
+interface PrefetchedScipDocument {
+  doc: ScipDocument;
+  relPath: string;
+  sdlSymbols: SdlSymbolForMatching[];
+}
+
+interface ScipSymbolPropertyUpdate {
+  symbolId: string;
+  scipSymbol: string;
+  source: "both";
+}
+
+interface ScipEdgeReplacement {
+  sourceId: string;
+  oldTargetId: string;
+  newTargetId: string;
+  edgeType: string;
+  confidence: number;
+  resolution: string;
+  resolverId: string;
+  resolutionPhase: string;
+}
+
+interface ScipDocumentWrites {
+  symbolUpdates: ScipSymbolPropertyUpdate[];
+  edgeCreates: ScipEdgeDescriptor[];
+  edgeReplaces: ScipEdgeReplacement[];
+}
+
+/**
+ * Match entries for the symbols `doc` references: the document's own
+ * matches, else the combined map built from earlier documents and external
+ * symbols. Only referenced symbols are looked up, so the cost per document
+ * does not grow with the size of the combined map.
+ */
+function resolveReferencedSymbols(
+  doc: ScipDocument,
+  docMatches: ReadonlyMap<string, ScipSymbolMatch>,
+  scipSymbolToId: ReadonlyMap<string, SymbolId>,
+): Map<string, ScipSymbolMatch> {
+  const resolved = new Map<string, ScipSymbolMatch>();
+  for (const occ of doc.occurrences) {
+    if (occ.symbolRoles & SCIP_ROLE_DEFINITION) continue;
+    if (resolved.has(occ.symbol)) continue;
+    const match = docMatches.get(occ.symbol);
+    if (match) {
+      resolved.set(occ.symbol, match);
+      continue;
+    }
+    const sdlId = scipSymbolToId.get(occ.symbol);
+    if (sdlId !== undefined) {
+      resolved.set(occ.symbol, {
+        scipSymbol: occ.symbol,
+        sdlSymbolId: sdlId,
+        matchType: "external",
+        kindMismatch: false,
+      });
+    }
+  }
+  return resolved;
+}
+
+/**
+ * Write stage of SCIP ingestion. Per-document writes are accumulated into
+ * batches; each batch is written in one transaction, strictly in submission
+ * order, while the caller moves on to the next documents. At most
+ * `SCIP_WRITE_QUEUE_DEPTH` batches are outstanding before `add` waits, and
+ * a write failure surfaces from the next `add` or `flush`.
+ */
+class ScipWriteStage {
+  private current = ScipWriteStage.emptyBatch();
+  private readonly outstanding: Array<{
+    done: Promise<void>;
+    relPaths: ReadonlySet<string>;
+    settled: boolean;
+  }> = [];
+  private tail: Promise<void> = Promise.resolve();
+
+  constructor(private readonly pipelined: boolean) {}
+
+  private static emptyBatch(): ScipDocumentWrites & {
+    relPaths: Set<string>;
+    rows: number;
+  } {
+    return {
+      symbolUpdates: [],
+      edgeCreates: [],
+      edgeReplaces: [],
+      relPaths: new Set(),
+      rows: 0,
+    };
+  }
+
+  /** Whether writes for `relPath` are queued but not yet committed. */
+  hasPending(relPath: string): boolean {
+    return (
+      this.current.relPaths.has(relPath) ||
+      this.outstanding.some(
+        (entry) => !entry.settled && entry.relPaths.has(relPath),
+      )
+    );
+  }
+
+  async add(relPath: string, writes: ScipDocumentWrites): Promise<void> {
+    const batch = this.current;
+    for (const update of writes.symbolUpdates) batch.symbolUpdates.push(update);
+    for (const edge of writes.edgeCreates) batch.edgeCreates.push(edge);
+    for (const op of writes.edgeReplaces) batch.edgeReplaces.push(op);
+    batch.relPaths.add(relPath);
+    batch.rows +=
+      writes.symbolUpdates.length +
+      writes.edgeCreates.length +
+      writes.edgeReplaces.length;
+
+    if (!this.pipelined) {
+      await this.flush();
+    } else if (
+      batch.relPaths.size >= SCIP_WRITE_BATCH_DOCUMENTS ||
+      batch.rows >= SCIP_WRITE_BATCH_ROWS
+    ) {
+      await this.submit();
+    }
+  }
+
+  /** Submit the open batch and wait until every batch is committed. */
+  async flush(): Promise<void> {
+    await this.submit();
+    while (this.outstanding.length > 0) {
+      await this.outstanding.shift()!.done;
+    }
+  }
+
+  /** Wait for outstanding writes without surfacing their errors. */
+  async settle(): Promise<void> {
+    await this.tail.catch(() => {});
+  }
+
+  private async submit(): Promise<void> {
+    const batch = this.current;
+    if (batch.rows === 0) {
+      this.current.relPaths.clear();
+      return;
+    }
+    while (this.outstanding.length >= SCIP_WRITE_QUEUE_DEPTH) {
+      await this.outstanding.shift()!.done;
+    }
+    this.current = ScipWriteStage.emptyBatch();
+    const entry = {
+      done: this.tail.then(() => writeScipBatch(batch)),
+      relPaths: batch.relPaths,
+      settled: false,
+    };
+    // Mark settlement and keep failures from being reported as unhandled;
+    // the error is rethrown to whoever awaits `entry.done`.
+    entry.done.then(
+      () => {
+        entry.settled = true;
+      },
+      () => {
+        entry.settled = true;
+      },
+    );
+    this.tail = entry.done;
+    this.outstanding.push(entry);
+  }
+}
+
+async function writeScipBatch(batch: ScipDocumentWrites): Promise<void> {
+  await withWriteConn(async (wConn) => {
+    await withTransaction(wConn, async (txConn) => {
+      if (batch.symbolUpdates.length > 0) {
+        await batchMergeScipSymbolProperties(txConn, batch.symbolUpdates);
+      }
+
+      if (batch.edgeCreates.length > 0) {
+        await batchMergeScipEdges(txConn, batch.edgeCreates);
+      }
+
+      if (batch.edgeReplaces.length > 0) {
+        await batchReplaceEdgeTargets(txConn, batch.edgeReplaces);
+      }
+    });
+  });
+}
+
 // ---------------------------------------------------------------------------
 // Main pipeline
 // ---------------------------------------------------------------------------
@@ -151,7 +367,9 @@ function scopedIngestionRecordPath(
  *   2. Check for redundant ingestion (content-hash dedup)
  *   3. Initialize decoder (Rust or TS fallback)
  *   4. Ingest external symbols (if enabled)
- *   5. Iterate documents: match symbols, build edges, write to DB
+ *   5. Iterate documents: match symbols, build edges, write to DB. Symbol
+ *      loading runs ahead of matching and batched writes trail behind it
+ *      (see `shouldPipelineScipIngest`)
  *   6. Write ingestion metadata
  *   7. Close decoder and return response
  *
@@ -373,117 +591,127 @@ export async function ingestScipIndex(
       edges: 0,
     });
 
-    for await (const doc of decoder.documents()) {
-      const relPath = normalizePath(doc.relativePath);
-      if (languageFilter && !languageFilter.has(doc.language)) {
-        documentsSkipped++;
-        continue;
-      }
-
-      // Check if SDL has indexed this file
-      const fileRow = await getFileByRepoPath(conn, request.repoId, relPath);
-      if (!fileRow) {
-        documentsSkipped++;
-        continue;
-      }
-
-      documentsProcessed++;
-
-      // Load existing SDL symbols for this file
-      const sdlSymbols = await getSymbolsForFile(conn, request.repoId, relPath);
+    // Stage 1 (prefetch) runs ahead of the matching loop: it pulls decoded
+    // documents (the Rust decoder decodes the next batch off-thread) and
+    // loads each file's SDL symbols. Stage 3 (writes) trails behind through
+    // `writes`. The matching loop itself stays sequential so the global
+    // SCIP symbol map grows in document order, exactly as before.
+    const pipelined = shouldPipelineScipIngest();
+    const prefetched = new BoundedQueue<PrefetchedScipDocument>(
+      pipelined ? SCIP_PREFETCH_DOCUMENTS : 1,
+    );
+    const writes = new ScipWriteStage(pipelined);
+    const prefetch = (async (decoder: ScipDecoder) => {
+      try {
+        for await (const doc of decoder.documents()) {
+          const relPath = normalizePath(doc.relativePath);
+          if (languageFilter && !languageFilter.has(doc.language)) {
+            documentsSkipped++;
+            continue;
+          }
 
-      // Build match map: SCIP symbol -> SDL symbol
-      const { matches: matchMap, skippedCount } = buildSymbolMatchMap(
-        doc,
-        sdlSymbols,
-      );
-      skippedSymbols += skippedCount;
-
-      // Process matched/created symbols
-      for (const [, match] of Array.from(matchMap.entries())) {
-        if (match.matchType === "exact" || match.matchType === "nameOnly") {
-          symbolsMatched++;
-          if (!dryRun) {
-            await withWriteConn(async (wConn) => {
-              await mergeScipSymbolProperties(wConn, match.sdlSymbolId, {
-                scipSymbol: match.scipSymbol,
-                source: "both",
-              });
-            });
+          // Check if SDL has indexed this file
+          const fileRow = await getFileByRepoPath(
+            conn,
+            request.repoId,
+            relPath,
+          );
+          if (!fileRow) {
+            documentsSkipped++;
+            continue;
           }
-        }
 
-        // Register in the combined symbol map for edge resolution
-        scipSymbolToId.set(match.scipSymbol, match.sdlSymbolId);
+          // Load existing SDL symbols for this file
+          const sdlSymbols = await getSymbolsForFile(
+            conn,
+            request.repoId,
+            relPath,
+          );
+          await prefetched.push({ doc, relPath, sdlSymbols });
+        }
+        prefetched.close();
+      } catch (err) {
+        prefetched.fail(err);
       }
+    })(decoder);
+
+    try {
+      for await (const { doc, relPath, sdlSymbols } of prefetched) {
+        documentsProcessed++;
+
+        // Build match map: SCIP symbol -> SDL symbol
+        const { matches: matchMap, skippedCount } = buildSymbolMatchMap(
+          doc,
+          sdlSymbols,
+        );
+        skippedSymbols += skippedCount;
+
+        // Process matched/created symbols
+        const symbolUpdates: ScipSymbolPropertyUpdate[] = [];
+        for (const match of matchMap.values()) {
+          if (match.matchType === "exact" || match.matchType === "nameOnly") {
+            symbolsMatched++;
+            symbolUpdates.push({
+              symbolId: match.sdlSymbolId,
+              scipSymbol: match.scipSymbol,
+              source: "both",
+            });
+          }
 
-      // Build containing-symbol map for reference occurrences
-      const containingMap = buildContainingSymbolMap(
-        doc.occurrences,
-        sdlSymbols,
-      );
-
-      // Merge match map with external symbol map for edge resolution
-      const allMatchMap = new Map(matchMap);
-      for (const [scipSym, sdlId] of Array.from(scipSymbolToId.entries())) {
-        if (!allMatchMap.has(scipSym)) {
-          allMatchMap.set(scipSym, {
-            scipSymbol: scipSym,
-            sdlSymbolId: sdlId,
-            matchType: "external",
-            kindMismatch: false,
-          });
+          // Register in the combined symbol map for edge resolution
+          scipSymbolToId.set(match.scipSymbol, match.sdlSymbolId);
         }
-      }
 
-      // Build edges from reference occurrences
-      const rawEdges = buildEdgesFromOccurrences(
-        doc,
-        allMatchMap,
-        containingMap,
-        config.confidence,
-      );
+        // Build containing-symbol map for reference occurrences
+        const containingMap = buildContainingSymbolMap(
+          doc.occurrences,
+          sdlSymbols,
+        );
+
+        // Build edges from reference occurrences, resolving targets through
+        // this document's matches first and then the combined map.
+        const rawEdges = buildEdgesFromOccurrences(
+          doc,
+          resolveReferencedSymbols(doc, matchMap, scipSymbolToId),
+          containingMap,
+          config.confidence,
+        );
+
+        // Edges read below are keyed by source symbols of this file, so
+        // pending writes only matter when the index repeats a path.
+        if (writes.hasPending(relPath)) {
+          await writes.flush();
+        }
 
-      // Batch-fetch existing edges for all (source, target) pairs
-      const edgePairs = rawEdges.map((e) => ({
-        sourceId: e.sourceSymbolId,
-        targetId: e.targetSymbolId,
-      }));
-      const existingEdgesMap = await batchGetExistingEdges(conn, edgePairs);
-
-      // Classify and apply each edge action
-      const edgeBatchCreate: typeof rawEdges = [];
-      const edgeBatchReplace: Array<{
-        sourceId: string;
-        oldTargetId: string;
-        newTargetId: string;
-        edgeType: string;
-        confidence: number;
-        resolution: string;
-        resolverId: string;
-        resolutionPhase: string;
-      }> = [];
-
-      for (const edge of rawEdges) {
-        const key = `${edge.sourceSymbolId}:${edge.targetSymbolId}:${edge.edgeType}`;
-        const existingRaw = existingEdgesMap.get(key) ?? null;
-
-        // Construct ExistingEdge with source/target for classifyEdgeAction
-        const existingEdge: ExistingEdge | null = existingRaw
-          ? {
-              sourceSymbolId: edge.sourceSymbolId,
-              targetSymbolId: edge.targetSymbolId,
-              edgeType: existingRaw.edgeType as ScipEdgeDescriptor["edgeType"],
-              confidence: existingRaw.confidence,
-              resolution: existingRaw.resolution,
-              resolverId: existingRaw.resolverId,
-            }
-          : null;
-
-        const action = classifyEdgeAction(existingEdge, edge);
+        // Batch-fetch existing edges for all (source, target) pairs
+        const edgePairs = rawEdges.map((e) => ({
+          sourceId: e.sourceSymbolId,
+          targetId: e.targetSymbolId,
+        }));
+        const existingEdgesMap = await batchGetExistingEdges(conn, edgePairs);
+
+        // Classify and apply each edge action
+        const edgeBatchCreate: typeof rawEdges = [];
+        const edgeBatchReplace: ScipEdgeReplacement[] = [];
+
+        for (const edge of rawEdges) {
+          const key = `${edge.sourceSymbolId}:${edge.targetSymbolId}:${edge.edgeType}`;
+          const existingRaw = existingEdgesMap.get(key) ?? null;
+
+          // Construct ExistingEdge with source/target for classifyEdgeAction
+          const existingEdge: ExistingEdge | null = existingRaw
+            ? {
+                sourceSymbolId: edge.sourceSymbolId,
+                targetSymbolId: edge.targetSymbolId,
+                edgeType:
+                  existingRaw.edgeType as ScipEdgeDescriptor["edgeType"],
+                confidence: existingRaw.confidence,
+                resolution: existingRaw.resolution,
+                resolverId: existingRaw.resolverId,
+              }
+            : null;
 
-        if (!dryRun) {
-          switch (action) {
+          switch (classifyEdgeAction(existingEdge, edge)) {
             case "create":
               edgeBatchCreate.push(edge);
               edgesCreated++;
@@ -511,104 +739,90 @@ export async function ingestScipIndex(
               // No action needed
               break;
           }
-        } else {
-          // Dry run — just count
-          switch (action) {
-            case "create":
-              edgesCreated++;
-              break;
-            case "upgrade":
-              edgesUpgraded++;
-              break;
-            case "replace":
-              edgesReplaced++;
-              break;
-            case "skip":
-              break;
-          }
         }
-      }
 
-      // Batch write created/upgraded/replaced edges in one transaction per
-      // document so a partially failed update cannot leave the edge set in
-      // a mixed state.
-      if (
-        !dryRun &&
-        (edgeBatchCreate.length > 0 || edgeBatchReplace.length > 0)
-      ) {
-        await withWriteConn(async (wConn) => {
-          await withTransaction(wConn, async (txConn) => {
-            if (edgeBatchCreate.length > 0) {
-              await batchMergeScipEdges(txConn, edgeBatchCreate);
-            }
-
-            if (edgeBatchReplace.length > 0) {
-              await batchReplaceEdgeTargets(txConn, edgeBatchReplace);
-            }
+        // Queue the document's writes. Batches of documents are written in
+        // one transaction each, so a partially failed update cannot leave a
+        // document's edge set in a mixed state.
+        if (!dryRun) {
+          await writes.add(relPath, {
+            symbolUpdates,
+            edgeCreates: edgeBatchCreate,
+            edgeReplaces: edgeBatchReplace,
           });
+        }
+
+        // Track unresolved from this document. We count distinct symbols per
+        // document for `unresolvedOccurrences` (so a single unresolved
+        // function with N call sites contributes 1 rather than N — preserves
+        // prior operator-facing semantics) BUT also produce a per-document
+        // coverage row that counts CALLABLE REFERENCE OCCURRENCES
+        // (per-occurrence, not per-unique-symbol). The latter feeds the
+        // pass-2 file-skip optimisation — pass-2 resolves per call site, so
+        // its skip predicate must reason per occurrence. Definitions are
+        // excluded since they are not "calls to resolve"; empty /
+        // local-prefixed symbols are excluded since they never produce
+        // cross-file edges.
+        const unresolvedInDoc = new Set<string>();
+        let docTotalRefs = 0;
+        let docMatchedRefs = 0;
+        let docUnresolvedRefs = 0;
+        for (const occ of doc.occurrences) {
+          if (occ.symbolRoles & SCIP_ROLE_DEFINITION) continue;
+          if (occ.symbol === "" || occ.symbol.startsWith("local ")) continue;
+          docTotalRefs++;
+          if (
+            scipSymbolToId.has(occ.symbol) ||
+            isExternalSymbol(occ.symbol, metadata.projectRoot)
+          ) {
+            docMatchedRefs++;
+          } else {
+            docUnresolvedRefs++;
+            unresolvedInDoc.add(occ.symbol);
+          }
+        }
+        unresolvedOccurrences += unresolvedInDoc.size;
+        perFileCoverage.push({
+          relPath,
+          total: docTotalRefs,
+          matched: docMatchedRefs,
+          unresolved: docUnresolvedRefs,
         });
-      }
 
-      // Track unresolved from this document. We count distinct symbols per
-      // document for `unresolvedOccurrences` (so a single unresolved function
-      // with N call sites contributes 1 rather than N — preserves prior
-      // operator-facing semantics) BUT also produce a per-document coverage
-      // row that counts CALLABLE REFERENCE OCCURRENCES (per-occurrence, not
-      // per-unique-symbol). The latter feeds the pass-2 file-skip optimisation
-      // — pass-2 resolves per call site, so its skip predicate must reason
-      // per occurrence. Definitions are excluded since they are not "calls
-      // to resolve"; empty / local-prefixed symbols are excluded since they
-      // never produce cross-file edges.
-      const matchedScipSymbols = new Set(scipSymbolToId.keys());
-      const unresolvedInDoc = new Set<string>();
-      let docTotalRefs = 0;
-      let docMatchedRefs = 0;
-      let docUnresolvedRefs = 0;
-      for (const occ of doc.occurrences) {
-        if (occ.symbolRoles & SCIP_ROLE_DEFINITION) continue;
-        if (occ.symbol === "" || occ.symbol.startsWith("local ")) continue;
-        docTotalRefs++;
-        if (
-          matchedScipSymbols.has(occ.symbol) ||
-          isExternalSymbol(occ.symbol, metadata.projectRoot)
-        ) {
-          docMatchedRefs++;
-        } else {
-          docUnresolvedRefs++;
-          unresolvedInDoc.add(occ.symbol);
+        // Log + emit progress every 50 documents. We don't know the total
+        // upfront with the streaming decoder, so progress is reported as a
+        // counter snapshot (current + running totals) rather than a
+        // percentage.
+        if (documentsProcessed % 50 === 0) {
+          logger.info("SCIP ingestion progress", {
+            documentsProcessed,
+            documentsSkipped,
+            symbolsMatched,
+            edgesCreated,
+          });
+          onProgress?.({
+            phase: "documents",
+            current: documentsProcessed,
+            matched: symbolsMatched,
+            edges: edgesCreated,
+          });
         }
-      }
-      unresolvedOccurrences += unresolvedInDoc.size;
-      perFileCoverage.push({
-        relPath,
-        total: docTotalRefs,
-        matched: docMatchedRefs,
-        unresolved: docUnresolvedRefs,
-      });
 
-      // Log + emit progress every 50 documents. We don't know the total
-      // upfront with the streaming decoder, so progress is reported as a
-      // counter snapshot (current + running totals) rather than a percentage.
-      if (documentsProcessed % 50 === 0) {
-        logger.info("SCIP ingestion progress", {
-          documentsProcessed,
-          documentsSkipped,
-          symbolsMatched,
-          edgesCreated,
-        });
-        onProgress?.({
-          phase: "documents",
-          current: documentsProcessed,
-          matched: symbolsMatched,
-          edges: edgesCreated,
-        });
+        // Do not run manual CHECKPOINT here. On LadybugDB 0.16.0 / Windows,
+        // a checkpoint can leave a native checkpoint task active while SCIP
+        // continues issuing read/write work, which can terminate the process
+        // with 0xC0000005. Startup and shutdown still perform best-effort
+        // WAL cleanup; SCIP's document loop must stay free of manual
+        // checkpoints.
       }
-
-      // Do not run manual CHECKPOINT here. On LadybugDB 0.16.0 / Windows,
-      // a checkpoint can leave a native checkpoint task active while SCIP
-      // continues issuing read/write work, which can terminate the process
-      // with 0xC0000005. Startup and shutdown still perform best-effort WAL
-      // cleanup; SCIP's document loop must stay free of manual checkpoints.
+      await writes.flush();
+    } catch (err) {
+      // Stop the prefetch stage; it fails its next push and exits.
+      prefetched.fail(err);
+      throw err;
+    } finally {
+      await prefetch;
+      await writes.settle();
     }
 
     // Final tick after the last document so CLI renderers land on a clean
@@ -1,3 +1,7 @@
-/** Hard decoder cap for one SCIP protobuf index file. */
+/**
+ * Hard cap for one SCIP protobuf index file in the TypeScript decoder, which
+ * loads the whole index into memory. The native decoder streams documents
+ * from disk and has no whole-file cap.
+ */
 export const SCIP_MAX_INDEX_BYTES = 512 * 1024 * 1024;
 
@@ -74,6 +74,7 @@ import {
 import { killProcessTree } from "../runtime/executor.js";
 import { resolveExecutable } from "../runtime/runtimes.js";
 import { SCIP_MAX_INDEX_BYTES } from "./limits.js";
+import { getDecoderMaxIndexBytes } from "./decoder-factory.js";
 import type {
   ScipFailureDiagnostic,
   ScipGeneratedIndexDiagnostic,
@@ -2540,13 +2541,17 @@ export async function runScipIoBeforeIndex(opts: {
     repoRootPath,
     generatorCfg,
     signal,
-    maxIndexBytes,
+    maxIndexBytes: requestedMaxIndexBytes,
     repoLanguages,
     repoConfig,
     repoId,
     filesFromPath,
     outputPath,
   } = opts;
+  // The native decoder streams documents, so only the TypeScript decoder
+  // forces oversized merged indexes into split mode.
+  const maxIndexBytes =
+    requestedMaxIndexBytes ?? (await getDecoderMaxIndexBytes());
   const requestedLanguageFilter =
     repoLanguages === undefined
       ? undefined
@@ -2864,7 +2869,7 @@ export async function runScipIoBeforeIndex(opts: {
     "scip-io: merged index exceeded decoder cap; generating split indexes",
     {
       repoRootPath,
-      maxIndexBytes: SCIP_MAX_INDEX_BYTES,
+      maxIndexBytes,
     },
   );
   const preSplitRunIndexStats = await snapshotSplitIndexStats(repoRootPath);
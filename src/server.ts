@@ -3,6 +3,10 @@ import { StdioServerTransport } from "@modelcontextprotocol/sdk/server/stdio.js"
 import {
   ListToolsRequestSchema,
   CallToolRequestSchema,
+  ListResourcesRequestSchema,
+  ReadResourceRequestSchema,
+  McpError,
+  ErrorCode as McpErrorCode,
   type ToolAnnotations,
   type ServerNotification,
 } from "@modelcontextprotocol/sdk/types.js";
@@ -10,6 +14,10 @@ import { z } from "zod";
 import { getLadybugConn } from "./db/ladybug.js";
 import { IndexError } from "./domain/errors.js";
 import { errorToMcpResponse } from "./mcp/errors.js";
+import {
+  listObservabilityResources,
+  readObservabilityResource,
+} from "./mcp/observability-resources.js";
 import {
   runIndexRefreshAdmission,
   runToolDispatch,
@@ -514,6 +522,7 @@ export class MCPServer {
       {
         capabilities: {
           tools: { listChanged: true },
+          resources: {},
           logging: {},
         },
       },
@@ -579,6 +588,22 @@ export class MCPServer {
       }
     });
 
+    this.server.setRequestHandler(ListResourcesRequestSchema, async () => ({
+      resources: listObservabilityResources(),
+    }));
+
+    this.server.setRequestHandler(ReadResourceRequestSchema, async (request) => {
+      const { uri } = request.params;
+      const text = readObservabilityResource(uri);
+      if (text === null) {
+        throw new McpError(
+          McpErrorCode.InvalidParams,
+          `Unknown resource: ${uri}`,
+        );
+      }
+      return { contents: [{ uri, mimeType: "application/json", text }] };
+    });
+
     this.server.setRequestHandler(
       CallToolRequestSchema,
       async (request, extra) => {
@@ -0,0 +1,50 @@
+import type { AppConfig } from "../config/types.js";
+import { getLadybugConn } from "../db/ladybug.js";
+import { restoreGraphSnapshotFromFile } from "../graph/graphSnapshotCache.js";
+import { logger } from "../util/logger.js";
+
+/**
+ * Seat each configured repo's graph snapshot from its persisted file, so the
+ * first slice after a restart takes the in-memory path instead of waiting
+ * for a LadybugDB warm-up. Repos without a current file are left to warm
+ * lazily as before.
+ */
+export async function restoreGraphSnapshotsOnStartup(
+  config: Pick<AppConfig, "repos">,
+): Promise<number> {
+  const conn = await getLadybugConn();
+  const startedAt = Date.now();
+  let restored = 0;
+  for (const repo of config.repos) {
+    try {
+      if (await restoreGraphSnapshotFromFile(conn, repo.repoId)) restored++;
+    } catch (error) {
+      logger.debug("graph snapshot startup restore failed", {
+        repoId: repo.repoId,
+        error: error instanceof Error ? error.message : String(error),
+      });
+    }
+  }
+  if (restored > 0) {
+    logger.info("graph snapshots restored from disk", {
+      restored,
+      durationMs: Date.now() - startedAt,
+    });
+  }
+  return restored;
+}
+
+/**
+ * Run {@link restoreGraphSnapshotsOnStartup} in the background so startup
+ * does not wait on reading snapshot files. Slices that arrive first take
+ * the usual warm-up path.
+ */
+export function startGraphSnapshotRestore(
+  config: Pick<AppConfig, "repos">,
+): void {
+  void restoreGraphSnapshotsOnStartup(config).catch((error) => {
+    logger.debug("graph snapshot startup restore failed", {
+      error: error instanceof Error ? error.message : String(error),
+    });
+  });
+}
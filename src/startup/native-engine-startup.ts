@@ -0,0 +1,15 @@
+import type { AppConfig } from "../config/types.js";
+import { onConfigLoaded } from "../config/loadConfig.js";
+import { configureRustParseEngineForConfig } from "../indexer/rustIndexer.js";
+
+/**
+ * Size the native parse pool for the startup config, and again whenever a
+ * changed config is loaded. Index runs and draft parses then only cap their
+ * share of that one pool.
+ */
+export function configureNativeParseEngineOnStartup(
+  config: Pick<AppConfig, "indexing">,
+): void {
+  configureRustParseEngineForConfig(config);
+  onConfigLoaded(configureRustParseEngineForConfig);
+}
@@ -398,3 +398,92 @@ export async function singleFlight<T>(
     throw err;
   }
 }
+
+/**
+ * FIFO hand-off between a producer and a consumer running concurrently.
+ * `push` waits while `capacity` items are buffered, so a fast producer can
+ * run at most `capacity` items ahead of the consumer.
+ *
+ * `close()` ends the stream once buffered items are drained; `fail(error)`
+ * drops buffered items and makes both sides throw `error`, so either stage
+ * can stop the other. Items must not be `undefined`.
+ */
+export class BoundedQueue<T> implements AsyncIterable<T> {
+  private readonly items: T[] = [];
+  private readonly takers: Array<{
+    resolve: (item: T | undefined) => void;
+    reject: (reason: unknown) => void;
+  }> = [];
+  private readonly givers: Array<{
+    resolve: () => void;
+    reject: (reason: unknown) => void;
+  }> = [];
+  private closed = false;
+  private failure: { error: unknown } | null = null;
+
+  constructor(private readonly capacity: number) {
+    if (capacity < 1) {
+      throw new Error("capacity must be at least 1");
+    }
+  }
+
+  get size(): number {
+    return this.items.length;
+  }
+
+  async push(item: T): Promise<void> {
+    while (true) {
+      if (this.failure) throw this.failure.error;
+      if (this.closed) throw new Error("BoundedQueue is closed");
+      const taker = this.takers.shift();
+      if (taker) {
+        taker.resolve(item);
+        return;
+      }
+      if (this.items.length < this.capacity) {
+        this.items.push(item);
+        return;
+      }
+      await new Promise<void>((resolve, reject) => {
+        this.givers.push({ resolve, reject });
+      });
+    }
+  }
+
+  /** Next item, or `undefined` once the queue is closed and drained. */
+  async shift(): Promise<T | undefined> {
+    if (this.failure) throw this.failure.error;
+    if (this.items.length > 0) {
+      const item = this.items.shift() as T;
+      this.givers.shift()?.resolve();
+      return item;
+    }
+    if (this.closed) return undefined;
+    return new Promise<T | undefined>((resolve, reject) => {
+      this.takers.push({ resolve, reject });
+    });
+  }
+
+  close(): void {
+    if (this.closed) return;
+    this.closed = true;
+    for (const taker of this.takers.splice(0)) taker.resolve(undefined);
+    for (const giver of this.givers.splice(0)) giver.resolve();
+  }
+
+  fail(error: unknown): void {
+    if (this.failure) return;
+    this.failure = { error };
+    this.items.length = 0;
+    for (const taker of this.takers.splice(0)) taker.reject(error);
+    for (const giver of this.givers.splice(0)) giver.reject(error);
+  }
+
+  async *[Symbol.asyncIterator](): AsyncIterator<T> {
+    while (true) {
+      const item = await this.shift();
+      if (item === undefined) return;
+      yield item as T;
+    }
+  }
+}
@@ -0,0 +1,295 @@
+/**
+ * Single-pass JSON serialization for budgeted responses.
+ *
+ * `serializeJson` walks the top levels of plain objects and arrays itself,
+ * writing every member into one list of string parts, and hands deeper
+ * values to `JSON.stringify`. Along the way it records how many characters
+ * each walked member occupies, so truncation can decide how many items or
+ * keys fit a token budget from those sizes instead of stringifying the same
+ * members a second time. Symbol cards that arrive paired with an etag (a
+ * `{ card, etag }` envelope, or a slice's `cards` next to its `cardRefs`)
+ * can be spliced in from a `CardFragmentSource` instead of being serialized
+ * again.
+ *
+ * The output is byte-for-byte what `JSON.stringify` produces: plain
+ * `JSON.stringify(value)` in "plain" mode, and `JSON.stringify` with
+ * `safeJsonReplacer` (undefined becomes null, functions/symbols/bigints
+ * become strings) in "safe" mode.
+ *
+ * Set `SDL_MCP_STREAMING_SERIALIZER=0` to turn off the serialized card
+ * fragment cache and the slice serializer's token-budget admission.
+ *
+ * @module util/streaming-json
+ */
+
+export function isStreamingSerializerEnabled(
+  env: NodeJS.ProcessEnv = process.env,
+): boolean {
+  return !/^(0|false|no)$/i.test(
+    (env.SDL_MCP_STREAMING_SERIALIZER ?? "").trim(),
+  );
+}
+
+/** Containers nested deeper than this are serialized as one leaf. */
+const WALK_DEPTH = 3;
+
+export type JsonSerializationMode = "plain" | "safe";
+
+/** Serialized size of a value, with per-member sizes for walked containers. */
+export interface SerializedSize {
+  /** Characters the value occupies in the output. */
+  length: number;
+  /** Array members by index. */
+  items?: SerializedSize[];
+  /** Object members by key; members the mode omits are absent. */
+  entries?: Map<string, SerializedSize>;
+}
+
+export interface SerializedJson {
+  /** Undefined only in "plain" mode, where `JSON.stringify` returns it too. */
+  json: string | undefined;
+  /** Absent when the value could not be walked (see `serializeJson`). */
+  size?: SerializedSize;
+}
+
+/**
+ * Serialized symbol cards keyed by content etag. Fragments must have been
+ * produced by plain `JSON.stringify`.
+ */
+export interface CardFragmentSource {
+  get(etag: string, card: Record<string, unknown>): string | undefined;
+  set(etag: string, card: Record<string, unknown>, json: string): void;
+}
+
+export function safeJsonReplacer(_key: string, item: unknown): unknown {
+  if (typeof item === "bigint") return item.toString();
+  if (typeof item === "function") return "[Function]";
+  if (typeof item === "symbol") return item.toString();
+  if (item === undefined) return null;
+  return item;
+}
+
+class JsonPartWriter {
+  readonly parts: string[] = [];
+  length = 0;
+
+  write(part: string): void {
+    this.parts.push(part);
+    this.length += part.length;
+  }
+}
+
+interface WalkContext {
+  mode: JsonSerializationMode;
+  fragments?: CardFragmentSource;
+}
+
+function isRecord(value: unknown): value is Record<string, unknown> {
+  return value !== null && typeof value === "object" && !Array.isArray(value);
+}
+
+function isWalkable(value: unknown, depth: number): value is object {
+  if (depth >= WALK_DEPTH || value === null || typeof value !== "object") {
+    return false;
+  }
+  if (Array.isArray(value)) return true;
+  const proto = Object.getPrototypeOf(value);
+  return (
+    (proto === Object.prototype || proto === null) &&
+    typeof (value as { toJSON?: unknown }).toJSON !== "function"
+  );
+}
+
+function leafJson(value: unknown, ctx: WalkContext): string | undefined {
+  return ctx.mode === "safe"
+    ? (JSON.stringify(value, safeJsonReplacer) ?? "null")
+    : JSON.stringify(value);
+}
+
+/** symbolId -> etag from a slice's `cardRefs`, when it has them. */
+function sliceCardEtags(
+  container: Record<string, unknown>,
+): Map<string, string> | undefined {
+  const refs = container.cardRefs;
+  if (!Array.isArray(refs) || refs.length === 0) return undefined;
+  const etags = new Map<string, string>();
+  for (const ref of refs) {
+    if (
+      isRecord(ref) &&
+      typeof ref.symbolId === "string" &&
+      typeof ref.etag === "string"
+    ) {
+      etags.set(ref.symbolId, ref.etag);
+    }
+  }
+  return etags;
+}
+
+function cardFragment(
+  card: Record<string, unknown>,
+  etag: string,
+  ctx: WalkContext,
+): string | undefined {
+  const fragments = ctx.fragments!;
+  const cached = fragments.get(etag, card);
+  if (cached !== undefined) return cached;
+  const json = JSON.stringify(card);
+  if (json !== undefined) fragments.set(etag, card, json);
+  return json;
+}
+
+/**
+ * Write `value` unless the mode omits it (plain-mode object members that
+ * are undefined, functions or symbols). Returns its size, or undefined
+ * when nothing was written.
+ */
+function writeMember(
+  w: JsonPartWriter,
+  prefix: string,
+  value: unknown,
+  depth: number,
+  ctx: WalkContext,
+  etag: string | undefined,
+): SerializedSize | undefined {
+  if (etag !== undefined && isRecord(value)) {
+    const json = cardFragment(value, etag, ctx);
+    if (json === undefined) return undefined;
+    w.write(prefix);
+    w.write(json);
+    return { length: json.length };
+  }
+  if (isWalkable(value, depth)) {
+    w.write(prefix);
+    return writeContainer(w, value, depth, ctx);
+  }
+  const json = leafJson(value, ctx);
+  if (json === undefined) return undefined;
+  w.write(prefix);
+  w.write(json);
+  return { length: json.length };
+}
+
+/** Array holes and values the mode omits serialize as null. */
+function writeArrayItem(
+  w: JsonPartWriter,
+  prefix: string,
+  value: unknown,
+  depth: number,
+  ctx: WalkContext,
+  etag: string | undefined,
+): SerializedSize {
+  const size = writeMember(w, prefix, value, depth, ctx, etag);
+  if (size) return size;
+  w.write(prefix + "null");
+  return { length: 4 };
+}
+
+function writeContainer(
+  w: JsonPartWriter,
+  value: object,
+  depth: number,
+  ctx: WalkContext,
+): SerializedSize {
+  const start = w.length;
+  if (Array.isArray(value)) {
+    const items: SerializedSize[] = [];
+    w.write("[");
+    for (let i = 0; i < value.length; i++) {
+      items.push(
+        writeArrayItem(w, i === 0 ? "" : ",", value[i], depth + 1, ctx, undefined),
+      );
+    }
+    w.write("]");
+    return { length: w.length - start, items };
+  }
+
+  const record = value as Record<string, unknown>;
+  const cardEtags = ctx.fragments ? cardEtagsFor(record) : undefined;
+  const entries = new Map<string, SerializedSize>();
+  w.write("{");
+  for (const key of Object.keys(record)) {
+    const prefix = (entries.size === 0 ? "" : ",") + JSON.stringify(key) + ":";
+    const member = record[key];
+    let size: SerializedSize | undefined;
+    if (cardEtags?.kind === "slice" && key === "cards" && Array.isArray(member)) {
+      size = writeSliceCards(w, prefix, member, depth + 1, ctx, cardEtags.etags);
+    } else {
+      const etag =
+        cardEtags?.kind === "card" && key === "card" ? cardEtags.etag : undefined;
+      size = writeMember(w, prefix, member, depth + 1, ctx, etag);
+    }
+    if (size) entries.set(key, size);
+  }
+  w.write("}");
+  return { length: w.length - start, entries };
+}
+
+type CardEtags =
+  | { kind: "card"; etag: string }
+  | { kind: "slice"; etags: Map<string, string> };
+
+function cardEtagsFor(record: Record<string, unknown>): CardEtags | undefined {
+  if (typeof record.etag === "string" && isRecord(record.card)) {
+    return { kind: "card", etag: record.etag };
+  }
+  if (Array.isArray(record.cards)) {
+    const etags = sliceCardEtags(record);
+    if (etags) return { kind: "slice", etags };
+  }
+  return undefined;
+}
+
+function writeSliceCards(
+  w: JsonPartWriter,
+  prefix: string,
+  cards: unknown[],
+  depth: number,
+  ctx: WalkContext,
+  etags: Map<string, string>,
+): SerializedSize {
+  w.write(prefix);
+  const start = w.length;
+  const items: SerializedSize[] = [];
+  w.write("[");
+  for (let i = 0; i < cards.length; i++) {
+    const card = cards[i];
+    const etag =
+      isRecord(card) && typeof card.symbolId === "string"
+        ? etags.get(card.symbolId)
+        : undefined;
+    items.push(writeArrayItem(w, i === 0 ? "" : ",", card, depth + 1, ctx, etag));
+  }
+  w.write("]");
+  return { length: w.length - start, items };
+}
+
+/**
+ * Serialize `value` in one pass. In "safe" mode a value that cannot be
+ * serialized at all (a cycle) falls back to its quoted `String(value)`,
+ * with no size tree; in "plain" mode the `JSON.stringify` error propagates.
+ */
+export function serializeJson(
+  value: unknown,
+  options: { mode?: JsonSerializationMode; fragments?: CardFragmentSource } = {},
+): SerializedJson {
+  const ctx: WalkContext = {
+    mode: options.mode ?? "plain",
+    // Cached fragments are plain JSON.stringify output.
+    fragments: options.mode === "safe" ? undefined : options.fragments,
+  };
+  try {
+    if (!isWalkable(value, 0)) {
+      const json = leafJson(value, ctx);
+      return {
+        json,
+        size: json === undefined ? undefined : { length: json.length },
+      };
+    }
+    const w = new JsonPartWriter();
+    const size = writeContainer(w, value, 0, ctx);
+    return { json: w.parts.join(""), size };
+  } catch (error) {
+    if (ctx.mode === "plain") throw error;
+    return { json: JSON.stringify(String(value)) };
+  }
+}
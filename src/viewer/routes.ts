@@ -158,15 +158,33 @@ export async function handleViewerApiRequest(
       return true;
     }
     const viewerConfig = getViewerRuntimeConfig();
+    // ?progress=1 streams NDJSON: intermediate {"type":"frame"} layouts while
+    // a large graph settles, then the final {"type":"layout"}.
+    const progressive = url.searchParams.get("progress") === "1";
+    const writeLine = (payload: Record<string, unknown>): void => {
+      if (!res.headersSent) res.writeHead(200, { "Content-Type": "application/x-ndjson" });
+      res.write(`${JSON.stringify(payload)}\n`);
+    };
     try {
-      json(res, 200, await getLayout(conn, repoId, lod, clusterId, {
+      const result = await getLayout(conn, repoId, lod, clusterId, {
         engine: viewerConfig.layout.engine,
         iterations: viewerConfig.layout.iterations,
         maxSymbolsPerClusterExpand: viewerConfig.layout.maxSymbolsPerClusterExpand,
-      }));
+        onProgress: progressive ? (frame) => writeLine({ type: "frame", ...frame }) : undefined,
+      });
+      if (progressive) {
+        writeLine({ type: "layout", ...result });
+        res.end();
+      } else {
+        json(res, 200, result);
+      }
     } catch (error) {
       const message = error instanceof Error ? error.message : "layout failed";
-      json(res, message.includes("limit") ? 413 : 500, { error: message });
+      if (res.headersSent) {
+        res.end(`${JSON.stringify({ type: "error", error: message })}\n`);
+      } else {
+        json(res, message.includes("limit") ? 413 : 500, { error: message });
+      }
     }
     return true;
   }
@@ -0,0 +1,250 @@
+import { describe, it } from "node:test";
+import assert from "node:assert";
+
+import { beamSearch } from "../../dist/graph/slice/beam-search-engine.js";
+import { beamSearchNative } from "../../dist/graph/slice/native-beam-search.js";
+import { supportsRustSliceBeamSearch } from "../../dist/indexer/rustIndexer.js";
+
+type EdgeType = "call" | "import" | "config" | "implements";
+
+const KINDS = ["function", "class", "method", "interface", "variable"];
+const PATHS = [
+  "src/server.ts",
+  "src/util/index.ts",
+  "tests/unit/server.test.ts",
+  "dist/server.js",
+  "scripts/build.ts",
+];
+
+/** Deterministic pseudo-random numbers in [0, 1). */
+function lcg(seed: number): () => number {
+  let state = seed >>> 0;
+  return () => {
+    state = (Math.imul(state, 1664525) + 1013904223) >>> 0;
+    return state / 0x1_0000_0000;
+  };
+}
+
+function buildGraph(nodeCount: number, fanOut: number, seed: number) {
+  const random = lcg(seed);
+  const symbols = new Map<string, unknown>();
+  const metrics = new Map<string, unknown>();
+  const clusters = new Map<string, string>();
+  const files = new Map<number, unknown>();
+  PATHS.forEach((relPath, i) => {
+    files.set(i + 1, { file_id: i + 1, repo_id: "parity", rel_path: relPath });
+  });
+
+  const ids: string[] = [];
+  for (let i = 0; i < nodeCount; i++) {
+    const id = `sym-${String(i).padStart(5, "0")}`;
+    ids.push(id);
+    symbols.set(id, {
+      symbol_id: id,
+      repo_id: "parity",
+      file_id: Math.floor(random() * (PATHS.length + 1)),
+      kind: KINDS[i % KINDS.length],
+      name: ["handleRequest", "parseConfig", "Server", "route", "beam"][
+        i % 5
+      ] + i,
+      exported: 1,
+      visibility: "public",
+      language: "ts",
+      range_start_line: i,
+      range_start_col: 0,
+      range_end_line: i + 20,
+      range_end_col: 0,
+      ast_fingerprint: "",
+      signature_json: i % 3 === 0 ? `{"params":[${i}]}` : null,
+      summary: i % 4 === 0 ? "Handles an incoming request." : null,
+      invariants_json: null,
+      side_effects_json: null,
+      updated_at: "",
+      external: i % 97 === 0 ? 1 : 0,
+    });
+    metrics.set(id, {
+      symbol_id: id,
+      fan_in: Math.floor(random() * 120),
+      fan_out: Math.floor(random() * 60),
+      churn_30d: Math.floor(random() * 25),
+      test_refs_json: null,
+      canonical_test_json: null,
+      page_rank: random(),
+      k_core: Math.floor(random() * 8),
+      updated_at: "",
+    });
+    if (i % 3 !== 0) clusters.set(id, `cluster-${i % 7}`);
+  }
+
+  const types: EdgeType[] = ["call", "import", "config", "implements"];
+  const edges: unknown[] = [];
+  const adjacencyOut = new Map<string, unknown[]>();
+  const adjacencyIn = new Map<string, unknown[]>();
+  const addEdge = (from: string, to: string) => {
+    const edge = {
+      repo_id: "parity",
+      from_symbol_id: from,
+      to_symbol_id: to,
+      type: types[Math.floor(random() * types.length)],
+      weight: 1,
+      provenance: null,
+      created_at: "",
+      confidence: random() < 0.2 ? undefined : random(),
+    };
+    edges.push(edge);
+    if (!adjacencyOut.has(from)) adjacencyOut.set(from, []);
+    adjacencyOut.get(from)!.push(edge);
+    if (!adjacencyIn.has(to)) adjacencyIn.set(to, []);
+    adjacencyIn.get(to)!.push(edge);
+  };
+  for (const from of ids) {
+    for (let k = 0; k < fanOut; k++) {
+      addEdge(from, ids[Math.floor(random() * ids.length)]);
+    }
+  }
+  // A hub wide enough to fill the frontier and force evictions.
+  for (const to of ids.slice(1, 1_500)) addEdge(ids[0], to);
+  // Edges to symbols outside the snapshot are ignored by both engines.
+  addEdge(ids[1], "missing-symbol");
+
+  return {
+    ids,
+    graph: {
+      repoId: "parity",
+      symbols,
+      edges,
+      adjacencyOut,
+      adjacencyIn,
+      metrics,
+      files,
+      clusters,
+    } as any, // eslint-disable-line @typescript-eslint/no-explicit-any
+  };
+}
+
+function recorder() {
+  const entries: Array<{ decision: string; symbolId: string; why: string }> =
+    [];
+  const record = (entry: { decision: string; symbolId: string; why: string }) =>
+    entries.push({
+      decision: entry.decision,
+      symbolId: entry.symbolId,
+      why: entry.why,
+    });
+  return {
+    entries,
+    collector: {
+      recordAccept: record,
+      recordEvict: record,
+      recordReject: record,
+    },
+  };
+}
+
+describe("native beam search parity", () => {
+  const edgeWeights = { call: 1, import: 0.6, config: 0.8, implements: 0.9 };
+  const { ids, graph } = buildGraph(3_000, 6, 7);
+
+  const cases = [
+    {
+      name: "entry symbols and task text",
+      startNodes: [
+        { symbolId: ids[0], source: "entrySymbol" as const },
+        { symbolId: ids[5], source: "entryFirstHop" as const },
+        { symbolId: "missing", source: "entrySymbol" as const },
+      ],
+      budget: { maxCards: 60, maxEstimatedTokens: 8_000 },
+      request: {
+        entrySymbols: [ids[0], ids[5], "missing"],
+        taskText: "handle request server route",
+      },
+      minConfidence: 0.3,
+    },
+    {
+      name: "stack trace, edited files and clusters",
+      startNodes: [
+        { symbolId: ids[10], source: "editedFile" as const },
+        { symbolId: ids[11], source: "stackTrace" as const },
+      ],
+      budget: { maxCards: 200, maxEstimatedTokens: 40_000 },
+      request: {
+        taskText: "parse config",
+        stackTrace:
+          "Error: boom\n  at parse (src/server.ts:30:5)\n" +
+          "  at run (src/util/index.ts:12)",
+        clusterContext: {
+          entryClusterIds: ["cluster-1"],
+          relatedClusterIds: ["cluster-2", "cluster-4"],
+        },
+      },
+      minConfidence: 0.1,
+    },
+    {
+      name: "tight token budget",
+      startNodes: [{ symbolId: ids[0], source: "entrySymbol" as const }],
+      budget: { maxCards: 500, maxEstimatedTokens: 900 },
+      request: { entrySymbols: [ids[0]], taskText: "beam" },
+      minConfidence: 0,
+    },
+  ];
+
+  for (const c of cases) {
+    it(`matches beamSearch: ${c.name}`, () => {
+      if (!supportsRustSliceBeamSearch()) return;
+
+      const ts = recorder();
+      const expected = beamSearch(
+        graph,
+        c.startNodes,
+        c.budget,
+        c.request,
+        edgeWeights,
+        c.minConfidence,
+        undefined,
+        ts.collector,
+      );
+      const native = recorder();
+      const actual = beamSearchNative(
+        graph,
+        c.startNodes,
+        c.budget,
+        c.request,
+        edgeWeights,
+        c.minConfidence,
+        undefined,
+        native.collector,
+      );
+
+      assert.ok(actual, "native beam search should run");
+      assert.deepStrictEqual(
+        Array.from(actual.sliceCards),
+        Array.from(expected.sliceCards),
+      );
+      assert.deepStrictEqual(actual.frontier, expected.frontier);
+      assert.strictEqual(actual.wasTruncated, expected.wasTruncated);
+      assert.strictEqual(
+        actual.droppedCandidates,
+        expected.droppedCandidates,
+      );
+      assert.strictEqual(actual.maxFrontierSize, expected.maxFrontierSize);
+      assert.deepStrictEqual(native.entries, ts.entries);
+    });
+  }
+
+  it("exercises frontier evictions", () => {
+    if (!supportsRustSliceBeamSearch()) return;
+
+    const native = recorder();
+    beamSearchNative(
+      graph,
+      [{ symbolId: ids[0], source: "entrySymbol" }],
+      { maxCards: 400, maxEstimatedTokens: 100_000 },
+      { taskText: "handle request" },
+      edgeWeights,
+      0,
+      undefined,
+      native.collector,
+    );
+    assert.ok(native.entries.some((e) => e.decision === "evicted"));
+  });
+});
@@ -1,8 +1,13 @@
 import { computeForceLayout } from "../../dist/graph/layout/force-layout.js";
-import { computeNativeLayoutJson, isNativeLayoutEngineAvailable } from "../../dist/graph/layout/native-engine.js";
+import {
+  computeNativeLayoutJson,
+  isNativeBarnesHutAvailable,
+  isNativeLayoutEngineAvailable,
+  streamNativeBarnesHutLayout,
+} from "../../dist/graph/layout/native-engine.js";
 import { fnv1a32, mulberry32 } from "../../dist/graph/layout/prng.js";
 import { serializeLayoutResult } from "../../dist/graph/layout/serializer.js";
-import type { LayoutInput } from "../../dist/graph/layout/types.js";
+import type { LayoutInput, LayoutResult } from "../../dist/graph/layout/types.js";
 
 let passed = 0;
 let failed = 0;
@@ -58,6 +63,28 @@ async function check(input: LayoutInput, iterations: number, label: string): Pro
   assertEqual(actual, expected, label);
 }
 
+async function lastFrame(input: LayoutInput, seed: number, iterations: number, options = {}): Promise<LayoutResult | null> {
+  let last: LayoutResult | null = null;
+  for await (const frame of streamNativeBarnesHutLayout(input, seed, iterations, options)) last = frame;
+  return last;
+}
+
+async function checkBarnesHut(input: LayoutInput, iterations: number, label: string): Promise<void> {
+  const seed = fnv1a32(label);
+  // Progressive frames must not change where the layout ends up.
+  const whole = await lastFrame(input, seed, iterations);
+  const framed = await lastFrame(input, seed, iterations, { frameEvery: 3 });
+  assertEqual(framed ? serializeLayoutResult(framed) : null, whole ? serializeLayoutResult(whole) : "", label + " (frames)");
+
+  // With a vanishing opening threshold every cell is opened: the exact model.
+  const exact = await computeForceLayout(input, seed, iterations);
+  const opened = await lastFrame(input, seed, iterations, { theta: 1e-9 });
+  const drift = opened
+    ? Math.max(...opened.positions.map((p, i) => Math.hypot(p.x - exact.positions[i].x, p.y - exact.positions[i].y, p.z - exact.positions[i].z)))
+    : Number.POSITIVE_INFINITY;
+  assertEqual(drift < 1e-3 ? "close" : "drift " + drift, "close", label + " (theta -> 0)");
+}
+
 async function main(): Promise<void> {
   console.log("=== SDL-MCP Layout Parity Tests ===\n");
   const available = isNativeLayoutEngineAvailable();
@@ -69,6 +96,10 @@ async function main(): Promise<void> {
 
   await check(goldenInput(), 60, "golden-12-node-graph");
   await check(generatedInput(2_000), 8, "generated-2000-node-graph");
+  if (isNativeBarnesHutAvailable()) {
+    await checkBarnesHut(goldenInput(), 20, "barnes-hut-12-node-graph");
+    await checkBarnesHut(generatedInput(500), 10, "barnes-hut-500-node-graph");
+  }
 
   console.log("\n=== Results: " + passed + " passed, " + failed + " failed ===");
   process.exit(failed > 0 ? 1 : 0);
@@ -0,0 +1,56 @@
+import { describe, it } from "node:test";
+import assert from "node:assert/strict";
+import { BoundedQueue } from "../../dist/util/concurrency.js";
+
+describe("BoundedQueue", () => {
+  it("delivers items in order and ends after close", async () => {
+    const queue = new BoundedQueue<number>(2);
+    const producer = (async () => {
+      for (let i = 0; i < 5; i++) await queue.push(i);
+      queue.close();
+    })();
+
+    const seen: number[] = [];
+    for await (const item of queue) seen.push(item);
+    await producer;
+    assert.deepEqual(seen, [0, 1, 2, 3, 4]);
+  });
+
+  it("blocks the producer while the queue is full", async () => {
+    const queue = new BoundedQueue<string>(1);
+    await queue.push("a");
+    let pushed = false;
+    const pending = queue.push("b").then(() => {
+      pushed = true;
+    });
+    await new Promise((resolve) => setImmediate(resolve));
+    assert.equal(pushed, false);
+    assert.equal(queue.size, 1);
+
+    assert.equal(await queue.shift(), "a");
+    await pending;
+    assert.equal(pushed, true);
+    assert.equal(await queue.shift(), "b");
+  });
+
+  it("propagates failure to both sides", async () => {
+    const queue = new BoundedQueue<number>(1);
+    await queue.push(1);
+    const blocked = queue.push(2);
+    const error = new Error("stage failed");
+    queue.fail(error);
+    await assert.rejects(blocked, error);
+    await assert.rejects(queue.shift(), error);
+    await assert.rejects(queue.push(3), error);
+  });
+
+  it("rejects pushes after close but drains buffered items", async () => {
+    const queue = new BoundedQueue<number>(4);
+    await queue.push(7);
+    queue.close();
+    await assert.rejects(queue.push(8), /closed/);
+    assert.equal(await queue.shift(), 7);
+    assert.equal(await queue.shift(), undefined);
+    assert.throws(() => new BoundedQueue<number>(0), /capacity/);
+  });
+});
@@ -0,0 +1,104 @@
+import { describe, it } from "node:test";
+import assert from "node:assert/strict";
+
+import {
+  computeKCore,
+  computePageRank,
+} from "../../dist/graph/centrality-algorithms.js";
+import {
+  previousPageRankColumn,
+  runCentrality,
+  shouldUseNativeCentrality,
+} from "../../dist/graph/centrality-worker-runner.js";
+import { supportsRustCentrality } from "../../dist/indexer/rustIndexer.js";
+
+const INPUT = {
+  symbolIds: ["d", "a", "c", "b"],
+  callEdges: [
+    { callerId: "a", calleeId: "b" },
+    { callerId: "b", calleeId: "c" },
+    { callerId: "c", calleeId: "a" },
+    { callerId: "c", calleeId: "d" },
+    { callerId: "c", calleeId: "gone" },
+  ],
+  pageRankEnabled: true,
+  kCoreEnabled: true,
+};
+
+describe("runCentrality", () => {
+  it("matches the JavaScript algorithms on either engine", async () => {
+    let loads = 0;
+    const result = await runCentrality(INPUT, 30_000, {
+      loadPreviousPageRank: async () => {
+        loads++;
+        return new Map();
+      },
+    });
+    assert.deepEqual(result.kCore, computeKCore(INPUT));
+    // The worker runs 20 fixed iterations; the native kernel converges.
+    const native = supportsRustCentrality();
+    const expected = computePageRank(INPUT, native ? 200 : 20);
+    assert.deepEqual(
+      result.pageRank.map((row) => row.symbolId),
+      expected.map((row) => row.symbolId),
+    );
+    result.pageRank.forEach((row, i) => {
+      assert.ok(
+        Math.abs(row.score - expected[i].score) < (native ? 1e-7 : 1e-12),
+      );
+    });
+    assert.ok(loads <= 1);
+  });
+
+  it("returns stored scores unchanged when refreshing an unchanged graph", async () => {
+    if (!supportsRustCentrality()) return;
+    const cold = await runCentrality(INPUT, 30_000);
+    const warm = await runCentrality(INPUT, 30_000, {
+      loadPreviousPageRank: async () =>
+        new Map(cold.pageRank.map((row) => [row.symbolId, row.score])),
+    });
+    assert.deepEqual(warm.pageRank, cold.pageRank);
+  });
+
+  it("skips disabled kernels", async () => {
+    const result = await runCentrality(
+      { ...INPUT, pageRankEnabled: false },
+      30_000,
+    );
+    assert.deepEqual(result.pageRank, []);
+    assert.equal(result.kCore.length, 4);
+  });
+
+  it("is controlled by SDL_MCP_NATIVE_CENTRALITY", () => {
+    assert.equal(shouldUseNativeCentrality({}), true);
+    assert.equal(
+      shouldUseNativeCentrality({ SDL_MCP_NATIVE_CENTRALITY: "false" }),
+      false,
+    );
+  });
+});
+
+describe("previousPageRankColumn", () => {
+  it("orders stored scores by node and marks unknown nodes NaN", () => {
+    const column = previousPageRankColumn(
+      ["a", "b", "c"],
+      new Map([
+        ["c", 0.5],
+        ["a", 0],
+        ["x", 0.2],
+      ]),
+    );
+    assert.ok(column);
+    assert.ok(Number.isNaN(column[0]));
+    assert.ok(Number.isNaN(column[1]));
+    assert.equal(column[2], 0.5);
+  });
+
+  it("returns null when nothing usable is stored", () => {
+    assert.equal(
+      previousPageRankColumn(["a"], new Map([["a", Number.NaN]])),
+      null,
+    );
+    assert.equal(previousPageRankColumn([], new Map()), null);
+  });
+});
@@ -0,0 +1,143 @@
+import { afterEach, describe, it } from "node:test";
+import assert from "node:assert/strict";
+
+import { buildCsrGraph } from "../../dist/graph/csr-snapshot.js";
+import {
+  forgetCommunities,
+  planIncrementalCommunities,
+  recallCommunities,
+  rememberCommunities,
+  shouldUseIncrementalClusters,
+} from "../../dist/indexer/cluster-incremental.js";
+import {
+  UNCLUSTERED_LABEL,
+  clusterAssignmentsFromLabels,
+} from "../../dist/indexer/rustIndexer.js";
+
+function callGraph(ids: string[], edges: Array<[string, string]>) {
+  return buildCsrGraph(
+    ids,
+    (emit) => {
+      for (const [from, to] of edges) emit(from, to, "call");
+    },
+    { includeUnknownEndpoints: true },
+  );
+}
+
+function flagged(graph: ReturnType<typeof callGraph>, flags: Uint8Array) {
+  return graph.symbolIds.filter((_, node) => flags[node] === 1);
+}
+
+const IDS = ["a", "b", "c", "d", "e", "f", "g", "h"];
+const EDGES: Array<[string, string]> = [
+  ["a", "b"],
+  ["b", "c"],
+  ["c", "a"],
+  ["e", "f"],
+  ["f", "g"],
+  ["g", "e"],
+];
+// Raw labels as the native kernel returns them: lowest node per community.
+const LABELS = Uint32Array.from([
+  0,
+  0,
+  0,
+  UNCLUSTERED_LABEL,
+  4,
+  4,
+  4,
+  UNCLUSTERED_LABEL,
+]);
+
+describe("planIncrementalCommunities", () => {
+  it("carries previous communities and flags nothing for an unchanged graph", () => {
+    const graph = callGraph(IDS, EDGES);
+    const plan = planIncrementalCommunities(
+      { graph: callGraph(IDS, EDGES), labels: LABELS },
+      graph,
+    );
+    assert.ok(plan);
+    assert.deepEqual(Array.from(plan.groups), Array.from(LABELS));
+    assert.deepEqual(flagged(graph, plan.changed), []);
+  });
+
+  it("flags changed callers and both ends of added or removed edges", () => {
+    const previous = { graph: callGraph(IDS, EDGES), labels: LABELS };
+    const graph = callGraph(IDS, [
+      ...EDGES.filter(([from]) => from !== "b"),
+      ["b", "d"],
+    ]);
+    const plan = planIncrementalCommunities(previous, graph, 1);
+    assert.ok(plan);
+    assert.deepEqual(flagged(graph, plan.changed), ["b", "c", "d"]);
+  });
+
+  it("maps nodes by symbol ID across inserted and removed symbols", () => {
+    const previous = { graph: callGraph(IDS, EDGES), labels: LABELS };
+    const ids = ["a0", ...IDS.filter((id) => id !== "h" && id !== "g")];
+    const graph = callGraph(ids, [
+      ["a", "b"],
+      ["b", "c"],
+      ["c", "a"],
+      ["e", "f"],
+      ["a0", "a"],
+    ]);
+    const plan = planIncrementalCommunities(previous, graph, 1);
+    assert.ok(plan);
+    // "b" and "e" keep their old group keys although their node IDs moved.
+    assert.equal(graph.nodeOf("b"), 2);
+    assert.equal(plan.groups[2], 0);
+    assert.equal(plan.groups[graph.nodeOf("e")!], 4);
+    assert.equal(plan.groups[graph.nodeOf("a0")!], UNCLUSTERED_LABEL);
+    // New "a0", "f" (lost f->g) and "e" (target of the vanished g->e).
+    assert.deepEqual(flagged(graph, plan.changed), ["a0", "e", "f"]);
+  });
+
+  it("falls back to a full run when too much changed", () => {
+    const previous = { graph: callGraph(IDS, EDGES), labels: LABELS };
+    const graph = callGraph(IDS, [["a", "h"]]);
+    assert.equal(planIncrementalCommunities(previous, graph), null);
+  });
+});
+
+describe("community snapshots", () => {
+  afterEach(() => forgetCommunities());
+
+  it("remembers one snapshot per repo", () => {
+    const snapshot = { graph: callGraph(IDS, EDGES), labels: LABELS };
+    rememberCommunities("repo-a", snapshot);
+    assert.equal(recallCommunities("repo-a"), snapshot);
+    assert.equal(recallCommunities("repo-b"), undefined);
+    forgetCommunities("repo-a");
+    assert.equal(recallCommunities("repo-a"), undefined);
+  });
+
+  it("is controlled by SDL_MCP_INCREMENTAL_CLUSTERS", () => {
+    assert.equal(shouldUseIncrementalClusters({}), true);
+    assert.equal(
+      shouldUseIncrementalClusters({ SDL_MCP_INCREMENTAL_CLUSTERS: "0" }),
+      false,
+    );
+    assert.equal(
+      shouldUseIncrementalClusters({ SDL_MCP_INCREMENTAL_CLUSTERS: " no " }),
+      false,
+    );
+  });
+});
+
+describe("clusterAssignmentsFromLabels", () => {
+  it("applies the minimum size and hashes sorted members", () => {
+    const graph = callGraph(IDS, EDGES);
+    const labels = Uint32Array.from(LABELS);
+    labels[3] = 3;
+    const assignments = clusterAssignmentsFromLabels(graph, labels, 3);
+    assert.deepEqual(
+      assignments.map((a) => a.symbolId),
+      ["a", "b", "c", "e", "f", "g"],
+    );
+    assert.equal(new Set(assignments.map((a) => a.clusterId)).size, 2);
+    assert.equal(assignments[0].clusterId, assignments[2].clusterId);
+    assert.ok(assignments.every((a) => a.membershipScore === 1));
+    assert.equal(clusterAssignmentsFromLabels(graph, labels, 4).length, 0);
+  });
+});
@@ -0,0 +1,160 @@
+import { describe, it, beforeEach } from "node:test";
+import assert from "node:assert/strict";
+
+import {
+  clearSliceCache,
+  getCachedSlice,
+  getSliceCacheStats,
+  invalidateSliceCacheForSymbols,
+  setCachedSlice,
+} from "../../dist/graph/sliceCache.js";
+import {
+  clearGraphSnapshots,
+  getGraphSnapshotCreatedAt,
+  invalidateGraphSnapshot,
+  setGraphSnapshot,
+  sharesGraphSnapshotLineage,
+} from "../../dist/graph/graphSnapshotCache.js";
+import {
+  _clearPprCache,
+  computePpr,
+  invalidatePprCacheForSymbols,
+} from "../../dist/retrieval/ppr.js";
+import { changedSymbolIds } from "../../dist/live-index/cache-invalidation.js";
+
+function slice(repoId: string, symbolIndex: string[], frontier: string[] = []) {
+  return {
+    repoId,
+    versionId: "v1",
+    budget: { maxCards: 10, maxEstimatedTokens: 1000 },
+    startSymbols: symbolIndex.slice(0, 1),
+    symbolIndex,
+    cards: [],
+    edges: [],
+    frontier: frontier.map((symbolId) => ({ symbolId, score: 0.5, why: "" })),
+  } as never;
+}
+
+function chainGraph(repoId: string, ids: string[]) {
+  const adjacencyOut = new Map<string, unknown[]>();
+  const adjacencyIn = new Map<string, unknown[]>();
+  for (const id of ids) {
+    adjacencyOut.set(id, []);
+    adjacencyIn.set(id, []);
+  }
+  for (let i = 0; i + 1 < ids.length; i++) {
+    const edge = {
+      from_symbol_id: ids[i],
+      to_symbol_id: ids[i + 1],
+      weight: 1,
+      confidence: 1,
+    };
+    adjacencyOut.get(ids[i])!.push(edge);
+    adjacencyIn.get(ids[i + 1])!.push(edge);
+  }
+  return {
+    repoId,
+    symbols: new Map(ids.map((id) => [id, { symbol_id: id }])),
+    edges: [],
+    adjacencyOut,
+    adjacencyIn,
+  } as never;
+}
+
+async function nextMillisecond(): Promise<void> {
+  const start = Date.now();
+  while (Date.now() === start) {
+    await new Promise((resolve) => setTimeout(resolve, 1));
+  }
+}
+
+describe("delta cache invalidation", () => {
+  beforeEach(() => {
+    clearSliceCache();
+    clearGraphSnapshots();
+    _clearPprCache();
+  });
+
+  it("evicts only slices that include a changed symbol", () => {
+    setCachedSlice("a", slice("delta-repo", ["s1", "s2"]));
+    setCachedSlice("b", slice("delta-repo", ["s3"], ["s4"]));
+    setCachedSlice("c", slice("other-repo", ["s1"]));
+
+    assert.equal(invalidateSliceCacheForSymbols("delta-repo", ["s9"]), 0);
+    assert.equal(invalidateSliceCacheForSymbols("delta-repo", ["s4"]), 1);
+    assert.equal(getCachedSlice("b"), null);
+    assert.notEqual(getCachedSlice("a"), null);
+    assert.notEqual(getCachedSlice("c"), null);
+
+    assert.equal(invalidateSliceCacheForSymbols("delta-repo", ["s2"]), 1);
+    assert.equal(getCachedSlice("a"), null);
+    assert.equal(getSliceCacheStats().deltaInvalidations, 2);
+    assert.equal(getSliceCacheStats().currentSize, 1);
+  });
+
+  it("tracks snapshot lineage until the snapshot is invalidated", async () => {
+    const graph = chainGraph("lineage-repo", ["x", "y"]);
+    assert.equal(setGraphSnapshot("lineage-repo", graph), true);
+    const first = getGraphSnapshotCreatedAt("lineage-repo")!;
+    await nextMillisecond();
+    assert.equal(setGraphSnapshot("lineage-repo", graph), true);
+    const second = getGraphSnapshotCreatedAt("lineage-repo")!;
+
+    assert.notEqual(first, second);
+    assert.equal(
+      sharesGraphSnapshotLineage("lineage-repo", first, second),
+      true,
+    );
+    invalidateGraphSnapshot("lineage-repo");
+    assert.equal(
+      sharesGraphSnapshotLineage("lineage-repo", first, second),
+      false,
+    );
+  });
+
+  it("carries PPR results across rebuilds until a delta hits", async () => {
+    const repoId = "ppr-delta-repo";
+    const graph = chainGraph(repoId, ["p", "q", "r"]);
+    setGraphSnapshot(repoId, graph);
+    const first = getGraphSnapshotCreatedAt(repoId)!;
+    const input = {
+      graph,
+      repoId,
+      options: { seeds: new Map([["p", 1]]), direction: "out" as const },
+    };
+    const computed = await computePpr({ ...input, snapshotCreatedAt: first });
+
+    await nextMillisecond();
+    setGraphSnapshot(repoId, graph);
+    const second = getGraphSnapshotCreatedAt(repoId)!;
+    const carried = await computePpr({ ...input, snapshotCreatedAt: second });
+    assert.equal(carried, computed);
+
+    assert.equal(invalidatePprCacheForSymbols(repoId, ["unrelated"]), 0);
+    assert.equal(invalidatePprCacheForSymbols(repoId, ["q"]), 1);
+    const recomputed = await computePpr({
+      ...input,
+      snapshotCreatedAt: second,
+    });
+    assert.notEqual(recomputed, computed);
+    assert.deepEqual(recomputed.scores, computed.scores);
+
+    // An unrelated snapshot never serves another one's results.
+    const fresh = await computePpr({ ...input, snapshotCreatedAt: -1 });
+    assert.notEqual(fresh, recomputed);
+  });
+
+  it("collects the symbols a patch may have changed", () => {
+    const frontier = {
+      touchedSymbolIds: ["b", "a"],
+      dependentSymbolIds: ["c"],
+      dependentFilePaths: [],
+      importedFilePaths: [],
+      invalidations: ["metrics" as const],
+    };
+    assert.deepEqual(
+      changedSymbolIds(frontier, ["old-a", "unresolved:call:x", "c", "t"]),
+      ["a", "b", "c", "old-a", "t"],
+    );
+  });
+});
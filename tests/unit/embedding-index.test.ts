@@ -0,0 +1,96 @@
+import { describe, it } from "node:test";
+import assert from "node:assert/strict";
+import { join } from "node:path";
+
+import {
+  decodeEmbeddingBlob,
+  embeddingIndexGenerationPath,
+  embeddingIndexPath,
+  hasEmbeddingIndex,
+  searchEmbeddingIndex,
+  shouldUseNativeEmbeddingIndex,
+} from "../../dist/retrieval/embedding-index.js";
+import { toFloat16Blob } from "../../dist/indexer/embeddings.js";
+
+describe("native embedding index", () => {
+  it("decodes stored blobs back to their vectors", () => {
+    const vector = [0.5, -0.25, 0.0001, -1];
+    const target = new Float32Array(6);
+    assert.equal(
+      decodeEmbeddingBlob(toFloat16Blob(vector), target, 1, 4),
+      true,
+    );
+    assert.equal(target[0], 0);
+    for (let i = 0; i < vector.length; i++) {
+      assert.ok(Math.abs(target[i + 1] - vector[i]) < 1e-4);
+    }
+    assert.equal(target[5], 0);
+  });
+
+  it("rejects blobs of the wrong dimension", () => {
+    const target = new Float32Array(4);
+    assert.equal(
+      decodeEmbeddingBlob(toFloat16Blob([1, 2]), target, 0, 4),
+      false,
+    );
+    assert.equal(decodeEmbeddingBlob("", target, 0, 4), false);
+    assert.deepEqual(Array.from(target), [0, 0, 0, 0]);
+  });
+
+  it("places one file per repo and model next to the graph database", () => {
+    const dbPath = join("/data", "graph", "sdl-mcp-graph.lbug");
+    assert.equal(
+      embeddingIndexPath("my/repo", "jina-embeddings-v2-base-code", dbPath),
+      join(
+        "/data",
+        "graph",
+        "embedding-index",
+        "my%2Frepo",
+        "jina-embeddings-v2-base-code.sdlvec",
+      ),
+    );
+    assert.equal(embeddingIndexPath("repo", "model", null), null);
+  });
+
+  it("writes rebuilds to generation files that sort by age", () => {
+    const path = join("/data", "embedding-index", "repo", "model.sdlvec");
+    const older = embeddingIndexGenerationPath(path, 9_000);
+    const newer = embeddingIndexGenerationPath(path, 10_000);
+    assert.equal(
+      older,
+      join(
+        "/data",
+        "embedding-index",
+        "repo",
+        `model.000000000009000-${process.pid}.sdlvec`,
+      ),
+    );
+    assert.ok(older < newer);
+  });
+
+  it("is on unless disabled by environment", () => {
+    assert.equal(shouldUseNativeEmbeddingIndex({}), true);
+    assert.equal(
+      shouldUseNativeEmbeddingIndex({ SDL_MCP_NATIVE_VECTOR_INDEX: "1" }),
+      true,
+    );
+    for (const value of ["0", "false", "NO", " 0 "]) {
+      assert.equal(
+        shouldUseNativeEmbeddingIndex({ SDL_MCP_NATIVE_VECTOR_INDEX: value }),
+        false,
+      );
+    }
+  });
+
+  it("returns null so callers fall back to Kuzu when no index exists", () => {
+    const repoId = `missing-${process.pid}`;
+    assert.equal(
+      hasEmbeddingIndex(repoId, "jina-embeddings-v2-base-code"),
+      false,
+    );
+    assert.equal(
+      searchEmbeddingIndex(repoId, "jina-embeddings-v2-base-code", [1, 0], 5),
+      null,
+    );
+  });
+});
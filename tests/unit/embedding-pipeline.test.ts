@@ -0,0 +1,111 @@
+import assert from "node:assert";
+import { describe, it } from "node:test";
+
+import {
+  EmbeddingBatcher,
+  EmbeddingWriteQueue,
+  isEmbeddingPipelineEnabled,
+} from "../../dist/indexer/embedding-pipeline.js";
+
+const identity = (n: number): number => n;
+
+describe("embedding pipeline", () => {
+  it("is on unless SDL_MCP_EMBEDDING_PIPELINE disables it", () => {
+    assert.strictEqual(isEmbeddingPipelineEnabled({}), true);
+    assert.strictEqual(
+      isEmbeddingPipelineEnabled({ SDL_MCP_EMBEDDING_PIPELINE: "0" }),
+      false,
+    );
+    assert.strictEqual(
+      isEmbeddingPipelineEnabled({ SDL_MCP_EMBEDDING_PIPELINE: "1" }),
+      true,
+    );
+  });
+
+  it("cuts fixed batches when not adaptive", () => {
+    const batcher = new EmbeddingBatcher([1, 2, 3, 4, 5], identity, {
+      maxBatchSize: 2,
+      targetBatchMs: 1,
+      adaptive: false,
+    });
+    batcher.record([1, 2], 1000);
+    const batches: number[][] = [];
+    for (let b = batcher.next(); b; b = batcher.next()) batches.push(b);
+    assert.deepStrictEqual(batches, [[1, 2], [3, 4], [5]]);
+  });
+
+  it("shrinks batches of long inputs to the target latency", () => {
+    const items = [10, 10, 10, 10, 100, 100, 100, 100];
+    const batcher = new EmbeddingBatcher(items, identity, {
+      maxBatchSize: 4,
+      targetBatchMs: 40,
+      adaptive: true,
+    });
+    // Unmeasured: the first batch takes the full width.
+    const first = batcher.next();
+    assert.deepStrictEqual(first, [10, 10, 10, 10]);
+    // 40 padded units took 40 ms: 1 ms per unit, so 40 units per batch.
+    batcher.record(first!, 40);
+    // A 100-unit input alone exceeds the budget but still makes progress.
+    assert.deepStrictEqual(batcher.next(), [100]);
+    assert.strictEqual(batcher.remaining, 3);
+  });
+
+  it("writes in the background and drains the rest", async () => {
+    const written: number[][] = [];
+    const queue = new EmbeddingWriteQueue<number>(
+      async (rows) => {
+        written.push(rows);
+      },
+      { flushSize: 2, maxQueued: 10 },
+    );
+    await queue.push([1]);
+    assert.deepStrictEqual(written, []);
+    await queue.push([2, 3]);
+    await queue.push([4]);
+    await queue.drain();
+    assert.deepStrictEqual(written.flat(), [1, 2, 3, 4]);
+    assert.strictEqual(queue.queued, 0);
+  });
+
+  it("holds pushes once too many rows are queued", async () => {
+    let release!: () => void;
+    const gate = new Promise<void>((resolve) => {
+      release = resolve;
+    });
+    const queue = new EmbeddingWriteQueue<number>(() => gate, {
+      flushSize: 1,
+      maxQueued: 2,
+    });
+    await queue.push([1]);
+    let settled = false;
+    const held = queue.push([2, 3]).then(() => {
+      settled = true;
+    });
+    await new Promise((resolve) => setImmediate(resolve));
+    assert.strictEqual(settled, false);
+    release();
+    await held;
+    assert.strictEqual(settled, true);
+    await queue.drain();
+  });
+
+  it("keeps rows of a failed write for the next one", async () => {
+    let fail = true;
+    const written: number[] = [];
+    const errors: number[] = [];
+    const queue = new EmbeddingWriteQueue<number>(
+      async (rows) => {
+        if (fail) throw new Error("busy");
+        written.push(...rows);
+      },
+      { flushSize: 1, maxQueued: 10, onWriteError: (_e, n) => errors.push(n) },
+    );
+    await queue.push([1, 2]);
+    await new Promise((resolve) => setImmediate(resolve));
+    assert.deepStrictEqual(errors, [2]);
+    fail = false;
+    await queue.drain();
+    assert.deepStrictEqual(written, [1, 2]);
+  });
+});
@@ -3,6 +3,7 @@ import assert from "node:assert";
 import { mkdirSync, mkdtempSync, rmSync, writeFileSync } from "node:fs";
 import { join } from "node:path";
 import { tmpdir } from "node:os";
+import { createHash } from "node:crypto";
 
 import { scanRepository } from "../../dist/indexer/fileScanner.js";
 import { RepoConfigSchema, type RepoConfig } from "../../dist/config/types.js";
@@ -364,4 +365,27 @@ describe("fileScanner.scanRepository", () => {
       ["packages/pkg-a/src/keep.ts"],
     );
   });
+
+  it("ignores stored hashes when no fast digest can confirm them", async () => {
+    const repoPath = makeTempRepo();
+    mkdirSync(join(repoPath, "src"), { recursive: true });
+    const content = "export const a = 1;";
+    writeFileSync(join(repoPath, "src", "a.ts"), content, "utf8");
+
+    const files = await scanRepository(repoPath, repoConfig(repoPath), {
+      knownHashes: new Map([
+        [
+          "src/a.ts",
+          { contentHash: "0".repeat(64), contentFastHash: "0".repeat(32) },
+        ],
+      ]),
+    });
+
+    assert.strictEqual(files.length, 1);
+    assert.strictEqual(
+      files[0].contentHash,
+      createHash("sha256").update(content).digest("hex"),
+    );
+    assert.strictEqual(files[0].contentFastHash, undefined);
+  });
 });
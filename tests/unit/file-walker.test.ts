@@ -212,3 +212,33 @@ describe("fileScanner walkRepositoryFiles", () => {
     ]);
   });
 });
+
+describe("createIgnoredPathMatcher", () => {
+  it("agrees with walkRepositoryFiles for direct and ancestor matches", async () => {
+    const { createIgnoredPathMatcher } = await import(
+      "../../dist/indexer/fileWalker.js"
+    );
+    const isIgnored = createIgnoredPathMatcher([
+      "**/node_modules/**",
+      "build/",
+      "*.gen.ts",
+    ]);
+
+    assert.strictEqual(isIgnored("src/index.ts"), false);
+    assert.strictEqual(isIgnored("node_modules/pkg/index.ts"), true);
+    assert.strictEqual(isIgnored("packages/a/node_modules/x/y.ts"), true);
+    // Directory-only pattern prunes the root build/ tree, not nested ones.
+    assert.strictEqual(isIgnored("build/out.ts"), true);
+    assert.strictEqual(isIgnored("src/build/out.ts"), false);
+    // Slash-less globs are anchored to the root.
+    assert.strictEqual(isIgnored("root.gen.ts"), true);
+    assert.strictEqual(isIgnored("src/keep.gen.ts"), false);
+  });
+
+  it("ignores nothing without patterns", async () => {
+    const { createIgnoredPathMatcher } = await import(
+      "../../dist/indexer/fileWalker.js"
+    );
+    assert.strictEqual(createIgnoredPathMatcher([])("a/b/c.ts"), false);
+  });
+});
@@ -0,0 +1,186 @@
+import { describe, it } from "node:test";
+import assert from "node:assert";
+import { getCsrSnapshot } from "../../dist/graph/csr-snapshot.js";
+import {
+  decodeGraphSnapshot,
+  encodeGraphSnapshot,
+  readGraphSnapshotVersion,
+  resolveGraphSnapshotPath,
+  shouldUseGraphSnapshotFile,
+} from "../../dist/graph/graph-snapshot-file.js";
+
+const REPO = "snapshot-file-repo";
+
+function symbol(id: string, fileId: number, extra: object = {}) {
+  return {
+    symbol_id: id,
+    repo_id: REPO,
+    file_id: fileId,
+    kind: "function",
+    name: id,
+    exported: 1,
+    visibility: null,
+    language: "typescript",
+    range_start_line: 1,
+    range_start_col: 0,
+    range_end_line: 4,
+    range_end_col: 1,
+    ast_fingerprint: `fp-${id}`,
+    signature_json: null,
+    summary: `Summary of ${id} — with non-ASCII text`,
+    invariants_json: null,
+    side_effects_json: null,
+    external: 0,
+    package_name: null,
+    package_version: null,
+    scip_symbol: null,
+    updated_at: "2026-01-01T00:00:00.000Z",
+    ...extra,
+  };
+}
+
+function edge(from: string, to: string, type = "call") {
+  return {
+    from_symbol_id: from,
+    to_symbol_id: to,
+    type,
+    weight: 1,
+    confidence: 0.8,
+  };
+}
+
+function makeGraph() {
+  const symbols = [
+    symbol("a", 1, { package_name: "pkg", scip_symbol: "scip a" }),
+    symbol("b", 2),
+    symbol("c", 1, { exported: 0 }),
+  ];
+  const edges = [
+    edge("a", "b"),
+    edge("c", "b"),
+    edge("b", "c", "import"),
+    edge("a", "external-target"),
+  ];
+  const adjacencyOut = new Map<string, any[]>();
+  const adjacencyIn = new Map<string, any[]>();
+  for (const row of symbols) {
+    adjacencyOut.set(row.symbol_id, []);
+    adjacencyIn.set(row.symbol_id, []);
+  }
+  for (const row of edges) {
+    adjacencyOut.get(row.from_symbol_id)?.push(row);
+    adjacencyIn.get(row.to_symbol_id)?.push(row);
+  }
+  const graph = {
+    repoId: REPO,
+    symbols: new Map(symbols.map((row) => [row.symbol_id, row])),
+    edges,
+    adjacencyIn,
+    adjacencyOut,
+    metrics: new Map([
+      [
+        "a",
+        {
+          symbol_id: "a",
+          fan_in: 0,
+          fan_out: 2,
+          churn_30d: 3,
+          test_refs_json: "[]",
+          canonical_test_json: null,
+          page_rank: 0.25,
+          k_core: 2,
+          updated_at: "2026-01-01T00:00:00.000Z",
+        },
+      ],
+    ]),
+    centralityStats: { maxPageRank: 0.25, maxKCore: 2 },
+    files: new Map([
+      [
+        1,
+        {
+          file_id: 1,
+          repo_id: REPO,
+          rel_path: "src/a.ts",
+          content_hash: "h1",
+          language: "typescript",
+          byte_size: 10,
+          last_indexed_at: null,
+          directory: "src",
+        },
+      ],
+    ]),
+    clusters: new Map([["a", "cluster-1"]]),
+  } as any;
+  return { graph, scip: edges[3] };
+}
+
+describe("graph snapshot file", () => {
+  it("round-trips every table, SCIP flags and the CSR view", () => {
+    const { graph, scip } = makeGraph();
+    const csr = getCsrSnapshot(graph);
+    const bytes = encodeGraphSnapshot(graph, csr, {
+      versionId: "v7",
+      scipEdges: new WeakSet([scip]),
+    });
+
+    const contents = decodeGraphSnapshot(bytes)!;
+    assert.ok(contents);
+    assert.strictEqual(contents.repoId, REPO);
+    assert.strictEqual(contents.versionId, "v7");
+    assert.deepStrictEqual(contents.symbols, [...graph.symbols.values()]);
+    assert.deepStrictEqual(contents.edges, graph.edges);
+    assert.deepStrictEqual(contents.metrics, [...graph.metrics.values()]);
+    assert.deepStrictEqual(contents.files, [...graph.files.values()]);
+    assert.deepStrictEqual([...contents.clusters], [["a", "cluster-1"]]);
+    assert.deepStrictEqual(contents.centralityStats, graph.centralityStats);
+
+    const flagged = contents.edges.filter((row) => contents.scipEdges.has(row));
+    assert.deepStrictEqual(flagged, [contents.edges[3]]);
+
+    assert.deepStrictEqual(contents.csr.symbolIds, csr.symbolIds);
+    assert.deepStrictEqual(contents.csr.offsets, csr.offsets);
+    assert.deepStrictEqual(contents.csr.neighbors, csr.neighbors);
+    assert.deepStrictEqual(contents.csr.weights, csr.weights);
+    assert.deepStrictEqual(contents.csr.edgeTypes, csr.edgeTypes);
+    // CSR columns are views over the file bytes, not copies.
+    assert.strictEqual(contents.csr.offsets.buffer, bytes.buffer);
+  });
+
+  it("reads the version stamp without decoding the tables", () => {
+    const { graph } = makeGraph();
+    const bytes = encodeGraphSnapshot(graph, getCsrSnapshot(graph), {
+      versionId: "v8",
+      scipEdges: new WeakSet(),
+    });
+    assert.deepStrictEqual(readGraphSnapshotVersion(bytes), {
+      repoId: REPO,
+      versionId: "v8",
+      symbolCount: 3,
+    });
+    assert.strictEqual(readGraphSnapshotVersion(new Uint8Array(4)), null);
+  });
+
+  it("rejects corrupt files", () => {
+    const { graph } = makeGraph();
+    const bytes = encodeGraphSnapshot(graph, getCsrSnapshot(graph), {
+      versionId: "v9",
+      scipEdges: new WeakSet(),
+    });
+    assert.throws(() => decodeGraphSnapshot(bytes.slice(0, bytes.length - 9)));
+    const badMagic = bytes.slice();
+    badMagic[0] ^= 0xff;
+    assert.throws(() => decodeGraphSnapshot(badMagic));
+  });
+
+  it("is on unless disabled and lives next to the graph database", () => {
+    assert.strictEqual(shouldUseGraphSnapshotFile({}), true);
+    assert.strictEqual(
+      shouldUseGraphSnapshotFile({ SDL_MCP_GRAPH_SNAPSHOT_FILE: "0" }),
+      false,
+    );
+    assert.strictEqual(
+      resolveGraphSnapshotPath("/data/graph.lbug", "org/repo"),
+      "/data/graph.lbug.graph-snapshots/org%2Frepo.bin",
+    );
+  });
+});
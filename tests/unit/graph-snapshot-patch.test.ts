@@ -0,0 +1,280 @@
+import { describe, it, beforeEach } from "node:test";
+import assert from "node:assert";
+import {
+  applyGraphSnapshotPatch,
+  clearGraphSnapshots,
+  getGraphSnapshot,
+  getGraphSnapshotCreatedAt,
+  setGraphSnapshot,
+  sharesGraphSnapshotLineage,
+} from "../../dist/graph/graphSnapshotCache.js";
+import { getCsrSnapshot } from "../../dist/graph/csr-snapshot.js";
+import {
+  decodeGraphSnapshot,
+  encodeGraphSnapshot,
+} from "../../dist/graph/graph-snapshot-file.js";
+
+const REPO = "patch-repo";
+
+function legacySymbol(id: string, fileId: number, extra: object = {}) {
+  return {
+    symbol_id: id,
+    repo_id: REPO,
+    file_id: fileId,
+    kind: "function",
+    name: id,
+    exported: 1,
+    ...extra,
+  };
+}
+
+function legacyEdge(from: string, to: string) {
+  return {
+    from_symbol_id: from,
+    to_symbol_id: to,
+    type: "call",
+    weight: 1,
+    confidence: 1,
+  };
+}
+
+function symbolRow(id: string, name = id) {
+  return {
+    symbolId: id,
+    repoId: REPO,
+    fileId: `${REPO}:src/a.ts`,
+    kind: "function",
+    name,
+    exported: true,
+    visibility: null,
+    language: "typescript",
+    rangeStartLine: 1,
+    rangeStartCol: 0,
+    rangeEndLine: 2,
+    rangeEndCol: 0,
+    astFingerprint: `fp-${id}`,
+    signatureJson: null,
+    summary: null,
+    invariantsJson: null,
+    sideEffectsJson: null,
+    external: false,
+    packageName: null,
+    packageVersion: null,
+    scipSymbol: null,
+    updatedAt: "2026-01-01T00:00:00.000Z",
+  };
+}
+
+function edgeRow(from: string, to: string) {
+  return {
+    repoId: REPO,
+    fromSymbolId: from,
+    toSymbolId: to,
+    edgeType: "call",
+    weight: 1,
+    confidence: 1,
+    resolution: "exact",
+    provenance: null,
+    createdAt: "2026-01-01T00:00:00.000Z",
+  };
+}
+
+function fileRow(relPath: string) {
+  return {
+    fileId: `${REPO}:${relPath}`,
+    repoId: REPO,
+    relPath,
+    contentHash: "hash",
+    language: "typescript",
+    byteSize: 10,
+    lastIndexedAt: "2026-01-01T00:00:00.000Z",
+    directory: "src",
+  };
+}
+
+/**
+ * a, c in src/a.ts; b in src/b.ts. Edges a->b, c->b, b->c and a SCIP
+ * edge a->b2.
+ */
+function seed() {
+  const a = legacySymbol("a", 1, { package_name: "pkg" });
+  const b = legacySymbol("b", 2);
+  const b2 = legacySymbol("b2", 2);
+  const c = legacySymbol("c", 1);
+  const ab = legacyEdge("a", "b");
+  const cb = legacyEdge("c", "b");
+  const bc = legacyEdge("b", "c");
+  const scip = legacyEdge("a", "b2");
+  const graph = {
+    repoId: REPO,
+    symbols: new Map<string, any>([
+      ["a", a],
+      ["b", b],
+      ["b2", b2],
+      ["c", c],
+    ]),
+    edges: [ab, cb, bc, scip],
+    adjacencyOut: new Map<string, any[]>([
+      ["a", [ab, scip]],
+      ["b", [bc]],
+      ["b2", []],
+      ["c", [cb]],
+    ]),
+    adjacencyIn: new Map<string, any[]>([
+      ["a", []],
+      ["b", [ab, cb]],
+      ["b2", [scip]],
+      ["c", [bc]],
+    ]),
+    files: new Map<number, any>([
+      [1, { file_id: 1, rel_path: "src/a.ts" }],
+      [2, { file_id: 2, rel_path: "src/b.ts" }],
+    ]),
+    clusters: new Map(),
+  } as any;
+  const scipEdges = new WeakSet<object>([scip]);
+  assert.ok(setGraphSnapshot(REPO, graph, undefined, scipEdges as any));
+  return { graph, ab, cb, bc, scip };
+}
+
+describe("applyGraphSnapshotPatch", () => {
+  beforeEach(() => {
+    clearGraphSnapshots();
+  });
+
+  it("returns false when no snapshot is cached", () => {
+    const applied = applyGraphSnapshotPatch(REPO, {
+      file: fileRow("src/a.ts"),
+      symbols: [],
+      removedSymbolIds: [],
+      refreshedSymbolIds: [],
+      edges: [],
+    } as any);
+    assert.strictEqual(applied, false);
+  });
+
+  it("applies the file's changes copy-on-write", () => {
+    const { graph, scip } = seed();
+    const before = getGraphSnapshotCreatedAt(REPO)!;
+
+    const applied = applyGraphSnapshotPatch(REPO, {
+      file: fileRow("src/a.ts"),
+      symbols: [symbolRow("a", "renamed"), symbolRow("d")],
+      removedSymbolIds: ["c"],
+      refreshedSymbolIds: ["a"],
+      edges: [edgeRow("a", "d"), edgeRow("d", "b")],
+    } as any);
+    assert.strictEqual(applied, true);
+
+    const next = getGraphSnapshot(REPO)!;
+    assert.notStrictEqual(next, graph);
+
+    // The previous graph is untouched.
+    assert.strictEqual(graph.symbols.size, 4);
+    assert.strictEqual(graph.edges.length, 4);
+    assert.strictEqual(graph.adjacencyIn.get("b").length, 2);
+
+    // Untouched rows and lists are shared.
+    assert.strictEqual(next.symbols.get("b"), graph.symbols.get("b"));
+    assert.strictEqual(next.adjacencyIn.get("b2"), graph.adjacencyIn.get("b2"));
+
+    assert.strictEqual(next.symbols.has("c"), false);
+    assert.strictEqual(next.adjacencyOut.has("c"), false);
+    const a = next.symbols.get("a")!;
+    assert.strictEqual(a.name, "renamed");
+    assert.strictEqual(a.file_id, 1);
+    assert.strictEqual(a.package_name, "pkg");
+    assert.strictEqual(next.symbols.get("d")!.file_id, 1);
+
+    const targets = (list: any[] | undefined) =>
+      (list ?? []).map((edge) => edge.to_symbol_id).sort();
+    const sources = (list: any[] | undefined) =>
+      (list ?? []).map((edge) => edge.from_symbol_id).sort();
+    // a->b is replaced; the SCIP edge survives.
+    assert.deepStrictEqual(targets(next.adjacencyOut.get("a")), ["b2", "d"]);
+    assert.ok(next.adjacencyOut.get("a")!.includes(scip));
+    assert.deepStrictEqual(sources(next.adjacencyIn.get("b")), ["d"]);
+    assert.deepStrictEqual(next.adjacencyOut.get("b"), []);
+    assert.deepStrictEqual(sources(next.adjacencyIn.get("d")), ["a"]);
+    assert.strictEqual(next.edges.length, 3);
+
+    const after = getGraphSnapshotCreatedAt(REPO)!;
+    assert.ok(after > before);
+    assert.strictEqual(sharesGraphSnapshotLineage(REPO, before, after), true);
+  });
+
+  it("keeps each patched version intact across chained patches", () => {
+    const { graph } = seed();
+    applyGraphSnapshotPatch(REPO, {
+      file: fileRow("src/a.ts"),
+      symbols: [symbolRow("d")],
+      removedSymbolIds: [],
+      refreshedSymbolIds: [],
+      edges: [edgeRow("d", "b")],
+    } as any);
+    const first = getGraphSnapshot(REPO)!;
+    applyGraphSnapshotPatch(REPO, {
+      file: fileRow("src/a.ts"),
+      symbols: [],
+      removedSymbolIds: ["d"],
+      refreshedSymbolIds: [],
+      edges: [],
+    } as any);
+    const second = getGraphSnapshot(REPO)!;
+
+    assert.strictEqual(graph.edges.length, 4);
+    assert.strictEqual(first.symbols.has("d"), true);
+    assert.strictEqual(first.edges.length, 5);
+    assert.strictEqual(first.adjacencyIn.get("b").length, 3);
+    assert.strictEqual(second.symbols.has("d"), false);
+    assert.strictEqual(second.edges.length, 4);
+    assert.strictEqual(second.adjacencyIn.get("b").length, 2);
+    assert.deepStrictEqual(
+      [...second.symbols.keys()].sort(),
+      ["a", "b", "b2", "c"],
+    );
+  });
+
+  it("encodes a patched snapshot for the rewritten snapshot file", () => {
+    const { scip } = seed();
+    applyGraphSnapshotPatch(REPO, {
+      file: fileRow("src/a.ts"),
+      symbols: [symbolRow("d")],
+      removedSymbolIds: ["c"],
+      refreshedSymbolIds: [],
+      edges: [edgeRow("d", "b")],
+    } as any);
+    const next = getGraphSnapshot(REPO)!;
+    const contents = decodeGraphSnapshot(
+      encodeGraphSnapshot(next, getCsrSnapshot(next), {
+        versionId: "v1",
+        scipEdges: new WeakSet([scip]) as any,
+      }),
+    )!;
+    assert.deepStrictEqual(
+      contents.symbols.map((symbol: any) => symbol.symbol_id).sort(),
+      ["a", "b", "b2", "d"],
+    );
+    assert.deepStrictEqual(
+      contents.edges.map((edge: any) => `${edge.from_symbol_id}>${edge.to_symbol_id}`),
+      ["a>b", "a>b2", "d>b"],
+    );
+    assert.strictEqual(contents.files.length, 2);
+  });
+
+  it("gives a new file the next numeric id", () => {
+    seed();
+    const row = { ...symbolRow("e"), fileId: `${REPO}:src/e.ts` };
+    applyGraphSnapshotPatch(REPO, {
+      file: fileRow("src/e.ts"),
+      symbols: [row],
+      removedSymbolIds: [],
+      refreshedSymbolIds: [],
+      edges: [],
+    } as any);
+    const next = getGraphSnapshot(REPO)!;
+    assert.strictEqual(next.symbols.get("e")!.file_id, 3);
+    assert.strictEqual(next.files!.get(3)!.rel_path, "src/e.ts");
+    assert.strictEqual(next.files!.size, 3);
+  });
+});
@@ -0,0 +1,133 @@
+import { describe, it } from "node:test";
+import assert from "node:assert/strict";
+
+import {
+  buildCsrGraph,
+  csrEdgeTypeMask,
+  getCsrSnapshot,
+  peekCsrSnapshot,
+} from "../../../dist/graph/csr-snapshot.js";
+import type { Graph } from "../../../dist/graph/buildGraph.js";
+
+type Edge = [string, string, string?, number?, number?];
+
+function build(
+  ids: string[],
+  edges: Edge[],
+  options?: { includeUnknownEndpoints?: boolean },
+) {
+  return buildCsrGraph(
+    ids,
+    (emit) => {
+      for (const [from, to, type, weight, confidence] of edges) {
+        emit(from, to, type as never, weight, confidence);
+      }
+    },
+    options,
+  );
+}
+
+function row(graph: ReturnType<typeof build>, id: string): string[] {
+  const node = graph.nodeOf(id);
+  assert.ok(node !== undefined);
+  const out: string[] = [];
+  for (let e = graph.offsets[node]; e < graph.offsets[node + 1]; e++) {
+    out.push(graph.symbolIds[graph.neighbors[e]]);
+  }
+  return out;
+}
+
+describe("buildCsrGraph", () => {
+  it("interns symbol ids in sorted order and sorts each row", () => {
+    const graph = build(
+      ["c", "a", "b", "a"],
+      [
+        ["a", "c", "call"],
+        ["a", "b", "import"],
+        ["c", "a", "call"],
+      ],
+    );
+    assert.deepEqual(graph.symbolIds, ["a", "b", "c"]);
+    assert.deepEqual(Array.from(graph.offsets), [0, 2, 2, 3]);
+    assert.deepEqual(row(graph, "a"), ["b", "c"]);
+    assert.deepEqual(row(graph, "c"), ["a"]);
+    // Columns move with the sorted neighbors.
+    assert.deepEqual(Array.from(graph.edgeTypes), [1, 0, 0]);
+    assert.equal(graph.edgeCount, 3);
+    assert.equal(graph.external, undefined);
+  });
+
+  it("keeps long rows stable and their columns aligned", () => {
+    const ids = Array.from({ length: 40 }, (_, i) =>
+      `s${String(i).padStart(2, "0")}`,
+    );
+    const edges: Edge[] = [];
+    for (let i = ids.length - 1; i > 0; i--) {
+      edges.push(["s00", ids[i], "call", i]);
+    }
+    edges.push(["s00", "s05", "call", 100]);
+    const graph = build(ids, edges);
+    const targets = row(graph, "s00");
+    assert.deepEqual(targets, [...targets].sort());
+    const at = targets.indexOf("s05");
+    assert.equal(graph.weights[at], 5);
+    assert.equal(graph.weights[at + 1], 100);
+  });
+
+  it("drops or flags unknown endpoints", () => {
+    const edges: Edge[] = [
+      ["a", "ext", "call"],
+      ["ext", "b", "call"],
+      ["a", "b", "call"],
+    ];
+    const strict = build(["a", "b"], edges);
+    assert.equal(strict.edgeCount, 1);
+
+    const open = build(["a", "b"], edges, { includeUnknownEndpoints: true });
+    assert.deepEqual(open.symbolIds, ["a", "b", "ext"]);
+    assert.deepEqual(Array.from(open.external ?? []), [0, 0, 1]);
+    assert.deepEqual(row(open, "ext"), ["b"]);
+  });
+
+  it("stores clamped edge strength and type codes", () => {
+    const graph = build(
+      ["a", "b", "c", "d"],
+      [
+        ["a", "b", "config", 2, 0.5],
+        ["a", "c", "implements", -1, 1],
+        ["a", "d", undefined, Number.NaN, 1],
+      ],
+    );
+    assert.deepEqual(Array.from(graph.weights), [1, 0, 0]);
+    assert.deepEqual(Array.from(graph.edgeTypes), [2, 3, 255]);
+    assert.equal(csrEdgeTypeMask(), 0);
+    assert.equal(csrEdgeTypeMask("call", "implements"), 0b1001);
+  });
+});
+
+describe("getCsrSnapshot", () => {
+  it("builds once per graph from adjacencyOut", () => {
+    const graph = {
+      repoId: "repo",
+      symbols: new Map([
+        ["b", { symbolId: "b" }],
+        ["a", { symbolId: "a" }],
+      ]),
+      edges: [],
+      adjacencyOut: new Map([
+        ["a", [{ from_symbol_id: "a", to_symbol_id: "b", type: "call" }]],
+        ["b", [{ from_symbol_id: "b", to_symbol_id: "gone", type: "call" }]],
+      ]),
+      adjacencyIn: new Map(),
+    } as unknown as Graph;
+
+    assert.equal(peekCsrSnapshot(graph), undefined);
+    const csr = getCsrSnapshot(graph);
+    assert.equal(getCsrSnapshot(graph), csr);
+    assert.equal(peekCsrSnapshot(graph), csr);
+    assert.deepEqual(csr.symbolIds, ["a", "b"]);
+    assert.deepEqual(row(csr, "a"), ["b"]);
+    assert.deepEqual(row(csr, "b"), []);
+    assert.ok(csr.byteLength > 0);
+  });
+});
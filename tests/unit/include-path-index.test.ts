@@ -0,0 +1,85 @@
+import assert from "node:assert/strict";
+import { describe, it } from "node:test";
+
+import {
+  IncludePathIndex,
+  isTrieResolvableSpecifier,
+} from "../../dist/indexer/import-resolution/include-path-index.js";
+import { resolveImportCandidatePaths } from "../../dist/indexer/import-resolution/registry.js";
+
+const EXTENSIONS = [".c", ".h", ".hpp"];
+const FILES = [
+  "src/main.c",
+  "src/utils.h",
+  "src/net/socket.h",
+  "include/mylib/core.h",
+  "inc/legacy.h",
+  "config.h",
+  "third_party/llvm/ADT/StringRef.h",
+];
+
+describe("IncludePathIndex", () => {
+  it("tries the including directory, the root, then include roots", () => {
+    const index = new IncludePathIndex(FILES);
+    assert.equal(index.resolve("src", "utils.h", EXTENSIONS), "src/utils.h");
+    assert.equal(index.resolve("src", "config.h", EXTENSIONS), "config.h");
+    assert.equal(
+      index.resolve("src", "mylib/core", EXTENSIONS),
+      "include/mylib/core.h",
+    );
+    assert.equal(
+      index.resolve("src/net", "legacy.h", EXTENSIONS),
+      "inc/legacy.h",
+    );
+    assert.equal(
+      index.resolve("src/net", "../utils.h", EXTENSIONS),
+      "src/utils.h",
+    );
+    assert.equal(index.resolve(".", "../../config.h", EXTENSIONS), null);
+    assert.equal(index.resolve("src", "missing.h", EXTENSIONS), null);
+  });
+
+  it("memoises per including directory and specifier", () => {
+    const index = new IncludePathIndex(FILES);
+    index.resolve("src", "utils.h", EXTENSIONS);
+    index.resolve("src", "utils.h", EXTENSIONS);
+    index.resolve("src/net", "utils.h", EXTENSIONS);
+    assert.equal(index.memoSize, 2);
+    // A different extension list gets its own memo.
+    assert.equal(index.resolve("src", "utils", [".c"]), null);
+    assert.equal(index.resolve("src", "utils", EXTENSIONS), "src/utils.h");
+  });
+
+  it("leaves absolute and backslashed specifiers to the path fallback", () => {
+    assert.equal(isTrieResolvableSpecifier("llvm/ADT/StringRef.h"), true);
+    assert.equal(isTrieResolvableSpecifier("/usr/include/stdio.h"), false);
+    assert.equal(isTrieResolvableSpecifier("win\\path.h"), false);
+    assert.equal(isTrieResolvableSpecifier("dir/.."), false);
+  });
+
+  it("matches the known-path adapter through the registry", async () => {
+    const knownRepoPaths = new Set(FILES);
+    const includePathIndex = new IncludePathIndex(FILES);
+    for (const specifier of [
+      "utils.h",
+      "net/socket",
+      "mylib/core.h",
+      "llvm/ADT/StringRef.h",
+      "../config.h",
+    ]) {
+      const params = {
+        language: "cpp",
+        repoRoot: "/nonexistent",
+        importerRelPath: "src/net/socket.h",
+        specifier,
+        extensions: EXTENSIONS,
+        knownRepoPaths,
+      };
+      assert.deepStrictEqual(
+        await resolveImportCandidatePaths({ ...params, includePathIndex }),
+        await resolveImportCandidatePaths(params),
+        specifier,
+      );
+    }
+  });
+});
@@ -0,0 +1,62 @@
+import assert from "node:assert";
+import { afterEach, describe, it } from "node:test";
+
+import {
+  LADYBUG_WRITE_CHUNK_SIZES,
+  adaptiveLadybugWriteChunkSize,
+  getLadybugWriteChunkSizes,
+  isAdaptiveLadybugWriteChunkingEnabled,
+  recordLadybugWriteChunk,
+  resetLadybugWriteChunkSizing,
+} from "../../dist/db/ladybug-batching.js";
+
+describe("adaptive LadybugDB write chunk sizing", () => {
+  afterEach(() => {
+    resetLadybugWriteChunkSizing();
+  });
+
+  it("starts at the fixed default", () => {
+    assert.strictEqual(
+      adaptiveLadybugWriteChunkSize("symbols"),
+      LADYBUG_WRITE_CHUNK_SIZES.symbols,
+    );
+  });
+
+  it("lets an explicit chunk size win", () => {
+    assert.strictEqual(adaptiveLadybugWriteChunkSize("symbols", 7), 7);
+    assert.throws(() => adaptiveLadybugWriteChunkSize("symbols", 0));
+  });
+
+  it("grows after a run of fast full chunks, up to the ceiling", () => {
+    for (let round = 0; round < 10; round++) {
+      for (let i = 0; i < 4; i++) {
+        const size = adaptiveLadybugWriteChunkSize("symbols");
+        recordLadybugWriteChunk("symbols", size, 1);
+      }
+    }
+    assert.strictEqual(adaptiveLadybugWriteChunkSize("symbols"), 1024);
+  });
+
+  it("ignores short tail chunks when growing", () => {
+    for (let i = 0; i < 8; i++) recordLadybugWriteChunk("symbols", 10, 1);
+    assert.strictEqual(adaptiveLadybugWriteChunkSize("symbols"), 256);
+  });
+
+  it("halves after a slow chunk, down to the floor", () => {
+    recordLadybugWriteChunk("edges", 4096, 500);
+    assert.strictEqual(adaptiveLadybugWriteChunkSize("edges"), 2048);
+    for (let i = 0; i < 20; i++) recordLadybugWriteChunk("edges", 1, 500);
+    assert.strictEqual(adaptiveLadybugWriteChunkSize("edges"), 16);
+    assert.deepStrictEqual(getLadybugWriteChunkSizes(), { edges: 16 });
+  });
+
+  it("is disabled by SDL_MCP_ADAPTIVE_WRITE_CHUNKS=0", () => {
+    assert.strictEqual(
+      isAdaptiveLadybugWriteChunkingEnabled({
+        SDL_MCP_ADAPTIVE_WRITE_CHUNKS: "0",
+      }),
+      false,
+    );
+    assert.strictEqual(isAdaptiveLadybugWriteChunkingEnabled({}), true);
+  });
+});
@@ -1047,6 +1047,41 @@ describe("LadybugDB Metrics Queries", () => {
       assert.strictEqual(result[1].fanIn, 75);
     });
 
+    it("reads positive stored PageRank per repo symbol", async () => {
+      await queries.upsertCentralityBatch(
+        conn as unknown as import("kuzu").Connection,
+        [
+          {
+            symbolId: "top-sym-1",
+            pageRank: 0.375,
+            kCore: 2,
+            updatedAt: "2024-01-02T00:00:00Z",
+          },
+          {
+            symbolId: "top-sym-2",
+            pageRank: 0,
+            kCore: 1,
+            updatedAt: "2024-01-02T00:00:00Z",
+          },
+        ],
+      );
+
+      const result = await queries.getPageRankByRepo(
+        conn as unknown as import("kuzu").Connection,
+        "top-test-repo",
+      );
+      assert.deepStrictEqual([...result], [["top-sym-1", 0.375]]);
+      assert.strictEqual(
+        (
+          await queries.getPageRankByRepo(
+            conn as unknown as import("kuzu").Connection,
+            "non-existent-repo",
+          )
+        ).size,
+        0,
+      );
+    });
+
     it("should return empty array for non-existent repo", async () => {
       const result = await queries.getTopSymbolsByFanIn(
         conn as unknown as import("kuzu").Connection,
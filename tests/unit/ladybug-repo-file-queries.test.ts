@@ -152,6 +152,67 @@ describe("LadybugDB Repo & File Queries", () => {
     },
   );
 
+  it(
+    "recordFileContentFastHashes only lands on rows with the same content hash",
+    { skip: !ladybugAvailable },
+    async () => {
+      const repoId = "repo-fast-hash";
+      const c = conn as unknown as import("kuzu").Connection;
+      await queries.upsertRepo(c, {
+        repoId,
+        rootPath: "C:/tmp/repo-fast-hash",
+        configJson: "{}",
+        createdAt: "2026-03-04T00:00:00Z",
+      });
+      for (const fileId of ["fast-1", "fast-2"]) {
+        await queries.upsertFile(c, {
+          fileId,
+          repoId,
+          relPath: `src/${fileId}.ts`,
+          contentHash: `hash-${fileId}`,
+          language: "ts",
+          byteSize: 1,
+          lastIndexedAt: "2026-03-04T00:00:00Z",
+        });
+      }
+      assert.strictEqual(
+        await queries.getRepoContentFastHashAlgorithm(c, repoId),
+        null,
+      );
+
+      await queries.recordFileContentFastHashes(c, repoId, "xxh3-128", [
+        { fileId: "fast-1", contentHash: "hash-fast-1", contentFastHash: "f1" },
+        { fileId: "fast-2", contentHash: "stale", contentFastHash: "f2" },
+      ]);
+
+      assert.strictEqual(
+        await queries.getRepoContentFastHashAlgorithm(c, repoId),
+        "xxh3-128",
+      );
+      const digests = async () =>
+        new Map(
+          (await queries.getFilesByRepo(c, repoId)).map((file) => [
+            file.fileId,
+            file.contentFastHash,
+          ]),
+        );
+      assert.strictEqual((await digests()).get("fast-1"), "f1");
+      assert.strictEqual((await digests()).get("fast-2"), null);
+
+      // A row rewritten without a digest must not keep the old one.
+      await queries.upsertFile(c, {
+        fileId: "fast-1",
+        repoId,
+        relPath: "src/fast-1.ts",
+        contentHash: "hash-fast-1-changed",
+        language: "ts",
+        byteSize: 1,
+        lastIndexedAt: "2026-03-05T00:00:00Z",
+      });
+      assert.strictEqual((await digests()).get("fast-1"), null);
+    },
+  );
+
   it(
     "getFilesByDirectory and getFileCount",
     { skip: !ladybugAvailable },
@@ -2,7 +2,8 @@ import assert from "node:assert";
 import { describe, it } from "node:test";
 
 import { computeForceLayout } from "../../dist/graph/layout/force-layout.js";
-import { effectiveIterations, planWarmStart } from "../../dist/graph/layout/layout-service.js";
+import { BARNES_HUT_MIN_NODES, effectiveIterations, planWarmStart, usesBarnesHut } from "../../dist/graph/layout/layout-service.js";
+import { isNativeBarnesHutAvailable, streamNativeBarnesHutLayout } from "../../dist/graph/layout/native-engine.js";
 import { fnv1a32, mulberry32 } from "../../dist/graph/layout/prng.js";
 import { serializeLayoutResult } from "../../dist/graph/layout/serializer.js";
 import type { LayoutInput } from "../../dist/graph/layout/types.js";
@@ -153,6 +154,19 @@ describe("layout engine", () => {
     assert.equal(effectiveIterations(20000, 300), 50);
   });
 
+  it("routes only large graphs to the native Barnes–Hut engine", async () => {
+    const native = isNativeBarnesHutAvailable();
+    assert.equal(usesBarnesHut(BARNES_HUT_MIN_NODES, "auto"), false);
+    assert.equal(usesBarnesHut(BARNES_HUT_MIN_NODES + 1, "auto"), native);
+    assert.equal(usesBarnesHut(BARNES_HUT_MIN_NODES + 1, "rust"), native);
+    assert.equal(usesBarnesHut(BARNES_HUT_MIN_NODES + 1, "typescript"), false);
+    if (!native) {
+      const frames = [];
+      for await (const frame of streamNativeBarnesHutLayout(GOLDEN_INPUT, 1, 10)) frames.push(frame);
+      assert.deepEqual(frames, []);
+    }
+  });
+
   it("lays out 5,000 nodes / 8,000 edges within the CI bound", async () => {
     const rng = mulberry32(0xfeedf00d);
     const count = 5000;
@@ -0,0 +1,59 @@
+import { describe, it } from "node:test";
+import assert from "node:assert/strict";
+
+import {
+  findLexicalSeedsByIdPrefix,
+  findLexicalSeedsByName,
+  hasLexicalSymbol,
+  invalidateLexicalIndex,
+  patchLexicalIndex,
+  searchLexicalIndex,
+  shouldUseNativeLexicalIndex,
+} from "../../dist/retrieval/lexical-index.js";
+
+/** A connection no build can read from, so no index ever appears. */
+const conn = {
+  query: async () => {
+    throw new Error("no database in this test");
+  },
+} as any;
+
+describe("native lexical index", () => {
+  it("is on unless disabled by environment", () => {
+    assert.equal(shouldUseNativeLexicalIndex({}), true);
+    assert.equal(
+      shouldUseNativeLexicalIndex({ SDL_MCP_NATIVE_LEXICAL_INDEX: "1" }),
+      true,
+    );
+    for (const value of ["0", "false", "NO", " 0 "]) {
+      assert.equal(
+        shouldUseNativeLexicalIndex({ SDL_MCP_NATIVE_LEXICAL_INDEX: value }),
+        false,
+      );
+    }
+  });
+
+  it("returns null so callers fall back to LadybugDB without an index", () => {
+    const repoId = `missing-${process.pid}`;
+    assert.equal(searchLexicalIndex(conn, repoId, "login", 5, false), null);
+    assert.equal(findLexicalSeedsByName(conn, repoId, "login", "exact"), null);
+    assert.equal(findLexicalSeedsByIdPrefix(conn, repoId, "abcdef"), null);
+    assert.equal(hasLexicalSymbol(conn, repoId, "abcdef"), null);
+    invalidateLexicalIndex(repoId);
+  });
+
+  it("leaves FTS wildcard queries to LadybugDB", () => {
+    assert.equal(searchLexicalIndex(conn, "repo", "log*", 5, false), null);
+    assert.equal(searchLexicalIndex(conn, "repo", "l?gin", 5, false), null);
+    invalidateLexicalIndex("repo");
+  });
+
+  it("ignores patches for repos without an index", () => {
+    assert.doesNotThrow(() =>
+      patchLexicalIndex(`missing-${process.pid}`, {
+        symbols: [{ symbolId: "a", name: "login", searchText: "login" }],
+        removedSymbolIds: ["b"],
+      }),
+    );
+  });
+});
@@ -129,7 +129,7 @@ describe("migration: graph integrity revisions and manifest", () => {
     ]);
     const summary = await getDerivedStateSummary("repo");
 
-    assert.equal(LADYBUG_SCHEMA_VERSION, 23);
+    assert.equal(LADYBUG_SCHEMA_VERSION, 24);
     assert.deepEqual(
       rows.map((row) => ({
         state: row?.graphIntegrityState,
@@ -349,14 +349,14 @@ describe("m007 safe SymbolEmbedding remediation", () => {
 
 describe("SymbolEmbedding migration registry and initializer paths", () => {
   it("keeps m021 before the graph-integrity migration", () => {
-    assert.equal(LADYBUG_SCHEMA_VERSION, 23);
+    assert.equal(LADYBUG_SCHEMA_VERSION, 24);
     assert.deepEqual(
       computePendingMigrations(migrations, 20).map(({ version }) => version),
-      [21, 22, 23],
+      [21, 22, 23, 24],
     );
     assert.deepEqual(
       computePendingMigrations(migrations, 7).map(({ version }) => version),
-      Array.from({ length: 16 }, (_, index) => index + 8),
+      Array.from({ length: 17 }, (_, index) => index + 8),
     );
   });
 
@@ -372,7 +372,7 @@ describe("SymbolEmbedding migration registry and initializer paths", () => {
     await initLadybugDb(dbPath);
     conn = await getLadybugConn();
 
-    assert.equal(await getSchemaVersion(conn), 23);
+    assert.equal(await getSchemaVersion(conn), 24);
     assert.deepEqual(await readSourceIds(conn), []);
     assert.equal(
       (await readDestinationRows(conn))[0]?.embeddingMiniLM,
@@ -380,7 +380,7 @@ describe("SymbolEmbedding migration registry and initializer paths", () => {
     );
   });
 
-  it("runs versions 8 through 23 in order from a recorded version 7", async () => {
+  it("runs versions 8 through 24 in order from a recorded version 7", async () => {
     const dbPath = join(testRoot, "version-7.lbug");
     mkdirSync(testRoot, { recursive: true });
     await initLadybugDb(dbPath);
@@ -409,9 +409,9 @@ describe("SymbolEmbedding migration registry and initializer paths", () => {
       conn = await getLadybugConn();
       assert.deepEqual(
         invoked,
-        Array.from({ length: 16 }, (_, index) => index + 8),
+        Array.from({ length: 17 }, (_, index) => index + 8),
       );
-      assert.equal(await getSchemaVersion(conn), 23);
+      assert.equal(await getSchemaVersion(conn), 24);
       assert.deepEqual(await readSourceIds(conn), []);
       assert.equal(
         (await readDestinationRows(conn))[0]?.embeddingMiniLM,
@@ -0,0 +1,136 @@
+import { describe, it } from "node:test";
+import assert from "node:assert/strict";
+
+import { beamSearch } from "../../dist/graph/slice/beam-search-engine.js";
+import {
+  beamSearchInMemory,
+  nativeBeamSearchMode,
+  packSliceGraph,
+} from "../../dist/graph/slice/native-beam-search.js";
+
+function symbol(id: string, name: string, fileId = 1) {
+  return {
+    symbol_id: id,
+    repo_id: "test-repo",
+    name,
+    kind: "function",
+    file_id: fileId,
+    exported: 1,
+    visibility: "public",
+    language: "ts",
+    range_start_line: 1,
+    range_start_col: 0,
+    range_end_line: 10,
+    range_end_col: 0,
+    ast_fingerprint: "",
+    signature_json: null,
+    summary: null,
+    invariants_json: null,
+    side_effects_json: null,
+    updated_at: "",
+  };
+}
+
+function edge(from: string, to: string, type: string, confidence?: number) {
+  return {
+    repo_id: "test-repo",
+    from_symbol_id: from,
+    to_symbol_id: to,
+    type,
+    weight: 1,
+    provenance: null,
+    created_at: "",
+    confidence,
+  };
+}
+
+function graphOf(
+  symbols: ReturnType<typeof symbol>[],
+  edges: ReturnType<typeof edge>[],
+) {
+  const adjacencyOut = new Map<string, unknown[]>();
+  const adjacencyIn = new Map<string, unknown[]>();
+  for (const e of edges) {
+    if (!adjacencyOut.has(e.from_symbol_id)) {
+      adjacencyOut.set(e.from_symbol_id, []);
+    }
+    adjacencyOut.get(e.from_symbol_id)!.push(e);
+    if (!adjacencyIn.has(e.to_symbol_id)) adjacencyIn.set(e.to_symbol_id, []);
+    adjacencyIn.get(e.to_symbol_id)!.push(e);
+  }
+  return {
+    repoId: "test-repo",
+    symbols: new Map(symbols.map((s) => [s.symbol_id, s])),
+    edges,
+    adjacencyOut,
+    adjacencyIn,
+    files: new Map([[1, { file_id: 1, rel_path: "src/Server.ts" }]]),
+  } as any; // eslint-disable-line @typescript-eslint/no-explicit-any
+}
+
+describe("native beam search", () => {
+  it("reads its mode from the environment", () => {
+    assert.equal(nativeBeamSearchMode({}), "on");
+    assert.equal(
+      nativeBeamSearchMode({ SDL_MCP_NATIVE_BEAM_SEARCH: "1" }),
+      "on",
+    );
+    assert.equal(
+      nativeBeamSearchMode({ SDL_MCP_NATIVE_BEAM_SEARCH: " Parity " }),
+      "parity",
+    );
+    for (const value of ["0", "false", "NO"]) {
+      assert.equal(
+        nativeBeamSearchMode({ SDL_MCP_NATIVE_BEAM_SEARCH: value }),
+        "off",
+      );
+    }
+  });
+
+  it("packs rows in expansion order with one entry per target", () => {
+    const graph = graphOf(
+      [symbol("a", "Alpha"), symbol("b", "beta", 0), symbol("c", "gamma")],
+      [
+        edge("a", "c", "import", 0.4),
+        edge("a", "b", "call", 2),
+        edge("a", "c", "config"),
+        edge("a", "missing", "call"),
+      ],
+    );
+    const { csr, input } = packSliceGraph(graph);
+    const [a, b, c] = ["a", "b", "c"].map((id) => csr.nodeOf(id)!);
+
+    assert.deepEqual(Array.from(input.offsets), [0, 2, 2, 2]);
+    assert.deepEqual(Array.from(input.neighbors), [c, b]);
+    // The last edge to `c` wins; confidence is normalised.
+    assert.deepEqual(Array.from(input.edgeTypes), [2, 0]);
+    assert.deepEqual(Array.from(input.confidences), [1, 1]);
+    assert.equal(input.names[a], "alpha");
+    assert.deepEqual(input.filePaths, ["src/Server.ts"]);
+    assert.deepEqual(input.filePathsLower, ["src/server.ts"]);
+    assert.equal(input.nodeFiles[b], 0xffffffff);
+    assert.equal(input.structure[b], 0.8);
+  });
+
+  it("falls back to beamSearch without the addon", () => {
+    const graph = graphOf(
+      [symbol("a", "alpha"), symbol("b", "alphaBeta"), symbol("c", "gamma")],
+      [edge("a", "b", "call"), edge("a", "c", "import", 0.9)],
+    );
+    const args = [
+      graph,
+      [{ symbolId: "a", source: "entrySymbol" as const }],
+      { maxCards: 10, maxEstimatedTokens: 10_000 },
+      { entrySymbols: ["a"], taskText: "alpha" },
+      { call: 1, import: 0.6, config: 0.8 },
+      0.5,
+    ] as const;
+    const expected = beamSearch(...args);
+    const actual = beamSearchInMemory(...args);
+    assert.deepEqual(
+      Array.from(actual.sliceCards),
+      Array.from(expected.sliceCards),
+    );
+    assert.deepEqual(actual.frontier, expected.frontier);
+  });
+});
@@ -0,0 +1,142 @@
+import assert from "node:assert";
+import { mkdirSync, mkdtempSync, rmSync, writeFileSync } from "node:fs";
+import { tmpdir } from "node:os";
+import { join, resolve } from "node:path";
+import { describe, it } from "node:test";
+
+import {
+  collectThroughputCorpus,
+  measureCorpusThroughput,
+  nativeBenchmarkMetrics,
+  readCriterionEstimates,
+} from "../../dist/benchmark/native-throughput.js";
+import { RegressionReportGenerator } from "../../dist/benchmark/regression.js";
+import {
+  ThresholdEvaluator,
+  type BenchmarkThresholds,
+} from "../../dist/benchmark/threshold.js";
+
+const FIXTURES = resolve(process.cwd(), "tests/stress/fixtures");
+
+describe("native throughput benchmark", () => {
+  it("collects natively parsed fixture files only", () => {
+    const corpus = collectThroughputCorpus("stress", FIXTURES);
+    assert.ok(corpus.files.length > 0);
+    assert.ok(corpus.files.some((f) => f.path === "src/go/server.go"));
+    assert.ok(!corpus.files.some((f) => f.path.endsWith(".kt")));
+    assert.ok(!corpus.files.some((f) => f.path.endsWith(".md")));
+    assert.strictEqual(
+      corpus.bytes,
+      corpus.files.reduce((sum, f) => sum + f.size, 0),
+    );
+  });
+
+  it("times rounds and counts symbols and parse errors", () => {
+    const corpus = collectThroughputCorpus("stress", FIXTURES, { maxFiles: 3 });
+    let calls = 0;
+    const result = measureCorpusThroughput(
+      corpus,
+      (_repoId, _root, files) => {
+        calls++;
+        return files.map((file, i) => ({
+          relPath: file.path,
+          contentHash: "",
+          symbols: [],
+          imports: [],
+          calls: [],
+          parseError: i === 0 ? "boom" : null,
+        }));
+      },
+      { rounds: 2 },
+    );
+    assert.ok(result);
+    assert.strictEqual(calls, 3); // warm-up + 2 rounds
+    assert.strictEqual(result.files, 3);
+    assert.strictEqual(result.parseErrors, 1);
+    assert.ok(result.peakRssMb > 0);
+  });
+
+  it("reports null when the native engine is unavailable", () => {
+    const corpus = collectThroughputCorpus("stress", FIXTURES, { maxFiles: 1 });
+    assert.strictEqual(measureCorpusThroughput(corpus, () => null), null);
+  });
+
+  it("reads Criterion estimates with peak heap", () => {
+    const dir = mkdtempSync(join(tmpdir(), "sdl-criterion-"));
+    try {
+      const bench = join(dir, "parse_files_parallel", "ts");
+      mkdirSync(join(bench, "new"), { recursive: true });
+      mkdirSync(join(dir, "report"), { recursive: true });
+      writeFileSync(
+        join(bench, "new", "estimates.json"),
+        JSON.stringify({ mean: { point_estimate: 2_500_000 } }),
+      );
+      writeFileSync(
+        join(bench, "peak_heap.json"),
+        JSON.stringify({ peakHeapBytes: 3 * 1024 * 1024 }),
+      );
+      const estimates = readCriterionEstimates(dir);
+      assert.deepStrictEqual(estimates, {
+        "parse_files_parallel/ts": { meanMs: 2.5, peakHeapBytes: 3145728 },
+      });
+      const metrics = nativeBenchmarkMetrics([], estimates);
+      assert.strictEqual(metrics["criterion.parse_files_parallel/ts.meanMs"], 2.5);
+      assert.strictEqual(
+        metrics["criterion.parse_files_parallel/ts.peakHeapMb"],
+        3,
+      );
+    } finally {
+      rmSync(dir, { recursive: true, force: true });
+    }
+  });
+
+  it("fails native thresholds on slowdowns and memory ceilings", () => {
+    const thresholds: BenchmarkThresholds = {
+      version: "1.0",
+      description: "test",
+      thresholds: {
+        indexing: {},
+        quality: {},
+        performance: {},
+        tokenEfficiency: {},
+        coverage: {},
+        native: {
+          nativeFilesPerSec: {
+            trend: "higher-is-better",
+            allowableDecreasePercent: 15,
+          },
+          nativePeakRssMb: { trend: "lower-is-better", maxValue: 1024 },
+        },
+      },
+      smoothing: {
+        warmupRuns: 0,
+        sampleRuns: 1,
+        outlierMethod: "none",
+        iqrMultiplier: 1.5,
+      },
+      baseline: { filePath: "unused", autoUpdateOnPass: false },
+    };
+    const current = { nativeFilesPerSec: 800, nativePeakRssMb: 1500 };
+    const result = new ThresholdEvaluator(thresholds).evaluate(current, {
+      nativeFilesPerSec: 1000,
+      nativePeakRssMb: 900,
+    });
+    assert.strictEqual(result.passed, false);
+    assert.strictEqual(result.summary.failed, 2);
+
+    const report = new RegressionReportGenerator().generate({
+      timestamp: new Date().toISOString(),
+      repoId: "native",
+      currentMetrics: current,
+      thresholds: thresholds.thresholds,
+      evaluations: result.evaluations,
+    });
+    assert.deepStrictEqual(report.failingThresholds, [
+      "native.nativeFilesPerSec",
+      "native.nativePeakRssMb",
+    ]);
+    assert.ok(
+      report.recommendations.some((r) => r.startsWith("Native engine")),
+    );
+  });
+});
@@ -0,0 +1,85 @@
+import { afterEach, describe, it } from "node:test";
+import assert from "node:assert/strict";
+
+import {
+  LATENCY_BUCKET_COUNT,
+  LatencyHistogram,
+  buildPhaseTrace,
+  getPhaseLatencyMetrics,
+  isPhaseStatsEnabled,
+  latencyBucketIndex,
+  recordPhaseDuration,
+  resetPhaseLatency,
+} from "../../../dist/observability/latency-histogram.js";
+
+describe("latency histogram", () => {
+  afterEach(() => resetPhaseLatency());
+
+  it("uses the native addon's bucket layout", () => {
+    assert.equal(latencyBucketIndex(0), 0);
+    assert.equal(latencyBucketIndex(63), 63);
+    assert.equal(latencyBucketIndex(64), 64);
+    assert.equal(latencyBucketIndex(127), 95);
+    assert.equal(latencyBucketIndex(128), 96);
+    assert.equal(latencyBucketIndex(2 ** 60), LATENCY_BUCKET_COUNT - 1);
+    let last = 0;
+    for (let v = 0; v < 1_000_000; v += 97) {
+      const bucket = latencyBucketIndex(v);
+      assert.ok(bucket >= last);
+      last = bucket;
+    }
+  });
+
+  it("reports percentiles within bucket precision", () => {
+    const histogram = new LatencyHistogram();
+    for (let ms = 1; ms <= 100; ms++) histogram.recordMicros(ms * 1000);
+    const p50 = histogram.percentileMs(0.5);
+    const p99 = histogram.percentileMs(0.99);
+    assert.ok(Math.abs(p50 - 50) / 50 < 0.04, `p50=${p50}`);
+    assert.ok(Math.abs(p99 - 99) / 99 < 0.04, `p99=${p99}`);
+    assert.ok(Math.abs(histogram.percentileMs(1) - 100) / 100 < 0.04);
+    assert.equal(new LatencyHistogram().percentileMs(0.5), 0);
+  });
+
+  it("merges sparse bucket columns", () => {
+    const histogram = new LatencyHistogram();
+    histogram.recordMicros(10);
+    histogram.addBuckets([10, 64], [2, 1], 84, 64);
+    assert.equal(histogram.count, 4);
+    assert.equal(histogram.maxMicros, 64);
+    const summary = histogram.summarize("native");
+    assert.equal(summary.source, "native");
+    assert.equal(summary.p50Ms, 0.01);
+  });
+
+  it("summarizes recorded phases and dumps them as a Chrome trace", () => {
+    const since = Date.now() - 1000;
+    recordPhaseDuration("pass2.resolve", 4);
+    recordPhaseDuration("pass2.resolve", 8);
+    const metrics = getPhaseLatencyMetrics();
+    assert.equal(metrics.enabled, true);
+    assert.equal(metrics.phases["pass2.resolve"].count, 2);
+    assert.equal(metrics.phases["pass2.resolve"].source, "js");
+
+    const trace = buildPhaseTrace(since);
+    const spans = trace.traceEvents.filter(
+      (e) => e.ph === "X" && e.tid === 0,
+    );
+    assert.equal(spans.length, 2);
+    assert.equal(spans[0].name, "pass2.resolve");
+    assert.equal(spans[0].tid, 0);
+    assert.ok(spans[0].ts! >= since * 1000);
+    const later = buildPhaseTrace(Date.now() + 60_000).traceEvents;
+    assert.equal(later.filter((e) => e.tid === 0).length, 1);
+  });
+
+  it("records nothing when SDL_MCP_PHASE_STATS disables it", () => {
+    assert.equal(isPhaseStatsEnabled({}), true);
+    assert.equal(isPhaseStatsEnabled({ SDL_MCP_PHASE_STATS: "0" }), false);
+    resetPhaseLatency({ SDL_MCP_PHASE_STATS: "false" });
+    recordPhaseDuration("ppr", 3);
+    const metrics = getPhaseLatencyMetrics();
+    assert.equal(metrics.enabled, false);
+    assert.deepEqual(metrics.phases, {});
+  });
+});
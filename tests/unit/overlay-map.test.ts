@@ -0,0 +1,77 @@
+import { describe, it } from "node:test";
+import assert from "node:assert";
+import { deserialize, serialize } from "node:v8";
+import { OverlayMap } from "../../dist/graph/overlay-map.js";
+
+describe("OverlayMap", () => {
+  it("reads like a Map and leaves its base untouched", () => {
+    const base = new Map([
+      ["a", 1],
+      ["b", 2],
+      ["c", 3],
+    ]);
+    const map = OverlayMap.over(base);
+    map.set("b", 20).set("d", 4);
+    map.delete("a");
+    map.set("a", 10);
+    map.delete("c");
+
+    assert.ok(!(map instanceof Map));
+    assert.strictEqual(map.size, 3);
+    assert.strictEqual(map.get("b"), 20);
+    assert.strictEqual(map.has("c"), false);
+    assert.strictEqual(map.delete("c"), false);
+    assert.deepStrictEqual(
+      [...map],
+      [
+        ["b", 20],
+        ["d", 4],
+        ["a", 10],
+      ],
+    );
+    assert.deepStrictEqual([...map.keys()], ["b", "d", "a"]);
+    assert.deepStrictEqual([...map.values()], [20, 4, 10]);
+    assert.deepStrictEqual(new Map(map), new Map([...map.entries()]));
+    assert.deepStrictEqual(
+      [...base],
+      [
+        ["a", 1],
+        ["b", 2],
+        ["c", 3],
+      ],
+    );
+  });
+
+  it("survives structured clone once copied into a Map", () => {
+    const map = OverlayMap.over(new Map([["a", 1]]));
+    map.set("b", 2);
+    const expected = new Map([
+      ["a", 1],
+      ["b", 2],
+    ]);
+    assert.deepStrictEqual(structuredClone(new Map(map)), expected);
+    assert.deepStrictEqual(deserialize(serialize(new Map(map))), expected);
+  });
+
+  it("copies only the overlay and flattens large ones", () => {
+    const base = new Map(
+      Array.from({ length: 100 }, (_, i) => [i, i] as [number, number]),
+    );
+    const first = OverlayMap.over(base);
+    first.set(1, -1);
+    const second = OverlayMap.over(first);
+    second.delete(2);
+    assert.strictEqual(first.has(2), true);
+    assert.strictEqual(second.get(1), -1);
+    assert.strictEqual(second.size, 99);
+
+    let map = second;
+    for (let i = 0; i < 40; i++) {
+      map = OverlayMap.over(map);
+      map.set(1000 + i, i);
+    }
+    assert.strictEqual(map.size, 139);
+    assert.strictEqual(map.get(1039), 39);
+    assert.strictEqual(map.has(2), false);
+  });
+});
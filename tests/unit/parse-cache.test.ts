@@ -0,0 +1,166 @@
+import { describe, it } from "node:test";
+import assert from "node:assert";
+import { mkdtempSync, rmSync } from "node:fs";
+import { tmpdir } from "node:os";
+import { join } from "node:path";
+
+import {
+  ParseCache,
+  loadParseCache,
+  resolveParseCachePath,
+  shouldUseParseCache,
+} from "../../dist/indexer/parse-cache.js";
+
+const OLD_MTIME = Date.now() - 60_000;
+
+function file(overrides: Record<string, unknown> = {}) {
+  return {
+    path: "src/a.ts",
+    size: 42,
+    mtime: OLD_MTIME,
+    inode: 7,
+    contentHash: "hash-a",
+    ...overrides,
+  };
+}
+
+function result(overrides: Record<string, unknown> = {}) {
+  return {
+    relPath: "src/a.ts",
+    contentHash: "hash-a",
+    content: "export const a = 1;",
+    symbols: [
+      {
+        nodeId: "a:1:0",
+        symbolId: "sym-a",
+        astFingerprint: "fp",
+        kind: "variable",
+        name: "a",
+        exported: true,
+        range: { startLine: 1, startCol: 0, endLine: 1, endCol: 19 },
+        summary: "",
+        invariantsJson: "[]",
+        sideEffectsJson: "[]",
+        roleTagsJson: "[]",
+        searchText: "a",
+      },
+    ],
+    imports: [],
+    calls: [
+      {
+        callerNodeId: "a:1:0",
+        calleeIdentifier: "b",
+        isResolved: false,
+        callType: "function",
+        range: { startLine: 1, startCol: 0, endLine: 1, endCol: 3 },
+      },
+    ],
+    parseError: null,
+    ...overrides,
+  } as never;
+}
+
+describe("ParseCache", () => {
+  it("returns a recorded hash only for an identical stat", () => {
+    const cache = new ParseCache("/unused");
+    cache.recordContentHash(file(), "hash-a");
+
+    assert.strictEqual(cache.contentHashFor(file()), "hash-a");
+    assert.strictEqual(cache.contentHashFor(file({ size: 43 })), undefined);
+    assert.strictEqual(
+      cache.contentHashFor(file({ mtime: OLD_MTIME + 1 })),
+      undefined,
+    );
+    assert.strictEqual(cache.contentHashFor(file({ inode: 8 })), undefined);
+  });
+
+  it("skips files modified inside the racy window", () => {
+    const cache = new ParseCache("/unused");
+    const fresh = file({ mtime: Date.now() });
+    cache.recordContentHash(fresh, "hash-a");
+    assert.strictEqual(cache.contentHashFor(fresh), undefined);
+  });
+
+  it("stores extractions snapshotted at record time", () => {
+    const cache = new ParseCache("/unused");
+    cache.recordContentHash(file(), "hash-a");
+    const parsed = result();
+    cache.recordResult(file(), parsed);
+    // Pass 1 resolves calls in place after recording.
+    (parsed as { calls: Array<{ isResolved: boolean }> }).calls[0].isResolved =
+      true;
+
+    const first = cache.resultFor(file());
+    assert.ok(first);
+    assert.strictEqual(first.content, undefined);
+    assert.strictEqual(first.symbols[0].symbolId, "sym-a");
+    assert.strictEqual(first.calls[0].isResolved, false);
+    first.calls[0].isResolved = true;
+    assert.strictEqual(cache.resultFor(file())?.calls[0].isResolved, false);
+
+    assert.strictEqual(cache.resultFor(file({ contentHash: "other" })), null);
+    assert.strictEqual(cache.resultFor(file({ size: 1 })), null);
+  });
+
+  it("refuses extractions whose native hash differs from the scan", () => {
+    const cache = new ParseCache("/unused");
+    cache.recordContentHash(file(), "hash-a");
+    cache.recordResult(file(), result({ contentHash: "decoded-text-hash" }));
+    cache.recordResult(file({ path: "src/b.ts" }), result());
+    cache.recordResult(file(), result({ parseError: "boom" }));
+    assert.strictEqual(cache.resultFor(file()), null);
+  });
+
+  it("keeps the extraction when only the stat changed", () => {
+    const cache = new ParseCache("/unused");
+    cache.recordContentHash(file(), "hash-a");
+    cache.recordResult(file(), result());
+
+    const touched = file({ mtime: OLD_MTIME + 5_000 });
+    cache.recordContentHash(touched, "hash-a");
+    assert.ok(cache.resultFor(touched));
+
+    cache.recordContentHash(touched, "hash-b");
+    assert.strictEqual(
+      cache.resultFor({ ...touched, contentHash: "hash-b" }),
+      null,
+    );
+  });
+
+  it("round-trips through flush and load and prunes removed paths", async () => {
+    const dir = mkdtempSync(join(tmpdir(), "sdl-parse-cache-"));
+    try {
+      const path = resolveParseCachePath(join(dir, "graph.lbug"), "my/repo");
+      assert.ok(path.endsWith("graph.lbug.parse-cache/my%2Frepo.bin"));
+
+      const cache = new ParseCache(path);
+      cache.recordContentHash(file(), "hash-a");
+      cache.recordResult(file(), result());
+      cache.recordContentHash(file({ path: "src/gone.ts" }), "hash-gone");
+      cache.retain(new Set(["src/a.ts"]));
+      await cache.flush();
+
+      const loaded = await loadParseCache(path);
+      assert.strictEqual(loaded.size, 1);
+      assert.strictEqual(loaded.contentHashFor(file()), "hash-a");
+      assert.strictEqual(loaded.resultFor(file())?.symbols[0].name, "a");
+
+      const missing = await loadParseCache(join(dir, "missing.bin"));
+      assert.strictEqual(missing.size, 0);
+    } finally {
+      rmSync(dir, { recursive: true, force: true });
+    }
+  });
+
+  it("can be disabled with SDL_MCP_PARSE_CACHE", () => {
+    assert.strictEqual(shouldUseParseCache({}), true);
+    assert.strictEqual(
+      shouldUseParseCache({ SDL_MCP_PARSE_CACHE: "0" }),
+      false,
+    );
+    assert.strictEqual(
+      shouldUseParseCache({ SDL_MCP_PARSE_CACHE: "false" }),
+      false,
+    );
+  });
+});
@@ -0,0 +1,128 @@
+import { afterEach, describe, it } from "node:test";
+import assert from "node:assert/strict";
+
+import { buildCsrGraph } from "../../dist/graph/csr-snapshot.js";
+import {
+  forgetProcesses,
+  mergeIncrementalProcesses,
+  planIncrementalProcesses,
+  recallProcesses,
+  rememberProcesses,
+  shouldUseIncrementalProcesses,
+} from "../../dist/graph/process.js";
+
+function callGraph(ids: string[], edges: Array<[string, string]>) {
+  return buildCsrGraph(
+    ids,
+    (emit) => {
+      for (const [from, to] of edges) emit(from, to, "call");
+    },
+    { includeUnknownEndpoints: true },
+  );
+}
+
+function trace(entry: string, steps: string[]) {
+  return {
+    processId: `process:${entry}`,
+    entrySymbolId: entry,
+    steps: steps.map((symbolId, stepOrder) => ({ symbolId, stepOrder })),
+    depth: steps.length - 1,
+  };
+}
+
+const IDS = ["a", "b", "c", "d", "h1", "h2"];
+const EDGES: Array<[string, string]> = [
+  ["h1", "a"],
+  ["a", "b"],
+  ["h2", "c"],
+  ["c", "d"],
+];
+const TRACES = [trace("h1", ["h1", "a", "b"]), trace("h2", ["h2", "c", "d"])];
+
+describe("planIncrementalProcesses", () => {
+  afterEach(() => forgetProcesses());
+
+  it("reuses every trace of an unchanged graph", () => {
+    const previous = {
+      graph: callGraph(IDS, EDGES),
+      maxDepth: 20,
+      traces: TRACES,
+    };
+    const plan = planIncrementalProcesses(
+      previous,
+      callGraph(IDS, EDGES),
+      ["h1", "h2"],
+      20,
+    );
+    assert.deepEqual(plan.retrace, []);
+    assert.equal(plan.reused.get("h1"), TRACES[0]);
+    assert.equal(plan.reused.get("h2"), TRACES[1]);
+  });
+
+  it("retraces only processes whose steps changed", () => {
+    const previous = {
+      graph: callGraph(IDS, EDGES),
+      maxDepth: 20,
+      traces: TRACES,
+    };
+    // b gains a callee; the rows h2 visits are untouched.
+    const graph = callGraph([...IDS, "e"], [...EDGES, ["b", "e"]]);
+    const plan = planIncrementalProcesses(
+      previous,
+      graph,
+      ["h1", "h2", "h3"],
+      20,
+    );
+    assert.deepEqual(plan.retrace, ["h1", "h3"]);
+    assert.deepEqual([...plan.reused.keys()], ["h2"]);
+
+    const retraced = [trace("h1", ["h1", "a", "b", "e"])];
+    const merged = mergeIncrementalProcesses(
+      ["h1", "h2", "h3"],
+      plan,
+      retraced,
+    );
+    assert.deepEqual(
+      merged.map((t) => t.entrySymbolId),
+      ["h1", "h2"],
+    );
+    assert.equal(merged[0], retraced[0]);
+    assert.equal(merged[1], TRACES[1]);
+  });
+
+  it("retraces everything when the depth limit changes", () => {
+    const previous = {
+      graph: callGraph(IDS, EDGES),
+      maxDepth: 20,
+      traces: TRACES,
+    };
+    const plan = planIncrementalProcesses(
+      previous,
+      callGraph(IDS, EDGES),
+      ["h1", "h2"],
+      5,
+    );
+    assert.deepEqual(plan.retrace, ["h1", "h2"]);
+    assert.equal(plan.reused.size, 0);
+  });
+
+  it("keeps one snapshot per repo", () => {
+    const snapshot = {
+      graph: callGraph(IDS, EDGES),
+      maxDepth: 20,
+      traces: TRACES,
+    };
+    rememberProcesses("repo-a", snapshot);
+    assert.equal(recallProcesses("repo-a"), snapshot);
+    forgetProcesses("repo-a");
+    assert.equal(recallProcesses("repo-a"), undefined);
+  });
+
+  it("reads SDL_MCP_INCREMENTAL_PROCESSES", () => {
+    assert.equal(shouldUseIncrementalProcesses({}), true);
+    assert.equal(
+      shouldUseIncrementalProcesses({ SDL_MCP_INCREMENTAL_PROCESSES: "0" }),
+      false,
+    );
+  });
+});
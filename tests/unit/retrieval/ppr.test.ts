@@ -6,6 +6,8 @@ import {
   computePpr,
   _clearPprCache,
   _resetNativeBindingCache,
+  getPprSeedCacheStats,
+  shouldUsePprSeedCache,
   DEFAULT_ALPHA,
   DEFAULT_EPSILON,
   DEFAULT_MAX_NODES_TOUCHED,
@@ -276,6 +278,67 @@ describe("computePpr", () => {
     assert.ok(result.scores.has("a"), "a should be reachable upstream");
     assert.ok(result.scores.has("c"), "c should be reachable downstream");
   });
-});
 
+  it("serves overlapping seed sets from cached unit-seed vectors", async () => {
+    _clearPprCache();
+    const graph = buildMiniGraph(
+      ["a", "b", "c", "d"],
+      new Map([
+        ["a", [{ to: "b" }, { to: "c" }]],
+        ["b", [{ to: "d" }]],
+        ["c", [{ to: "d" }, { to: "a", weight: 0.5 }]],
+      ]),
+    );
+    const seeds = new Map([
+      ["a", 0.6],
+      ["c", 0.4],
+    ]);
+
+    await computePpr({
+      graph,
+      snapshotCreatedAt: 6,
+      repoId: "r",
+      options: { seeds: new Map([["a", 1.0]]), direction: "out" },
+    });
+    assert.deepEqual(getPprSeedCacheStats(), { hits: 0, misses: 1 });
+
+    const merged = await computePpr({
+      graph,
+      snapshotCreatedAt: 6,
+      repoId: "r",
+      options: { seeds, direction: "out" },
+    });
+    assert.deepEqual(getPprSeedCacheStats(), { hits: 1, misses: 2 });
+    assert.equal(merged.backend, "js");
+
+    process.env.SDL_MCP_PPR_SEED_CACHE = "0";
+    try {
+      const pushed = await computePpr({
+        graph,
+        snapshotCreatedAt: 7,
+        repoId: "r",
+        options: { seeds, direction: "out" },
+      });
+      assert.deepEqual(getPprSeedCacheStats(), { hits: 1, misses: 2 });
+      assert.deepEqual([...merged.scores.keys()].sort(), ["a", "b", "c", "d"]);
+      for (const [id, score] of pushed.scores) {
+        const actual = merged.scores.get(id) ?? 0;
+        assert.ok(
+          Math.abs(actual - score) < 1e-2,
+          `seed-vector merge at ${id}: expected=${score} actual=${actual}`,
+        );
+      }
+    } finally {
+      delete process.env.SDL_MCP_PPR_SEED_CACHE;
+    }
+  });
 
+  it("seed cache can be disabled with SDL_MCP_PPR_SEED_CACHE", () => {
+    assert.equal(shouldUsePprSeedCache({}), true);
+    assert.equal(shouldUsePprSeedCache({ SDL_MCP_PPR_SEED_CACHE: "0" }), false);
+    assert.equal(
+      shouldUsePprSeedCache({ SDL_MCP_PPR_SEED_CACHE: "false" }),
+      false,
+    );
+  });
+});
@@ -1,5 +1,8 @@
 import { describe, it, before, after } from "node:test";
 import assert from "node:assert";
+import { mkdirSync, mkdtempSync, rmSync, writeFileSync } from "node:fs";
+import { tmpdir } from "node:os";
+import { join } from "node:path";
 
 import {
   isRustEngineAvailable,
@@ -8,6 +11,13 @@ import {
   generateSymbolIdRust,
   computeClustersRust,
   traceProcessesRust,
+  configureRustParseEngine,
+  getRustParseEngineStatus,
+  parseDraftIncrementalRust,
+  parseFilesRustStream,
+  shouldUsePackedNativeSymbols,
+  configureRustFingerprintMode,
+  nativeFingerprintMode,
 } from "../../dist/indexer/rustIndexer.js";
 
 describe("rustIndexer — native addon disabled", () => {
@@ -72,6 +82,80 @@ describe("rustIndexer — native addon disabled", () => {
     );
     assert.strictEqual(result, null);
   });
+
+  it("parse engine controls return null when addon is disabled", () => {
+    assert.strictEqual(configureRustParseEngine(4), null);
+    assert.strictEqual(getRustParseEngineStatus(), null);
+    assert.strictEqual(configureRustFingerprintMode("ts-compat"), false);
+  });
+
+  it("parseDraftIncrementalRust returns null when addon is disabled", async () => {
+    const result = await parseDraftIncrementalRust({
+      repoId: "test-repo",
+      relPath: "src/index.ts",
+      content: "export const x = 1;\n",
+    });
+    assert.strictEqual(result, null);
+  });
+
+  it("parseFilesRustStream returns null when addon is disabled", () => {
+    const files = [{ path: "src/a.ts", size: 10, mtime: Date.now() }];
+    assert.strictEqual(
+      parseFilesRustStream("test-repo", "/tmp/repo", files),
+      null,
+    );
+  });
+});
+
+describe("rustIndexer — persistent parse engine", () => {
+  it("reuses the worker pool across batches and resizes on demand", () => {
+    if (!isRustEngineAvailable()) return;
+
+    const configured = configureRustParseEngine(2);
+    // The addon may be present but built without the parse engine exports.
+    if (!configured) return;
+    assert.strictEqual(configured.threadCount, 2);
+
+    const buildsBefore = configured.poolBuilds;
+    parseFilesRust("test-repo", "/tmp/repo", [], 2);
+    parseFilesRust("test-repo", "/tmp/repo", [], 2);
+    assert.strictEqual(getRustParseEngineStatus()?.poolBuilds, buildsBefore);
+
+    const resized = configureRustParseEngine(3);
+    assert.strictEqual(resized?.threadCount, 3);
+    assert.strictEqual(resized?.poolBuilds, buildsBefore + 1);
+  });
+
+  it("keeps one pool across real batches with different thread counts", () => {
+    if (!isRustEngineAvailable()) return;
+    const before = getRustParseEngineStatus();
+    if (!before) return;
+
+    const root = mkdtempSync(join(tmpdir(), "sdl-parse-engine-"));
+    try {
+      const files = Array.from({ length: 6 }, (_, i) => {
+        const path = `src/mod${i}.ts`;
+        const content = `export function fn${i}(a: number): number {\n  return a + ${i};\n}\n`;
+        mkdirSync(join(root, "src"), { recursive: true });
+        writeFileSync(join(root, path), content);
+        return { path, size: content.length, mtime: Date.now() };
+      });
+
+      parseFilesRust("test-repo", root, files, 2);
+      const warm = getRustParseEngineStatus()!;
+      for (const threads of [1, 0, 3, 2]) {
+        const results = parseFilesRust("test-repo", root, files, threads);
+        assert.strictEqual(results?.length, files.length);
+        assert.ok(results!.every((r) => r && r.symbols.length > 0));
+      }
+      const after = getRustParseEngineStatus()!;
+      assert.strictEqual(after.poolBuilds, warm.poolBuilds);
+      assert.strictEqual(after.threadCount, warm.threadCount);
+      assert.ok(after.filesParsed >= warm.filesParsed + files.length * 4);
+    } finally {
+      rmSync(root, { recursive: true, force: true });
+    }
+  });
 });
 
 describe("rustIndexer — parseFilesRust with unsupported languages", () => {
@@ -98,6 +182,31 @@ describe("rustIndexer — parseFilesRust with unsupported languages", () => {
   });
 });
 
+describe("rustIndexer — parseFilesRustStream", () => {
+  it("delivers every file exactly once across streamed chunks", async () => {
+    if (!isRustEngineAvailable()) return;
+
+    const files = [
+      { path: "src/main.kt", size: 50, mtime: Date.now() },
+      { path: "src/missing-a.ts", size: 50, mtime: Date.now() },
+      { path: "src/missing-b.ts", size: 50, mtime: Date.now() },
+    ];
+    const stream = parseFilesRustStream("test-repo", "/tmp/repo", files, 2, 1);
+    // The addon may be present but built without the streaming export.
+    if (!stream) return;
+
+    const seen: string[] = [];
+    for await (const chunk of stream) {
+      assert.ok(chunk.length > 0, "chunks should never be empty");
+      for (const result of chunk) seen.push(result.relPath);
+    }
+    assert.deepStrictEqual(
+      seen.sort(),
+      files.map((file) => file.path).sort(),
+    );
+  });
+});
+
 describe("rustIndexer — parseFilesRust with empty input", () => {
   it("returns empty array for empty file list when addon is available", () => {
     if (!isRustEngineAvailable()) return;
@@ -129,3 +238,37 @@ describe("rustIndexer — env var parsing", () => {
     assert.strictEqual(available, false);
   });
 });
+
+describe("rustIndexer — packed symbol output switch", () => {
+  it("uses packed symbols only when SDL_MCP_NATIVE_PACKED_SYMBOLS opts in", () => {
+    assert.strictEqual(shouldUsePackedNativeSymbols({}), false);
+    for (const value of ["1", "true", " YES "]) {
+      assert.strictEqual(
+        shouldUsePackedNativeSymbols({ SDL_MCP_NATIVE_PACKED_SYMBOLS: value }),
+        true,
+      );
+    }
+    for (const value of ["0", "false", "no"]) {
+      assert.strictEqual(
+        shouldUsePackedNativeSymbols({ SDL_MCP_NATIVE_PACKED_SYMBOLS: value }),
+        false,
+      );
+    }
+  });
+});
+
+describe("rustIndexer — fingerprint mode switch", () => {
+  it("selects ts-compat only when SDL_MCP_NATIVE_FINGERPRINT_MODE asks for it", () => {
+    assert.strictEqual(nativeFingerprintMode({}), "native");
+    for (const value of ["ts", "TS-COMPAT", " ts "]) {
+      assert.strictEqual(
+        nativeFingerprintMode({ SDL_MCP_NATIVE_FINGERPRINT_MODE: value }),
+        "ts-compat",
+      );
+    }
+    assert.strictEqual(
+      nativeFingerprintMode({ SDL_MCP_NATIVE_FINGERPRINT_MODE: "native" }),
+      "native",
+    );
+  });
+});
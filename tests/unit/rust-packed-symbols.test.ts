@@ -0,0 +1,154 @@
+import { describe, it } from "node:test";
+import assert from "node:assert";
+
+import { PackedSymbolReader } from "../../dist/indexer/rust-packed-symbols.js";
+
+interface Row {
+  kind: string;
+  visibility: string;
+  exported: boolean;
+  range: [number, number, number, number];
+  strings: string[];
+}
+
+/** Mirror of native/src/parse/packed.rs::pack_files for test fixtures. */
+function pack(rows: Row[]): Buffer {
+  const dict: string[] = [];
+  const code = (value: string): number => {
+    const existing = dict.indexOf(value);
+    if (existing >= 0) return existing;
+    dict.push(value);
+    return dict.length - 1;
+  };
+  const kinds = rows.map((row) => code(row.kind));
+  const visibility = rows.map((row) => code(row.visibility));
+
+  const stringChunks: Buffer[] = [];
+  let stringBytes = 0;
+  const push = (value: string): [number, number] => {
+    if (value.length === 0) return [0, 0];
+    const bytes = Buffer.from(value, "utf8");
+    const offset = stringBytes;
+    stringChunks.push(bytes);
+    stringBytes += bytes.length;
+    return [offset, bytes.length];
+  };
+  const dictRefs = dict.map(push);
+  const refs = rows.flatMap((row) => row.strings.map(push));
+
+  const n = rows.length;
+  const exportedEnd = 24 + dict.length * 8 + n * 5;
+  const rangeOffset = (exportedEnd + 3) & ~3;
+  const head = Buffer.alloc(rangeOffset + n * 16 + refs.length * 8);
+  const header = [0x534c4453, 1, n, dict.length, 11, stringBytes];
+  header.forEach((value, i) => head.writeUInt32LE(value, i * 4));
+  let at = 24;
+  for (const [offset, len] of dictRefs) {
+    head.writeUInt32LE(offset, at);
+    head.writeUInt32LE(len, at + 4);
+    at += 8;
+  }
+  for (const value of [...kinds, ...visibility]) {
+    head.writeUInt16LE(value, at);
+    at += 2;
+  }
+  for (const row of rows) head.writeUInt8(row.exported ? 1 : 0, at++);
+  at = rangeOffset;
+  for (const row of rows) {
+    for (const value of row.range) {
+      head.writeUInt32LE(value, at);
+      at += 4;
+    }
+  }
+  for (const [offset, len] of refs) {
+    head.writeUInt32LE(offset, at);
+    head.writeUInt32LE(len, at + 4);
+    at += 8;
+  }
+  return Buffer.concat([head, ...stringChunks]);
+}
+
+function row(name: string, overrides: Partial<Row> = {}): Row {
+  return {
+    kind: "function",
+    visibility: "",
+    exported: true,
+    range: [1, 0, 3, 1],
+    strings: [
+      `${name}:1:0`,
+      `id-${name}`,
+      "fp",
+      name,
+      `Computes ${name} — ünïcode`,
+      `${name} search`,
+      "",
+      "",
+      '["io"]',
+      "",
+      "",
+    ],
+    ...overrides,
+  };
+}
+
+describe("PackedSymbolReader", () => {
+  it("decodes rows into the same shape as mapNativeSymbol", () => {
+    const signed = row("add");
+    signed.strings[6] = '{"params":[{"name":"a","type":"number"}],"returns":"number"}';
+    const buffer = pack([
+      signed,
+      row("Calc", { kind: "class", visibility: "private", exported: false }),
+    ]);
+
+    const reader = new PackedSymbolReader(buffer);
+    assert.strictEqual(reader.symbolCount, 2);
+
+    const [add, calc] = reader.decode(0, 2);
+    assert.strictEqual(add.nodeId, "add:1:0");
+    assert.strictEqual(add.symbolId, "id-add");
+    assert.strictEqual(add.kind, "function");
+    assert.strictEqual(add.visibility, undefined);
+    assert.strictEqual(add.summary, "Computes add — ünïcode");
+    assert.deepStrictEqual(add.range, {
+      startLine: 1,
+      startCol: 0,
+      endLine: 3,
+      endCol: 1,
+    });
+    assert.deepStrictEqual(add.signature, {
+      params: [{ name: "a", type: "number" }],
+      returns: "number",
+    });
+    assert.strictEqual(add.invariantsJson, "[]");
+    assert.strictEqual(add.sideEffectsJson, '["io"]');
+    assert.strictEqual(add.decorators, undefined);
+
+    assert.strictEqual(calc.kind, "class");
+    assert.strictEqual(calc.visibility, "private");
+    assert.strictEqual(calc.exported, false);
+    assert.strictEqual(calc.signature, undefined);
+  });
+
+  it("decodes an arbitrary row window", () => {
+    const reader = new PackedSymbolReader(
+      pack([row("a"), row("b"), row("c")]),
+    );
+    assert.deepStrictEqual(
+      reader.decode(1, 2).map((symbol) => symbol.name),
+      ["b", "c"],
+    );
+    assert.deepStrictEqual(reader.decode(3, 0), []);
+    assert.throws(() => reader.decode(2, 2), RangeError);
+  });
+
+  it("rejects buffers with a foreign magic or mismatched length", () => {
+    const buffer = pack([row("a")]);
+    const wrongMagic = Buffer.from(buffer);
+    wrongMagic.writeUInt32LE(0, 0);
+    assert.throws(() => new PackedSymbolReader(wrongMagic), /Unsupported/);
+    assert.throws(
+      () => new PackedSymbolReader(buffer.subarray(0, buffer.length - 1)),
+      /does not match/,
+    );
+  });
+});
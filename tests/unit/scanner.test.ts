@@ -55,4 +55,30 @@ describe("isScannedFileChanged", () => {
       true,
     );
   });
+
+  it("treats a matching fast digest as unchanged", () => {
+    assert.equal(
+      isScannedFileChanged(
+        {
+          path: "src/example.ts",
+          size: 12,
+          mtime: new Date("2026-06-23T13:00:00.000Z").getTime(),
+          contentHash: "a".repeat(64),
+          contentFastHash: "f".repeat(32),
+        },
+        {
+          fileId: "file-1",
+          repoId: "repo",
+          relPath: "src/example.ts",
+          contentHash: "a".repeat(64),
+          contentFastHash: "f".repeat(32),
+          language: "typescript",
+          byteSize: 12,
+          lastIndexedAt: "2026-06-23T12:00:00.000Z",
+          directory: "src",
+        },
+      ),
+      false,
+    );
+  });
 });
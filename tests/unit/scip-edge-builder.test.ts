@@ -226,6 +226,31 @@ describe("buildContainingSymbolMap", () => {
     assert.equal(map.get(1), "sym-b");
     assert.equal(map.has(2), false);
   });
+
+  it("agrees with findContainingSymbol on nested and tied ranges", () => {
+    const sdlSymbols = [
+      makeSdlSymbol("file-scope", 1, 200),
+      makeSdlSymbol("class", 10, 80),
+      makeSdlSymbol("method-a", 20, 30),
+      makeSdlSymbol("method-a-twin", 20, 30),
+      makeSdlSymbol("method-b", 25, 40),
+      makeSdlSymbol("inverted", 60, 50),
+    ];
+    const occurrences = [0, 9, 19, 24, 29, 35, 55, 150, 250].map((line) =>
+      makeOccurrence("ref", line),
+    );
+
+    const map = buildContainingSymbolMap(occurrences, sdlSymbols);
+    occurrences.forEach((occ, i) => {
+      assert.equal(
+        map.get(i) ?? null,
+        findContainingSymbol(occ.range, sdlSymbols),
+        `occurrence on line ${occ.range.startLine}`,
+      );
+    });
+    assert.equal(map.get(3), "method-a");
+    assert.equal(map.has(8), false);
+  });
 });
 
 // ---------------------------------------------------------------------------
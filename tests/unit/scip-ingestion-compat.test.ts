@@ -6,6 +6,7 @@ import {
   autoIngestScipIndexes,
   runScipIngestInsideIndex,
   scipIngestWillRun,
+  shouldPipelineScipIngest,
 } from "../../dist/scip/ingestion.js";
 
 describe("SCIP ingestion compatibility hooks", () => {
@@ -45,4 +46,15 @@ describe("SCIP ingestion compatibility hooks", () => {
     assert.deepEqual(insideResult.generatedIndexes, []);
     assert.deepEqual(insideResult.failures, []);
   });
+
+  it("pipelines document stages unless SDL_MCP_SCIP_PIPELINE opts out", () => {
+    assert.equal(shouldPipelineScipIngest({}), true);
+    assert.equal(shouldPipelineScipIngest({ SDL_MCP_SCIP_PIPELINE: "1" }), true);
+    for (const value of ["0", "false", " NO "]) {
+      assert.equal(
+        shouldPipelineScipIngest({ SDL_MCP_SCIP_PIPELINE: value }),
+        false,
+      );
+    }
+  });
 });
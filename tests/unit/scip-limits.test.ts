@@ -4,6 +4,7 @@ import { readFileSync } from "node:fs";
 
 import { SCIP_MAX_INDEX_BYTES } from "../../dist/scip/limits.js";
 import { TypeScriptScipDecoder } from "../../dist/scip/decoder-ts.js";
+import { getDecoderMaxIndexBytes } from "../../dist/scip/decoder-factory.js";
 
 describe("SCIP decoder limits", () => {
   it("uses a 512 MiB cap in the TypeScript decoder export", () => {
@@ -11,9 +12,15 @@ describe("SCIP decoder limits", () => {
     assert.equal(TypeScriptScipDecoder.MAX_INDEX_SIZE, SCIP_MAX_INDEX_BYTES);
   });
 
-  it("uses a 512 MiB cap in the native decoder source", () => {
+  it("streams the native decoder without a whole-file cap", () => {
     const source = readFileSync("native/src/scip/decoder.rs", "utf-8");
-    assert.match(source, /MAX_SCIP_INDEX_BYTES:\s*u64\s*=\s*512\s*\*\s*1024\s*\*\s*1024/);
+    assert.doesNotMatch(source, /MAX_SCIP_INDEX_BYTES/);
+    assert.doesNotMatch(source, /std::fs::read\(/);
+    assert.match(source, /IndexFieldReader/);
+  });
+
+  it("only applies the cap when the TypeScript decoder is selected", async () => {
+    assert.equal(await getDecoderMaxIndexBytes(), SCIP_MAX_INDEX_BYTES);
   });
 });
 
@@ -25,6 +25,8 @@ import {
   enumerateRepoFiles,
   enumerateExplicitIncludeFiles,
   shouldReportSkippedFile,
+  applySourceEdits,
+  toDraftTextEdits,
 } from "../../dist/mcp/tools/search-edit/planner.js";
 
 describe("search-edit planner — isPathAllowed (deny-list + globs)", () => {
@@ -272,3 +274,28 @@ describe("search-edit planner — enumerateRepoFiles", () => {
     assert.ok(candidates.length <= 3, `expected <= 3 candidates, got ${candidates.length}`);
   });
 });
+
+describe("search-edit planner — toDraftTextEdits", () => {
+  it("maps character ranges to sequential UTF-8 byte edits", () => {
+    const content = "é = one;\nconst ü = two;\n";
+    const edits = [
+      { operationId: "a", start: 4, end: 7, replacement: "1" },
+      { operationId: "b", start: 19, end: 22, replacement: "zwei" },
+    ];
+    const next = applySourceEdits(content, edits);
+    const textEdits = toDraftTextEdits(content, edits);
+    assert.deepEqual(textEdits, [
+      { startByte: 5, oldEndByte: 8, text: "1" },
+      { startByte: 19, oldEndByte: 22, text: "zwei" },
+    ]);
+    let working = Buffer.from(content, "utf8");
+    for (const edit of textEdits) {
+      working = Buffer.concat([
+        working.subarray(0, edit.startByte),
+        Buffer.from(edit.text, "utf8"),
+        working.subarray(edit.oldEndByte),
+      ]);
+    }
+    assert.equal(working.toString("utf8"), next);
+  });
+});
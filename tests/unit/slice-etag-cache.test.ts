@@ -0,0 +1,128 @@
+import { afterEach, beforeEach, describe, it } from "node:test";
+import assert from "node:assert";
+import { existsSync, mkdirSync, rmSync } from "node:fs";
+import { tmpdir } from "node:os";
+import { dirname, join } from "node:path";
+
+import { buildSlice } from "../../dist/graph/slice.js";
+import { clearSliceCache } from "../../dist/graph/sliceCache.js";
+import { estimateTokens } from "../../dist/graph/slice/slice-serializer.js";
+import { createSchema } from "../../dist/db/ladybug-schema.js";
+import * as ladybugDb from "../../dist/db/ladybug-queries.js";
+
+const TEST_DB_PATH = join(tmpdir(), ".lbug-slice-etag-cache-test-db.lbug");
+const NOW = "2026-03-05T12:00:00.000Z";
+const MAX_TOKENS = 200;
+
+interface Closeable {
+  close: () => Promise<void>;
+}
+
+describe("slice cache with known card ETags", () => {
+  let conn: import("kuzu").Connection;
+  let db: Closeable;
+
+  beforeEach(async () => {
+    if (existsSync(TEST_DB_PATH)) {
+      rmSync(TEST_DB_PATH, { recursive: true, force: true });
+    }
+    mkdirSync(dirname(TEST_DB_PATH), { recursive: true });
+    const kuzu = await import("kuzu");
+    const database = new kuzu.Database(TEST_DB_PATH);
+    conn = new kuzu.Connection(database);
+    db = database as unknown as Closeable;
+    await createSchema(conn);
+    clearSliceCache();
+  });
+
+  afterEach(async () => {
+    clearSliceCache();
+    try {
+      await (conn as unknown as Closeable).close();
+    } catch {}
+    try {
+      await db.close();
+    } catch {}
+    rmSync(TEST_DB_PATH, { recursive: true, force: true });
+  });
+
+  it("caches a slice admitted at full cost regardless of the builder's ETags", async () => {
+    await ladybugDb.upsertRepo(conn, {
+      repoId: "repo",
+      rootPath: "/repo",
+      configJson: JSON.stringify({ policy: {} }),
+      createdAt: NOW,
+    });
+    await ladybugDb.upsertFile(conn, {
+      fileId: "file-1",
+      repoId: "repo",
+      relPath: "src/app.ts",
+      contentHash: "hash-1",
+      language: "ts",
+      byteSize: 100,
+      lastIndexedAt: NOW,
+    });
+    const ids = Array.from({ length: 12 }, (_, i) => `sym-${i}`);
+    for (const symbolId of ids) {
+      await ladybugDb.upsertSymbol(conn, {
+        symbolId,
+        repoId: "repo",
+        fileId: "file-1",
+        kind: "function",
+        name: `handler${symbolId.replace("sym-", "")}`,
+        exported: true,
+        visibility: "public",
+        language: "ts",
+        rangeStartLine: 1,
+        rangeStartCol: 0,
+        rangeEndLine: 2,
+        rangeEndCol: 1,
+        astFingerprint: `${symbolId}-fp`,
+        signatureJson: null,
+        summary: "Handles one kind of incoming request for the app.",
+        invariantsJson: null,
+        sideEffectsJson: null,
+        updatedAt: NOW,
+      });
+    }
+    await ladybugDb.insertEdges(
+      conn,
+      ids.slice(1).map((toSymbolId) => ({
+        repoId: "repo",
+        fromSymbolId: "sym-0",
+        toSymbolId,
+        edgeType: "call",
+        weight: 1,
+        confidence: 1,
+        resolution: "exact",
+        resolverId: "pass2-ts",
+        resolutionPhase: "pass2",
+        provenance: "ts-compiler",
+        createdAt: NOW,
+      })),
+    );
+
+    const request = {
+      repoId: "repo",
+      versionId: "v1",
+      conn,
+      entrySymbols: ["sym-0"],
+      budget: { maxCards: 20, maxEstimatedTokens: MAX_TOKENS },
+      cardDetail: "deps" as const,
+      minConfidence: 0,
+    };
+    const knownCardEtags = Object.fromEntries(
+      ids.map((symbolId) => [symbolId, `etag-${symbolId}`]),
+    );
+
+    await buildSlice({ ...request, knownCardEtags });
+    const { slice } = await buildSlice(request);
+
+    assert.strictEqual(slice.cardRefs, undefined);
+    assert.ok(slice.cards.length < ids.length, "budget dropped cards");
+    assert.ok(
+      slice.cards.length === 1 || estimateTokens(slice.cards) <= MAX_TOKENS,
+      `cached slice spends ${estimateTokens(slice.cards)} tokens`,
+    );
+  });
+});
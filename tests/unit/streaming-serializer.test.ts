@@ -0,0 +1,229 @@
+import { describe, it } from "node:test";
+import assert from "node:assert/strict";
+
+import {
+  safeJsonReplacer,
+  serializeJson,
+} from "../../dist/util/streaming-json.js";
+import { CardFragmentCache } from "../../dist/code-mode/etag-cache.js";
+import { WorkflowBudgetTracker } from "../../dist/code-mode/workflow-budget.js";
+import { admitCardsWithinTokenBudget } from "../../dist/graph/slice/truncation-handler.js";
+import {
+  buildPayloadCardsAndRefs,
+  estimateTokens,
+  streamPayloadCards,
+} from "../../dist/graph/slice/slice-serializer.js";
+import type { SymbolCard } from "../../dist/domain/types.js";
+
+function makeCard(symbolId: string, summary = "Does things."): SymbolCard {
+  return {
+    symbolId,
+    repoId: "repo-1",
+    file: `src/${symbolId}.ts`,
+    range: { startLine: 1, startCol: 0, endLine: 10, endCol: 0 },
+    kind: "function" as any,
+    name: `fn_${symbolId}`,
+    exported: true,
+    summary,
+    deps: { imports: [], calls: [] },
+    version: { ledgerVersion: "v1", astFingerprint: "abcdef1234567890" },
+  };
+}
+
+describe("serializeJson", () => {
+  const samples: unknown[] = [
+    {
+      a: 1,
+      omitted: undefined,
+      fn: () => 1,
+      list: [undefined, () => 2, null, "x"],
+      nested: { deeper: { deepest: { leaf: [1, { z: undefined }] } } },
+      date: new Date(0),
+      withToJson: { toJSON: () => ({ replaced: true }) },
+    },
+    [1, "two", { card: { symbolId: "s" }, etag: "e" }],
+    "plain string",
+    42,
+    null,
+    [],
+    {},
+  ];
+
+  it("matches JSON.stringify byte for byte in both modes", () => {
+    for (const value of samples) {
+      assert.equal(serializeJson(value).json, JSON.stringify(value));
+      assert.equal(
+        serializeJson(value, { mode: "safe" }).json,
+        JSON.stringify(value, safeJsonReplacer) ?? "null",
+      );
+    }
+    assert.equal(serializeJson(undefined).json, undefined);
+    assert.equal(serializeJson(undefined, { mode: "safe" }).json, "null");
+  });
+
+  it("records member sizes for walked containers", () => {
+    const { json, size } = serializeJson(
+      { items: [1, "xx"], label: "yyy" },
+      { mode: "safe" },
+    );
+    assert.equal(size?.length, json?.length);
+    assert.equal(size?.entries?.get("items")?.length, '[1,"xx"]'.length);
+    assert.deepEqual(
+      size?.entries?.get("items")?.items?.map((item) => item.length),
+      [1, 4],
+    );
+    assert.equal(size?.entries?.get("label")?.length, '"yyy"'.length);
+  });
+
+  it("falls back to the quoted string for cycles in safe mode only", () => {
+    const cyclic: Record<string, unknown> = {};
+    cyclic.self = { back: cyclic };
+    assert.equal(
+      serializeJson(cyclic, { mode: "safe" }).json,
+      JSON.stringify(String(cyclic)),
+    );
+    assert.throws(() => serializeJson(cyclic));
+  });
+
+  it("splices cached card fragments for etagged cards", () => {
+    const fragments = new CardFragmentCache();
+    const result = {
+      slice: {
+        cards: [{ symbolId: "a", name: "alpha" }],
+        cardRefs: [{ symbolId: "a", etag: "etag-a" }],
+      },
+    };
+    assert.equal(
+      serializeJson(result, { fragments }).json,
+      JSON.stringify(result),
+    );
+    assert.equal(fragments.size, 1);
+
+    // A later response carrying the same etag reuses the stored fragment.
+    const stale = '{"symbolId":"a","name":"cached"}';
+    fragments.set("etag-a", { symbolId: "a", name: "alpha" }, stale);
+    const reused = serializeJson(result, { fragments }).json!;
+    assert.ok(reused.includes(stale));
+
+    // A different field projection under the same etag is not reused.
+    const projected = {
+      card: { symbolId: "a" },
+      etag: "etag-a",
+    };
+    assert.equal(
+      serializeJson(projected, { fragments }).json,
+      JSON.stringify(projected),
+    );
+  });
+});
+
+describe("CardFragmentCache", () => {
+  it("evicts least recently used fragments past its caps", () => {
+    const cache = new CardFragmentCache(2, 1_000);
+    const card = { symbolId: "s" };
+    cache.set("e1", card, "{}");
+    cache.set("e2", card, "{}");
+    assert.equal(cache.get("e1", card), "{}");
+    cache.set("e3", card, "{}");
+    assert.equal(cache.get("e2", card), undefined);
+    assert.equal(cache.get("e1", card), "{}");
+
+    const small = new CardFragmentCache(10, 10);
+    small.set("a", card, "x".repeat(6));
+    small.set("b", card, "y".repeat(6));
+    assert.equal(small.size, 1);
+    assert.equal(small.get("b", card), "y".repeat(6));
+  });
+});
+
+describe("WorkflowBudgetTracker.estimateResultTokens", () => {
+  it("estimates the same tokens with cached card fragments", () => {
+    const result = {
+      cards: [
+        { card: { symbolId: "x", name: "one" }, etag: "etag-x" },
+        { card: { symbolId: "y", name: "two" }, etag: "etag-y" },
+      ],
+    };
+    const first = WorkflowBudgetTracker.estimateResultTokens(result);
+    assert.equal(WorkflowBudgetTracker.estimateResultTokens(result), first);
+    assert.ok(first > 0);
+  });
+});
+
+describe("admitCardsWithinTokenBudget", () => {
+  const cards = ["c", "a", "b"].map((id) => makeCard(id));
+  const perCard = estimateTokens([cards[0]]);
+
+  it("admits everything that fits", () => {
+    const admission = admitCardsWithinTokenBudget(cards, ["a", "b", "c"], 10_000);
+    assert.equal(admission.admitted, cards);
+    assert.deepEqual(admission.dropped, []);
+  });
+
+  it("drops cards past the budget in priority order and keeps hydration order", () => {
+    const admission = admitCardsWithinTokenBudget(
+      cards,
+      ["a", "b", "c"],
+      perCard * 2,
+    );
+    assert.deepEqual(
+      admission.admitted.map((card) => card.symbolId),
+      ["a", "b"],
+    );
+    assert.deepEqual(admission.dropped, ["c"]);
+  });
+
+  it("always admits the first card and does not charge known cards", () => {
+    const tight = admitCardsWithinTokenBudget(cards, ["b", "a", "c"], 1);
+    assert.deepEqual(
+      tight.admitted.map((card) => card.symbolId),
+      ["b"],
+    );
+
+    const known = admitCardsWithinTokenBudget(cards, ["a", "b", "c"], perCard, {
+      a: "etag-a",
+      b: "etag-b",
+    });
+    assert.deepEqual(known.dropped, []);
+  });
+});
+
+describe("streamPayloadCards", () => {
+  it("matches buildPayloadCardsAndRefs and sums tokens while writing", () => {
+    const cards = ["a", "b"].map((id) => makeCard(id));
+    const streamed = streamPayloadCards(cards);
+    assert.deepEqual(
+      streamed.cardsForPayload,
+      buildPayloadCardsAndRefs(cards).cardsForPayload,
+    );
+    assert.equal(
+      streamed.estimatedTokens,
+      estimateTokens(streamed.cardsForPayload),
+    );
+    assert.equal(streamed.cardRefs, undefined);
+    assert.equal(streamed.fullCards, undefined);
+  });
+
+  it("returns the ETag-free card list from the same pass", () => {
+    const cards = ["a", "b"].map((id) => makeCard(id));
+    const first = streamPayloadCards(cards, { knownCardEtags: { z: "none" } });
+    const etagA = first.cardRefs!.find((ref) => ref.symbolId === "a")!.etag;
+
+    const streamed = streamPayloadCards(cards, {
+      knownCardEtags: { a: etagA },
+      retainFullCards: true,
+    });
+    assert.deepEqual(
+      streamed.cardsForPayload.map((card) => card.symbolId),
+      ["b"],
+    );
+    assert.deepEqual(
+      streamed.fullCards?.map((card) => card.symbolId),
+      ["a", "b"],
+    );
+    assert.equal(
+      streamed.estimatedTokens,
+      estimateTokens(streamed.cardsForPayload),
+    );
+  });
+});
@@ -0,0 +1,32 @@
+import { describe, it } from "node:test";
+import assert from "node:assert/strict";
+
+import { SymbolIdFilter } from "../../dist/graph/symbol-filter.js";
+
+describe("SymbolIdFilter", () => {
+  const ids = Array.from({ length: 5_000 }, (_, i) => `repo:sym:${i}`);
+  const filter = SymbolIdFilter.from(ids);
+
+  it("has no false negatives", () => {
+    for (const id of ids) assert.equal(filter.mightContain(id), true);
+  });
+
+  it("keeps false positives near one percent", () => {
+    let positives = 0;
+    for (let i = 0; i < 5_000; i++) {
+      if (filter.mightContain(`other:sym:${i}`)) positives++;
+    }
+    assert.ok(positives < 150, `false positives: ${positives}`);
+  });
+
+  it("sizes itself at a few bytes per symbol", () => {
+    assert.ok(filter.byteLength <= ids.length * 4);
+    assert.equal(SymbolIdFilter.from([]).byteLength, 8);
+  });
+
+  it("reports intersections", () => {
+    assert.equal(filter.intersects(["nope", "repo:sym:42"]), true);
+    assert.equal(SymbolIdFilter.from(["a"]).intersects([]), false);
+    assert.equal(SymbolIdFilter.from([]).intersects(["a"]), false);
+  });
+});
@@ -7,6 +7,7 @@ import {
   buildSymbolMapCacheFromRows,
   clearSymbolMapCache,
   getCachedSymbolMap,
+  releaseSymbolMapCache,
   removeFilesFromSymbolMapCache,
   syncSymbolIndexFromCache,
 } from "../../dist/indexer/symbol-map-cache.js";
@@ -78,6 +79,60 @@ describe("symbol map cache", () => {
     assert.equal(refreshedSymbolIndex.has("src/b.ts"), false);
   });
 
+  it("serves the packed name lookups in insertion and ID order", () => {
+    const cache = buildSymbolMapCacheFromRows({
+      repoId: "repo-5",
+      files: [
+        createFileRow("repo-5", "src/a.ts"),
+        createFileRow("repo-5", "src/b.ts"),
+      ],
+      symbols: [
+        createLiteSymbol("repo-5", "src/b.ts", "run-b", "run", "function", true),
+        createLiteSymbol("repo-5", "src/a.ts", "run-a", "run", "function", false),
+        createLiteSymbol("repo-5", "src/a.ts", "stop-a", "stop", "function", true),
+      ],
+    });
+
+    assert.deepEqual(
+      cache.allSymbolsByName.get("run")?.map((symbol) => symbol.symbolId),
+      ["run-b", "run-a"],
+    );
+    assert.deepEqual(cache.globalNameToSymbolIds.get("run"), ["run-a", "run-b"]);
+    assert.equal(cache.globalPreferredSymbolId.get("run"), "run-b");
+    assert.equal(cache.globalPreferredSymbolId.has("stop"), false);
+    assert.deepEqual(cache.allSymbolsByName.get("stop")?.[0], {
+      symbolId: "stop-a",
+      repoId: "repo-5",
+      fileId: "repo-5:src/a.ts",
+      name: "stop",
+      kind: "function",
+      exported: true,
+    });
+
+    // Lookups return fresh arrays.
+    cache.globalNameToSymbolIds.get("run")?.pop();
+    assert.equal(cache.globalNameToSymbolIds.get("run")?.length, 2);
+
+    applySymbolMapFileUpdates(cache, [
+      {
+        fileId: "repo-5:src/b.ts",
+        relPath: "src/b.ts",
+        symbols: [
+          createLiteSymbol("repo-5", "src/b.ts", "run-b2", "run", "function", false),
+        ],
+      },
+    ]);
+    assert.deepEqual(cache.globalNameToSymbolIds.get("run"), ["run-a", "run-b2"]);
+    assert.equal(cache.globalPreferredSymbolId.has("run"), false);
+    assert.equal(cache.symbolsByFileId.get("repo-5:src/b.ts")?.length, 1);
+    assert.deepEqual([...cache.allSymbolsByName.keys()].sort(), ["run", "stop"]);
+
+    releaseSymbolMapCache(cache);
+    assert.equal(getCachedSymbolMap("repo-5"), undefined);
+    assert.equal(cache.allSymbolsByName.has("run"), false);
+    assert.equal(cache.symbols.symbolCount, 0);
+  });
+
   it("clears repo-scoped cache entries", () => {
     buildSymbolMapCacheFromRows({
       repoId: "repo-3",